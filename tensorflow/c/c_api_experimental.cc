@@ -15,6 +15,10 @@ limitations under the License.
 
 #include "tensorflow/c/c_api_experimental.h"
 
+#include <cstring>
+#include <utility>
+#include <vector>
+
 #include "absl/strings/substitute.h"
 #include "tensorflow/c/c_api.h"
 #include "tensorflow/c/c_api_internal.h"
@@ -35,6 +39,7 @@ limitations under the License.
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/shape_inference.h"
 #include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/node_builder.h"
 #include "tensorflow/core/platform/blocking_counter.h"
@@ -324,6 +329,85 @@ void TF_EnqueueNamedTensor(TF_Session* session, int tensor_id,
   VLOG(1) << "Enqueuing is done.";
 }
 
+void TF_SessionRunWithOutputBuffers(
+    TF_Session* session, const TF_Buffer* run_options, const TF_Output* inputs,
+    TF_Tensor* const* input_values, int ninputs, const TF_Output* outputs,
+    void* const* output_buffers, const size_t* output_buffer_lengths,
+    size_t* output_byte_sizes, int noutputs,
+    const TF_Operation* const* target_opers, int ntargets, TF_Status* status) {
+  using tensorflow::Tensor;
+
+  if (session->extend_before_run &&
+      !tensorflow::ExtendSessionGraphHelper(session, status)) {
+    return;
+  }
+
+  tensorflow::RunOptions run_options_proto;
+  if (run_options != nullptr && !run_options_proto.ParseFromArray(
+                                    run_options->data, run_options->length)) {
+    status->status = InvalidArgument("Unparseable RunOptions proto");
+    return;
+  }
+
+  // Convert from TF_Output and TF_Tensor to a string and Tensor.
+  std::vector<std::pair<std::string, Tensor>> input_pairs(ninputs);
+  for (int i = 0; i < ninputs; ++i) {
+    status->status =
+        tensorflow::TF_TensorToTensor(input_values[i], &input_pairs[i].second);
+    if (!status->status.ok()) return;
+    input_pairs[i].first = tensorflow::strings::StrCat(
+        inputs[i].oper->node.name(), ":", inputs[i].index);
+  }
+
+  // Convert from TF_Output to string names.
+  std::vector<std::string> output_names(noutputs);
+  for (int i = 0; i < noutputs; ++i) {
+    output_names[i] = tensorflow::strings::StrCat(
+        outputs[i].oper->node.name(), ":", outputs[i].index);
+  }
+
+  // Convert from TF_Operation* to string names.
+  std::vector<std::string> target_names(ntargets);
+  for (int i = 0; i < ntargets; ++i) {
+    target_names[i] = target_opers[i]->node.name();
+  }
+
+  tensorflow::RunMetadata run_metadata_proto;
+  std::vector<Tensor> output_tensors(noutputs);
+  status->status =
+      session->session->Run(run_options_proto, input_pairs, output_names,
+                            target_names, &output_tensors,
+                            &run_metadata_proto);
+  if (!status->status.ok()) return;
+
+  // Write the fetched tensors into the caller-owned buffers. Unlike
+  // TF_SessionRun, no TF_Tensor is allocated per fetch; the contents land
+  // directly in the caller's (typically reused) buffers.
+  for (int i = 0; i < noutputs; ++i) {
+    const Tensor& src = output_tensors[i];
+    if (!tensorflow::DataTypeCanUseMemcpy(src.dtype())) {
+      status->status = InvalidArgument(
+          "Fetch ", output_names[i], " has dtype ",
+          tensorflow::DataTypeString(src.dtype()),
+          " whose contents cannot be written to a caller-owned buffer");
+      return;
+    }
+    const size_t num_bytes = src.TotalBytes();
+    if (num_bytes > output_buffer_lengths[i]) {
+      status->status = InvalidArgument(
+          "Fetch ", output_names[i], " needs ", num_bytes,
+          " bytes but the registered output buffer only holds ",
+          output_buffer_lengths[i]);
+      return;
+    }
+    if (num_bytes > 0) {
+      const tensorflow::StringPiece src_data = src.tensor_data();
+      std::memcpy(output_buffers[i], src_data.data(), num_bytes);
+    }
+    if (output_byte_sizes != nullptr) output_byte_sizes[i] = num_bytes;
+  }
+}
+
 TF_Buffer* TFE_GetServerDef(const char* text_proto, TF_Status* status) {
   tensorflow::ServerDef server_def;
   if (!tensorflow::protobuf::TextFormat::ParseFromString(text_proto,
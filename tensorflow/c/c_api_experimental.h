@@ -129,6 +129,34 @@ TF_CAPI_EXPORT extern void TF_EnqueueNamedTensor(TF_Session* session,
                                                  int tensor_id,
                                                  TF_Tensor* tensor,
                                                  TF_Status* status);
+
+// Runs the graph associated with `session` like TF_SessionRun, but writes
+// each fetched tensor's contents directly into a caller-owned buffer instead
+// of allocating a fresh TF_Tensor per fetch. This makes the fetch path
+// copy-free on the caller's side for fixed-shape serving: the caller sizes
+// each buffer once (e.g. from a dry run via TF_SessionRun and
+// TF_TensorByteSize) and reuses it across requests, e.g. pointing into an
+// RPC response arena.
+//
+// On success, `output_buffers[i]` holds the raw tensor content of the i-th
+// fetch, laid out as in TF_TensorData, and `output_byte_sizes[i]` (if not
+// NULL) is set to the number of bytes written.
+//
+// Fails with InvalidArgument if a fetched tensor is of a non-memcpyable
+// dtype (e.g. TF_STRING or TF_RESOURCE) or if its content does not fit in
+// `output_buffer_lengths[i]` bytes; buffers already written are left as-is.
+TF_CAPI_EXPORT extern void TF_SessionRunWithOutputBuffers(
+    TF_Session* session, const TF_Buffer* run_options,
+    // Input tensors
+    const TF_Output* inputs, TF_Tensor* const* input_values, int ninputs,
+    // Output tensors
+    const TF_Output* outputs, void* const* output_buffers,
+    const size_t* output_buffer_lengths, size_t* output_byte_sizes,
+    int noutputs,
+    // Target operations
+    const TF_Operation* const* target_opers, int ntargets,
+    TF_Status* status);
+
 // Create a serialized tensorflow.ServerDef proto.
 TF_Buffer* TFE_GetServerDef(const char* text_proto, TF_Status* status);
 
@@ -86,6 +86,54 @@ TEST(CAPI_EXPERIMENTAL, IsStateful) {
   EXPECT_EQ(id, 0);
 }
 
+TEST(CAPI_EXPERIMENTAL, SessionRunWithOutputBuffers) {
+  TF_Status* s = TF_NewStatus();
+  TF_Graph* graph = TF_NewGraph();
+
+  // The graph computes `3 + 2`.
+  TF_Operation* a = ScalarConst(3, graph, s, "A");
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  TF_Operation* b = ScalarConst(2, graph, s, "B");
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  TF_Operation* add = Add(a, b, graph, s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+
+  TF_SessionOptions* opts = TF_NewSessionOptions();
+  TF_Session* session = TF_NewSession(graph, opts, s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  TF_DeleteSessionOptions(opts);
+
+  TF_Output fetch{add, 0};
+  int32_t result = 0;
+  void* buffers[1] = {&result};
+  size_t buffer_lengths[1] = {sizeof(result)};
+  size_t byte_sizes[1] = {0};
+  TF_SessionRunWithOutputBuffers(session, /*run_options=*/nullptr,
+                                 /*inputs=*/nullptr, /*input_values=*/nullptr,
+                                 /*ninputs=*/0, &fetch, buffers,
+                                 buffer_lengths, byte_sizes, /*noutputs=*/1,
+                                 /*target_opers=*/nullptr, /*ntargets=*/0, s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  EXPECT_EQ(3 + 2, result);
+  EXPECT_EQ(sizeof(int32_t), byte_sizes[0]);
+
+  // A buffer that is too small for the fetched tensor is an error.
+  size_t short_lengths[1] = {sizeof(result) - 1};
+  TF_SessionRunWithOutputBuffers(session, /*run_options=*/nullptr,
+                                 /*inputs=*/nullptr, /*input_values=*/nullptr,
+                                 /*ninputs=*/0, &fetch, buffers, short_lengths,
+                                 /*output_byte_sizes=*/nullptr, /*noutputs=*/1,
+                                 /*target_opers=*/nullptr, /*ntargets=*/0, s);
+  EXPECT_EQ(TF_INVALID_ARGUMENT, TF_GetCode(s));
+
+  TF_CloseSession(session, s);
+  EXPECT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  TF_DeleteSession(session, s);
+  EXPECT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  TF_DeleteGraph(graph);
+  TF_DeleteStatus(s);
+}
+
 class ShapeInferenceTest : public ::testing::Test {
  protected:
   ShapeInferenceTest()
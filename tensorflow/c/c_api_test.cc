@@ -48,6 +48,7 @@ limitations under the License.
 #include "tensorflow/core/graph/tensor_id.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/mem.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/platform/resource_loader.h"
@@ -1051,6 +1052,63 @@ TEST(CAPI, Session) {
   TF_DeleteStatus(s);
 }
 
+TEST(CAPI, SessionZeroCopyFeed) {
+  TF_Status* s = TF_NewStatus();
+  TF_Graph* graph = TF_NewGraph();
+
+  TF_Operation* feed = Placeholder(graph, s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+
+  // Identity forwards its input buffer, so if the feed path is zero-copy all
+  // the way through, the fetched tensor aliases the memory that was handed
+  // to TF_NewTensor.
+  TF_OperationDescription* desc = TF_NewOperation(graph, "Identity", "ident");
+  TF_AddInput(desc, {feed, 0});
+  TF_Operation* identity = TF_FinishOperation(desc, s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+
+  // Feed memory the way a caller adopting foreign (e.g. protobuf arena)
+  // buffers would: aligned, with a deallocator that does not touch the
+  // buffer itself.
+  const size_t alignment = TF_TensorDefaultAlignment();
+  int32_t* data = static_cast<int32_t*>(
+      tensorflow::port::AlignedMalloc(4 * sizeof(int32_t), alignment));
+  ASSERT_NE(data, nullptr);
+  for (int i = 0; i < 4; ++i) data[i] = i;
+  const int64_t dims[] = {4};
+  TF_Tensor* t =
+      TF_NewTensor(TF_INT32, dims, 1, data, 4 * sizeof(int32_t),
+                   [](void*, size_t, void*) {}, nullptr);
+  ASSERT_NE(t, nullptr);
+
+  // The aligned buffer must be adopted, not copied.
+  EXPECT_EQ(data, TF_TensorData(t));
+  EXPECT_FALSE(TF_TensorOwnsMemory(t));
+  EXPECT_TRUE(TF_TensorIsAligned(t));
+
+  CSession csession(graph, s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  csession.SetInputs({{feed, t}});
+  csession.SetOutputs({identity});
+  csession.Run(s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+
+  TF_Tensor* out = csession.output_tensor(0);
+  ASSERT_TRUE(out != nullptr);
+  EXPECT_EQ(TF_INT32, TF_TensorType(out));
+  ASSERT_EQ(4 * sizeof(int32_t), TF_TensorByteSize(out));
+  // End-to-end zero copy: the fetched tensor is backed by the very buffer
+  // that was fed in, and TensorFlow never took ownership of it.
+  EXPECT_EQ(data, TF_TensorData(out));
+  EXPECT_FALSE(TF_TensorOwnsMemory(out));
+
+  csession.CloseAndDelete(s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  TF_DeleteGraph(graph);
+  TF_DeleteStatus(s);
+  tensorflow::port::AlignedFree(data);
+}
+
 // If `device` is non-empty, run Min op on that device.
 // Otherwise run it on the default device (CPU).
 void RunMinTest(const string& device, bool use_XLA) {
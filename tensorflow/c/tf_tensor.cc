@@ -348,6 +348,16 @@ Status TensorInterface::ToTensor(tensorflow::Tensor* dst) const {
 
 bool TensorInterface::IsAligned() const { return tensor_.IsAligned(); }
 
+bool TensorInterface::OwnsMemory() const {
+  TensorBuffer* buf = tensorflow::TensorCApi::Buffer(tensor_);
+  return buf == nullptr || buf->root_buffer()->OwnsMemory();
+}
+
 }  // namespace tensorflow
 
 bool TF_TensorIsAligned(const TF_Tensor* t) { return t->tensor->IsAligned(); }
+
+bool TF_TensorOwnsMemory(const TF_Tensor* t) {
+  return tensorflow::down_cast<const tensorflow::TensorInterface*>(t->tensor)
+      ->OwnsMemory();
+}
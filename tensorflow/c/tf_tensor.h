@@ -63,6 +63,13 @@ typedef struct TF_Tensor TF_Tensor;
 // Clients must provide a custom deallocator function so they can pass in
 // memory managed by something like numpy.
 //
+// For dtypes other than TF_STRING and TF_RESOURCE, if `data` is aligned to
+// TF_TensorDefaultAlignment() the buffer is adopted as-is: the returned
+// tensor's TF_TensorData is `data` itself, no copy is made, and the
+// deallocator runs only when the last reference to the buffer is dropped.
+// Misaligned buffers are copied (and the deallocator invoked immediately).
+// Use TF_TensorOwnsMemory to check which case applied.
+//
 // May return NULL (and invoke the deallocator) if the provided data buffer
 // (data, len) is inconsistent with a tensor of the given TF_DataType
 // and the shape specified by (dima, num_dims).
@@ -154,6 +161,14 @@ TF_CAPI_EXPORT extern void TF_TensorBitcastFrom(const TF_Tensor* from,
 // Returns bool iff this tensor is aligned.
 TF_CAPI_EXPORT extern bool TF_TensorIsAligned(const TF_Tensor*);
 
+// Returns true iff the tensor's backing buffer was allocated by TensorFlow
+// (e.g. by TF_AllocateTensor, or by a copy made during TF_NewTensor).
+// Returns false when the buffer was adopted from the caller, i.e. the
+// zero-copy path of TF_NewTensor was taken and TF_TensorData points at the
+// caller-provided memory. This also holds for tensors fetched from a session
+// run whose buffer was forwarded unchanged from such a feed.
+TF_CAPI_EXPORT extern bool TF_TensorOwnsMemory(const TF_Tensor*);
+
 #ifdef __cplusplus
 } /* end extern "C" */
 #endif
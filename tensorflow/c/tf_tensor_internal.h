@@ -110,6 +110,7 @@ class TensorInterface : public AbstractTensorInterface {
   void* Data() const override;
   bool IsAligned() const override;
   bool CanMove() const override;
+  bool OwnsMemory() const;
   std::string SummarizeValue() const override;
 
   void SetShape(const int64_t* dims, int num_dims);
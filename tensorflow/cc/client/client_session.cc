@@ -19,6 +19,7 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/protobuf/config.pb.h"
@@ -37,11 +38,25 @@ class ClientSession::Impl {
   static SessionOptions MakeDefaultSessionOptions(const string& target);
   Status MaybeExtendGraph() const;
 
+  void ScheduleRunAsync(std::vector<std::pair<string, Tensor>> feeds,
+                        std::vector<string> output_tensor_names,
+                        std::vector<string> target_node_names,
+                        RunAsyncCallback callback) const;
+
   std::unique_ptr<Session> session_;
   std::shared_ptr<Graph> graph_;
 
   mutable mutex mu_;
   mutable int last_num_graph_nodes_ TF_GUARDED_BY(mu_) = 0;
+
+  // Executes RunAsync calls; created on first use. Destroying the pool in
+  // ~Impl waits for all outstanding calls.
+  mutable mutex async_mu_;
+  mutable condition_variable async_slot_available_;
+  mutable std::unique_ptr<thread::ThreadPool> async_pool_
+      TF_GUARDED_BY(async_mu_);
+  mutable int num_outstanding_async_runs_ TF_GUARDED_BY(async_mu_) = 0;
+  mutable int max_outstanding_async_runs_ TF_GUARDED_BY(async_mu_) = 2;
 };
 
 ClientSession::ClientSession(const Scope& scope, const string& target)
@@ -158,6 +173,82 @@ Status ClientSession::Run(
                                threadpool_options);
 }
 
+void ClientSession::Impl::ScheduleRunAsync(
+    std::vector<std::pair<string, Tensor>> feeds,
+    std::vector<string> output_tensor_names,
+    std::vector<string> target_node_names, RunAsyncCallback callback) const {
+  thread::ThreadPool* pool = nullptr;
+  {
+    mutex_lock l(async_mu_);
+    if (async_pool_ == nullptr) {
+      async_pool_.reset(new thread::ThreadPool(Env::Default(),
+                                               "client_session_run_async",
+                                               max_outstanding_async_runs_));
+    }
+    while (num_outstanding_async_runs_ >= max_outstanding_async_runs_) {
+      async_slot_available_.wait(l);
+    }
+    ++num_outstanding_async_runs_;
+    pool = async_pool_.get();
+  }
+  pool->Schedule([this, feeds = std::move(feeds),
+                         output_tensor_names = std::move(output_tensor_names),
+                         target_node_names = std::move(target_node_names),
+                         callback = std::move(callback)]() mutable {
+    std::vector<Tensor> outputs;
+    Status status = session_->Run(RunOptions(), feeds, output_tensor_names,
+                                  target_node_names, &outputs, nullptr);
+    // Free the slot before invoking the callback so that a callback that
+    // submits follow-up work never blocks the pipeline.
+    {
+      mutex_lock l(async_mu_);
+      --num_outstanding_async_runs_;
+      async_slot_available_.notify_one();
+    }
+    callback(status, std::move(outputs));
+  });
+}
+
+void ClientSession::RunAsync(const FeedType& inputs,
+                             const std::vector<Output>& fetch_outputs,
+                             const std::vector<Operation>& run_outputs,
+                             RunAsyncCallback callback) const {
+  std::vector<std::pair<string, Tensor>> feeds;
+  feeds.reserve(inputs.size());
+  for (auto const& feed : inputs) {
+    if (!feed.second.status.ok()) {
+      callback(feed.second.status, {});
+      return;
+    }
+    feeds.emplace_back(feed.first.name(), feed.second.tensor);
+  }
+  std::vector<string> output_tensor_names;
+  output_tensor_names.reserve(fetch_outputs.size());
+  for (auto const& output : fetch_outputs) {
+    output_tensor_names.push_back(output.name());
+  }
+  std::vector<string> target_node_names;
+  target_node_names.reserve(run_outputs.size());
+  for (auto const& output : run_outputs) {
+    target_node_names.push_back(output.node()->name());
+  }
+  Status status = impl()->MaybeExtendGraph();
+  if (!status.ok()) {
+    callback(status, {});
+    return;
+  }
+  impl()->ScheduleRunAsync(std::move(feeds), std::move(output_tensor_names),
+                           std::move(target_node_names), std::move(callback));
+}
+
+void ClientSession::SetRunAsyncMaxOutstanding(int max_outstanding) {
+  CHECK_GE(max_outstanding, 1);
+  mutex_lock l(impl()->async_mu_);
+  CHECK(impl()->async_pool_ == nullptr)
+      << "SetRunAsyncMaxOutstanding must be called before the first RunAsync";
+  impl()->max_outstanding_async_runs_ = max_outstanding;
+}
+
 Status ClientSession::MakeCallable(const CallableOptions& callable_options,
                                    CallableHandle* out_handle) {
   TF_RETURN_IF_ERROR(impl()->MaybeExtendGraph());
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CC_CLIENT_CLIENT_SESSION_H_
 #define TENSORFLOW_CC_CLIENT_CLIENT_SESSION_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -105,6 +106,37 @@ class ClientSession {
              std::vector<Tensor>* outputs, RunMetadata* run_metadata,
              const thread::ThreadPoolOptions& threadpool_options) const;
 
+  /// A callback invoked when an asynchronous `RunAsync` call completes. It
+  /// receives the run status and the fetched tensors, in the same order as
+  /// the `fetch_outputs` passed to `RunAsync`.
+  typedef std::function<void(const Status&, std::vector<Tensor>)>
+      RunAsyncCallback;
+
+  /// \brief Evaluates `fetch_outputs` asynchronously and invokes `callback`
+  /// with the result.
+  ///
+  /// The run is executed on an internal thread pool and `callback` is invoked
+  /// from one of its threads, so the callback must not block on another
+  /// `RunAsync` completion. Multiple outstanding calls are executed
+  /// concurrently (the underlying session is thread-safe), which allows a
+  /// single submitting thread to pipeline requests and keep a device
+  /// saturated. At most `max_outstanding` calls (see
+  /// `SetRunAsyncMaxOutstanding`) are admitted at a time; when the bound is
+  /// reached, `RunAsync` blocks until a slot frees up.
+  ///
+  /// The `ClientSession` must outlive all outstanding calls; the destructor
+  /// blocks until they complete.
+  /// NOTE: This API is still experimental and may change.
+  void RunAsync(const FeedType& inputs,
+                const std::vector<Output>& fetch_outputs,
+                const std::vector<Operation>& run_outputs,
+                RunAsyncCallback callback) const;
+
+  /// \brief Sets the bound on outstanding `RunAsync` calls. Must be >= 1 and
+  /// must be called before the first `RunAsync` call; the default is 2.
+  /// NOTE: This API is still experimental and may change.
+  void SetRunAsyncMaxOutstanding(int max_outstanding);
+
   /// \brief A handle to a subgraph, created with
   /// `ClientSession::MakeCallable()`.
   typedef int64_t CallableHandle;
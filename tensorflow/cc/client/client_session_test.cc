@@ -17,10 +17,13 @@ limitations under the License.
 
 #include "tensorflow/cc/client/client_session.h"
 
+#include <atomic>
 #include <utility>
 #include <vector>
 
 #include "absl/synchronization/barrier.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/notification.h"
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/cc/ops/standard_ops.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
@@ -121,6 +124,52 @@ TEST(ClientSessionTest, Extend) {
   test::ExpectTensorEqual<int>(outputs[0], test::AsTensor<int>({31, 42}, {2}));
 }
 
+TEST(ClientSessionTest, RunAsync) {
+  Scope root = Scope::NewRootScope();
+  auto a = Placeholder(root, DT_INT32);
+  auto b = Placeholder(root, DT_INT32);
+  auto c = Add(root, a, b);
+  ClientSession session(root);
+
+  absl::Notification done;
+  session.RunAsync({{a, 1}, {b, 41}}, {c}, {},
+                   [&done](const Status& status, std::vector<Tensor> outputs) {
+                     TF_EXPECT_OK(status);
+                     ASSERT_EQ(outputs.size(), 1);
+                     test::ExpectTensorEqual<int>(outputs[0],
+                                                  test::AsTensor<int>({42},
+                                                                      {}));
+                     done.Notify();
+                   });
+  done.WaitForNotification();
+}
+
+TEST(ClientSessionTest, RunAsyncPipelined) {
+  Scope root = Scope::NewRootScope();
+  auto a = Placeholder(root, DT_INT32);
+  auto c = Add(root, a, {1});
+  ClientSession session(root);
+  session.SetRunAsyncMaxOutstanding(4);
+
+  constexpr int kNumRequests = 16;
+  absl::BlockingCounter pending(kNumRequests);
+  std::atomic<int> num_ok(0);
+  for (int i = 0; i < kNumRequests; ++i) {
+    session.RunAsync(
+        {{a, i}}, {c}, {},
+        [&, i](const Status& status, std::vector<Tensor> outputs) {
+          TF_EXPECT_OK(status);
+          ASSERT_EQ(outputs.size(), 1);
+          test::ExpectTensorEqual<int>(outputs[0],
+                                       test::AsTensor<int>({i + 1}, {}));
+          ++num_ok;
+          pending.DecrementCount();
+        });
+  }
+  pending.Wait();
+  EXPECT_EQ(num_ok, kNumRequests);
+}
+
 TEST(ClientSessionTest, MultiThreadedWithDefaultThreadpool) {
   Scope root = Scope::NewRootScope();
   auto a = Add(root, {1, 2}, {3, 4});
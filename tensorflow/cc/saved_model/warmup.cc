@@ -0,0 +1,162 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/cc/saved_model/warmup.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/cc/saved_model/constants.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/kernels/batching_util/warmup.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/protobuf/meta_graph.pb.h"
+#include "tensorflow/core/public/session.h"
+
+namespace tensorflow {
+namespace {
+
+// One session run against a signature at a fixed batch size.
+struct WarmupRun {
+  std::vector<std::pair<string, Tensor>> inputs;
+  std::vector<string> output_names;
+};
+
+// Builds a zero-filled tensor for "info".  Unknown dimensions are replaced
+// by "batch_size" in the leading position and by 1 elsewhere;
+// "*has_dynamic_batch" is set when the leading dimension was unknown.
+Status MakeZeroTensor(const TensorInfo& info, int batch_size,
+                      bool* has_dynamic_batch, Tensor* out) {
+  if (info.encoding_case() != TensorInfo::kName) {
+    return errors::Unimplemented(
+        "Sparse and composite signature inputs cannot be synthesized");
+  }
+  if (!DataTypeCanUseMemcpy(info.dtype()) && info.dtype() != DT_STRING) {
+    return errors::Unimplemented("Cannot synthesize an input of dtype ",
+                                 DataTypeString(info.dtype()));
+  }
+  if (info.tensor_shape().unknown_rank()) {
+    return errors::Unimplemented(
+        "Cannot synthesize an input of unknown rank");
+  }
+  TensorShape shape;
+  int dim_index = 0;
+  for (const auto& dim : info.tensor_shape().dim()) {
+    int64_t size = dim.size();
+    if (size < 0) {
+      if (dim_index == 0) {
+        size = batch_size;
+        *has_dynamic_batch = true;
+      } else {
+        size = 1;
+      }
+    }
+    TF_RETURN_IF_ERROR(shape.AddDimWithStatus(size));
+    ++dim_index;
+  }
+  *out = Tensor(info.dtype(), shape);
+  if (DataTypeCanUseMemcpy(info.dtype())) {
+    memset(const_cast<char*>(out->tensor_data().data()), 0,
+           out->tensor_data().size());
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+Status RunSavedModelWarmup(const SavedModelBundleInterface& bundle,
+                           const WarmupOptions& options) {
+  // Registering the model lets supported batch kernels treat these runs as
+  // warmup requests and prime all of their allowed batch sizes.
+  serving::WarmupStateRegistry::Key model_key(options.model_name,
+                                              options.model_version);
+  auto per_model_data =
+      std::make_unique<serving::WarmupStateRegistry::PerModelData>();
+  per_model_data->warmup_all_batch_sizes = true;
+  auto handle = serving::GetGlobalWarmupStateRegistry().Register(
+      model_key, std::move(per_model_data));
+  TF_RETURN_IF_ERROR(handle.status());
+
+  const std::vector<int> batch_sizes =
+      options.batch_sizes.empty() ? std::vector<int>{1} : options.batch_sizes;
+
+  std::vector<WarmupRun> runs;
+  for (const auto& entry : bundle.GetSignatures()) {
+    const string& signature_key = entry.first;
+    const SignatureDef& signature = entry.second;
+    if (signature_key == kSavedModelInitOpSignatureKey ||
+        signature.inputs().empty() || signature.outputs().empty()) {
+      continue;
+    }
+    if (!options.signature_keys.empty() &&
+        std::find(options.signature_keys.begin(), options.signature_keys.end(),
+                  signature_key) == options.signature_keys.end()) {
+      continue;
+    }
+    for (int batch_size : batch_sizes) {
+      WarmupRun run;
+      bool has_dynamic_batch = false;
+      Status synthesize_status;
+      for (const auto& input : signature.inputs()) {
+        Tensor tensor;
+        synthesize_status = MakeZeroTensor(input.second, batch_size,
+                                           &has_dynamic_batch, &tensor);
+        if (!synthesize_status.ok()) break;
+        run.inputs.emplace_back(input.second.name(), std::move(tensor));
+      }
+      if (!synthesize_status.ok()) {
+        VLOG(1) << "Skipping warmup of signature '" << signature_key
+                << "': " << synthesize_status.message();
+        break;
+      }
+      for (const auto& output : signature.outputs()) {
+        run.output_names.push_back(output.second.name());
+      }
+      runs.push_back(std::move(run));
+      // One run suffices for signatures with fully known input shapes.
+      if (!has_dynamic_batch) break;
+    }
+  }
+
+  Status overall_status;
+  mutex status_mu;
+  {
+    thread::ThreadPool pool(Env::Default(), "saved_model_warmup",
+                            std::max(1, options.num_threads));
+    for (const WarmupRun& run : runs) {
+      pool.Schedule([&bundle, &run, &status_mu, &overall_status] {
+        std::vector<Tensor> outputs;
+        Status s = bundle.GetSession()->Run(run.inputs, run.output_names, {},
+                                            &outputs);
+        if (!s.ok()) {
+          mutex_lock l(status_mu);
+          overall_status.Update(s);
+        }
+      });
+    }
+  }  // Joins all warmup runs.
+  return overall_status;
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,61 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CC_SAVED_MODEL_WARMUP_H_
+#define TENSORFLOW_CC_SAVED_MODEL_WARMUP_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tensorflow/cc/saved_model/loader.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+
+/// Options for RunSavedModelWarmup().
+struct WarmupOptions {
+  /// Batch sizes to prime.  For a signature whose inputs have an unknown
+  /// leading dimension, one warmup run per batch size is issued; signatures
+  /// with fully known input shapes are run once.
+  std::vector<int> batch_sizes = {1};
+
+  /// Number of warmup runs executed concurrently.
+  int num_threads = 4;
+
+  /// If non-empty, only the signatures with these keys are warmed up.
+  std::vector<std::string> signature_keys;
+
+  /// Model key under which the warmup state is registered, so that batch
+  /// kernels can recognize the runs as warmup and prime all of their
+  /// allowed batch sizes from a single request.
+  std::string model_name = "default";
+  int64_t model_version = 0;
+};
+
+/// Primes the caches that the first requests against a freshly loaded
+/// SavedModel would otherwise pay for (kernel instantiation, packed-weight
+/// caches, JIT compilation) by running the signatures of "bundle" on
+/// zero-filled input tensors, concurrently across signatures and batch
+/// sizes.  Call this while the replica is still out of rotation; it returns
+/// once every warmup run has completed, with the first error encountered,
+/// if any.  Signatures whose inputs cannot be synthesized (sparse or
+/// composite encodings, unknown rank) are skipped.
+Status RunSavedModelWarmup(const SavedModelBundleInterface& bundle,
+                           const WarmupOptions& options = WarmupOptions());
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CC_SAVED_MODEL_WARMUP_H_
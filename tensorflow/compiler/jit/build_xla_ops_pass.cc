@@ -159,6 +159,13 @@ void MergeOutgoingDataEdges(const Scope& s, Node* old_node, Node* new_node,
 
       ops::_XlaMerge xla_merge_op(s.WithOpName("merge_oidx_", oidx),
                                   Output(old_node, oidx), new_output);
+      if (!GetMarkForCompilationPassFlags()
+               ->tf_xla_cluster_autotune_dir.empty()) {
+        // Let the merge op report which of the two paths produced the live
+        // input to the cluster autotuner.
+        xla_merge_op.output.node()->AddAttr("cluster_name",
+                                            std::string(cluster_name));
+      }
       merged_output = merged_outputs[oidx] = xla_merge_op.output;
     }
 
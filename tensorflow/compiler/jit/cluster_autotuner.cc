@@ -0,0 +1,118 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/compiler/jit/cluster_autotuner.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "tensorflow/compiler/jit/flags.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
+
+namespace tensorflow {
+namespace {
+
+// One "<cluster_name> <tf_us> <xla_us> <decluster>" line per cluster.
+constexpr char kAutotuneResultsFileName[] = "xla_cluster_autotune_results.txt";
+
+std::string AutotuneResultsPath(const std::string& dir) {
+  return io::JoinPath(dir, kAutotuneResultsFileName);
+}
+
+}  // namespace
+
+Status SaveClusterAutotuneResults(const std::string& dir,
+                                  const ClusterAutotuneResultMap& results) {
+  TF_RETURN_IF_ERROR(Env::Default()->RecursivelyCreateDir(dir));
+
+  // Merge with what's already on disk so that verdicts from other devices (or
+  // earlier runs) survive. Freshly measured results win.
+  TF_ASSIGN_OR_RETURN(ClusterAutotuneResultMap merged,
+                      LoadClusterAutotuneResults(dir));
+  for (const auto& [cluster_name, result] : results) {
+    merged[cluster_name] = result;
+  }
+
+  std::string contents;
+  for (const auto& [cluster_name, result] : merged) {
+    absl::StrAppend(&contents, cluster_name, " ",
+                    result.tf_time_us_per_execution, " ",
+                    result.xla_time_us_per_execution, " ",
+                    result.decluster ? 1 : 0, "\n");
+  }
+  return WriteStringToFile(Env::Default(), AutotuneResultsPath(dir), contents);
+}
+
+absl::StatusOr<ClusterAutotuneResultMap> LoadClusterAutotuneResults(
+    const std::string& dir) {
+  const std::string path = AutotuneResultsPath(dir);
+  if (!Env::Default()->FileExists(path).ok()) {
+    return ClusterAutotuneResultMap{};
+  }
+
+  std::string contents;
+  TF_RETURN_IF_ERROR(ReadFileToString(Env::Default(), path, &contents));
+
+  ClusterAutotuneResultMap results;
+  for (absl::string_view line :
+       absl::StrSplit(contents, '\n', absl::SkipEmpty())) {
+    std::vector<absl::string_view> fields = absl::StrSplit(line, ' ');
+    ClusterAutotuneResult result;
+    int decluster = 0;
+    if (fields.size() != 4 ||
+        !absl::SimpleAtoi(fields[1], &result.tf_time_us_per_execution) ||
+        !absl::SimpleAtoi(fields[2], &result.xla_time_us_per_execution) ||
+        !absl::SimpleAtoi(fields[3], &decluster)) {
+      return errors::InvalidArgument(
+          "Malformed cluster autotune results line in ", path, ": ", line);
+    }
+    result.decluster = decluster != 0;
+    results.emplace(std::string(fields[0]), result);
+  }
+  return results;
+}
+
+bool ShouldDeclusterFromAutotuneResults(absl::string_view cluster_name) {
+  const std::string& dir =
+      GetMarkForCompilationPassFlags()->tf_xla_cluster_autotune_dir;
+  if (dir.empty()) {
+    return false;
+  }
+
+  // The persisted results are loaded once per process: clustering decisions
+  // made from them must not change while a graph is being (re-)marked.
+  static const ClusterAutotuneResultMap* results = [&dir] {
+    auto results_or = LoadClusterAutotuneResults(dir);
+    if (!results_or.ok()) {
+      LOG(WARNING) << "Failed to load cluster autotune results from " << dir
+                   << ": " << results_or.status();
+      return new ClusterAutotuneResultMap{};
+    }
+    return new ClusterAutotuneResultMap(*std::move(results_or));
+  }();
+
+  auto it = results->find(cluster_name);
+  return it != results->end() && it->second.decluster;
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,69 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_COMPILER_JIT_CLUSTER_AUTOTUNER_H_
+#define TENSORFLOW_COMPILER_JIT_CLUSTER_AUTOTUNER_H_
+
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/statusor.h"
+
+namespace tensorflow {
+
+// Measured outcome of running a cluster both through the TF fallback path and
+// through XLA. Produced by DeviceCompilationProfiler at the end of a process
+// and consulted by MarkForCompilationPass in subsequent runs to de-cluster
+// subgraphs that lost to TF (see the tf_xla_cluster_autotune_dir flag).
+//
+// Verdicts are keyed by cluster name, so they are only meaningful across runs
+// when tf_xla_deterministic_cluster_names is set.
+struct ClusterAutotuneResult {
+  // Mean wall time of one execution through the TF fallback path.
+  int64_t tf_time_us_per_execution = 0;
+
+  // Mean wall time of one execution through XLA.
+  int64_t xla_time_us_per_execution = 0;
+
+  // True if the cluster executed slower through XLA and should not be formed
+  // again.
+  bool decluster = false;
+};
+
+using ClusterAutotuneResultMap =
+    absl::flat_hash_map<std::string, ClusterAutotuneResult>;
+
+// Merges `results` with the results already persisted in `dir` (entries in
+// `results` win) and writes the merged map back. Creates the directory if it
+// doesn't exist.
+Status SaveClusterAutotuneResults(const std::string& dir,
+                                  const ClusterAutotuneResultMap& results);
+
+// Reads previously persisted results from `dir`. Returns an empty map if no
+// results have been persisted yet.
+absl::StatusOr<ClusterAutotuneResultMap> LoadClusterAutotuneResults(
+    const std::string& dir);
+
+// Returns true if the results persisted in the directory named by the
+// tf_xla_cluster_autotune_dir flag say that `cluster_name` should not be
+// clustered. The results are loaded once per process; returns false if the
+// flag is unset or the results cannot be read.
+bool ShouldDeclusterFromAutotuneResults(absl::string_view cluster_name);
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_COMPILER_JIT_CLUSTER_AUTOTUNER_H_
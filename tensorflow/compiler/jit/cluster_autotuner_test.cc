@@ -0,0 +1,99 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/compiler/jit/cluster_autotuner.h"
+
+#include <string>
+
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+std::string NewAutotuneDir(const std::string& name) {
+  std::string dir = io::JoinPath(testing::TmpDir(), name);
+  TF_CHECK_OK(Env::Default()->RecursivelyCreateDir(dir));
+  return dir;
+}
+
+TEST(ClusterAutotunerTest, LoadFromEmptyDirReturnsEmptyMap) {
+  std::string dir = NewAutotuneDir("empty");
+
+  TF_ASSERT_OK_AND_ASSIGN(ClusterAutotuneResultMap results,
+                          LoadClusterAutotuneResults(dir));
+  EXPECT_TRUE(results.empty());
+}
+
+TEST(ClusterAutotunerTest, SaveLoadRoundTrip) {
+  std::string dir = NewAutotuneDir("round_trip");
+
+  ClusterAutotuneResultMap results;
+  results["cluster_0"] = {/*tf_time_us_per_execution=*/100,
+                          /*xla_time_us_per_execution=*/250,
+                          /*decluster=*/true};
+  results["cluster_1"] = {/*tf_time_us_per_execution=*/400,
+                          /*xla_time_us_per_execution=*/80,
+                          /*decluster=*/false};
+  TF_ASSERT_OK(SaveClusterAutotuneResults(dir, results));
+
+  TF_ASSERT_OK_AND_ASSIGN(ClusterAutotuneResultMap loaded,
+                          LoadClusterAutotuneResults(dir));
+  ASSERT_EQ(loaded.size(), 2);
+  EXPECT_EQ(loaded["cluster_0"].tf_time_us_per_execution, 100);
+  EXPECT_EQ(loaded["cluster_0"].xla_time_us_per_execution, 250);
+  EXPECT_TRUE(loaded["cluster_0"].decluster);
+  EXPECT_EQ(loaded["cluster_1"].tf_time_us_per_execution, 400);
+  EXPECT_EQ(loaded["cluster_1"].xla_time_us_per_execution, 80);
+  EXPECT_FALSE(loaded["cluster_1"].decluster);
+}
+
+TEST(ClusterAutotunerTest, SaveMergesWithPersistedResults) {
+  std::string dir = NewAutotuneDir("merge");
+
+  ClusterAutotuneResultMap first;
+  first["cluster_0"] = {100, 250, true};
+  first["cluster_1"] = {400, 80, false};
+  TF_ASSERT_OK(SaveClusterAutotuneResults(dir, first));
+
+  // A second save updates cluster_0's verdict and adds cluster_2 while
+  // leaving cluster_1 untouched.
+  ClusterAutotuneResultMap second;
+  second["cluster_0"] = {100, 90, false};
+  second["cluster_2"] = {10, 50, true};
+  TF_ASSERT_OK(SaveClusterAutotuneResults(dir, second));
+
+  TF_ASSERT_OK_AND_ASSIGN(ClusterAutotuneResultMap loaded,
+                          LoadClusterAutotuneResults(dir));
+  ASSERT_EQ(loaded.size(), 3);
+  EXPECT_FALSE(loaded["cluster_0"].decluster);
+  EXPECT_EQ(loaded["cluster_0"].xla_time_us_per_execution, 90);
+  EXPECT_FALSE(loaded["cluster_1"].decluster);
+  EXPECT_TRUE(loaded["cluster_2"].decluster);
+}
+
+TEST(ClusterAutotunerTest, LoadRejectsMalformedResults) {
+  std::string dir = NewAutotuneDir("malformed");
+  TF_ASSERT_OK(WriteStringToFile(
+      Env::Default(), io::JoinPath(dir, "xla_cluster_autotune_results.txt"),
+      "cluster_0 not_a_number 250 1\n"));
+
+  EXPECT_FALSE(LoadClusterAutotuneResults(dir).ok());
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -87,6 +87,13 @@ class DeviceCompilationCache {
   // found, `request_count` is incremented before returning the value.
   Value LookupOrCreate(const Key& key);
 
+  // Like `LookupOrCreate`, but if the entry is in the kCompiling state, blocks
+  // until the in-flight compilation finishes before returning its result.
+  // Lets strict compilation requests that race with a background compilation
+  // of the same signature pick up the freshly stored executable instead of
+  // observing a kCompiling entry with a null executable.
+  Value LookupOrCreateWhenNotCompiling(const Key& key);
+
   // Caches `compile_state`, `compilation_status`, `compilation_result` and
   // `executable` and associates them with the provided `key`. Takes ownership
   // of `compilation_result` and `executable`. Does not increment the
@@ -203,6 +210,37 @@ DeviceCompilationCache<ExecutableType>::LookupOrCreate(const Key& key) {
   return value;
 }
 
+template <typename ExecutableType>
+typename DeviceCompilationCache<ExecutableType>::Value
+DeviceCompilationCache<ExecutableType>::LookupOrCreateWhenNotCompiling(
+    const Key& key) {
+  // The outer lock protects the existence of the cache entry. It does not
+  // protect the contents of the cache entry.
+  Entry* entry;
+  {
+    mutex_lock lock(compile_cache_mu_);
+    // Emplace empty cache entry if not found.
+    auto it = cache_.emplace(key, std::make_unique<Entry>()).first;
+    entry = it->second.get();
+  }
+
+  mutex_lock lock(entry->mu);
+  // The background compilation thread updates `compile_state` (together with
+  // the compilation outputs) under `entry->mu` when it finishes, which wakes
+  // this wait up.
+  entry->mu.Await(Condition(
+      +[](DeviceCompileState* compile_state) {
+        return *compile_state != DeviceCompileState::kCompiling;
+      },
+      &entry->compile_state));
+  Value value = {/*compile_state=*/entry->compile_state,
+                 /*compilation_status=*/entry->compilation_status,
+                 /*request_count=*/++entry->request_count,
+                 /*compilation_result=*/entry->compilation_result.get(),
+                 /*executable=*/entry->executable.get()};
+  return value;
+}
+
 template <typename ExecutableType>
 void DeviceCompilationCache<ExecutableType>::Store(
     const Key& key, std::optional<DeviceCompileState> compile_state,
@@ -22,6 +22,7 @@ limitations under the License.
 #include <vector>
 
 #include <gtest/gtest.h>
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/test.h"
 #include "tsl/protobuf/error_codes.pb.h"
@@ -139,6 +140,53 @@ TEST(DeviceCompilationCacheTest, StoreLookupOrCreate) {
   EXPECT_EQ(cache_value.executable->data, "foo_exe");
 }
 
+TEST(DeviceCompilationCacheTest,
+     LookupOrCreateWhenNotCompilingReturnsImmediately) {
+  auto cache = std::make_unique<Cache>();
+
+  TF_ASSERT_OK_AND_ASSIGN(auto key, BuildSampleSignature("foo"));
+  auto compilation_result = std::make_unique<XlaCompiler::CompilationResult>();
+  auto executable = std::make_unique<FakeExecutable>("foo_exe");
+  cache->Store(key, DeviceCompileState::kCompiled, absl::OkStatus(),
+               std::move(compilation_result), std::move(executable));
+  auto cache_value = cache->LookupOrCreateWhenNotCompiling(key);
+
+  EXPECT_EQ(cache_value.compile_state, DeviceCompileState::kCompiled);
+  EXPECT_EQ(cache_value.request_count, 1);
+  EXPECT_TRUE(cache_value.executable != nullptr);
+  EXPECT_EQ(cache_value.executable->data, "foo_exe");
+}
+
+TEST(DeviceCompilationCacheTest,
+     LookupOrCreateWhenNotCompilingWaitsForCompilation) {
+  auto cache = std::make_unique<Cache>();
+
+  TF_ASSERT_OK_AND_ASSIGN(auto key, BuildSampleSignature("foo"));
+  cache->Store(key, DeviceCompileState::kCompiling, std::nullopt, std::nullopt,
+               std::nullopt);
+
+  // Finish the "background compilation" from a separate thread; the sleep
+  // makes it likely (but is not required for correctness) that the lookup
+  // below starts waiting first.
+  std::unique_ptr<Thread> thread(Env::Default()->StartThread(
+      ThreadOptions(), "fake_background_compilation", [&] {
+        Env::Default()->SleepForMicroseconds(1000);
+        auto compilation_result =
+            std::make_unique<XlaCompiler::CompilationResult>();
+        auto executable = std::make_unique<FakeExecutable>("foo_exe");
+        cache->Store(key, DeviceCompileState::kCompiled, absl::OkStatus(),
+                     std::move(compilation_result), std::move(executable));
+      }));
+
+  auto cache_value = cache->LookupOrCreateWhenNotCompiling(key);
+
+  EXPECT_EQ(cache_value.compile_state, DeviceCompileState::kCompiled);
+  EXPECT_TRUE(cache_value.compilation_status.ok());
+  EXPECT_TRUE(cache_value.compilation_result != nullptr);
+  EXPECT_TRUE(cache_value.executable != nullptr);
+  EXPECT_EQ(cache_value.executable->data, "foo_exe");
+}
+
 TEST(DeviceCompilationCacheTest, StoreOptionalArgs) {
   auto cache = std::make_unique<Cache>();
 
@@ -33,7 +33,7 @@ struct DeviceCompilationClusterSignature {
   // for compile-time constant arguments to the compilation, ordered by
   // argument number. Tensors must be in host memory.
   using TensorTypeAndShape =
-      std::pair<DataType, absl::InlinedVector<int64_t, 4>>;
+      std::pair<DataType, absl::InlinedVector<int64_t, 8>>;
   absl::InlinedVector<std::variant<Tensor, TensorTypeAndShape>, 8> args;
 
   bool operator==(const DeviceCompilationClusterSignature& other) const;
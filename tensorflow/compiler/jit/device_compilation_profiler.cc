@@ -21,10 +21,13 @@ limitations under the License.
 #include <utility>
 
 #include "absl/strings/str_cat.h"
+#include "tensorflow/compiler/jit/cluster_autotuner.h"
+#include "tensorflow/compiler/jit/flags.h"
 #include "tensorflow/compiler/jit/xla_activity.pb.h"
 #include "tensorflow/compiler/jit/xla_activity_listener.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
 #include "tensorflow/core/framework/metrics.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/status.h"
 #include "tsl/platform/mutex.h"
@@ -65,9 +68,53 @@ constexpr int64_t kDefaultCompilationThreshold = 2;
 // Maximum number of ongoing compilations.
 constexpr int64_t kMaxNumOngoingCompilations = kNumAsyncDeviceCompilerThreads;
 
+// Bound on the number of in-flight cluster run measurements. Entries leak if
+// a step errors out between the start and end of a cluster execution, so the
+// pending map is dropped wholesale when it grows past this.
+constexpr int64_t kMaxPendingClusterRuns = 1024;
+
+// Minimum number of timed executions on each of the TF fallback path and XLA
+// before the autotuner renders a verdict for a cluster.
+constexpr int64_t kMinAutotuneSamplesPerMode = 8;
+
+// XLA must lose to the TF fallback path by more than this margin before a
+// cluster is declared unprofitable, to keep noise from flip-flopping
+// verdicts.
+constexpr double kDeclusterMargin = 1.1;
+
 }  // namespace
 
 DeviceCompilationProfiler::~DeviceCompilationProfiler() {
+  const std::string& autotune_dir =
+      GetMarkForCompilationPassFlags()->tf_xla_cluster_autotune_dir;
+  if (!autotune_dir.empty()) {
+    ClusterAutotuneResultMap results;
+    {
+      mutex_lock lock(mu_);
+      for (const auto& [cluster_name, stats] : cluster_compile_stats_) {
+        if (stats.tf_execution_count < kMinAutotuneSamplesPerMode ||
+            stats.xla_execution_count < kMinAutotuneSamplesPerMode) {
+          continue;
+        }
+        ClusterAutotuneResult result;
+        result.tf_time_us_per_execution =
+            stats.cumulative_tf_execution_time_us / stats.tf_execution_count;
+        result.xla_time_us_per_execution =
+            stats.cumulative_xla_execution_time_us / stats.xla_execution_count;
+        result.decluster = result.xla_time_us_per_execution >
+                           result.tf_time_us_per_execution * kDeclusterMargin;
+        results.emplace(cluster_name, result);
+      }
+    }
+    if (!results.empty()) {
+      Status status = SaveClusterAutotuneResults(autotune_dir, results);
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to persist cluster autotune results to "
+                     << autotune_dir << ": " << status;
+      }
+    }
+  }
+
   mutex_lock lock(mu_);
   cluster_compile_stats_.clear();
 }
@@ -94,6 +141,44 @@ void DeviceCompilationProfiler::RegisterExecution(
   RegisterExecutionForCluster(function, &it->second);
 }
 
+void DeviceCompilationProfiler::RegisterClusterRunStart(
+    const std::string& cluster_name, int64_t step_id) {
+  const uint64 start_us = Env::Default()->NowMicros();
+  mutex_lock lock(mu_);
+  if (pending_cluster_runs_.size() >= kMaxPendingClusterRuns) {
+    pending_cluster_runs_.clear();
+  }
+  pending_cluster_runs_[std::make_pair(cluster_name, step_id)] = start_us;
+}
+
+void DeviceCompilationProfiler::RegisterClusterRunEnd(
+    const std::string& cluster_name, int64_t step_id, bool used_xla) {
+  const uint64 end_us = Env::Default()->NowMicros();
+  mutex_lock lock(mu_);
+  auto pending_it =
+      pending_cluster_runs_.find(std::make_pair(cluster_name, step_id));
+  if (pending_it == pending_cluster_runs_.end()) {
+    // The start wasn't recorded (or a later output of the same cluster already
+    // consumed it); there is nothing to measure.
+    return;
+  }
+  const int64_t elapsed_us = end_us - pending_it->second;
+  pending_cluster_runs_.erase(pending_it);
+
+  auto it = cluster_compile_stats_.emplace(cluster_name, ClusterCompileStats{})
+                .first;
+  if (used_xla) {
+    ++it->second.xla_execution_count;
+    it->second.cumulative_xla_execution_time_us += elapsed_us;
+  } else {
+    ++it->second.tf_execution_count;
+    it->second.cumulative_tf_execution_time_us += elapsed_us;
+  }
+  VLOG(3) << "Cluster " << cluster_name << " ran through "
+          << (used_xla ? "XLA" : "the TF fallback path") << " in " << elapsed_us
+          << " us.";
+}
+
 Status DeviceCompilationProfiler::RegisterCompilation(
     const NameAttrList& function, int64_t compile_time_us,
     bool used_persistent_cache) {
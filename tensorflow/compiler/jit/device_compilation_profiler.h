@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <string>
+#include <utility>
 
 #include "tensorflow/compiler/jit/xla_compile_util.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
@@ -46,12 +47,26 @@ class DeviceCompilationProfiler : public ResourceBase {
     // tagged megamorphic, it stays megamorphic forever.
     bool is_megamorphic = false;
 
+    // Number of timed executions of the cluster through the TF fallback path
+    // and through XLA, together with the cumulative wall times. Used to decide
+    // whether the cluster should be formed again in subsequent runs (see
+    // cluster_autotuner.h).
+    int64_t tf_execution_count = 0;
+    int64_t cumulative_tf_execution_time_us = 0;
+    int64_t xla_execution_count = 0;
+    int64_t cumulative_xla_execution_time_us = 0;
+
     std::string DebugString() const {
       return absl::StrCat(
           "DeviceCompilationProfiler::ClusterCompileStats {compile_count=",
           compile_count, ", execution_count=", execution_count,
           ", cumulative_compile_time_us=", cumulative_compile_time_us,
-          ", is_megamorphic=", is_megamorphic, "}");
+          ", is_megamorphic=", is_megamorphic,
+          ", tf_execution_count=", tf_execution_count,
+          ", cumulative_tf_execution_time_us=", cumulative_tf_execution_time_us,
+          ", xla_execution_count=", xla_execution_count,
+          ", cumulative_xla_execution_time_us=",
+          cumulative_xla_execution_time_us, "}");
     }
   };
 
@@ -71,6 +86,22 @@ class DeviceCompilationProfiler : public ResourceBase {
   // sets the megamorphic bit accordingly).
   void RegisterExecution(const NameAttrList& function);
 
+  // Records that an execution of `cluster_name` has started in the step
+  // identified by `step_id`. The matching `RegisterClusterRunEnd` call
+  // attributes the elapsed wall time to either the TF fallback path or XLA.
+  // Used by the cluster autotuner (see cluster_autotuner.h); the recorded
+  // times are persisted when this profiler is destroyed if the
+  // tf_xla_cluster_autotune_dir flag is set.
+  void RegisterClusterRunStart(const std::string& cluster_name,
+                               int64_t step_id);
+
+  // Records that the execution of `cluster_name` started in step `step_id` has
+  // finished and accumulates the elapsed wall time into the cluster's TF or
+  // XLA runtime stats. A no-op if no matching `RegisterClusterRunStart` was
+  // recorded.
+  void RegisterClusterRunEnd(const std::string& cluster_name, int64_t step_id,
+                             bool used_xla);
+
   // Registers a cluster compilation. Increments the compilation count and
   // accumulates the compile time for the given cluster. Also broadcasts an
   // XlaJitCompilationActivity.
@@ -90,6 +121,11 @@ class DeviceCompilationProfiler : public ResourceBase {
   absl::flat_hash_map<std::string, ClusterCompileStats> cluster_compile_stats_
       TF_GUARDED_BY(mu_);
 
+  // Maps {cluster name, step id} to the start timestamp (in microseconds) of
+  // an in-flight cluster execution.
+  absl::flat_hash_map<std::pair<std::string, int64_t>, uint64>
+      pending_cluster_runs_ TF_GUARDED_BY(mu_);
+
   int64_t num_ongoing_compilations_ TF_GUARDED_BY(mu_) = 0;
 
   DeviceCompilationProfiler(const DeviceCompilationProfiler&) = delete;
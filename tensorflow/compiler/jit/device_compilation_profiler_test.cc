@@ -42,6 +42,40 @@ TEST(DeviceCompilationProfilerTest, RegisterExecution) {
   EXPECT_EQ(stats.execution_count, 5);
 }
 
+TEST(DeviceCompilationProfilerTest, RegisterClusterRuns) {
+  DeviceCompilationProfiler* profiler = new DeviceCompilationProfiler();
+  core::ScopedUnref profiler_ref(profiler);
+
+  NameAttrList function;
+  function.set_name("TestFunc");
+
+  profiler->RegisterClusterRunStart(function.name(), /*step_id=*/0);
+  profiler->RegisterClusterRunEnd(function.name(), /*step_id=*/0,
+                                  /*used_xla=*/false);
+  profiler->RegisterClusterRunStart(function.name(), /*step_id=*/1);
+  profiler->RegisterClusterRunEnd(function.name(), /*step_id=*/1,
+                                  /*used_xla=*/true);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto stats, profiler->GetCompileStats(function));
+  EXPECT_EQ(stats.tf_execution_count, 1);
+  EXPECT_EQ(stats.xla_execution_count, 1);
+  EXPECT_GE(stats.cumulative_tf_execution_time_us, 0);
+  EXPECT_GE(stats.cumulative_xla_execution_time_us, 0);
+}
+
+TEST(DeviceCompilationProfilerTest, RegisterClusterRunEndWithoutStart) {
+  DeviceCompilationProfiler* profiler = new DeviceCompilationProfiler();
+  core::ScopedUnref profiler_ref(profiler);
+
+  NameAttrList function;
+  function.set_name("TestFunc");
+
+  // An end without a matching start must not record anything.
+  profiler->RegisterClusterRunEnd(function.name(), /*step_id=*/0,
+                                  /*used_xla=*/true);
+  EXPECT_FALSE(profiler->GetCompileStats(function).ok());
+}
+
 TEST(DeviceCompilationProfilerTest, RegisterCompilation) {
   DeviceCompilationProfiler* profiler = new DeviceCompilationProfiler();
   core::ScopedUnref profiler_ref(profiler);
@@ -92,7 +92,10 @@ class DeviceCompiler : public ResourceBase {
   // and `out_executable`.  If `compile_mode` is `kStrict` then the compilation
   // cache always attempts the compilation on a cache miss. If compilation mode
   // is 'kAsync' compilation of the cluster happens in the background while the
-  // fallback path executes.
+  // fallback path executes; once the background compilation finishes, the
+  // executable is stored in the cache and picked up by subsequent requests.
+  // A `kStrict` request that races with such a background compilation blocks
+  // until it completes instead of observing a null executable.
   //
   // The result of compilation is written to `*out_compilation_result`, which
   // must be non-null. If `out_executable` is non-null, also builds an
@@ -385,10 +388,12 @@ Status DeviceCompiler<ExecutableType, ClientType>::CompileAsynchronous(
     VLOG(2) << "Finished asynchronous compililation of cluster "
             << function_name << '.';
     profiler->DecrementOngoingAsyncCompilations();
-    // Update compilation status in cache.
+    // Update compilation status in cache. Move the entry to a terminal state
+    // so that requests waiting for this compilation observe the error instead
+    // of a perpetually kCompiling entry.
     if (!s.ok()) {
-      cache_->Store(signature, std::nullopt, s.status(), std::nullopt,
-                    std::nullopt);
+      cache_->Store(signature, DeviceCompileState::kCompiled, s.status(),
+                    std::nullopt, std::nullopt);
     }
   });
   return absl::OkStatus();
@@ -485,9 +490,19 @@ Status DeviceCompiler<ExecutableType, ClientType>::CompileImpl(
                         cache_value, scope, ctx, profiler, cluster_mutex));
     }
   } else if (state == DeviceCompileState::kCompiling) {
-    VLOG(2) << "Ongoing asynchronous compilation for signature: "
-            << human_signature;
-    return absl::OkStatus();
+    if (compile_mode == DeviceCompileMode::kStrict) {
+      // A strict request has no fallback path, so instead of observing a null
+      // executable while a background compilation of the same signature is in
+      // flight, wait for that compilation to finish and swap in whatever it
+      // stores.
+      VLOG(2) << "Waiting for ongoing asynchronous compilation for signature: "
+              << human_signature;
+      cache_value = cache_->LookupOrCreateWhenNotCompiling(signature);
+    } else {
+      VLOG(2) << "Ongoing asynchronous compilation for signature: "
+              << human_signature;
+      return absl::OkStatus();
+    }
   } else if (state == DeviceCompileState::kCompiled) {
     VLOG(2) << "Already Compiled for signature: " << human_signature;
   }
@@ -31,6 +31,7 @@ limitations under the License.
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/public/version.h"
 #include "tsl/platform/statusor.h"
 
 namespace tensorflow {
@@ -181,6 +182,9 @@ std::string DeviceExecutablePersistor<ExecutableType, ClientType>::
       key.signature_fingerprint(), kXlaSerializedCacheKeySeparator,
       key.cluster_fingerprint(), kXlaSerializedCacheKeySeparator,
       key.device_type(),
+      key.tf_version().empty()
+          ? ""
+          : absl::StrCat(kXlaSerializedCacheKeySeparator, key.tf_version()),
       key.compiled_using_pjrt()
           ? absl::StrCat(kXlaSerializedCacheKeySeparator, "pjrt")
           : "");
@@ -205,6 +209,11 @@ DeviceExecutablePersistor<ExecutableType, ClientType>::BuildSerializedCacheKey(
   key.set_device_type(device_type().type_string());
   key.set_prefix(persistence_prefix());
   key.set_compiled_using_pjrt(compiled_using_pjrt);
+  // Serialized executables are only valid for the exact version that wrote
+  // them, so the version participates in the key (and therefore in the file
+  // name), letting several versions share one cache directory across
+  // processes.
+  key.set_tf_version(TF_VERSION_STRING);
   return key;
 }
 
@@ -40,6 +40,7 @@ limitations under the License.
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/status_matchers.h"
 #include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/public/version.h"
 #include "tensorflow/core/tfrt/common/create_pjrt_client_util.h"
 #include "tensorflow/core/tfrt/common/pjrt_util.h"
 
@@ -203,6 +204,9 @@ std::string GetFilePath(XlaSerializedCacheKey key,
       key.signature_fingerprint(), kXlaSerializedCacheKeySeparator,
       key.cluster_fingerprint(), kXlaSerializedCacheKeySeparator,
       key.device_type(),
+      key.tf_version().empty()
+          ? ""
+          : absl::StrCat(kXlaSerializedCacheKeySeparator, key.tf_version()),
       key.compiled_using_pjrt()
           ? absl::StrCat(kXlaSerializedCacheKeySeparator, "pjrt")
           : "",
@@ -231,6 +235,7 @@ XlaSerializedCacheKey CreateCacheKey(
   key.set_device_type(device_type.type_string());
   key.set_prefix(persistence_prefix);
   key.set_compiled_using_pjrt(compiled_using_pjrt);
+  key.set_tf_version(TF_VERSION_STRING);
   return key;
 }
 
@@ -580,6 +585,42 @@ TEST_F(DeviceExecutionPersistorTest, LoadSerializedExecutableEmpty) {
               testing::StatusIs(error::INVALID_ARGUMENT));
 }
 
+TEST_F(DeviceExecutionPersistorTest, LoadTfVersionMismatch) {
+  XlaDeviceExecutablePersistor::Config config(
+      /*persistent_cache_directory=*/cache_dir_,
+      /*disable_strict_signature_checks=*/false,
+      /*persistence_prefix=*/"xla");
+  XlaDeviceExecutablePersistor persistor(config,
+                                         DefaultXlaOptions().device_type);
+
+  auto key =
+      CreateCacheKey(/*signature_hash=*/123, compilation_result_add_,
+                     persistor.device_type(), persistor.persistence_prefix());
+
+  // Re-home the persisted entry under a key claiming another TF version.
+  // Since the version participates in the file name, the running version's
+  // lookup misses the stale entry instead of loading it.
+  XlaSerializedCacheEntry entry;
+  TF_ASSERT_OK(ReadTextOrBinaryProto(
+      Env::Default(), GetFilePath(key, persistor.persistent_cache_directory()),
+      &entry));
+  auto stale_key = key;
+  stale_key.set_tf_version("0.0.0");
+  *entry.mutable_key() = stale_key;
+  TF_ASSERT_OK(Env::Default()->DeleteFile(
+      GetFilePath(key, persistor.persistent_cache_directory())));
+  TF_ASSERT_OK(WriteBinaryProto(
+      Env::Default(),
+      GetFilePath(stale_key, persistor.persistent_cache_directory()), entry));
+
+  MockXlaCompilerClient mock_client;
+  auto loaded_executable = persistor.TryToLoadExecutable(
+      /*signature_hash=*/123, "signature", DefaultXlaOptions(),
+      compilation_result_add_, &mock_client);
+
+  EXPECT_FALSE(loaded_executable.has_value());
+}
+
 TEST_F(DeviceExecutionPersistorTest, PersistPjRtAndXlaExecutables) {
   // Persist PJRT executable.
   PjRtDeviceExecutablePersistor::Config pjrt_config(
@@ -159,6 +159,13 @@ void AppendMarkForCompilationPassFlagsInternal(std::vector<Flag>* flag_list) {
            &mark_for_compilation_flags->tf_xla_persistent_cache_directory,
            "If non-empty, JIT-compiled executables are saved to and loaded "
            "from the specified file system directory path. Empty by default."),
+      Flag("tf_xla_cluster_autotune_dir",
+           &mark_for_compilation_flags->tf_xla_cluster_autotune_dir,
+           "If non-empty, measured TF-vs-XLA cluster runtimes are persisted "
+           "to the specified directory and clusters that executed slower "
+           "through XLA are not re-clustered in subsequent runs. Use "
+           "together with tf_xla_deterministic_cluster_names. Empty by "
+           "default."),
       Flag("tf_xla_persistent_cache_device_types",
            &mark_for_compilation_flags->tf_xla_persistent_cache_device_types,
            "If non-empty, the persistent cache will only be used for the "
@@ -245,6 +252,7 @@ void AllocateAndParseFlags() {
   mark_for_compilation_flags->tf_xla_disable_strict_signature_checks = false;
   mark_for_compilation_flags->tf_xla_persistent_cache_prefix =
       "xla_compile_cache";
+  mark_for_compilation_flags->tf_xla_cluster_autotune_dir = "";
 
   device_flags = new XlaDeviceFlags;
   device_flags->tf_xla_compile_on_demand = false;
@@ -263,6 +271,7 @@ void AllocateAndParseFlags() {
   ops_flags = new XlaOpsCommonFlags;
   ops_flags->tf_xla_always_defer_compilation = false;
   ops_flags->tf_xla_async_compilation = false;
+  ops_flags->tf_xla_batch_dim_buckets = "";
   ops_flags->tf_xla_use_device_api.enabled_for_xla_launch_ = true;
   ops_flags->tf_xla_use_device_api.enabled_for_compile_on_demand_ = true;
   ops_flags->tf_xla_use_device_api.enabled_for_compile_and_run_ = true;
@@ -334,6 +343,17 @@ void AllocateAndParseFlags() {
             "When lazy compilation is enabled, asynchronous compilation starts "
             "the cluster compilation in the background, and the fallback path "
             "is executed until the compilation has finished."),
+       Flag("tf_xla_batch_dim_buckets", &ops_flags->tf_xla_batch_dim_buckets,
+            "Comma-separated, strictly increasing bucket boundaries for the "
+            "leading (batch) dimension of XLA cluster inputs, e.g. "
+            "\"8,16,32,64\". When non-empty, XlaLaunch rounds the shared "
+            "leading dimension of the cluster's runtime parameters up to the "
+            "next boundary before compiling, zero-pads the inputs and slices "
+            "the outputs back, so variable-length workloads converge to one "
+            "executable per bucket. Only sound for clusters that compute "
+            "their outputs row-wise over the leading dimension and do not "
+            "update resource variables. Empty (the default) disables "
+            "bucketing."),
        Flag("tf_xla_use_device_api_for_xla_launch",
             &ops_flags->tf_xla_use_device_api.enabled_for_xla_launch_,
             "If true, uses Device API (PjRt) for single device compilation and "
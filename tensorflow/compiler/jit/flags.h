@@ -111,6 +111,14 @@ struct MarkForCompilationPassFlags {
 
   // Specifies the persistance cache prefix. Default is "xla_compile_cache"
   string tf_xla_persistent_cache_prefix;
+
+  // If non-empty, measured TF-vs-XLA cluster runtimes are persisted to the
+  // specified directory and de-clustering verdicts are read back from it.
+  // Clusters that executed slower through XLA than through the TF fallback
+  // path are not re-clustered in subsequent runs. Should be used together
+  // with tf_xla_deterministic_cluster_names so that verdicts stay keyed to
+  // the same clusters across runs.
+  std::string tf_xla_cluster_autotune_dir;
 };
 
 // Flags associated with XLA Sparse Core.
@@ -152,6 +160,19 @@ struct XlaOpsCommonFlags {
   // the main execution. The fallback path is taken while compilation happens.
   bool tf_xla_async_compilation;
 
+  // Comma-separated, strictly increasing list of bucket boundaries for the
+  // leading ("batch") dimension of XLA cluster inputs, e.g. "8,16,32,64".
+  // When non-empty, XlaLaunch rounds the shared leading dimension of a
+  // cluster's runtime parameters up to the next boundary before compiling,
+  // zero-pads the inputs to the bucketed size and slices outputs back
+  // afterwards, so variable-length workloads converge to one executable per
+  // bucket instead of recompiling per batch size. Only sound for clusters
+  // whose outputs are computed row-wise over the leading dimension (no
+  // reductions or normalization across the batch) and which do not update
+  // resource variables; the caller opts in to that contract by setting the
+  // flag. Empty (the default) disables bucketing.
+  std::string tf_xla_batch_dim_buckets;
+
   class PjRtForSingleDeviceCompilationRollout {
    public:
     // Allow using Device API (PjRt) for `device_type` in the XlaLaunch op.
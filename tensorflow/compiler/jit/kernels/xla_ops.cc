@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/compiler/jit/kernels/xla_ops.h"
 
+#include <cstring>
 #include <functional>
 #include <map>
 #include <memory>
@@ -24,7 +25,9 @@ limitations under the License.
 #include <string_view>
 #include <tuple>
 #include <utility>
+#include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -35,6 +38,7 @@ limitations under the License.
 #include "tensorflow/compiler/jit/encapsulate_subgraphs_pass.h"
 #include "tensorflow/compiler/jit/flags.h"
 #include "tensorflow/compiler/jit/pjrt_compile_util.h"
+#include "tensorflow/compiler/jit/shape_bucketing.h"
 #include "tensorflow/compiler/jit/variable_info.h"
 #include "tensorflow/compiler/jit/variable_info_util.h"
 #include "tensorflow/compiler/jit/xla_activity_listener.h"
@@ -342,6 +346,86 @@ absl::StatusOr<xla::ExecutionOutput> RunExecutable(
   return execution_output;
 }
 
+// Applies the tf_xla_batch_dim_buckets flag to `args`, in place. Returns the
+// bucketing decision, or std::nullopt when bucketing is disabled or does not
+// apply to this launch (see ApplyBatchDimBucketing).
+absl::StatusOr<std::optional<BatchDimBucketing>> MaybeApplyBatchDimBucketing(
+    const XlaPlatformInfo& platform_info,
+    std::vector<XlaCompiler::Argument>* args) {
+  const std::string& spec = GetXlaOpsCommonFlags()->tf_xla_batch_dim_buckets;
+  if (spec.empty()) return {std::nullopt};
+  // The padding below produces plain device tensors; the XLA-device path
+  // expects XlaTensors carrying shaped buffers and is not supported.
+  if (platform_info.is_on_xla_device()) return {std::nullopt};
+  TF_ASSIGN_OR_RETURN(std::vector<int64_t> buckets,
+                      ParseBatchDimBuckets(spec));
+  return ApplyBatchDimBucketing(buckets, args);
+}
+
+// Allocates copies of the inputs listed in `bucketing`, zero-padded in the
+// leading dimension to the bucketed batch size, and returns them in
+// `padded_storage` with a corresponding arg-number map in `padded_inputs`.
+// Tensors are laid out with the leading dimension outermost, so the original
+// input occupies a prefix of the padded buffer; the remainder is zero-filled
+// to keep the executable's results deterministic.
+Status PadInputsForBatchDimBucketing(
+    OpKernelContext* ctx, const BatchDimBucketing& bucketing,
+    std::vector<Tensor>* padded_storage,
+    std::map<int, const Tensor*>* padded_inputs) {
+  se::Stream* stream = GetStream(ctx);
+  padded_storage->reserve(bucketing.padded_arg_indices.size());
+  for (int arg_num : bucketing.padded_arg_indices) {
+    const Tensor& input = ctx->input(arg_num);
+    if (!DataTypeCanUseMemcpy(input.dtype())) {
+      return errors::InvalidArgument(
+          "tf_xla_batch_dim_buckets does not support padding inputs of type ",
+          DataTypeString(input.dtype()));
+    }
+    TensorShape padded_shape = input.shape();
+    padded_shape.set_dim(0, bucketing.bucketed_batch_dim);
+    Tensor padded;
+    TF_RETURN_IF_ERROR(
+        ctx->allocate_temp(input.dtype(), padded_shape, &padded));
+    char* padded_base = const_cast<char*>(padded.tensor_data().data());
+    const size_t input_bytes = input.TotalBytes();
+    if (stream) {
+      se::DeviceMemoryBase dst(padded_base, padded.TotalBytes());
+      TF_RETURN_IF_ERROR(stream->MemZero(&dst, padded.TotalBytes()));
+      if (input_bytes > 0) {
+        se::DeviceMemoryBase src(
+            const_cast<char*>(input.tensor_data().data()), input_bytes);
+        se::DeviceMemoryBase dst_prefix = dst.GetByteSlice(0, input_bytes);
+        TF_RETURN_IF_ERROR(stream->Memcpy(&dst_prefix, src, input_bytes));
+      }
+    } else {
+      std::memset(padded_base, 0, padded.TotalBytes());
+      if (input_bytes > 0) {
+        std::memcpy(padded_base, input.tensor_data().data(), input_bytes);
+      }
+    }
+    padded_storage->push_back(std::move(padded));
+  }
+  // The map points into `padded_storage`; fill it only once the vector has
+  // stopped reallocating.
+  for (int i = 0; i < bucketing.padded_arg_indices.size(); ++i) {
+    (*padded_inputs)[bucketing.padded_arg_indices[i]] = &(*padded_storage)[i];
+  }
+  return absl::OkStatus();
+}
+
+// Slices outputs that were computed at the bucketed batch size back to the
+// original batch size. Slicing the leading dimension only rewrites tensor
+// metadata; the underlying buffer is shared, so no copy is made.
+void SliceOutputsForBatchDimBucketing(OpKernelContext* ctx,
+                                      const BatchDimBucketing& bucketing) {
+  for (int i = 0; i < ctx->num_outputs(); ++i) {
+    Tensor* output = ctx->mutable_output(i);
+    if (output == nullptr || output->dims() < 1) continue;
+    if (output->dim_size(0) != bucketing.bucketed_batch_dim) continue;
+    ctx->set_output(i, output->Slice(0, bucketing.original_batch_dim));
+  }
+}
+
 absl::StatusOr<
     std::pair<std::vector<XlaCompiler::Argument>, ResourceVarsSnapshot>>
 GetXlaCompilerArgsAndSnapshotVariables(
@@ -526,6 +610,20 @@ void XlaLocalLaunchBase::ComputeAsync(OpKernelContext* ctx, DoneCallback done) {
   bool use_pjrt = GetXlaOpsCommonFlags()
                       ->tf_xla_use_device_api.IsEnabledInXlaLaunchForDevice(
                           platform_info_.device_type());
+
+  std::optional<BatchDimBucketing> batch_dim_bucketing;
+  if (!use_pjrt) {
+    auto bucketing_or =
+        MaybeApplyBatchDimBucketing(platform_info_, &xla_compiler_args);
+    OP_REQUIRES_OK_ASYNC(ctx, bucketing_or.status(), done);
+    batch_dim_bucketing = *bucketing_or;
+    if (batch_dim_bucketing.has_value()) {
+      VLOG(2) << "Bucketing batch dimension of " << function_.name()
+              << " from " << batch_dim_bucketing->original_batch_dim << " to "
+              << batch_dim_bucketing->bucketed_batch_dim;
+    }
+  }
+
   if (use_pjrt) {
     VLOG(2) << "Compiling using PJRT";
     Status status = CompileToPjRtLoadedExecutable(
@@ -576,9 +674,26 @@ void XlaLocalLaunchBase::ComputeAsync(OpKernelContext* ctx, DoneCallback done) {
       &executable);
   OP_REQUIRES_OK_ASYNC(ctx, status, done);
 
+  if (batch_dim_bucketing.has_value()) {
+    // Bucketed execution writes back values computed at the padded batch
+    // size, so clusters that update resource variables are not supported.
+    OP_REQUIRES_ASYNC(
+        ctx,
+        absl::c_none_of(compilation_result->resource_updates,
+                        [](const XlaCompiler::ResourceUpdate& update) {
+                          return update.modified;
+                        }),
+        errors::InvalidArgument(
+            "tf_xla_batch_dim_buckets is not supported for clusters that "
+            "update resource variables: ",
+            function_.name()),
+        done);
+  }
+
   // Continuation of the execution, may be run in a different thread.
   auto run_xla_cluster = [ctx, client, executable, compilation_result, done,
-                          inputs, resources = resources_]() {
+                          inputs, resources = resources_,
+                          bucketing = batch_dim_bucketing]() {
     // Separate scope so that VariableInfo locks are released before done is
     // called.
     {
@@ -601,12 +716,24 @@ void XlaLocalLaunchBase::ComputeAsync(OpKernelContext* ctx, DoneCallback done) {
       XlaComputationLaunchContext launch_context =
           GetLaunchContext(platform_info, ctx, client, allocator.get());
 
+      std::vector<Tensor> padded_input_storage;
+      std::map<int, const Tensor*> padded_inputs;
+      if (bucketing.has_value()) {
+        OP_REQUIRES_OK_ASYNC(
+            ctx,
+            PadInputsForBatchDimBucketing(ctx, *bucketing,
+                                          &padded_input_storage,
+                                          &padded_inputs),
+            done);
+      }
+
       const xla::HloInputOutputAliasConfig& input_output_alias =
           executable->executable()->module().input_output_alias_config();
       absl::StatusOr<std::vector<xla::ExecutionInput>> execution_inputs =
           launch_context.PopulateInputs(
               ctx, compilation_result, resource_var_ptrs,
-              /*missing_ctx_input_prefix=*/0, input_output_alias);
+              /*missing_ctx_input_prefix=*/0, input_output_alias,
+              padded_inputs);
       OP_REQUIRES_OK_ASYNC(ctx, execution_inputs.status(), done);
 
       xla::gpu::GpuExecutableRunOptions gpu_options;
@@ -640,6 +767,9 @@ void XlaLocalLaunchBase::ComputeAsync(OpKernelContext* ctx, DoneCallback done) {
               /*missing_ctx_input_prefix=*/0, absl::MakeSpan(variable_infos),
               input_output_alias, resource_var_ptrs),
           done);
+      if (bucketing.has_value()) {
+        SliceOutputsForBatchDimBucketing(ctx, *bucketing);
+      }
       VLOG(1) << "Done";
     }
     done();
@@ -714,6 +844,55 @@ class XlaLaunchV2Op : public XlaLocalLaunchBase {
                            /*has_ref_vars=*/true) {}
 };
 
+// Looks up (or creates) the DeviceCompilationProfiler for `ctx`'s device. The
+// profiler is owned by the resource manager; the caller must unref it.
+Status GetOrCreateProfiler(OpKernelContext* ctx,
+                           DeviceCompilationProfiler** profiler) {
+  ResourceMgr* rm = ctx->resource_manager();
+  if (!rm) {
+    return absl::InternalError("No resource manager.");
+  }
+  return rm->LookupOrCreate<DeviceCompilationProfiler>(
+      rm->default_container(), "device_compilation_profiler", profiler,
+      [](DeviceCompilationProfiler** profiler) {
+        *profiler = new DeviceCompilationProfiler();
+        return absl::OkStatus();
+      });
+}
+
+// Reports the start of an execution of cluster `function` to the
+// DeviceCompilationProfiler so that the downstream _XlaMerge op can attribute
+// the elapsed wall time to either the TF fallback path or XLA. A no-op unless
+// the cluster autotuner is enabled.
+void MaybeRegisterClusterRunStart(OpKernelContext* ctx,
+                                  const NameAttrList& function) {
+  if (GetMarkForCompilationPassFlags()->tf_xla_cluster_autotune_dir.empty()) {
+    return;
+  }
+  DeviceCompilationProfiler* profiler;
+  Status status = GetOrCreateProfiler(ctx, &profiler);
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to look up DeviceCompilationProfiler: " << status;
+    return;
+  }
+  core::ScopedUnref profiler_ref(profiler);
+  profiler->RegisterClusterRunStart(function.name(), ctx->step_id());
+}
+
+// The _XlaMerge counterpart of `MaybeRegisterClusterRunStart`.
+void MaybeRegisterClusterRunEnd(OpKernelContext* ctx,
+                                const std::string& cluster_name,
+                                bool used_xla) {
+  DeviceCompilationProfiler* profiler;
+  Status status = GetOrCreateProfiler(ctx, &profiler);
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to look up DeviceCompilationProfiler: " << status;
+    return;
+  }
+  core::ScopedUnref profiler_ref(profiler);
+  profiler->RegisterClusterRunEnd(cluster_name, ctx->step_id(), used_xla);
+}
+
 }  // namespace
 
 XlaLocalLaunchOp::XlaLocalLaunchOp(OpKernelConstruction* ctx)
@@ -821,6 +1000,8 @@ void XlaCompileOp::Compute(OpKernelContext* ctx) {
     compilation_successful.scalar<bool>()() = false;
     ctx->set_output(0, compilation_key);
     ctx->set_output(1, compilation_successful);
+    // The TF fallback path will run this cluster; let the autotuner time it.
+    MaybeRegisterClusterRunStart(ctx, function_);
     return;
   }
 
@@ -850,6 +1031,11 @@ void XlaCompileOp::Compute(OpKernelContext* ctx) {
 
   ctx->set_output(0, compilation_key);
   ctx->set_output(1, compilation_successful);
+  // _XlaRun will run this cluster; let the autotuner time it. Strict clusters
+  // have no merge node downstream, so there is nothing to measure against.
+  if (!must_compile_) {
+    MaybeRegisterClusterRunStart(ctx, function_);
+  }
 }
 
 XlaRunOp::XlaRunOp(OpKernelConstruction* ctx)
@@ -971,13 +1157,24 @@ void XlaRunOp::Compute(OpKernelContext* ctx) {
           absl::MakeSpan(*variable_infos), input_output_alias, snapshot_ptrs));
 }
 
-XlaMergeOp::XlaMergeOp(OpKernelConstruction* ctx) : OpKernel(ctx) {}
+XlaMergeOp::XlaMergeOp(OpKernelConstruction* ctx) : OpKernel(ctx) {
+  // The attr is absent in graphs produced before the cluster autotuner
+  // existed.
+  if (!ctx->GetAttr("cluster_name", &cluster_name_).ok()) {
+    cluster_name_.clear();
+  }
+}
 
 void XlaMergeOp::Compute(OpKernelContext* ctx) {
   VLOG(3) << "XlaMergeOp " << def().name();
   int i = 0;
   if (ctx->has_input(i) || ctx->has_input(++i)) {
     ctx->set_output(0, ctx->input(i));
+    if (!cluster_name_.empty()) {
+      // Input 0 is the TF fallback (PartitionedCall) output, input 1 the
+      // _XlaRun output.
+      MaybeRegisterClusterRunEnd(ctx, cluster_name_, /*used_xla=*/i == 1);
+    }
   }
 }
 
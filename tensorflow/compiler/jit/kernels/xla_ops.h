@@ -133,6 +133,13 @@ class XlaMergeOp : public OpKernel {
   explicit XlaMergeOp(OpKernelConstruction* ctx);
 
   void Compute(OpKernelContext* ctx) override;
+
+ private:
+  // If non-empty, the name of the cluster whose TF-fallback and XLA outputs
+  // this op merges. Set by BuildXlaOpsPass when the cluster autotuner is
+  // enabled; the op then reports which path produced the live input (and how
+  // long the execution took) to the DeviceCompilationProfiler.
+  std::string cluster_name_;
 };
 
 }  // namespace tensorflow
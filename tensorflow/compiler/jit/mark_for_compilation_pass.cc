@@ -35,6 +35,7 @@ limitations under the License.
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_join.h"
+#include "tensorflow/compiler/jit/cluster_autotuner.h"
 #include "tensorflow/compiler/jit/compilability_check_util.h"
 #include "tensorflow/compiler/jit/deadness_analysis.h"
 #include "tensorflow/compiler/jit/defs.h"
@@ -1007,6 +1008,13 @@ Status MarkForCompilationPassImpl::CreateClusters() {
                         GetNextClusterSequenceNumber(graph_fingerprint_));
       }
 
+      if (ShouldDeclusterFromAutotuneResults(name)) {
+        VLOG(2) << "Not assigning node " << n->name() << " to cluster " << name
+                << " because the cluster autotuner found the cluster "
+                << "unprofitable under XLA.";
+        continue;
+      }
+
       n->AddAttr(kXlaClusterAttr, name);
       n->AddAttr(kXlaAlreadyClustered, true);
       VLOG(3) << "Assigning node " << n->name() << " to cluster " << name;
@@ -110,6 +110,7 @@ REGISTER_OP("_XlaMerge")
     .Input("xla_run: T")
     .Output("output: T")
     .Attr("T: type")
+    .Attr("cluster_name: string = ''")
     .SetShapeFn([](InferenceContext* c) {
       c->set_output(0, c->input(0));
       return absl::OkStatus();
@@ -122,6 +123,9 @@ placed on the host, the _XlaMerge op can merge inputs of all types when
 placed on the device. This prevents the need for copy operations, in
 particular when an XLA cluster has int32 outputs. The _XlaMerge up does not
 have a value_index output that identifies the chosen input.
+
+If cluster_name is non-empty, the op reports which of the two paths produced
+the live input (and when) to the cluster autotuner.
 )");
 
 }  // namespace tensorflow
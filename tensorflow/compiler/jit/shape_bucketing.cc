@@ -0,0 +1,99 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/compiler/jit/shape_bucketing.h"
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "absl/types/variant.h"
+#include "tensorflow/compiler/tf2xla/xla_compiler.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/statusor.h"
+
+namespace tensorflow {
+
+absl::StatusOr<std::vector<int64_t>> ParseBatchDimBuckets(
+    absl::string_view spec) {
+  std::vector<int64_t> buckets;
+  for (absl::string_view piece : absl::StrSplit(spec, ',')) {
+    int64_t boundary;
+    if (!absl::SimpleAtoi(piece, &boundary) || boundary <= 0) {
+      return errors::InvalidArgument(
+          "Malformed bucket boundary '", piece, "' in bucket list '", spec,
+          "'; expected a positive integer.");
+    }
+    if (!buckets.empty() && boundary <= buckets.back()) {
+      return errors::InvalidArgument(
+          "Bucket boundaries must be strictly increasing, got '", spec, "'.");
+    }
+    buckets.push_back(boundary);
+  }
+  return buckets;
+}
+
+int64_t RoundUpToBucket(int64_t dim, absl::Span<const int64_t> buckets) {
+  for (int64_t boundary : buckets) {
+    if (boundary >= dim) return boundary;
+  }
+  return dim;
+}
+
+std::optional<BatchDimBucketing> ApplyBatchDimBucketing(
+    absl::Span<const int64_t> buckets,
+    std::vector<XlaCompiler::Argument>* args) {
+  if (buckets.empty()) return std::nullopt;
+
+  int64_t batch_dim = -1;
+  std::vector<int> parameter_indices;
+  for (int i = 0; i < args->size(); ++i) {
+    const XlaCompiler::Argument& arg = (*args)[i];
+    if (arg.kind != XlaCompiler::Argument::kParameter) continue;
+    // Bucketing rewrites the TensorFlow shape of the argument; parameters
+    // described directly by an xla::Shape are opaque to it.
+    if (!absl::holds_alternative<TensorShape>(arg.shape)) return std::nullopt;
+    const TensorShape& shape = absl::get<TensorShape>(arg.shape);
+    if (shape.dims() < 1) continue;
+    if (batch_dim < 0) {
+      batch_dim = shape.dim_size(0);
+    } else if (shape.dim_size(0) != batch_dim) {
+      // The parameters don't agree on a common batch dimension, so there is
+      // no single dimension that can be padded consistently.
+      return std::nullopt;
+    }
+    parameter_indices.push_back(i);
+  }
+  if (parameter_indices.empty()) return std::nullopt;
+
+  const int64_t bucketed_dim = RoundUpToBucket(batch_dim, buckets);
+  if (bucketed_dim == batch_dim) return std::nullopt;
+
+  for (int i : parameter_indices) {
+    TensorShape shape = absl::get<TensorShape>((*args)[i].shape);
+    shape.set_dim(0, bucketed_dim);
+    (*args)[i].shape = std::move(shape);
+  }
+  return BatchDimBucketing{batch_dim, bucketed_dim,
+                           std::move(parameter_indices)};
+}
+
+}  // namespace tensorflow
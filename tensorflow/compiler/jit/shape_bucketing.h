@@ -0,0 +1,81 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_COMPILER_JIT_SHAPE_BUCKETING_H_
+#define TENSORFLOW_COMPILER_JIT_SHAPE_BUCKETING_H_
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tensorflow/compiler/tf2xla/xla_compiler.h"
+#include "tensorflow/core/platform/statusor.h"
+
+namespace tensorflow {
+
+// Shape bucketing rounds the leading ("batch") dimension of a cluster's
+// runtime parameters up to a configured bucket boundary before the
+// compilation signature is formed, so that variable-length workloads
+// converge to one executable per bucket instead of one per distinct batch
+// size. The caller is responsible for padding the corresponding input
+// tensors to the bucketed batch size before execution and for slicing
+// outputs back to the original batch size afterwards; see the
+// tf_xla_batch_dim_buckets flag for the semantic restrictions this
+// places on the cluster.
+
+// Describes a bucketing decision made for one compilation/execution of a
+// cluster.
+struct BatchDimBucketing {
+  // The leading dimension shared by all runtime parameters, as observed at
+  // execution time.
+  int64_t original_batch_dim;
+
+  // The bucket boundary `original_batch_dim` was rounded up to. Always
+  // strictly greater than `original_batch_dim`.
+  int64_t bucketed_batch_dim;
+
+  // Argument numbers (indices into the kernel's inputs) whose shapes were
+  // rewritten and whose tensors therefore need padding before execution.
+  std::vector<int> padded_arg_indices;
+};
+
+// Parses a comma-separated list of bucket boundaries (e.g. "8,16,32,64").
+// Boundaries must be positive and strictly increasing. Returns an
+// InvalidArgument error otherwise.
+absl::StatusOr<std::vector<int64_t>> ParseBatchDimBuckets(
+    absl::string_view spec);
+
+// Returns the smallest boundary in `buckets` that is >= `dim`, or `dim`
+// itself when `dim` exceeds the largest boundary. `buckets` must be sorted
+// in increasing order.
+int64_t RoundUpToBucket(int64_t dim, absl::Span<const int64_t> buckets);
+
+// Rounds the leading dimension of the kParameter arguments in `args` up to
+// the next boundary in `buckets`, in place, and returns a description of the
+// rewrite. Returns std::nullopt (and leaves `args` untouched) when bucketing
+// does not apply: there are no rank >= 1 runtime parameters, the parameters
+// do not all share the same leading dimension, a parameter carries an
+// xla::Shape rather than a TensorShape, or the shared leading dimension
+// already lies on a bucket boundary (or beyond the largest one). Constant
+// and resource arguments are never rewritten.
+std::optional<BatchDimBucketing> ApplyBatchDimBucketing(
+    absl::Span<const int64_t> buckets,
+    std::vector<XlaCompiler::Argument>* args);
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_COMPILER_JIT_SHAPE_BUCKETING_H_
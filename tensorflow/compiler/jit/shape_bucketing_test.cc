@@ -0,0 +1,147 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/compiler/jit/shape_bucketing.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/types/variant.h"
+#include "xla/shape_util.h"
+#include "tensorflow/compiler/tf2xla/xla_compiler.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+
+namespace tensorflow {
+namespace {
+
+using Argument = XlaCompiler::Argument;
+
+Argument Parameter(const TensorShape& shape) {
+  Argument arg;
+  arg.kind = Argument::kParameter;
+  arg.type = DT_FLOAT;
+  arg.shape = shape;
+  return arg;
+}
+
+TEST(ParseBatchDimBucketsTest, ParsesIncreasingList) {
+  TF_ASSERT_OK_AND_ASSIGN(std::vector<int64_t> buckets,
+                          ParseBatchDimBuckets("8,16,32"));
+  EXPECT_EQ(buckets, (std::vector<int64_t>{8, 16, 32}));
+}
+
+TEST(ParseBatchDimBucketsTest, RejectsMalformedInput) {
+  EXPECT_FALSE(ParseBatchDimBuckets("").ok());
+  EXPECT_FALSE(ParseBatchDimBuckets("8,banana").ok());
+  EXPECT_FALSE(ParseBatchDimBuckets("8,,32").ok());
+  EXPECT_FALSE(ParseBatchDimBuckets("0,8").ok());
+  EXPECT_FALSE(ParseBatchDimBuckets("-8,16").ok());
+}
+
+TEST(ParseBatchDimBucketsTest, RejectsNonIncreasingBoundaries) {
+  EXPECT_FALSE(ParseBatchDimBuckets("8,8").ok());
+  EXPECT_FALSE(ParseBatchDimBuckets("16,8").ok());
+}
+
+TEST(RoundUpToBucketTest, RoundsUpToNextBoundary) {
+  const std::vector<int64_t> buckets = {8, 16, 32};
+  EXPECT_EQ(RoundUpToBucket(1, buckets), 8);
+  EXPECT_EQ(RoundUpToBucket(8, buckets), 8);
+  EXPECT_EQ(RoundUpToBucket(9, buckets), 16);
+  EXPECT_EQ(RoundUpToBucket(32, buckets), 32);
+}
+
+TEST(RoundUpToBucketTest, LeavesDimBeyondLargestBoundaryAlone) {
+  const std::vector<int64_t> buckets = {8, 16, 32};
+  EXPECT_EQ(RoundUpToBucket(33, buckets), 33);
+}
+
+TEST(ApplyBatchDimBucketingTest, PadsSharedLeadingDim) {
+  std::vector<Argument> args = {Parameter(TensorShape({3, 7})),
+                                Parameter(TensorShape({3}))};
+  const std::vector<int64_t> buckets = {8, 16};
+
+  auto bucketing = ApplyBatchDimBucketing(buckets, &args);
+  ASSERT_TRUE(bucketing.has_value());
+  EXPECT_EQ(bucketing->original_batch_dim, 3);
+  EXPECT_EQ(bucketing->bucketed_batch_dim, 8);
+  EXPECT_EQ(bucketing->padded_arg_indices, (std::vector<int>{0, 1}));
+  EXPECT_EQ(absl::get<TensorShape>(args[0].shape), TensorShape({8, 7}));
+  EXPECT_EQ(absl::get<TensorShape>(args[1].shape), TensorShape({8}));
+}
+
+TEST(ApplyBatchDimBucketingTest, SkipsConstantsResourcesAndScalars) {
+  Argument constant;
+  constant.kind = Argument::kConstant;
+  constant.type = DT_INT32;
+  constant.shape = TensorShape({3});
+
+  Argument resource;
+  resource.kind = Argument::kResource;
+  resource.type = DT_FLOAT;
+  resource.shape = TensorShape({3, 7});
+
+  std::vector<Argument> args = {constant, Parameter(TensorShape({})),
+                                Parameter(TensorShape({3, 7})), resource};
+  const std::vector<int64_t> buckets = {8};
+
+  auto bucketing = ApplyBatchDimBucketing(buckets, &args);
+  ASSERT_TRUE(bucketing.has_value());
+  EXPECT_EQ(bucketing->padded_arg_indices, (std::vector<int>{2}));
+  EXPECT_EQ(absl::get<TensorShape>(args[0].shape), TensorShape({3}));
+  EXPECT_EQ(absl::get<TensorShape>(args[2].shape), TensorShape({8, 7}));
+  EXPECT_EQ(absl::get<TensorShape>(args[3].shape), TensorShape({3, 7}));
+}
+
+TEST(ApplyBatchDimBucketingTest, DeclinesMismatchedLeadingDims) {
+  std::vector<Argument> args = {Parameter(TensorShape({3, 7})),
+                                Parameter(TensorShape({5, 7}))};
+  const std::vector<int64_t> buckets = {8};
+
+  EXPECT_FALSE(ApplyBatchDimBucketing(buckets, &args).has_value());
+  EXPECT_EQ(absl::get<TensorShape>(args[0].shape), TensorShape({3, 7}));
+  EXPECT_EQ(absl::get<TensorShape>(args[1].shape), TensorShape({5, 7}));
+}
+
+TEST(ApplyBatchDimBucketingTest, DeclinesWhenAlreadyOnBoundary) {
+  std::vector<Argument> args = {Parameter(TensorShape({8, 7}))};
+  const std::vector<int64_t> buckets = {8, 16};
+
+  EXPECT_FALSE(ApplyBatchDimBucketing(buckets, &args).has_value());
+}
+
+TEST(ApplyBatchDimBucketingTest, DeclinesBeyondLargestBoundary) {
+  std::vector<Argument> args = {Parameter(TensorShape({17, 7}))};
+  const std::vector<int64_t> buckets = {8, 16};
+
+  EXPECT_FALSE(ApplyBatchDimBucketing(buckets, &args).has_value());
+}
+
+TEST(ApplyBatchDimBucketingTest, DeclinesXlaShapeParameters) {
+  Argument xla_shape_arg;
+  xla_shape_arg.kind = Argument::kParameter;
+  xla_shape_arg.type = DT_FLOAT;
+  xla_shape_arg.shape = xla::ShapeUtil::MakeShape(xla::F32, {3, 7});
+
+  std::vector<Argument> args = {Parameter(TensorShape({3, 7})), xla_shape_arg};
+  const std::vector<int64_t> buckets = {8};
+
+  EXPECT_FALSE(ApplyBatchDimBucketing(buckets, &args).has_value());
+}
+
+}  // namespace
+}  // namespace tensorflow
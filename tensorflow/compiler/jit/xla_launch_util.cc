@@ -37,6 +37,7 @@ limitations under the License.
 #include "xla/client/local_client.h"
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/pjrt/pjrt_common.h"
+#include "xla/pjrt/pjrt_compiler.h"
 #include "xla/pjrt/pjrt_future.h"
 #include "xla/pjrt/pjrt_stream_executor_client.h"
 #include "xla/pjrt/tracked_device_buffer.h"
@@ -153,7 +154,8 @@ XlaComputationLaunchContext::PopulateInputs(
     const XlaCompiler::CompilationResult* compilation_result,
     const std::map<int, const Tensor*>& resource_vars,
     int missing_ctx_input_prefix,
-    const xla::HloInputOutputAliasConfig& input_output_alias) {
+    const xla::HloInputOutputAliasConfig& input_output_alias,
+    const std::map<int, const Tensor*>& substitute_inputs) {
   std::vector<xla::ExecutionInput> arguments;
   arguments.reserve(compilation_result->xla_input_shapes.size());
 
@@ -176,9 +178,15 @@ XlaComputationLaunchContext::PopulateInputs(
                                 update.modified;
                        });
 
-    const Tensor* t = is_resource_variable
-                          ? resource_var_it->second
-                          : &(ctx->input(arg_num - missing_ctx_input_prefix));
+    const Tensor* t;
+    if (is_resource_variable) {
+      t = resource_var_it->second;
+    } else if (auto substitute_it = substitute_inputs.find(arg_num);
+               substitute_it != substitute_inputs.end()) {
+      t = substitute_it->second;
+    } else {
+      t = &(ctx->input(arg_num - missing_ctx_input_prefix));
+    }
     CHECK(t);
     bool donate_buffer =
         t->RefCountIsOne() && is_updated_resource_variable &&
@@ -605,6 +613,23 @@ XlaComputationLaunchContext::BuildXlaCompilerArguments(
   return out;
 }
 
+// Creates a PjRtBuffer that aliases the host memory of `tensor` without
+// copying it, for CPU-backed PjRt clients whose device memory is directly
+// addressable by the host. The buffer holds a reference on the tensor so the
+// memory stays alive until the runtime is done with the buffer.
+static absl::StatusOr<std::unique_ptr<xla::PjRtBuffer>>
+AliasHostTensorAsPjRtBuffer(const Tensor& tensor, xla::PjRtClient* pjrt_client,
+                            xla::PjRtDevice* pjrt_device) {
+  xla::Shape shape;
+  TF_RETURN_IF_ERROR(
+      TensorShapeToXLAShape(tensor.dtype(), tensor.shape(), &shape));
+  return pjrt_client->BufferFromHostBuffer(
+      tensor.data(), shape.element_type(), shape.dimensions(),
+      /*byte_strides=*/std::nullopt,
+      xla::PjRtClient::HostBufferSemantics::kImmutableZeroCopy,
+      /*on_done_with_host_buffer=*/[tensor]() {}, pjrt_device);
+}
+
 // TODO(b/289002708) Create a unit test to cover use_pjrt_tensor_buffer=true.
 Status PreparePjRtExecutableArguments(
     int num_missing_prefix_ctx_inputs, const std::vector<int>& input_mapping,
@@ -645,6 +670,17 @@ Status PreparePjRtExecutableArguments(
           dynamic_cast<const PjRtTensorBuffer*>(DMAHelper::buffer(tensor));
       if (pjrt_tensor_buffer != nullptr) {
         args->push_back(pjrt_tensor_buffer->pjrt_buffer());
+      } else if (pjrt_client->platform_id() == xla::CpuId()) {
+        // On CPU the tensor memory is directly addressable by the runtime, so
+        // alias it into a PjRtBuffer instead of copying.
+        TF_ASSIGN_OR_RETURN(
+            std::unique_ptr<xla::PjRtBuffer> pjrt_buffer,
+            AliasHostTensorAsPjRtBuffer(*tensor, pjrt_client, pjrt_device));
+        owned_args->push_back(std::move(pjrt_buffer));
+        args->push_back(owned_args->back().get());
+        // The aliased buffer borrows the tensor's memory and must not be
+        // donated to the computation.
+        non_donatable_input_indices->insert(args->size() - 1);
       } else {
         // Creates a PjRtBuffer from DeviceMemoryBase. The newly created
         // PjRtBuffer needs to be persisted till XLA execution is completed.
@@ -668,6 +704,24 @@ Status PreparePjRtExecutableArguments(
         owned_args->push_back(std::move(pjrt_buffer));
         args->push_back(owned_args->back().get());
       }
+    } else if (av_tensor == nullptr) {
+      // A plain host tensor produced by a regular TF CPU kernel feeding
+      // straight into the cluster. Alias its memory into a PjRtBuffer rather
+      // than copying every activation across the cluster boundary.
+      if (pjrt_client == nullptr ||
+          pjrt_client->platform_id() != xla::CpuId()) {
+        return absl::InvalidArgumentError(
+            "The input tensor is not an AsyncValueTensor and aliasing plain "
+            "host tensors is only supported on CPU.");
+      }
+      TF_ASSIGN_OR_RETURN(
+          std::unique_ptr<xla::PjRtBuffer> pjrt_buffer,
+          AliasHostTensorAsPjRtBuffer(*tensor, pjrt_client, pjrt_device));
+      owned_args->push_back(std::move(pjrt_buffer));
+      args->push_back(owned_args->back().get());
+      // The aliased buffer borrows the tensor's memory and must not be
+      // donated to the computation.
+      non_donatable_input_indices->insert(args->size() - 1);
     } else {
       if (av_tensor->GetBuffer() == nullptr) {
         CHECK_EQ(tensor->NumElements(), 0);  // Crash OK
@@ -848,9 +902,12 @@ Status RunPjRtExecutable(
     const XlaCompiler::CompilationResult& compilation_result,
     xla::PjRtClient* pjrt_client, xla::PjRtLoadedExecutable* executable,
     OpKernelContext* ctx) {
-  const bool use_pjrt_tensor_buffer = ctx->device()
-                                          ->tensorflow_accelerator_device_info()
-                                          ->use_pjrt_tensor_buffer;
+  // Plain CPU devices have no accelerator device info.
+  const auto* accelerator_device_info =
+      ctx->device()->tensorflow_accelerator_device_info();
+  const bool use_pjrt_tensor_buffer =
+      accelerator_device_info != nullptr &&
+      accelerator_device_info->use_pjrt_tensor_buffer;
 
   const DeviceType& device_type = GetDeviceType(ctx);
   TF_ASSIGN_OR_RETURN(const int pjrt_device_id,
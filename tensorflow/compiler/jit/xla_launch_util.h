@@ -71,13 +71,17 @@ Status SetOutputForConstant(
 // `non_donatable_input_indices` will also be set, which contains the indices of
 // the input that should not be donated to output.
 //
-// There can be three types of input: 1. Tensor with PjRtTensorBuffer; 2.
-// Tensor with AsyncValueTensor; 3. Tensor with raw device mem pointer.
+// There can be four types of input: 1. Tensor with PjRtTensorBuffer; 2.
+// Tensor with AsyncValueTensor; 3. Tensor with raw device mem pointer; 4.
+// plain host tensor on a CPU-backed PjRt client.
 // For case 3, we need to create a PjRtBuffer from the raw device mem pointer,
 // and we need to ensure the PjRtBuffer persists till XLA computation is
 // complete. Therefore we put the newly created PjRtBuffer into `owned_args`.
 // Caller is responsible to ensure `owned_args` lives till the end of XLA
 // computation.
+// For case 4, the host memory is aliased into a zero-copy PjRtBuffer which is
+// likewise placed in `owned_args`; the buffer is marked non-donatable since
+// it borrows the tensor's memory.
 Status PreparePjRtExecutableArguments(
     int num_missing_prefix_ctx_inputs, const std::vector<int>& input_mapping,
     const std::vector<const Tensor*>& inputs,
@@ -185,12 +189,19 @@ class XlaComputationLaunchContext {
   // missing and adjusts input indices accordingly.  All elements in kernel's
   // input_mapping must be greater than or equal to `missing_ctx_input_prefix`
   // (in other words, no inputs actually required by the kernel can be missing).
+  //
+  // `substitute_inputs` optionally maps TensorFlow argument numbers to
+  // tensors that are used in place of the corresponding `ctx` inputs, e.g.
+  // inputs padded to a bucketed batch size. The substitute tensors must match
+  // the shapes the executable was compiled for and must outlive the
+  // execution.
   absl::StatusOr<std::vector<xla::ExecutionInput>> PopulateInputs(
       OpKernelContext* ctx,
       const XlaCompiler::CompilationResult* compilation_result,
       const std::map<int, const Tensor*>& resource_vars,
       int missing_ctx_input_prefix,
-      const xla::HloInputOutputAliasConfig& input_output_alias);
+      const xla::HloInputOutputAliasConfig& input_output_alias,
+      const std::map<int, const Tensor*>& substitute_inputs = {});
 
   // Given the XLA output in `output`, populate all outputs of `ctx`.  Also
   // writes out the resource variable updates.
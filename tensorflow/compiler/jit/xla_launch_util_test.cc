@@ -324,6 +324,44 @@ TEST_F(PjRtExecutionUtilTest, PreparePjRtExecutableArgumentsVariableInputs) {
       *literal2, xla::LiteralUtil::CreateR2<int32_t>({{3, 4}})));
 }
 
+TEST_F(PjRtExecutionUtilTest, PreparePjRtExecutableArgumentsHostTensors) {
+  std::vector<const Tensor*> inputs;
+  inputs.push_back(CreateHostTensor<int32_t>(TensorShape({1, 3}), {1, 2, 3}));
+  inputs.push_back(CreateHostTensor<int32_t>(TensorShape({1, 3}), {4, 5, 6}));
+  std::vector<int> input_mapping{0, 1};
+  std::vector<VariableInfo> variables;
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto* pjrt_device,
+      pjrt_client_->LookupAddressableDevice(
+          xla::PjRtLocalDeviceId(device_->parsed_name().id)));
+
+  std::vector<xla::PjRtBuffer*> exec_args;
+  exec_args.reserve(input_mapping.size());
+  std::vector<std::unique_ptr<xla::PjRtBuffer>> owned_args;
+  absl::flat_hash_set<int> non_donatable_input_indices;
+  TF_EXPECT_OK(PreparePjRtExecutableArguments(
+      /*num_missing_prefix_ctx_inputs=*/0, input_mapping, inputs,
+      GetVariableSnapshots(variables), pjrt_client_, pjrt_device,
+      /*use_pjrt_tensor_buffer=*/false, &exec_args, &owned_args,
+      &non_donatable_input_indices));
+
+  EXPECT_EQ(exec_args.size(), 2);
+  // Plain host tensors get aliased into zero-copy buffers owned by the
+  // caller and must not be donated.
+  EXPECT_EQ(owned_args.size(), 2);
+  EXPECT_TRUE(non_donatable_input_indices.contains(0));
+  EXPECT_TRUE(non_donatable_input_indices.contains(1));
+
+  std::shared_ptr<xla::Literal> literal1 = *exec_args[0]->ToLiteralSync();
+  EXPECT_TRUE(xla::LiteralTestUtil::Equal(
+      *literal1, xla::LiteralUtil::CreateR2<int32_t>({{1, 2, 3}})));
+
+  std::shared_ptr<xla::Literal> literal2 = *exec_args[1]->ToLiteralSync();
+  EXPECT_TRUE(xla::LiteralTestUtil::Equal(
+      *literal2, xla::LiteralUtil::CreateR2<int32_t>({{4, 5, 6}})));
+}
+
 TEST_F(PjRtExecutionUtilTest, PopulateCtxOutputs) {
   XlaOpRegistry::RegisterCompilationKernels();
   TF_EXPECT_OK(NodeDefBuilder("AddV2", "AddV2")
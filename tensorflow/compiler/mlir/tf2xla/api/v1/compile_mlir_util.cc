@@ -63,6 +63,7 @@ limitations under the License.
 #include "tensorflow/compiler/mlir/tensorflow/utils/serialize_mlir_module_utils.h"
 #include "tensorflow/compiler/mlir/tensorflow/utils/translate_utils.h"
 #include "tensorflow/compiler/mlir/tensorflow/utils/xla_sharding_util.h"
+#include "tensorflow/compiler/mlir/tf2xla/internal/bridge_metrics_pass_instrumentation.h"
 #include "tensorflow/compiler/mlir/tf2xla/internal/mlir_pass_instrumentation.h"
 #include "tensorflow/compiler/mlir/tf2xla/internal/passes/lowering_passes.h"
 #include "tensorflow/compiler/mlir/tf2xla/transforms/passes.h"
@@ -392,6 +393,9 @@ void CreateMlirLoweringPassesPipeline(mlir::PassManager& pm) {
   pm.addPass(mlir::TF::CreateTFShapeInferencePass());
   pm.addPass(mlir::mhlo::CreateLegalizeTFCommunicationPass());
 
+  pm.addInstrumentation(
+      std::make_unique<
+          tensorflow::tf2xla::internal::BridgeMetricsPassInstrumentation>());
   auto pass_instrumentors = mlir::GetPassInstrumentors();
   for (const auto& creator : pass_instrumentors) {
     pm.addInstrumentation(creator());
@@ -644,6 +648,9 @@ Status CreateAndRunMlirBridge(mlir::ModuleOp module_op,
                                     lower_to_xla_hlo,
                                     /*allow_partial_conversion=*/false);
 
+  tf2xla.addInstrumentation(
+      std::make_unique<
+          tensorflow::tf2xla::internal::BridgeMetricsPassInstrumentation>());
   auto pass_instrumentors = mlir::GetPassInstrumentors();
   for (const auto& creator : pass_instrumentors) {
     tf2xla.addInstrumentation(creator());
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/compiler/mlir/tf2xla/api/v2/cluster_tf.h"
 
+#include <memory>
 #include <string>
 
 #include "absl/log/log.h"
@@ -32,6 +33,7 @@ limitations under the License.
 #include "tensorflow/compiler/mlir/tensorflow/utils/dump_mlir_util.h"
 #include "tensorflow/compiler/mlir/tensorflow/utils/error_util.h"
 #include "tensorflow/compiler/mlir/tf2xla/api/v2/device_type.pb.h"
+#include "tensorflow/compiler/mlir/tf2xla/internal/bridge_metrics_pass_instrumentation.h"
 #include "tensorflow/compiler/mlir/tf2xla/internal/clustering_bridge_passes.h"
 #include "tensorflow/compiler/mlir/tf2xla/internal/logging_hooks.h"
 #include "tensorflow/core/framework/metrics.h"
@@ -77,6 +79,8 @@ tensorflow::Status RunTFXLABridge(
 
   // Populate a passmanager with the list of passes that implement the bridge.
   pipeline_builder(bridge);
+  bridge.addInstrumentation(
+      std::make_unique<internal::BridgeMetricsPassInstrumentation>());
 
   mlir::StatusScopedDiagnosticHandler diag_handler(
       module.getContext(), /*propagate=*/false,
@@ -31,6 +31,7 @@ limitations under the License.
 #include "tensorflow/compiler/mlir/tensorflow/transforms/passes.h"
 #include "tensorflow/compiler/mlir/tensorflow/utils/data_dumper_logger_config.h"
 #include "tensorflow/compiler/mlir/tensorflow/utils/dump_mlir_util.h"
+#include "tensorflow/compiler/mlir/tf2xla/internal/bridge_metrics_pass_instrumentation.h"
 #include "tensorflow/compiler/mlir/tf2xla/internal/logging_hooks.h"
 #include "tensorflow/core/platform/error_payloads.h"
 #include "tensorflow/core/platform/status.h"
@@ -134,6 +135,8 @@ tensorflow::Status ExportFromTensorflowDialectToExecutor(
   ::tensorflow::applyTensorflowAndCLOptions(tf_to_executor);
   tf_to_executor.enableVerifier();
   AddTfDialectToExecutorPasses(tf_to_executor);
+  tf_to_executor.addInstrumentation(
+      std::make_unique<internal::BridgeMetricsPassInstrumentation>());
 
   if (VLOG_IS_ON(1) ||
       DEBUG_DATA_DUMPER()->ShouldDump(module_name.str(), kDebugGroupMain)) {
@@ -0,0 +1,70 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/compiler/mlir/tf2xla/internal/bridge_metrics_pass_instrumentation.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "mlir/IR/Operation.h"  // from @llvm-project
+#include "mlir/Pass/Pass.h"  // from @llvm-project
+#include "tensorflow/core/framework/metrics.h"
+#include "tensorflow/core/platform/env.h"
+
+namespace tensorflow {
+namespace tf2xla {
+namespace internal {
+
+void BridgeMetricsPassInstrumentation::runBeforePass(mlir::Pass* pass,
+                                                     mlir::Operation* op) {
+  const uint64 start_us = Env::Default()->NowMicros();
+  mutex_lock lock(mu_);
+  start_us_[std::make_pair(pass, op)] = start_us;
+}
+
+void BridgeMetricsPassInstrumentation::runAfterPass(mlir::Pass* pass,
+                                                    mlir::Operation* op) {
+  const uint64 end_us = Env::Default()->NowMicros();
+  uint64 start_us;
+  {
+    mutex_lock lock(mu_);
+    auto it = start_us_.find(std::make_pair(pass, op));
+    if (it == start_us_.end()) {
+      return;
+    }
+    start_us = it->second;
+    start_us_.erase(it);
+  }
+
+  const std::string pass_name = pass->getName().str();
+  metrics::UpdateTfMlirBridgePassTime(pass_name, end_us - start_us);
+
+  int64_t num_ops = 0;
+  op->walk([&num_ops](mlir::Operation*) { ++num_ops; });
+  metrics::RecordTfMlirBridgePassIrSize(pass_name, num_ops);
+}
+
+void BridgeMetricsPassInstrumentation::runAfterPassFailed(mlir::Pass* pass,
+                                                          mlir::Operation* op) {
+  // Failed passes abort the pipeline; drop the pending timestamp so the map
+  // doesn't accumulate dead entries.
+  mutex_lock lock(mu_);
+  start_us_.erase(std::make_pair(pass, op));
+}
+
+}  // namespace internal
+}  // namespace tf2xla
+}  // namespace tensorflow
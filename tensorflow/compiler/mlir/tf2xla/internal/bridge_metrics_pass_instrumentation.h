@@ -0,0 +1,55 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_COMPILER_MLIR_TF2XLA_INTERNAL_BRIDGE_METRICS_PASS_INSTRUMENTATION_H_
+#define TENSORFLOW_COMPILER_MLIR_TF2XLA_INTERNAL_BRIDGE_METRICS_PASS_INSTRUMENTATION_H_
+
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "mlir/IR/Operation.h"  // from @llvm-project
+#include "mlir/Pass/Pass.h"  // from @llvm-project
+#include "mlir/Pass/PassInstrumentation.h"  // from @llvm-project
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace tf2xla {
+namespace internal {
+
+// Pass instrumentation that exports per-pass wall time and post-pass IR size
+// of the TF-to-XLA bridge pass pipelines through
+// tensorflow/core/framework/metrics.h, keyed by pass name.
+class BridgeMetricsPassInstrumentation : public mlir::PassInstrumentation {
+ public:
+  void runBeforePass(mlir::Pass* pass, mlir::Operation* op) override;
+  void runAfterPass(mlir::Pass* pass, mlir::Operation* op) override;
+  void runAfterPassFailed(mlir::Pass* pass, mlir::Operation* op) override;
+
+ private:
+  mutex mu_;
+
+  // Start timestamps (in microseconds) of in-flight pass runs. Nested
+  // pipelines may run passes on sibling ops concurrently, so runs are keyed
+  // by {pass, op}.
+  absl::flat_hash_map<std::pair<mlir::Pass*, mlir::Operation*>, uint64>
+      start_us_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace internal
+}  // namespace tf2xla
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_COMPILER_MLIR_TF2XLA_INTERNAL_BRIDGE_METRICS_PASS_INSTRUMENTATION_H_
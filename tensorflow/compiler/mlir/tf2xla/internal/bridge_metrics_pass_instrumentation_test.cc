@@ -0,0 +1,75 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/compiler/mlir/tf2xla/internal/bridge_metrics_pass_instrumentation.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "mlir/Dialect/Func/IR/FuncOps.h"  // from @llvm-project
+#include "mlir/IR/BuiltinOps.h"  // from @llvm-project
+#include "mlir/IR/MLIRContext.h"  // from @llvm-project
+#include "mlir/IR/OwningOpRef.h"  // from @llvm-project
+#include "mlir/Parser/Parser.h"  // from @llvm-project
+#include "mlir/Pass/PassManager.h"  // from @llvm-project
+#include "mlir/Transforms/Passes.h"  // from @llvm-project
+#include "tensorflow/core/lib/monitoring/cell_reader.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace tf2xla {
+namespace internal {
+namespace {
+
+using ::tensorflow::monitoring::testing::CellReader;
+using ::tensorflow::monitoring::testing::Histogram;
+
+constexpr char kPassTimeMetric[] =
+    "/tensorflow/core/tf_mlir_bridge_pass_time_usecs";
+constexpr char kIrSizeMetric[] = "/tensorflow/core/tf_mlir_bridge_pass_ir_size";
+
+constexpr char kMlirModuleStr[] = R"(
+  module {
+    func.func @main() {
+      return
+    }
+  })";
+
+TEST(BridgeMetricsPassInstrumentationTest, RecordsPassTimeAndIrSize) {
+  CellReader<int64_t> pass_time_reader(kPassTimeMetric);
+  CellReader<Histogram> ir_size_reader(kIrSizeMetric);
+
+  mlir::MLIRContext context;
+  context.loadDialect<mlir::func::FuncDialect>();
+  mlir::OwningOpRef<mlir::ModuleOp> module =
+      mlir::parseSourceString<mlir::ModuleOp>(kMlirModuleStr, &context);
+  ASSERT_TRUE(module);
+
+  mlir::PassManager pm(&context);
+  pm.addInstrumentation(std::make_unique<BridgeMetricsPassInstrumentation>());
+  pm.addPass(mlir::createCanonicalizerPass());
+  ASSERT_TRUE(mlir::succeeded(pm.run(*module)));
+
+  const std::string pass_name = "Canonicalizer";
+  EXPECT_GE(pass_time_reader.Delta(pass_name), 0);
+  EXPECT_EQ(ir_size_reader.Delta(pass_name).num(), 1);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tf2xla
+}  // namespace tensorflow
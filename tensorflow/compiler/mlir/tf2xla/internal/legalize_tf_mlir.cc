@@ -19,6 +19,7 @@ limitations under the License.
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
 #include "llvm/ADT/StringRef.h"
 #include "mlir/IR/BuiltinOps.h"  // from @llvm-project
@@ -37,8 +38,10 @@ limitations under the License.
 #include "tensorflow/compiler/tf2xla/xla_helpers.h"
 #include "xla/mlir_hlo/mhlo/IR/register.h"
 #include "xla/shape.h"
+#include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/profile_utils/cpu_utils.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/protobuf/tpu/compile_metadata.pb.h"
@@ -46,6 +49,7 @@ limitations under the License.
 #include "tensorflow/core/tpu/tpu_compile.h"
 #include "tsl/platform/error_logging.h"
 #include "tsl/platform/errors.h"
+#include "tsl/platform/fingerprint.h"
 #include "tsl/platform/statusor.h"
 
 namespace tensorflow {
@@ -59,6 +63,43 @@ constexpr char kBridgeComponent[] = "TFXLABridge";
 using tpu::MlirToHloArgs;
 using tpu::ShardingAndIndex;
 
+namespace {
+
+// Process-wide cache of lowered modules, keyed by a fingerprint of the
+// serialized computation and the compilation options that influence lowering.
+// Repeated retraces of an identical tf.function hit the cache and skip the
+// MLIR lowering pipeline entirely. The cache is bounded and cleared wholesale
+// when full; lowering results are small (the XLA computation is held by
+// shared_ptr) so a simple policy suffices.
+constexpr int kLoweringCacheMaxEntries = 64;
+
+struct LoweringCache {
+  mutex mu;
+  absl::flat_hash_map<uint64, XlaCompilationResult> entries TF_GUARDED_BY(mu);
+};
+
+LoweringCache& GetLoweringCache() {
+  static auto* cache = new LoweringCache();
+  return *cache;
+}
+
+uint64 LoweringCacheKey(const MlirToHloArgs& computation,
+                        const tpu::TPUCompileMetadataProto& metadata,
+                        bool use_tuple_args, llvm::StringRef device_type,
+                        const std::vector<TensorShape>& arg_shapes) {
+  uint64 key = tsl::Fingerprint64(computation.mlir_module);
+  key = tsl::FingerprintCat64(key,
+                              tsl::Fingerprint64(metadata.SerializeAsString()));
+  key = tsl::FingerprintCat64(key, tsl::Fingerprint64(device_type.str()));
+  key = tsl::FingerprintCat64(key, use_tuple_args ? 1 : 0);
+  for (const TensorShape& shape : arg_shapes) {
+    key = tsl::FingerprintCat64(key, tsl::Fingerprint64(shape.DebugString()));
+  }
+  return key;
+}
+
+}  // namespace
+
 absl::StatusOr<std::string> CompileFromMlirToXlaHlo(
     bool lower_to_xla_hlo, const MlirToHloArgs& computation,
     const tpu::TPUCompileMetadataProto& metadata, llvm::StringRef device_type,
@@ -119,6 +160,30 @@ absl::StatusOr<XlaCompilationResult> LegalizeWithMlirBridge(
   // Enabling op fallback also enables whole graph fallback if op by op
   // fallback failed.
 
+  // Custom legalization passes may lower differently per call, so only cache
+  // when none are supplied (the common production configuration).
+  const bool use_lowering_cache = custom_legalization_passes.empty();
+  uint64 cache_key = 0;
+  if (use_lowering_cache) {
+    cache_key = LoweringCacheKey(computation, metadata, use_tuple_args,
+                                 device_type, arg_shapes);
+    LoweringCache& cache = GetLoweringCache();
+    mutex_lock lock(cache.mu);
+    auto it = cache.entries.find(cache_key);
+    if (it != cache.entries.end()) {
+      metrics::UpdateTfMlirBridgeLoweringCacheStatus(/*hit=*/true);
+      VLOG(1) << "Reusing cached MLIR bridge lowering result";
+      *compilation_result = it->second;
+      // Sharding outputs depend on the (cheap) metadata/shape analysis only,
+      // so recompute them rather than caching.
+      TF_RETURN_IF_ERROR(
+          tpu::GetShardingInfo(metadata, arg_shapes, shape_determination_fns,
+                               arg_core_mapping, per_core_arg_shapes));
+      return *compilation_result;
+    }
+    metrics::UpdateTfMlirBridgeLoweringCacheStatus(/*hit=*/false);
+  }
+
   absl::StatusOr<std::string> mlir_bridge_status = CompileFromMlirToXlaHlo(
       /*lower_to_xla_hlo=*/true, computation, metadata, device_type,
       shape_determination_fns, use_tuple_args, compilation_result,
@@ -128,6 +193,14 @@ absl::StatusOr<XlaCompilationResult> LegalizeWithMlirBridge(
   if (mlir_bridge_status.ok()) {
     VLOG(1) << "Successfully compiled MLIR computation to XLA HLO using MLIR "
                "tf2xla bridge";
+    if (use_lowering_cache) {
+      LoweringCache& cache = GetLoweringCache();
+      mutex_lock lock(cache.mu);
+      if (cache.entries.size() >= kLoweringCacheMaxEntries) {
+        cache.entries.clear();
+      }
+      cache.entries.emplace(cache_key, *compilation_result);
+    }
     return *compilation_result;
   }
 
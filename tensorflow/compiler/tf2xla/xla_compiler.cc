@@ -508,13 +508,13 @@ std::vector<int64_t> XlaCompiler::Argument::DimensionSizes() const {
   }
 }
 
-absl::InlinedVector<int64_t, 4>
+absl::InlinedVector<int64_t, 8>
 XlaCompiler::Argument::DimensionSizesAsInlinedVector() const {
   if (absl::holds_alternative<TensorShape>(shape)) {
     return std::get<TensorShape>(shape).dim_sizes();
   } else {
     auto v = std::get<xla::Shape>(shape).dimensions();
-    return absl::InlinedVector<int64_t, 4>(v.begin(), v.end());
+    return absl::InlinedVector<int64_t, 8>(v.begin(), v.end());
   }
 }
 
@@ -0,0 +1,256 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Benchmarks allocator behavior under concurrent load with mixed small/large
+// allocation sizes, modeling several sessions hammering one process-wide
+// allocator. Covers BFCAllocator, PoolAllocator and cpu_allocator.
+//
+// By default each benchmark thread replays a synthetic bimodal trace (90%
+// small buffers of 64B..4KB, 10% large buffers of 256KB..4MB, bounded
+// lifetimes). A recorded production trace can be replayed instead by
+// pointing TF_ALLOCATOR_BENCHMARK_TRACE at a text file with one event per
+// line:
+//
+//   alloc <id> <bytes>
+//   free <id>
+//
+// Reported counters: allocations/sec (items processed), p99 AllocateRaw
+// latency in nanoseconds, and for BFCAllocator a fragmentation measure
+// (1 - largest_free_block / free_bytes) sampled at the end of the run.
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/bfc_allocator.h"
+#include "tensorflow/core/common_runtime/pool_allocator.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/lib/strings/numbers.h"
+#include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/env_time.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/numa.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/test_benchmark.h"
+
+namespace tensorflow {
+namespace {
+
+struct TraceEvent {
+  bool is_alloc;
+  int id;           // Buffer slot; frees reference the id of a prior alloc.
+  size_t num_bytes; // Only meaningful for allocs.
+};
+
+// Parses the TF_ALLOCATOR_BENCHMARK_TRACE file format described above.
+// Returns an empty vector if the file cannot be read or parsed.
+std::vector<TraceEvent> LoadTraceFromFile(const string& path) {
+  std::vector<TraceEvent> trace;
+  string contents;
+  Status s = ReadFileToString(Env::Default(), path, &contents);
+  if (!s.ok()) {
+    LOG(ERROR) << "Could not read allocation trace " << path << ": "
+               << s.message();
+    return trace;
+  }
+  for (const string& line : str_util::Split(contents, '\n')) {
+    std::vector<string> parts =
+        str_util::Split(line, ' ', str_util::SkipEmpty());
+    if (parts.empty()) continue;
+    TraceEvent event;
+    if (parts[0] == "alloc" && parts.size() == 3) {
+      event.is_alloc = true;
+      if (!strings::safe_strto32(parts[1], &event.id)) return {};
+      int64_t bytes;
+      if (!strings::safe_strto64(parts[2], &bytes)) return {};
+      event.num_bytes = static_cast<size_t>(bytes);
+    } else if (parts[0] == "free" && parts.size() == 2) {
+      event.is_alloc = false;
+      event.num_bytes = 0;
+      if (!strings::safe_strto32(parts[1], &event.id)) return {};
+    } else {
+      LOG(ERROR) << "Unparseable trace line: " << line;
+      return {};
+    }
+    trace.push_back(event);
+  }
+  return trace;
+}
+
+// Synthesizes a bimodal trace: 90% small (64B..4KB), 10% large
+// (256KB..4MB), each buffer freed after a bounded random number of
+// subsequent events so a working set of mixed sizes stays live.
+std::vector<TraceEvent> SynthesizeBimodalTrace(int num_allocs, int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::uniform_int_distribution<size_t> small_bytes(64, 4096);
+  std::uniform_int_distribution<size_t> large_bytes(256 << 10, 4 << 20);
+  std::uniform_int_distribution<int> lifetime(1, 64);
+
+  std::vector<TraceEvent> trace;
+  trace.reserve(2 * num_allocs);
+  // free_at[i] holds ids to free before issuing alloc i.
+  std::vector<std::vector<int>> free_at(num_allocs + 1);
+  for (int i = 0; i < num_allocs; ++i) {
+    for (int id : free_at[i]) {
+      trace.push_back({false, id, 0});
+    }
+    TraceEvent event;
+    event.is_alloc = true;
+    event.id = i;
+    event.num_bytes =
+        percent(rng) < 90 ? small_bytes(rng) : large_bytes(rng);
+    trace.push_back(event);
+    free_at[std::min(num_allocs, i + lifetime(rng))].push_back(i);
+  }
+  for (int id : free_at[num_allocs]) {
+    trace.push_back({false, id, 0});
+  }
+  return trace;
+}
+
+const std::vector<TraceEvent>& GetTrace(int seed) {
+  static const char* trace_path = getenv("TF_ALLOCATOR_BENCHMARK_TRACE");
+  if (trace_path != nullptr) {
+    // A recorded trace is replayed identically by every thread.
+    static const auto* trace =
+        new std::vector<TraceEvent>(LoadTraceFromFile(trace_path));
+    if (!trace->empty()) return *trace;
+  }
+  static auto* traces = new std::vector<std::vector<TraceEvent>>(
+      64, std::vector<TraceEvent>());
+  static mutex mu;
+  mutex_lock l(mu);
+  std::vector<TraceEvent>& trace = (*traces)[seed % 64];
+  if (trace.empty()) {
+    trace = SynthesizeBimodalTrace(/*num_allocs=*/4096, seed);
+  }
+  return trace;
+}
+
+// Replays `trace` against `allocator`, recording AllocateRaw latencies.
+// Returns the number of allocations performed.
+int64_t ReplayTrace(Allocator* allocator, const std::vector<TraceEvent>& trace,
+                    std::vector<int64_t>* alloc_latency_ns) {
+  std::vector<void*> slots;
+  int64_t num_allocs = 0;
+  for (const TraceEvent& event : trace) {
+    if (event.is_alloc) {
+      if (event.id >= static_cast<int>(slots.size())) {
+        slots.resize(event.id + 1, nullptr);
+      }
+      const int64_t start = EnvTime::NowNanos();
+      slots[event.id] =
+          allocator->AllocateRaw(Allocator::kAllocatorAlignment,
+                                 event.num_bytes);
+      alloc_latency_ns->push_back(EnvTime::NowNanos() - start);
+      ++num_allocs;
+    } else if (event.id < static_cast<int>(slots.size()) &&
+               slots[event.id] != nullptr) {
+      allocator->DeallocateRaw(slots[event.id]);
+      slots[event.id] = nullptr;
+    }
+  }
+  for (void* ptr : slots) {
+    if (ptr != nullptr) allocator->DeallocateRaw(ptr);
+  }
+  return num_allocs;
+}
+
+int64_t Percentile99(std::vector<int64_t>* latencies) {
+  if (latencies->empty()) return 0;
+  const size_t idx = (latencies->size() * 99) / 100;
+  std::nth_element(latencies->begin(), latencies->begin() + idx,
+                   latencies->end());
+  return (*latencies)[idx];
+}
+
+// 1 - largest_free_block / free_bytes, from the allocator's stats; 0 when
+// the allocator does not track them or there is no free memory.
+double FragmentationFraction(Allocator* allocator) {
+  absl::optional<AllocatorStats> stats = allocator->GetStats();
+  if (!stats.has_value()) return 0.0;
+  int64_t free_bytes = 0;
+  if (stats->bin_free_bytes.has_value()) {
+    for (int64_t bin_bytes : *stats->bin_free_bytes) free_bytes += bin_bytes;
+  } else if (stats->bytes_limit.has_value()) {
+    free_bytes = *stats->bytes_limit - stats->bytes_in_use;
+  }
+  if (free_bytes <= 0 || stats->largest_free_block_bytes <= 0) return 0.0;
+  return 1.0 -
+         static_cast<double>(stats->largest_free_block_bytes) / free_bytes;
+}
+
+void RunContentionBenchmark(::testing::benchmark::State& state,
+                            Allocator* allocator, bool report_fragmentation) {
+  std::vector<int64_t> latencies;
+  int64_t num_allocs = 0;
+  const std::vector<TraceEvent>& trace = GetTrace(state.thread_index());
+  for (auto s : state) {
+    num_allocs += ReplayTrace(allocator, trace, &latencies);
+  }
+  state.SetItemsProcessed(num_allocs);
+  state.counters["p99_alloc_ns"] = ::benchmark::Counter(
+      static_cast<double>(Percentile99(&latencies)));
+  if (report_fragmentation) {
+    state.counters["fragmentation"] =
+        ::benchmark::Counter(FragmentationFraction(allocator));
+  }
+}
+
+Allocator* SharedBFCAllocator() {
+  static Allocator* bfc = [] {
+    BFCAllocator::Options opts;
+    opts.allow_growth = true;
+    return new BFCAllocator(
+        absl::WrapUnique<SubAllocator>(
+            new BasicCPUAllocator(port::kNUMANoAffinity, {}, {})),
+        1LL << 32, "bfc_contention_bench", opts);
+  }();
+  return bfc;
+}
+
+Allocator* SharedPoolAllocator() {
+  static Allocator* pool = new PoolAllocator(
+      /*pool_size_limit=*/100, /*auto_resize=*/true,
+      new BasicCPUAllocator(port::kNUMANoAffinity, {}, {}), new Pow2Rounder,
+      "pool_contention_bench");
+  return pool;
+}
+
+void BM_BFCAllocatorContention(::testing::benchmark::State& state) {
+  RunContentionBenchmark(state, SharedBFCAllocator(),
+                         /*report_fragmentation=*/true);
+}
+BENCHMARK(BM_BFCAllocatorContention)->ThreadRange(1, 16)->UseRealTime();
+
+void BM_PoolAllocatorContention(::testing::benchmark::State& state) {
+  RunContentionBenchmark(state, SharedPoolAllocator(),
+                         /*report_fragmentation=*/false);
+}
+BENCHMARK(BM_PoolAllocatorContention)->ThreadRange(1, 16)->UseRealTime();
+
+void BM_CpuAllocatorContention(::testing::benchmark::State& state) {
+  RunContentionBenchmark(state, cpu_allocator(),
+                         /*report_fragmentation=*/false);
+}
+BENCHMARK(BM_CpuAllocatorContention)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace
+}  // namespace tensorflow
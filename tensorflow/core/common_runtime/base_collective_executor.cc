@@ -17,6 +17,7 @@ limitations under the License.
 #include <algorithm>
 #include <functional>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/common_runtime/copy_tensor.h"
 #include "tensorflow/core/common_runtime/device_mgr.h"
@@ -34,6 +35,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/profiler/lib/connected_traceme.h"
@@ -49,6 +51,25 @@ bool IsCancelled(CancellationManager* cancel_mgr) {
   return cancel_mgr != nullptr &&
          (cancel_mgr->IsCancelled() || cancel_mgr->IsCancelling());
 }
+
+// Upper bound in bytes on a fused batch of small ring all-reduce launches.
+// When positive, ring all-reduces no larger than this are executed
+// back-to-back on a single work queue thread instead of each paying for its
+// own thread handoff, which amortizes per-collective dispatch overhead for
+// workloads that issue many small gradient all-reduces.  Zero (the default)
+// disables fused dispatch.  Only enable this when all group members launch
+// their collectives in a consistent order (e.g. via ordering tokens),
+// otherwise members may execute fused batches in different orders and
+// deadlock.
+int64_t CollectiveFusionThresholdBytes() {
+  static const int64_t threshold_bytes = [] {
+    int64_t threshold;
+    TF_CHECK_OK(ReadInt64FromEnvVar("TF_COLLECTIVE_FUSION_MAX_BYTES",
+                                    /*default_val=*/0, &threshold));
+    return threshold;
+  }();
+  return threshold_bytes;
+}
 }  // namespace
 
 /*static*/
@@ -332,8 +353,8 @@ void BaseCollectiveExecutor::ExecuteAsync(OpKernelContext* ctx,
   // starve executor threads.
   col_impl->Ref();
   profiler::TraceMeProducer producer("BaseCollectiveExecutor::ExecuteAsync");
-  RunClosure([col_impl, col_ctx, done_safe, ctx,
-              context_id = producer.GetContextId()]() {
+  std::function<void()> launch = [col_impl, col_ctx, done_safe, ctx,
+                                  context_id = producer.GetContextId()]() {
     core::ScopedUnref unref(col_impl);
     profiler::TraceMeConsumer consumer(
         [ctx, col_ctx] {
@@ -354,7 +375,75 @@ void BaseCollectiveExecutor::ExecuteAsync(OpKernelContext* ctx,
       core::ScopedUnref unref(col_impl);
       done_safe(s);
     });
-  });
+  };
+  if (!ScheduleFusedLaunch(col_params, input, std::move(launch))) {
+    RunClosure(std::move(launch));
+  }
+}
+
+bool BaseCollectiveExecutor::ScheduleFusedLaunch(
+    const CollectiveParams* col_params, const Tensor* input,
+    std::function<void()> launch) {
+  const int64_t threshold_bytes = CollectiveFusionThresholdBytes();
+  // Restrict fused dispatch to RingReduce, whose Run() returns only after the
+  // collective completes; DrainFusedLaunches depends on that to execute batch
+  // members strictly in arrival order.
+  if (threshold_bytes <= 0 || input == nullptr ||
+      col_params->instance.type != REDUCTION_COLLECTIVE ||
+      col_params->instance.impl_details.collective_name != "RingReduce" ||
+      static_cast<int64_t>(input->TotalBytes()) > threshold_bytes) {
+    return false;
+  }
+  bool schedule_drain = false;
+  {
+    mutex_lock l(fusion_mu_);
+    pending_launches_.push_back(
+        {static_cast<int64_t>(input->TotalBytes()), std::move(launch)});
+    if (!fusion_drain_scheduled_) {
+      fusion_drain_scheduled_ = true;
+      schedule_drain = true;
+    }
+  }
+  if (schedule_drain) {
+    // Keep this executor alive until the drain loop observes an empty queue;
+    // the callers' refs may be dropped as soon as their launches complete.
+    Ref();
+    RunClosure([this] { DrainFusedLaunches(); });
+  }
+  return true;
+}
+
+void BaseCollectiveExecutor::DrainFusedLaunches() {
+  while (true) {
+    std::vector<PendingLaunch> batch;
+    {
+      mutex_lock l(fusion_mu_);
+      if (pending_launches_.empty()) {
+        fusion_drain_scheduled_ = false;
+        break;
+      }
+      // Take pending launches in arrival order up to the byte threshold,
+      // always taking at least one.  Launches that arrive while a batch is
+      // running form the next batch.
+      const int64_t threshold_bytes = CollectiveFusionThresholdBytes();
+      int64_t batch_bytes = 0;
+      while (!pending_launches_.empty() &&
+             (batch.empty() ||
+              batch_bytes + pending_launches_.front().bytes <=
+                  threshold_bytes)) {
+        batch_bytes += pending_launches_.front().bytes;
+        batch.push_back(std::move(pending_launches_.front()));
+        pending_launches_.pop_front();
+      }
+    }
+    // Each launch blocks until its ring passes complete, so batch members run
+    // back-to-back on this thread; chunk-level overlap of reduce and transfer
+    // within each member is handled by RingAlg subdivisions.
+    for (PendingLaunch& pending : batch) {
+      pending.run();
+    }
+  }
+  Unref();
 }
 
 void BaseCollectiveExecutor::CompleteParamsAsync(
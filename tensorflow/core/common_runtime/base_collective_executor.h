@@ -15,6 +15,8 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_BASE_COLLECTIVE_EXECUTOR_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_BASE_COLLECTIVE_EXECUTOR_H_
 
+#include <deque>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -150,6 +152,12 @@ class BaseCollectiveExecutor : public CollectiveExecutor {
   Status status_ TF_GUARDED_BY(status_mu_);
 
  private:
+  // A small ring all-reduce launch held back for fused dispatch.
+  struct PendingLaunch {
+    int64_t bytes;
+    std::function<void()> run;
+  };
+
   Status CreateCollective(const CollectiveParams& col_params,
                           CollectiveImplementationInterface** col_impl);
   // Check if all ops on which this collective depends on have launched.
@@ -158,6 +166,21 @@ class BaseCollectiveExecutor : public CollectiveExecutor {
   // Tries to return the status that is the original error. It returns the
   // aborted status if the collective executor is aborted.
   Status GetStatus(const Status& s) TF_LOCKS_EXCLUDED(status_mu_);
+  // If `col_params` describes a small ring all-reduce and fused dispatch is
+  // enabled, queues `launch` for execution in a fused batch and returns true.
+  // Returns false if the caller should dispatch `launch` itself.
+  bool ScheduleFusedLaunch(const CollectiveParams* col_params,
+                           const Tensor* input, std::function<void()> launch)
+      TF_LOCKS_EXCLUDED(fusion_mu_);
+  // Runs queued launches in arrival order, batched up to the fusion byte
+  // threshold, until the queue is empty.
+  void DrainFusedLaunches() TF_LOCKS_EXCLUDED(fusion_mu_);
+
+  // Queue of small all-reduce launches awaiting fused dispatch; see
+  // ScheduleFusedLaunch in base_collective_executor.cc.
+  mutex fusion_mu_;
+  std::deque<PendingLaunch> pending_launches_ TF_GUARDED_BY(fusion_mu_);
+  bool fusion_drain_scheduled_ TF_GUARDED_BY(fusion_mu_) = false;
 };
 
 }  // namespace tensorflow
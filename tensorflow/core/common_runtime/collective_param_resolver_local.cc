@@ -32,6 +32,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/gtl/flatmap.h"
+#include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/lib/strings/strcat.h"
@@ -470,6 +471,20 @@ GlobalDeviceMap EstablishGlobalRank(const CollGroupParams& gp,
 // Count the devices associated with each task and set
 // gp->same_num_devices_per_task.  Requires gp->task_names
 // be sorted.
+// Fingerprints the inputs that determine the ranking computed by
+// CompleteDefaultRanking: the configured ring order plus each member's
+// device name and locality, in sorted member order.
+uint64 RankingFingerprint(const CollGroupParams& gp,
+                          const string& gpu_ring_order) {
+  uint64 fp = Hash64(gpu_ring_order);
+  for (const CollGroupMember& member : gp.members) {
+    fp = Hash64Combine(fp, Hash64(member.device.name()));
+    fp = Hash64Combine(fp,
+                       Hash64(member.device.locality().SerializeAsString()));
+  }
+  return fp;
+}
+
 void SetDevPerTask(CollGroupParams* gp) {
   gp->num_devices_per_task.clear();
   for (const CollGroupMember& member : gp->members) {
@@ -560,19 +575,43 @@ void CollectiveParamResolverLocal::CompleteDefaultRanking(CollGroupParams* gp) {
               return DeviceNameUtils::CompareFullNames(lhs.device.name(),
                                                        rhs.device.name());
             });
+  // The ranking below is a pure function of the sorted membership and the
+  // ring order config, so groups with identical membership can reuse a
+  // previously computed permutation.
+  const uint64 fp = RankingFingerprint(*gp, gpu_ring_order_);
+  {
+    mutex_lock l(ranking_mu_);
+    auto it = ranking_cache_.find(fp);
+    if (it != ranking_cache_.end() &&
+        it->second.size() == gp->members.size()) {
+      VLOG(2) << "Reusing cached device ranking for group " << gp->group_key;
+      std::vector<CollGroupMember> cached_members(gp->group_size);
+      for (int i = 0; i < gp->group_size; ++i) {
+        cached_members[it->second[i]] = std::move(gp->members[i]);
+      }
+      gp->members = std::move(cached_members);
+      return;
+    }
+  }
   // Establish an instance-specific default rank order for devices
   // based on localities.  This rank order should be a good ring
   // order, if possible.
   GlobalDeviceMap gdm = EstablishGlobalRank(*gp, gpu_ring_order_);
   // Reflect the new global ranking on shared
   std::vector<CollGroupMember> new_members(gp->group_size);
+  std::vector<int> ranking(gp->group_size);
   for (const auto& git : gdm) {
     const TaskDeviceMap& tdm = git.second;
     for (const auto& tit : tdm) {
       const DevRec& dr = tit.second;
       new_members[dr.global_rank] = std::move(gp->members[dr.original_rank]);
+      ranking[dr.original_rank] = dr.global_rank;
     }
   }
+  {
+    mutex_lock l(ranking_mu_);
+    ranking_cache_[fp] = std::move(ranking);
+  }
 
   if (VLOG_IS_ON(2)) {
     string buf;
@@ -693,6 +732,19 @@ void CollectiveParamResolverLocal::AssignCollectiveType(CollectiveParams* cp) {
   // After enough testing, we may simplify this logic to use NCCL whenever
   // available.
   CollectiveImplementationInterface* col_impl;
+  // An explicit "hierarchical" hint selects the cross-task hierarchical
+  // reduction, where only one device per task exchanges data across tasks.
+  if (cp->instance.type == REDUCTION_COLLECTIVE &&
+      cp->instance.impl_details.communication_hint == "hierarchical" &&
+      cp->group.num_tasks > 1 &&
+      CollectiveRegistry::LookupParamResolverInstance("HierarchicalTaskReduce",
+                                                      &col_impl)
+          .ok()) {
+    cp->instance.impl_details.collective_name = "HierarchicalTaskReduce";
+    VLOG(1) << "AssignCollectiveType "
+            << cp->instance.impl_details.collective_name;
+    return;
+  }
   bool use_nccl =
       (nccl_ || cp->instance.impl_details.communication_hint == "nccl") &&
       cp->group.device_type == DEVICE_GPU &&
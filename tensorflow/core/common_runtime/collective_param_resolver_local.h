@@ -149,6 +149,9 @@ class CollectiveParamResolverLocal : public ParamResolverInterface {
 
   // Establishes the final order of gp->device_names and gp->task_names by
   // considering localities of all devices.
+  // The resulting permutation is memoized by a fingerprint of the group
+  // membership, so groups with identical membership (a common pattern when
+  // many group keys span the same devices) skip the ranking computation.
   void CompleteDefaultRanking(CollGroupParams* gp);
 
   // Finish populating *cp.
@@ -208,6 +211,11 @@ class CollectiveParamResolverLocal : public ParamResolverInterface {
       instance_table_ TF_GUARDED_BY(instance_mu_);
   mutex status_mu_;
   Status status_ TF_GUARDED_BY(status_mu_);
+  // Maps a fingerprint of group membership to the member permutation
+  // computed by CompleteDefaultRanking, indexed by sorted member position.
+  mutex ranking_mu_;
+  gtl::FlatMap<uint64, std::vector<int>> ranking_cache_
+      TF_GUARDED_BY(ranking_mu_);
 };
 
 }  // namespace tensorflow
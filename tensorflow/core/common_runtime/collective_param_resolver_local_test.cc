@@ -160,6 +160,33 @@ TEST_F(CollectiveParamResolverLocalTest, CompleteDefaultRanking) {
                             });
 }
 
+TEST_F(CollectiveParamResolverLocalTest, CompleteDefaultRankingCached) {
+  constexpr int kNumGpus = 4;
+  CollGroupParams group;
+  group.device_type = DeviceType("GPU");
+  group.num_tasks = 1;
+  group.group_size = kNumGpus;
+  for (int gpu_idx = 0; gpu_idx < kNumGpus; ++gpu_idx) {
+    CollGroupMember member;
+    member.task = "/job:localhost/replica:0/task:0";
+    member.device.set_name(strings::StrCat(
+        "/job:localhost/replica:0/task:0/device:GPU:", gpu_idx));
+    group.members.push_back(member);
+  }
+  // Two groups with identical membership must produce the same ranking, and
+  // the second must reuse the permutation cached by the first.
+  CollGroupParams group1 = group;
+  CollGroupParams group2 = group;
+  prl_->CompleteDefaultRanking(&group1);
+  prl_->CompleteDefaultRanking(&group2);
+  for (int i = 0; i < kNumGpus; ++i) {
+    EXPECT_EQ(group1.members[i].device.name(),
+              group2.members[i].device.name());
+  }
+  mutex_lock l(prl_->ranking_mu_);
+  EXPECT_EQ(prl_->ranking_cache_.size(), 1);
+}
+
 TEST_F(CollectiveParamResolverLocalTest, CompleteParamsReduction1Task) {
   CollectiveParams* cps[NUM_DEVS];
   Status statuses[NUM_DEVS];
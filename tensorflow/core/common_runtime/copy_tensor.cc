@@ -16,15 +16,19 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/copy_tensor.h"
 
 #include <atomic>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/framework/device_factory.h"
 #include "tensorflow/core/framework/variant_op_registry.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/refcount.h"
+#include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/profiler/lib/scoped_annotation.h"
 #include "tensorflow/core/util/reffed_status_callback.h"
 
@@ -52,6 +56,55 @@ std::vector<RegistrationInfo>* MutableRegistry() {
   return registry;
 }
 
+// Cache of copy-path decisions per (sender, receiver) device-type pair.
+// ViaDMA runs on every device-to-device edge, so the registry scan and the
+// fall-back-via-host decision are resolved once per pair rather than per
+// copy. A cached nullptr means no function is registered for the pair and
+// the copy must be routed through host memory.
+struct CopyFunctionCache {
+  mutex mu;
+  absl::flat_hash_map<string, CopyTensor::CopyFunction> functions
+      TF_GUARDED_BY(mu);
+};
+
+CopyFunctionCache* MutableCopyFunctionCache() {
+  static CopyFunctionCache* cache = new CopyFunctionCache;
+  return cache;
+}
+
+// Returns the registered copy function for the device-type pair, or nullptr
+// if the copy has to go via the host. The result is cached;
+// CopyTensor::Register() invalidates the cache.
+CopyTensor::CopyFunction FindCopyFunction(const DeviceType& src_device_type,
+                                          const DeviceType& dst_device_type) {
+  CopyFunctionCache* cache = MutableCopyFunctionCache();
+  const string key = strings::StrCat(src_device_type.type_string(), "->",
+                                     dst_device_type.type_string());
+  {
+    mutex_lock l(cache->mu);
+    auto iter = cache->functions.find(key);
+    if (iter != cache->functions.end()) {
+      return iter->second;
+    }
+  }
+  CopyTensor::CopyFunction copy_function = nullptr;
+  // TODO(penpornk): Revisit the lookup mechanism after PR #43611 (device
+  // alias) is resolved.
+  const bool src_device_is_pluggable =
+      DeviceFactory::IsPluggableDevice(src_device_type.type_string());
+  for (const RegistrationInfo& ri : *MutableRegistry()) {
+    if (ri.sender_device_type == src_device_type &&
+        ri.receiver_device_type == dst_device_type) {
+      if (src_device_is_pluggable && !ri.is_pluggable_device) continue;
+      copy_function = ri.copy_function;
+      break;
+    }
+  }
+  mutex_lock l(cache->mu);
+  cache->functions.emplace(key, copy_function);
+  return copy_function;
+}
+
 void CopyHostToDevice(const Tensor* input, Allocator* cpu_allocator,
                       Allocator* out_allocator, StringPiece edge_name,
                       Device* dst, Tensor* output,
@@ -227,23 +280,17 @@ void CopyTensor::ViaDMA(StringPiece edge_name, DeviceContext* send_dev_context,
 
   // E.g., gpu -> gpu
   if (non_cpu_src && non_cpu_dst) {
-    // Device to device copy.  Look through registry for an appropriate
-    // CopyFunction.
-    std::vector<RegistrationInfo>* registry = MutableRegistry();
-    // TODO(penpornk): Revisit the lookup mechanism after PR #43611 (device
-    // alias) is resolved.
-    const bool src_device_is_pluggable =
-        DeviceFactory::IsPluggableDevice(src_device_type.type_string());
-    for (const RegistrationInfo& ri : *registry) {
-      if (ri.sender_device_type == src_device_type &&
-          ri.receiver_device_type == dst_device_type) {
-        if (src_device_is_pluggable && !ri.is_pluggable_device) continue;
-        CopyDeviceToDevice(ri.copy_function, cpu_allocator, out_allocator,
-                           send_dev_context, recv_dev_context, src, dst,
-                           src_alloc_attr, dst_alloc_attr, input, output,
-                           dev_to_dev_stream_index, std::move(done));
-        return;
-      }
+    // Device to device copy. The copy function resolved for this device
+    // pair (direct DMA when one is registered, e.g. peer-to-peer for GPUs
+    // with peer access enabled) is cached across copies.
+    CopyTensor::CopyFunction copy_function =
+        FindCopyFunction(src_device_type, dst_device_type);
+    if (copy_function != nullptr) {
+      CopyDeviceToDevice(copy_function, cpu_allocator, out_allocator,
+                         send_dev_context, recv_dev_context, src, dst,
+                         src_alloc_attr, dst_alloc_attr, input, output,
+                         dev_to_dev_stream_index, std::move(done));
+      return;
     }
 
     // Fall back to copying via the host.
@@ -308,6 +355,11 @@ Status CopyTensor::Register(DeviceType sender_device_type,
   std::vector<RegistrationInfo>* registry = MutableRegistry();
   registry->emplace_back(sender_device_type, receiver_device_type,
                          copy_function, is_pluggable_device);
+  // PluggableDevice copy functions may be registered after copies have
+  // already resolved (and cached) a path for their device pair.
+  CopyFunctionCache* cache = MutableCopyFunctionCache();
+  mutex_lock l(cache->mu);
+  cache->functions.clear();
   return absl::OkStatus();
 }
 
@@ -18,6 +18,7 @@ limitations under the License.
 #include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/platform/stacktrace.h"
 #include "tensorflow/core/platform/stream_executor.h"
@@ -33,6 +34,11 @@ namespace {
 //  - Should EventMgrs be shared between devices on a machine with multiple
 //  devices of the same type?
 static const int kNumThreads = 2;
+
+// In low-latency mode, how long after the most recent event completion the
+// polling loop keeps re-polling without sleeping before it falls back to
+// 1-usec sleeps.
+static const int64_t kLowLatencySpinWindowUsecs = 128;
 }  // namespace
 
 namespace device_event_mgr {
@@ -100,6 +106,7 @@ EventMgr::EventMgr(se::StreamExecutor* se, const GPUOptions& gpu_options)
       polling_active_delay_usecs_(gpu_options.polling_active_delay_usecs()
                                       ? gpu_options.polling_active_delay_usecs()
                                       : 10),
+      low_latency_(gpu_options.experimental().use_low_latency_event_poller()),
       threadpool_(Env::Default(), "Device_Event_Manager", kNumThreads) {
   device_event_mgr::InitThreadpoolLabels(&threadpool_);
   StartPollingLoop();
@@ -143,9 +150,16 @@ void EventMgr::StopPollingLoop() {
 //
 // While one or more events is outstanding, poll for completed events.  When no
 // events are outstanding, we sleep until one is enqueued.
+//
+// In low-latency mode this thread is a dedicated poller: it re-polls without
+// sleeping while completions are recent, backs off to 1-usec sleeps when the
+// streams look idle, and runs completed callbacks itself instead of handing
+// them to the callback thread.
 void EventMgr::PollLoop() {
+  uint64 last_completion_usecs = Env::Default()->NowMicros();
   while (true) {
     bool events_still_pending;
+    std::vector<std::function<void()>> to_run;
     {
       mutex_lock l(mu_);
       if (stop_polling_) {
@@ -154,12 +168,27 @@ void EventMgr::PollLoop() {
       if (callbacks_.empty()) {
         events_pending_.wait(l);
       }
-      PollEvents(/*stream=*/nullptr);  // poll all streams
+      // Poll all streams.
+      PollEvents(/*stream=*/nullptr, low_latency_ ? &to_run : nullptr);
       events_still_pending = !callbacks_.empty();
     }
 
+    if (!to_run.empty()) {
+      last_completion_usecs = Env::Default()->NowMicros();
+      for (std::function<void()>& callback : to_run) {
+        callback();
+      }
+    }
+
     if (events_still_pending) {
-      Env::Default()->SleepForMicroseconds(polling_active_delay_usecs_);
+      if (low_latency_) {
+        if (Env::Default()->NowMicros() - last_completion_usecs >
+            kLowLatencySpinWindowUsecs) {
+          Env::Default()->SleepForMicroseconds(1);
+        }
+      } else {
+        Env::Default()->SleepForMicroseconds(polling_active_delay_usecs_);
+      }
     }
   }
   polling_stopped_->Notify();
@@ -195,7 +224,9 @@ void EventMgr::EnqueueCallback(se::Stream* stream, std::function<void()> func) {
 // spikes of up to several hundred outstanding.  (If GPUKernelTracker
 // is used to cap pending kernels there should never be more than
 // that many.)
-void EventMgr::PollEvents(se::Stream* stream /*=nullptr*/) {
+void EventMgr::PollEvents(se::Stream* stream /*=nullptr*/,
+                          std::vector<std::function<void()>>* completed
+                          /*=nullptr*/) {
   VLOG(2) << "PollEvents with one or more callbacks pending on "
           << callbacks_.size() << " streams and " << free_events_.size()
           << " unused event objects.";
@@ -228,7 +259,11 @@ void EventMgr::PollEvents(se::Stream* stream /*=nullptr*/) {
               break;
             case se::Event::Status::kComplete:
               free_events_.push_back(std::move(event));
-              threadpool_.Schedule(std::move(callback));
+              if (completed != nullptr) {
+                completed->push_back(std::move(callback));
+              } else {
+                threadpool_.Schedule(std::move(callback));
+              }
               // std::deque::erase() does invalidate iterators, so we can't
               // erase `it` here.  Instead, we'll wait until the end of the loop
               // over stream_callbacks and erase all of the completed events at
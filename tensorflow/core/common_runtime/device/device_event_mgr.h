@@ -66,11 +66,20 @@ class EventMgr {
 
   // Execute `func` when all pending stream actions have completed.  func must
   // be brief and non-blocking since it executes in the one thread used for all
-  // such callbacks and also buffer deletions.
+  // such callbacks and also buffer deletions.  In low-latency mode (see
+  // GPUOptions.experimental.use_low_latency_event_poller) completed callbacks
+  // run directly on the polling thread (or the calling thread), so the same
+  // restrictions apply even more strongly.
   void ThenExecute(se::Stream* stream, std::function<void()> func) {
-    mutex_lock l(mu_);
-    EnqueueCallback(stream, std::move(func));
-    PollEvents(stream);
+    std::vector<std::function<void()>> to_run;
+    {
+      mutex_lock l(mu_);
+      EnqueueCallback(stream, std::move(func));
+      PollEvents(stream, low_latency_ ? &to_run : nullptr);
+    }
+    for (std::function<void()>& callback : to_run) {
+      callback();
+    }
   }
 
  private:
@@ -80,6 +89,10 @@ class EventMgr {
 
   se::StreamExecutor* const exec_;
   const int32 polling_active_delay_usecs_;
+  // When true, the polling loop spins with an adaptive back-off and completed
+  // callbacks are dispatched immediately on the polling (or enqueueing)
+  // thread instead of being bounced through the callback thread.
+  const bool low_latency_;
   mutex mu_;
   condition_variable events_pending_ TF_GUARDED_BY(mu_);
 
@@ -95,7 +108,12 @@ class EventMgr {
   //
   // If `stream` is not null, we only poll events for that stream.  Otherwise we
   // poll events for all streams.
-  void PollEvents(se::Stream* stream = nullptr)
+  //
+  // If `completed` is not null, callbacks of completed events are appended to
+  // it for the caller to run after releasing mu_; otherwise they are scheduled
+  // on the callback thread.
+  void PollEvents(se::Stream* stream = nullptr,
+                  std::vector<std::function<void()>>* completed = nullptr)
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // An internal polling loop that runs at a low frequency to clear straggler
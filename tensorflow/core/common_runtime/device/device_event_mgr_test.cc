@@ -134,6 +134,21 @@ TEST(EventMgr, WarnIfInCallback) {
   note.WaitForNotification();
   EXPECT_TRUE(hit);
 }
+
+// Tests that callbacks still fire (and the queue drains) when the low-latency
+// poller is enabled.
+TEST(EventMgr, LowLatencyPoller) {
+  auto stream_exec = se::GPUMachineManager()->ExecutorForDevice(0).value();
+  GPUOptions gpu_options;
+  gpu_options.mutable_experimental()->set_use_low_latency_event_poller(true);
+  TEST_EventMgr em(stream_exec, gpu_options);
+  TF_ASSERT_OK_AND_ASSIGN(auto stream, stream_exec->CreateStream());
+  Notification note;
+  em.ThenExecute(stream.get(), [&note]() { note.Notify(); });
+  note.WaitForNotification();
+  TEST_EventMgrHelper th(&em);
+  EXPECT_EQ(0, th.queue_size());
+}
 }  // namespace
 
 // Provides access to private resources of BaseGPUDevice.
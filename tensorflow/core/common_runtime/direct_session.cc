@@ -17,7 +17,9 @@ limitations under the License.
 
 #include <algorithm>
 #include <atomic>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"
@@ -41,6 +43,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/rendezvous_mgr.h"
 #include "tensorflow/core/common_runtime/scoped_allocator_mgr.h"
 #include "tensorflow/core/common_runtime/step_stats_collector.h"
+#include "tensorflow/core/common_runtime/tensor_buffer_pool.h"
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/graph_def_util.h"
@@ -48,6 +51,8 @@ limitations under the License.
 #include "tensorflow/core/framework/logging.h"
 #include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/run_handler.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/versions.pb.h"
@@ -56,6 +61,7 @@ limitations under the License.
 #include "tensorflow/core/graph/graph_partition.h"
 #include "tensorflow/core/graph/subgraph.h"
 #include "tensorflow/core/graph/tensor_id.h"
+#include "tensorflow/core/lib/core/blocking_counter.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/notification.h"
 #include "tensorflow/core/lib/core/refcount.h"
@@ -198,6 +204,14 @@ class DirectSessionFactory : public SessionFactory {
     TF_RETURN_IF_ERROR(DeviceFactory::AddDevices(
         options, "/job:localhost/replica:0/task:0", &devices));
 
+    // By session creation time op and kernel registration has quiesced, so
+    // freeze the registries into read-only snapshots. This keeps concurrent
+    // session setups (e.g. loading many models at startup) from contending
+    // on the registry mutexes; late registrations simply invalidate the
+    // snapshots and fall back to the locked paths.
+    OpRegistry::Global()->Freeze();
+    FreezeGlobalKernelRegistry();
+
     DirectSession* session = new DirectSession(
         options, new StaticDeviceMgr(std::move(devices)), this);
     {
@@ -582,8 +596,17 @@ Status DirectSession::RunInternal(
   // Use std::unique_ptr to ensure garbage collection
   std::unique_ptr<thread::ThreadPool> threadpool_wrapper;
 
+  // For tiny graphs, the hand-off from the calling thread into the inter-op
+  // thread pool costs more than the kernels themselves, so execute them
+  // inline unless the caller supplied its own inter-op pool.
+  const bool tiny_graph =
+      executors_and_keys->total_op_nodes > 0 &&
+      executors_and_keys->total_op_nodes <= kInlineGraphOpNodeThreshold &&
+      threadpool_options.inter_op_threadpool == nullptr;
+
   const bool inline_execution_requested =
-      run_in_caller_thread_ || run_options.inter_op_thread_pool() == -1;
+      run_in_caller_thread_ || run_options.inter_op_thread_pool() == -1 ||
+      tiny_graph;
 
   if (inline_execution_requested) {
     // We allow using the caller thread only when having a single executor
@@ -619,7 +642,8 @@ Status DirectSession::RunInternal(
 
   std::unique_ptr<RunHandler> handler;
   if (ShouldUseRunHandlerPool(run_options) &&
-      run_options.experimental().use_run_handler_pool()) {
+      (run_options.experimental().use_run_handler_pool() ||
+       options_.config.experimental().use_session_run_handler_pool())) {
     VLOG(1) << "Using RunHandler to scheduler inter-op closures.";
     handler = GetOrCreateRunHandlerPool(options_)->Get(
         step_id, call_timeout,
@@ -840,6 +864,87 @@ Status DirectSession::RunInternal(
   return absl::OkStatus();
 }
 
+Status DirectSession::RunCallableFastPath(
+    int64_t step_id, CallFrameInterface* call_frame,
+    ExecutorsAndKeys* executors_and_keys) {
+  DCHECK(executors_and_keys->supports_run_fast_path);
+  const uint64 start_time_usecs = options_.env->NowMicros();
+  executors_and_keys->step_count.fetch_add(1, std::memory_order_relaxed);
+  RunState run_state(step_id, &devices_);
+
+  profiler::TraceMeProducer activity(
+      // To TraceMeConsumers in ExecutorState::Process/Finish.
+      [&] {
+        return profiler::TraceMeEncode(
+            "SessionRun", {{"id", step_id}, {"_r", 1} /*root_event*/});
+      },
+      profiler::ContextType::kTfExecutor, step_id,
+      profiler::TraceMeLevel::kInfo);
+
+  // Register this step with session's cancellation manager, so that
+  // `Session::Close()` will cancel the step.
+  CancellationManager step_cancellation_manager(cancellation_manager_);
+  if (step_cancellation_manager.IsCancelled()) {
+    return errors::Cancelled("Run call was cancelled");
+  }
+
+  const PerPartitionExecutorsAndLib& item = executors_and_keys->items[0];
+
+  Executor::Args args;
+  args.step_id = step_id;
+  args.call_frame = call_frame;
+  args.session_config = &options_.config;
+  args.session_state = &session_state_;
+  args.session_handle = session_handle_;
+  args.tensor_store = &run_state.tensor_store;
+  args.step_container = &run_state.step_container;
+  args.sync_on_finish = sync_on_finish_;
+  args.start_time_usecs = start_time_usecs;
+  args.cancellation_manager = &step_cancellation_manager;
+
+  thread::ThreadPool* pool =
+      (run_in_caller_thread_ ||
+       (executors_and_keys->total_op_nodes > 0 &&
+        executors_and_keys->total_op_nodes <= kInlineGraphOpNodeThreshold))
+          ? nullptr
+          : thread_pools_[0].first;
+  args.run_all_kernels_inline = pool == nullptr;
+  thread::ThreadPool* device_thread_pool =
+      item.device->tensorflow_device_thread_pool();
+  if (device_thread_pool != nullptr) {
+    args.runner = [device_thread_pool](Executor::Args::Closure c) {
+      device_thread_pool->Schedule(std::move(c));
+    };
+  } else if (pool != nullptr) {
+    args.runner = [pool](Executor::Args::Closure c) {
+      pool->Schedule(std::move(c));
+    };
+  } else {
+    args.runner = [](const Executor::Args::Closure& c) { c(); };
+  }
+
+  PrivateIntraProcessRendezvous rendezvous(device_mgr_.get());
+  args.rendezvous = &rendezvous;
+
+  Status run_status = item.executor->Run(args);
+  if (step_cancellation_manager.IsCancelled()) {
+    run_status.Update(errors::Cancelled("Run call was cancelled"));
+  }
+  TF_RETURN_IF_ERROR(run_status);
+
+  // Save the output tensors of this run we choose to keep.
+  if (!run_state.tensor_store.empty()) {
+    TF_RETURN_IF_ERROR(run_state.tensor_store.SaveTensors(
+        {executors_and_keys->callable_options.fetch().begin(),
+         executors_and_keys->callable_options.fetch().end()},
+        &session_state_));
+  }
+
+  metrics::UpdateGraphExecTime(options_.env->NowMicros() - start_time_usecs);
+
+  return absl::OkStatus();
+}
+
 Status DirectSession::Run(const RunOptions& run_options,
                           const NamedTensorList& inputs,
                           const std::vector<string>& output_names,
@@ -1422,6 +1527,11 @@ Status DirectSession::CreateExecutors(
       if (kernel && !OpSegment::ShouldOwnKernel(lib, kernel->type_string()))
         delete kernel;
     };
+    if (options_.config.experimental().use_session_tensor_buffer_pool() &&
+        device->device_type() == DEVICE_CPU) {
+      params.session_buffer_pool = TensorBufferPool::GetForAllocator(
+          device->GetAllocator(AllocatorAttributes()));
+    }
 
     optimizer.Optimize(lib, options_.env, device, &partition_graph,
                        GraphOptimizer::Options());
@@ -1438,11 +1548,64 @@ Status DirectSession::CreateExecutors(
                                          device->name(),
                                          partition_graph.get()));
 
+    ek->total_op_nodes += partition_graph->num_op_nodes();
+
+    // Executor initialization constructs kernels serially, so expensive
+    // kernel constructors (e.g. weight packing) would otherwise all land on
+    // the first Run. When requested, instantiate the kernels for this
+    // partition across the inter-op thread pool first and let the executor
+    // pick up the finished kernels.
+    std::shared_ptr<std::unordered_map<string, OpKernel*>> prewarmed_kernels;
+    if (options_.config.experimental().parallel_kernel_instantiation() &&
+        thread_pools_[0].first != nullptr) {
+      prewarmed_kernels =
+          std::make_shared<std::unordered_map<string, OpKernel*>>();
+      thread::ThreadPool* pool = thread_pools_[0].first;
+      BlockingCounter pending(partition_graph->num_op_nodes());
+      mutex prewarm_mu;
+      for (Node* n : partition_graph->op_nodes()) {
+        pool->Schedule([&params, &pending, &prewarm_mu, &prewarmed_kernels,
+                        n]() {
+          OpKernel* kernel = nullptr;
+          // Creation failures are reported by the executor's own kernel
+          // creation below, with the node attached to the error.
+          if (params.create_kernel(n->properties(), &kernel).ok()) {
+            mutex_lock l(prewarm_mu);
+            prewarmed_kernels->emplace(n->name(), kernel);
+          }
+          pending.DecrementCount();
+        });
+      }
+      pending.Wait();
+      auto base_create_kernel = params.create_kernel;
+      params.create_kernel =
+          [prewarmed_kernels, base_create_kernel](
+              const std::shared_ptr<const NodeProperties>& props,
+              OpKernel** kernel) {
+            auto it = prewarmed_kernels->find(props->node_def.name());
+            if (it != prewarmed_kernels->end()) {
+              *kernel = it->second;
+              prewarmed_kernels->erase(it);
+              return absl::OkStatus();
+            }
+            return base_create_kernel(props, kernel);
+          };
+    }
+
     item->executor = nullptr;
     item->device = device;
     auto executor_type = options_.config.experimental().executor_type();
-    TF_RETURN_IF_ERROR(
-        NewExecutor(executor_type, params, *partition_graph, &item->executor));
+    Status create_status =
+        NewExecutor(executor_type, params, *partition_graph, &item->executor);
+    if (prewarmed_kernels != nullptr) {
+      // Release any prewarmed kernels the executor did not claim (e.g. when
+      // executor construction failed part way).
+      for (auto& entry : *prewarmed_kernels) {
+        params.delete_kernel(entry.second);
+      }
+      prewarmed_kernels->clear();
+    }
+    TF_RETURN_IF_ERROR(create_status);
     if (!options_.config.experimental().disable_output_partition_graphs() ||
         options_.config.graph_options().build_cost_model() > 0) {
       item->graph = std::move(partition_graph);
@@ -1876,6 +2039,23 @@ Status DirectSession::MakeCallable(const CallableOptions& callable_options,
   RunStateArgs run_state_args(callable_options.run_options().debug_options());
   TF_RETURN_IF_ERROR(
       CreateExecutors(callable_options, &ek, &func_info, &run_state_args));
+
+  // Decide once, at callable creation time, whether steady-state RunCallable()
+  // calls can take the reduced-overhead path in RunCallableFastPath().
+  const RunOptions& callable_run_options = callable_options.run_options();
+  ek->supports_run_fast_path =
+      ek->items.size() == 1 &&
+      ek->collective_graph_key == BuildGraphOptions::kNoCollectiveGraphKey &&
+      callable_run_options.trace_level() == RunOptions::NO_TRACE &&
+      callable_run_options.timeout_in_ms() == 0 &&
+      callable_run_options.inter_op_thread_pool() == 0 &&
+      callable_run_options.debug_options()
+          .debug_tensor_watch_opts()
+          .empty() &&
+      !callable_run_options.experimental().use_run_handler_pool() &&
+      operation_timeout_in_ms_ == 0 &&
+      options_.config.graph_options().build_cost_model() == 0;
+
   {
     mutex_lock l(callables_lock_);
     *out_handle = next_callable_handle_++;
@@ -2015,9 +2195,18 @@ class DirectSession::RunCallableCallFrame : public CallFrameInterface {
     LogMemory::RecordStep(step_id, run_state_args.handle);
   }
 
-  TF_RETURN_IF_ERROR(RunInternal(
-      step_id, executors_and_keys->callable_options.run_options(), &call_frame,
-      executors_and_keys.get(), run_metadata, threadpool_options));
+  if (TF_PREDICT_TRUE(executors_and_keys->supports_run_fast_path &&
+                      run_metadata == nullptr &&
+                      threadpool_options.inter_op_threadpool == nullptr &&
+                      threadpool_options.intra_op_threadpool == nullptr)) {
+    TF_RETURN_IF_ERROR(
+        RunCallableFastPath(step_id, &call_frame, executors_and_keys.get()));
+  } else {
+    TF_RETURN_IF_ERROR(RunInternal(
+        step_id, executors_and_keys->callable_options.run_options(),
+        &call_frame, executors_and_keys.get(), run_metadata,
+        threadpool_options));
+  }
 
   if (fetch_tensors != nullptr) {
     size_t output_size = 0;
@@ -176,8 +176,22 @@ class DirectSession : public Session {
     CallableOptions callable_options;
 
     int64_t collective_graph_key = BuildGraphOptions::kNoCollectiveGraphKey;
+
+    // True iff `RunCallable()` may use `RunCallableFastPath()` for this set of
+    // executors. Computed once in `MakeCallable()`; see the predicate there.
+    bool supports_run_fast_path = false;
+
+    // Total number of op nodes across all partitions. Used to detect tiny
+    // graphs that are cheaper to run inline on the calling thread than to
+    // hand off to the inter-op thread pool.
+    int64_t total_op_nodes = 0;
   };
 
+  // Graphs with at most this many op nodes are executed inline on the calling
+  // thread: for such graphs the hand-off into the inter-op thread pool costs
+  // more than the kernels themselves.
+  static constexpr int64_t kInlineGraphOpNodeThreshold = 5;
+
   // A FunctionInfo object is created for every unique set of feeds/fetches.
   // This info could be folded into the ExecutorsAndKeys object but we would
   // like to maintain a deletion order in which the OpKernels (owned by the
@@ -269,6 +283,16 @@ class DirectSession : public Session {
       RunMetadata* run_metadata,
       const thread::ThreadPoolOptions& threadpool_options);
 
+  // A reduced-overhead alternative to `RunInternal()` for steady-state
+  // `RunCallable()` calls: skips the debugger, cost-model, collective,
+  // run-handler and tracing hooks, and always executes the single partition
+  // synchronously on the calling thread's rendezvous.
+  //
+  // REQUIRES: `executors_and_keys->supports_run_fast_path`.
+  ::tensorflow::Status RunCallableFastPath(int64_t step_id,
+                                           CallFrameInterface* call_frame,
+                                           ExecutorsAndKeys* executors_and_keys);
+
   // Returns whether inter-op execution uses a global pool or the input
   // `run_options` requests being run on inter_op_thread_pool = 0 in case
   // multiple pools are configured.
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/direct_session.h"
 
+#include <cstdlib>
 #include <map>
 #include <memory>
 #include <random>
@@ -46,7 +47,9 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/platform/stacktrace.h"
 #include "tensorflow/core/platform/test.h"
@@ -157,6 +160,27 @@ TEST_F(DirectSessionMinusAXTest, RunSimpleNetwork) {
   EXPECT_FLOAT_EQ(5.0, mat(0, 0));
 }
 
+TEST_F(DirectSessionMinusAXTest, RunSimpleNetworkParallelKernelInstantiation) {
+  Initialize({3, 2, -1, 0});
+  SessionOptions options(DefaultSessionOptions());
+  options.config.mutable_experimental()->set_parallel_kernel_instantiation(
+      true);
+  auto session = absl::WrapUnique(NewSession(options));
+  ASSERT_TRUE(session != nullptr);
+  TF_ASSERT_OK(session->Create(def_));
+  std::vector<std::pair<string, Tensor>> inputs;
+
+  std::vector<string> output_names = {y_ + ":0"};
+  std::vector<string> target_nodes = {y_neg_};
+  std::vector<Tensor> outputs;
+  TF_ASSERT_OK(session->Run(inputs, output_names, target_nodes, &outputs));
+
+  ASSERT_EQ(1, outputs.size());
+  auto mat = outputs[0].matrix<float>();
+  ASSERT_TRUE(outputs[0].IsInitialized());
+  EXPECT_FLOAT_EQ(5.0, mat(0, 0));
+}
+
 TEST_F(DirectSessionMinusAXTest, RunSimpleNetwork_Callable) {
   Initialize({3, 2, -1, 0});
   auto session = CreateSession();
@@ -2325,6 +2349,49 @@ TEST(DirectSessionTest, LocalDeviceManager) {
   EXPECT_GT(mgr->ListDevices().size(), 0);
 }
 
+TEST(DirectSessionTest, OptimizedGraphCacheReuse) {
+  const string cache_dir =
+      io::JoinPath(testing::TmpDir(), "optimized_graph_cache");
+  TF_ASSERT_OK(Env::Default()->RecursivelyCreateDir(cache_dir));
+  setenv("TF_GRAPH_OPTIMIZATION_CACHE_DIR", cache_dir.c_str(), 1);
+
+  Graph graph(OpRegistry::Global());
+  Tensor a_tensor(DT_FLOAT, TensorShape({2, 2}));
+  test::FillValues<float>(&a_tensor, {3, 2, -1, 0});
+  Node* a = test::graph::Constant(&graph, a_tensor);
+  Tensor x_tensor(DT_FLOAT, TensorShape({2, 1}));
+  test::FillValues<float>(&x_tensor, {1, 1});
+  Node* x = test::graph::Constant(&graph, x_tensor);
+  Node* y = test::graph::Matmul(&graph, a, x, false, false);
+  GraphDef def;
+  graph.ToGraphDef(&def);
+
+  auto run_once = [&def, y](std::vector<Tensor>* outputs) {
+    auto session = CreateSession();
+    ASSERT_TRUE(session != nullptr);
+    TF_ASSERT_OK(session->Create(def));
+    TF_ASSERT_OK(
+        session->Run({}, {y->name() + ":0"}, {}, outputs));
+    ASSERT_EQ(1, outputs->size());
+  };
+
+  // The first load runs the MetaOptimizer and populates the cache.
+  std::vector<Tensor> first_outputs;
+  run_once(&first_outputs);
+  std::vector<string> cache_files;
+  TF_ASSERT_OK(Env::Default()->GetMatchingPaths(
+      io::JoinPath(cache_dir, "optimized_graph_*.pb"), &cache_files));
+  ASSERT_EQ(1, cache_files.size());
+
+  // A second session with the same graph reuses the cached optimized graph
+  // and produces the same result.
+  std::vector<Tensor> second_outputs;
+  run_once(&second_outputs);
+  test::ExpectTensorEqual<float>(first_outputs[0], second_outputs[0]);
+
+  unsetenv("TF_GRAPH_OPTIMIZATION_CACHE_DIR");
+}
+
 // A fake device representing some novel Device type.
 class FakeDevice : public Device {
  public:
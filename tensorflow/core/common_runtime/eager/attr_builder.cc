@@ -258,6 +258,8 @@ const NodeDef& AttrBuilder::BuildNodeDef() {
 void AttrBuilder::CopyAttributes(const AttrBuilder& other) {
   encoded_attrs_.insert(other.encoded_attrs_.begin(),
                         other.encoded_attrs_.end());
+  cached_cache_key_ = std::nullopt;
+  cached_attr_cache_key_ = std::nullopt;
 }
 
 Status AttrTypeByName(const AttrTypeMap& m, const string& attr_name,
@@ -307,13 +309,20 @@ tensorflow::Fprint128 AttrBuilder::CacheKey(const StringPiece device) {
 
 tensorflow::Fprint128 AttrBuilder::BuildCacheKeyForDevice(
     const StringPiece device) const {
-  tensorflow::Fprint128 f = tensorflow::Fingerprint128(op_name());
-  f = tsl::FingerprintCat128(f, tensorflow::Fingerprint128(device));
-  for (const auto& p : encoded_attrs_) {
-    CombineUnordered(
-        CacheKeyHelper(p.first, tensorflow::Fingerprint128(p.second)), &f);
+  // The attribute fingerprint does not depend on the device, so it is
+  // memoized separately.  Op dispatch computes the cache key both before
+  // and after placement, and this way the second computation only hashes
+  // the device name rather than every attribute again.
+  if (!cached_attr_cache_key_) {
+    tensorflow::Fprint128 f = tensorflow::Fingerprint128(op_name());
+    for (const auto& p : encoded_attrs_) {
+      CombineUnordered(
+          CacheKeyHelper(p.first, tensorflow::Fingerprint128(p.second)), &f);
+    }
+    cached_attr_cache_key_ = f;
   }
-  return f;
+  return tsl::FingerprintCat128(*cached_attr_cache_key_,
+                                tensorflow::Fingerprint128(device));
 }
 
 void AttrBuilder::GetNameAttrList(
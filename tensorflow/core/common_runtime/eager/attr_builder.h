@@ -108,6 +108,7 @@ class AttrBuilder : public AbstractOpAttrs {
     encoded_attrs_.clear();
     node_def_finalized_ = false;
     cached_cache_key_ = std::nullopt;
+    cached_attr_cache_key_ = std::nullopt;
     device_for_cached_cache_key_.clear();
   }
 
@@ -123,6 +124,7 @@ class AttrBuilder : public AbstractOpAttrs {
     AddAttrIfNotPresent(attr_name, attr_tmp_);
     node_def_finalized_ = false;
     cached_cache_key_ = std::nullopt;
+    cached_attr_cache_key_ = std::nullopt;
     return *this;
   }
 
@@ -131,6 +133,7 @@ class AttrBuilder : public AbstractOpAttrs {
   AttrBuilder& Set(StringPiece attr_name, const AttrValue& value) {
     AddAttrIfNotPresent(attr_name, value);
     cached_cache_key_ = std::nullopt;
+    cached_attr_cache_key_ = std::nullopt;
     return *this;
   }
 
@@ -206,6 +209,11 @@ class AttrBuilder : public AbstractOpAttrs {
   bool node_def_finalized_;
 
   std::optional<tensorflow::Fprint128> cached_cache_key_;
+  // Device-independent fingerprint of op_name_ and encoded_attrs_, memoized
+  // so that computing the cache key for a second device (op dispatch does so
+  // before and after placement) does not re-hash every attribute.  Mutable
+  // because it is filled in lazily by the const BuildCacheKeyForDevice.
+  mutable std::optional<tensorflow::Fprint128> cached_attr_cache_key_;
   string device_for_cached_cache_key_;
 };
 
@@ -815,6 +815,13 @@ Status EagerContext::AddDevices(std::vector<std::unique_ptr<Device>> devices) {
   // Add the devices to pflr's device set.
   pflr_->InitializeDeviceAndFlr();
   InitPrioritizedDeviceTypeList();
+
+  // Cached placement decisions were made against the old device set and may
+  // no longer pick the best device, so drop them.
+  {
+    mutex_lock dl(device_cache_mu_);
+    device_cache_.clear();
+  }
   return absl::OkStatus();
 }
 
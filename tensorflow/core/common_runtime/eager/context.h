@@ -781,6 +781,10 @@ class EagerContext : public ImmediateExecutionContext, public core::RefCounted {
 
   std::unordered_map<string, std::unique_ptr<FunctionLibraryDefinition>>
       component_function_libraries_ TF_GUARDED_BY(cache_mu_);
+  // Cached placement decisions, keyed by a fingerprint of the op name, attrs,
+  // requested device and input devices. Cleared whenever the device set
+  // changes since the decisions are only valid against the device set they
+  // were made with.
   absl::flat_hash_map<Fprint128, Device*, Fprint128Hasher> device_cache_
       TF_GUARDED_BY(device_cache_mu_);
   std::unordered_map<std::string, std::vector<std::function<void()>>>
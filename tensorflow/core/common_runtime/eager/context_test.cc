@@ -132,6 +132,20 @@ TEST_F(EagerContextTest, CompositeDevice) {
       "/job:localhost/replica:0/task:0/device:COMPOSITE:2", &device)));
 }
 
+TEST_F(EagerContextTest, AddDevicesInvalidatesDeviceCache) {
+  InitContext(SessionOptions(), DEVICE_PLACEMENT_EXPLICIT);
+  const Fprint128 cache_key{/*low64=*/1, /*high64=*/2};
+  context()->AddDeviceToCache(cache_key, context()->HostCPU());
+  EXPECT_EQ(context()->GetCachedDevice(cache_key), context()->HostCPU());
+
+  // Growing the device set must drop cached placement decisions; they may no
+  // longer pick the best device.
+  std::vector<std::unique_ptr<Device>> added_devices;
+  added_devices.emplace_back(CreateDevice(DEVICE_CPU, 2));
+  TF_ASSERT_OK(context()->AddDevices(std::move(added_devices)));
+  EXPECT_EQ(context()->GetCachedDevice(cache_key), nullptr);
+}
+
 TEST_F(EagerContextTest, CompositeDeviceWithGivenName) {
   InitContext(SessionOptions(), DEVICE_PLACEMENT_EXPLICIT);
   const std::vector<string> underlying_devices_0 = {
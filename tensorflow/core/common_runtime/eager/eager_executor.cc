@@ -32,15 +32,29 @@ bool IsAsyncWaitForRemoteFunctionEnabled() {
                                  true, &enabled));
   return enabled;
 }
+
+// Read per-construction rather than memoized so that tests can vary the
+// setting between executors.
+int NumExecutorLanes(bool async) {
+  if (!async) return 1;
+  int64_t num_lanes = 1;
+  TF_CHECK_OK(
+      ReadInt64FromEnvVar("TF_EAGER_EXECUTOR_NUM_LANES", 1, &num_lanes));
+  return static_cast<int>(std::max(int64_t{1}, num_lanes));
+}
 }  // namespace
 
 EagerExecutor::EagerExecutor(bool async, bool enable_streaming_enqueue,
                              int in_flight_nodes_limit)
     : next_node_id_(0),
       ok_(true),
+      num_lanes_(NumExecutorLanes(async)),
+      running_lane_threads_(async ? num_lanes_ : 0),
       thread_(async ? tensorflow::Env::Default()->StartThread(
                           tensorflow::ThreadOptions(), "eager_async_executor",
-                          std::bind(&EagerExecutor::Run, this))
+                          num_lanes_ > 1
+                              ? std::bind(&EagerExecutor::RunLane, this)
+                              : std::bind(&EagerExecutor::Run, this))
                     : nullptr),
       last_eager_client_(nullptr),
       enable_async_wait_for_remote_function_(
@@ -51,6 +65,15 @@ EagerExecutor::EagerExecutor(bool async, bool enable_streaming_enqueue,
     VLOG(4) << "EagerExecutor InFlightNodes limit is set to "
             << in_flight_nodes_limit_;
   }
+  if (async && num_lanes_ > 1) {
+    VLOG(4) << "EagerExecutor running with " << num_lanes_ << " lanes";
+    extra_lane_threads_.reserve(num_lanes_ - 1);
+    for (int i = 1; i < num_lanes_; ++i) {
+      extra_lane_threads_.emplace_back(tensorflow::Env::Default()->StartThread(
+          tensorflow::ThreadOptions(), "eager_async_executor",
+          std::bind(&EagerExecutor::RunLane, this)));
+    }
+  }
 }
 
 EagerExecutor::~EagerExecutor() {
@@ -240,10 +263,14 @@ void EagerExecutor::NodeDone(const core::RefCountPtr<NodeItem>& item,
   item->state = NodeState::kDONE;
 
   bool async = item->node->AsAsync() != nullptr;
+  // In lane mode every claimed node lives in unfinished_nodes_ until it is
+  // done, so it must be erased and its waiters notified just like an async
+  // node.
+  bool tracked = async || num_lanes_ > 1;
   // If executing synchronously we don't need to notify if status is OK since
   // the node  was never added to the unfinished_nodes_ list and nobody should
   // ever be waiting for it.
-  if (status.ok() && !from_queue && !async) {
+  if (status.ok() && !from_queue && !tracked) {
     return;
   }
 
@@ -257,7 +284,7 @@ void EagerExecutor::NodeDone(const core::RefCountPtr<NodeItem>& item,
       // Since this was from the async queue, pop it from the front of the queue
       DCHECK(!node_queue_.empty() && item.get() == node_queue_.front().get());
       node_queue_.pop();
-    } else if (async) {
+    } else if (tracked) {
       // If it is an Async node then we will find the node in the unfinished
       // nodes list. However we only notify if we are at the front of the list
       // since we don't want to notify any waiters of earlier nodes.
@@ -345,8 +372,11 @@ void EagerExecutor::NotifyWaiters(uint64 id) {
 }
 
 void EagerExecutor::Run() {
-  auto thread_exited_notifier =
-      gtl::MakeCleanup([this] { thread_exited_notification_.Notify(); });
+  auto thread_exited_notifier = gtl::MakeCleanup([this] {
+    if (running_lane_threads_.fetch_sub(1) == 1) {
+      thread_exited_notification_.Notify();
+    }
+  });
   while (true) {
     core::RefCountPtr<NodeItem> curr_item;
     {
@@ -372,6 +402,51 @@ void EagerExecutor::Run() {
   }
 }
 
+void EagerExecutor::RunLane() {
+  auto thread_exited_notifier = gtl::MakeCleanup([this] {
+    if (running_lane_threads_.fetch_sub(1) == 1) {
+      thread_exited_notification_.Notify();
+    }
+  });
+  while (true) {
+    core::RefCountPtr<NodeItem> curr_item;
+    {
+      tensorflow::mutex_lock l(node_queue_mutex_);
+      while (node_queue_.empty() || !status_.ok()) {
+        if (state_ == ExecutorState::kShutDown) return;
+        nodes_pending_.wait(l);
+      }
+      // Unlike Run(), claim the node by popping it and moving it to
+      // unfinished_nodes_ so that other lanes can claim the nodes behind it.
+      // Keeping it in unfinished_nodes_ until NodeDone ensures
+      // WaitForAllPendingNodes and NotifyWaiters still see it as pending.
+      curr_item = std::move(node_queue_.front());
+      node_queue_.pop();
+      curr_item->state = NodeState::kSCHEDULED;
+      curr_item->Ref();
+      unfinished_nodes_.emplace_hint(
+          unfinished_nodes_.end(), curr_item->id,
+          core::RefCountPtr<NodeItem>(curr_item.get()));
+    }
+    DVLOG(3) << "Running Node: [id " << curr_item->id << "] "
+             << curr_item->node->DebugString();
+    // Note: the cross-client remote-function sync heuristic in RunItem is
+    // intentionally not applied here; it relies on a total order of node
+    // execution, which lanes do not provide.
+    AsyncEagerNode* async_node = curr_item->node->AsAsync();
+    if (async_node == nullptr) {
+      tensorflow::Status status = curr_item->node->Run();
+      NodeDone(curr_item, status, /*from_queue=*/false);
+    } else {
+      auto* async_ref = curr_item.release();
+      async_node->RunAsync([this, async_ref](const Status& status) {
+        core::RefCountPtr<NodeItem> async_item(async_ref);
+        NodeDone(async_item, status, /*from_queue=*/false);
+      });
+    }
+  }
+}
+
 Status EagerExecutor::RunItem(core::RefCountPtr<NodeItem> item,
                               bool from_queue) {
   DVLOG(3) << "Running Node: [id " << item->id << "] "
@@ -107,11 +107,21 @@ class AsyncRemoteExecuteNode : public AsyncEagerNode {
 
 // A class for handling async execution (see TFE_ContextSetAsync).
 // Note that this class is thread-safe.
+//
+// By default a single thread drains the node queue in FIFO order.  When
+// TF_EAGER_EXECUTOR_NUM_LANES is set to N > 1, N lane threads claim nodes
+// from the queue instead, so independent nodes overlap on CPU.  Data
+// dependencies are enforced by TensorHandle readiness: a node that consumes
+// the output of an earlier in-flight node blocks in TensorHandle::WaitReady
+// until the producer stores its tensor.  Nodes are claimed in queue order,
+// so every producer starts no later than its consumers, which keeps the
+// scheme free of deadlock.  Side-effect ordering between ops is NOT
+// preserved across lanes, and the cross-client remote-function sync
+// heuristic is bypassed, so lanes are intended for local inference-style
+// workloads with independent branches.
 // TODO(agarwal): TFE_OpAddInput may currently block if it tries to access the
 // device of the input handle. Fix that.
 // TODO(agarwal): Implement support for control dependencies.
-// TODO(agarwal): Support out-of-order execution and dispatching multiple
-// EagerNode in parallel.
 // TODO(agarwal): Implement optimizations over EagerNode traces.
 class EagerExecutor {
  public:
@@ -210,6 +220,11 @@ class EagerExecutor {
   // `status_` is not ok.
   void Run();
 
+  // Like Run(), but claims nodes off the queue so that several lane threads
+  // can execute them concurrently. Used when num_lanes_ > 1. Every claimed
+  // node is tracked in unfinished_nodes_ until NodeDone.
+  void RunLane();
+
   Status RunItem(core::RefCountPtr<NodeItem> item, bool from_queue);
   Status MoveToUnfinished(core::RefCountPtr<NodeItem> item, bool from_queue);
 
@@ -258,10 +273,22 @@ class EagerExecutor {
   ExecutorState state_ TF_GUARDED_BY(node_queue_mutex_) =
       ExecutorState::kActive;
 
+  // Number of threads draining the node queue in async mode. Read from
+  // TF_EAGER_EXECUTOR_NUM_LANES at construction; 1 in sync mode and by
+  // default.
+  const int num_lanes_;
+
+  // Counts lane threads that have not exited yet. The last exiting thread
+  // notifies thread_exited_notification_.
+  std::atomic<int> running_lane_threads_;
+
   // Thread object that calls the `Run` method in async mode.This thread runs
   // until state_ is set to kShuttingDown. It is `nullptr` in sync mode.
   const std::unique_ptr<Thread> thread_;
 
+  // Additional lane threads running `RunLane`, started when num_lanes_ > 1.
+  std::vector<std::unique_ptr<Thread>> extra_lane_threads_;
+
   // Last device where remote function with remote inputs was executed.
   const eager::EagerClient* last_eager_client_;
 
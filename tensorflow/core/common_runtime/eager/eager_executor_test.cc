@@ -14,8 +14,10 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/common_runtime/eager/eager_executor.h"
 
+#include <cstdlib>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/status_matchers.h"
@@ -269,6 +271,42 @@ TEST(EagerExecutorTest, TestAsyncExecutorFailRunWithAsyncNode) {
   ASSERT_EQ(state->read_state(), TestState::State::kFailure);
 }
 
+TEST(EagerExecutorTest, TestMultiLaneExecutorRunsAllNodes) {
+  setenv("TF_EAGER_EXECUTOR_NUM_LANES", "4", /*overwrite=*/1);
+  auto async_executor = std::make_unique<EagerExecutor>(
+      /*async=*/true, /*enable_streaming_enqueue=*/true);
+  unsetenv("TF_EAGER_EXECUTOR_NUM_LANES");
+
+  constexpr int kNumNodes = 32;
+  std::vector<std::unique_ptr<TestState>> states;
+  for (int i = 0; i < kNumNodes; ++i) {
+    states.push_back(std::make_unique<TestState>());
+    auto node = std::make_unique<TestEagerNode>(states.back().get());
+    TF_ASSERT_OK(async_executor->AddOrExecute(std::move(node)));
+  }
+  TF_ASSERT_OK(async_executor->WaitForAllPendingNodes());
+  for (auto& state : states) {
+    ASSERT_EQ(state->read_state(), TestState::State::kSuccess);
+  }
+  TF_ASSERT_OK(async_executor->ShutDown());
+}
+
+TEST(EagerExecutorTest, TestMultiLaneExecutorFailRun) {
+  setenv("TF_EAGER_EXECUTOR_NUM_LANES", "4", /*overwrite=*/1);
+  auto async_executor = std::make_unique<EagerExecutor>(
+      /*async=*/true, /*enable_streaming_enqueue=*/true);
+  unsetenv("TF_EAGER_EXECUTOR_NUM_LANES");
+
+  auto state = std::make_unique<TestState>();
+  auto node = std::make_unique<TestEagerNode>(state.get(), absl::OkStatus(),
+                                              errors::Internal("test"));
+
+  TF_ASSERT_OK(async_executor->AddOrExecute(std::move(node)));
+  auto status = async_executor->WaitForAllPendingNodes();
+  ASSERT_EQ(status.code(), tensorflow::error::INTERNAL);
+  ASSERT_EQ(state->read_state(), TestState::State::kFailure);
+}
+
 TEST(EagerExecutorTest, TestAsyncExecutorAddNodesAfterShutdown) {
   auto async_executor = std::make_unique<EagerExecutor>(
       /*async=*/true, /*enable_streaming_enqueue=*/true);
@@ -1276,21 +1276,36 @@ Status GetOrCreateKernelAndDevice(
   // Set the EagerOperation's device prior to extracting the input_device_ptrs
   // to avoid any redundant H2D/D2H copies.
   if (device == nullptr && !op->is_function()) {
-    auto get_device_cache_key = [](EagerOperation* op,
-                                   const EagerContext& ctx) -> Fprint128 {
+    auto get_device_cache_key =
+        [](EagerOperation* op,
+           const EagerContext& ctx) -> std::optional<Fprint128> {
       Fprint128 device_cache_key =
           op->MutableAttrs()->CacheKey(op->DeviceName());
       device_cache_key =
           tsl::FingerprintCat128(device_cache_key, ctx.AllowSoftPlacement());
+      // The placement decision can depend on where the op's inputs live, so
+      // fold the input devices into the key. Ops with custom device inputs
+      // are not cached.
+      const absl::InlinedVector<TensorHandle*, 4>* inputs;
+      if (!op->TensorHandleInputs(&inputs).ok()) return std::nullopt;
+      for (TensorHandle* input : *inputs) {
+        device_cache_key = tsl::FingerprintCat128(
+            device_cache_key,
+            Fingerprint128(input->DeviceOrHostCPU(ctx)->name()));
+      }
       return device_cache_key;
     };
-    Fprint128 device_cache_key = get_device_cache_key(op, ctx);
-    device = ctx.GetCachedDevice(device_cache_key);
-    if (device == nullptr) {
-      TF_RETURN_IF_ERROR(SetOpDevice(ctx, op, &device));
-      ctx.AddDeviceToCache(device_cache_key, device);
+    std::optional<Fprint128> device_cache_key = get_device_cache_key(op, ctx);
+    if (device_cache_key.has_value()) {
+      device = ctx.GetCachedDevice(*device_cache_key);
+      if (device == nullptr) {
+        TF_RETURN_IF_ERROR(SetOpDevice(ctx, op, &device));
+        ctx.AddDeviceToCache(*device_cache_key, device);
+      } else {
+        op->SetDevice(device);
+      }
     } else {
-      op->SetDevice(device);
+      TF_RETURN_IF_ERROR(SetOpDevice(ctx, op, &device));
     }
   }
 
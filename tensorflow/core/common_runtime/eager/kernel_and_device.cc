@@ -31,6 +31,7 @@ limitations under the License.
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/cancellation.h"
 #include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/resource_mgr.h"
@@ -42,6 +43,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/map_util.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/platform/denormal.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/notification.h"
@@ -49,6 +51,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/annotated_traceme.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/public/version.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/tensor_slice_reader_cache.h"
 #if !defined(IS_MOBILE_PLATFORM)
 #include "tensorflow/core/grappler/grappler_item.h"
@@ -277,6 +280,28 @@ struct OpExecutionState : public core::RefCounted {
   // TODO(nareshmodi): consider refcounting the cancellation_manager.
   CancellationManager cancellation_manager;
 };
+
+// Period for the per-op-type cost counters: every Nth KernelAndDeviceOp::Run
+// call on a thread records op latency and bytes touched via
+// metrics::UpdateEagerOpCost. The per-call cost of the check is a
+// thread-local increment, cheap enough to stay always on in serving. Set
+// TF_EAGER_OP_COST_SAMPLE_PERIOD=0 to disable sampling entirely.
+int64_t OpCostSamplePeriod() {
+  static const int64_t period = [] {
+    int64_t v;
+    TF_CHECK_OK(ReadInt64FromEnvVar("TF_EAGER_OP_COST_SAMPLE_PERIOD",
+                                    /*default_val=*/1000, &v));
+    return v;
+  }();
+  return period;
+}
+
+bool ShouldSampleOpCost() {
+  const int64_t period = OpCostSamplePeriod();
+  if (period <= 0) return false;
+  static thread_local int64_t num_calls = 0;
+  return (++num_calls % period) == 0;
+}
 }  // anonymous namespace
 
 Status KernelAndDeviceOp::Run(
@@ -329,6 +354,12 @@ Status KernelAndDeviceOp::Run(
 
   OpKernelContext context(&params);
 
+  const bool sample_op_cost = ShouldSampleOpCost();
+  uint64 op_start_usecs = 0;
+  if (TF_PREDICT_FALSE(sample_op_cost)) {
+    op_start_usecs = Env::Default()->NowMicros();
+  }
+
   {
     port::ScopedFlushDenormal flush;
     port::ScopedSetRound round(FE_TONEAREST);
@@ -353,6 +384,26 @@ Status KernelAndDeviceOp::Run(
     return s;
   }
 
+  if (TF_PREDICT_FALSE(sample_op_cost)) {
+    // Bytes touched approximates memory traffic as the sum of input and
+    // output tensor sizes. Latency is host wall time of the Compute call,
+    // which for asynchronous devices measures dispatch rather than device
+    // completion.
+    uint64 bytes_touched = 0;
+    for (const TensorValue& v : *inputs.GetTensorValues()) {
+      if (v.tensor != nullptr) bytes_touched += v.tensor->TotalBytes();
+    }
+    for (int i = 0; i < context.num_outputs(); ++i) {
+      const Tensor* output_tensor = context.mutable_output(i);
+      if (output_tensor != nullptr) {
+        bytes_touched += output_tensor->TotalBytes();
+      }
+    }
+    metrics::UpdateEagerOpCost(kernel_->type_string(),
+                               Env::Default()->NowMicros() - op_start_usecs,
+                               bytes_touched);
+  }
+
   if (outputs != nullptr) {
     outputs->clear();
     for (int i = 0; i < context.num_outputs(); ++i) {
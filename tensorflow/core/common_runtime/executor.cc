@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -31,10 +32,12 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/executor_factory.h"
 #include "tensorflow/core/common_runtime/graph_view.h"
 #include "tensorflow/core/common_runtime/immutable_executor_state.h"
+#include "tensorflow/core/common_runtime/op_memory_sampler.h"
 #include "tensorflow/core/common_runtime/pending_counts.h"
 #include "tensorflow/core/common_runtime/propagator_state.h"
 #include "tensorflow/core/common_runtime/renamed_device.h"
 #include "tensorflow/core/common_runtime/simple_propagator_state.h"
+#include "tensorflow/core/common_runtime/step_arena_allocator.h"
 #include "tensorflow/core/common_runtime/step_stats_collector.h"
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/cancellation.h"
@@ -62,6 +65,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/manual_constructor.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/context.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
@@ -71,6 +75,7 @@ limitations under the License.
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/profiler/lib/annotated_traceme.h"
 #include "tensorflow/core/profiler/lib/connected_traceme.h"
 #include "tensorflow/core/profiler/lib/context_types.h"
@@ -145,6 +150,60 @@ struct KernelTimer {
 typedef gtl::InlinedVector<TensorValue, 4> TensorValueVec;
 typedef gtl::InlinedVector<AllocatorAttributes, 4> AllocatorAttributeVec;
 
+// A sharded ready-node queue used when the work-stealing executor mode is
+// enabled (see ConfigProto.Experimental.use_work_stealing_executor). Pushes
+// are spread across per-worker shards, and each draining worker pops from its
+// own shard before scanning the others, so bursts of ready nodes on wide
+// graphs do not serialize on a single queue mutex.
+template <typename TaggedNode>
+class WorkStealingReadyQueue {
+ public:
+  explicit WorkStealingReadyQueue(int num_shards)
+      : shards_(std::max(1, num_shards)) {}
+
+  int num_shards() const { return shards_.size(); }
+
+  void Push(const TaggedNode& tagged_node) {
+    const int shard =
+        next_shard_.fetch_add(1, std::memory_order_relaxed) % shards_.size();
+    mutex_lock l(shards_[shard].mu);
+    shards_[shard].nodes.push_back(tagged_node);
+  }
+
+  // Pops a node, preferring `worker`'s own shard. Local pops take the most
+  // recently pushed node to keep its inputs warm in cache; steals take the
+  // oldest node to minimize contention with the victim. Returns an empty
+  // optional when every shard is empty.
+  absl::optional<TaggedNode> Pop(int worker) {
+    const int num_shards = shards_.size();
+    for (int i = 0; i < num_shards; ++i) {
+      Shard& shard = shards_[(worker + i) % num_shards];
+      mutex_lock l(shard.mu);
+      if (!shard.nodes.empty()) {
+        absl::optional<TaggedNode> tagged_node;
+        if (i == 0) {
+          tagged_node = shard.nodes.back();
+          shard.nodes.pop_back();
+        } else {
+          tagged_node = shard.nodes.front();
+          shard.nodes.pop_front();
+        }
+        return tagged_node;
+      }
+    }
+    return absl::nullopt;
+  }
+
+ private:
+  struct Shard {
+    mutex mu;
+    std::deque<TaggedNode> nodes TF_GUARDED_BY(mu);
+  };
+
+  std::vector<Shard> shards_;
+  std::atomic<uint64> next_shard_{0};
+};
+
 class ExecutorImpl : public Executor {
  public:
   explicit ExecutorImpl(const LocalExecutorParams& p) : immutable_state_(p) {}
@@ -193,6 +252,11 @@ class ExecutorImpl : public Executor {
       return is_expensive_[node.node_id];
     }
 
+    // Returns the current dynamic cost estimate for the node, in cycles.
+    uint64 EstimatedCostCycles(const NodeItem& node) const {
+      return cost_estimates_[node.node_id].load(std::memory_order_relaxed);
+    }
+
     // Updates the dynamic cost estimate, which is used to determine whether the
     // given node is expensive. The new cost estimate is a weighted average of
     // the old cost estimate and the latest cost. We only update cost estimates
@@ -340,6 +404,16 @@ class ExecutorState {
   // REQUIRES: `!ready->empty()`.
   void ScheduleReady(TaggedNodeSeq* ready, TaggedNodeReadyQueue* inline_ready);
 
+  // Pushes the nodes in `*nodes` onto the work-stealing queue and spawns up to
+  // one draining worker per shard. Only called when the work-stealing executor
+  // mode is enabled.
+  void ScheduleWorkStealing(TaggedNodeSeq* nodes, int64_t scheduled_nsec);
+
+  // Sorts `*nodes` so that nodes with a higher measured cost from earlier
+  // steps are dispatched first. Stable, so nodes with equal estimates keep a
+  // deterministic order.
+  void SortByEstimatedCost(TaggedNodeSeq* nodes);
+
   // A wrapper for runner_ to keep track of the pending queue length. Op
   // execution should dispatch work using this function instead of using runner_
   // directly.
@@ -398,9 +472,18 @@ class ExecutorState {
   Executor::Args::Runner runner_;
   bool sync_on_finish_;
   const bool run_all_kernels_inline_;
+  const bool cost_priority_scheduling_;
 
   PropagatorStateType propagator_;
 
+  // Non-null iff the work-stealing executor mode is enabled for this session.
+  std::unique_ptr<WorkStealingReadyQueue<TaggedNode>> work_stealing_queue_;
+
+  // Non-null iff TF_EXECUTOR_STEP_ARENA_TEMP is set. Refcounted: this state
+  // holds one reference for the step; each outstanding temp allocation holds
+  // another, so slabs are reclaimed once both have drained.
+  StepArenaAllocator* step_arena_ = nullptr;
+
   // Invoked when the execution finishes.
   Executor::DoneCallback done_cb_;
 
@@ -448,6 +531,10 @@ ExecutorState<PropagatorStateType>::ExecutorState(
       runner_(args.runner),
       sync_on_finish_(args.sync_on_finish),
       run_all_kernels_inline_(args.run_all_kernels_inline),
+      cost_priority_scheduling_(
+          args.session_config != nullptr &&
+          args.session_config->experimental()
+              .use_cost_based_scheduling_priority()),
       propagator_(immutable_state, step_id_, vlog_),
       num_outstanding_ops_(0) {
   if (args.user_intra_op_threadpool != nullptr) {
@@ -455,6 +542,24 @@ ExecutorState<PropagatorStateType>::ExecutorState(
     user_device_ = RenamedDevice::NewRenamedDevice(
         device->name(), device, false, false, args.user_intra_op_threadpool);
   }
+  if (session_config_ != nullptr && !run_all_kernels_inline_ &&
+      session_config_->experimental().use_work_stealing_executor()) {
+    work_stealing_queue_ = std::make_unique<WorkStealingReadyQueue<TaggedNode>>(
+        port::MaxParallelism());
+  }
+  static const bool step_arena_enabled = [] {
+    bool value = false;
+    Status status =
+        ReadBoolFromEnvVar("TF_EXECUTOR_STEP_ARENA_TEMP", false, &value);
+    if (!status.ok()) {
+      LOG(ERROR) << "TF_EXECUTOR_STEP_ARENA_TEMP: " << status.message();
+    }
+    return value;
+  }();
+  if (step_arena_enabled) {
+    step_arena_ = new StepArenaAllocator(
+        immutable_state_.params().device->GetAllocator(AllocatorAttributes()));
+  }
 }
 
 template <class PropagatorStateType>
@@ -462,6 +567,11 @@ ExecutorState<PropagatorStateType>::~ExecutorState() {
   if (device_context_) {
     device_context_->Unref();
   }
+  if (step_arena_ != nullptr) {
+    // Outstanding temp allocations may still hold references; the arena
+    // frees its slabs when the last one is released.
+    step_arena_->Unref();
+  }
   delete slice_reader_cache_;
 }
 
@@ -622,6 +732,9 @@ Status ExecutorState<PropagatorStateType>::ProcessSync(
   if (outputs->size() < item.num_outputs) outputs->resize(item.num_outputs);
   s = ProcessOutputs(item, &ctx, outputs->data(), stats);
   nodestats::SetMemory(stats, &ctx);
+  if (TF_PREDICT_FALSE(stats == nullptr && ctx.track_allocations())) {
+    OpMemorySampler::Global().RecordOpExecution(&ctx);
+  }
   return s;
 }
 
@@ -678,6 +791,10 @@ void ExecutorState<PropagatorStateType>::ProcessAsync(
       Status s =
           ProcessOutputs(*state->item, &state->ctx, outputs.data(), stats);
       nodestats::SetMemory(stats, &state->ctx);
+      if (TF_PREDICT_FALSE(stats == nullptr &&
+                           state->ctx.track_allocations())) {
+        OpMemorySampler::Global().RecordOpExecution(&state->ctx);
+      }
       if (vlog_) {
         VLOG(2) << "Async kernel done: " << state->item->node_id << " step "
                 << step_id_ << " "
@@ -778,6 +895,8 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
   params->runner = &runner_;
   params->run_all_kernels_inline = run_all_kernels_inline_;
   params->stats_collector = stats_collector_;
+  params->step_arena_allocator = step_arena_;
+  params->session_buffer_pool = immutable_state_.params().session_buffer_pool;
   params->inc_num_deferred_ops_function = [this]() {
     mutex_lock lock(num_deferred_ops_mu_);
     num_deferred_ops_++;
@@ -873,6 +992,12 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
       nodestats::SetScheduled(stats, scheduled_nsec);
       nodestats::SetAllStart(stats);
     }
+    if (TF_PREDICT_FALSE(stats == nullptr && !tagged_node.get_is_dead() &&
+                         OpMemorySampler::Global().ShouldSample())) {
+      // Sampled memory attribution: track this execution's allocations and
+      // export them after compute (see ProcessSync/ProcessAsync).
+      params->track_allocations = true;
+    }
 
     if (vlog_) {
       VLOG(1) << "Process node: " << id << " step " << params->step_id << " "
@@ -1263,6 +1388,40 @@ bool ExecutorState<PropagatorStateType>::NodeDone(
   }
 }
 
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::SortByEstimatedCost(
+    TaggedNodeSeq* nodes) {
+  std::stable_sort(
+      nodes->begin(), nodes->end(),
+      [this](const TaggedNode& a, const TaggedNode& b) {
+        return kernel_stats_->EstimatedCostCycles(a.get_node_item()) >
+               kernel_stats_->EstimatedCostCycles(b.get_node_item());
+      });
+}
+
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::ScheduleWorkStealing(
+    TaggedNodeSeq* nodes, int64_t scheduled_nsec) {
+  const int num_workers = std::min<int>(
+      nodes->size(), work_stealing_queue_->num_shards());
+  for (auto& tagged_node : *nodes) {
+    work_stealing_queue_->Push(tagged_node);
+  }
+  // Each draining worker holds a reference on `num_outstanding_ops_`, so the
+  // final NodeDone cannot trigger Finish (and delete this state) while a
+  // worker is still scanning the shards.
+  num_outstanding_ops_.fetch_add(num_workers, std::memory_order_relaxed);
+  for (int i = 0; i < num_workers; ++i) {
+    RunTask([this, i, scheduled_nsec]() {
+      while (absl::optional<TaggedNode> tagged_node =
+                 work_stealing_queue_->Pop(i)) {
+        Process(*tagged_node, scheduled_nsec);
+      }
+      if (num_outstanding_ops_.fetch_sub(1) == 1) ScheduleFinish();
+    });
+  }
+}
+
 template <class PropagatorStateType>
 void ExecutorState<PropagatorStateType>::ScheduleReady(
     TaggedNodeSeq* ready, TaggedNodeReadyQueue* inline_ready) {
@@ -1282,6 +1441,13 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
     scheduled_nsec = nodestats::NowInNsec();
   }
 
+  // When cost-based priorities are enabled, dispatch the most expensive ready
+  // nodes first so critical-path kernels are not queued behind cheap
+  // bookkeeping ops.
+  if (cost_priority_scheduling_ && ready->size() > 1) {
+    SortByEstimatedCost(ready);
+  }
+
   if (run_all_kernels_inline_) {
     if (inline_ready == nullptr) {
       // Schedule all ready kernels from a single closure. This ensure that,
@@ -1302,6 +1468,11 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
     const TaggedNode* curr_expensive_node = nullptr;
     TaggedNodeSeq expensive_nodes;
     if (inline_ready == nullptr) {
+      if (work_stealing_queue_ != nullptr) {
+        ScheduleWorkStealing(ready, scheduled_nsec);
+        ready->clear();
+        return;
+      }
       // Schedule to run all the ready ops in thread pool.
       for (auto& tagged_node : *ready) {
         RunTask([=]() { Process(tagged_node, scheduled_nsec); },
@@ -1331,7 +1502,9 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
       }
     }
     if (!expensive_nodes.empty()) {
-      if (expensive_nodes.size() < kInlineScheduleReadyThreshold) {
+      if (work_stealing_queue_ != nullptr) {
+        ScheduleWorkStealing(&expensive_nodes, scheduled_nsec);
+      } else if (expensive_nodes.size() < kInlineScheduleReadyThreshold) {
         for (auto& tagged_node : expensive_nodes) {
           RunTask(std::bind(&ExecutorState::Process, this, tagged_node,
                             scheduled_nsec),
@@ -0,0 +1,235 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Executor micro-benchmarks that model production graph shapes: deep
+// sequential chains, wide fan-out, control-flow loops, and many concurrent
+// steps over the same executor. Unlike the benchmarks in executor_test.cc,
+// these are parameterized over per-node cost (via matmul size) and over the
+// number of in-flight steps, so scheduler changes can be evaluated against
+// both cheap-op dispatch overhead and expensive-op load balancing.
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/device_factory.h"
+#include "tensorflow/core/common_runtime/executor.h"
+#include "tensorflow/core/common_runtime/graph_constructor.h"
+#include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
+#include "tensorflow/core/common_runtime/process_util.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/graph/testlib.h"
+#include "tensorflow/core/lib/core/blocking_counter.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/test_benchmark.h"
+#include "tensorflow/core/public/session_options.h"
+
+namespace tensorflow {
+namespace {
+
+// Scalar float constant.
+Tensor ScalarV(float val) {
+  Tensor tensor(DT_FLOAT, TensorShape({}));
+  tensor.scalar<float>()() = val;
+  return tensor;
+}
+
+// Square float matrix filled with `val`, used to dial per-node cost.
+Tensor MatrixV(int dim, float val) {
+  Tensor tensor(DT_FLOAT, TensorShape({dim, dim}));
+  tensor.flat<float>().setConstant(val);
+  return tensor;
+}
+
+// A sequential chain of `depth` nodes with no available parallelism. With
+// dim == 0 the chain is scalar Adds (pure dispatch overhead); otherwise each
+// link is a dim x dim matmul so the scheduler sees expensive nodes.
+static void BM_DeepChain(::testing::benchmark::State& state) {
+  const int depth = state.range(0);
+  const int dim = state.range(1);
+
+  Graph* g = new Graph(OpRegistry::Global());
+  Node* cur;
+  if (dim == 0) {
+    cur = test::graph::Constant(g, ScalarV(1.0));
+    for (int i = 0; i < depth; ++i) {
+      cur = test::graph::Add(g, cur, cur);
+    }
+  } else {
+    cur = test::graph::Constant(g, MatrixV(dim, 1.0));
+    for (int i = 0; i < depth; ++i) {
+      cur = test::graph::Matmul(g, cur, cur, false, false);
+    }
+  }
+  FixupSourceAndSinkEdges(g);
+  test::Benchmark("cpu", g, /*old_benchmark_api=*/false).Run(state);
+  state.SetLabel(strings::StrCat("depth = ", depth, " dim = ", dim));
+  state.SetItemsProcessed(depth * static_cast<int64_t>(state.iterations()));
+}
+
+// Cheap chains: dominated by per-node scheduling overhead.
+BENCHMARK(BM_DeepChain)->UseRealTime()->ArgPair(64, 0)->ArgPair(1024, 0);
+// Expensive chains: dominated by kernel compute.
+BENCHMARK(BM_DeepChain)->UseRealTime()->ArgPair(64, 64)->ArgPair(256, 64);
+
+// A single source fanning out to `fanout` independent nodes, all ready at
+// once. Models the worst case for ready-queue contention: one propagation
+// makes a large batch of nodes runnable simultaneously.
+static void BM_WideFanout(::testing::benchmark::State& state) {
+  const int fanout = state.range(0);
+  const int dim = state.range(1);
+
+  Graph* g = new Graph(OpRegistry::Global());
+  Node* src = test::graph::Constant(g, dim == 0 ? ScalarV(1.0)
+                                                : MatrixV(dim, 1.0));
+  for (int i = 0; i < fanout; ++i) {
+    if (dim == 0) {
+      test::graph::Identity(g, src);
+    } else {
+      test::graph::Matmul(g, src, src, false, false);
+    }
+  }
+  FixupSourceAndSinkEdges(g);
+  test::Benchmark("cpu", g, /*old_benchmark_api=*/false).Run(state);
+  state.SetLabel(strings::StrCat("fanout = ", fanout, " dim = ", dim));
+  state.SetItemsProcessed((fanout + 1) *
+                          static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(BM_WideFanout)
+    ->UseRealTime()
+    ->ArgPair(100, 0)
+    ->ArgPair(1000, 0)
+    ->ArgPair(100, 64)
+    ->ArgPair(1000, 64);
+
+// An Enter node with `is_constant` set, so the entered value is visible in
+// every loop iteration (test::graph::Enter only builds iteration-0 inputs).
+Node* ConstantEnter(Graph* g, Node* input, const string& frame_name) {
+  Node* ret;
+  TF_CHECK_OK(NodeBuilder(g->NewName("n"), "Enter")
+                  .Input(input)
+                  .Attr("frame_name", frame_name)
+                  .Attr("is_constant", true)
+                  .Finalize(g, &ret));
+  return ret;
+}
+
+// A raw Switch/Merge/NextIteration loop that iterates `loop_iters` times.
+// This exercises the full PropagatorState control-flow machinery (frames and
+// iterations) rather than the SimplePropagatorState fast path.
+static void BM_ControlFlowLoop(::testing::benchmark::State& state) {
+  const int loop_iters = state.range(0);
+
+  Graph* g = new Graph(OpRegistry::Global());
+  // i = 0; while (i < loop_iters) i += 1;
+  Node* zero = test::graph::Constant(g, ScalarV(0.0));
+  Node* one = test::graph::Constant(g, ScalarV(1.0));
+  Node* limit = test::graph::Constant(g, ScalarV(loop_iters));
+  Node* enter_i = test::graph::Enter(g, zero, "loop");
+  Node* enter_one = ConstantEnter(g, one, "loop");
+  Node* enter_limit = ConstantEnter(g, limit, "loop");
+  Node* merge_i = test::graph::Merge(g, enter_i, enter_i);
+  Node* less = test::graph::Less(g, merge_i, enter_limit);
+  Node* cond = test::graph::LoopCond(g, less);
+  Node* switch_i = test::graph::Switch(g, merge_i, cond);
+  // Output 0 of Switch is the false (exit) branch; output 1 continues.
+  test::graph::Exit(g, test::graph::Identity(g, switch_i, 0));
+  Node* i_true = test::graph::Identity(g, switch_i, 1);
+  Node* next_i =
+      test::graph::Next(g, g->NewName("n"),
+                        test::graph::Add(g, i_true, enter_one));
+  // Rewire the second Merge input to close the back edge.
+  TF_CHECK_OK(g->UpdateEdge(next_i, 0, merge_i, 1));
+
+  FixupSourceAndSinkEdges(g);
+  test::Benchmark("cpu", g, /*old_benchmark_api=*/false).Run(state);
+  state.SetLabel(strings::StrCat("loop_iters = ", loop_iters));
+  state.SetItemsProcessed(loop_iters * static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(BM_ControlFlowLoop)->UseRealTime()->Arg(10)->Arg(100)->Arg(1000);
+
+// Runs `concurrent_steps` steps of the same executor in flight at once,
+// sharing one inter-op pool. Models a serving host executing many small
+// requests against one session, where steps contend on the scheduler rather
+// than on kernels.
+static void BM_ConcurrentSteps(::testing::benchmark::State& state) {
+  const int concurrent_steps = state.range(0);
+  const int width = state.range(1);
+
+  auto device = DeviceFactory::NewDevice("CPU", {},
+                                         "/job:localhost/replica:0/task:0");
+  auto g = std::make_unique<Graph>(OpRegistry::Global());
+  Node* src = test::graph::Constant(g.get(), ScalarV(1.0));
+  for (int i = 0; i < width; ++i) {
+    test::graph::Add(g.get(), src, src);
+  }
+  FixupSourceAndSinkEdges(g.get());
+
+  const int version = g->versions().producer();
+  LocalExecutorParams params;
+  params.device = device.get();
+  params.create_kernel =
+      [&device, version](const std::shared_ptr<const NodeProperties>& props,
+                         OpKernel** kernel) {
+        return CreateNonCachedKernel(device.get(), nullptr, props, version,
+                                     kernel);
+      };
+  params.delete_kernel = [](OpKernel* kernel) {
+    DeleteNonCachedKernel(kernel);
+  };
+  Executor* exec = nullptr;
+  TF_CHECK_OK(NewLocalExecutor(params, *g, &exec));
+
+  SessionOptions options;
+  thread::ThreadPool* pool = ComputePool(options);
+  Executor::Args::Runner runner = [pool](std::function<void()> fn) {
+    pool->Schedule(std::move(fn));
+  };
+
+  for (auto s : state) {
+    BlockingCounter counter(concurrent_steps);
+    for (int i = 0; i < concurrent_steps; ++i) {
+      pool->Schedule([exec, &runner, &counter]() {
+        Executor::Args args;
+        args.runner = runner;
+        TF_CHECK_OK(exec->Run(args));
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+  }
+  state.SetLabel(strings::StrCat("steps = ", concurrent_steps,
+                                 " width = ", width));
+  state.SetItemsProcessed(concurrent_steps * (width + 1) *
+                          static_cast<int64_t>(state.iterations()));
+  delete exec;
+}
+
+BENCHMARK(BM_ConcurrentSteps)
+    ->UseRealTime()
+    ->ArgPair(1, 64)
+    ->ArgPair(8, 64)
+    ->ArgPair(64, 64)
+    ->ArgPair(64, 1024);
+
+}  // namespace
+}  // namespace tensorflow
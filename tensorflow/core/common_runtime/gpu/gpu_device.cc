@@ -113,6 +113,9 @@ namespace tensorflow {
 
 namespace {
 
+// Upper bound on GPUOptions.experimental.num_compute_stream_groups.
+constexpr int kMaxComputeStreamGroups = 4;
+
 // Returns priority for the given virtual GPU id from the session options.
 // Returns 0 if no virtual devices are specified.
 int GetPriority(const int tf_device_id, const GPUOptions& options) {
@@ -480,14 +483,14 @@ BaseGPUDevice::BaseGPUDevice(const SessionOptions& options, const string& name,
 
 BaseGPUDevice::~BaseGPUDevice() {
   delete accelerator_device_info_;
-  if (scratch_) gpu_allocator_->DeallocateRaw(scratch_);
-  device_context_->Unref();
+  for (char* scratch : scratch_) gpu_allocator_->DeallocateRaw(scratch);
+  for (GPUDeviceContext* context : device_contexts_) context->Unref();
 }
 
 // This should be idempotent if already initialized.
 Status BaseGPUDevice::InitScratchBuffers() {
   mutex_lock l(scratch_init_mutex_);
-  if (!scratch_) {
+  while (scratch_.size() < stream_groups_.size()) {
     DCHECK(stream_);
     size_t scratch_buffer_size = Eigen::kGpuScratchSize + sizeof(unsigned int);
     profiler::ScopedMemoryDebugAnnotation op_annotation("ScratchBuffer");
@@ -502,7 +505,7 @@ Status BaseGPUDevice::InitScratchBuffers() {
         se::DeviceMemoryBase(scratch_buffer, scratch_buffer_size));
     TF_RETURN_IF_ERROR(executor_->SynchronousMemZero(
         &mem, Eigen::kGpuScratchSize + sizeof(unsigned int)));
-    scratch_ = static_cast<char*>(scratch_buffer);
+    scratch_.push_back(static_cast<char*>(scratch_buffer));
   }
   return OkStatus();
 }
@@ -564,6 +567,43 @@ Status BaseGPUDevice::Init(const SessionOptions& options) {
 #endif
                            stream_->host_to_device, stream_->device_to_host,
                            stream_->device_to_device, host_memory_allocator);
+  stream_groups_.push_back(stream_);
+  device_contexts_.push_back(device_context_);
+
+#ifndef TF_GPU_USE_PJRT
+  // Additional compute stream groups, handed out to executors round-robin by
+  // TryGetDeviceContext so that independent subgraphs can overlap on the
+  // device. When PJRT manages the streams there is only the single group it
+  // provides.
+  int num_stream_groups =
+      options.config.gpu_options().experimental().num_compute_stream_groups();
+  if (num_stream_groups == 0) num_stream_groups = 1;
+  if (num_stream_groups < 1 || num_stream_groups > kMaxComputeStreamGroups) {
+    LOG(ERROR)
+        << "Illegal GPUOptions.experimental.num_compute_stream_groups="
+        << num_stream_groups << " set to 1 instead.";
+    num_stream_groups = 1;
+  }
+  if (num_stream_groups > 1 &&
+      !options.config.gpu_options().experimental().timestamped_allocator()) {
+    LOG(WARNING)
+        << "GPUOptions.experimental.num_compute_stream_groups > 1 without "
+           "timestamped_allocator: memory freed on one stream may be reused "
+           "on another stream while the freeing kernel is still pending.";
+  }
+  for (int i = 1; i < num_stream_groups; ++i) {
+    StreamGroup* group = StreamGroupFactory::Global().GetOrCreate(
+        tf_device_id_, i, executor_, options.config.gpu_options());
+    stream_groups_.push_back(group);
+    device_contexts_.push_back(
+        new GPUDeviceContext(i, group->compute,
+#if TENSORFLOW_USE_ROCM
+                             group->nccl,
+#endif
+                             group->host_to_device, group->device_to_host,
+                             group->device_to_device, host_memory_allocator));
+  }
+#endif  // TF_GPU_USE_PJRT
 
   em_ = EventMgrFactory::Singleton()->GetEventMgr(executor_,
                                                   options.config.gpu_options());
@@ -850,11 +890,29 @@ Status BaseGPUDevice::Sync() {
 
   // Device::Sync is supposed to block until all operations queued on the device
   // at the time of the call have completed.  On GPUs, only operations enqueued
-  // on the compute stream can remain pending after the (Async)OpKernel that
+  // on the compute streams can remain pending after the (Async)OpKernel that
   // enqueued the operation has completed.  We do use other streams for copies
   // and collectives, but in those cases the (Async)OpKernels themselves block
   // until the queued operation has finished.
-  return stream_->compute->BlockHostUntilDone();
+  for (StreamGroup* group : stream_groups_) {
+    TF_RETURN_IF_ERROR(group->compute->BlockHostUntilDone());
+  }
+  return OkStatus();
+}
+
+Status BaseGPUDevice::TryGetDeviceContext(DeviceContext** out_context) {
+  if (device_contexts_.size() == 1) {
+    // Single stream group: report no per-executor context so callers fall
+    // back to the default context from AcceleratorDeviceInfo, as before.
+    *out_context = nullptr;
+    return OkStatus();
+  }
+  GPUDeviceContext* context =
+      device_contexts_[static_cast<size_t>(next_stream_group_.fetch_add(1)) %
+                       device_contexts_.size()];
+  context->Ref();
+  *out_context = context;
+  return OkStatus();
 }
 
 void BaseGPUDevice::ComputeAsync(AsyncOpKernel* op_kernel,
@@ -1289,11 +1347,11 @@ void BaseGPUDevice::ReinitializeDevice(OpKernelContext* context,
   ConcretePerOpGpuDevice* concrete_device =
       static_cast<ConcretePerOpGpuDevice*>(device);
   DCHECK(concrete_device);
-  DCHECK_EQ(stream_id, 0);
+  DCHECK_LT(stream_id, static_cast<int>(stream_groups_.size()));
   const gpuStream_t gpu_stream = reinterpret_cast<gpuStream_t>(
-      stream_->compute->platform_specific_handle().stream);
+      stream_groups_[stream_id]->compute->platform_specific_handle().stream);
   concrete_device->Reinitialize(context, gpu_stream, tf_device_id_, allocator,
-                                scratch_);
+                                scratch_[stream_id]);
 }
 
 PerOpGpuDevice* BaseGPUDevice::MakeGpuDevice() {
@@ -1310,7 +1368,7 @@ Status BaseGPUDevice::ReinitializeGpuDevice(OpKernelContext* context,
     const int stream_id = gpu_dc->stream_id();
     VLOG(1) << "  eigen_gpu_device(" << dc << ") => stream[" << stream_id
             << "]";
-    CHECK_EQ(stream_id, 0);
+    CHECK_LT(stream_id, static_cast<int>(stream_groups_.size()));
     ReinitializeDevice(context, device, stream_id, allocator);
   } else {
     ReinitializeDevice(context, device, 0, allocator);
@@ -26,6 +26,7 @@ limitations under the License.
 #define TF_GPU_USE_PJRT
 #endif  // PLATFORM_GOOGLE && TF_PLATFORM_LINUX_X86_64
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -139,6 +140,13 @@ class BaseGPUDevice : public LocalDevice {
                                DeviceContext* dc,
                                Allocator* allocator) override;
 
+  // Hands out the device contexts of this device's stream groups round-robin,
+  // so that each executor acquiring a context runs on its own compute stream
+  // when GPUOptions.experimental.num_compute_stream_groups > 1. Returns
+  // nullptr (i.e. the default-context fallback) when only one stream group
+  // exists, which is the default.
+  Status TryGetDeviceContext(DeviceContext** out_context) override;
+
   // Returns the platform GPU id of this device within the native driver system;
   // e.g., for CUDA and ROCm this is the ordinal of the GPU within the system.
   int gpu_id() const {
@@ -206,9 +214,18 @@ class BaseGPUDevice : public LocalDevice {
 
   core::RefCountPtr<DeviceContext> pjrt_device_context_;
   StreamGroup* stream_;
+  // All stream groups of this device. stream_groups_[0] == stream_; further
+  // entries exist only when num_compute_stream_groups > 1.
+  gtl::InlinedVector<StreamGroup*, 4> stream_groups_;
   mutex scratch_init_mutex_;
-  char* scratch_ = nullptr;
+  // One Eigen scratch buffer per stream group; the buffer must not be shared
+  // across streams that may run concurrently.
+  gtl::InlinedVector<char*, 4> scratch_;
   GPUDeviceContext* device_context_;
+  // One device context per stream group; device_contexts_[0] ==
+  // device_context_. TryGetDeviceContext rotates through them.
+  gtl::InlinedVector<GPUDeviceContext*, 4> device_contexts_;
+  std::atomic<int64_t> next_stream_group_{0};
   DeviceBase::AcceleratorDeviceInfo* accelerator_device_info_ = nullptr;
   mutex trace_mu_;
   tsl::TfDeviceId tf_device_id_;
@@ -645,6 +645,75 @@ TEST_F(GPUDeviceTest, StreamToIdMultipleVirtualDevices) {
   EXPECT_FALSE(BaseGPUDevice::FindTfDeviceId(nullptr).has_value());
 }
 
+TEST_F(GPUDeviceTest, SingleComputeStreamGroupReturnsNoContext) {
+  // With the default single stream group, executors fall back to the default
+  // context from AcceleratorDeviceInfo.
+  SessionOptions opts = MakeSessionOptions("0");
+  std::vector<std::unique_ptr<Device>> devices;
+  TF_CHECK_OK(DeviceFactory::GetFactory("GPU")->CreateDevices(
+      opts, kDeviceNamePrefix, &devices));
+  ASSERT_EQ(devices.size(), 1);
+  DeviceContext* context = nullptr;
+  TF_ASSERT_OK(devices[0]->TryGetDeviceContext(&context));
+  EXPECT_EQ(context, nullptr);
+}
+
+TEST_F(GPUDeviceTest, MultipleComputeStreamGroups) {
+  SessionOptions opts = MakeSessionOptions("0");
+  opts.config.mutable_gpu_options()
+      ->mutable_experimental()
+      ->set_num_compute_stream_groups(2);
+  std::vector<std::unique_ptr<Device>> devices;
+  TF_CHECK_OK(DeviceFactory::GetFactory("GPU")->CreateDevices(
+      opts, kDeviceNamePrefix, &devices));
+  ASSERT_EQ(devices.size(), 1);
+
+  // Contexts are handed out round-robin over the two stream groups, so
+  // consecutive executors land on distinct compute streams.
+  DeviceContext* context0 = nullptr;
+  DeviceContext* context1 = nullptr;
+  DeviceContext* context2 = nullptr;
+  TF_ASSERT_OK(devices[0]->TryGetDeviceContext(&context0));
+  TF_ASSERT_OK(devices[0]->TryGetDeviceContext(&context1));
+  TF_ASSERT_OK(devices[0]->TryGetDeviceContext(&context2));
+  ASSERT_NE(context0, nullptr);
+  ASSERT_NE(context1, nullptr);
+  EXPECT_NE(context0, context1);
+  EXPECT_EQ(context0, context2);
+  EXPECT_EQ(static_cast<GPUDeviceContext*>(context0)->stream_id(), 0);
+  EXPECT_EQ(static_cast<GPUDeviceContext*>(context1)->stream_id(), 1);
+  EXPECT_NE(static_cast<GPUDeviceContext*>(context0)->stream(),
+            static_cast<GPUDeviceContext*>(context1)->stream());
+  context0->Unref();
+  context1->Unref();
+  context2->Unref();
+}
+
+TEST_F(GPUDeviceTest, PooledGpuHostAllocator) {
+  SessionOptions opts = MakeSessionOptions("0");
+  opts.config.mutable_gpu_options()
+      ->mutable_experimental()
+      ->set_use_pooled_gpu_host_allocator(true);
+  std::vector<std::unique_ptr<Device>> devices;
+  TF_CHECK_OK(DeviceFactory::GetFactory("GPU")->CreateDevices(
+      opts, kDeviceNamePrefix, &devices));
+  ASSERT_EQ(devices.size(), 1);
+
+  Allocator* host_allocator = GPUProcessState::singleton()->GetGpuHostAllocator(
+      opts.config.gpu_options(), /*numa_node=*/0);
+  ASSERT_NE(host_allocator, nullptr);
+  EXPECT_EQ(host_allocator->Name(), "gpu_host_pool");
+
+  // Pinned staging buffers are recycled: a freed buffer satisfies the next
+  // request of the same size class without going back to the driver.
+  void* first = host_allocator->AllocateRaw(64, 1 << 20);
+  ASSERT_NE(first, nullptr);
+  host_allocator->DeallocateRaw(first);
+  void* second = host_allocator->AllocateRaw(64, 1 << 20);
+  EXPECT_EQ(second, first);
+  host_allocator->DeallocateRaw(second);
+}
+
 class GPUKernelTrackerTest : public ::testing::Test {
  protected:
   void Init(const GPUKernelTracker::Params& params) {
@@ -0,0 +1,65 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_graph_replay_cache.h"
+
+#include <memory>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "xla/stream_executor/command_buffer.h"
+#include "xla/stream_executor/trace_command_buffer_factory.h"
+#include "tsl/platform/errors.h"
+#include "tsl/platform/statusor.h"
+
+namespace tensorflow {
+
+absl::Status GpuGraphReplayCache::ExecuteOrCapture(
+    uint64 key, se::Stream* stream,
+    absl::AnyInvocable<absl::Status(se::Stream*)> launch_fn) {
+  {
+    mutex_lock l(mu_);
+    auto iter = buffers_.find(key);
+    if (iter != buffers_.end()) {
+      return executor_->Submit(stream, *iter->second);
+    }
+  }
+
+  // Capture outside the lock; captures for distinct keys may proceed
+  // concurrently on distinct streams.
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<se::CommandBuffer> buffer,
+                      se::TraceCommandBufferFactory::Create(
+                          executor_, stream, std::move(launch_fn),
+                          se::CommandBuffer::Mode::kPrimary));
+
+  mutex_lock l(mu_);
+  auto emplace_result = buffers_.emplace(key, std::move(buffer));
+  // Tracing records the work without executing it, so submit once for the
+  // current step. If another thread captured the same key concurrently, its
+  // buffer won; submit that one and let ours be destroyed.
+  return executor_->Submit(stream, *emplace_result.first->second);
+}
+
+void GpuGraphReplayCache::Invalidate(uint64 key) {
+  mutex_lock l(mu_);
+  buffers_.erase(key);
+}
+
+int64_t GpuGraphReplayCache::size() const {
+  mutex_lock l(mu_);
+  return buffers_.size();
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,75 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_GRAPH_REPLAY_CACHE_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_GRAPH_REPLAY_CACHE_H_
+
+#include <memory>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "xla/stream_executor/command_buffer.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/stream_executor.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// Caches captured device command buffers (CUDA graphs on the CUDA backend,
+// HIP graphs on ROCm) keyed by the caller's step signature, so that a fixed
+// kernel launch sequence executed many times per second is captured once and
+// replayed with a single submission afterwards, eliminating the per-launch
+// CPU overhead.
+//
+// The caller owns the correctness prerequisites of replay: the launch
+// sequence must be identical across steps (same kernels, same device buffer
+// addresses, no host-side side effects inside the captured region), and the
+// key must fingerprint everything that can change it — typically the feed
+// shapes and the input/output buffer addresses. Call Invalidate (or switch
+// to a new key) when any of those change, e.g. on a shape change.
+class GpuGraphReplayCache {
+ public:
+  explicit GpuGraphReplayCache(se::StreamExecutor* executor)
+      : executor_(executor) {}
+
+  // Replays the command buffer cached under `key` on `stream` if one exists.
+  // Otherwise runs `launch_fn` under capture — recording all StreamExecutor
+  // work issued on the stream passed to it — caches the finalized command
+  // buffer under `key`, and submits it once so the current step still
+  // executes. Host-side work in `launch_fn` runs only during the capture
+  // step.
+  absl::Status ExecuteOrCapture(
+      uint64 key, se::Stream* stream,
+      absl::AnyInvocable<absl::Status(se::Stream*)> launch_fn);
+
+  // Drops the command buffer cached under `key`, e.g. after a shape change.
+  void Invalidate(uint64 key);
+
+  // Number of captured command buffers currently cached.
+  int64_t size() const;
+
+ private:
+  se::StreamExecutor* const executor_;  // not owned
+
+  mutable mutex mu_;
+  absl::flat_hash_map<uint64, std::unique_ptr<se::CommandBuffer>> buffers_
+      TF_GUARDED_BY(mu_);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_GRAPH_REPLAY_CACHE_H_
@@ -0,0 +1,80 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_graph_replay_cache.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "xla/stream_executor/gpu/gpu_init.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/stream_executor.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(GpuGraphReplayCacheTest, CaptureThenReplay) {
+  se::StreamExecutor* executor =
+      se::GPUMachineManager()->ExecutorForDevice(0).value();
+  TF_ASSERT_OK_AND_ASSIGN(auto stream, executor->CreateStream());
+
+  constexpr int kNumElements = 16;
+  constexpr uint64_t kKey = 1;
+  se::DeviceMemory<uint32_t> mem =
+      executor->AllocateArray<uint32_t>(kNumElements);
+  ASSERT_FALSE(mem.is_null());
+
+  GpuGraphReplayCache cache(executor);
+  int capture_count = 0;
+  auto launch_fn = [&](se::Stream* capture_stream) {
+    ++capture_count;
+    return capture_stream->Memset32(&mem, 42, mem.size());
+  };
+
+  // First execution captures and submits the command buffer.
+  TF_ASSERT_OK(cache.ExecuteOrCapture(kKey, stream.get(), launch_fn));
+  TF_ASSERT_OK(stream->BlockHostUntilDone());
+  EXPECT_EQ(capture_count, 1);
+  EXPECT_EQ(cache.size(), 1);
+
+  std::vector<uint32_t> host(kNumElements, 0);
+  TF_ASSERT_OK(stream->Memcpy(host.data(), mem, mem.size()));
+  TF_ASSERT_OK(stream->BlockHostUntilDone());
+  for (uint32_t value : host) EXPECT_EQ(value, 42);
+
+  // Clobber the buffer, then replay: the cached command buffer must rerun the
+  // captured memset without invoking launch_fn again.
+  TF_ASSERT_OK(stream->MemZero(&mem, mem.size()));
+  TF_ASSERT_OK(cache.ExecuteOrCapture(kKey, stream.get(), launch_fn));
+  TF_ASSERT_OK(stream->BlockHostUntilDone());
+  EXPECT_EQ(capture_count, 1);
+
+  TF_ASSERT_OK(stream->Memcpy(host.data(), mem, mem.size()));
+  TF_ASSERT_OK(stream->BlockHostUntilDone());
+  for (uint32_t value : host) EXPECT_EQ(value, 42);
+
+  // Invalidation (e.g. on a shape change) forces a re-capture.
+  cache.Invalidate(kKey);
+  EXPECT_EQ(cache.size(), 0);
+  TF_ASSERT_OK(cache.ExecuteOrCapture(kKey, stream.get(), launch_fn));
+  TF_ASSERT_OK(stream->BlockHostUntilDone());
+  EXPECT_EQ(capture_count, 2);
+
+  executor->Deallocate(&mem);
+}
+
+}  // namespace
+}  // namespace tensorflow
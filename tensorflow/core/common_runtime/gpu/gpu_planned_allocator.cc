@@ -0,0 +1,170 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/gpu/gpu_planned_allocator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "tensorflow/core/lib/monitoring/counter.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+
+namespace {
+
+auto* planned_hits = monitoring::Counter<1>::New(
+    "/tensorflow/core/gpu_planned_allocator/hits",
+    "Number of GPU allocations served from the pre-carved memory plan.",
+    "allocator_name");
+auto* planned_misses = monitoring::Counter<1>::New(
+    "/tensorflow/core/gpu_planned_allocator/misses",
+    "Number of planned-size GPU allocations that exceeded the captured peak "
+    "and fell through to the wrapped allocator.",
+    "allocator_name");
+
+int64_t Int64FromEnv(const char* var, int64_t default_value) {
+  int64_t value = default_value;
+  Status status = ReadInt64FromEnvVar(var, default_value, &value);
+  if (!status.ok()) {
+    LOG(ERROR) << var << ": " << status.message();
+  }
+  return value;
+}
+
+}  // namespace
+
+GpuPlannedAllocator::GpuPlannedAllocator(Allocator* base, const string& name)
+    : base_(base),
+      name_(name),
+      warmup_allocs_(Int64FromEnv("TF_GPU_MEM_PLAN_WARMUP_ALLOCS", 8192)),
+      max_plan_bytes_(Int64FromEnv("TF_GPU_MEM_PLAN_MAX_BYTES", 1LL << 30)) {}
+
+GpuPlannedAllocator::~GpuPlannedAllocator() {
+  for (auto& entry : plan_) {
+    SizeBin* bin = entry.second.get();
+    mutex_lock l(bin->mu);
+    for (void* ptr : bin->free_buffers) {
+      base_->DeallocateRaw(ptr);
+    }
+    bin->free_buffers.clear();
+  }
+  // Planned buffers still held by live tensors at destruction time leak back
+  // to the wrapped allocator when those tensors are freed; the device is
+  // being torn down at that point, so this is benign.
+  delete base_;
+}
+
+void GpuPlannedAllocator::BuildPlan() {
+  int64_t planned_bytes = 0;
+  int64_t planned_buffers = 0;
+  for (const auto& entry : capture_) {
+    const size_t size = entry.first;
+    const CaptureRecord& rec = entry.second;
+    // Only recurring sizes benefit from a static plan; one-off allocations
+    // (e.g. initialization scratch) stay with the wrapped allocator.
+    if (rec.count < 2 || rec.peak_live < 1) continue;
+    auto bin = std::make_unique<SizeBin>();
+    for (int64_t i = 0; i < rec.peak_live; ++i) {
+      if (planned_bytes + static_cast<int64_t>(size) > max_plan_bytes_) break;
+      void* ptr = base_->AllocateRaw(Allocator::kAllocatorAlignment, size);
+      if (ptr == nullptr) break;
+      planned_bytes += size;
+      ++planned_buffers;
+      bin->free_buffers.push_back(ptr);
+      planned_ptrs_[ptr] = bin.get();
+    }
+    if (!bin->free_buffers.empty()) {
+      plan_.emplace(size, std::move(bin));
+    }
+  }
+  VLOG(1) << name_ << ": memory plan built from " << capture_allocs_
+          << " warmup allocations: " << plan_.size() << " sizes, "
+          << planned_buffers << " buffers, " << planned_bytes
+          << " bytes pre-carved.";
+  capture_.clear();
+  // Pointers still live from the capture phase are not in planned_ptrs_, so
+  // their frees fall through to the wrapped allocator as before.
+  capture_ptrs_.clear();
+  plan_ready_.store(true, std::memory_order_release);
+}
+
+void* GpuPlannedAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
+  if (num_bytes == 0 || alignment > Allocator::kAllocatorAlignment) {
+    return base_->AllocateRaw(alignment, num_bytes);
+  }
+  const size_t rounded = RoundSize(num_bytes);
+  if (plan_ready_.load(std::memory_order_acquire)) {
+    auto it = plan_.find(rounded);
+    if (it != plan_.end()) {
+      SizeBin* bin = it->second.get();
+      void* ptr = nullptr;
+      {
+        mutex_lock l(bin->mu);
+        if (!bin->free_buffers.empty()) {
+          ptr = bin->free_buffers.back();
+          bin->free_buffers.pop_back();
+        }
+      }
+      if (ptr != nullptr) {
+        planned_hits->GetCell(name_)->IncrementBy(1);
+        return ptr;
+      }
+      planned_misses->GetCell(name_)->IncrementBy(1);
+    }
+    return base_->AllocateRaw(alignment, num_bytes);
+  }
+  // Capture phase: pass through while recording the live-buffer profile.
+  void* ptr = base_->AllocateRaw(alignment, num_bytes);
+  if (ptr == nullptr) return ptr;
+  mutex_lock l(capture_mu_);
+  if (!plan_ready_.load(std::memory_order_relaxed)) {
+    CaptureRecord& rec = capture_[rounded];
+    rec.count++;
+    rec.live++;
+    rec.peak_live = std::max(rec.peak_live, rec.live);
+    capture_ptrs_[ptr] = rounded;
+    if (++capture_allocs_ >= warmup_allocs_) {
+      BuildPlan();
+    }
+  }
+  return ptr;
+}
+
+void GpuPlannedAllocator::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) return;
+  if (plan_ready_.load(std::memory_order_acquire)) {
+    auto it = planned_ptrs_.find(ptr);
+    if (it != planned_ptrs_.end()) {
+      SizeBin* bin = it->second;
+      mutex_lock l(bin->mu);
+      bin->free_buffers.push_back(ptr);
+      return;
+    }
+  } else {
+    mutex_lock l(capture_mu_);
+    auto it = capture_ptrs_.find(ptr);
+    if (it != capture_ptrs_.end()) {
+      auto rec_it = capture_.find(it->second);
+      if (rec_it != capture_.end()) {
+        rec_it->second.live--;
+      }
+      capture_ptrs_.erase(it);
+    }
+  }
+  base_->DeallocateRaw(ptr);
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,115 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_PLANNED_ALLOCATOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_PLANNED_ALLOCATOR_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// Wraps a device allocator (normally the GPU BFC allocator) with a
+// capture-then-plan policy for graphs that run the same step repeatedly.
+//
+// During a warmup window covering the first TF_GPU_MEM_PLAN_WARMUP_ALLOCS
+// allocations (default 8192), requests pass through to the wrapped allocator
+// while the planner records, per rounded size, how many buffers of that size
+// were simultaneously live. When the window closes it carves that working
+// set out of the wrapped allocator once -- up to TF_GPU_MEM_PLAN_MAX_BYTES
+// (default 1GiB) -- into per-size freelists. Subsequent allocations of a
+// planned size pop a buffer under a per-size mutex, bypassing the wrapped
+// allocator's global lock and bin search entirely; sizes outside the plan,
+// or bursts beyond the captured peak, fall through to the wrapped allocator.
+//
+// Enabled per device via
+// GPUOptions.experimental.use_warmup_memory_plan (see GPUProcessState).
+class GpuPlannedAllocator : public Allocator {
+ public:
+  // Takes ownership of `base`, matching GPUDebugAllocator.
+  GpuPlannedAllocator(Allocator* base, const string& name);
+  ~GpuPlannedAllocator() override;
+
+  string Name() override { return name_; }
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void DeallocateRaw(void* ptr) override;
+
+  absl::optional<AllocatorStats> GetStats() override {
+    return base_->GetStats();
+  }
+  bool ClearStats() override { return base_->ClearStats(); }
+
+  AllocatorMemoryType GetMemoryType() const override {
+    return base_->GetMemoryType();
+  }
+
+ private:
+  // Sizes are rounded to this granularity before being keyed, matching the
+  // BFC allocator's minimum allocation size.
+  static constexpr size_t kRoundBytes = 256;
+  static size_t RoundSize(size_t num_bytes) {
+    return (num_bytes + kRoundBytes - 1) & ~(kRoundBytes - 1);
+  }
+
+  struct CaptureRecord {
+    int64_t live = 0;       // Currently live buffers of this size.
+    int64_t peak_live = 0;  // Peak simultaneously live buffers.
+    int64_t count = 0;      // Total allocations of this size.
+  };
+
+  struct SizeBin {
+    mutex mu;
+    std::vector<void*> free_buffers TF_GUARDED_BY(mu);
+  };
+
+  // Builds the static plan from the captured distribution. Called once,
+  // under capture_mu_, when the warmup window closes.
+  void BuildPlan() TF_EXCLUSIVE_LOCKS_REQUIRED(capture_mu_);
+
+  Allocator* const base_;  // Owned.
+  const string name_;
+  const int64_t warmup_allocs_;
+  const int64_t max_plan_bytes_;
+
+  // Flipped exactly once when the plan is in place; read on the fast path.
+  std::atomic<bool> plan_ready_{false};
+
+  mutex capture_mu_;
+  int64_t capture_allocs_ TF_GUARDED_BY(capture_mu_) = 0;
+  absl::flat_hash_map<size_t, CaptureRecord> capture_ TF_GUARDED_BY(capture_mu_);
+  // Live pass-through pointers and their rounded sizes, so frees during
+  // capture can update the live counts.
+  absl::flat_hash_map<const void*, size_t> capture_ptrs_
+      TF_GUARDED_BY(capture_mu_);
+
+  // Written only in BuildPlan, read-only afterwards; the maps themselves
+  // never change once plan_ready_ is true, so lookups are lock-free.
+  absl::flat_hash_map<size_t, std::unique_ptr<SizeBin>> plan_;
+  absl::flat_hash_map<const void*, SizeBin*> planned_ptrs_;
+
+  GpuPlannedAllocator(const GpuPlannedAllocator&) = delete;
+  void operator=(const GpuPlannedAllocator&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_PLANNED_ALLOCATOR_H_
@@ -42,6 +42,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/gpu/gpu_cudamalloc_allocator.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_debug_allocator.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_id_manager.h"
+#include "tensorflow/core/common_runtime/gpu/gpu_planned_allocator.h"
 #include "tensorflow/core/common_runtime/pool_allocator.h"
 #include "tensorflow/core/common_runtime/shared_counter.h"
 #include "tensorflow/core/framework/log_memory.h"
@@ -211,6 +212,14 @@ Allocator* GPUProcessState::GetGPUAllocator(
 #endif
     }
 
+    if (options.experimental().use_warmup_memory_plan() &&
+        gpu_bfc_allocator != nullptr) {
+      LOG(INFO) << "Using warmup memory plan for GPU: " << platform_device_id;
+      gpu_allocator = new GpuPlannedAllocator(
+          gpu_allocator,
+          strings::StrCat("GPU_", tf_device_id.value(), "_planned"));
+    }
+
     Allocator* recording_allocator = nullptr;
     if (process_state_->ProcessState::FLAGS_brain_gpu_record_mem_types) {
       ProcessState::MemDesc md;
@@ -362,12 +371,27 @@ Allocator* GPUProcessState::GetGpuHostAllocator(const GPUOptions& options,
         se, numa_node, gpu_host_alloc_visitors_[numa_node],
         gpu_host_free_visitors_[numa_node]);
 
-    tsl::BFCAllocator::Options allocator_opts;
-    allocator_opts.allow_growth =
-        !options.experimental().gpu_host_mem_disallow_growth();
-    tsl::Allocator* allocator =
-        new tsl::BFCAllocator(absl::WrapUnique(sub_allocator), mem_limit_bytes,
-                              /*name=*/"gpu_host_bfc", allocator_opts);
+    tsl::Allocator* allocator = nullptr;
+    if (options.experimental().use_pooled_gpu_host_allocator()) {
+      // Size-classed staging pool: pinned buffers are recycled across steps
+      // instead of being returned to the driver, so repeated feeds stop
+      // paying for host-memory registration. Power-of-2 rounding gives the
+      // size classes; auto_resize raises the pool limits until evictions
+      // (and hence driver frees) become rare.
+      allocator =
+          new PoolAllocator(/*pool_size_limit=*/100, /*auto_resize=*/true,
+                            sub_allocator, new Pow2Rounder, "gpu_host_pool");
+      VLOG(2) << "Using PoolAllocator for gpu host memory, numa_node="
+              << numa_node;
+    } else {
+      tsl::BFCAllocator::Options allocator_opts;
+      allocator_opts.allow_growth =
+          !options.experimental().gpu_host_mem_disallow_growth();
+      allocator = new tsl::BFCAllocator(absl::WrapUnique(sub_allocator),
+                                        mem_limit_bytes,
+                                        /*name=*/"gpu_host_bfc",
+                                        allocator_opts);
+    }
 
     if (LogMemory::IsEnabled() && !allocator->TracksAllocationSizes()) {
       // Wrap the allocator to track allocation ids for better logging
@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <utility>
 
@@ -42,6 +43,61 @@ ABSL_CONST_INIT int64_t (*NowNs)() = +[]() -> int64_t {
 
 using DeviceStates = GpuServingDeviceSelector::DeviceStates;
 
+namespace {
+
+// Predicted time until `device_state` drains all work already routed to it.
+// Mirrors ServingDeviceSelector::EstimateTimeTillIdleNs, except that a
+// program whose model has no recorded execution time yet counts as
+// kDefaultEstimateNs instead of zero, so untrained models still contribute
+// their queue position to the prediction.
+int64_t PredictedCompletionTimeNs(
+    const tsl::ServingDeviceSelector::DeviceState& device_state,
+    int64_t now_ns) {
+  int64_t ns_till_idle = 0;
+  for (const auto& queue : device_state.enqueued_programs) {
+    for (const auto& info : queue) {
+      ns_till_idle +=
+          std::max(info.execution_info->MaybeGetValidTime(
+                       info.prefetch_results),
+                   kDefaultEstimateNs);
+    }
+  }
+  // Account for the elapsed time of the currently running program.
+  if (ns_till_idle > 0) {
+    ns_till_idle = std::max<int64_t>(
+        0, ns_till_idle - (now_ns - device_state.last_started_ns));
+  }
+  for (const auto& queue : device_state.scheduled_programs) {
+    for (const auto& info : queue) {
+      ns_till_idle +=
+          std::max(info.execution_info->MaybeGetValidTime(
+                       info.prefetch_results),
+                   kDefaultEstimateNs);
+    }
+  }
+  return ns_till_idle;
+}
+
+}  // namespace
+
+int EarliestCompletionPolicy::SelectDevice(
+    absl::string_view program_fingerprint,
+    const tsl::ServingDeviceSelector::DeviceStates& device_states) {
+  const int num_devices = device_states.states.size();
+  const int64_t now_ns = NowNs();
+  int selected = 0;
+  int64_t min_completion_ns = std::numeric_limits<int64_t>::max();
+  for (int i = 0; i < num_devices; ++i) {
+    const int64_t completion_ns =
+        PredictedCompletionTimeNs(device_states.states[i], now_ns);
+    if (completion_ns < min_completion_ns) {
+      min_completion_ns = completion_ns;
+      selected = i;
+    }
+  }
+  return selected;
+}
+
 GpuServingDeviceSelector::GpuServingDeviceSelector(
     const int num_devices,
     std::unique_ptr<ServingDeviceSelector::Policy> device_selector_policy)
@@ -64,6 +120,9 @@ tsl::DeviceReservation GpuServingDeviceSelector::ReserveDevice(
       program_fingerprint, /*priority=*/0, req_id_counter_++,
       /*priority_queue_count=*/1, /*prefetch_results=*/0, NowNs());
 
+  GpuSchedulingMetricsStorage::GetGlobalStorage().TotalGpuLoadNs().Set(
+      TotalEstimatedTimeTillIdleNs());
+
   return tsl::DeviceReservation(device_index, this);
 }
 
@@ -88,6 +88,20 @@ class GpuServingDeviceSelector : public tsl::ServingDeviceSelector {
   std::optional<int64_t> min_exec_time_ ABSL_GUARDED_BY(mu_);
 };
 
+// Policy that routes each request to the device with the earliest predicted
+// completion time: the sum of per-model execution-time estimates of all work
+// outstanding on the device, minus the elapsed time of the currently running
+// program. A model without a recorded execution time yet counts as a minimal
+// non-zero estimate, so selection among untrained models degrades to
+// shortest-queue. Prefer this over RoundRobinPolicy for multi-GPU single-host
+// serving with heterogeneous models.
+class EarliestCompletionPolicy : public tsl::ServingDeviceSelector::Policy {
+ public:
+  int SelectDevice(
+      absl::string_view program_fingerprint,
+      const tsl::ServingDeviceSelector::DeviceStates& device_states) override;
+};
+
 }  // namespace gpu
 }  // namespace tensorflow
 
@@ -135,6 +135,46 @@ TEST(GpuServingDeviceSelector, DefaultPolicyOnlyEnqueueCall) {
       0e6);
 }
 
+TEST(GpuServingDeviceSelector, EarliestCompletionPolicy) {
+  ServingDeviceSelectorTestHelper helper;
+  GpuServingDeviceSelector selector(
+      /*num_devices=*/2, std::make_unique<EarliestCompletionPolicy>());
+
+  // Train the execution-time estimates: two back-to-back runs of each model
+  // so the second completion records the per-model time.
+  selector.Enqueue(0, "fast");
+  selector.Enqueue(0, "fast");
+  helper.ElapseNs(1e6);
+  selector.Completed(0, false);
+  helper.ElapseNs(1e6);
+  selector.Completed(0, false);
+  selector.Enqueue(1, "slow");
+  selector.Enqueue(1, "slow");
+  helper.ElapseNs(4e6);
+  selector.Completed(1, false);
+  helper.ElapseNs(4e6);
+  selector.Completed(1, false);
+
+  // Both devices are idle; ties go to the lowest index.
+  tsl::DeviceReservation r0 = selector.ReserveDevice("slow");
+  EXPECT_EQ(r0.device_index(), 0);
+
+  // Device 0 now holds 4ms of predicted work, so "fast" requests route to
+  // device 1 until its predicted completion catches up — even though its
+  // queue is longer than device 0's.
+  tsl::DeviceReservation r1 = selector.ReserveDevice("fast");
+  EXPECT_EQ(r1.device_index(), 1);
+  tsl::DeviceReservation r2 = selector.ReserveDevice("fast");
+  EXPECT_EQ(r2.device_index(), 1);
+  tsl::DeviceReservation r3 = selector.ReserveDevice("fast");
+  EXPECT_EQ(r3.device_index(), 1);
+
+  // Reservations count as outstanding work in the exported load metric.
+  EXPECT_EQ(
+      GpuSchedulingMetricsStorage::GetGlobalStorage().TotalGpuLoadNs().Get(),
+      7e6);
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace tensorflow
@@ -126,6 +126,44 @@ TEST(PoolAllocatorTest, AutoResize) {
   EXPECT_EQ(100, pool.size_limit());
 }
 
+TEST(PoolAllocatorTest, AdaptiveClassLimits) {
+  PoolAllocator pool(8 /*pool_size_limit*/, true /*auto_resize*/,
+                     new BasicCPUAllocator(0 /*numa_node*/, {}, {}),
+                     new NoopRounder, "pool");
+
+  // Drive a bimodal distribution: three small requests for every large one,
+  // long enough for several decay intervals to elapse.
+  for (int i = 0; i < 4096; ++i) {
+    void* small = pool.AllocateRaw(4, 256);
+    pool.DeallocateRaw(small);
+    if (i % 3 == 0) {
+      void* large = pool.AllocateRaw(4, 1 << 20);
+      pool.DeallocateRaw(large);
+    }
+  }
+
+  // Exactly two size classes saw traffic, and the per-class limits should
+  // apportion the pool by each class's share of demand, with the minority
+  // class still guaranteed at least one pooled buffer.
+  int nonzero_classes = 0;
+  size_t small_class_limit = 0;
+  size_t large_class_limit = 0;
+  for (int c = 0; c < 64; ++c) {
+    const size_t limit = pool.size_class_limit(c);
+    if (limit > 0) {
+      ++nonzero_classes;
+      if (small_class_limit == 0) {
+        small_class_limit = limit;
+      } else {
+        large_class_limit = limit;
+      }
+    }
+  }
+  EXPECT_EQ(2, nonzero_classes);
+  EXPECT_GT(small_class_limit, large_class_limit);
+  EXPECT_GE(large_class_limit, 1);
+}
+
 TEST(PoolAllocatorTest, CudaHostAllocator) {
   int alloc_count = 0;
   int64_t alloc_size = 0;
@@ -53,6 +53,7 @@ limitations under the License.
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/public/version.h"
 
 namespace tensorflow {
@@ -1185,6 +1186,14 @@ Status GraphConstructor::Convert() {
         g_->AddFunctionLibrary(*std::move(library), library_traces));
   }
 
+  // Pre-allocate node and edge storage for everything we are about to
+  // import, so conversion of large graphs is not allocation-bound.
+  int num_inputs = 0;
+  for (int n = 0; n < node_def_count(); ++n) {
+    num_inputs += get_node_def(n).input_size();
+  }
+  g_->Reserve(node_def_count(), num_inputs);
+
   std::vector<InputInfo> inputs;
   int processed = 0;
 
@@ -1533,6 +1542,27 @@ Status ConvertGraphDefToGraph(const GraphConstructorOptions& opts,
                                      /*missing_unused_input_map_keys=*/nullptr);
 }
 
+Status ConvertSerializedGraphDefToGraph(const GraphConstructorOptions& opts,
+                                        absl::string_view serialized,
+                                        Graph* g) {
+  // Parse into an arena so the (potentially millions of) NodeDef and
+  // AttrValue submessages of a large GraphDef do not each pay for a heap
+  // allocation.  The proto is only needed while the Graph is built, so the
+  // whole arena is released on return.
+  protobuf::Arena arena;
+  GraphDef* gdef = protobuf::Arena::Create<GraphDef>(&arena);
+  if (!gdef->ParseFromArray(serialized.data(), serialized.size())) {
+    return errors::InvalidArgument(
+        "Could not parse the provided bytes as a GraphDef");
+  }
+  ShapeRefiner refiner(gdef->versions().producer(), g->op_registry());
+  return GraphConstructor::Construct(
+      opts, gdef->node(), &gdef->versions(), &gdef->library(),
+      &gdef->debug_info(), g, &refiner, /*return_tensors=*/nullptr,
+      /*return_nodes=*/nullptr,
+      /*missing_unused_input_map_keys=*/nullptr);
+}
+
 Status ConvertNodeDefsToGraph(const GraphConstructorOptions& opts,
                               absl::Span<const NodeDef> nodes, Graph* g,
                               const GraphDebugInfo* debug_info) {
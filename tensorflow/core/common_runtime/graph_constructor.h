@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GRAPH_CONSTRUCTOR_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_GRAPH_CONSTRUCTOR_H_
 
+#include "absl/strings/string_view.h"
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/tensor_id.h"
@@ -58,6 +59,15 @@ extern Status ConvertGraphDefToGraph(const GraphConstructorOptions& opts,
 extern Status ConvertGraphDefToGraph(const GraphConstructorOptions& opts,
                                      GraphDef&& gdef, Graph* g);
 
+// Same as ConvertGraphDefToGraph, but parses the GraphDef directly from its
+// wire-format bytes into a protobuf arena.  For very large graphs this avoids
+// one heap allocation per NodeDef/AttrValue during parsing, which otherwise
+// dominates model load time.  The arena (and the parsed proto) is discarded
+// before returning; only the constructed Graph survives.
+extern Status ConvertSerializedGraphDefToGraph(
+    const GraphConstructorOptions& opts, absl::string_view serialized,
+    Graph* g);
+
 // Same as ConvertGraphDefToGraph, but takes just nodes.  Used by function
 // instantiation.
 // TODO(irving): This will turn into std::vector<NodeInfoPtr> soon.
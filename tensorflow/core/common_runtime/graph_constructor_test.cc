@@ -916,6 +916,32 @@ TEST_F(GraphConstructorTest, SimpleModelWithControlEdges) {
   EXPECT_TRUE(HasControlEdge("t1", "t2"));
 }
 
+TEST_F(GraphConstructorTest, ConvertSerializedGraphDefToGraph) {
+  GraphDef gdef;
+  ASSERT_TRUE(protobuf::TextFormat::ParseFromString(
+      "node { name: 'W1' op: 'TestParams' }"
+      "node { name: 'input' op: 'TestInput' }"
+      "node { name: 't1' op: 'TestMul' input: [ 'W1', 'input:1' ] }",
+      &gdef));
+  GraphConstructorOptions opts;
+  TF_EXPECT_OK(ConvertSerializedGraphDefToGraph(opts, gdef.SerializeAsString(),
+                                                &graph_));
+  EXPECT_TRUE(HasNode("W1"));
+  EXPECT_TRUE(HasNode("input"));
+  EXPECT_TRUE(HasNode("t1"));
+  EXPECT_TRUE(HasEdge("W1", 0, "t1", 0));
+  EXPECT_TRUE(HasEdge("input", 1, "t1", 1));
+}
+
+TEST_F(GraphConstructorTest, ConvertSerializedGraphDefToGraph_ParseError) {
+  GraphConstructorOptions opts;
+  Status s = ConvertSerializedGraphDefToGraph(opts, "not a graphdef", &graph_);
+  EXPECT_FALSE(s.ok());
+  EXPECT_TRUE(absl::StrContains(
+      s.message(), "Could not parse the provided bytes as a GraphDef"))
+      << s;
+}
+
 TEST_F(GraphConstructorTest, Error_ControlEdgeBeforeRealInput) {
   ExpectError(
       "node { name: 'W1' op: 'TestParams' }"
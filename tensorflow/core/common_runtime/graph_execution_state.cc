@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/graph_execution_state.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
@@ -49,10 +50,16 @@ limitations under the License.
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/gtl/flatset.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/public/version.h"
 #include "tensorflow/core/util/device_name_utils.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/util.h"
 
 #ifndef IS_MOBILE_PLATFORM
@@ -649,6 +656,51 @@ Status GraphExecutionState::InitBaseGraph(std::unique_ptr<Graph>&& new_graph) {
   return absl::OkStatus();
 }
 
+namespace {
+
+// Returns the directory of the on-disk optimized-graph cache, or the empty
+// string if the cache is disabled.  Deployments that reload identical models
+// many times can point this at a directory next to the model to skip the
+// MetaOptimizer on repeat loads.
+string OptimizedGraphCacheDir() {
+  string dir;
+  Status s = ReadStringFromEnvVar("TF_GRAPH_OPTIMIZATION_CACHE_DIR",
+                                  /*default_val=*/"", &dir);
+  if (!s.ok()) return "";
+  return dir;
+}
+
+// Computes the cache file path for an optimization request.  The key covers
+// the graph content, the feeds and fetches (which affect pruning), the
+// TensorFlow version, and the set of devices, so a cached graph is only
+// reused by an equivalent binary on identical hardware.
+string OptimizedGraphCachePath(const string& cache_dir,
+                               const grappler::GrapplerItem& item,
+                               const DeviceSet& device_set) {
+  uint64 fp = Fingerprint64(item.graph.SerializeAsString());
+  for (const string& fetch : item.fetch) {
+    fp = FingerprintCat64(fp, Fingerprint64(fetch));
+  }
+  for (const auto& feed : item.feed) {
+    fp = FingerprintCat64(fp, Fingerprint64(feed.first));
+  }
+  fp = FingerprintCat64(fp, Fingerprint64(TF_VERSION_STRING));
+  std::vector<string> device_names;
+  device_names.reserve(device_set.devices().size());
+  for (const Device* d : device_set.devices()) {
+    device_names.push_back(d->name());
+  }
+  std::sort(device_names.begin(), device_names.end());
+  for (const string& name : device_names) {
+    fp = FingerprintCat64(fp, Fingerprint64(name));
+  }
+  return io::JoinPath(
+      cache_dir, strings::StrCat("optimized_graph_",
+                                 strings::Hex(fp, strings::kZeroPad16), ".pb"));
+}
+
+}  // namespace
+
 Status GraphExecutionState::OptimizeGraph(
     const BuildGraphOptions& options, const Graph& graph,
     const FunctionLibraryDefinition* flib_def,
@@ -812,11 +864,32 @@ Status GraphExecutionState::OptimizeGraph(
       }
     }
 
-    // Now we can run the MetaOptimizer on the constructed GrapplerItem.
+    // Now we can run the MetaOptimizer on the constructed GrapplerItem.  If
+    // an on-disk cache directory is configured and already holds an optimized
+    // graph for this exact key, reuse it and skip the optimizer entirely.
     GraphDef new_graph;
-    TF_RETURN_IF_ERROR(
-        grappler::RunMetaOptimizer(std::move(item), session_options_->config,
-                                   cpu_device, &cluster, &new_graph));
+    string cache_path;
+    const string cache_dir = OptimizedGraphCacheDir();
+    if (!cache_dir.empty()) {
+      cache_path = OptimizedGraphCachePath(cache_dir, item, *device_set_);
+    }
+    if (!cache_path.empty() &&
+        ReadBinaryProto(Env::Default(), cache_path, &new_graph).ok()) {
+      VLOG(1) << "Reusing cached optimized graph: " << cache_path;
+    } else {
+      TF_RETURN_IF_ERROR(
+          grappler::RunMetaOptimizer(std::move(item), session_options_->config,
+                                     cpu_device, &cluster, &new_graph));
+      if (!cache_path.empty()) {
+        // A failed write only costs a re-optimization on the next load.
+        Status write_status =
+            WriteBinaryProto(Env::Default(), cache_path, new_graph);
+        if (!write_status.ok()) {
+          LOG(WARNING) << "Failed to write optimized graph cache entry "
+                       << cache_path << ": " << write_status;
+        }
+      }
+    }
 
     // Merge optimized graph function library with an original library.
     // Optimized graph might have new functions specialized for it's
@@ -856,6 +929,47 @@ Status GraphExecutionState::OptimizeGraph(
 #endif  // IS_MOBILE_PLATFORM
 }
 
+namespace {
+
+// Returns a deep copy of `other`, suitable for handing to a caller that takes
+// ownership of the ClientGraph.
+std::unique_ptr<ClientGraph> CopyClientGraph(const ClientGraph& other) {
+  auto copy = std::make_unique<ClientGraph>(
+      std::make_unique<FunctionLibraryDefinition>(*other.flib_def),
+      other.feed_types, other.fetch_types, other.collective_graph_key);
+  CopyGraph(other.graph, &copy->graph);
+  return copy;
+}
+
+}  // namespace
+
+std::unique_ptr<ClientGraph> GraphExecutionState::LookupClientGraphCache(
+    const string& key) {
+  mutex_lock l(client_graph_cache_mu_);
+  auto it = client_graph_cache_.find(key);
+  if (it == client_graph_cache_.end()) return nullptr;
+  client_graph_cache_lru_.erase(it->second.lru_position);
+  client_graph_cache_lru_.push_front(key);
+  it->second.lru_position = client_graph_cache_lru_.begin();
+  return CopyClientGraph(*it->second.prototype);
+}
+
+void GraphExecutionState::InsertClientGraphCache(
+    const string& key, const ClientGraph& client_graph, int64_t max_entries) {
+  mutex_lock l(client_graph_cache_mu_);
+  if (client_graph_cache_.contains(key)) return;
+  while (!client_graph_cache_lru_.empty() &&
+         client_graph_cache_.size() >= static_cast<size_t>(max_entries)) {
+    client_graph_cache_.erase(client_graph_cache_lru_.back());
+    client_graph_cache_lru_.pop_back();
+  }
+  client_graph_cache_lru_.push_front(key);
+  ClientGraphCacheEntry entry;
+  entry.prototype = CopyClientGraph(client_graph);
+  entry.lru_position = client_graph_cache_lru_.begin();
+  client_graph_cache_.emplace(key, std::move(entry));
+}
+
 Status GraphExecutionState::BuildGraph(const BuildGraphOptions& options,
                                        std::unique_ptr<ClientGraph>* out) {
   VLOG(1) << "BuildGraph";
@@ -867,6 +981,22 @@ Status GraphExecutionState::BuildGraph(const BuildGraphOptions& options,
         "Attempted to prune a graph that has not been fully initialized.");
   }
 
+  const int64_t cache_max_entries =
+      session_options_ != nullptr
+          ? session_options_->config.experimental()
+                .client_graph_cache_max_entries()
+          : 0;
+  string cache_key;
+  if (cache_max_entries > 0) {
+    cache_key = options.DebugString();
+    std::unique_ptr<ClientGraph> cached = LookupClientGraphCache(cache_key);
+    if (cached != nullptr) {
+      VLOG(1) << "BuildGraph: reusing cached client graph";
+      *out = std::move(cached);
+      return absl::OkStatus();
+    }
+  }
+
   // Grappler optimization might change the structure of a graph itself, and
   // also it can add/prune functions to/from the library.
   std::unique_ptr<Graph> optimized_graph;
@@ -973,6 +1103,11 @@ Status GraphExecutionState::BuildGraph(const BuildGraphOptions& options,
 
   // TODO(vrv): We should check invariants of the graph here.
   metrics::UpdateGraphBuildTime(Env::Default()->NowMicros() - start_time_usecs);
+
+  if (cache_max_entries > 0) {
+    InsertClientGraphCache(cache_key, *dense_copy, cache_max_entries);
+  }
+
   *out = std::move(dense_copy);
   return absl::OkStatus();
 }
@@ -17,10 +17,12 @@ limitations under the License.
 #define TENSORFLOW_CORE_COMMON_RUNTIME_GRAPH_EXECUTION_STATE_H_
 
 #include <functional>
+#include <list>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/common_runtime/build_graph_options.h"
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/common_runtime/device_set.h"
@@ -30,6 +32,8 @@ limitations under the License.
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/platform/types.h"
 
 namespace tensorflow {
@@ -198,6 +202,16 @@ class GraphExecutionState {
   Status PruneGraph(const BuildGraphOptions& options, Graph* graph,
                     subgraph::RewriteGraphMetadata* out_rewrite_metadata);
 
+  // Returns a fresh copy of the cached ClientGraph for `key`, or nullptr on a
+  // cache miss. The entry is moved to the front of the LRU list on a hit.
+  std::unique_ptr<ClientGraph> LookupClientGraphCache(const string& key);
+
+  // Inserts a prototype copy of `client_graph` under `key`, evicting
+  // least-recently-used entries to stay within `max_entries`.
+  void InsertClientGraphCache(const string& key,
+                              const ClientGraph& client_graph,
+                              int64_t max_entries);
+
   // The GraphExecutionState must store a copy of the original GraphDef if
   // either of the following conditions holds:
   //
@@ -228,6 +242,21 @@ class GraphExecutionState {
   // Whether to run Placer.
   bool run_placer_;
 
+  // An LRU cache of pruned+placed ClientGraphs previously built by
+  // `BuildGraph()`, keyed by the BuildGraphOptions signature. Entries are
+  // prototypes: a cache hit returns a fresh copy, since callers take
+  // ownership of (and may mutate) the returned ClientGraph. Only populated
+  // when `config.experimental().client_graph_cache_max_entries() > 0`.
+  struct ClientGraphCacheEntry {
+    std::unique_ptr<ClientGraph> prototype;
+    std::list<string>::iterator lru_position;
+  };
+  mutable mutex client_graph_cache_mu_;
+  std::list<string> client_graph_cache_lru_
+      TF_GUARDED_BY(client_graph_cache_mu_);
+  absl::flat_hash_map<string, ClientGraphCacheEntry> client_graph_cache_
+      TF_GUARDED_BY(client_graph_cache_mu_);
+
   GraphExecutionState(const GraphExecutionState&) = delete;
   void operator=(const GraphExecutionState&) = delete;
 };
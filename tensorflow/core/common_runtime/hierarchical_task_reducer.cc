@@ -0,0 +1,373 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/hierarchical_task_reducer.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/collective_rma_local.h"
+#include "tensorflow/core/common_runtime/collective_util.h"
+#include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/framework/device_base.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/notification.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
+
+namespace tensorflow {
+
+namespace {
+// Key to be used for BufRendezvous by HierarchicalTaskReducer.  The prefix
+// distinguishes the intra-task reduce, inter-task tree, and intra-task
+// broadcast phases of the algorithm.
+string ReduceBufKey(const string& exec_key, const string& key_prefix,
+                    int src_rank, int dst_rank) {
+  return strings::StrCat(exec_key, ":", key_prefix, ":", src_rank, ":",
+                         dst_rank);
+}
+}  // namespace
+
+HierarchicalTaskReducer::HierarchicalTaskReducer()
+    : col_ctx_(nullptr), col_params_(nullptr), done_(nullptr) {}
+
+Status HierarchicalTaskReducer::InitializeCollectiveParams(
+    CollectiveParams* col_params) {
+  CHECK_EQ(col_params->instance.type, REDUCTION_COLLECTIVE);
+  CHECK_EQ(col_params->instance.impl_details.collective_name,
+           "HierarchicalTaskReduce");
+  // Members must be sorted so that all devices in the same task are
+  // adjacent; CompleteDefaultRanking establishes this.
+  const string* prior_task_name = &col_params->group.members[0].task;
+  int num_tasks = 1;
+  for (int di = 1; di < col_params->group.group_size; ++di) {
+    if (col_params->group.members[di].task != *prior_task_name) {
+      ++num_tasks;
+      prior_task_name = &col_params->group.members[di].task;
+    }
+  }
+  if (num_tasks != col_params->group.num_tasks) {
+    return errors::Internal(
+        "HierarchicalTaskReduce requires devices of the same task to be "
+        "adjacent in the group ordering, found ", num_tasks,
+        " task spans for ", col_params->group.num_tasks, " tasks");
+  }
+  return absl::OkStatus();
+}
+
+Status HierarchicalTaskReducer::InitializeCollectiveContext(
+    std::shared_ptr<CollectiveContext> col_ctx) {
+  CHECK(col_ctx->dev_mgr);
+  col_ctx_ = col_ctx;
+  col_params_ = col_ctx->col_params.get();
+  return collective_util::InitializeDeviceAndLocality(
+      col_ctx->dev_mgr, col_ctx->device_name, &col_ctx->device,
+      &col_ctx->device_locality);
+}
+
+void HierarchicalTaskReducer::Run(StatusCallback done) {
+  CHECK(col_ctx_);
+  CHECK(col_params_);
+  done_ = std::move(done);
+
+  // Count devices per task and the group rank at which each task begins.
+  dev_per_task_.clear();
+  task_lo_.clear();
+  const string* prior_task_name = &col_params_->group.members[0].task;
+  int dev_count = 1;
+  task_lo_.push_back(0);
+  for (int di = 1; di < col_params_->group.group_size; ++di) {
+    if (col_params_->group.members[di].task != *prior_task_name) {
+      dev_per_task_.push_back(dev_count);
+      task_lo_.push_back(di);
+      dev_count = 1;
+      prior_task_name = &col_params_->group.members[di].task;
+    } else {
+      ++dev_count;
+    }
+  }
+  dev_per_task_.push_back(dev_count);
+
+  RunReduction();
+
+  VLOG(2) << "device=" << col_ctx_->device_name << " return status "
+          << status_;
+  done_(status_);
+}
+
+// Executes the hierarchical reduction on behalf of a single device.
+// Phase 1: every non-leader device sends its input to the leader (first
+// device) of its task, which accumulates the partials into its output.
+// Phase 2: task leaders reduce over a binary tree rooted at task 0; the
+// root applies final_op and the result is broadcast back down the tree.
+// Phase 3: each leader forwards the result to its task-local peers.
+// Every phase is blocking; like the other CPU-side collectives this runs
+// in a blockable thread.
+void HierarchicalTaskReducer::RunReduction() {
+  const int me = col_params_->default_rank;
+  const int num_tasks = static_cast<int>(dev_per_task_.size());
+  int my_task = num_tasks - 1;
+  for (int ti = 0; ti < num_tasks; ++ti) {
+    if (me < task_lo_[ti] + dev_per_task_[ti]) {
+      my_task = ti;
+      break;
+    }
+  }
+  const int leader = task_lo_[my_task];
+  VLOG(1) << "HierarchicalTaskReducer::RunReduction device="
+          << col_ctx_->device_name << " rank=" << me << " task=" << my_task
+          << " leader=" << leader;
+
+  if (me != leader) {
+    // Contribute the local partial, then wait for the reduced result.
+    SendBlocking("red", leader, col_ctx_->input);
+    if (status_.ok()) {
+      RecvBlocking("bcast", leader, col_ctx_->output);
+    }
+    return;
+  }
+
+  // Leader: start by copying input to output if we're not already computing
+  // in place on the input tensor.
+  if ((col_ctx_->input != col_ctx_->output) &&
+      (DMAHelper::base(col_ctx_->input) != DMAHelper::base(col_ctx_->output))) {
+    Notification note;
+    tsl::profiler::TraceMe activity("MemCpyAsync",
+                                    tsl::profiler::TraceMeLevel::kInfo);
+    CollectiveRemoteAccessLocal::MemCpyAsync(
+        col_ctx_->op_ctx->op_device_context(),
+        col_ctx_->op_ctx->op_device_context(), col_ctx_->device,
+        col_ctx_->device, col_ctx_->op_ctx->input_alloc_attr(0),
+        col_ctx_->op_ctx->output_alloc_attr(0), col_ctx_->input,
+        col_ctx_->output, 0 /*dev_to_dev_stream_index*/,
+        [this, &note](const Status& s) {
+          status_.Update(s);
+          note.Notify();
+        });
+    note.WaitForNotification();
+    if (!status_.ok()) return;
+  }
+
+  Tensor tmp(col_ctx_->device->GetAllocator(
+                 col_ctx_->op_ctx->output_alloc_attr(0)),
+             col_ctx_->output->dtype(), col_ctx_->output->shape());
+
+  // Phase 1: accumulate the partials of the task-local peers.
+  {
+    tsl::profiler::TraceMe activity("IntraTaskReduce",
+                                    tsl::profiler::TraceMeLevel::kInfo);
+    for (int di = 1; di < dev_per_task_[my_task] && status_.ok(); ++di) {
+      RecvAndReduceBlocking("red", leader + di, &tmp);
+    }
+  }
+  if (!status_.ok()) return;
+
+  // Phase 2: reduce up the binary tree of task leaders, then receive the
+  // result back down.  The parent of task t is (t - 1) / 2 and its children
+  // are 2t + 1 and 2t + 2.
+  {
+    tsl::profiler::TraceMe activity("InterTaskReduce",
+                                    tsl::profiler::TraceMeLevel::kInfo);
+    for (int child = 2 * my_task + 1;
+         child <= 2 * my_task + 2 && child < num_tasks && status_.ok();
+         ++child) {
+      RecvAndReduceBlocking("up", task_lo_[child], &tmp);
+    }
+    if (!status_.ok()) return;
+    if (my_task == 0) {
+      Finalize();
+    } else {
+      const int parent = task_lo_[(my_task - 1) / 2];
+      SendBlocking("up", parent, col_ctx_->output);
+      if (status_.ok()) {
+        RecvBlocking("down", parent, col_ctx_->output);
+      }
+    }
+  }
+  if (!status_.ok()) return;
+
+  // Phase 3: forward the result to the child leaders and to the task-local
+  // peers, in parallel.
+  {
+    tsl::profiler::TraceMe activity("ForwardResult",
+                                    tsl::profiler::TraceMeLevel::kInfo);
+    mutex mu;  // also guards status_ while callbacks are pending
+    int pending_count = 0;
+    condition_variable all_done;
+    auto send_complete = [this, &mu, &pending_count,
+                          &all_done](const Status& s) {
+      mutex_lock l(mu);
+      status_.Update(s);
+      --pending_count;
+      if (pending_count == 0) all_done.notify_all();
+    };
+    for (int child = 2 * my_task + 1;
+         child <= 2 * my_task + 2 && child < num_tasks; ++child) {
+      {
+        mutex_lock l(mu);
+        ++pending_count;
+      }
+      DispatchSend("down", me, task_lo_[child], col_ctx_->output,
+                   send_complete);
+    }
+    for (int di = 1; di < dev_per_task_[my_task]; ++di) {
+      {
+        mutex_lock l(mu);
+        ++pending_count;
+      }
+      DispatchSend("bcast", me, leader + di, col_ctx_->output, send_complete);
+    }
+    {
+      mutex_lock l(mu);
+      if (pending_count > 0) all_done.wait(l);
+    }
+  }
+}
+
+void HierarchicalTaskReducer::SendBlocking(const string& key_prefix,
+                                           int dst_rank,
+                                           const Tensor* src_tensor) {
+  Notification note;
+  DispatchSend(key_prefix, col_params_->default_rank, dst_rank, src_tensor,
+               [this, &note](const Status& s) {
+                 status_.Update(s);
+                 note.Notify();
+               });
+  note.WaitForNotification();
+}
+
+void HierarchicalTaskReducer::RecvBlocking(const string& key_prefix,
+                                           int src_rank, Tensor* dst_tensor) {
+  Notification note;
+  DispatchRecv(key_prefix, src_rank, col_params_->default_rank, dst_tensor,
+               [this, &note](const Status& s) {
+                 status_.Update(s);
+                 note.Notify();
+               });
+  note.WaitForNotification();
+}
+
+void HierarchicalTaskReducer::RecvAndReduceBlocking(const string& key_prefix,
+                                                    int src_rank,
+                                                    Tensor* tmp) {
+  RecvBlocking(key_prefix, src_rank, tmp);
+  if (!status_.ok()) return;
+  status_.Update(collective_util::ComputeBinOp(
+      col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+      col_params_->merge_op, col_ctx_->output, tmp));
+}
+
+void HierarchicalTaskReducer::Finalize() {
+  if (col_params_->final_op == nullptr || !status_.ok()) return;
+  // Create an on-device scalar value from the group size.
+  Tensor group_size_val;
+  switch (col_ctx_->output->dtype()) {
+    case DT_HALF:
+      group_size_val =
+          Tensor(static_cast<Eigen::half>(col_params_->group.group_size));
+      break;
+    case DT_FLOAT:
+      group_size_val =
+          Tensor(static_cast<float>(col_params_->group.group_size));
+      break;
+    case DT_DOUBLE:
+      group_size_val =
+          Tensor(static_cast<double>(col_params_->group.group_size));
+      break;
+    case DT_INT32:
+      group_size_val =
+          Tensor(static_cast<int32>(col_params_->group.group_size));
+      break;
+    case DT_INT64:
+      group_size_val =
+          Tensor(static_cast<int64_t>(col_params_->group.group_size));
+      break;
+    default:
+      status_ = errors::Internal("Unsupported type ",
+                                 DataTypeString(col_ctx_->output->dtype()));
+      return;
+  }
+  Tensor group_size;
+  if (col_params_->group.device_type != "CPU") {
+    group_size = Tensor(
+        col_ctx_->device->GetAllocator(col_ctx_->op_ctx->input_alloc_attr(0)),
+        col_ctx_->output->dtype(), TensorShape({}));
+    Notification note;
+    col_ctx_->op_ctx->op_device_context()->CopyCPUTensorToDevice(
+        &group_size_val, col_ctx_->device, &group_size,
+        [this, &note](const Status& s) {
+          status_.Update(s);
+          note.Notify();
+        });
+    note.WaitForNotification();
+    if (!status_.ok()) return;
+  } else {
+    group_size = group_size_val;
+  }
+  status_.Update(collective_util::ComputeBinOp(
+      col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+      col_params_->final_op, col_ctx_->output, &group_size));
+}
+
+void HierarchicalTaskReducer::DispatchSend(const string& key_prefix,
+                                           int src_rank, int dst_rank,
+                                           const Tensor* src_tensor,
+                                           const StatusCallback& done) {
+  string send_buf_key =
+      ReduceBufKey(col_ctx_->exec_key, key_prefix, src_rank, dst_rank);
+  VLOG(3) << "DispatchSend " << send_buf_key << " from_device "
+          << col_ctx_->device_name << " to_device "
+          << col_params_->group.members[dst_rank].device.name();
+  col_ctx_->col_exec->remote_access()->PostToPeer(
+      col_params_->group.members[dst_rank].device.name(),
+      col_params_->group.members[dst_rank].task, send_buf_key,
+      col_ctx_->device, col_ctx_->op_ctx->op_device_context(),
+      col_ctx_->op_ctx->output_alloc_attr(0), src_tensor,
+      col_ctx_->device_locality, col_ctx_->op_ctx->cancellation_manager(),
+      done);
+}
+
+void HierarchicalTaskReducer::DispatchRecv(const string& key_prefix,
+                                           int src_rank, int dst_rank,
+                                           Tensor* dst_tensor,
+                                           const StatusCallback& done) {
+  string recv_buf_key =
+      ReduceBufKey(col_ctx_->exec_key, key_prefix, src_rank, dst_rank);
+  VLOG(3) << "DispatchRecv " << recv_buf_key << " from_device "
+          << col_params_->group.members[src_rank].device.name()
+          << " to_device " << col_ctx_->device_name;
+  col_ctx_->col_exec->remote_access()->RecvFromPeer(
+      col_params_->group.members[src_rank].device.name(),
+      col_params_->group.members[src_rank].task,
+      col_params_->group.members[src_rank].is_local, recv_buf_key,
+      col_ctx_->device, col_ctx_->op_ctx->op_device_context(),
+      col_ctx_->op_ctx->output_alloc_attr(0), dst_tensor,
+      col_ctx_->device_locality, 0 /*stream_index*/,
+      col_ctx_->op_ctx->cancellation_manager(), done);
+}
+
+namespace {
+REGISTER_COLLECTIVE(HierarchicalTaskReduce, HierarchicalTaskReducer);
+}  // namespace
+
+}  // namespace tensorflow
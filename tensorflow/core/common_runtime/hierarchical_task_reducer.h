@@ -0,0 +1,91 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_TASK_REDUCER_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_TASK_REDUCER_H_
+
+#include <vector>
+
+#include "tensorflow/core/common_runtime/base_collective_executor.h"
+#include "tensorflow/core/framework/collective.h"
+
+namespace tensorflow {
+
+// Hierarchical implementation of collective reduction for multi-task groups.
+// One leader device per task accumulates the partials of its task-local
+// peers, the leaders reduce among themselves over a binary tree rooted at
+// task 0, and the result is broadcast back down the tree and out to the
+// task-local peers.  Only the leaders exchange data across tasks, so
+// inter-task traffic is independent of the number of devices per task,
+// unlike a flat ring over all devices.
+class HierarchicalTaskReducer : public CollectiveImplementationInterface {
+ public:
+  HierarchicalTaskReducer();
+  ~HierarchicalTaskReducer() override = default;
+
+  // Validates that the group is a multi-device reduction with members
+  // sorted so that all devices of a task are adjacent.
+  Status InitializeCollectiveParams(CollectiveParams* col_params) override;
+
+  // Initializes members of CollectiveContext not yet initialized, i.e. device
+  // and device_locality.  Also saves the CollectiveContext in this object.
+  Status InitializeCollectiveContext(
+      std::shared_ptr<CollectiveContext> col_ctx) override;
+
+  // Begins execution of the hierarchical reduction.
+  // Must be called in a blockable thread.
+  void Run(StatusCallback done) override;
+
+ private:
+  // Sends `src_tensor` asynchronously from this device to the device at
+  // group rank `dst_rank`.  `key_prefix` distinguishes the phases of the
+  // algorithm.  Calls `done` upon completion.
+  void DispatchSend(const string& key_prefix, int src_rank, int dst_rank,
+                    const Tensor* src_tensor, const StatusCallback& done);
+
+  // Receives a tensor into the memory buffer owned by `dst_tensor` at this
+  // device from the device at group rank `src_rank`.  Calls `done` upon
+  // completion.
+  void DispatchRecv(const string& key_prefix, int src_rank, int dst_rank,
+                    Tensor* dst_tensor, const StatusCallback& done);
+
+  // Blocking variants of the above; update status_ on failure.
+  void SendBlocking(const string& key_prefix, int dst_rank,
+                    const Tensor* src_tensor);
+  void RecvBlocking(const string& key_prefix, int src_rank,
+                    Tensor* dst_tensor);
+
+  // Receives a partial into tmp from `src_rank` and accumulates it into the
+  // output with merge_op.
+  void RecvAndReduceBlocking(const string& key_prefix, int src_rank,
+                             Tensor* tmp);
+
+  // Applies final_op (e.g. division by group size) to the output.
+  void Finalize();
+
+  // Executes the three phases of the reduction.
+  void RunReduction();
+
+  std::shared_ptr<CollectiveContext> col_ctx_;
+  const CollectiveParams* col_params_;  // Not owned
+  StatusCallback done_;
+  Status status_;
+  // Number of devices per task, indexed by task, plus the group rank at
+  // which each task's devices begin.  Valid while RunReduction executes.
+  std::vector<int> dev_per_task_;
+  std::vector<int> task_lo_;
+};
+
+}  // namespace tensorflow
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_TASK_REDUCER_H_
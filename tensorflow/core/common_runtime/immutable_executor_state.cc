@@ -24,6 +24,7 @@ limitations under the License.
 #include "tensorflow/core/graph/graph_node_util.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
@@ -31,6 +32,20 @@ namespace {
 bool IsInitializationOp(const Node* node) {
   return node->op_def().allows_uninitialized_input();
 }
+
+// Whether pending-count entries should be padded to one cache line per node.
+// This avoids false sharing between threads concurrently finishing unrelated
+// nodes on many-core hosts, at the cost of a larger count array per
+// iteration.
+bool PendingCountsCacheLineShardingEnabled() {
+  static const bool enabled = [] {
+    bool b = false;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_EXECUTOR_SHARDED_PENDING_COUNTS",
+                                   /*default_val=*/false, &b));
+    return b;
+  }();
+  return enabled;
+}
 }  // namespace
 
 ImmutableExecutorState::~ImmutableExecutorState() {
@@ -88,9 +103,12 @@ Status ImmutableExecutorState::Initialize(const Graph& graph) {
   ControlFlowInfo cf_info;
   TF_RETURN_IF_ERROR(BuildControlFlowInfo(&graph, &cf_info));
 
+  const bool shard_pending_counts = PendingCountsCacheLineShardingEnabled();
   for (auto& it : cf_info.unique_frame_names) {
-    EnsureFrameInfo(it)->nodes =
-        std::make_unique<std::vector<const NodeItem*>>();
+    FrameInfo* frame_info = EnsureFrameInfo(it);
+    frame_info->nodes = std::make_unique<std::vector<const NodeItem*>>();
+    frame_info->pending_counts_layout.set_cache_line_sharding(
+        shard_pending_counts);
   }
   root_frame_info_ = frame_info_[""].get();
 
@@ -259,9 +277,50 @@ Status ImmutableExecutorState::Initialize(const Graph& graph) {
   // Initialize PendingCounts only after pending_ids_[node.id] is initialized
   // for all nodes.
   InitializePending(&graph, cf_info);
+
+  if (!requires_control_flow_) {
+    BuildPropagationPlan();
+  }
+
   return gview_.SetAllocAttrs(&graph, params_.device);
 }
 
+void ImmutableExecutorState::BuildPropagationPlan() {
+  DCHECK(!requires_control_flow_);
+  const int num_nodes = gview_.num_nodes();
+  propagation_plan_offsets_.resize(num_nodes + 1);
+
+  size_t total_entries = 0;
+  for (int id = 0; id < num_nodes; ++id) {
+    propagation_plan_offsets_[id] = total_entries;
+    const NodeItem* item = gview_.node(id);
+    if (item != nullptr) {
+      total_entries += item->num_output_edges + item->num_output_control_edges;
+    }
+  }
+  propagation_plan_offsets_[num_nodes] = total_entries;
+
+  // Flattening the per-node EdgeInfo/ControlEdgeInfo arrays into one
+  // contiguous array lets `SimplePropagatorState::PropagateOutputs()` walk a
+  // single span per node with no per-edge-type dispatch, and improves cache
+  // locality across consecutive node completions.
+  propagation_plan_.reserve(total_entries);
+  for (int id = 0; id < num_nodes; ++id) {
+    const NodeItem* item = gview_.node(id);
+    if (item == nullptr) continue;
+    for (const EdgeInfo& e : item->output_edges()) {
+      propagation_plan_.push_back(PropagationPlanEntry{
+          e.dst_id, e.output_slot, e.input_slot, static_cast<bool>(e.is_last)});
+    }
+    for (const ControlEdgeInfo& e : item->output_control_edges()) {
+      propagation_plan_.push_back(
+          PropagationPlanEntry{e.dst_id, /*src_slot=*/-1, /*input_slot=*/-1,
+                               /*is_last=*/false});
+    }
+  }
+  DCHECK_EQ(propagation_plan_.size(), total_entries);
+}
+
 namespace {
 // If a Node has been marked to use a ScopedAllocator x for output i, then
 // sc_attr will contain the subsequence (i, x) at an even offset.  This function
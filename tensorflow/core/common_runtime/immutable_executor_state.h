@@ -26,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/pending_counts.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/gtl/array_slice.h"
 #include "tensorflow/core/lib/gtl/flatmap.h"
 #include "tensorflow/core/lib/gtl/flatset.h"
 #include "tensorflow/core/platform/macros.h"
@@ -74,6 +75,22 @@ class ImmutableExecutorState {
     int32 parallel_iterations;
   };
 
+  // One entry in the flat propagation plan compiled for control-flow-free
+  // graphs. Each entry describes one output (data or control) edge of a node,
+  // with all frame/iteration bookkeeping resolved at construction time.
+  struct PropagationPlanEntry {
+    // The node ID of the destination in `graph_view()`.
+    int32 dst_id;
+    // The index of the output that produces the value, or -1 for a control
+    // edge (in which case no input slot is written).
+    int32 src_slot;
+    // The flattened input location to write, already offset by the
+    // destination's `input_start`. Unused for control edges.
+    int32 input_slot;
+    // True iff the value may be moved (rather than copied) into `input_slot`.
+    bool is_last;
+  };
+
   explicit ImmutableExecutorState(const LocalExecutorParams& p)
       : params_(p), gview_() {}
   ~ImmutableExecutorState();
@@ -101,6 +118,25 @@ class ImmutableExecutorState {
 
   bool requires_control_flow_support() const { return requires_control_flow_; }
 
+  // Returns true iff a flat propagation plan was compiled for this graph.
+  // Plans are only built when `!requires_control_flow_support()`.
+  bool has_propagation_plan() const {
+    return !propagation_plan_offsets_.empty();
+  }
+
+  // Returns the propagation plan for the given node: the destinations of all
+  // of its output data and control edges as a single flat span, with data
+  // edges preceding control edges. Walking this span is equivalent to (but
+  // cheaper than) walking the node's `EdgeInfo` and `ControlEdgeInfo` arrays.
+  //
+  // REQUIRES: `has_propagation_plan()`.
+  gtl::ArraySlice<PropagationPlanEntry> propagation_plan(int node_id) const {
+    const int32 begin = propagation_plan_offsets_[node_id];
+    const int32 end = propagation_plan_offsets_[node_id + 1];
+    return gtl::ArraySlice<PropagationPlanEntry>(
+        propagation_plan_.data() + begin, end - begin);
+  }
+
   // Copies the pending counts for nodes in this graph to the given array.
   //
   // This method provides a more efficient way of initializing
@@ -126,6 +162,13 @@ class ImmutableExecutorState {
                                      ControlFlowInfo* cf_info);
   void InitializePending(const Graph* graph, const ControlFlowInfo& cf_info);
 
+  // Compiles the flat propagation plan for a control-flow-free graph.
+  //
+  // REQUIRES: `!requires_control_flow_` and `gview_` fully initialized (in
+  // particular, `EdgeInfo::input_slot` members already rewritten to refer to
+  // flattened input locations).
+  void BuildPropagationPlan();
+
   FrameInfo* EnsureFrameInfo(const string& fname);
 
   // Owned.
@@ -152,6 +195,13 @@ class ImmutableExecutorState {
   // pending counts for the nodes in the graph, indexed by node ID.
   std::unique_ptr<std::atomic<int32>[]> atomic_pending_counts_;
 
+  // If `requires_control_flow_` is false, the flat propagation plan for the
+  // graph. The entries for node `i` are stored at
+  // `propagation_plan_[propagation_plan_offsets_[i] ..
+  // propagation_plan_offsets_[i + 1])`.
+  std::vector<PropagationPlanEntry> propagation_plan_;
+  std::vector<int32> propagation_plan_offsets_;
+
   // Shallow copies of the constant tensors used in the graph.
   std::vector<Tensor> const_tensors_;
 
@@ -329,7 +329,8 @@ string InlineFunctionBodyOptions::DebugString() const {
       output_control_src == OutputControlSrc::kDataOutputs ? "DataOutputs"
                                                            : "ControlOutputs",
       ", inlined_function_body_placer=", inlined_function_body_placer.name,
-      ", uniquify_frame_names=", true_false(uniquify_frame_names));
+      ", uniquify_frame_names=", true_false(uniquify_frame_names),
+      ", max_inlined_body_size=", max_inlined_body_size);
 }
 
 Status ValidateInlining(const Node* node, const FunctionBody* fbody,
@@ -378,6 +379,14 @@ Status ValidateInlining(const Node* node, const FunctionBody* fbody,
         "Function inlining explicitly disabled by 'options.disable_inlining'");
   }
 
+  if (options.max_inlined_body_size >= 0 &&
+      fbody->graph->num_op_nodes() > options.max_inlined_body_size) {
+    return errors::InvalidArgument(
+        "Function body has ", fbody->graph->num_op_nodes(),
+        " op nodes, which exceeds 'options.max_inlined_body_size' (",
+        options.max_inlined_body_size, ")");
+  }
+
   if (!options.inline_impl_selection_group_functions) {
     bool is_impl_selection_group_function =
         fbody->record->fdef().attr().find("api_implements") !=
@@ -888,14 +897,36 @@ bool ExpandInlineFunctions(FunctionLibraryRuntime* lib, Graph* graph,
     candidates.emplace_back(node, fbody);
   }
 
+  // With a node budget, inline smallest bodies first so the budget is
+  // spent on the calls whose overhead is largest relative to their size.
+  if (options.inlined_nodes_budget >= 0) {
+    absl::c_stable_sort(candidates,
+                        [](const std::pair<Node*, const FunctionBody*>& a,
+                           const std::pair<Node*, const FunctionBody*>& b) {
+                          return a.second->graph->num_op_nodes() <
+                                 b.second->graph->num_op_nodes();
+                        });
+  }
+
   bool inlined_any = false;
+  int64_t remaining_budget = options.inlined_nodes_budget;
   for (const auto& p : candidates) {
+    const int64_t body_size = p.second->graph->num_op_nodes();
+    if (options.inlined_nodes_budget >= 0 && body_size > remaining_budget) {
+      VLOG(1) << "Skipped function call inlining: node=" << p.first->name()
+              << " body_size=" << body_size
+              << " remaining_budget=" << remaining_budget;
+      continue;
+    }
     Status inlined = InlineFunctionBody(*fld, graph, p.first, p.second,
                                         p.first->IsPartitionedCall()
                                             ? options.multi_device_options
                                             : options.native_options);
     if (inlined.ok()) {
       inlined_any = true;
+      if (options.inlined_nodes_budget >= 0) {
+        remaining_budget -= body_size;
+      }
     } else {
       VLOG(1) << "Failed to inline function call: node=" << p.first->name()
               << " error=" << inlined.message();
@@ -145,6 +145,11 @@ struct InlineFunctionBodyOptions {
   // partitioner generates frame names that must remain unmodified across all
   // partitions of a multi-device function.
   bool uniquify_frame_names = true;
+  // If non-negative, function bodies with more than this many op nodes are
+  // not inlined and the function call is kept. This keeps inlining from
+  // exploding the graph (and with it optimization time and instruction
+  // cache locality) when large functions are called from many sites.
+  int64_t max_inlined_body_size = -1;
 
   // A human-readable debug string for this options.
   string DebugString() const;
@@ -208,6 +213,13 @@ struct ExpandInlineFunctionsOptions {
 
   InlineFunctionBodyOptions native_options;
   InlineFunctionBodyOptions multi_device_options;
+
+  // If non-negative, bounds the total number of function body op nodes that
+  // a single ExpandInlineFunctions pass may add to the graph. Candidates
+  // are inlined smallest body first, so the budget is spent on the calls
+  // whose per-call overhead is largest relative to their size; calls that
+  // do not fit within the remaining budget are left as function calls.
+  int64_t inlined_nodes_budget = -1;
 };
 
 // WARNING(ezhulenev): PLEASE DO NOT USE THIS FUNCTION. This is a temporary
@@ -109,5 +109,65 @@ TEST(InlineFunctionBody, ColocationConstraintPropagation) {
   TF_EXPECT_GRAPH_EQ(expected_gdef, output_gdef);
 }
 
+TEST(InlineFunctionBody, MaxInlinedBodySize) {
+  // A function body exceeding options.max_inlined_body_size must be kept as
+  // a function call, and the graph must be left unmodified.
+
+  FunctionLibraryDefinition flib_def(OpRegistry::Global(),
+                                     FunctionDefLibrary());
+  FunctionDef fdef = FunctionDefHelper::Define(
+      "f",                       // Name
+      {"x: float", "y: float"},  // Args
+      {"z: float"},              // Returns
+      {},                        // Attr def
+      // Nodes
+      {
+          {{"z"}, "AddV2", {"x", "y"}, {{"T", DT_FLOAT}}},
+      });
+  TF_ASSERT_OK(flib_def.AddFunctionDef(fdef));
+
+  auto g = std::make_unique<Graph>(OpRegistry::Global());
+  GraphConstructorOptions opts;
+  const Tensor kZero = test::AsScalar<int64_t>(0);
+  const Tensor kOne = test::AsScalar<int64_t>(1);
+  GraphDef gdef = GDef(
+      {
+          NDef("inp0", "Const", {}, {{"dtype", DT_FLOAT}, {"value", kZero}}),
+          NDef("inp1", "Const", {}, {{"dtype", DT_FLOAT}, {"value", kOne}}),
+          NDef("call", "StatefulPartitionedCall", {"inp0", "inp1"},
+               {{"Tin", DataTypeSlice{DT_FLOAT, DT_FLOAT}},
+                {"Tout", DataTypeSlice{DT_FLOAT}},
+                {"f", FunctionDefHelper::FunctionRef("f", {})}}),
+          NDef("out0", "_Retval", {"call:0"}, {{"T", DT_FLOAT}}),
+      },
+      {});
+  TF_ASSERT_OK(ConvertGraphDefToGraph(opts, gdef, g.get()));
+
+  Node* caller = nullptr;
+  for (Node* node : g->nodes()) {
+    if (node->name() == "call") {
+      caller = node;
+    }
+  }
+
+  std::unique_ptr<FunctionBody> fbody;
+  TF_ASSERT_OK(FunctionDefToBodyHelper(fdef, {}, &flib_def, &fbody));
+
+  // The body has a single op node ("z"): a zero budget rejects it.
+  InlineFunctionBodyOptions inline_options;
+  inline_options.max_inlined_body_size = 0;
+  EXPECT_FALSE(
+      InlineFunctionBody(flib_def, g.get(), caller, fbody.get(), inline_options)
+          .ok());
+  GraphDef unmodified_gdef;
+  g->ToGraphDef(&unmodified_gdef);
+  TF_EXPECT_GRAPH_EQ(gdef, unmodified_gdef);
+
+  // A budget of one op node admits it.
+  inline_options.max_inlined_body_size = 1;
+  TF_EXPECT_OK(InlineFunctionBody(flib_def, g.get(), caller, fbody.get(),
+                                  inline_options));
+}
+
 }  // namespace
 }  // namespace tensorflow
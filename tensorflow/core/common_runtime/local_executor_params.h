@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 
 namespace tensorflow {
+class Allocator;
 class Device;
 class StepStatsCollector;
 class SessionMetadata;
@@ -50,6 +51,11 @@ struct LocalExecutorParams {
 
   // Whether control flow nodes are allowed to be executed synchronously.
   bool allow_control_flow_sync_execution = false;
+
+  // If non-null, kernels run by this executor allocate output and temporary
+  // buffers through this pool instead of the device allocator. Not owned;
+  // must outlive the executor.
+  Allocator* session_buffer_pool = nullptr;
 };
 
 }  // end namespace tensorflow
@@ -0,0 +1,95 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/op_memory_sampler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <tuple>
+
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tracking_allocator.h"
+#include "tensorflow/core/lib/monitoring/counter.h"
+#include "tensorflow/core/lib/monitoring/gauge.h"
+
+namespace tensorflow {
+namespace {
+
+auto* sampled_op_allocated_bytes = monitoring::Counter<1>::New(
+    "/tensorflow/core/memory/sampled_op_allocated_bytes",
+    "Bytes allocated by sampled executions of an op type, scaled by the "
+    "sampling rate.",
+    "op_type");
+
+auto* sampled_op_live_bytes = monitoring::Gauge<int64_t, 1>::New(
+    "/tensorflow/core/memory/sampled_op_live_bytes",
+    "Bytes still allocated when the most recently sampled execution of an op "
+    "type finished.",
+    "op_type");
+
+auto* sampled_op_peak_bytes = monitoring::Gauge<int64_t, 1>::New(
+    "/tensorflow/core/memory/sampled_op_peak_bytes",
+    "High watermark of bytes allocated during the most recently sampled "
+    "execution of an op type.",
+    "op_type");
+
+}  // namespace
+
+OpMemorySampler::OpMemorySampler(int64_t sample_rate)
+    : sample_rate_(sample_rate) {}
+
+/* static */ OpMemorySampler& OpMemorySampler::Global() {
+  static OpMemorySampler* sampler = []() {
+    int64_t sample_rate = 0;
+    const char* rate_str = std::getenv("TF_OP_MEMORY_SAMPLE_RATE");
+    if (rate_str != nullptr) {
+      sample_rate = std::atoll(rate_str);
+    }
+    return new OpMemorySampler(sample_rate);
+  }();
+  return *sampler;
+}
+
+void OpMemorySampler::RecordOpExecution(OpKernelContext* ctx) {
+  int64_t allocated_bytes = 0;
+  int64_t live_bytes = 0;
+  int64_t peak_bytes = 0;
+  for (const auto& wrapped : ctx->ConsumeWrappedAllocators()) {
+    TrackingAllocator* tracking_allocator = wrapped.second;
+    const auto sizes = tracking_allocator->GetSizes();
+    allocated_bytes += static_cast<int64_t>(std::get<0>(sizes));
+    peak_bytes =
+        std::max(peak_bytes, static_cast<int64_t>(std::get<1>(sizes)));
+    live_bytes += static_cast<int64_t>(std::get<2>(sizes));
+    // Release the wrapper; it deletes itself once its remaining allocations
+    // are freed.
+    tracking_allocator->GetRecordsAndUnRef();
+  }
+  // Only export cells for op types that actually allocate.
+  if (allocated_bytes == 0 && live_bytes == 0) return;
+  RecordSample(ctx->op_kernel().type_string(), allocated_bytes, live_bytes,
+               peak_bytes);
+}
+
+void OpMemorySampler::RecordSample(const string& op_type,
+                                   int64_t allocated_bytes, int64_t live_bytes,
+                                   int64_t peak_bytes) {
+  sampled_op_allocated_bytes->GetCell(op_type)->IncrementBy(allocated_bytes *
+                                                            sample_rate_);
+  sampled_op_live_bytes->GetCell(op_type)->Set(live_bytes);
+  sampled_op_peak_bytes->GetCell(op_type)->Set(peak_bytes);
+}
+
+}  // namespace tensorflow
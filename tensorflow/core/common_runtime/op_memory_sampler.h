@@ -0,0 +1,78 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_OP_MEMORY_SAMPLER_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_OP_MEMORY_SAMPLER_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+class OpKernelContext;
+
+// Always-on sampled per-op memory attribution.
+//
+// When enabled (TF_OP_MEMORY_SAMPLE_RATE=N with N > 0), the executor tracks
+// the allocations of one in every N op executions with a TrackingAllocator
+// and exports the result under per-op-type monitoring metrics:
+//
+//   /tensorflow/core/memory/sampled_op_allocated_bytes (counter, scaled by N)
+//   /tensorflow/core/memory/sampled_op_live_bytes (gauge, latest sample)
+//   /tensorflow/core/memory/sampled_op_peak_bytes (gauge, latest sample)
+//
+// This makes it possible to see which op type balloons or leaks memory in
+// production without a profiler session running. Metrics are keyed by op
+// type rather than node name to bound the metric cardinality. A sampled
+// execution pays for one TrackingAllocator wrapper per allocator it touches;
+// unsampled executions only pay one atomic counter increment.
+class OpMemorySampler {
+ public:
+  // Sampler that records one in every `sample_rate` op executions. A rate
+  // <= 0 disables sampling.
+  explicit OpMemorySampler(int64_t sample_rate);
+
+  // Returns the process-wide sampler, configured from the
+  // TF_OP_MEMORY_SAMPLE_RATE environment variable (default: disabled).
+  static OpMemorySampler& Global();
+
+  bool enabled() const { return sample_rate_ > 0; }
+
+  // Returns true if the calling op execution should be sampled.
+  bool ShouldSample() {
+    if (sample_rate_ <= 0) return false;
+    return num_executions_.fetch_add(1, std::memory_order_relaxed) %
+               sample_rate_ ==
+           0;
+  }
+
+  // Consumes the tracking allocators of a sampled op execution and updates
+  // the exported metrics. `ctx->track_allocations()` must be true.
+  void RecordOpExecution(OpKernelContext* ctx);
+
+  // Updates the exported metrics with one sampled execution of `op_type`.
+  void RecordSample(const string& op_type, int64_t allocated_bytes,
+                    int64_t live_bytes, int64_t peak_bytes);
+
+ private:
+  const int64_t sample_rate_;
+  std::atomic<uint64_t> num_executions_{0};
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_OP_MEMORY_SAMPLER_H_
@@ -0,0 +1,66 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/op_memory_sampler.h"
+
+#include <cstdint>
+
+#include "tensorflow/core/lib/monitoring/cell_reader.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+using monitoring::testing::CellReader;
+
+TEST(OpMemorySamplerTest, DisabledNeverSamples) {
+  OpMemorySampler sampler(/*sample_rate=*/0);
+  EXPECT_FALSE(sampler.enabled());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_FALSE(sampler.ShouldSample());
+  }
+}
+
+TEST(OpMemorySamplerTest, SamplesOneInEveryN) {
+  OpMemorySampler sampler(/*sample_rate=*/4);
+  EXPECT_TRUE(sampler.enabled());
+  int num_sampled = 0;
+  for (int i = 0; i < 400; ++i) {
+    if (sampler.ShouldSample()) ++num_sampled;
+  }
+  EXPECT_EQ(num_sampled, 100);
+}
+
+TEST(OpMemorySamplerTest, ExportsScaledMetrics) {
+  CellReader<int64_t> allocated_bytes(
+      "/tensorflow/core/memory/sampled_op_allocated_bytes");
+  CellReader<int64_t> live_bytes(
+      "/tensorflow/core/memory/sampled_op_live_bytes");
+  CellReader<int64_t> peak_bytes(
+      "/tensorflow/core/memory/sampled_op_peak_bytes");
+
+  OpMemorySampler sampler(/*sample_rate=*/8);
+  sampler.RecordSample("TestOp", /*allocated_bytes=*/1000,
+                       /*live_bytes=*/200, /*peak_bytes=*/600);
+
+  // Allocated bytes are scaled by the sampling rate to approximate the
+  // unsampled total; live and peak bytes report the sample as-is.
+  EXPECT_EQ(allocated_bytes.Delta("TestOp"), 8000);
+  EXPECT_EQ(live_bytes.Read("TestOp"), 200);
+  EXPECT_EQ(peak_bytes.Read("TestOp"), 600);
+}
+
+}  // namespace
+}  // namespace tensorflow
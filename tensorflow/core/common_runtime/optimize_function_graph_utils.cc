@@ -18,12 +18,14 @@ limitations under the License.
 #include <cstdlib>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/time/clock.h"
@@ -49,6 +51,8 @@ limitations under the License.
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/graph_node_util.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/util/debug_data_dumper.h"
 #include "tsl/platform/env.h"
@@ -257,6 +261,90 @@ string GetFileCacheName(const string& dir_name, const string& function_name,
                       fdef->node_def_size());
 }
 
+// Maximum number of entries held by the in-process optimization cache.
+// Entries are optimized-graph protos; the cache is cleared when full so its
+// resident size stays modest on hosts with many distinct functions.
+constexpr size_t kInMemoryCacheMaxEntries = 128;
+
+// Process-level cache of graph optimization results, shared by every
+// session/FunctionLibraryRuntime in the process. Entries are stored as
+// `OptimizedFunctionGraph` protos because `OptimizedFunctionGraphInfo` is
+// move-only; a hit is restored with `OptimizedFunctionGraphInfo::FromProto`.
+class OptimizedFunctionGraphCache {
+ public:
+  std::optional<OptimizedFunctionGraph> Lookup(uint64 key) {
+    mutex_lock l(mu_);
+    auto iter = entries_.find(key);
+    if (iter == entries_.end()) return std::nullopt;
+    return iter->second;
+  }
+
+  void Insert(uint64 key, OptimizedFunctionGraph proto) {
+    mutex_lock l(mu_);
+    if (entries_.size() >= kInMemoryCacheMaxEntries) entries_.clear();
+    entries_.insert_or_assign(key, std::move(proto));
+  }
+
+ private:
+  mutex mu_;
+  absl::flat_hash_map<uint64, OptimizedFunctionGraph> entries_
+      TF_GUARDED_BY(mu_);
+};
+
+OptimizedFunctionGraphCache& GlobalOptimizedFunctionGraphCache() {
+  static auto* const cache = new OptimizedFunctionGraphCache;
+  return *cache;
+}
+
+bool InMemoryGraphCachingEnabled() {
+  return !absl::StrCat(getenv(kInMemoryGraphCachingEnvVariableName)).empty();
+}
+
+// Computes the in-process cache key of an instantiation. The canonical key
+// produced by `Canonicalize` identifies the function library by pointer,
+// which is unique per session; instead, hash the reachable function
+// definitions by content so that identical functions instantiated from
+// different sessions share one cache entry.
+uint64 InMemoryCacheKey(
+    const string& function_name, AttrSlice attrs,
+    const FunctionLibraryRuntime::InstantiateOptions& options,
+    const DeviceSet& dev_set, const FunctionDef& fdef,
+    const FunctionLibraryDefinition& lib_def) {
+  FunctionLibraryRuntime::InstantiateOptions canonical_options = options;
+  canonical_options.lib_def = nullptr;
+  uint64 key =
+      Fingerprint64(Canonicalize(function_name, attrs, canonical_options));
+  key = FingerprintCat64(key, FunctionDefHash(fdef));
+  const FunctionLibraryDefinition reachable_lib_def =
+      lib_def.ReachableDefinitions(fdef);
+  std::vector<string> reachable_names = reachable_lib_def.ListFunctionNames();
+  std::sort(reachable_names.begin(), reachable_names.end());
+  for (const string& name : reachable_names) {
+    key = FingerprintCat64(key, Fingerprint64(name));
+    key = FingerprintCat64(key,
+                           FunctionDefHash(*reachable_lib_def.Find(name)));
+  }
+  // Placement (and hence the optimization result) depends on the device set.
+  std::vector<string> device_names;
+  device_names.reserve(dev_set.devices().size());
+  for (const Device* device : dev_set.devices()) {
+    device_names.push_back(device->name());
+  }
+  std::sort(device_names.begin(), device_names.end());
+  for (const string& device_name : device_names) {
+    key = FingerprintCat64(key, Fingerprint64(device_name));
+  }
+  return key;
+}
+
+// Stores `info` in the in-process optimization cache when `key` is set.
+void MaybeInsertIntoInMemoryCache(const std::optional<uint64>& key,
+                                  const OptimizedFunctionGraphInfo& info) {
+  if (!key.has_value()) return;
+  GlobalOptimizedFunctionGraphCache().Insert(
+      *key, OptimizedFunctionGraphInfo::ToProto(info));
+}
+
 // Generates graph and return information given the input function name,
 // attributes and function definition.
 Status GetGraphAndArgRets(const string& function_name, AttrSlice attrs,
@@ -668,16 +756,62 @@ OptimizeFunctionGraphOrReadFromFileCache(
   // Get the caching directory from Env variable.
   const string dir_name = absl::StrCat(getenv(kGraphCachingEnvVariableName));
 
-  // Scenario (1): Not eligible for caching. Run the optimization passes.
+  const FunctionLibraryDefinition* lib_def =
+      options.lib_def == nullptr ? input_lib_def : options.lib_def;
+
+  // The in-process cache is consulted before the file cache. Component
+  // functions are skipped, like in the file cache below, because they are
+  // already instantiated from an optimized graph.
+  std::optional<uint64> memory_cache_key;
+  if (InMemoryGraphCachingEnabled() && !options.is_component_function) {
+    const FunctionDef* fdef_for_key = lib_def->Find(function_name);
+    if (fdef_for_key != nullptr) {
+      memory_cache_key = InMemoryCacheKey(function_name, attrs, options,
+                                          dev_set, *fdef_for_key, *lib_def);
+      std::optional<OptimizedFunctionGraph> cached_proto =
+          GlobalOptimizedFunctionGraphCache().Lookup(*memory_cache_key);
+      if (cached_proto.has_value()) {
+        absl::StatusOr<OptimizedFunctionGraphInfo> restored =
+            OptimizedFunctionGraphInfo::FromProto(*std::move(cached_proto));
+        if (restored.ok()) {
+          metrics::UpdateFunctionGraphOptimizationSavingTime(
+              restored->optimization_duration_usecs,
+              metrics::GraphOptimizationSource::kJit);
+          metrics::IncrementFunctionGraphOptimizationCacheHitCount(
+              1, metrics::GraphOptimizationSource::kJit);
+          VLOG(3) << "Restored the optimized graph of function "
+                  << function_name << " from the in-process cache.";
+          return restored;
+        }
+        // Fall through to the remaining scenarios when restoring fails.
+        metrics::IncrementFunctionGraphOptimizationCacheFailureCount(
+            1, metrics::GraphOptimizationSource::kJit);
+        LOG(ERROR) << "Restoring the optimized graph of function "
+                   << function_name
+                   << " from the in-process cache failed. Continue to run the "
+                      "Tensorflow graph optimization passes instead. Error: "
+                   << restored.status();
+      }
+    }
+  }
+
+  // Scenario (1): Not eligible for file caching. Run the optimization passes.
   if (dir_name.empty() || options.is_component_function) {
-    return OptimizeFunctionGraph(function_name, attrs, options, dev_set,
-                                 input_lib_def, composite_devices, cpu_device,
-                                 default_device, env,
-                                 OptimizedFunctionGraph::JIT);
+    TF_ASSIGN_OR_RETURN(
+        OptimizedFunctionGraphInfo optimized_function_graph_info,
+        OptimizeFunctionGraph(function_name, attrs, options, dev_set,
+                              input_lib_def, composite_devices, cpu_device,
+                              default_device, env,
+                              OptimizedFunctionGraph::JIT));
+    if (memory_cache_key.has_value()) {
+      metrics::IncrementFunctionGraphOptimizationCacheMissCount(
+          1, metrics::GraphOptimizationSource::kJit);
+      MaybeInsertIntoInMemoryCache(memory_cache_key,
+                                   optimized_function_graph_info);
+    }
+    return optimized_function_graph_info;
   }
 
-  const FunctionLibraryDefinition* lib_def =
-      options.lib_def == nullptr ? input_lib_def : options.lib_def;
   const FunctionDef* fdef = lib_def->Find(function_name);
   // If the function definition can't be found, return as error because there's
   // no point running the graph optimization passes as that will fail too.
@@ -709,6 +843,8 @@ OptimizeFunctionGraphOrReadFromFileCache(
           << absl::ToInt64Milliseconds(absl::Microseconds(
                  optimized_function_graph_info->optimization_duration_usecs))
           << " msecs";
+      MaybeInsertIntoInMemoryCache(memory_cache_key,
+                                   *optimized_function_graph_info);
       return optimized_function_graph_info;
     }
 
@@ -719,10 +855,14 @@ OptimizeFunctionGraphOrReadFromFileCache(
         << "Reading from Tensorflow graph optimization cache failed. Continue "
            "to run the Tensorflow graph optimization passes instead. Error: "
         << optimized_function_graph_info.status();
-    return OptimizeFunctionGraph(function_name, attrs, options, dev_set,
-                                 input_lib_def, composite_devices, cpu_device,
-                                 default_device, env,
-                                 OptimizedFunctionGraph::JIT);
+    TF_ASSIGN_OR_RETURN(
+        OptimizedFunctionGraphInfo optimized_info_from_passes,
+        OptimizeFunctionGraph(function_name, attrs, options, dev_set,
+                              input_lib_def, composite_devices, cpu_device,
+                              default_device, env,
+                              OptimizedFunctionGraph::JIT));
+    MaybeInsertIntoInMemoryCache(memory_cache_key, optimized_info_from_passes);
+    return optimized_info_from_passes;
   }
 
   // Scenario (3): No file cache exists for this function.
@@ -768,6 +908,8 @@ OptimizeFunctionGraphOrReadFromFileCache(
               << ") msecs";
   }
 
+  MaybeInsertIntoInMemoryCache(memory_cache_key,
+                               optimized_function_graph_info.value());
   return optimized_function_graph_info;
 }
 
@@ -35,6 +35,14 @@ namespace tensorflow {
 // Note: if the caching location retrieved by the env variable is empty it means
 // no caching would be performed.
 static const char kGraphCachingEnvVariableName[] = "TF_GRAPH_CACHING";
+// The name of the env variable that enables the in-process cache of graph
+// optimization results. Any non-empty value enables it. Unlike the file cache
+// above, entries are shared across all sessions in the process and are keyed
+// by the content of the function (and its reachable library) rather than by
+// the owning session, so hosts running many sessions of the same model
+// optimize each function only once.
+static const char kInMemoryGraphCachingEnvVariableName[] =
+    "TF_INMEMORY_GRAPH_CACHING";
 // The threshold of the graph optimization duration to be cached.
 // Note: setting this threshold to 0 means to cache for every function.
 constexpr absl::Duration kCachingThresholdDuration = absl::Seconds(3);
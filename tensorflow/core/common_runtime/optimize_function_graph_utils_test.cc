@@ -246,5 +246,68 @@ TEST(OptimizeFunctionGraphTest, OptimizeFunctionGraphAndWriteToCache) {
   ASSERT_TRUE(empty_file_list.empty());
 }
 
+TEST(OptimizeFunctionGraphTest, InMemoryCacheIsSharedAcrossLibraries) {
+  // The in-process cache is keyed by function content, so a second library
+  // holding an identical function (as with multiple sessions running the same
+  // model) reuses the optimization result of the first one.
+  unsetenv(kGraphCachingEnvVariableName);
+  setenv(kInMemoryGraphCachingEnvVariableName, "1", 1);
+
+  FunctionLibraryRuntime::InstantiateOptions opts;
+  opts.is_multi_device_function = true;
+  FunctionDefLibrary proto;
+  *(proto.add_function()) = test::function::FindDevice();
+
+  std::vector<std::unique_ptr<Device>> devices;
+  CreateCpuDeviceList(kDevicePrefix, 3, devices);
+  DeviceSet device_set;
+  for (const auto& device : devices) {
+    device_set.AddDevice(device.get());
+  }
+
+  const int64_t hit_count_before =
+      metrics::GetFunctionGraphOptimizationCacheHitCount(
+          metrics::GraphOptimizationSource::kJit);
+  const int64_t miss_count_before =
+      metrics::GetFunctionGraphOptimizationCacheMissCount(
+          metrics::GraphOptimizationSource::kJit);
+
+  // The first instantiation misses and populates the cache.
+  auto lib_def =
+      std::make_unique<FunctionLibraryDefinition>(OpRegistry::Global(), proto);
+  absl::StatusOr<OptimizedFunctionGraphInfo> optimized_info =
+      OptimizeFunctionGraphOrReadFromFileCache(
+          "FindDevice", {}, opts, device_set, lib_def.get(),
+          /*composite_devices=*/{}, devices[0].get(), devices[1].get(),
+          Env::Default(), /*caching_threshold_duration=*/absl::ZeroDuration());
+  TF_ASSERT_OK(optimized_info.status());
+  EXPECT_EQ(metrics::GetFunctionGraphOptimizationCacheMissCount(
+                metrics::GraphOptimizationSource::kJit),
+            miss_count_before + 1);
+  EXPECT_EQ(metrics::GetFunctionGraphOptimizationCacheHitCount(
+                metrics::GraphOptimizationSource::kJit),
+            hit_count_before);
+
+  // A fresh library holding the same function definition hits the cache.
+  auto second_lib_def =
+      std::make_unique<FunctionLibraryDefinition>(OpRegistry::Global(), proto);
+  optimized_info = OptimizeFunctionGraphOrReadFromFileCache(
+      "FindDevice", {}, opts, device_set, second_lib_def.get(),
+      /*composite_devices=*/{}, devices[0].get(), devices[1].get(),
+      Env::Default(), /*caching_threshold_duration=*/absl::ZeroDuration());
+  TF_ASSERT_OK(optimized_info.status());
+  EXPECT_EQ(metrics::GetFunctionGraphOptimizationCacheMissCount(
+                metrics::GraphOptimizationSource::kJit),
+            miss_count_before + 1);
+  EXPECT_EQ(metrics::GetFunctionGraphOptimizationCacheHitCount(
+                metrics::GraphOptimizationSource::kJit),
+            hit_count_before + 1);
+  EXPECT_EQ(optimized_info->name, "FindDevice");
+  EXPECT_EQ(optimized_info->num_return_nodes, 1);
+  EXPECT_THAT(optimized_info->ret_types, ElementsAre(DT_STRING));
+
+  unsetenv(kInMemoryGraphCachingEnvVariableName);
+}
+
 }  // namespace
 }  // namespace tensorflow
@@ -73,9 +73,23 @@ class PendingCounts {
    public:
     Handle CreateHandle(size_t max_pending_count, size_t max_dead_count);
 
+    // If enabled, every handle created afterwards starts on its own cache
+    // line. By default adjacent handles share cache lines (up to 64 packed
+    // counts per line), which causes false sharing between threads that
+    // concurrently decrement counts for unrelated nodes on many-core hosts.
+    // Sharding trades ~64x memory for the count array (one byte becomes one
+    // cache line per node) for contention-free updates.
+    void set_cache_line_sharding(bool enable) {
+      cache_line_sharding_ = enable;
+    }
+
    private:
     friend class PendingCounts;
+
+    static constexpr int kCacheLineBytes = 64;
+
     int next_offset_ = 0;  // Next byte offset to allocate
+    bool cache_line_sharding_ = false;
   };
 
   // Create a new PendingCounts object that can hold the state of
@@ -547,6 +561,14 @@ class PendingCounts {
 inline PendingCounts::Handle PendingCounts::Layout::CreateHandle(
     size_t max_pending_count, size_t max_dead_count) {
   Handle result;
+  if (cache_line_sharding_) {
+    // Round the offset up so that this handle's count lives on its own cache
+    // line. The padding bytes are never addressed by any other handle.
+    next_offset_ =
+        ((static_cast<int64_t>(next_offset_) + kCacheLineBytes - 1) /
+         kCacheLineBytes) *
+        kCacheLineBytes;
+  }
   if ((max_pending_count > kMaxCountForPackedCounts) ||
       (max_dead_count > kMaxCountForPackedCounts)) {
     constexpr int B = sizeof(std::atomic<LargeCounts>);
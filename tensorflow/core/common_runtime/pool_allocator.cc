@@ -22,9 +22,11 @@ limitations under the License.
 #include <sys/mman.h>  // for munmap
 #endif
 
+#include <algorithm>
 #include <map>
 #include <utility>
 
+#include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mem.h"
@@ -35,6 +37,27 @@ limitations under the License.
 
 namespace tensorflow {
 
+namespace {
+
+auto* pool_get_from_pool = monitoring::Counter<1>::New(
+    "/tensorflow/core/pool_allocator/get_from_pool",
+    "Number of PoolAllocator requests satisfied from the pool.", "pool_name");
+auto* pool_allocated = monitoring::Counter<1>::New(
+    "/tensorflow/core/pool_allocator/allocated",
+    "Number of PoolAllocator requests requiring a fresh allocation.",
+    "pool_name");
+auto* pool_evicted = monitoring::Counter<1>::New(
+    "/tensorflow/core/pool_allocator/evicted",
+    "Number of buffers evicted from a PoolAllocator pool.", "pool_name");
+
+// The decayed request histogram halves every kDecayInterval requests, so the
+// per-class limits track the recent allocation distribution rather than the
+// all-time one.
+constexpr int64_t kDecayInterval = 1024;
+constexpr double kDecayFactor = 0.5;
+
+}  // namespace
+
 PoolAllocator::PoolAllocator(size_t pool_size_limit, bool auto_resize,
                              SubAllocator* allocator,
                              RoundUpInterface* size_rounder, string name)
@@ -109,6 +132,9 @@ void* PoolAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
   if (has_size_limit_) {
     {
       mutex_lock lock(mutex_);
+      if (auto_resize_) {
+        RecordRequest(num_bytes);
+      }
       auto iter = pool_.find(num_bytes);
       if (iter == pool_.end()) {
         allocated_count_++;
@@ -120,15 +146,20 @@ void* PoolAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
         pr = iter->second;
         RemoveFromList(pr);
         pool_.erase(iter);
+        class_count_[SizeClass(pr->num_bytes)]--;
         // Fall out of lock scope and do the result without the lock held.
       }
     }
   }
   if (pr != nullptr) {
+    pool_get_from_pool->GetCell(name_)->IncrementBy(1);
     void* r = pr->ptr;
     delete pr;
     return PrepareChunk(r, alignment, num_bytes);
   } else {
+    if (has_size_limit_) {
+      pool_allocated->GetCell(name_)->IncrementBy(1);
+    }
     size_t bytes_received;
     void* ptr = allocator_->Alloc(kPoolAlignment, num_bytes, &bytes_received);
     return PrepareChunk(ptr, alignment, bytes_received);
@@ -152,6 +183,7 @@ void PoolAllocator::DeallocateRaw(void* ptr) {
     pr->ptr = cp;
     AddToList(pr);
     pool_.insert(std::make_pair(cp->num_bytes, pr));
+    class_count_[SizeClass(cp->num_bytes)]++;
   }
 }
 
@@ -170,6 +202,42 @@ void PoolAllocator::Clear() {
     evicted_count_ = 0;
     lru_head_ = nullptr;
     lru_tail_ = nullptr;
+    for (int c = 0; c < kNumSizeClasses; ++c) {
+      class_ema_[c] = 0;
+      class_limit_[c] = 0;
+      class_count_[c] = 0;
+    }
+    requests_since_decay_ = 0;
+  }
+}
+
+int PoolAllocator::SizeClass(size_t num_bytes) {
+  return std::min(kNumSizeClasses - 1,
+                  static_cast<int>(Log2Ceiling64(num_bytes)));
+}
+
+void PoolAllocator::RecordRequest(size_t num_bytes) {
+  class_ema_[SizeClass(num_bytes)] += 1.0;
+  if (++requests_since_decay_ >= kDecayInterval) {
+    requests_since_decay_ = 0;
+    for (double& v : class_ema_) {
+      v *= kDecayFactor;
+    }
+    RecomputeClassLimits();
+  }
+}
+
+void PoolAllocator::RecomputeClassLimits() {
+  double total = 0.0;
+  for (double v : class_ema_) total += v;
+  if (total <= 0.0) return;
+  for (int c = 0; c < kNumSizeClasses; ++c) {
+    class_limit_[c] =
+        static_cast<size_t>(pool_size_limit_ * (class_ema_[c] / total) + 0.5);
+    // Any class with recent activity deserves at least one pooled buffer.
+    if (class_ema_[c] > 0.0 && class_limit_[c] == 0) {
+      class_limit_[c] = 1;
+    }
   }
 }
 
@@ -207,6 +275,22 @@ void PoolAllocator::AddToList(PtrRecord* pr) {
 void PoolAllocator::EvictOne() {
   DCHECK(lru_tail_ != nullptr);
   PtrRecord* prec = lru_tail_;
+  if (auto_resize_) {
+    // Prefer evicting from a size class holding more buffers than its share
+    // of recent demand, so that a burst of one size cannot flush the other
+    // mode of a bimodal distribution out of the pool. The scan from the LRU
+    // tail is bounded to keep eviction cost constant.
+    static const int kMaxEvictScan = 16;
+    PtrRecord* cand = lru_tail_;
+    for (int i = 0; i < kMaxEvictScan && cand != nullptr;
+         ++i, cand = cand->prev) {
+      const int c = SizeClass(cand->num_bytes);
+      if (class_count_[c] > class_limit_[c]) {
+        prec = cand;
+        break;
+      }
+    }
+  }
   RemoveFromList(prec);
   auto iter = pool_.find(prec->num_bytes);
   while (iter->second != prec) {
@@ -214,9 +298,11 @@ void PoolAllocator::EvictOne() {
     DCHECK(iter != pool_.end());
   }
   pool_.erase(iter);
+  class_count_[SizeClass(prec->num_bytes)]--;
   allocator_->Free(prec->ptr, prec->num_bytes);
   delete prec;
   ++evicted_count_;
+  pool_evicted->GetCell(name_)->IncrementBy(1);
   // Auto-resizing, and warning messages.
   static const double kTolerable = 2e-3;
   static const int kCheckInterval = 1000;
@@ -249,6 +335,7 @@ void PoolAllocator::EvictOne() {
                   << " to " << new_size_limit;
       }
       pool_size_limit_ = new_size_limit;
+      RecomputeClassLimits();
       // Reset all the counters so that ratios are relative to new sizes
       // at next test interval.
       put_count_ = 0;
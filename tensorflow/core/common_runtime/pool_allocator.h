@@ -100,6 +100,14 @@ class PoolAllocator : public Allocator {
     return pool_size_limit_;
   }
 
+  // Current limit on pooled buffers of the given power-of-2 size class,
+  // maintained by the adaptive policy when auto_resize is true.
+  size_t size_class_limit(int size_class) const TF_NO_THREAD_SAFETY_ANALYSIS {
+    DCHECK_GE(size_class, 0);
+    DCHECK_LT(size_class, kNumSizeClasses);
+    return class_limit_[size_class];
+  }
+
   AllocatorMemoryType GetMemoryType() const override {
     return allocator_->GetMemoryType();
   }
@@ -121,6 +129,17 @@ class PoolAllocator : public Allocator {
   // Delete the least recently used record.
   void EvictOne() TF_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Adaptive sizing, active when auto_resize_ is true: requests feed a
+  // decayed per-size-class histogram, which periodically sets per-class
+  // pool limits proportional to each class's share of recent demand.
+  // Eviction prefers classes holding more than their limit, so a burst of
+  // one size in a bimodal distribution cannot flush the other mode out of
+  // the pool.
+  static constexpr int kNumSizeClasses = 64;  // log2 of the rounded size
+  static int SizeClass(size_t num_bytes);
+  void RecordRequest(size_t num_bytes) TF_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void RecomputeClassLimits() TF_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   const string name_;
   const bool has_size_limit_;
   const bool auto_resize_;
@@ -135,6 +154,10 @@ class PoolAllocator : public Allocator {
   int64_t put_count_ TF_GUARDED_BY(mutex_) = 0;
   int64_t allocated_count_ TF_GUARDED_BY(mutex_) = 0;
   int64_t evicted_count_ TF_GUARDED_BY(mutex_) = 0;
+  double class_ema_[kNumSizeClasses] TF_GUARDED_BY(mutex_) = {};
+  size_t class_limit_[kNumSizeClasses] TF_GUARDED_BY(mutex_) = {};
+  size_t class_count_[kNumSizeClasses] TF_GUARDED_BY(mutex_) = {};
+  int64_t requests_since_decay_ TF_GUARDED_BY(mutex_) = 0;
 };
 
 // Do-nothing rounder. Passes through sizes unchanged.
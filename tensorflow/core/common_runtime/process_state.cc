@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/process_state.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstring>
 #include <vector>
@@ -28,11 +29,105 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/numa.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
+namespace {
+
+// Dispatches each allocation to the per-NUMA-node CPU arena of the node the
+// calling thread is currently running on. Deallocations are routed back to
+// the owning arena through a sharded pointer map, since one BFC/pool arena
+// cannot free a chunk carved out by another.
+class NUMALocalAllocator : public Allocator {
+ public:
+  explicit NUMALocalAllocator(ProcessState* process_state)
+      : process_state_(process_state) {}
+
+  string Name() override { return "numa_local_cpu"; }
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override {
+    Allocator* a =
+        process_state_->GetCPUAllocator(port::NUMAGetThreadNodeAffinity());
+    void* p = a->AllocateRaw(alignment, num_bytes);
+    if (p != nullptr) {
+      Shard& shard = ShardFor(p);
+      mutex_lock l(shard.mu);
+      shard.owner[p] = a;
+    }
+    return p;
+  }
+
+  void DeallocateRaw(void* p) override {
+    if (p == nullptr) return;
+    Allocator* a = nullptr;
+    {
+      Shard& shard = ShardFor(p);
+      mutex_lock l(shard.mu);
+      auto it = shard.owner.find(p);
+      CHECK(it != shard.owner.end())  // Crash OK
+          << "Deallocating pointer not allocated by NUMALocalAllocator";
+      a = it->second;
+      shard.owner.erase(it);
+    }
+    a->DeallocateRaw(p);
+  }
+
+  // Aggregates the stats of all node arenas. Per-node breakdowns remain
+  // available from each arena's own GetStats().
+  absl::optional<AllocatorStats> GetStats() override {
+    AllocatorStats merged;
+    bool any = false;
+    for (int node = 0; node < port::NUMANumNodes(); ++node) {
+      auto stats = process_state_->GetCPUAllocator(node)->GetStats();
+      if (!stats) continue;
+      any = true;
+      merged.num_allocs += stats->num_allocs;
+      merged.bytes_in_use += stats->bytes_in_use;
+      merged.peak_bytes_in_use += stats->peak_bytes_in_use;
+      merged.largest_alloc_size =
+          std::max(merged.largest_alloc_size, stats->largest_alloc_size);
+      if (stats->bytes_limit) {
+        merged.bytes_limit =
+            merged.bytes_limit.value_or(0) + *stats->bytes_limit;
+      }
+    }
+    if (!any) return absl::nullopt;
+    return merged;
+  }
+
+  bool ClearStats() override {
+    bool cleared = true;
+    for (int node = 0; node < port::NUMANumNodes(); ++node) {
+      cleared = process_state_->GetCPUAllocator(node)->ClearStats() && cleared;
+    }
+    return cleared;
+  }
+
+  AllocatorMemoryType GetMemoryType() const override {
+    return AllocatorMemoryType::kHostPageable;
+  }
+
+ private:
+  static constexpr int kNumShards = 16;
+  struct Shard {
+    mutex mu;
+    std::unordered_map<const void*, Allocator*> owner TF_GUARDED_BY(mu);
+  };
+
+  Shard& ShardFor(const void* p) {
+    // Drop the low alignment bits before sharding.
+    return shards_[(reinterpret_cast<uintptr_t>(p) >> 6) % kNumShards];
+  }
+
+  ProcessState* process_state_;  // Not owned.
+  Shard shards_[kNumShards];
+};
+
+}  // namespace
+
 /*static*/ ProcessState* ProcessState::singleton() {
   static ProcessState* instance = new ProcessState;
   static absl::once_flag f;
@@ -103,9 +198,14 @@ Allocator* ProcessState::GetCPUAllocator(int numa_node) {
 
       BFCAllocator::Options allocator_opts;
       allocator_opts.allow_growth = true;
-      allocator = new BFCAllocator(
-          absl::WrapUnique(sub_allocator), cpu_mem_limit,
-          /*name=*/"bfc_cpu_allocator_for_gpu", allocator_opts);
+      // Give NUMA-bound arenas distinct names so per-node stats can be told
+      // apart in memory logs and profiles.
+      string name = numa_enabled_
+                        ? strings::StrCat("bfc_cpu_allocator_numa_",
+                                          cpu_allocators_.size())
+                        : string("bfc_cpu_allocator_for_gpu");
+      allocator = new BFCAllocator(absl::WrapUnique(sub_allocator),
+                                   cpu_mem_limit, name, allocator_opts);
 
       VLOG(2) << "Using BFCAllocator with memory limit of "
               << cpu_mem_limit_in_mb << " MB for ProcessState CPU allocator";
@@ -138,6 +238,22 @@ Allocator* ProcessState::GetCPUAllocator(int numa_node) {
   return cpu_allocators_[numa_node];
 }
 
+Allocator* ProcessState::GetNUMALocalCPUAllocator() {
+  if (!numa_enabled_ || port::NUMANumNodes() < 2) {
+    return GetCPUAllocator(port::kNUMANoAffinity);
+  }
+  // Create all node arenas eagerly (GetCPUAllocator takes mu_, so this must
+  // happen before the lock below).
+  for (int node = 0; node < port::NUMANumNodes(); ++node) {
+    GetCPUAllocator(node);
+  }
+  mutex_lock lock(mu_);
+  if (numa_local_allocator_ == nullptr) {
+    numa_local_allocator_ = new NUMALocalAllocator(this);
+  }
+  return numa_local_allocator_;
+}
+
 void ProcessState::AddCPUAllocVisitor(SubAllocator::Visitor visitor) {
   VLOG(1) << "AddCPUAllocVisitor";
   mutex_lock lock(mu_);
@@ -164,6 +280,8 @@ void ProcessState::TestOnlyReset() {
     if (a != default_cpu_allocator) delete a;
   }
   cpu_allocators_.clear();
+  delete numa_local_allocator_;
+  numa_local_allocator_ = nullptr;
   for (Allocator* a : cpu_al_) {
     delete a;
   }
@@ -66,6 +66,14 @@ class ProcessState : public ProcessStateInterface {
   // Treats numa_node == kNUMANoAffinity as numa_node == 0.
   Allocator* GetCPUAllocator(int numa_node) override;
 
+  // Returns an Allocator that dispatches each allocation to the arena of the
+  // NUMA node the calling thread is currently running on, so threads pinned
+  // to a socket receive socket-local memory. Falls back to
+  // GetCPUAllocator(0) when NUMA is not enabled or the host has a single
+  // node. REQUIRES: EnableNUMA() must have been called first for NUMA-bound
+  // arenas to be created.
+  Allocator* GetNUMALocalCPUAllocator();
+
   // Registers alloc visitor for the CPU allocator(s).
   // REQUIRES: must be called before GetCPUAllocator.
   void AddCPUAllocVisitor(SubAllocator::Visitor v);
@@ -109,6 +117,9 @@ class ProcessState : public ProcessStateInterface {
   std::atomic<int> cpu_allocators_cached_;
   std::array<Allocator*, 8> cpu_allocators_cache_;
 
+  // Lazily created by GetNUMALocalCPUAllocator().
+  Allocator* numa_local_allocator_ TF_GUARDED_BY(mu_) = nullptr;
+
   // Optional RecordingAllocators that wrap the corresponding
   // Allocators for runtime attribute use analysis.
   MDMap mem_desc_map_;
@@ -0,0 +1,45 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/request_cost_context.h"
+
+namespace tensorflow {
+namespace {
+
+thread_local RequestCost* current_request_cost = nullptr;
+
+}  // namespace
+
+ScopedRequestCostContext::ScopedRequestCostContext(RequestCost* request_cost)
+    : previous_(current_request_cost) {
+  current_request_cost = request_cost;
+}
+
+ScopedRequestCostContext::~ScopedRequestCostContext() {
+  current_request_cost = previous_;
+}
+
+/* static */ RequestCost* ScopedRequestCostContext::GetCurrent() {
+  return current_request_cost;
+}
+
+RequestCost* RequestCostContextAccessor::GetRequestCost() const {
+  return ScopedRequestCostContext::GetCurrent();
+}
+
+REGISTER_REQUEST_COST_ACCESSOR("request_cost_context",
+                               RequestCostContextAccessor);
+
+}  // namespace tensorflow
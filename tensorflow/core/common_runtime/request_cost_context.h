@@ -0,0 +1,75 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_REQUEST_COST_CONTEXT_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_REQUEST_COST_CONTEXT_H_
+
+#include "tensorflow/core/common_runtime/request_cost.h"
+#include "tensorflow/core/common_runtime/request_cost_accessor_registry.h"
+
+namespace tensorflow {
+
+// A thread-local token that associates the work running on the current thread
+// with the RequestCost of the originating rpc request, so costs can be
+// attributed to a request even after it crosses component boundaries (e.g.
+// batching, executor, device callbacks) where a RequestCost* cannot be
+// threaded through explicitly.
+//
+// An rpc handler installs the token at the top of request processing:
+//
+//   ScopedRequestCostContext context(&request_cost);
+//
+// Components that resume per-request work on other threads re-install it
+// around the resumed work (e.g. around a task's done callback). Code in scope
+// records costs via ScopedRequestCostContext::GetCurrent() or, without a
+// direct dependency, via the "request_cost_context" RequestCostAccessor
+// (TF_REQUEST_COST_ACCESSOR_TYPE=request_cost_context).
+//
+// Scopes nest: the destructor restores the previously installed token.
+class ScopedRequestCostContext {
+ public:
+  // Associates the current thread with `request_cost` until destruction.
+  // `request_cost` may be nullptr (e.g. a task without a cost collector), in
+  // which case the scope clears the association. Must be destroyed on the
+  // thread it was created on, in reverse order of creation.
+  explicit ScopedRequestCostContext(RequestCost* request_cost);
+
+  // Restores the token that was installed when this scope was created.
+  ~ScopedRequestCostContext();
+
+  ScopedRequestCostContext(const ScopedRequestCostContext&) = delete;
+  ScopedRequestCostContext& operator=(const ScopedRequestCostContext&) =
+      delete;
+
+  // Returns the RequestCost of the request the current thread is working on,
+  // or nullptr if no token is installed.
+  static RequestCost* GetCurrent();
+
+ private:
+  RequestCost* previous_;
+};
+
+// RequestCostAccessor that reads the thread-local token installed by
+// ScopedRequestCostContext. Registered as "request_cost_context".
+class RequestCostContextAccessor : public RequestCostAccessor {
+ public:
+  // Returns the RequestCost of the request the current thread is working on,
+  // or nullptr if no token is installed.
+  RequestCost* GetRequestCost() const override;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_REQUEST_COST_CONTEXT_H_
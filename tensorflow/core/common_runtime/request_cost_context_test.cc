@@ -0,0 +1,66 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/request_cost_context.h"
+
+#include <memory>
+
+#include "tensorflow/core/common_runtime/request_cost.h"
+#include "tensorflow/core/common_runtime/request_cost_accessor_registry.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(ScopedRequestCostContextTest, InstallsAndRestoresToken) {
+  EXPECT_EQ(ScopedRequestCostContext::GetCurrent(), nullptr);
+  RequestCost request_cost;
+  {
+    ScopedRequestCostContext context(&request_cost);
+    EXPECT_EQ(ScopedRequestCostContext::GetCurrent(), &request_cost);
+  }
+  EXPECT_EQ(ScopedRequestCostContext::GetCurrent(), nullptr);
+}
+
+TEST(ScopedRequestCostContextTest, ScopesNest) {
+  RequestCost outer_cost;
+  RequestCost inner_cost;
+  ScopedRequestCostContext outer(&outer_cost);
+  {
+    ScopedRequestCostContext inner(&inner_cost);
+    EXPECT_EQ(ScopedRequestCostContext::GetCurrent(), &inner_cost);
+    {
+      // A task without a cost collector clears the association.
+      ScopedRequestCostContext cleared(nullptr);
+      EXPECT_EQ(ScopedRequestCostContext::GetCurrent(), nullptr);
+    }
+    EXPECT_EQ(ScopedRequestCostContext::GetCurrent(), &inner_cost);
+  }
+  EXPECT_EQ(ScopedRequestCostContext::GetCurrent(), &outer_cost);
+}
+
+TEST(RequestCostContextAccessorTest, ReadsThreadLocalToken) {
+  std::unique_ptr<RequestCostAccessor> accessor =
+      RequestCostAccessorRegistry::CreateByNameOrNull("request_cost_context");
+  ASSERT_NE(accessor, nullptr);
+  EXPECT_EQ(accessor->GetRequestCost(), nullptr);
+
+  RequestCost request_cost;
+  ScopedRequestCostContext context(&request_cost);
+  EXPECT_EQ(accessor->GetRequestCost(), &request_cost);
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/common_runtime/shape_refiner.h"
 
+#include <algorithm>
 #include <deque>
 #include <limits>
 #include <memory>
@@ -25,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/eval_const_tensor.h"
 #include "tensorflow/core/common_runtime/function_utils.h"
 #include "tensorflow/core/common_runtime/graph_constructor.h"
+#include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/common_shape_fns.h"
 #include "tensorflow/core/framework/node_def.pb.h"
@@ -34,6 +36,8 @@ limitations under the License.
 #include "tensorflow/core/framework/versions.pb.h"
 #include "tensorflow/core/graph/algorithm.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tsl/platform/statusor.h"
 
 namespace tensorflow {
@@ -43,6 +47,83 @@ using shape_inference::InferenceContext;
 using shape_inference::ShapeAndType;
 using shape_inference::ShapeHandle;
 
+ShapeInferenceResultCache* ShapeInferenceResultCache::Global() {
+  static ShapeInferenceResultCache* cache = new ShapeInferenceResultCache;
+  return cache;
+}
+
+bool ShapeInferenceResultCache::Lookup(
+    uint64 key, std::vector<TensorShapeProto>* shapes) const {
+  mutex_lock l(mu_);
+  const auto it = cache_.find(key);
+  if (it == cache_.end()) return false;
+  *shapes = it->second;
+  return true;
+}
+
+void ShapeInferenceResultCache::Insert(uint64 key,
+                                       std::vector<TensorShapeProto> shapes) {
+  mutex_lock l(mu_);
+  if (static_cast<int64_t>(cache_.size()) >= kMaxEntries) return;
+  cache_.emplace(key, std::move(shapes));
+}
+
+int64_t ShapeInferenceResultCache::num_entries() const {
+  mutex_lock l(mu_);
+  return cache_.size();
+}
+
+void ShapeInferenceResultCache::Clear() {
+  mutex_lock l(mu_);
+  cache_.clear();
+}
+
+namespace {
+
+bool ShapeInferenceResultCacheEnabled() {
+  static const bool enabled = []() {
+    bool enabled = false;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_SHAPE_INFERENCE_RESULT_CACHE",
+                                   /*default_val=*/false, &enabled));
+    return enabled;
+  }();
+  return enabled;
+}
+
+// Fingerprints everything the shape function of `node` may read besides
+// input tensor values and handle data: the op, its attrs and the input
+// shapes. Callers must not use the cache when values or handle data can
+// contribute to the result.
+uint64 ComputeShapeInferenceKey(const Node* node, InferenceContext* c) {
+  uint64 h = Hash64(node->type_string());
+  // Attrs in sorted order for a deterministic fingerprint.
+  std::vector<std::pair<StringPiece, const AttrValue*>> attrs;
+  attrs.reserve(node->def().attr().size());
+  for (const auto& attr : node->def().attr()) {
+    attrs.emplace_back(attr.first, &attr.second);
+  }
+  std::sort(attrs.begin(), attrs.end());
+  for (const auto& attr : attrs) {
+    h = Hash64Combine(h, Hash64(attr.first.data(), attr.first.size()));
+    h = Hash64Combine(h, AttrValueHash(*attr.second));
+  }
+  h = Hash64Combine(h, c->num_inputs());
+  for (int i = 0; i < c->num_inputs(); ++i) {
+    ShapeHandle shape = c->input(i);
+    if (!c->RankKnown(shape)) {
+      h = Hash64Combine(h, kint64max);
+      continue;
+    }
+    h = Hash64Combine(h, c->Rank(shape));
+    for (int d = 0; d < c->Rank(shape); ++d) {
+      h = Hash64Combine(h, c->Value(c->Dim(shape, d)));
+    }
+  }
+  return h;
+}
+
+}  // namespace
+
 ShapeRefiner::ShapeRefiner(int graph_def_version,
                            const OpRegistryInterface* ops)
     : graph_def_version_(graph_def_version),
@@ -711,6 +792,37 @@ Status ShapeRefiner::RunShapeFn(const Node* node,
                                 const OpRegistrationData* op_reg_data,
                                 InferenceContext* c,
                                 InferenceContext* outer_context) {
+  // A result can be served from (and stored into) the process-wide cache
+  // only when the shape function cannot read anything the cache key does
+  // not cover: no function call inference (which consults the function
+  // library), no outer context, and no handle data on the inputs. Whether
+  // input tensor values were requested is only known after running the
+  // function, and is checked before inserting below.
+  bool cache_eligible =
+      ShapeInferenceResultCacheEnabled() && outer_context == nullptr &&
+      op_reg_data->shape_inference_fn != nullptr &&
+      !(function_library_ != nullptr &&
+        IsFunctionCall(*function_library_, *node));
+  for (int i = 0; cache_eligible && i < c->num_inputs(); ++i) {
+    if (c->input_handle_shapes_and_types(i) != nullptr) {
+      cache_eligible = false;
+    }
+  }
+  uint64 cache_key = 0;
+  if (cache_eligible) {
+    cache_key = ComputeShapeInferenceKey(node, c);
+    std::vector<TensorShapeProto> cached;
+    if (ShapeInferenceResultCache::Global()->Lookup(cache_key, &cached) &&
+        static_cast<int>(cached.size()) == c->num_outputs()) {
+      for (int i = 0; i < c->num_outputs(); ++i) {
+        ShapeHandle shape;
+        TF_RETURN_IF_ERROR(c->MakeShapeFromShapeProto(cached[i], &shape));
+        c->set_output(i, shape);
+      }
+      return absl::OkStatus();
+    }
+  }
+
   // This will be filled in with real data in a second pass.
   std::vector<const Tensor*> input_tensors(node->num_inputs(), nullptr);
   std::vector<Tensor> real_tensors(node->num_inputs());
@@ -822,6 +934,29 @@ Status ShapeRefiner::RunShapeFn(const Node* node,
     }
   } while (rerun_shape_fn);
 
+  if (cache_eligible) {
+    // Only cache results that did not depend on input tensor values and
+    // carry no handle data on the outputs.
+    for (int i = 0; cache_eligible && i < c->num_inputs(); ++i) {
+      if (c->requested_input_tensor(i) ||
+          c->requested_input_tensor_as_partial_shape(i)) {
+        cache_eligible = false;
+      }
+    }
+    for (int i = 0; cache_eligible && i < c->num_outputs(); ++i) {
+      if (c->output_handle_shapes_and_types(i) != nullptr) {
+        cache_eligible = false;
+      }
+    }
+    if (cache_eligible) {
+      std::vector<TensorShapeProto> shapes(c->num_outputs());
+      for (int i = 0; i < c->num_outputs(); ++i) {
+        c->ShapeHandleToProto(c->output(i), &shapes[i]);
+      }
+      ShapeInferenceResultCache::Global()->Insert(cache_key, std::move(shapes));
+    }
+  }
+
   return absl::OkStatus();
 }
 
@@ -24,15 +24,49 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/graph_runner.h"
 #include "tensorflow/core/framework/function.pb.h"
 #include "tensorflow/core/framework/shape_inference.h"
+#include "tensorflow/core/framework/tensor_shape.pb.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
 
 namespace tensorflow {
 namespace grappler {
 class GraphProperties;
 }
 
+// A process-wide cache of shape inference results, keyed by a fingerprint
+// of a node's op, attrs and input shapes. Only results proven independent
+// of input tensor values and resource handle data are stored, so a hit is
+// always equivalent to re-running the shape function. The cache amortizes
+// shape inference across repeated imports of near-identical graphs in one
+// process; it is consulted by ShapeRefiner when the environment variable
+// TF_SHAPE_INFERENCE_RESULT_CACHE is set to true.
+class ShapeInferenceResultCache {
+ public:
+  static ShapeInferenceResultCache* Global();
+
+  // If `key` is present, fills `shapes` with the cached output shapes and
+  // returns true.
+  bool Lookup(uint64 key, std::vector<TensorShapeProto>* shapes) const;
+
+  // Stores the output `shapes` for `key`. Becomes a no-op once the cache
+  // holds kMaxEntries entries.
+  void Insert(uint64 key, std::vector<TensorShapeProto> shapes);
+
+  int64_t num_entries() const;
+  void Clear();
+
+ private:
+  // Bounds memory usage; entries past the cap are simply not stored.
+  static constexpr int64_t kMaxEntries = 1 << 20;
+
+  mutable mutex mu_;
+  absl::flat_hash_map<uint64, std::vector<TensorShapeProto>> cache_
+      TF_GUARDED_BY(mu_);
+};
+
 // ShapeRefiner performs shape inference for TensorFlow Graphs.  It is
 // responsible for instantiating InferenceContext objects for each
 // Node in the Graph, and providing/storing the 'input_tensor' Tensors
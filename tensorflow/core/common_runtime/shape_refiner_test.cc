@@ -123,6 +123,26 @@ namespace {
     EXPECT_EQ(EXPECTED, (*v)[0].dtype);                               \
   } while (0);
 
+TEST(ShapeInferenceResultCacheTest, InsertLookupClear) {
+  ShapeInferenceResultCache cache;
+  std::vector<TensorShapeProto> shapes(2);
+  shapes[0].add_dim()->set_size(2);
+  shapes[1].add_dim()->set_size(-1);
+  cache.Insert(42, shapes);
+  EXPECT_EQ(cache.num_entries(), 1);
+
+  std::vector<TensorShapeProto> cached;
+  ASSERT_TRUE(cache.Lookup(42, &cached));
+  ASSERT_EQ(cached.size(), 2);
+  EXPECT_EQ(cached[0].dim(0).size(), 2);
+  EXPECT_EQ(cached[1].dim(0).size(), -1);
+  EXPECT_FALSE(cache.Lookup(43, &cached));
+
+  cache.Clear();
+  EXPECT_EQ(cache.num_entries(), 0);
+  EXPECT_FALSE(cache.Lookup(42, &cached));
+}
+
 TEST_F(ShapeRefinerTest, Constant) {
   // Create a constant node and validate that adding it is successful
   // and that its shape is correct.
@@ -74,6 +74,32 @@ void SimplePropagatorState::PropagateOutputs(const TaggedNode& tagged_node,
   const GraphView& gview = immutable_state_.graph_view();
   const NodeItem* item = tagged_node.node_item;
 
+  if (TF_PREDICT_TRUE(immutable_state_.has_propagation_plan())) {
+    // Fast path: walk the flat propagation plan compiled at executor
+    // construction time instead of the per-node EdgeInfo arrays.
+    for (const ImmutableExecutorState::PropagationPlanEntry& e :
+         immutable_state_.propagation_plan(item->node_id)) {
+      if (e.src_slot >= 0) {
+        // NOTE(mrry): The write to `input_tensors_[e.input_slot]` must happen
+        // before the pending count update, or else one thread might conclude
+        // that the count has dropped to zero before another thread finishes
+        // updating the input.
+        if (e.is_last) {
+          input_tensors_[e.input_slot] = std::move((*outputs)[e.src_slot]);
+        } else {
+          input_tensors_[e.input_slot] = (*outputs)[e.src_slot];
+        }
+      }
+
+      int32_t previous_num_pending =
+          pending_[e.dst_id].fetch_sub(1, std::memory_order_release);
+      if (previous_num_pending == 1) {
+        ready->emplace_back(&gview.node_ref(e.dst_id));
+      }
+    }
+    return;
+  }
+
   for (const EdgeInfo& e : item->output_edges()) {
     const int dst_id = e.dst_id;
     const int src_slot = e.output_slot;
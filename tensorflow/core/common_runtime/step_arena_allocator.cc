@@ -0,0 +1,81 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/step_arena_allocator.h"
+
+namespace tensorflow {
+
+StepArenaAllocator::StepArenaAllocator(Allocator* base, size_t slab_bytes)
+    : base_(base), slab_bytes_(slab_bytes) {}
+
+StepArenaAllocator::~StepArenaAllocator() {
+  // The last reference is gone: the step has finished and all allocations
+  // have been released, so the slabs can be returned wholesale.
+  for (const Slab& slab : slabs_) {
+    base_->DeallocateRaw(slab.base);
+  }
+}
+
+void* StepArenaAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
+  if (num_bytes == 0) return nullptr;
+  if (num_bytes > slab_bytes_ / kMaxArenaRequestDivisor ||
+      alignment > Allocator::kAllocatorAlignment) {
+    // Large or over-aligned requests are not worth arena placement; they
+    // would waste slab space. They still hold a reference so lifetime
+    // handling stays uniform.
+    void* ptr = base_->AllocateRaw(alignment, num_bytes);
+    if (ptr != nullptr) Ref();
+    return ptr;
+  }
+  mutex_lock l(mu_);
+  if (!slabs_.empty()) {
+    Slab& slab = slabs_.back();
+    size_t offset = (slab.used + alignment - 1) & ~(alignment - 1);
+    if (offset + num_bytes <= slab.capacity) {
+      slab.used = offset + num_bytes;
+      Ref();
+      return slab.base + offset;
+    }
+  }
+  char* slab_base = static_cast<char*>(
+      base_->AllocateRaw(Allocator::kAllocatorAlignment, slab_bytes_));
+  if (slab_base == nullptr) return nullptr;
+  slabs_.push_back(Slab{slab_base, slab_bytes_, num_bytes});
+  Ref();
+  return slab_base;
+}
+
+void StepArenaAllocator::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) return;
+  bool from_arena;
+  {
+    tf_shared_lock l(mu_);
+    from_arena = FromArena(ptr);
+  }
+  if (!from_arena) {
+    base_->DeallocateRaw(ptr);
+  }
+  // May delete `this`; must be the last action.
+  Unref();
+}
+
+bool StepArenaAllocator::FromArena(const void* ptr) const {
+  const char* p = static_cast<const char*>(ptr);
+  for (const Slab& slab : slabs_) {
+    if (p >= slab.base && p < slab.base + slab.capacity) return true;
+  }
+  return false;
+}
+
+}  // namespace tensorflow
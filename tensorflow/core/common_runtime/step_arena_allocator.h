@@ -0,0 +1,86 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_STEP_ARENA_ALLOCATOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_STEP_ARENA_ALLOCATOR_H_
+
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/lib/core/refcount.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// A bump allocator for temporary kernel allocations whose lifetime is bounded
+// by one executor step. Memory is carved out of large slabs obtained from the
+// wrapped device allocator; individual DeallocateRaw calls only drop a
+// reference, and the slabs are returned wholesale once the step has finished
+// AND every allocation has been released. Holding a reference per allocation
+// keeps the arena (and its slabs) alive even if a temp tensor briefly
+// outlives step teardown, e.g. because a kernel forwarded it to an output.
+//
+// The executor owns one reference for the duration of the step; see
+// OpKernelContext::Params::step_arena_allocator for how kernels reach it.
+//
+// Unlike ScopedAllocator (scoped_allocator.h) this requires no graph
+// annotations or pre-computed field layout: any allocate_temp call with
+// default attributes can be served.
+class StepArenaAllocator : public Allocator, public core::RefCounted {
+ public:
+  // `base` must outlive this allocator. `slab_bytes` is the size of each
+  // slab requested from `base`.
+  explicit StepArenaAllocator(Allocator* base,
+                              size_t slab_bytes = kDefaultSlabBytes);
+  ~StepArenaAllocator() override;
+
+  string Name() override { return "step_arena"; }
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void DeallocateRaw(void* ptr) override;
+
+  AllocatorMemoryType GetMemoryType() const override {
+    return base_->GetMemoryType();
+  }
+
+  // Requests larger than this fraction of a slab bypass the arena and go
+  // straight to the base allocator.
+  static constexpr size_t kDefaultSlabBytes = 1 << 20;  // 1MiB
+  static constexpr size_t kMaxArenaRequestDivisor = 4;
+
+ private:
+  struct Slab {
+    char* base;
+    size_t capacity;
+    size_t used;
+  };
+
+  // True if `ptr` lies inside one of the arena's slabs.
+  bool FromArena(const void* ptr) const TF_SHARED_LOCKS_REQUIRED(mu_);
+
+  Allocator* const base_;  // Not owned.
+  const size_t slab_bytes_;
+
+  mutable mutex mu_;
+  std::vector<Slab> slabs_ TF_GUARDED_BY(mu_);
+
+  StepArenaAllocator(const StepArenaAllocator&) = delete;
+  void operator=(const StepArenaAllocator&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_STEP_ARENA_ALLOCATOR_H_
@@ -0,0 +1,154 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/tensor_buffer_pool.h"
+
+#include "tensorflow/core/lib/monitoring/counter.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+
+namespace {
+
+auto* pool_hits = monitoring::Counter<0>::New(
+    "/tensorflow/core/tensor_buffer_pool/hits",
+    "Number of tensor buffer allocations served from the recycling pool.");
+auto* pool_misses = monitoring::Counter<0>::New(
+    "/tensorflow/core/tensor_buffer_pool/misses",
+    "Number of pool-eligible allocations that fell through to the "
+    "underlying allocator.");
+auto* pool_evictions = monitoring::Counter<0>::New(
+    "/tensorflow/core/tensor_buffer_pool/evictions",
+    "Number of buffers freed instead of pooled because the pool byte "
+    "budget was exhausted.");
+
+int64_t MaxPoolBytesFromEnv() {
+  int64_t value = 64 << 20;  // 64MiB default budget.
+  Status status = ReadInt64FromEnvVar("TF_TENSOR_BUFFER_POOL_MAX_BYTES",
+                                      value, &value);
+  if (!status.ok()) {
+    LOG(ERROR) << "TF_TENSOR_BUFFER_POOL_MAX_BYTES: " << status.message();
+  }
+  return value;
+}
+
+}  // namespace
+
+/* static */
+TensorBufferPool* TensorBufferPool::GetForAllocator(Allocator* base) {
+  static mutex* registry_mu = new mutex;
+  static auto* registry =
+      new absl::flat_hash_map<Allocator*, TensorBufferPool*>;
+  mutex_lock l(*registry_mu);
+  auto it = registry->find(base);
+  if (it != registry->end()) {
+    return it->second;
+  }
+  // Deliberately leaked: pooled buffers may outlive any one session.
+  TensorBufferPool* pool = new TensorBufferPool(base);
+  registry->emplace(base, pool);
+  return pool;
+}
+
+TensorBufferPool::TensorBufferPool(Allocator* base)
+    : base_(base), max_pool_bytes_(MaxPoolBytesFromEnv()) {}
+
+/* static */
+int TensorBufferPool::SizeClassIndex(size_t num_bytes) {
+  int size_class = 0;
+  size_t class_bytes = kMinClassBytes;
+  while (class_bytes < num_bytes) {
+    class_bytes <<= 1;
+    ++size_class;
+  }
+  DCHECK_LT(size_class, kNumSizeClasses);
+  return size_class;
+}
+
+/* static */
+size_t TensorBufferPool::SizeClassBytes(int size_class) {
+  return kMinClassBytes << size_class;
+}
+
+void* TensorBufferPool::AllocateRaw(size_t alignment, size_t num_bytes) {
+  if (num_bytes == 0 || num_bytes > kMaxPooledBytes ||
+      alignment > Allocator::kAllocatorAlignment) {
+    return base_->AllocateRaw(alignment, num_bytes);
+  }
+  const int size_class = SizeClassIndex(num_bytes);
+  void* ptr = nullptr;
+  {
+    SizeClass& sc = classes_[size_class];
+    mutex_lock l(sc.mu);
+    if (!sc.free_buffers.empty()) {
+      ptr = sc.free_buffers.back();
+      sc.free_buffers.pop_back();
+    }
+  }
+  if (ptr != nullptr) {
+    pooled_bytes_.fetch_sub(SizeClassBytes(size_class),
+                            std::memory_order_relaxed);
+    pool_hits->GetCell()->IncrementBy(1);
+    return ptr;
+  }
+  pool_misses->GetCell()->IncrementBy(1);
+  // Allocate the full class size so the buffer can serve any future request
+  // in its class.
+  ptr = base_->AllocateRaw(Allocator::kAllocatorAlignment,
+                           SizeClassBytes(size_class));
+  if (ptr != nullptr) {
+    PtrShard& shard = ShardFor(ptr);
+    mutex_lock l(shard.mu);
+    shard.size_class[ptr] = size_class;
+  }
+  return ptr;
+}
+
+void TensorBufferPool::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) return;
+  int size_class = -1;
+  {
+    PtrShard& shard = ShardFor(ptr);
+    mutex_lock l(shard.mu);
+    auto it = shard.size_class.find(ptr);
+    if (it != shard.size_class.end()) {
+      size_class = it->second;
+    }
+  }
+  if (size_class < 0) {
+    // Pass-through allocation (too large or over-aligned).
+    base_->DeallocateRaw(ptr);
+    return;
+  }
+  const int64_t class_bytes = SizeClassBytes(size_class);
+  if (pooled_bytes_.load(std::memory_order_relaxed) + class_bytes <=
+      max_pool_bytes_) {
+    pooled_bytes_.fetch_add(class_bytes, std::memory_order_relaxed);
+    SizeClass& sc = classes_[size_class];
+    mutex_lock l(sc.mu);
+    sc.free_buffers.push_back(ptr);
+    return;
+  }
+  // Budget exhausted: free for real and forget the pointer.
+  pool_evictions->GetCell()->IncrementBy(1);
+  {
+    PtrShard& shard = ShardFor(ptr);
+    mutex_lock l(shard.mu);
+    shard.size_class.erase(ptr);
+  }
+  base_->DeallocateRaw(ptr);
+}
+
+}  // namespace tensorflow
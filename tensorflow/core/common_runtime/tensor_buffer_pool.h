@@ -0,0 +1,105 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_TENSOR_BUFFER_POOL_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_TENSOR_BUFFER_POOL_H_
+
+#include <atomic>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// A recycling pool for tensor buffers on the steady-state inference path.
+// Buffers are bucketed into power-of-two size classes; DeallocateRaw returns
+// a buffer to its class freelist (up to a byte budget) instead of freeing it,
+// and AllocateRaw serves repeat shapes from the freelist without touching the
+// underlying allocator. Sessions that execute the same graph millions of
+// times stop paying allocator cost once the pool is warm.
+//
+// Raw buffers carry no dtype, so classes are keyed by size only; two dtypes
+// with equal byte counts share a class, which strictly increases hit rate.
+//
+// Pools are process-lifetime singletons keyed by the wrapped allocator (see
+// GetForAllocator) so pooled buffers can safely outlive the session that
+// allocated them. Hit/miss/eviction counts are exported under
+// /tensorflow/core/tensor_buffer_pool/.
+class TensorBufferPool : public Allocator {
+ public:
+  // Returns the process-wide pool wrapping `base`, creating it on first use.
+  // The returned pool is never destroyed.
+  static TensorBufferPool* GetForAllocator(Allocator* base);
+
+  string Name() override { return "tensor_buffer_pool"; }
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void DeallocateRaw(void* ptr) override;
+
+  AllocatorMemoryType GetMemoryType() const override {
+    return base_->GetMemoryType();
+  }
+
+  absl::optional<AllocatorStats> GetStats() override {
+    return base_->GetStats();
+  }
+  bool ClearStats() override { return base_->ClearStats(); }
+
+  // Requests above this size always go to the underlying allocator.
+  static constexpr size_t kMaxPooledBytes = 16 << 20;  // 16MiB
+
+ private:
+  explicit TensorBufferPool(Allocator* base);
+
+  static constexpr size_t kMinClassBytes = 256;
+  static constexpr int kNumSizeClasses = 17;  // 256B .. 16MiB
+
+  struct SizeClass {
+    mutex mu;
+    std::vector<void*> free_buffers TF_GUARDED_BY(mu);
+  };
+
+  static int SizeClassIndex(size_t num_bytes);
+  static size_t SizeClassBytes(int size_class);
+
+  Allocator* const base_;  // Not owned.
+  const int64_t max_pool_bytes_;
+
+  SizeClass classes_[kNumSizeClasses];
+  std::atomic<int64_t> pooled_bytes_{0};
+
+  // Maps live pooled pointers to their size class, so DeallocateRaw can tell
+  // pooled buffers from pass-through ones. Sharded to keep contention low.
+  static constexpr int kNumPtrShards = 16;
+  struct PtrShard {
+    mutex mu;
+    absl::flat_hash_map<const void*, int> size_class TF_GUARDED_BY(mu);
+  };
+  PtrShard ptr_shards_[kNumPtrShards];
+  PtrShard& ShardFor(const void* ptr) {
+    return ptr_shards_[(reinterpret_cast<uintptr_t>(ptr) >> 6) %
+                       kNumPtrShards];
+  }
+
+  TensorBufferPool(const TensorBufferPool&) = delete;
+  void operator=(const TensorBufferPool&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_TENSOR_BUFFER_POOL_H_
@@ -43,6 +43,9 @@ class ThreadPoolDeviceFactory : public DeviceFactory {
     if (iter != options.config.device_count().end()) {
       n = iter->second;
     }
+    if (options.config.experimental().use_numa_affinity()) {
+      ProcessState::singleton()->EnableNUMA();
+    }
     for (int i = 0; i < n; i++) {
       string name = strings::StrCat(name_prefix, "/device:CPU:", i);
       std::unique_ptr<ThreadPoolDevice> tpd;
@@ -56,9 +59,16 @@ class ThreadPoolDeviceFactory : public DeviceFactory {
         }
         DeviceLocality dev_locality;
         dev_locality.set_numa_node(numa_node);
+        // With fewer CPU devices than NUMA nodes, one device's worker
+        // threads span sockets; let each allocation come from the arena of
+        // the calling thread's node instead of pinning the whole device to
+        // one node's arena.
+        Allocator* allocator =
+            n < num_numa_nodes
+                ? ProcessState::singleton()->GetNUMALocalCPUAllocator()
+                : ProcessState::singleton()->GetCPUAllocator(numa_node);
         tpd = std::make_unique<ThreadPoolDevice>(
-            options, name, Bytes(256 << 20), dev_locality,
-            ProcessState::singleton()->GetCPUAllocator(numa_node));
+            options, name, Bytes(256 << 20), dev_locality, allocator);
       } else {
         tpd = std::make_unique<ThreadPoolDevice>(
             options, name, Bytes(256 << 20), DeviceLocality(),
@@ -14,18 +14,28 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/data/compression_utils.h"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "zstd.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/framework/variant_op_registry.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/snappy.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -36,6 +46,11 @@ namespace {
 // version.
 constexpr int kCompressedElementVersion = 0;
 
+// Version written when the element is framed into independently compressed
+// blocks and/or compressed with a non-Snappy codec. Version 0 elements are
+// always a single Snappy stream.
+constexpr int kFramedCompressedElementVersion = 1;
+
 }  // namespace
 
 class Iov {
@@ -61,7 +76,216 @@ class Iov {
   size_t num_bytes_;
 };
 
+namespace {
+
+// A contiguous range of element bytes, described by the iovec pieces it
+// covers. Produced by `SplitIovIntoBlocks`.
+using IovBlock = std::vector<struct iovec>;
+
+size_t BlockNumBytes(const IovBlock& block) {
+  size_t num_bytes = 0;
+  for (const auto& piece : block) {
+    num_bytes += piece.iov_len;
+  }
+  return num_bytes;
+}
+
+// Splits the logical concatenation of the pieces in `iov` into blocks of
+// `block_bytes` bytes (the last block may be shorter). Pieces that straddle a
+// block boundary are split between the adjacent blocks.
+std::vector<IovBlock> SplitIovIntoBlocks(Iov& iov, size_t block_bytes) {
+  std::vector<IovBlock> blocks;
+  if (block_bytes == 0) {
+    return blocks;
+  }
+  IovBlock current;
+  size_t current_bytes = 0;
+  for (size_t i = 0; i < iov.NumPieces(); ++i) {
+    char* base = static_cast<char*>(iov.Data()[i].iov_base);
+    size_t remaining = iov.Data()[i].iov_len;
+    while (remaining > 0) {
+      size_t num_bytes = std::min(remaining, block_bytes - current_bytes);
+      current.push_back({base, num_bytes});
+      base += num_bytes;
+      remaining -= num_bytes;
+      current_bytes += num_bytes;
+      if (current_bytes == block_bytes) {
+        blocks.push_back(std::move(current));
+        current.clear();
+        current_bytes = 0;
+      }
+    }
+  }
+  if (current_bytes > 0) {
+    blocks.push_back(std::move(current));
+  }
+  return blocks;
+}
+
+// Shared pool on which element blocks are compressed and decompressed in
+// parallel.
+thread::ThreadPool* CompressionThreadPool() {
+  static thread::ThreadPool* pool = new thread::ThreadPool(
+      Env::Default(), "data_compression", port::MaxParallelism());
+  return pool;
+}
+
+// Runs `fn(i)` for each i in [0, n), in parallel when there is more than one
+// block. Blocks until all invocations have completed.
+void RunBlocksInParallel(int64_t n, const std::function<void(int64_t)>& fn) {
+  if (n <= 1) {
+    for (int64_t i = 0; i < n; ++i) {
+      fn(i);
+    }
+    return;
+  }
+  BlockingCounter counter(n - 1);
+  for (int64_t i = 1; i < n; ++i) {
+    CompressionThreadPool()->Schedule([i, &fn, &counter]() {
+      fn(i);
+      counter.DecrementCount();
+    });
+  }
+  fn(0);
+  counter.Wait();
+}
+
+// Compresses the bytes covered by `block` into `out` using `codec`.
+Status CompressBlock(CompressionCodec codec, const IovBlock& block,
+                     string* out) {
+  const size_t num_bytes = BlockNumBytes(block);
+  if (codec == CompressionCodec::kSnappy) {
+    if (!port::Snappy_CompressFromIOVec(block.data(), num_bytes, out)) {
+      return errors::Internal("Failed to compress using snappy.");
+    }
+    return absl::OkStatus();
+  }
+  // Zstd requires contiguous input, so blocks spanning multiple pieces are
+  // first gathered into a scratch buffer.
+  tstring scratch;
+  const char* src;
+  if (block.size() == 1) {
+    src = static_cast<const char*>(block[0].iov_base);
+  } else {
+    scratch.resize_uninitialized(num_bytes);
+    char* pos = scratch.mdata();
+    for (const auto& piece : block) {
+      memcpy(pos, piece.iov_base, piece.iov_len);
+      pos += piece.iov_len;
+    }
+    src = scratch.data();
+  }
+  out->resize(ZSTD_compressBound(num_bytes));
+  size_t compressed_size = ZSTD_compress(&(*out)[0], out->size(), src,
+                                         num_bytes, ZSTD_CLEVEL_DEFAULT);
+  if (ZSTD_isError(compressed_size)) {
+    return errors::Internal("Failed to compress using zstd: ",
+                            ZSTD_getErrorName(compressed_size));
+  }
+  out->resize(compressed_size);
+  return absl::OkStatus();
+}
+
+// Decompresses `compressed_size` bytes at `compressed` into the bytes covered
+// by `block` using `codec`.
+Status UncompressBlock(CompressionCodec codec, const char* compressed,
+                       size_t compressed_size, const IovBlock& block) {
+  const size_t num_bytes = BlockNumBytes(block);
+  if (codec == CompressionCodec::kSnappy) {
+    size_t uncompressed_size;
+    if (!port::Snappy_GetUncompressedLength(compressed, compressed_size,
+                                            &uncompressed_size)) {
+      return errors::Internal(
+          "Could not get snappy uncompressed length. Compressed block size: ",
+          compressed_size);
+    }
+    if (uncompressed_size != num_bytes) {
+      return errors::Internal("Uncompressed size mismatch. Snappy expects ",
+                              uncompressed_size,
+                              " whereas the tensor metadata suggests ",
+                              num_bytes);
+    }
+    if (!port::Snappy_UncompressToIOVec(compressed, compressed_size,
+                                        block.data(), block.size())) {
+      return errors::Internal("Failed to perform snappy decompression.");
+    }
+    return absl::OkStatus();
+  }
+  // Zstd requires contiguous output, so blocks spanning multiple pieces are
+  // decompressed into a scratch buffer and scattered afterwards.
+  tstring scratch;
+  char* dst;
+  if (block.size() == 1) {
+    dst = static_cast<char*>(block[0].iov_base);
+  } else {
+    scratch.resize_uninitialized(num_bytes);
+    dst = scratch.mdata();
+  }
+  size_t uncompressed_size =
+      ZSTD_decompress(dst, num_bytes, compressed, compressed_size);
+  if (ZSTD_isError(uncompressed_size)) {
+    return errors::Internal("Failed to perform zstd decompression: ",
+                            ZSTD_getErrorName(uncompressed_size));
+  }
+  if (uncompressed_size != num_bytes) {
+    return errors::Internal("Uncompressed size mismatch. Zstd produced ",
+                            uncompressed_size,
+                            " whereas the tensor metadata suggests ",
+                            num_bytes);
+  }
+  if (block.size() > 1) {
+    const char* pos = scratch.data();
+    for (const auto& piece : block) {
+      memcpy(piece.iov_base, pos, piece.iov_len);
+      pos += piece.iov_len;
+    }
+  }
+  return absl::OkStatus();
+}
+
+// Options used by the two-argument `CompressElement` overload, read from the
+// environment once on first use.
+const CompressionOptions& DefaultCompressionOptions() {
+  static const CompressionOptions* options = [] {
+    auto* result = new CompressionOptions();
+    string codec;
+    Status s = ReadStringFromEnvVar("TF_DATA_COMPRESSION_CODEC",
+                                    /*default_val=*/"snappy", &codec);
+    if (!s.ok()) {
+      LOG(ERROR) << s;
+    }
+    if (codec == "zstd") {
+      result->codec = CompressionCodec::kZstd;
+    } else if (codec != "snappy") {
+      LOG(ERROR) << "Unrecognized TF_DATA_COMPRESSION_CODEC value: " << codec
+                 << "; using snappy.";
+    }
+    int64_t block_bytes = 0;
+    s = ReadInt64FromEnvVar("TF_DATA_COMPRESSION_BLOCK_BYTES",
+                            /*default_val=*/0, &block_bytes);
+    if (!s.ok()) {
+      LOG(ERROR) << s;
+    }
+    if (block_bytes < 0) {
+      LOG(ERROR) << "Invalid TF_DATA_COMPRESSION_BLOCK_BYTES value: "
+                 << block_bytes;
+      block_bytes = 0;
+    }
+    result->block_bytes = block_bytes;
+    return result;
+  }();
+  return *options;
+}
+
+}  // namespace
+
+Status CompressElement(const std::vector<Tensor>& element,
+                       CompressedElement* out) {
+  return CompressElement(element, DefaultCompressionOptions(), out);
+}
+
 Status CompressElement(const std::vector<Tensor>& element,
+                       const CompressionOptions& options,
                        CompressedElement* out) {
   // First pass: preprocess the non`memcpy`able tensors.
   size_t num_string_tensors = 0;
@@ -120,16 +344,41 @@ Status CompressElement(const std::vector<Tensor>& element,
     }
   }
 
-  if (iov.NumBytes() > kuint32max) {
+  if (options.codec == CompressionCodec::kSnappy &&
+      iov.NumBytes() > kuint32max) {
     return errors::OutOfRange("Encountered dataset element of size ",
                               iov.NumBytes(),
                               ", exceeding the 4GB Snappy limit.");
   }
-  if (!port::Snappy_CompressFromIOVec(iov.Data(), iov.NumBytes(),
-                                      out->mutable_data())) {
-    return errors::Internal("Failed to compress using snappy.");
+  if (options.codec == CompressionCodec::kSnappy && options.block_bytes == 0) {
+    // Legacy single-stream format, readable by version 0 consumers.
+    if (!port::Snappy_CompressFromIOVec(iov.Data(), iov.NumBytes(),
+                                        out->mutable_data())) {
+      return errors::Internal("Failed to compress using snappy.");
+    }
+    out->set_version(kCompressedElementVersion);
+  } else {
+    const size_t block_bytes = options.block_bytes > 0
+                                   ? static_cast<size_t>(options.block_bytes)
+                                   : iov.NumBytes();
+    std::vector<IovBlock> blocks = SplitIovIntoBlocks(iov, block_bytes);
+    std::vector<string> compressed_blocks(blocks.size());
+    std::vector<Status> statuses(blocks.size());
+    RunBlocksInParallel(blocks.size(), [&](int64_t i) {
+      statuses[i] =
+          CompressBlock(options.codec, blocks[i], &compressed_blocks[i]);
+    });
+    for (const Status& status : statuses) {
+      TF_RETURN_IF_ERROR(status);
+    }
+    out->set_codec(static_cast<int32>(options.codec));
+    out->set_uncompressed_block_bytes(block_bytes);
+    for (const string& compressed_block : compressed_blocks) {
+      out->add_compressed_block_sizes(compressed_block.size());
+      out->mutable_data()->append(compressed_block);
+    }
+    out->set_version(kFramedCompressedElementVersion);
   }
-  out->set_version(kCompressedElementVersion);
   VLOG(3) << "Compressed element from " << iov.NumBytes() << " bytes to "
           << out->data().size() << " bytes";
   return absl::OkStatus();
@@ -137,7 +386,8 @@ Status CompressElement(const std::vector<Tensor>& element,
 
 Status UncompressElement(const CompressedElement& compressed,
                          std::vector<Tensor>* out) {
-  if (compressed.version() != kCompressedElementVersion) {
+  if (compressed.version() != kCompressedElementVersion &&
+      compressed.version() != kFramedCompressedElementVersion) {
     return errors::Internal("Unsupported compressed element version: ",
                             compressed.version());
   }
@@ -191,22 +441,67 @@ Status UncompressElement(const CompressedElement& compressed,
 
   // Step 2: Uncompress into the iovec.
   const std::string& compressed_data = compressed.data();
-  size_t uncompressed_size;
-  if (!port::Snappy_GetUncompressedLength(
-          compressed_data.data(), compressed_data.size(), &uncompressed_size)) {
-    return errors::Internal(
-        "Could not get snappy uncompressed length. Compressed data size: ",
-        compressed_data.size());
-  }
-  if (uncompressed_size != static_cast<size_t>(iov.NumBytes())) {
-    return errors::Internal(
-        "Uncompressed size mismatch. Snappy expects ", uncompressed_size,
-        " whereas the tensor metadata suggests ", iov.NumBytes());
-  }
-  if (!port::Snappy_UncompressToIOVec(compressed_data.data(),
-                                      compressed_data.size(), iov.Data(),
-                                      iov.NumPieces())) {
-    return errors::Internal("Failed to perform snappy decompression.");
+  if (compressed.version() == kFramedCompressedElementVersion) {
+    CompressionCodec codec;
+    switch (compressed.codec()) {
+      case static_cast<int32>(CompressionCodec::kSnappy):
+        codec = CompressionCodec::kSnappy;
+        break;
+      case static_cast<int32>(CompressionCodec::kZstd):
+        codec = CompressionCodec::kZstd;
+        break;
+      default:
+        return errors::Internal("Unsupported compressed element codec: ",
+                                compressed.codec());
+    }
+    std::vector<IovBlock> blocks =
+        SplitIovIntoBlocks(iov, compressed.uncompressed_block_bytes());
+    if (static_cast<int>(blocks.size()) !=
+        compressed.compressed_block_sizes_size()) {
+      return errors::Internal(
+          "Compressed block count mismatch. The element contains ",
+          compressed.compressed_block_sizes_size(),
+          " blocks whereas the tensor metadata suggests ", blocks.size());
+    }
+    std::vector<size_t> block_offsets(blocks.size());
+    size_t offset = 0;
+    for (int i = 0; i < blocks.size(); ++i) {
+      block_offsets[i] = offset;
+      offset += compressed.compressed_block_sizes(i);
+    }
+    if (offset != compressed_data.size()) {
+      return errors::Internal("Compressed data size mismatch. The element has ",
+                              compressed_data.size(),
+                              " bytes whereas the block sizes sum to ", offset);
+    }
+    std::vector<Status> statuses(blocks.size());
+    RunBlocksInParallel(blocks.size(), [&](int64_t i) {
+      statuses[i] = UncompressBlock(
+          codec, compressed_data.data() + block_offsets[i],
+          compressed.compressed_block_sizes(i), blocks[i]);
+    });
+    for (const Status& status : statuses) {
+      TF_RETURN_IF_ERROR(status);
+    }
+  } else {
+    size_t uncompressed_size;
+    if (!port::Snappy_GetUncompressedLength(compressed_data.data(),
+                                            compressed_data.size(),
+                                            &uncompressed_size)) {
+      return errors::Internal(
+          "Could not get snappy uncompressed length. Compressed data size: ",
+          compressed_data.size());
+    }
+    if (uncompressed_size != static_cast<size_t>(iov.NumBytes())) {
+      return errors::Internal(
+          "Uncompressed size mismatch. Snappy expects ", uncompressed_size,
+          " whereas the tensor metadata suggests ", iov.NumBytes());
+    }
+    if (!port::Snappy_UncompressToIOVec(compressed_data.data(),
+                                        compressed_data.size(), iov.Data(),
+                                        iov.NumPieces())) {
+      return errors::Internal("Failed to perform snappy decompression.");
+    }
   }
 
   // Third pass: deserialize nonstring, non`memcpy`able tensors.
@@ -24,6 +24,21 @@ limitations under the License.
 namespace tensorflow {
 namespace data {
 
+// Codec used to compress element bytes. The enumerator values match the
+// `codec` field of the `CompressedElement` proto.
+enum class CompressionCodec : int { kSnappy = 0, kZstd = 1 };
+
+// Options controlling how `CompressElement` encodes its output.
+struct CompressionOptions {
+  CompressionCodec codec = CompressionCodec::kSnappy;
+  // If positive, the element bytes are split into independently compressed
+  // blocks of this many bytes so that compression and decompression of a
+  // single large element can run across multiple cores. If zero, the element
+  // is compressed as a single stream; with the Snappy codec this writes the
+  // legacy version 0 format that predates framing.
+  int64_t block_bytes = 0;
+};
+
 // Compresses the components of `element` into the `CompressedElement` proto.
 //
 // In addition to writing the actual compressed bytes, `Compress` fills
@@ -33,7 +48,17 @@ namespace data {
 Status CompressElement(const std::vector<Tensor>& element,
                        CompressedElement* out);
 
-// Uncompresses a `CompressedElement` into a vector of tensor components.
+// Like the above, but with explicit control over the codec and framing. The
+// two-argument overload reads its defaults from the TF_DATA_COMPRESSION_CODEC
+// ("snappy" or "zstd") and TF_DATA_COMPRESSION_BLOCK_BYTES environment
+// variables.
+Status CompressElement(const std::vector<Tensor>& element,
+                       const CompressionOptions& options,
+                       CompressedElement* out);
+
+// Uncompresses a `CompressedElement` into a vector of tensor components. The
+// codec and framing are determined by the `CompressedElement` itself; framed
+// elements with multiple blocks are decompressed in parallel.
 Status UncompressElement(const CompressedElement& compressed,
                          std::vector<Tensor>* out);
 
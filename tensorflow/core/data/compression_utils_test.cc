@@ -93,12 +93,35 @@ TEST_P(ParameterizedCompressionUtilsTest, CompressedElementVersion) {
   EXPECT_EQ(0, compressed.version());
 }
 
+TEST_P(ParameterizedCompressionUtilsTest, FramedRoundTrip) {
+  std::vector<Tensor> element = GetParam();
+  for (CompressionCodec codec :
+       {CompressionCodec::kSnappy, CompressionCodec::kZstd}) {
+    for (int64_t block_bytes : {int64_t{0}, int64_t{1}, int64_t{64}}) {
+      CompressionOptions options;
+      options.codec = codec;
+      options.block_bytes = block_bytes;
+      CompressedElement compressed;
+      TF_ASSERT_OK(CompressElement(element, options, &compressed));
+      if (codec == CompressionCodec::kSnappy && block_bytes == 0) {
+        EXPECT_EQ(0, compressed.version());
+      } else {
+        EXPECT_EQ(1, compressed.version());
+      }
+      std::vector<Tensor> round_trip_element;
+      TF_ASSERT_OK(UncompressElement(compressed, &round_trip_element));
+      TF_EXPECT_OK(
+          ExpectEqual(element, round_trip_element, /*compare_order=*/true));
+    }
+  }
+}
+
 TEST_P(ParameterizedCompressionUtilsTest, VersionMismatch) {
   std::vector<Tensor> element = GetParam();
   CompressedElement compressed;
   TF_ASSERT_OK(CompressElement(element, &compressed));
 
-  compressed.set_version(1);
+  compressed.set_version(2);
   std::vector<Tensor> round_trip_element;
   EXPECT_THAT(UncompressElement(compressed, &round_trip_element),
               StatusIs(error::INTERNAL));
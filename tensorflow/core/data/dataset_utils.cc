@@ -89,6 +89,7 @@ constexpr char kNoopEliminationOpt[] = "noop_elimination";
 constexpr char kMapParallelizationOpt[] = "map_parallelization";
 constexpr char kShuffleAndRepeatFusionOpt[] = "shuffle_and_repeat_fusion";
 constexpr char kFilterFusionOpt[] = "filter_fusion";
+constexpr char kFilterMapFusionOpt[] = "filter_map_fusion";
 constexpr char kMapAndFilterFusionOpt[] = "map_and_filter_fusion";
 constexpr char kMapFusionOpt[] = "map_fusion";
 constexpr char kParallelBatchOpt[] = "parallel_batch";
@@ -153,6 +154,14 @@ void DefaultOptimizationGraphRewrites(
       optimization_disabled->insert(kFilterFusionOpt);
     }
   }
+  if (optimization_options.optional_filter_map_fusion_case() ==
+      OptimizationOptions::kFilterMapFusion) {
+    if (optimization_options.filter_map_fusion()) {
+      optimization_enabled->insert(kFilterMapFusionOpt);
+    } else {
+      optimization_disabled->insert(kFilterMapFusionOpt);
+    }
+  }
   if (optimization_options.optional_map_and_batch_fusion_case() ==
       OptimizationOptions::kMapAndBatchFusion) {
     if (optimization_options.map_and_batch_fusion()) {
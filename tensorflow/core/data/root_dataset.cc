@@ -32,11 +32,14 @@ limitations under the License.
 #include "tensorflow/core/framework/model.h"
 #include "tensorflow/core/framework/model.pb.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/host_info.h"
 #include "tensorflow/core/platform/mem.h"
+#include "tensorflow/core/platform/numa.h"
 #include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/stringprintf.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tsl/platform/host_info.h"
 
 namespace tensorflow {
@@ -52,6 +55,7 @@ constexpr char kReadRoundtripLatency[] = "read_latency_usec";
 constexpr char kReadResponseBytes[] = "read_bytes";
 constexpr char kIntraOpParallelism[] = "intra_op_parallelism";
 constexpr char kMemBandwidth[] = "mem_bw_used_megabytes_per_sec";
+constexpr char kNumaNode[] = "numa_node";
 constexpr char kPrivateThreadpoolSize[] = "threadpool_size";
 constexpr char kRamBudget[] = "ram_budget_megabytes";
 constexpr char kRamUsage[] = "ram_usage_megabytes";
@@ -63,6 +67,41 @@ inline int64_t value_or_default(int64_t x, int64_t y, int64_t z) {
   return x == y ? z : x;
 }
 
+// Returns the NUMA node to which tf.data pipeline threads should be pinned,
+// or `port::kNUMANoAffinity` if pinning is not requested or not possible.
+// Controlled by the environment variable `TF_DATA_NUMA_NODE`. Pinning the
+// private threadpool keeps the pipeline threads (and, via the kernel's
+// first-touch policy, the buffers they populate) local to one socket, which
+// avoids cross-socket memory traffic on multi-socket hosts.
+int DataNumaNode() {
+  static const int numa_node = [] {
+    int64_t value = -1;
+    Status status = ReadInt64FromEnvVar("TF_DATA_NUMA_NODE", -1, &value);
+    if (!status.ok()) {
+      LOG(ERROR) << status;
+      return port::kNUMANoAffinity;
+    }
+    if (value < 0) {
+      return port::kNUMANoAffinity;
+    }
+    if (!port::NUMAEnabled()) {
+      LOG(WARNING) << "TF_DATA_NUMA_NODE=" << value
+                   << " was requested but NUMA support is not available; "
+                      "tf.data threads will not be pinned.";
+      return port::kNUMANoAffinity;
+    }
+    if (value >= port::NUMANumNodes()) {
+      LOG(WARNING) << "TF_DATA_NUMA_NODE=" << value
+                   << " is out of range; this host has "
+                   << port::NUMANumNodes()
+                   << " NUMA node(s). tf.data threads will not be pinned.";
+      return port::kNUMANoAffinity;
+    }
+    return static_cast<int>(value);
+  }();
+  return numa_node;
+}
+
 void SetRootDatasetParams(const Options& options, RootDataset::Params* params) {
   if (ShouldConfigureMaxIntraOpParallelism(options)) {
     params->max_intra_op_parallelism =
@@ -105,6 +144,7 @@ void SetRootDatasetParams(const Options& options, RootDataset::Params* params) {
     ram_budget_share = model::kRamBudgetShare;
   }
   params->ram_budget_share = ram_budget_share;
+  params->numa_node = DataNumaNode();
 }
 
 void AddTraceMetadata(const RootDataset::Params& params, const Options& options,
@@ -128,12 +168,17 @@ void AddTraceMetadata(const RootDataset::Params& params, const Options& options,
                                     params.max_intra_op_parallelism, 0,
                                     port::MaxParallelism())))));
   }
+  if (params.numa_node != port::kNUMANoAffinity) {
+    trace_metadata->push_back(std::make_pair(
+        kNumaNode, strings::Printf("%d", params.numa_node)));
+  }
   if (params.private_threadpool_size >= 0) {
     trace_metadata->push_back(std::make_pair(
         kPrivateThreadpoolSize,
-        strings::Printf("%lld", static_cast<long long>(value_or_default(
-                                    params.private_threadpool_size, 0,
-                                    port::MaxParallelism())))));
+        strings::Printf("%lld",
+                        static_cast<long long>(value_or_default(
+                            params.private_threadpool_size, 0,
+                            port::MaxParallelism(params.numa_node))))));
   }
   auto experiments = GetExperiments();
   if (!experiments.empty()) {
@@ -180,11 +225,16 @@ class RootDataset::Iterator : public DatasetIterator<RootDataset> {
                            port::MaxParallelism());
     }
     if (dataset()->params_.private_threadpool_size >= 0) {
+      const int numa_node = dataset()->params_.numa_node;
+      // When pinning to a NUMA node, size the default threadpool to the
+      // parallelism available on that node rather than the whole host.
       threadpool_size_ =
           value_or_default(dataset()->params_.private_threadpool_size, 0,
-                           port::MaxParallelism());
+                           port::MaxParallelism(numa_node));
+      ThreadOptions thread_options;
+      thread_options.numa_node = numa_node;
       thread_pool_ = std::make_unique<thread::ThreadPool>(
-          Env::Default(), ThreadOptions{}, "data_private_threadpool",
+          Env::Default(), thread_options, "data_private_threadpool",
           threadpool_size_);
     }
     cancellation_manager_ = std::make_unique<CancellationManager>();
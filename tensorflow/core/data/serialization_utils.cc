@@ -159,6 +159,18 @@ Status UpdateCheckpointElements(
   return absl::OkStatus();
 }
 
+Status GetIteratorName(const VariantTensorData& data, std::string* name) {
+  string metadata;
+  data.get_metadata(&metadata);
+  auto keys = str_util::Split(metadata, kDelimiter, str_util::SkipEmpty());
+  if (keys.empty()) {
+    return errors::Internal(
+        "Failed to extract an iterator name: no metadata found.");
+  }
+  *name = keys[0];
+  return absl::OkStatus();
+}
+
 VariantTensorDataReader::VariantTensorDataReader(
     const std::vector<const tensorflow::VariantTensorData*>& data) {
   for (const auto& d : data) {
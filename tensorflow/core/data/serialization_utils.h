@@ -59,6 +59,10 @@ Status UpdateCheckpointElements(
     const std::vector<std::vector<Tensor>>& elements,
     const absl::flat_hash_set<int64_t>& checkpoint_indices);
 
+// Returns the iterator name under which `data` was written by a
+// `VariantTensorDataWriter`, i.e. the first component of its metadata.
+Status GetIteratorName(const VariantTensorData& data, std::string* name);
+
 // Helper class for reading data from a vector of VariantTensorData objects.
 class VariantTensorDataReader : public IteratorStateReader {
  public:
@@ -101,6 +101,20 @@ TEST(SerializationUtilsTest, VariantTensorDataRoundtrip) {
   EXPECT_EQ(input_tensor.flat<float>()(0), val_tensor.flat<float>()(0));
 }
 
+TEST(SerializationUtilsTest, GetIteratorName) {
+  VariantTensorDataWriter writer;
+  TF_ASSERT_OK(writer.WriteScalar(full_name("Int64"), 24));
+  std::vector<const VariantTensorData*> data;
+  writer.GetData(&data);
+  ASSERT_EQ(data.size(), 1);
+  std::string name;
+  TF_ASSERT_OK(GetIteratorName(*data[0], &name));
+  EXPECT_EQ(name, "Iterator:");
+
+  VariantTensorData empty_data;
+  EXPECT_EQ(error::INTERNAL, GetIteratorName(empty_data, &name).code());
+}
+
 TEST(SerializationUtilsTest, VariantTensorDataNonExistentKey) {
   VariantTensorData data;
   strings::StrAppend(&data.metadata_, "key1", "@@");
@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DATA_SERVICE_CROSS_TRAINER_CACHE_H_
 #define TENSORFLOW_CORE_DATA_SERVICE_CROSS_TRAINER_CACHE_H_
 
+#include <array>
 #include <cstddef>
 #include <deque>
 #include <functional>
@@ -24,6 +25,7 @@ limitations under the License.
 #include <utility>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
 #include "tensorflow/core/data/service/byte_size.h"
 #include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/platform/errors.h"
@@ -46,7 +48,10 @@ namespace data {
 // collected when the cache becomes full. Consequently, trainers read from a
 // sliding window through the dataset and may not read the full dataset.
 //
-// The `CrossTrainerCache` class is thread-safe.
+// The `CrossTrainerCache` class is thread-safe. Trainer progress is sharded
+// across multiple mutexes and cache hits only take a shared lock on the
+// window, so concurrent trainers reading already-cached elements do not
+// serialize on a single mutex.
 //
 // Example usage:
 //
@@ -126,21 +131,23 @@ class CrossTrainerCache {
     bool cache_hit;
   };
 
-  // Returns the next element and metrics about this query.
-  StatusOr<CacheQueryResult> GetCacheQueryResult(const std::string& trainer_id);
+  // Trainer progress is partitioned into shards, each with its own mutex, so
+  // that concurrent trainers do not all contend on one lock when reading
+  // already-cached elements.
+  struct TrainerShard {
+    mutex mu;
 
-  // Returns true if element is ready for `trainer_id`. An element is ready if
-  // other trainers have read the data and the data remains in the cache. If the
-  // data is not ready, one of the trainers need to extend the cache.
-  bool IsElementReady(const std::string& trainer_id);
+    // Maps trainer IDs to element indices. The indices are absolute indices
+    // within the dataset. The actual index to use with `cache_` would be
+    // `element_indices[trainer_id] - cache_start_index_`.
+    absl::flat_hash_map<std::string, size_t> element_indices TF_GUARDED_BY(mu);
+  };
 
-  // Returns the absolute element index relative to the dataset (not relative to
-  // the cached elements).
-  size_t GetElementIndex(const std::string& trainer_id);
+  // Returns the next element and metrics about this query.
+  StatusOr<CacheQueryResult> GetCacheQueryResult(const std::string& trainer_id);
 
-  // Returns the next element for `trainer_id`.
-  StatusOr<std::shared_ptr<const ElementType>> GetElement(
-      const std::string& trainer_id);
+  // Returns the shard holding the progress of `trainer_id`.
+  TrainerShard& GetShard(const std::string& trainer_id);
 
   // Reads a new element and writes it into the cache.
   Status ExtendCache();
@@ -173,11 +180,10 @@ class CrossTrainerCache {
   // True if one thread is extending the cache.
   bool extending_cache_ TF_GUARDED_BY(mu_) = false;
 
-  // Maps trainer IDs to element indices. The indices are absolute indices
-  // within the dataset. The actual index to use with `cache_` would be
-  // `trainer_to_element_index_map_[trainer_id] - cache_start_index_`.
-  absl::flat_hash_map<std::string, size_t> trainer_to_element_index_map_
-      TF_GUARDED_BY(mu_);
+  // Number of shards over which trainer progress is partitioned.
+  static constexpr size_t kNumTrainerShards = 16;
+
+  std::array<TrainerShard, kNumTrainerShards> trainer_shards_;
 };
 
 template <class ElementType>
@@ -211,70 +217,63 @@ StatusOr<typename CrossTrainerCache<ElementType>::CacheQueryResult>
 CrossTrainerCache<ElementType>::GetCacheQueryResult(
     const std::string& trainer_id) {
   bool should_extend_cache = false;
+  TrainerShard& shard = GetShard(trainer_id);
   while (true) {
+    // Fast path: the element is already cached. Readers hold their shard
+    // mutex and a shared lock on `mu_`, so cache hits of trainers in
+    // different shards proceed in parallel.
     {
-      mutex_lock l(mu_);
+      mutex_lock shard_lock(shard.mu);
+      tf_shared_lock l(mu_);
       TF_RETURN_IF_ERROR(status_);
-      if (IsElementReady(trainer_id)) {
-        TF_ASSIGN_OR_RETURN(std::shared_ptr<const ElementType> element,
-                            GetElement(trainer_id));
+      size_t element_index = shard.element_indices[trainer_id];
+      if (element_index < cache_start_index_) {
+        element_index = cache_start_index_;
+      }
+      if (element_index < cache_start_index_ + cache_.size()) {
+        if (element_index >= std::numeric_limits<size_t>::max()) {
+          return errors::Internal(
+              "tf.data service caching element index exceeds integer limit. "
+              "Got ",
+              element_index);
+        }
+        std::shared_ptr<const ElementType> element =
+            cache_[element_index - cache_start_index_];
+        shard.element_indices[trainer_id] = element_index + 1;
         return CacheQueryResult{element,
                                 /*is_cache_hit=*/!should_extend_cache};
       }
+    }
 
-      // Extends the cache or waits for another thread to extend the cache. When
-      // concurrent trainers wait for the next element, only one of them should
-      // extend the cache.
+    // Slow path: extends the cache or waits for another thread to extend the
+    // cache. When concurrent trainers wait for the next element, only one of
+    // them should extend the cache. If a concurrent extension lands between
+    // the fast path and this block, this thread may extend the cache one
+    // element further than strictly needed, which is benign.
+    {
+      mutex_lock l(mu_);
+      TF_RETURN_IF_ERROR(status_);
       if (extending_cache_) {
         should_extend_cache = false;
         cv_.wait(l);
-      } else {
-        should_extend_cache = true;
-        extending_cache_ = true;
+        continue;
       }
+      should_extend_cache = true;
+      extending_cache_ = true;
     }
 
-    if (should_extend_cache) {
-      Status s = ExtendCache();
-      mutex_lock l(mu_);
-      extending_cache_ = false;
-      cv_.notify_all();
-      TF_RETURN_IF_ERROR(s);
-    }
-  }
-}
-
-template <class ElementType>
-bool CrossTrainerCache<ElementType>::IsElementReady(
-    const std::string& trainer_id) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-  return GetElementIndex(trainer_id) < cache_start_index_ + cache_.size();
-}
-
-template <class ElementType>
-StatusOr<std::shared_ptr<const ElementType>>
-CrossTrainerCache<ElementType>::GetElement(const std::string& trainer_id)
-    TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-  size_t element_index = GetElementIndex(trainer_id);
-  if (element_index >= std::numeric_limits<size_t>::max()) {
-    return errors::Internal(
-        "tf.data service caching element index exceeds integer limit. Got ",
-        element_index);
+    Status s = ExtendCache();
+    mutex_lock l(mu_);
+    extending_cache_ = false;
+    cv_.notify_all();
+    TF_RETURN_IF_ERROR(s);
   }
-
-  std::shared_ptr<const ElementType> result =
-      cache_[element_index - cache_start_index_];
-  trainer_to_element_index_map_[trainer_id] = element_index + 1;
-  return result;
 }
 
 template <class ElementType>
-size_t CrossTrainerCache<ElementType>::GetElementIndex(
-    const std::string& trainer_id) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-  size_t element_index = trainer_to_element_index_map_[trainer_id];
-  if (element_index < cache_start_index_) {
-    element_index = cache_start_index_;
-  }
-  return element_index;
+typename CrossTrainerCache<ElementType>::TrainerShard&
+CrossTrainerCache<ElementType>::GetShard(const std::string& trainer_id) {
+  return trainer_shards_[absl::HashOf(trainer_id) % kNumTrainerShards];
 }
 
 template <class ElementType>
@@ -311,6 +310,10 @@ void CrossTrainerCache<ElementType>::FreeSpace(size_t new_element_size_bytes)
     ++num_elements_discarded;
   }
 
+  if (num_elements_discarded > 0) {
+    metrics::RecordTFDataServiceCrossTrainerCacheEvictions(
+        num_elements_discarded);
+  }
   VLOG(3) << "Freed " << num_elements_discarded << " element(s) from "
           << "tf.data service cross-trainer cache. Memory usage: "
           << ByteSize::Bytes(cache_size_bytes_) << ".";
@@ -342,7 +345,7 @@ void CrossTrainerCache<ElementType>::RecordMetrics(
   metrics::RecordTFDataServiceCrossTrainerCacheQuery(result.cache_hit);
   size_t cache_size_bytes = 0;
   {
-    mutex_lock l(mu_);
+    tf_shared_lock l(mu_);
     cache_size_bytes = cache_size_bytes_;
   }
   metrics::RecordTFDataServiceCrossTrainerCacheSizeBytes(cache_size_bytes);
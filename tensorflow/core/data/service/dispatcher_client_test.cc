@@ -284,6 +284,31 @@ TEST_F(DispatcherClientTest, RegisterDatasetWithExplicitId) {
   EXPECT_EQ(dataset_id1, dataset_id2);
 }
 
+TEST_F(DispatcherClientTest, RegisterIdenticalDatasetReusesId) {
+  TF_ASSERT_OK(SetUpTfDataService(/*num_workers=*/1));
+  DataServiceMetadata metadata = GetDefaultMetadata();
+  metadata.set_cardinality(10);
+  TF_ASSERT_OK_AND_ASSIGN(const std::string dataset_id1,
+                          RegisterDataset(RangeDataset(10), metadata));
+
+  // Registering a byte-identical dataset with matching metadata is served
+  // from the dispatcher's fingerprint cache.
+  TF_ASSERT_OK_AND_ASSIGN(const std::string dataset_id2,
+                          RegisterDataset(RangeDataset(10), metadata));
+  EXPECT_EQ(dataset_id1, dataset_id2);
+
+  // A different dataset graph gets a new ID.
+  TF_ASSERT_OK_AND_ASSIGN(const std::string dataset_id3,
+                          RegisterDataset(RangeDataset(20), metadata));
+  EXPECT_NE(dataset_id1, dataset_id3);
+
+  // The same graph with different metadata gets a new ID.
+  metadata.set_cardinality(kInfiniteCardinality);
+  TF_ASSERT_OK_AND_ASSIGN(const std::string dataset_id4,
+                          RegisterDataset(RangeDataset(10), metadata));
+  EXPECT_NE(dataset_id1, dataset_id4);
+}
+
 TEST_F(DispatcherClientTest, DatasetsDoNotMatch) {
   TF_ASSERT_OK(SetUpTfDataService(/*num_workers=*/1));
   DataServiceMetadata metadata = GetDefaultMetadata();
@@ -609,6 +609,15 @@ Status DataServiceDispatcherImpl::GetOrRegisterDataset(
   DatasetDef dataset_def = request->dataset();
   GraphDef* graph = dataset_def.mutable_graph();
   PrepareGraph(graph);
+  // Fingerprints the graph outside of `mu_`: hashing dominates the cost of
+  // registration, and computing it here keeps simultaneous registrations from
+  // serializing on the dispatcher mutex.
+  uint64 fingerprint = 0;
+  Status hash_status = HashGraph(*graph, &fingerprint);
+  if (!hash_status.ok()) {
+    VLOG(2) << "Failed to fingerprint dataset graph: " << hash_status
+            << ". Proceeding without fingerprint-based dataset reuse.";
+  }
 
   mutex_lock l(mu_);
   TF_ASSIGN_OR_RETURN(std::optional<std::string> dataset_id,
@@ -619,15 +628,54 @@ Status DataServiceDispatcherImpl::GetOrRegisterDataset(
     response->set_dataset_id(*dataset_id);
     return absl::OkStatus();
   }
+  if (hash_status.ok() && request->dataset_id().empty()) {
+    TF_ASSIGN_OR_RETURN(
+        std::optional<std::string> matching_id,
+        FindDatasetByFingerprint(fingerprint, request->metadata()));
+    if (matching_id.has_value()) {
+      VLOG(3) << "RegisterDataset matches the fingerprint of existing dataset "
+              << "with ID = " << *matching_id;
+      response->set_dataset_id(*matching_id);
+      return absl::OkStatus();
+    }
+  }
 
   std::string new_dataset_id;
   TF_RETURN_IF_ERROR(RegisterDataset(dataset_def, request->metadata(),
                                      request->dataset_id(), new_dataset_id));
+  if (hash_status.ok()) {
+    datasets_by_fingerprint_.insert({fingerprint, new_dataset_id});
+  }
   response->set_dataset_id(new_dataset_id);
   VLOG(3) << "Registered new dataset with id " << new_dataset_id;
   return absl::OkStatus();
 }
 
+absl::StatusOr<std::optional<std::string>>
+DataServiceDispatcherImpl::FindDatasetByFingerprint(
+    uint64 fingerprint, const DataServiceMetadata& metadata)
+    TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+  auto it = datasets_by_fingerprint_.find(fingerprint);
+  if (it == datasets_by_fingerprint_.end()) {
+    return std::optional<std::string>();
+  }
+  std::shared_ptr<const Dataset> existing_dataset;
+  Status status = state_.DatasetFromId(it->second, existing_dataset);
+  if (errors::IsNotFound(status)) {
+    datasets_by_fingerprint_.erase(it);
+    return std::optional<std::string>();
+  }
+  TF_RETURN_IF_ERROR(status);
+  // Identical graphs registered with different metadata (e.g. a different
+  // compression setting) must not share a dataset.
+  if (!ValidateMatchingDataset(existing_dataset->dataset_id, metadata,
+                               existing_dataset->metadata)
+           .ok()) {
+    return std::optional<std::string>();
+  }
+  return std::optional<std::string>(existing_dataset->dataset_id);
+}
+
 absl::StatusOr<std::optional<std::string>>
 DataServiceDispatcherImpl::FindDataset(
     const GetOrRegisterDatasetRequest& request)
@@ -659,6 +707,7 @@ Status DataServiceDispatcherImpl::RegisterDataset(
   register_dataset->set_dataset_id(dataset_id);
   *register_dataset->mutable_metadata() = metadata;
   TF_RETURN_IF_ERROR(dataset_store_->Put(dataset_id, dataset));
+  dataset_def_cache_[dataset_id] = std::make_shared<const DatasetDef>(dataset);
   return Apply(update);
 }
 
@@ -1550,7 +1599,14 @@ Status DataServiceDispatcherImpl::GetDatasetDef(
 Status DataServiceDispatcherImpl::GetDatasetDef(
     const Dataset& dataset, std::shared_ptr<const DatasetDef>& dataset_def)
     TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-  return dataset_store_->Get(dataset.dataset_id, dataset_def);
+  auto it = dataset_def_cache_.find(dataset.dataset_id);
+  if (it != dataset_def_cache_.end()) {
+    dataset_def = it->second;
+    return absl::OkStatus();
+  }
+  TF_RETURN_IF_ERROR(dataset_store_->Get(dataset.dataset_id, dataset_def));
+  dataset_def_cache_[dataset.dataset_id] = dataset_def;
+  return absl::OkStatus();
 }
 
 DispatcherStateExport DataServiceDispatcherImpl::ExportState() const
@@ -219,6 +219,12 @@ class DataServiceDispatcherImpl {
   // Returns nullptr if no such dataset exists.
   absl::StatusOr<std::optional<std::string>> FindDataset(
       const GetOrRegisterDatasetRequest& request);
+  // Finds the ID of a registered dataset whose graph fingerprint matches
+  // `fingerprint` and whose metadata matches `metadata`. Returns an empty
+  // optional if no such dataset exists.
+  absl::StatusOr<std::optional<std::string>> FindDatasetByFingerprint(
+      uint64 fingerprint, const DataServiceMetadata& metadata)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   // Gets a worker's stub from `worker_stubs_`, or if none exists, creates a
   // stub and stores it in `worker_stubs_`. A borrowed pointer to the stub is
   // stored in `out_stub`.
@@ -363,6 +369,16 @@ class DataServiceDispatcherImpl {
       worker_stubs_ TF_GUARDED_BY(mu_);
   // Store of dataset definitions.
   std::unique_ptr<DatasetStore> dataset_store_ TF_GUARDED_BY(mu_);
+  // Maps fingerprints of registered dataset graphs to dataset IDs. Repeated
+  // registrations of byte-identical datasets are served from this map without
+  // re-storing the graph, so simultaneous job starts do not serialize on
+  // graph processing.
+  absl::flat_hash_map<uint64, std::string> datasets_by_fingerprint_
+      TF_GUARDED_BY(mu_);
+  // Caches dataset definitions by dataset ID so that creating split providers
+  // for new iterations does not re-read and re-parse the stored graph.
+  absl::flat_hash_map<std::string, std::shared_ptr<const DatasetDef>>
+      dataset_def_cache_ TF_GUARDED_BY(mu_);
   // Mapping from iteration id to the split providers for the iteration.
   absl::flat_hash_map<int64_t, std::vector<std::unique_ptr<SplitProvider>>>
       split_providers_ TF_GUARDED_BY(mu_);
@@ -0,0 +1,240 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/element_spill_queue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "tensorflow/core/data/compression_utils.h"
+#include "tensorflow/core/framework/dataset.pb.h"
+#include "tensorflow/core/lib/core/coding.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/statusor.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+// A spill record is `[uint64 body_len][int64 element_index][uint8
+// end_of_sequence][CompressedElement bytes]`, where `body_len` counts
+// everything after the length prefix.
+constexpr size_t kLengthPrefixBytes = sizeof(uint64_t);
+constexpr size_t kBodyHeaderBytes = sizeof(int64_t) + 1;
+
+}  // namespace
+
+ElementSpillQueue::ElementSpillQueue(const std::string& spill_file,
+                                     size_t max_memory_bytes,
+                                     size_t max_spill_bytes)
+    : spill_file_(spill_file),
+      max_memory_bytes_(max_memory_bytes),
+      max_spill_bytes_(max_spill_bytes) {
+  write_behind_thread_ = absl::WrapUnique(Env::Default()->StartThread(
+      /*thread_options=*/{}, /*name=*/"tf_data_service_spill_write_behind",
+      [this] { WriteBehindLoop(); }));
+}
+
+ElementSpillQueue::~ElementSpillQueue() {
+  Cancel(errors::Cancelled("The element spill queue is destroyed."));
+  // Joins the write-behind thread before touching the spill file.
+  write_behind_thread_.reset();
+  {
+    mutex_lock l(mu_);
+    read_file_.reset();
+  }
+  if (write_file_ != nullptr) {
+    write_file_->Close().IgnoreError();
+    write_file_.reset();
+    Env::Default()->DeleteFile(spill_file_).IgnoreError();
+  }
+}
+
+Status ElementSpillQueue::Push(GetElementResult&& element) {
+  const size_t element_bytes = element.EstimatedMemoryUsageBytes();
+  {
+    mutex_lock l(mu_);
+    while (status_.ok() &&
+           memory_bytes_ + element_bytes > max_memory_bytes_ &&
+           spill_bytes_ >= max_spill_bytes_) {
+      cv_.wait(l);
+    }
+    TF_RETURN_IF_ERROR(status_);
+    if (memory_bytes_ + element_bytes <= max_memory_bytes_) {
+      order_.push_back(Tier::kMemory);
+      memory_.push_back(std::move(element));
+      memory_bytes_ += element_bytes;
+      cv_.notify_all();
+      return absl::OkStatus();
+    }
+  }
+  // The memory tier is full: compress outside the lock and hand the record to
+  // the write-behind thread. There is a single producer, so the records are
+  // enqueued in element order.
+  std::string record;
+  TF_RETURN_IF_ERROR(SerializeElement(element, record));
+  mutex_lock l(mu_);
+  TF_RETURN_IF_ERROR(status_);
+  order_.push_back(Tier::kDisk);
+  spill_bytes_ += record.size();
+  pending_writes_.push_back(std::move(record));
+  cv_.notify_all();
+  return absl::OkStatus();
+}
+
+absl::StatusOr<GetElementResult> ElementSpillQueue::Pop() {
+  mutex_lock l(mu_);
+  while (true) {
+    TF_RETURN_IF_ERROR(status_);
+    if (!order_.empty()) {
+      if (order_.front() == Tier::kMemory) {
+        order_.pop_front();
+        GetElementResult element = std::move(memory_.front());
+        memory_.pop_front();
+        memory_bytes_ -= element.EstimatedMemoryUsageBytes();
+        cv_.notify_all();
+        return element;
+      }
+      if (spilled_ready_ > 0) {
+        order_.pop_front();
+        TF_ASSIGN_OR_RETURN(GetElementResult element, ReadSpilledElement());
+        cv_.notify_all();
+        return element;
+      }
+    }
+    cv_.wait(l);
+  }
+}
+
+bool ElementSpillQueue::Empty() const {
+  mutex_lock l(mu_);
+  return order_.empty();
+}
+
+void ElementSpillQueue::Cancel(Status status) {
+  DCHECK(!status.ok());
+  mutex_lock l(mu_);
+  if (status_.ok()) {
+    status_ = std::move(status);
+  }
+  cv_.notify_all();
+}
+
+Status ElementSpillQueue::SerializeElement(const GetElementResult& element,
+                                           std::string& record) {
+  std::string payload;
+  if (!element.end_of_sequence) {
+    CompressedElement compressed;
+    TF_RETURN_IF_ERROR(CompressElement(element.components, &compressed));
+    if (!compressed.SerializeToString(&payload)) {
+      return errors::Internal("Failed to serialize a spilled tf.data element.");
+    }
+  }
+  const uint64_t body_len = kBodyHeaderBytes + payload.size();
+  record.clear();
+  record.resize(kLengthPrefixBytes + kBodyHeaderBytes);
+  core::EncodeFixed64(&record[0], body_len);
+  core::EncodeFixed64(&record[kLengthPrefixBytes],
+                      static_cast<uint64_t>(element.element_index));
+  record[kLengthPrefixBytes + sizeof(int64_t)] =
+      element.end_of_sequence ? 1 : 0;
+  record.append(payload);
+  return absl::OkStatus();
+}
+
+absl::StatusOr<GetElementResult> ElementSpillQueue::ReadSpilledElement() {
+  if (read_file_ == nullptr) {
+    TF_RETURN_IF_ERROR(
+        Env::Default()->NewRandomAccessFile(spill_file_, &read_file_));
+  }
+  char length_buffer[kLengthPrefixBytes];
+  StringPiece length_piece;
+  TF_RETURN_IF_ERROR(read_file_->Read(read_offset_, kLengthPrefixBytes,
+                                      &length_piece, length_buffer));
+  const uint64_t body_len = core::DecodeFixed64(length_piece.data());
+  if (body_len < kBodyHeaderBytes) {
+    return errors::DataLoss("Corrupt spill record in file: ", spill_file_);
+  }
+  auto body = std::make_unique<char[]>(body_len);
+  StringPiece body_piece;
+  TF_RETURN_IF_ERROR(read_file_->Read(read_offset_ + kLengthPrefixBytes,
+                                      body_len, &body_piece, body.get()));
+  read_offset_ += kLengthPrefixBytes + body_len;
+  spill_bytes_ -= kLengthPrefixBytes + body_len;
+  --spilled_ready_;
+
+  GetElementResult element;
+  element.element_index =
+      static_cast<int64_t>(core::DecodeFixed64(body_piece.data()));
+  element.end_of_sequence = body_piece[sizeof(int64_t)] != 0;
+  element.skip = false;
+  if (!element.end_of_sequence) {
+    CompressedElement compressed;
+    if (!compressed.ParseFromArray(body_piece.data() + kBodyHeaderBytes,
+                                   body_len - kBodyHeaderBytes)) {
+      return errors::DataLoss("Unable to parse a spilled tf.data element from "
+                              "file: ",
+                              spill_file_);
+    }
+    TF_RETURN_IF_ERROR(UncompressElement(compressed, &element.components));
+  }
+  return element;
+}
+
+void ElementSpillQueue::WriteBehindLoop() {
+  while (true) {
+    std::string record;
+    {
+      mutex_lock l(mu_);
+      while (status_.ok() && pending_writes_.empty()) {
+        cv_.wait(l);
+      }
+      if (!status_.ok()) {
+        return;
+      }
+      record = std::move(pending_writes_.front());
+      pending_writes_.pop_front();
+    }
+    Status s;
+    if (write_file_ == nullptr) {
+      s = Env::Default()->NewWritableFile(spill_file_, &write_file_);
+    }
+    if (s.ok()) {
+      s = write_file_->Append(record);
+    }
+    if (s.ok()) {
+      s = write_file_->Flush();
+    }
+    mutex_lock l(mu_);
+    if (!s.ok()) {
+      if (status_.ok()) {
+        status_ = s;
+      }
+      cv_.notify_all();
+      return;
+    }
+    ++spilled_ready_;
+    cv_.notify_all();
+  }
+}
+
+}  // namespace data
+}  // namespace tensorflow
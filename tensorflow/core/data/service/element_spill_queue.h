@@ -0,0 +1,116 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_DATA_SERVICE_ELEMENT_SPILL_QUEUE_H_
+#define TENSORFLOW_CORE_DATA_SERVICE_ELEMENT_SPILL_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+namespace data {
+
+// A bounded FIFO queue of `GetElementResult`s with a local-disk overflow tier.
+// The newest elements are held in memory up to `max_memory_bytes`; once the
+// memory tier is full, a background write-behind thread compresses and appends
+// overflow elements to `spill_file`, up to `max_spill_bytes` of not yet
+// consumed spilled data. `Push` only blocks when both tiers are full, so the
+// queue can absorb multi-second consumer stalls without growing its memory
+// footprint. Elements are returned in the order they were pushed regardless of
+// the tier they landed in.
+//
+// `Push` must be called from a single producer thread. `Pop` may be called
+// concurrently from many consumer threads. The spill file is deleted when the
+// queue is destroyed.
+class ElementSpillQueue {
+ public:
+  ElementSpillQueue(const std::string& spill_file, size_t max_memory_bytes,
+                    size_t max_spill_bytes);
+  ~ElementSpillQueue();
+
+  // Appends an element, blocking while both the memory and the disk tiers are
+  // full. Returns the cancellation status if the queue is cancelled.
+  Status Push(GetElementResult&& element);
+
+  // Removes and returns the oldest element, blocking while the queue is empty.
+  // Returns the cancellation status if the queue is cancelled.
+  absl::StatusOr<GetElementResult> Pop();
+
+  // Returns true if the queue holds no elements in either tier.
+  bool Empty() const;
+
+  // Cancels the queue with `status`, waking all blocked callers. `status` must
+  // not be OK.
+  void Cancel(Status status);
+
+ private:
+  // The tier an element was pushed to, in element order.
+  enum class Tier : uint8_t { kMemory, kDisk };
+
+  // Serializes `element` into a spill record.
+  Status SerializeElement(const GetElementResult& element,
+                          std::string& record);
+
+  // Reads the next spill record from the spill file and parses it.
+  absl::StatusOr<GetElementResult> ReadSpilledElement()
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Body of the write-behind thread: appends pending spill records to the
+  // spill file and publishes them to consumers.
+  void WriteBehindLoop();
+
+  const std::string spill_file_;
+  const size_t max_memory_bytes_;
+  const size_t max_spill_bytes_;
+
+  mutable mutex mu_;
+  condition_variable cv_;
+  Status status_ TF_GUARDED_BY(mu_) = absl::OkStatus();
+  // Tier of each queued element, oldest first.
+  std::deque<Tier> order_ TF_GUARDED_BY(mu_);
+  // Memory-tier elements, oldest first.
+  std::deque<GetElementResult> memory_ TF_GUARDED_BY(mu_);
+  size_t memory_bytes_ TF_GUARDED_BY(mu_) = 0;
+  // Serialized records waiting for the write-behind thread.
+  std::deque<std::string> pending_writes_ TF_GUARDED_BY(mu_);
+  // Bytes of spilled data not yet consumed, including pending writes.
+  size_t spill_bytes_ TF_GUARDED_BY(mu_) = 0;
+  // The number of spilled records flushed to disk and not yet read.
+  int64_t spilled_ready_ TF_GUARDED_BY(mu_) = 0;
+  uint64_t read_offset_ TF_GUARDED_BY(mu_) = 0;
+
+  // Write side of the spill file, used only by the write-behind thread.
+  std::unique_ptr<WritableFile> write_file_;
+  // Read side of the spill file, opened lazily on the first spilled read.
+  std::unique_ptr<RandomAccessFile> read_file_ TF_GUARDED_BY(mu_);
+  std::unique_ptr<Thread> write_behind_thread_;
+
+  ElementSpillQueue(const ElementSpillQueue&) = delete;
+  void operator=(const ElementSpillQueue&) = delete;
+};
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DATA_SERVICE_ELEMENT_SPILL_QUEUE_H_
@@ -0,0 +1,95 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/element_spill_queue.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/status_matchers.h"
+#include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+using ::tensorflow::testing::StatusIs;
+
+GetElementResult MakeElement(int64_t index) {
+  GetElementResult result;
+  result.components.push_back(test::AsTensor<int64_t>({index, index + 1}));
+  result.element_index = index;
+  result.end_of_sequence = false;
+  result.skip = false;
+  return result;
+}
+
+std::string SpillFile() {
+  std::string filename;
+  EXPECT_TRUE(Env::Default()->LocalTempFilename(&filename));
+  return filename;
+}
+
+TEST(ElementSpillQueueTest, FifoAcrossTiers) {
+  // A tiny memory budget forces most elements through the disk tier.
+  ElementSpillQueue queue(SpillFile(), /*max_memory_bytes=*/64,
+                          /*max_spill_bytes=*/10 << 20);
+  constexpr int64_t kNumElements = 100;
+  for (int64_t i = 0; i < kNumElements; ++i) {
+    TF_ASSERT_OK(queue.Push(MakeElement(i)));
+  }
+  for (int64_t i = 0; i < kNumElements; ++i) {
+    TF_ASSERT_OK_AND_ASSIGN(GetElementResult result, queue.Pop());
+    EXPECT_EQ(result.element_index, i);
+    EXPECT_FALSE(result.end_of_sequence);
+    ASSERT_EQ(result.components.size(), 1);
+    test::ExpectEqual(result.components[0],
+                      test::AsTensor<int64_t>({i, i + 1}));
+  }
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(ElementSpillQueueTest, EndOfSequenceRoundTrip) {
+  ElementSpillQueue queue(SpillFile(), /*max_memory_bytes=*/0,
+                          /*max_spill_bytes=*/10 << 20);
+  GetElementResult eos;
+  eos.end_of_sequence = true;
+  eos.element_index = 5;
+  TF_ASSERT_OK(queue.Push(std::move(eos)));
+  TF_ASSERT_OK_AND_ASSIGN(GetElementResult result, queue.Pop());
+  EXPECT_TRUE(result.end_of_sequence);
+  EXPECT_EQ(result.element_index, 5);
+  EXPECT_TRUE(result.components.empty());
+}
+
+TEST(ElementSpillQueueTest, CancelWakesBlockedPop) {
+  ElementSpillQueue queue(SpillFile(), /*max_memory_bytes=*/64,
+                          /*max_spill_bytes=*/10 << 20);
+  queue.Cancel(errors::Cancelled("Cancelled"));
+  EXPECT_THAT(queue.Pop(), StatusIs(error::CANCELLED));
+  EXPECT_THAT(queue.Push(MakeElement(0)), StatusIs(error::CANCELLED));
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
@@ -0,0 +1,677 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/shm_transfer.h"
+
+#if !defined(PLATFORM_WINDOWS)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/data/service/worker.pb.h"
+#include "tensorflow/core/framework/metrics.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/random/random.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/host_info.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/strcat.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/protobuf/service_config.pb.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+// Initial size of the per-connection shared memory segment. The segment grows
+// geometrically when an element does not fit.
+constexpr uint64_t kInitialShmBytes = 1 << 20;
+
+// Component serialization kinds used in the shared memory payload.
+constexpr int32_t kRawComponent = 0;
+constexpr int32_t kProtoComponent = 1;
+
+std::string SocketPath(int id) {
+  return strings::StrCat("/tmp/tf_data_shm_", id, ".sock");
+}
+
+std::string ShmName(int id, int64_t connection) {
+  return strings::StrCat("/tf_data_shm_", id, "_", connection);
+}
+
+// Reads exactly `n` bytes from `fd` into `data`.
+Status ReadFull(int fd, char* data, size_t n) {
+  while (n > 0) {
+    ssize_t r = read(fd, data, n);
+    if (r == 0) {
+      return errors::Cancelled("Shared memory transfer connection closed.");
+    }
+    if (r < 0) {
+      if (errno == EINTR) continue;
+      return errors::Internal("Failed to read from shared memory transfer ",
+                              "control socket: ", strerror(errno));
+    }
+    data += r;
+    n -= r;
+  }
+  return absl::OkStatus();
+}
+
+// Writes exactly `n` bytes from `data` to `fd`.
+Status WriteFull(int fd, const char* data, size_t n) {
+  while (n > 0) {
+    ssize_t r = write(fd, data, n);
+    if (r < 0) {
+      if (errno == EINTR) continue;
+      return errors::Internal("Failed to write to shared memory transfer ",
+                              "control socket: ", strerror(errno));
+    }
+    data += r;
+    n -= r;
+  }
+  return absl::OkStatus();
+}
+
+template <typename T>
+Status ReadPod(int fd, T* value) {
+  return ReadFull(fd, reinterpret_cast<char*>(value), sizeof(T));
+}
+
+template <typename T>
+Status WritePod(int fd, T value) {
+  return WriteFull(fd, reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Returns the number of bytes needed to serialize `result` into shared
+// memory. For memcpy-able dtypes the tensor buffer is copied verbatim; other
+// dtypes (e.g. strings and variants, including compressed elements) fall back
+// to `TensorProto`.
+uint64_t PayloadBytes(const GetElementResult& result,
+                      std::vector<TensorProto>& fallback_protos) {
+  uint64_t bytes = 2 * sizeof(uint8_t) + sizeof(int64_t) + sizeof(uint64_t);
+  for (const Tensor& component : result.components) {
+    bytes += sizeof(int32_t);
+    if (DataTypeCanUseMemcpy(component.dtype())) {
+      bytes += sizeof(int32_t) + sizeof(uint64_t) +
+               component.dims() * sizeof(int64_t) + sizeof(uint64_t) +
+               component.tensor_data().size();
+    } else {
+      fallback_protos.emplace_back();
+      component.AsProtoTensorContent(&fallback_protos.back());
+      bytes += sizeof(uint64_t) + fallback_protos.back().ByteSizeLong();
+    }
+  }
+  return bytes;
+}
+
+// Cursor for writing POD values and byte ranges into a shared memory segment.
+class ShmWriter {
+ public:
+  explicit ShmWriter(char* data) : data_(data) {}
+
+  template <typename T>
+  void Write(T value) {
+    memcpy(data_ + offset_, &value, sizeof(T));
+    offset_ += sizeof(T);
+  }
+
+  void WriteBytes(const char* bytes, uint64_t n) {
+    memcpy(data_ + offset_, bytes, n);
+    offset_ += n;
+  }
+
+  char* Position() { return data_ + offset_; }
+
+  void Advance(uint64_t n) { offset_ += n; }
+
+  uint64_t offset() const { return offset_; }
+
+ private:
+  char* const data_;
+  uint64_t offset_ = 0;
+};
+
+// Cursor for reading POD values and byte ranges from a shared memory segment,
+// with bounds checking.
+class ShmReader {
+ public:
+  ShmReader(const char* data, uint64_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  Status Read(T* value) {
+    TF_RETURN_IF_ERROR(Check(sizeof(T)));
+    memcpy(value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return absl::OkStatus();
+  }
+
+  Status ReadBytes(uint64_t n, const char** bytes) {
+    TF_RETURN_IF_ERROR(Check(n));
+    *bytes = data_ + offset_;
+    offset_ += n;
+    return absl::OkStatus();
+  }
+
+ private:
+  Status Check(uint64_t n) const {
+    if (offset_ + n > size_) {
+      return errors::Internal(
+          "Malformed shared memory transfer payload: expected ", n,
+          " bytes at offset ", offset_, " in a payload of ", size_, " bytes.");
+    }
+    return absl::OkStatus();
+  }
+
+  const char* const data_;
+  const uint64_t size_;
+  uint64_t offset_ = 0;
+};
+
+// Serializes `result` into `data`, which must be able to hold the number of
+// bytes previously returned by `PayloadBytes`.
+void SerializeResult(const GetElementResult& result,
+                     const std::vector<TensorProto>& fallback_protos,
+                     char* data) {
+  ShmWriter writer(data);
+  writer.Write<uint8_t>(result.end_of_sequence ? 1 : 0);
+  writer.Write<uint8_t>(result.skip ? 1 : 0);
+  writer.Write<int64_t>(result.element_index);
+  writer.Write<uint64_t>(result.components.size());
+  size_t next_fallback = 0;
+  for (const Tensor& component : result.components) {
+    if (DataTypeCanUseMemcpy(component.dtype())) {
+      writer.Write<int32_t>(kRawComponent);
+      writer.Write<int32_t>(static_cast<int32_t>(component.dtype()));
+      writer.Write<uint64_t>(component.dims());
+      for (int d = 0; d < component.dims(); ++d) {
+        writer.Write<int64_t>(component.dim_size(d));
+      }
+      absl::string_view buffer = component.tensor_data();
+      writer.Write<uint64_t>(buffer.size());
+      writer.WriteBytes(buffer.data(), buffer.size());
+    } else {
+      const TensorProto& proto = fallback_protos[next_fallback++];
+      writer.Write<int32_t>(kProtoComponent);
+      uint64_t proto_bytes = proto.ByteSizeLong();
+      writer.Write<uint64_t>(proto_bytes);
+      proto.SerializeToArray(writer.Position(), proto_bytes);
+      writer.Advance(proto_bytes);
+    }
+  }
+}
+
+// Deserializes a `GetElementResult` from the first `size` bytes of `data`.
+Status ParseResult(const char* data, uint64_t size, GetElementResult& result) {
+  ShmReader reader(data, size);
+  uint8_t end_of_sequence, skip;
+  TF_RETURN_IF_ERROR(reader.Read(&end_of_sequence));
+  TF_RETURN_IF_ERROR(reader.Read(&skip));
+  result.end_of_sequence = end_of_sequence != 0;
+  result.skip = skip != 0;
+  TF_RETURN_IF_ERROR(reader.Read(&result.element_index));
+  uint64_t num_components;
+  TF_RETURN_IF_ERROR(reader.Read(&num_components));
+  for (uint64_t i = 0; i < num_components; ++i) {
+    int32_t kind;
+    TF_RETURN_IF_ERROR(reader.Read(&kind));
+    if (kind == kRawComponent) {
+      int32_t dtype;
+      uint64_t ndims;
+      TF_RETURN_IF_ERROR(reader.Read(&dtype));
+      TF_RETURN_IF_ERROR(reader.Read(&ndims));
+      TensorShape shape;
+      for (uint64_t d = 0; d < ndims; ++d) {
+        int64_t dim_size;
+        TF_RETURN_IF_ERROR(reader.Read(&dim_size));
+        TF_RETURN_IF_ERROR(shape.AddDimWithStatus(dim_size));
+      }
+      uint64_t num_bytes;
+      TF_RETURN_IF_ERROR(reader.Read(&num_bytes));
+      const char* bytes;
+      TF_RETURN_IF_ERROR(reader.ReadBytes(num_bytes, &bytes));
+      Tensor tensor(static_cast<DataType>(dtype), shape);
+      if (tensor.tensor_data().size() != num_bytes) {
+        return errors::Internal(
+            "Malformed shared memory transfer payload: tensor of type ",
+            DataTypeString(static_cast<DataType>(dtype)), " and shape ",
+            shape.DebugString(), " requires ", tensor.tensor_data().size(),
+            " bytes, but the payload holds ", num_bytes, " bytes.");
+      }
+      memcpy(tensor.data(), bytes, num_bytes);
+      result.components.push_back(std::move(tensor));
+    } else if (kind == kProtoComponent) {
+      uint64_t proto_bytes;
+      TF_RETURN_IF_ERROR(reader.Read(&proto_bytes));
+      const char* bytes;
+      TF_RETURN_IF_ERROR(reader.ReadBytes(proto_bytes, &bytes));
+      TensorProto proto;
+      if (!proto.ParseFromArray(bytes, proto_bytes)) {
+        return errors::Internal("Failed to parse tensor proto from shared ",
+                                "memory transfer payload.");
+      }
+      result.components.emplace_back();
+      if (!result.components.back().FromProto(proto)) {
+        return errors::Internal("Failed to parse tensor.");
+      }
+    } else {
+      return errors::Internal(
+          "Malformed shared memory transfer payload: unknown component kind ",
+          kind, ".");
+    }
+  }
+  return absl::OkStatus();
+}
+
+// A data transfer server that serves element payloads through per-connection
+// POSIX shared memory segments. Requests and responses are exchanged over a
+// Unix domain socket; element contents never pass through the socket.
+class ShmTransferServer : public DataTransferServer {
+ public:
+  explicit ShmTransferServer(GetElementT get_element)
+      : get_element_(std::move(get_element)),
+        id_(static_cast<int>(random::New64() & 0x7fffffff)) {}
+
+  ~ShmTransferServer() override {
+    {
+      mutex_lock l(mu_);
+      stopped_ = true;
+      for (int fd : connection_fds_) {
+        shutdown(fd, SHUT_RDWR);
+      }
+    }
+    if (listen_fd_ >= 0) {
+      shutdown(listen_fd_, SHUT_RDWR);
+    }
+    accept_thread_.reset();
+    {
+      mutex_lock l(mu_);
+      connection_threads_.clear();
+    }
+    if (listen_fd_ >= 0) {
+      close(listen_fd_);
+      unlink(SocketPath(id_).c_str());
+    }
+  }
+
+  Status Start(const experimental::WorkerConfig& config) override {
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+      return errors::Internal("Failed to create shared memory transfer ",
+                              "socket: ", strerror(errno));
+    }
+    const std::string path = SocketPath(id_);
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+      return errors::Internal("Shared memory transfer socket path too long: ",
+                              path);
+    }
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(path.c_str());
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) <
+        0) {
+      return errors::Internal("Failed to bind shared memory transfer socket ",
+                              path, ": ", strerror(errno));
+    }
+    if (listen(listen_fd_, SOMAXCONN) < 0) {
+      return errors::Internal("Failed to listen on shared memory transfer ",
+                              "socket ", path, ": ", strerror(errno));
+    }
+    accept_thread_.reset(env_->StartThread(
+        {}, "shm_transfer_accept", [this]() { AcceptLoop(); }));
+    return absl::OkStatus();
+  }
+
+  // The returned value is not a TCP port; it identifies the Unix domain
+  // socket at which the server accepts connections. The client recovers the
+  // socket path from the port component of the transfer server address.
+  int Port() const override { return id_; }
+
+  absl::StatusOr<std::string> GetCompatibilityInfo() const override {
+    return port::Hostname();
+  }
+
+ private:
+  void AcceptLoop() {
+    while (true) {
+      int fd = accept(listen_fd_, nullptr, nullptr);
+      if (fd < 0) {
+        if (errno == EINTR) continue;
+        return;
+      }
+      int64_t connection;
+      {
+        mutex_lock l(mu_);
+        if (stopped_) {
+          close(fd);
+          return;
+        }
+        connection = next_connection_++;
+        connection_fds_.push_back(fd);
+      }
+      std::unique_ptr<Thread> thread(env_->StartThread(
+          {}, strings::StrCat("shm_transfer_connection_", connection),
+          [this, fd, connection]() { HandleConnection(fd, connection); }));
+      mutex_lock l(mu_);
+      connection_threads_.push_back(std::move(thread));
+    }
+  }
+
+  void HandleConnection(int fd, int64_t connection) {
+    const std::string shm_name = ShmName(id_, connection);
+    char* shm_data = nullptr;
+    uint64_t shm_bytes = 0;
+    int shm_fd = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    Status s;
+    if (shm_fd < 0) {
+      s = errors::Internal("Failed to create shared memory segment ", shm_name,
+                           ": ", strerror(errno));
+    } else {
+      s = Resize(shm_fd, kInitialShmBytes, &shm_data, &shm_bytes);
+    }
+    // Handshake: tell the client which segment to map and how large it is.
+    if (s.ok()) {
+      s = WritePod<uint64_t>(fd, shm_name.size());
+      if (s.ok()) s = WriteFull(fd, shm_name.data(), shm_name.size());
+      if (s.ok()) s = WritePod<uint64_t>(fd, shm_bytes);
+    }
+    while (s.ok()) {
+      s = ServeRequest(fd, shm_fd, &shm_data, &shm_bytes);
+    }
+    if (!errors::IsCancelled(s)) {
+      VLOG(1) << "Shared memory transfer connection " << connection
+              << " closed: " << s;
+    }
+    if (shm_data != nullptr) {
+      munmap(shm_data, shm_bytes);
+    }
+    if (shm_fd >= 0) {
+      close(shm_fd);
+      shm_unlink(shm_name.c_str());
+    }
+    close(fd);
+  }
+
+  // Serves one `GetElement` request on `fd`, growing the shared memory
+  // segment if the element does not fit.
+  Status ServeRequest(int fd, int shm_fd, char** shm_data,
+                      uint64_t* shm_bytes) {
+    uint64_t request_bytes;
+    TF_RETURN_IF_ERROR(ReadPod(fd, &request_bytes));
+    std::string request_buffer(request_bytes, '\0');
+    TF_RETURN_IF_ERROR(ReadFull(fd, &request_buffer[0], request_bytes));
+    GetElementRequest request;
+    if (!request.ParseFromString(request_buffer)) {
+      return errors::Internal("Failed to parse GetElementRequest from shared ",
+                              "memory transfer control socket.");
+    }
+    GetElementResult result;
+    Status element_status = get_element_(&request, &result);
+    uint64_t payload_bytes = 0;
+    if (element_status.ok()) {
+      std::vector<TensorProto> fallback_protos;
+      payload_bytes = PayloadBytes(result, fallback_protos);
+      if (payload_bytes > *shm_bytes) {
+        uint64_t new_bytes = *shm_bytes;
+        while (new_bytes < payload_bytes) new_bytes *= 2;
+        munmap(*shm_data, *shm_bytes);
+        *shm_data = nullptr;
+        TF_RETURN_IF_ERROR(Resize(shm_fd, new_bytes, shm_data, shm_bytes));
+      }
+      SerializeResult(result, fallback_protos, *shm_data);
+    }
+    TF_RETURN_IF_ERROR(
+        WritePod<int32_t>(fd, static_cast<int32_t>(element_status.code())));
+    absl::string_view message = element_status.message();
+    TF_RETURN_IF_ERROR(WritePod<uint64_t>(fd, message.size()));
+    TF_RETURN_IF_ERROR(WriteFull(fd, message.data(), message.size()));
+    TF_RETURN_IF_ERROR(WritePod<uint64_t>(fd, *shm_bytes));
+    return WritePod<uint64_t>(fd, payload_bytes);
+  }
+
+  static Status Resize(int shm_fd, uint64_t new_bytes, char** shm_data,
+                       uint64_t* shm_bytes) {
+    if (ftruncate(shm_fd, new_bytes) < 0) {
+      return errors::Internal("Failed to resize shared memory segment to ",
+                              new_bytes, " bytes: ", strerror(errno));
+    }
+    void* data = mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      shm_fd, 0);
+    if (data == MAP_FAILED) {
+      return errors::Internal("Failed to map shared memory segment: ",
+                              strerror(errno));
+    }
+    *shm_data = static_cast<char*>(data);
+    *shm_bytes = new_bytes;
+    return absl::OkStatus();
+  }
+
+  const GetElementT get_element_;
+  const int id_;
+  int listen_fd_ = -1;
+
+  mutex mu_;
+  bool stopped_ TF_GUARDED_BY(mu_) = false;
+  int64_t next_connection_ TF_GUARDED_BY(mu_) = 0;
+  std::vector<int> connection_fds_ TF_GUARDED_BY(mu_);
+  std::vector<std::unique_ptr<Thread>> connection_threads_ TF_GUARDED_BY(mu_);
+  // Must be ordered after `mu_` members so that `AcceptLoop` can be joined
+  // while they are still valid.
+  std::unique_ptr<Thread> accept_thread_;
+};
+
+// The client side of `ShmTransferServer`. Calls are serialized; each task
+// reads from its worker through a dedicated client.
+class ShmTransferClient : public DataTransferClient {
+ public:
+  ~ShmTransferClient() override {
+    mutex_lock l(mu_);
+    if (shm_data_ != nullptr) {
+      munmap(shm_data_, shm_bytes_);
+    }
+    if (shm_fd_ >= 0) {
+      close(shm_fd_);
+    }
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  static Status Create(const Config& config,
+                       std::unique_ptr<DataTransferClient>* out) {
+    size_t colon = config.address.rfind(':');
+    int id;
+    if (colon == std::string::npos ||
+        !absl::SimpleAtoi(config.address.substr(colon + 1), &id)) {
+      return errors::InvalidArgument(
+          "Failed to parse shared memory transfer server id from address '",
+          config.address, "'.");
+    }
+    auto client = absl::WrapUnique(new ShmTransferClient());
+    TF_RETURN_IF_ERROR(client->Connect(id));
+    *out = std::move(client);
+    return absl::OkStatus();
+  }
+
+  Status GetElement(const GetElementRequest& req,
+                    GetElementResult& result) override {
+    mutex_lock l(mu_);
+    if (cancelled_) {
+      return errors::Cancelled("Client was cancelled.");
+    }
+    int64_t start_time_us = env_->NowMicros();
+    std::string request_buffer;
+    if (!req.SerializeToString(&request_buffer)) {
+      return errors::Internal("Failed to serialize GetElementRequest.");
+    }
+    TF_RETURN_IF_ERROR(WritePod<uint64_t>(fd_, request_buffer.size()));
+    TF_RETURN_IF_ERROR(
+        WriteFull(fd_, request_buffer.data(), request_buffer.size()));
+    int32_t code;
+    TF_RETURN_IF_ERROR(ReadPod(fd_, &code));
+    uint64_t message_bytes;
+    TF_RETURN_IF_ERROR(ReadPod(fd_, &message_bytes));
+    std::string message(message_bytes, '\0');
+    if (message_bytes > 0) {
+      TF_RETURN_IF_ERROR(ReadFull(fd_, &message[0], message_bytes));
+    }
+    uint64_t shm_bytes, payload_bytes;
+    TF_RETURN_IF_ERROR(ReadPod(fd_, &shm_bytes));
+    TF_RETURN_IF_ERROR(ReadPod(fd_, &payload_bytes));
+    if (shm_bytes != shm_bytes_) {
+      TF_RETURN_IF_ERROR(Remap(shm_bytes));
+    }
+    if (code != 0) {
+      return Status(static_cast<absl::StatusCode>(code), message);
+    }
+    TF_RETURN_IF_ERROR(ParseResult(shm_data_, payload_bytes, result));
+    metrics::RecordTFDataServiceGetElementDuration(
+        kShmTransferProtocol, env_->NowMicros() - start_time_us);
+    return absl::OkStatus();
+  }
+
+  void TryCancel() override {
+    VLOG(2) << "Cancel ShmTransferClient.";
+    // Shut down the control socket to unblock any in-flight request.
+    cancelled_ = true;
+    shutdown(fd_, SHUT_RDWR);
+  }
+
+  Status CheckCompatibility(
+      const std::string& server_compatibility_info) const override {
+    if (server_compatibility_info != port::Hostname()) {
+      return errors::FailedPrecondition(
+          "The '", kShmTransferProtocol, "' data transfer protocol requires ",
+          "the worker and the trainer to run on the same host, but the ",
+          "worker runs on '", server_compatibility_info,
+          "' and the trainer on '", port::Hostname(), "'.");
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  ShmTransferClient() = default;
+
+  Status Connect(int id) {
+    fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd_ < 0) {
+      return errors::Internal("Failed to create shared memory transfer ",
+                              "socket: ", strerror(errno));
+    }
+    const std::string path = SocketPath(id);
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+      return errors::Internal("Shared memory transfer socket path too long: ",
+                              path);
+    }
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+      return errors::Unavailable("Failed to connect to shared memory ",
+                                 "transfer server at ", path, ": ",
+                                 strerror(errno));
+    }
+    uint64_t name_bytes;
+    TF_RETURN_IF_ERROR(ReadPod(fd_, &name_bytes));
+    std::string shm_name(name_bytes, '\0');
+    TF_RETURN_IF_ERROR(ReadFull(fd_, &shm_name[0], name_bytes));
+    uint64_t shm_bytes;
+    TF_RETURN_IF_ERROR(ReadPod(fd_, &shm_bytes));
+    shm_fd_ = shm_open(shm_name.c_str(), O_RDWR, 0600);
+    if (shm_fd_ < 0) {
+      return errors::Internal("Failed to open shared memory segment ",
+                              shm_name, ": ", strerror(errno));
+    }
+    mutex_lock l(mu_);
+    return Remap(shm_bytes);
+  }
+
+  Status Remap(uint64_t shm_bytes) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    if (shm_data_ != nullptr) {
+      munmap(shm_data_, shm_bytes_);
+      shm_data_ = nullptr;
+    }
+    void* data =
+        mmap(nullptr, shm_bytes, PROT_READ, MAP_SHARED, shm_fd_, 0);
+    if (data == MAP_FAILED) {
+      return errors::Internal("Failed to map shared memory segment: ",
+                              strerror(errno));
+    }
+    shm_data_ = static_cast<char*>(data);
+    shm_bytes_ = shm_bytes;
+    return absl::OkStatus();
+  }
+
+  mutex mu_;
+  int fd_ = -1;
+  int shm_fd_ = -1;
+  char* shm_data_ TF_GUARDED_BY(mu_) = nullptr;
+  uint64_t shm_bytes_ TF_GUARDED_BY(mu_) = 0;
+  std::atomic<bool> cancelled_{false};
+};
+
+class ShmTransferServerRegistrar {
+ public:
+  ShmTransferServerRegistrar() {
+    DataTransferServer::Register(
+        kShmTransferProtocol,
+        [](DataTransferServer::GetElementT get_element,
+           std::shared_ptr<DataTransferServer>* out) {
+          *out = std::make_shared<ShmTransferServer>(std::move(get_element));
+          return absl::OkStatus();
+        });
+  }
+};
+static ShmTransferServerRegistrar shm_server_registrar;
+
+class ShmTransferClientRegistrar {
+ public:
+  ShmTransferClientRegistrar() {
+    DataTransferClient::Register(
+        kShmTransferProtocol, [](DataTransferClient::Config config,
+                                 std::unique_ptr<DataTransferClient>* out) {
+          return ShmTransferClient::Create(config, out);
+        });
+  }
+};
+static ShmTransferClientRegistrar shm_client_registrar;
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // !defined(PLATFORM_WINDOWS)
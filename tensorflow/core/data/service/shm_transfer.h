@@ -0,0 +1,36 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_DATA_SERVICE_SHM_TRANSFER_H_
+#define TENSORFLOW_CORE_DATA_SERVICE_SHM_TRANSFER_H_
+
+namespace tensorflow {
+namespace data {
+
+// Name of the shared-memory data transfer implementation. It moves element
+// payloads between a tf.data service worker and a same-host trainer through a
+// POSIX shared memory segment, using a Unix domain socket only for small
+// control messages. This avoids protobuf serialization of tensor contents and
+// the loopback network stack. The implementation is registered through the
+// `DataTransferServer`/`DataTransferClient` factories and negotiated via the
+// `data_transfer_protocol` plumbing; the compatibility check rejects pairings
+// that do not run on the same host, in which case the client falls back to
+// gRPC.
+constexpr const char kShmTransferProtocol[] = "shm";
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DATA_SERVICE_SHM_TRANSFER_H_
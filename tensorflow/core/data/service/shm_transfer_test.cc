@@ -0,0 +1,228 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/shm_transfer.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/data/service/worker.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/platform.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/strcat.h"
+#include "tensorflow/core/platform/test.h"
+
+#if !defined(PLATFORM_WINDOWS)
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+// Round-trips results through the registered "shm" server and client over a
+// real Unix domain socket and shared memory segment, so the tests cover the
+// wire framing, the payload serialization and the bounds-checked parsing.
+class ShmTransferTest : public ::testing::Test {
+ protected:
+  Status StartServerAndClient(DataTransferServer::GetElementT get_element) {
+    TF_RETURN_IF_ERROR(DataTransferServer::Build(
+        kShmTransferProtocol, std::move(get_element), &server_));
+    TF_RETURN_IF_ERROR(server_->Start(/*config=*/{}));
+    DataTransferClient::Config config;
+    config.protocol = kShmTransferProtocol;
+    config.address = strings::StrCat("localhost:", server_->Port());
+    config.accelerator_device_info = nullptr;
+    config.allocator = nullptr;
+    return DataTransferClient::Build(kShmTransferProtocol, config, &client_);
+  }
+
+  // Declared before `client_` so the client closes its connection before the
+  // server joins its connection threads.
+  std::shared_ptr<DataTransferServer> server_;
+  std::unique_ptr<DataTransferClient> client_;
+};
+
+// Serves a fixed sequence of results, one per request.
+DataTransferServer::GetElementT ServeResults(
+    std::shared_ptr<std::vector<GetElementResult>> results) {
+  auto next = std::make_shared<size_t>(0);
+  return [results, next](const GetElementRequest* request,
+                         GetElementResult* result) {
+    if (*next >= results->size()) {
+      return errors::OutOfRange("Requested element ", *next, " but only ",
+                                results->size(), " were provided.");
+    }
+    *result = std::move((*results)[(*next)++]);
+    return absl::OkStatus();
+  };
+}
+
+TEST_F(ShmTransferTest, RoundTripsMemcpyDtypes) {
+  Tensor int_tensor(DT_INT64, TensorShape({2, 3}));
+  test::FillIota<int64_t>(&int_tensor, 1);
+  Tensor float_tensor(DT_FLOAT, TensorShape({4}));
+  test::FillIota<float>(&float_tensor, 0.5);
+  auto results = std::make_shared<std::vector<GetElementResult>>();
+  results->emplace_back();
+  results->back().components.push_back(int_tensor);
+  results->back().components.push_back(float_tensor);
+  results->back().element_index = 7;
+  TF_ASSERT_OK(StartServerAndClient(ServeResults(results)));
+
+  GetElementResult result;
+  TF_ASSERT_OK(client_->GetElement(GetElementRequest(), result));
+  ASSERT_EQ(result.components.size(), 2);
+  test::ExpectEqual(result.components[0], int_tensor);
+  test::ExpectEqual(result.components[1], float_tensor);
+  EXPECT_EQ(result.element_index, 7);
+  EXPECT_FALSE(result.end_of_sequence);
+  EXPECT_FALSE(result.skip);
+}
+
+TEST_F(ShmTransferTest, RoundTripsStringsThroughProtoFallback) {
+  Tensor string_tensor(DT_STRING, TensorShape({3}));
+  string_tensor.flat<tstring>()(0) = "hello";
+  string_tensor.flat<tstring>()(1) = "";
+  string_tensor.flat<tstring>()(2) = std::string(1000, 'x');
+  auto results = std::make_shared<std::vector<GetElementResult>>();
+  results->emplace_back();
+  results->back().components.push_back(string_tensor);
+  TF_ASSERT_OK(StartServerAndClient(ServeResults(results)));
+
+  GetElementResult result;
+  TF_ASSERT_OK(client_->GetElement(GetElementRequest(), result));
+  ASSERT_EQ(result.components.size(), 1);
+  test::ExpectEqual(result.components[0], string_tensor);
+}
+
+TEST_F(ShmTransferTest, RoundTripsEmptyComponentsAndFlags) {
+  auto results = std::make_shared<std::vector<GetElementResult>>();
+  // A tensor with zero elements, a skipped element, and end of sequence.
+  results->emplace_back();
+  results->back().components.push_back(
+      Tensor(DT_INT32, TensorShape({0, 5})));
+  results->emplace_back();
+  results->back().skip = true;
+  results->back().element_index = 3;
+  results->emplace_back();
+  results->back().end_of_sequence = true;
+  TF_ASSERT_OK(StartServerAndClient(ServeResults(results)));
+
+  GetElementResult result;
+  TF_ASSERT_OK(client_->GetElement(GetElementRequest(), result));
+  ASSERT_EQ(result.components.size(), 1);
+  EXPECT_EQ(result.components[0].shape(), TensorShape({0, 5}));
+
+  result = GetElementResult();
+  TF_ASSERT_OK(client_->GetElement(GetElementRequest(), result));
+  EXPECT_TRUE(result.skip);
+  EXPECT_EQ(result.element_index, 3);
+
+  result = GetElementResult();
+  TF_ASSERT_OK(client_->GetElement(GetElementRequest(), result));
+  EXPECT_TRUE(result.end_of_sequence);
+  EXPECT_TRUE(result.components.empty());
+}
+
+TEST_F(ShmTransferTest, GrowsSegmentForLargeElements) {
+  // Larger than the initial 1 MiB segment, so the server must grow it and
+  // the client must remap before parsing.
+  Tensor large_tensor(DT_INT64, TensorShape({1 << 18, 4}));
+  test::FillIota<int64_t>(&large_tensor, 0);
+  Tensor small_tensor(DT_INT32, TensorShape({2}));
+  test::FillIota<int32>(&small_tensor, 1);
+  auto results = std::make_shared<std::vector<GetElementResult>>();
+  results->emplace_back();
+  results->back().components.push_back(large_tensor);
+  results->emplace_back();
+  results->back().components.push_back(small_tensor);
+  TF_ASSERT_OK(StartServerAndClient(ServeResults(results)));
+
+  GetElementResult result;
+  TF_ASSERT_OK(client_->GetElement(GetElementRequest(), result));
+  ASSERT_EQ(result.components.size(), 1);
+  test::ExpectEqual(result.components[0], large_tensor);
+
+  // The connection stays usable with the grown segment.
+  result = GetElementResult();
+  TF_ASSERT_OK(client_->GetElement(GetElementRequest(), result));
+  ASSERT_EQ(result.components.size(), 1);
+  test::ExpectEqual(result.components[0], small_tensor);
+}
+
+TEST_F(ShmTransferTest, PropagatesElementErrors) {
+  auto calls = std::make_shared<int>(0);
+  TF_ASSERT_OK(StartServerAndClient(
+      [calls](const GetElementRequest* request, GetElementResult* result) {
+        if ((*calls)++ == 0) {
+          return errors::NotFound("no such task");
+        }
+        result->end_of_sequence = true;
+        return absl::OkStatus();
+      }));
+
+  GetElementResult result;
+  Status s = client_->GetElement(GetElementRequest(), result);
+  EXPECT_TRUE(errors::IsNotFound(s));
+  EXPECT_EQ(s.message(), "no such task");
+
+  // The connection survives element errors.
+  TF_ASSERT_OK(client_->GetElement(GetElementRequest(), result));
+  EXPECT_TRUE(result.end_of_sequence);
+}
+
+TEST_F(ShmTransferTest, PassesRequestFieldsToServer) {
+  TF_ASSERT_OK(StartServerAndClient(
+      [](const GetElementRequest* request, GetElementResult* result) {
+        // Echo a request field so the test observes that the request
+        // survived the trip through the control socket.
+        result->element_index = request->task_id();
+        result->end_of_sequence = true;
+        return absl::OkStatus();
+      }));
+
+  GetElementRequest request;
+  request.set_task_id(42);
+  GetElementResult result;
+  TF_ASSERT_OK(client_->GetElement(request, result));
+  EXPECT_EQ(result.element_index, 42);
+}
+
+TEST_F(ShmTransferTest, CompatibilityRequiresSameHost) {
+  TF_ASSERT_OK(StartServerAndClient(
+      [](const GetElementRequest* request, GetElementResult* result) {
+        result->end_of_sequence = true;
+        return absl::OkStatus();
+      }));
+
+  absl::StatusOr<std::string> info = server_->GetCompatibilityInfo();
+  TF_ASSERT_OK(info.status());
+  TF_EXPECT_OK(client_->CheckCompatibility(*info));
+  EXPECT_TRUE(errors::IsFailedPrecondition(
+      client_->CheckCompatibility("some-other-host")));
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // !defined(PLATFORM_WINDOWS)
@@ -24,6 +24,7 @@ limitations under the License.
 #include "tensorflow/core/data/service/common.h"
 #include "tensorflow/core/data/service/cross_trainer_cache.h"
 #include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/data/service/element_spill_queue.h"
 #include "tensorflow/core/data/service/thread_safe_buffer.h"
 #include "tensorflow/core/data/service/worker.pb.h"
 #include "tensorflow/core/data/standalone.h"
@@ -33,13 +34,17 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/lib/gtl/cleanup.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/stringprintf.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/protobuf/service_config.pb.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -48,6 +53,55 @@ namespace {
 constexpr int64_t kWaitBeforeSkipUs = 100 * 1000;  // 100ms.
 constexpr size_t kDefaultCrossTrainerCacheSizeBytes =
     10 * (size_t{1} << 30);  // 10GB
+constexpr int64_t kDefaultSpillBufferBytes = 64 * (int64_t{1} << 20);  // 64MB
+constexpr int64_t kDefaultSpillMaxBytes = 10 * (int64_t{1} << 30);     // 10GB
+
+// Returns the local directory for spilling prefetched elements to disk, or an
+// empty string if spilling is disabled.
+std::string SpillDirectory() {
+  static std::string* spill_dir = []() {
+    std::string dir;
+    Status status =
+        ReadStringFromEnvVar("TF_DATA_SERVICE_SPILL_DIR", "", &dir);
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to read TF_DATA_SERVICE_SPILL_DIR: " << status;
+    }
+    return new std::string(dir);
+  }();
+  return *spill_dir;
+}
+
+// Returns the memory budget of the spill queue, configured via
+// TF_DATA_SERVICE_SPILL_BUFFER_BYTES.
+size_t SpillBufferBytes() {
+  static int64_t buffer_bytes = []() {
+    int64_t bytes = kDefaultSpillBufferBytes;
+    Status status = ReadInt64FromEnvVar("TF_DATA_SERVICE_SPILL_BUFFER_BYTES",
+                                        kDefaultSpillBufferBytes, &bytes);
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to read TF_DATA_SERVICE_SPILL_BUFFER_BYTES: "
+                 << status;
+    }
+    return bytes;
+  }();
+  return buffer_bytes;
+}
+
+// Returns the disk budget of the spill queue, configured via
+// TF_DATA_SERVICE_SPILL_MAX_BYTES.
+size_t SpillMaxBytes() {
+  static int64_t max_bytes = []() {
+    int64_t bytes = kDefaultSpillMaxBytes;
+    Status status = ReadInt64FromEnvVar("TF_DATA_SERVICE_SPILL_MAX_BYTES",
+                                        kDefaultSpillMaxBytes, &bytes);
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to read TF_DATA_SERVICE_SPILL_MAX_BYTES: "
+                 << status;
+    }
+    return bytes;
+  }();
+  return max_bytes;
+}
 
 }  // namespace
 
@@ -111,6 +165,17 @@ Status TaskRunner::Create(const experimental::WorkerConfig& worker_config,
 FirstComeFirstServedTaskRunner::FirstComeFirstServedTaskRunner(
     std::unique_ptr<TaskIterator> iterator)
     : iterator_(std::move(iterator)), buffer_(/*buffer_size=*/1) {
+  const std::string spill_dir = SpillDirectory();
+  if (!spill_dir.empty()) {
+    std::string spill_file = io::JoinPath(
+        spill_dir, strings::Printf("tf_data_service_spill_%016llx",
+                                   static_cast<unsigned long long>(
+                                       random::New64())));
+    spill_queue_ = std::make_unique<ElementSpillQueue>(
+        spill_file, SpillBufferBytes(), SpillMaxBytes());
+    LOG(INFO) << "Spilling overflowing tf.data service elements to "
+              << spill_file;
+  }
   RunPrefetchThread();
 }
 
@@ -118,7 +183,9 @@ FirstComeFirstServedTaskRunner::~FirstComeFirstServedTaskRunner() { Cancel(); }
 
 Status FirstComeFirstServedTaskRunner::GetNext(const GetElementRequest& req,
                                                GetElementResult& result) {
-  if (req.allow_skip() && buffer_.Empty()) {
+  const bool empty =
+      spill_queue_ != nullptr ? spill_queue_->Empty() : buffer_.Empty();
+  if (req.allow_skip() && empty) {
     result.skip = true;
     return absl::OkStatus();
   }
@@ -126,13 +193,22 @@ Status FirstComeFirstServedTaskRunner::GetNext(const GetElementRequest& req,
 }
 
 Status FirstComeFirstServedTaskRunner::GetNext(GetElementResult& result) {
+  if (spill_queue_ != nullptr) {
+    TF_ASSIGN_OR_RETURN(result, spill_queue_->Pop());
+    return absl::OkStatus();
+  }
   TF_ASSIGN_OR_RETURN(result, buffer_.Pop());
   return absl::OkStatus();
 }
 
 Status FirstComeFirstServedTaskRunner::PrefetchFn() {
   while (true) {
-    TF_RETURN_IF_ERROR(buffer_.Push(GetNextFromInputIterator()));
+    if (spill_queue_ != nullptr) {
+      TF_ASSIGN_OR_RETURN(GetElementResult element, GetNextFromInputIterator());
+      TF_RETURN_IF_ERROR(spill_queue_->Push(std::move(element)));
+    } else {
+      TF_RETURN_IF_ERROR(buffer_.Push(GetNextFromInputIterator()));
+    }
   }
   return absl::OkStatus();
 }
@@ -142,6 +218,9 @@ void FirstComeFirstServedTaskRunner::RunPrefetchThread() {
     Status status = PrefetchFn();
     if (!status.ok()) {
       buffer_.Cancel(status);
+      if (spill_queue_ != nullptr) {
+        spill_queue_->Cancel(status);
+      }
     }
   };
   prefetch_thread_ = absl::WrapUnique(Env::Default()->StartThread(
@@ -171,6 +250,10 @@ FirstComeFirstServedTaskRunner::GetNextFromInputIterator()
 void FirstComeFirstServedTaskRunner::Cancel() {
   VLOG(2) << "Cancelling tf.data service FCFS task.";
   buffer_.Cancel(errors::Cancelled("tf.data service FCFS task is cancelled."));
+  if (spill_queue_ != nullptr) {
+    spill_queue_->Cancel(
+        errors::Cancelled("tf.data service FCFS task is cancelled."));
+  }
 }
 
 std::shared_ptr<model::Model> FirstComeFirstServedTaskRunner::model() const {
@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/data/service/common.pb.h"
 #include "tensorflow/core/data/service/cross_trainer_cache.h"
 #include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/data/service/element_spill_queue.h"
 #include "tensorflow/core/data/service/thread_safe_buffer.h"
 #include "tensorflow/core/data/service/worker.pb.h"
 #include "tensorflow/core/data/standalone.h"
@@ -139,6 +140,11 @@ class FirstComeFirstServedTaskRunner : public TaskRunner {
   int64_t element_index_ TF_GUARDED_BY(mu_) = 0;
 
   ThreadSafeBuffer<GetElementResult> buffer_;
+  // When the TF_DATA_SERVICE_SPILL_DIR environment variable points at a local
+  // directory, prefetched elements go through a spill queue instead of
+  // `buffer_`, so the buffer can absorb consumer stalls by spilling overflow
+  // elements to disk rather than growing in memory.
+  std::unique_ptr<ElementSpillQueue> spill_queue_;
   std::unique_ptr<Thread> prefetch_thread_;
 
   FirstComeFirstServedTaskRunner(const FirstComeFirstServedTaskRunner&) =
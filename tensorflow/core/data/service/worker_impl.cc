@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/data/service/worker_impl.h"
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -52,6 +53,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/env_time.h"
 #include "tensorflow/core/platform/errors.h"
@@ -64,6 +66,7 @@ limitations under the License.
 #include "tensorflow/core/protobuf/service_config.pb.h"
 #include "tensorflow/core/public/session_options.h"
 #include "tensorflow/core/util/dump_graph.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/status_to_from_proto.h"
 #include "tsl/platform/statusor.h"
@@ -79,6 +82,47 @@ constexpr absl::Duration kDefaultDispatcherTimeout = absl::Hours(1);
 
 using WorkerConfig = experimental::WorkerConfig;
 
+// Returns the worker's processing-time budget in nanoseconds: the sum of the
+// per-element processing times of all active tasks at which the worker is
+// considered saturated. Configured via
+// TF_DATA_SERVICE_WORKER_SATURATION_BUDGET_NSEC; by default the budget is one
+// second of processing per schedulable CPU.
+double SaturationBudgetNsec() {
+  static const double budget = []() {
+    int64_t value = 0;
+    Status status = ReadInt64FromEnvVar(
+        "TF_DATA_SERVICE_WORKER_SATURATION_BUDGET_NSEC", 0, &value);
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to read "
+                    "TF_DATA_SERVICE_WORKER_SATURATION_BUDGET_NSEC: "
+                 << status;
+    }
+    if (value > 0) {
+      return static_cast<double>(value);
+    }
+    return port::NumSchedulableCPUs() * 1.0e9;
+  }();
+  return budget;
+}
+
+// Returns true if the worker should reject new task assignments while
+// saturated, so the dispatcher retries the assignment later instead of piling
+// more work onto an overloaded worker. Defaults to false.
+bool RejectTasksWhenSaturated() {
+  static const bool reject = []() {
+    bool value = false;
+    Status status = ReadBoolFromEnvVar(
+        "TF_DATA_SERVICE_WORKER_REJECT_WHEN_SATURATED", false, &value);
+    if (!status.ok()) {
+      LOG(ERROR)
+          << "Failed to read TF_DATA_SERVICE_WORKER_REJECT_WHEN_SATURATED: "
+          << status;
+    }
+    return value;
+  }();
+  return reject;
+}
+
 // Moves the element into the response. If the tensor contains a single
 // CompressedElement variant, the move will be zero-copy. Otherwise, the tensor
 // data will be serialized as TensorProtos.
@@ -320,12 +364,25 @@ Status DataServiceWorkerImpl::ProcessTask(const ProcessTaskRequest* request,
 
 Status DataServiceWorkerImpl::ProcessTaskInternal(const TaskDef& task_def)
     TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-  std::shared_ptr<Task>& task = tasks_[task_def.task_id()];
-  if (task) {
+  if (tasks_.contains(task_def.task_id())) {
     VLOG(1) << "Received request to process already-processed task "
-            << task->task_def.task_id();
+            << task_def.task_id();
     return absl::OkStatus();
   }
+  if (RejectTasksWhenSaturated() &&
+      total_processing_time_nsec_.load(std::memory_order_relaxed) >
+          SaturationBudgetNsec()) {
+    // The dispatcher treats this as retriable and re-offers the task in a
+    // later heartbeat, by which time the load may have drained or moved to
+    // other workers.
+    return errors::Unavailable(
+        "tf.data service worker ", worker_address_,
+        " is saturated and cannot accept task ", task_def.task_id(),
+        ". The estimated total processing time of its active tasks is ",
+        total_processing_time_nsec_.load(std::memory_order_relaxed),
+        "ns, above the budget of ", SaturationBudgetNsec(), "ns.");
+  }
+  std::shared_ptr<Task>& task = tasks_[task_def.task_id()];
   task = std::make_unique<Task>(task_def);
   VLOG(3) << "Began processing for task " << task_def.task_id()
           << " with processing mode "
@@ -609,6 +666,11 @@ std::vector<ActiveTask> DataServiceWorkerImpl::GetActiveTasks() const
     current_tasks = tasks_;
   }
 
+  const double target_processing_time_nsec =
+      current_tasks.empty()
+          ? 0.0
+          : SaturationBudgetNsec() / static_cast<double>(current_tasks.size());
+  double total_processing_time_nsec = 0.0;
   for (const auto& [task_id, task] : current_tasks) {
     if (task == nullptr) {
       continue;
@@ -616,6 +678,7 @@ std::vector<ActiveTask> DataServiceWorkerImpl::GetActiveTasks() const
     ActiveTask active_task;
     active_task.set_task_id(task_id);
     active_task.set_processing_time_nsec(0.0);
+    active_task.set_target_processing_time_nsec(target_processing_time_nsec);
 
     bool task_initialized = false;
     {
@@ -629,10 +692,13 @@ std::vector<ActiveTask> DataServiceWorkerImpl::GetActiveTasks() const
       double processing_time_nsec = model->ComputeSnapshotProcessingTimeNsec();
       if (processing_time_nsec > 0) {
         active_task.set_processing_time_nsec(processing_time_nsec);
+        total_processing_time_nsec += processing_time_nsec;
       }
     }
     active_tasks.push_back(std::move(active_task));
   }
+  total_processing_time_nsec_.store(total_processing_time_nsec,
+                                    std::memory_order_relaxed);
 
   return active_tasks;
 }
@@ -128,6 +128,10 @@ Status Writer::Create(Env* env, const std::string& filename,
       *out_writer =
           std::make_unique<TFRecordWriter>(filename, compression_type);
       break;
+    case 3:
+      *out_writer =
+          std::make_unique<ColumnarWriter>(filename, compression_type, dtypes);
+      break;
     default:
       return errors::InvalidArgument("Snapshot writer version: ", version,
                                      " is not supported.");
@@ -200,6 +204,81 @@ TFRecordWriter::~TFRecordWriter() {
   }
 }
 
+std::string ColumnFileName(const std::string& filename, int64_t column_index) {
+  return strings::Printf("%s.column_%02lld", filename.c_str(),
+                         static_cast<long long>(column_index));
+}
+
+ColumnarWriter::ColumnarWriter(const std::string& filename,
+                               const std::string& compression_type,
+                               const DataTypeVector& dtypes)
+    : filename_(filename),
+      compression_type_(compression_type),
+      dtypes_(dtypes) {}
+
+Status ColumnarWriter::Initialize(tensorflow::Env* env) {
+  env_ = env;
+  columns_.reserve(dtypes_.size());
+  for (int64_t i = 0; i < dtypes_.size(); ++i) {
+    columns_.push_back(std::make_unique<TFRecordWriter>(
+        ColumnFileName(filename_, i), compression_type_));
+    TF_RETURN_IF_ERROR(columns_.back()->Initialize(env));
+  }
+  return absl::OkStatus();
+}
+
+Status ColumnarWriter::WriteTensors(const std::vector<Tensor>& tensors) {
+  if (tensors.size() != columns_.size()) {
+    return errors::InvalidArgument(
+        "Expected an element with ", columns_.size(), " components but got ",
+        tensors.size(), " while writing columnar snapshot file: ", filename_);
+  }
+  for (int64_t i = 0; i < tensors.size(); ++i) {
+    TF_RETURN_IF_ERROR(columns_[i]->WriteTensors({tensors[i]}));
+  }
+  ++num_elements_;
+  return absl::OkStatus();
+}
+
+Status ColumnarWriter::Sync() {
+  for (auto& column : columns_) {
+    TF_RETURN_IF_ERROR(column->Sync());
+  }
+  return absl::OkStatus();
+}
+
+Status ColumnarWriter::Close() {
+  if (columns_.empty()) {
+    return absl::OkStatus();
+  }
+  for (auto& column : columns_) {
+    TF_RETURN_IF_ERROR(column->Close());
+  }
+  columns_.clear();
+  // The index is written last so that a reader never sees an index referring
+  // to incompletely written column streams. It is stored as a string scalar
+  // so it can be read back with `TFRecordReaderImpl`.
+  experimental::SnapshotColumnarIndex index;
+  for (const auto& dtype : dtypes_) {
+    index.add_dtype(dtype);
+  }
+  index.set_num_elements(num_elements_);
+  Tensor index_tensor(DT_STRING, TensorShape({}));
+  index_tensor.scalar<tstring>()() = index.SerializeAsString();
+  TFRecordWriter index_writer(filename_, compression_type_);
+  TF_RETURN_IF_ERROR(index_writer.Initialize(env_));
+  TF_RETURN_IF_ERROR(index_writer.WriteTensors({index_tensor}));
+  return index_writer.Close();
+}
+
+ColumnarWriter::~ColumnarWriter() {
+  Status s = Close();
+  if (!s.ok()) {
+    LOG(ERROR) << "Failed to close columnar snapshot file " << filename_
+               << ": " << s;
+  }
+}
+
 CustomWriter::CustomWriter(const std::string& filename,
                            const std::string& compression_type,
                            const DataTypeVector& dtypes)
@@ -378,6 +457,10 @@ Status Reader::Create(Env* env, const std::string& filename,
       *out_reader =
           std::make_unique<TFRecordReader>(filename, compression_type, dtypes);
       break;
+    case 3:
+      *out_reader =
+          std::make_unique<ColumnarReader>(filename, compression_type, dtypes);
+      break;
     default:
       return errors::InvalidArgument("Snapshot reader version: ", version,
                                      " is not supported.");
@@ -808,6 +891,67 @@ Status TFRecordReader::ReadTensors(std::vector<Tensor>* read_tensors) {
   return absl::OkStatus();
 }
 
+ColumnarReader::ColumnarReader(const std::string& filename,
+                               const string& compression,
+                               const DataTypeVector& dtypes,
+                               std::optional<std::vector<int64_t>> columns)
+    : filename_(filename),
+      compression_(compression),
+      dtypes_(dtypes),
+      columns_(std::move(columns)) {}
+
+Status ColumnarReader::Initialize(Env* env) {
+  TFRecordReaderImpl index_reader(filename_, compression_);
+  TF_RETURN_IF_ERROR(index_reader.Initialize(env));
+  TF_ASSIGN_OR_RETURN(Tensor index_tensor, index_reader.GetNext());
+  if (index_tensor.dtype() != DT_STRING || index_tensor.dims() != 0) {
+    return errors::DataLoss("Expected a string scalar index in columnar ",
+                            "snapshot file: ", filename_);
+  }
+  experimental::SnapshotColumnarIndex index;
+  const tstring& serialized = index_tensor.scalar<tstring>()();
+  if (!index.ParseFromArray(serialized.data(), serialized.size())) {
+    return errors::DataLoss(
+        "Unable to parse the index of columnar snapshot file: ", filename_);
+  }
+  if (index.dtype_size() != dtypes_.size()) {
+    return errors::InvalidArgument(
+        "Columnar snapshot file ", filename_, " stores ", index.dtype_size(),
+        " columns but ", dtypes_.size(), " dtypes were requested.");
+  }
+  std::vector<int64_t> selected_columns;
+  if (columns_.has_value()) {
+    selected_columns = *columns_;
+  } else {
+    for (int64_t i = 0; i < dtypes_.size(); ++i) {
+      selected_columns.push_back(i);
+    }
+  }
+  column_readers_.reserve(selected_columns.size());
+  for (int64_t column : selected_columns) {
+    if (column < 0 || column >= index.dtype_size()) {
+      return errors::InvalidArgument("Column ", column,
+                                     " is out of range for columnar snapshot "
+                                     "file: ",
+                                     filename_);
+    }
+    column_readers_.push_back(std::make_unique<TFRecordReaderImpl>(
+        ColumnFileName(filename_, column), compression_));
+    TF_RETURN_IF_ERROR(column_readers_.back()->Initialize(env));
+  }
+  return absl::OkStatus();
+}
+
+Status ColumnarReader::ReadTensors(std::vector<Tensor>* read_tensors) {
+  read_tensors->clear();
+  read_tensors->reserve(column_readers_.size());
+  for (auto& column_reader : column_readers_) {
+    TF_ASSIGN_OR_RETURN(Tensor tensor, column_reader->GetNext());
+    read_tensors->push_back(std::move(tensor));
+  }
+  return absl::OkStatus();
+}
+
 CustomReader::CustomReader(const std::string& filename,
                            const string& compression_type, const int version,
                            const DataTypeVector& dtypes)
@@ -129,6 +129,41 @@ class TFRecordWriter : public Writer {
   std::unique_ptr<io::RecordWriter> record_writer_;
 };
 
+// Returns the name of the per-column record stream for the given snapshot
+// file and column index, used by the columnar snapshot format.
+std::string ColumnFileName(const std::string& filename, int64_t column_index);
+
+// Writes snapshots in a columnar layout: each element component is appended
+// to its own record stream at `ColumnFileName(filename, i)`, and the main
+// file holds a `SnapshotColumnarIndex` describing the column streams. Readers
+// can project a subset of columns without reading the others.
+class ColumnarWriter : public Writer {
+ public:
+  ColumnarWriter(const std::string& filename,
+                 const std::string& compression_type,
+                 const DataTypeVector& dtypes);
+
+  Status Initialize(tensorflow::Env* env) override;
+
+  Status WriteTensors(const std::vector<Tensor>& tensors) override;
+
+  Status Sync() override;
+
+  Status Close() override;
+
+  ~ColumnarWriter() override;
+
+ private:
+  const std::string filename_;
+  const std::string compression_type_;
+  const DataTypeVector dtypes_;
+
+  // Kept to write the index file when the writer is closed.
+  Env* env_ = nullptr;
+  std::vector<std::unique_ptr<TFRecordWriter>> columns_;
+  int64_t num_elements_ = 0;
+};
+
 // Writes snapshot with a custom (legacy) file format.
 class CustomWriter : public Writer {
  public:
@@ -309,6 +344,29 @@ class TFRecordReader : public Reader {
   const DataTypeVector dtypes_;
 };
 
+// Reads snapshots previously written with `ColumnarWriter`. If `columns` is
+// provided, only the selected column streams are opened and `ReadTensors`
+// returns the components in the order given by `columns`; otherwise all
+// columns are read.
+class ColumnarReader : public Reader {
+ public:
+  ColumnarReader(const std::string& filename, const string& compression,
+                 const DataTypeVector& dtypes,
+                 std::optional<std::vector<int64_t>> columns = std::nullopt);
+
+  Status Initialize(Env* env) override;
+
+  Status ReadTensors(std::vector<Tensor>* read_tensors) override;
+
+ private:
+  const std::string filename_;
+  const string compression_;
+  const DataTypeVector dtypes_;
+  const std::optional<std::vector<int64_t>> columns_;
+
+  std::vector<std::unique_ptr<TFRecordReaderImpl>> column_readers_;
+};
+
 // Reads snapshots previously written with `CustomWriter`.
 class CustomReader : public Reader {
  public:
@@ -24,6 +24,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/io/compression.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/platform/test_benchmark.h"
@@ -97,6 +98,44 @@ TEST(SnapshotUtilTest, CombinationRoundTripTest) {
   SnapshotRoundTrip(io::compression::kNone, 2);
   SnapshotRoundTrip(io::compression::kGzip, 2);
   SnapshotRoundTrip(io::compression::kSnappy, 2);
+
+  SnapshotRoundTrip(io::compression::kNone, 3);
+  SnapshotRoundTrip(io::compression::kGzip, 3);
+  SnapshotRoundTrip(io::compression::kSnappy, 3);
+}
+
+TEST(SnapshotUtilTest, ColumnarReaderProjectsColumns) {
+  tensorflow::DataTypeVector dtypes = {DT_INT64, DT_STRING};
+  Tensor int_tensor(static_cast<int64_t>(42));
+  Tensor string_tensor(tstring("snapshot"));
+
+  std::string filename;
+  EXPECT_TRUE(Env::Default()->LocalTempFilename(&filename));
+
+  std::unique_ptr<Writer> writer;
+  TF_ASSERT_OK(Writer::Create(Env::Default(), filename, io::compression::kNone,
+                              /*version=*/3, dtypes, &writer));
+  for (int i = 0; i < 10; ++i) {
+    TF_ASSERT_OK(writer->WriteTensors({int_tensor, string_tensor}));
+  }
+  TF_ASSERT_OK(writer->Close());
+
+  // Reading only the string column should not touch the int64 column stream.
+  TF_ASSERT_OK(Env::Default()->DeleteFile(ColumnFileName(filename, 0)));
+  ColumnarReader reader(filename, io::compression::kNone, dtypes,
+                        std::vector<int64_t>{1});
+  TF_ASSERT_OK(reader.Initialize(Env::Default()));
+  for (int i = 0; i < 10; ++i) {
+    std::vector<Tensor> read_tensors;
+    TF_ASSERT_OK(reader.ReadTensors(&read_tensors));
+    ASSERT_EQ(read_tensors.size(), 1);
+    EXPECT_EQ(read_tensors[0].scalar<tstring>()(), "snapshot");
+  }
+  std::vector<Tensor> read_tensors;
+  EXPECT_TRUE(errors::IsOutOfRange(reader.ReadTensors(&read_tensors)));
+
+  TF_ASSERT_OK(Env::Default()->DeleteFile(filename));
+  TF_ASSERT_OK(Env::Default()->DeleteFile(ColumnFileName(filename, 1)));
 }
 
 TEST(SnapshotUtilTest, MetadataFileRoundTrip) {
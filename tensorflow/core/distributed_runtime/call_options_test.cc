@@ -36,4 +36,13 @@ TEST(CallOptions, Cancel) {
   EXPECT_EQ(num_calls, 2);
 }
 
+TEST(CallOptions, Deadline) {
+  CallOptions opts;
+  EXPECT_EQ(opts.GetDeadline(), 0);
+  opts.SetDeadline(1234567890);
+  EXPECT_EQ(opts.GetDeadline(), 1234567890);
+  opts.SetDeadline(0);
+  EXPECT_EQ(opts.GetDeadline(), 0);
+}
+
 }  // namespace tensorflow
@@ -21,6 +21,7 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/device_resolver_distributed.h"
 #include "tensorflow/core/distributed_runtime/worker_cache.h"
 #include "tensorflow/core/framework/device_attributes.pb.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/protobuf/config.pb.h"
@@ -73,6 +74,15 @@ class CompleteInstanceCall : public CancellableCall {
     }
     req_.set_device(device_name);
     req_.set_is_source(is_source);
+    // Give the RPC the collective's own completion budget as an absolute
+    // deadline. A flapping group leader then fails the call (including any
+    // RPC-level retries) within the budget instead of leaving the step to
+    // the full watchdog timeout.
+    if (instance.impl_details.timeout_seconds > 0) {
+      opts_.SetDeadline(Env::Default()->NowMicros() +
+                        static_cast<int64_t>(
+                            instance.impl_details.timeout_seconds * 1'000'000));
+    }
   }
 
   ~CompleteInstanceCall() override {}
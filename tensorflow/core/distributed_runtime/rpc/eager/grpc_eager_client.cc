@@ -16,7 +16,10 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/rpc/eager/grpc_eager_client.h"
 
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "grpcpp/generic/generic_stub.h"
 #include "xla/tsl/distributed_runtime/call_options.h"
@@ -74,6 +77,22 @@ bool EnableStreaming() {
   return result;
 }
 
+/* Flush window, in microseconds, for coalescing consecutive streaming
+ * enqueue requests destined for the same remote context into a single
+ * EnqueueRequest RPC. While the window is open newly arriving ops are
+ * appended to a pending batch instead of being sent immediately, which
+ * trades a small amount of dispatch latency for far fewer RPCs on
+ * enqueue-heavy workloads. 0 (the default) disables batching. Only
+ * applies when streaming enqueue is in use, so batching preserves the
+ * per-context ordering guarantees of the streaming call.
+ */
+int64_t StreamingEnqueueBatchWindowMicros() {
+  int64_t result;
+  TF_CHECK_OK(ReadInt64FromEnvVar(
+      "TF_EAGER_CLIENT_STREAMING_ENQUEUE_BATCH_USEC", 0, &result));
+  return result;
+}
+
 // Ref-counted thread to handle callbacks for completed requests a GRPC
 // completion queue. The thread might be shared by multiple eager clients, and
 // each one of them should hold a reference count to ensure that the thread
@@ -145,11 +164,26 @@ class GrpcEagerClient : public EagerClient {
 
   CLIENT_METHOD(CreateContext);
   CLIENT_METHOD(UpdateContext);
-  CLIENT_METHOD(WaitQueueDone);
   CLIENT_METHOD(KeepAlive);
 
 #undef CLIENT_METHOD
 
+  void WaitQueueDoneAsync(const WaitQueueDoneRequest* request,
+                          WaitQueueDoneResponse* response,
+                          StatusCallback done) override {
+    // Flush any ops still held in the client-side enqueue batch; otherwise
+    // the wait below could complete before they have even been sent.
+    if (StreamingEnqueueBatchWindowMicros() > 0) {
+      FlushPendingEnqueue(request->context_id());
+    }
+    StatusCallback done_wrapped = callback_wrapper(std::move(done));
+    new RPCState<protobuf::Message>(
+        &stub_, cq_, "/tensorflow.eager.EagerService/WaitQueueDone", *request,
+        response, std::move(done_wrapped), /*call_opts=*/nullptr,
+        /*threadpool=*/nullptr, /*max_retries=*/0, /*fail_fast=*/true,
+        &target_);
+  }
+
 #define CLIENT_METHOD_WITH_TIMEOUT_AND_RETRIES(method)                       \
   void method##Async(const method##Request* request,                         \
                      method##Response* response, StatusCallback done,        \
@@ -196,6 +230,11 @@ class GrpcEagerClient : public EagerClient {
   void CloseContextAsync(const CloseContextRequest* request,
                          CloseContextResponse* response,
                          StatusCallback done) override {
+    // Send out any batched ops before the streaming call is cancelled so
+    // their callers still get a response.
+    if (StreamingEnqueueBatchWindowMicros() > 0) {
+      FlushPendingEnqueue(request->context_id());
+    }
     StatusCallback done_wrapped = callback_wrapper(std::move(done));
     new RPCState<protobuf::Message>(
         &stub_, cq_, "/tensorflow.eager.EagerService/CloseContext", *request,
@@ -228,6 +267,27 @@ class GrpcEagerClient : public EagerClient {
     // 2. The flag set in the eager executor.
     // Streaming enqueue is allowed only when the both are enabled.
     if (EnableStreaming() && enable_streaming_enqueue) {
+      const int64_t batch_window_micros = StreamingEnqueueBatchWindowMicros();
+      if (batch_window_micros > 0) {
+        const uint64 context_id = request->context_id();
+        mutex_lock l(mu_);
+        PendingEnqueue& pending = pending_enqueues_[context_id];
+        pending.request.set_context_id(context_id);
+        pending.request.mutable_queue()->MergeFrom(request->queue());
+        pending.callers.push_back(
+            {request->queue_size(), response, std::move(done_wrapped)});
+        if (!pending.flush_scheduled) {
+          pending.flush_scheduled = true;
+          // Hold a reference so the flush closure never outlives the client.
+          Ref();
+          Env::Default()->SchedClosureAfter(
+              batch_window_micros, [this, context_id]() {
+                FlushPendingEnqueue(context_id);
+                this->Unref();
+              });
+        }
+        return;
+      }
       mutex_lock l(mu_);
       auto it = enqueue_dispatchers_.find(request->context_id());
       if (it == enqueue_dispatchers_.end()) {
@@ -266,6 +326,65 @@ class GrpcEagerClient : public EagerClient {
   std::unordered_map<uint64, StreamingRPCDispatcher<EnqueueResponse>>
       enqueue_dispatchers_ TF_GUARDED_BY(mu_);
 
+  // A client-side batch of streaming enqueue requests for one remote
+  // context. Requests arriving within the flush window are merged into
+  // `request`; `callers` remembers how many queue items each original
+  // request contributed so the merged response can be demultiplexed.
+  struct PendingEnqueue {
+    struct Caller {
+      int num_items;
+      EnqueueResponse* response;
+      StatusCallback done;
+    };
+    EnqueueRequest request;
+    std::vector<Caller> callers;
+    bool flush_scheduled = false;
+  };
+  std::unordered_map<uint64, PendingEnqueue> pending_enqueues_
+      TF_GUARDED_BY(mu_);
+
+  // Sends the pending batch for `context_id` (if any) as one streaming
+  // enqueue request. Each caller's done callback runs when the merged
+  // response arrives, with its slice of the queue responses copied out.
+  void FlushPendingEnqueue(uint64 context_id) {
+    mutex_lock l(mu_);
+    auto it = pending_enqueues_.find(context_id);
+    if (it == pending_enqueues_.end()) return;
+    PendingEnqueue pending = std::move(it->second);
+    pending_enqueues_.erase(it);
+    if (pending.callers.empty()) return;
+    auto dit = enqueue_dispatchers_.find(context_id);
+    if (dit == enqueue_dispatchers_.end()) {
+      auto it_and_bool = enqueue_dispatchers_.emplace(
+          std::piecewise_construct, std::forward_as_tuple(context_id),
+          std::forward_as_tuple(
+              &stub_, cq_,
+              "/tensorflow.eager.EagerService/StreamingEnqueue"));
+      dit = it_and_bool.first;
+    }
+    auto merged_response = std::make_shared<EnqueueResponse>();
+    auto callers = std::make_shared<std::vector<PendingEnqueue::Caller>>(
+        std::move(pending.callers));
+    dit->second.SendNextRequest(
+        pending.request, merged_response.get(),
+        [merged_response, callers](const Status& status) {
+          int offset = 0;
+          for (auto& caller : *callers) {
+            if (status.ok()) {
+              for (int i = 0;
+                   i < caller.num_items &&
+                   offset + i < merged_response->queue_response_size();
+                   ++i) {
+                *caller.response->add_queue_response() =
+                    merged_response->queue_response(offset + i);
+              }
+            }
+            offset += caller.num_items;
+            caller.done(status);
+          }
+        });
+  }
+
   StatusCallback callback_wrapper(StatusCallback done) {
     Ref();
     return [this, done = std::move(done)](const Status& status) {
@@ -43,11 +43,13 @@ class GrpcRemoteWorker : public WorkerInterface {
  public:
   explicit GrpcRemoteWorker(SharedGrpcChannelPtr channel,
                             ::grpc::CompletionQueue* completion_queue,
+                            ::grpc::CompletionQueue* bulk_completion_queue,
                             thread::ThreadPool* callback_threadpool,
                             WorkerCacheLogger* logger, const string& target)
       : channel_(std::move(channel)),
         stub_(channel_),
         cq_(completion_queue),
+        bulk_cq_(bulk_completion_queue),
         callback_threadpool_(callback_threadpool),
         getstatus_(Method(GrpcWorkerMethod::kGetStatus)),
         createworkersession_(Method(GrpcWorkerMethod::kCreateWorkerSession)),
@@ -171,7 +173,8 @@ class GrpcRemoteWorker : public WorkerInterface {
       done(s);
     };
 
-    IssueRequest(request, response, recvbuf_, callback, call_opts);
+    IssueRequest(request, response, recvbuf_, callback, call_opts,
+                 /*fail_fast=*/true, bulk_cq_);
   }
 
   void CompleteGroupAsync(CallOptions* call_opts,
@@ -269,22 +272,26 @@ class GrpcRemoteWorker : public WorkerInterface {
 
  private:
   // Utility method for issuing a generic asynchronous request. The
-  // given callback, `done`, will be called when the RPC completes.
+  // given callback, `done`, will be called when the RPC completes.  Bulk
+  // tensor transfers pass `bulk_cq_` as `cq` so that their completions do
+  // not delay control RPCs polled on `cq_`.
   void IssueRequest(const protobuf::Message* request,
                     protobuf::Message* response, const ::grpc::string& method,
                     StatusCallback done, CallOptions* call_opts = nullptr,
-                    bool fail_fast = true) {
+                    bool fail_fast = true,
+                    ::grpc::CompletionQueue* cq = nullptr) {
     new RPCState<protobuf::Message>(
-        &stub_, cq_, method, *request, response, std::move(done), call_opts,
-        callback_threadpool_, MaxRetries(), fail_fast, &target_);
+        &stub_, cq == nullptr ? cq_ : cq, method, *request, response,
+        std::move(done), call_opts, callback_threadpool_, MaxRetries(),
+        fail_fast, &target_);
   }
 
   void IssueRequest(const protobuf::Message* request, TensorResponse* response,
                     const ::grpc::string& method, StatusCallback done,
                     CallOptions* call_opts = nullptr) {
     new RPCState<TensorResponse>(
-        &stub_, cq_, method, *request, response, std::move(done), call_opts,
-        callback_threadpool_, MaxRetries(),
+        &stub_, bulk_cq_, method, *request, response, std::move(done),
+        call_opts, callback_threadpool_, MaxRetries(),
         /*fail_fast=*/true, &target_,
         // Use optimized proto parse function that avoids a copy.
         GrpcMaybeParseTensorResponse);
@@ -314,6 +321,7 @@ class GrpcRemoteWorker : public WorkerInterface {
   SharedGrpcChannelPtr channel_;
   ::grpc::GenericStub stub_;
   ::grpc::CompletionQueue* cq_;
+  ::grpc::CompletionQueue* bulk_cq_;
   thread::ThreadPool* callback_threadpool_;
 
   const ::grpc::string getstatus_;
@@ -341,13 +349,14 @@ class GrpcRemoteWorker : public WorkerInterface {
   void operator=(const GrpcRemoteWorker&) = delete;
 };
 
-WorkerInterface* NewGrpcRemoteWorker(SharedGrpcChannelPtr channel,
-                                     ::grpc::CompletionQueue* completion_queue,
-                                     thread::ThreadPool* callback_threadpool,
-                                     WorkerCacheLogger* logger,
-                                     const string& target) {
+WorkerInterface* NewGrpcRemoteWorker(
+    SharedGrpcChannelPtr channel, ::grpc::CompletionQueue* completion_queue,
+    ::grpc::CompletionQueue* bulk_completion_queue,
+    thread::ThreadPool* callback_threadpool, WorkerCacheLogger* logger,
+    const string& target) {
   return new GrpcRemoteWorker(std::move(channel), completion_queue,
-                              callback_threadpool, logger, target);
+                              bulk_completion_queue, callback_threadpool,
+                              logger, target);
 }
 
 }  // namespace tensorflow
@@ -26,11 +26,16 @@ namespace tensorflow {
 class WorkerCacheLogger;
 class WorkerInterface;
 
-WorkerInterface* NewGrpcRemoteWorker(SharedGrpcChannelPtr channel,
-                                     ::grpc::CompletionQueue* completion_queue,
-                                     thread::ThreadPool* callback_threadpool,
-                                     WorkerCacheLogger* logger,
-                                     const string& target);
+// Returns a WorkerInterface that issues RPCs over `channel`.
+// Latency-sensitive control RPCs complete on `completion_queue`, while bulk
+// tensor transfers (RecvTensor, RecvBuf) complete on
+// `bulk_completion_queue`.  The two may be the same queue, in which case
+// bulk and control traffic share a polling thread.
+WorkerInterface* NewGrpcRemoteWorker(
+    SharedGrpcChannelPtr channel, ::grpc::CompletionQueue* completion_queue,
+    ::grpc::CompletionQueue* bulk_completion_queue,
+    thread::ThreadPool* callback_threadpool, WorkerCacheLogger* logger,
+    const string& target);
 
 }  // namespace tensorflow
 
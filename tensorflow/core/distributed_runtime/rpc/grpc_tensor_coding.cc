@@ -15,8 +15,11 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_tensor_coding.h"
 
+#include <vector>
+
 #include "grpcpp/support/byte_buffer.h"
 #include "grpcpp/support/slice.h"
+#include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor.pb.h"
@@ -25,6 +28,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/io/proto_encode_helper.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/protobuf/worker.pb.h"
 
 namespace tensorflow {
@@ -134,6 +138,117 @@ static void EncodeSkeleton(const Tensor& val, io::ProtoEncodeHelper* e) {
 #endif
 }
 
+namespace {
+
+// Cache of skeleton encodings keyed by (dtype, shape). Parameter-server
+// style workloads encode responses for the same handful of variables over
+// and over, so the skeleton rarely differs between responses.
+class SkeletonCache {
+ public:
+  static SkeletonCache* Global() {
+    static SkeletonCache* cache = new SkeletonCache;
+    return cache;
+  }
+
+  // Fills "*out" with the skeleton encoding of "val" (see EncodeSkeleton),
+  // consulting the cache first.
+  void GetEncoding(const Tensor& val, string* out) {
+    // Binary cache key: dtype followed by the dimension sizes.
+    string key;
+    key.reserve(sizeof(int32) + val.shape().dims() * sizeof(int64_t));
+    const int32 dtype = val.dtype();
+    key.append(reinterpret_cast<const char*>(&dtype), sizeof(dtype));
+    for (int d = 0; d < val.shape().dims(); d++) {
+      const int64_t dim_size = val.shape().dim_size(d);
+      key.append(reinterpret_cast<const char*>(&dim_size), sizeof(dim_size));
+    }
+    {
+      mutex_lock l(mu_);
+      auto iter = cache_.find(key);
+      if (iter != cache_.end()) {
+        *out = iter->second;
+        return;
+      }
+    }
+    gtl::InlinedVector<char, 128> space(SkeletonEncodingSizeUpperBound(val));
+    io::ProtoEncodeHelper e(space.data(), space.size());
+    EncodeSkeleton(val, &e);
+    out->assign(e.data(), e.size());
+    mutex_lock l(mu_);
+    // The cache is expected to stay tiny (one entry per distinct tensor
+    // signature); flush it in the unlikely case it grows large.
+    if (cache_.size() >= kMaxEntries) {
+      cache_.clear();
+    }
+    cache_.emplace(std::move(key), *out);
+  }
+
+ private:
+  static const size_t kMaxEntries = 256;
+
+  mutex mu_;
+  absl::flat_hash_map<string, string> cache_ TF_GUARDED_BY(mu_);
+};
+
+// Freelist of fixed-size backing buffers for the metadata slice of each
+// response (sections A through D2 above, plus the payload of small
+// tensors). Responses for the same variable all need the same few bytes,
+// so recycling the backing store avoids a malloc/free pair per response.
+class SliceBufferPool {
+ public:
+  // Buffers this large cover the response header, skeleton and tags, and
+  // inlined tensor payloads of up to kLargeTensorBytes.
+  static const size_t kBufferBytes = 4096;
+
+  // Returns a slice with "len" writable bytes at begin(), backed by a
+  // pooled buffer when "len" fits.
+  static ::grpc::Slice MakeSlice(size_t len) {
+    if (len > kBufferBytes) {
+      return ::grpc::Slice(len);
+    }
+    SliceBufferPool* pool = Global();
+    char* buf = nullptr;
+    {
+      mutex_lock l(pool->mu_);
+      if (!pool->free_buffers_.empty()) {
+        buf = pool->free_buffers_.back();
+        pool->free_buffers_.pop_back();
+      }
+    }
+    if (buf == nullptr) {
+      buf = new char[kBufferBytes];
+    }
+    return ::grpc::Slice(buf, len, &SliceBufferPool::Recycle, buf);
+  }
+
+ private:
+  static const size_t kMaxFreeBuffers = 64;
+
+  static SliceBufferPool* Global() {
+    static SliceBufferPool* pool = new SliceBufferPool;
+    return pool;
+  }
+
+  // Called by gRPC once it no longer references the slice.
+  static void Recycle(void* backing) {
+    char* buf = static_cast<char*>(backing);
+    SliceBufferPool* pool = Global();
+    {
+      mutex_lock l(pool->mu_);
+      if (pool->free_buffers_.size() < kMaxFreeBuffers) {
+        pool->free_buffers_.push_back(buf);
+        return;
+      }
+    }
+    delete[] buf;
+  }
+
+  mutex mu_;
+  std::vector<char*> free_buffers_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace
+
 void EncodeTensorToByteBuffer(bool is_dead, const Tensor& val, bool require_ack,
                               ::grpc::ByteBuffer* result) {
   const int kLargeTensorBytes = 1024;
@@ -164,13 +279,12 @@ void EncodeTensorToByteBuffer(bool is_dead, const Tensor& val, bool require_ack,
   } else {
     // skeleton is the encoded TensorProto contents (dtype and shape), but
     // not the actual data
-    gtl::InlinedVector<char, 128> skeleton(SkeletonEncodingSizeUpperBound(val));
-    io::ProtoEncodeHelper e_skeleton(skeleton.data(), skeleton.size());
-    EncodeSkeleton(val, &e_skeleton);
+    string skeleton;
+    SkeletonCache::Global()->GetEncoding(val, &skeleton);
 
     StringPiece tdata = val.tensor_data();
     uint32 overall_tensor_proto_bytesize =
-        (e_skeleton.size() +
+        (skeleton.size() +
          VarLengthEncodingSize(TensorProto::kTensorContentFieldNumber,
                                tdata.size()));
     string header;  // All of RecvTensorResponse except the tensor() field
@@ -205,7 +319,7 @@ void EncodeTensorToByteBuffer(bool is_dead, const Tensor& val, bool require_ack,
     e.WriteVarlengthBeginning(RecvTensorResponse::kTensorFieldNumber,
                               overall_tensor_proto_bytesize);
     // (C)
-    e.WriteRawBytes(StringPiece(e_skeleton.data(), e_skeleton.size()));
+    e.WriteRawBytes(skeleton);
     // (D1) & (D2)
     e.WriteVarlengthBeginning(TensorProto::kTensorContentFieldNumber,
                               tdata.size());
@@ -218,7 +332,7 @@ void EncodeTensorToByteBuffer(bool is_dead, const Tensor& val, bool require_ack,
     {
       size_t slice_len =
           e.size() + (share_tensor_slice_memory ? 0 : tdata.size());
-      slices[0] = ::grpc::Slice(slice_len);
+      slices[0] = SliceBufferPool::MakeSlice(slice_len);
       memcpy(const_cast<uint8_t*>(slices[0].begin()), e.data(), e.size());
       if (!share_tensor_slice_memory) {
         // (E)
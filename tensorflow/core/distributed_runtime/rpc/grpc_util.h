@@ -27,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/protobuf.h"
+#include "tensorflow/core/platform/refcount.h"
 
 namespace tensorflow {
 // NOLINTBEGIN(misc-unused-using-decls)
@@ -35,6 +36,17 @@ using tsl::SharedGrpcChannelPtr;
 using tsl::ToGrpcStatus;
 // NOLINTEND(misc-unused-using-decls)
 
+// Keeps the slices underlying a ::grpc::ByteBuffer alive for tensors that
+// alias transport memory; see TensorResponse::Source::MaybeGetOwnedBufferRef.
+class OwnedGrpcByteBuffer : public core::RefCounted {
+ public:
+  explicit OwnedGrpcByteBuffer(const ::grpc::ByteBuffer& buffer)
+      : buffer_(buffer) {}
+
+ private:
+  ::grpc::ByteBuffer buffer_;
+};
+
 // Thin wrapper around ::grpc::ProtoBufferReader to give TensorResponse
 // an efficient byte reader from which to decode a RecvTensorResponse.
 class GrpcByteSource : public TensorResponse::Source {
@@ -50,6 +62,13 @@ class GrpcByteSource : public TensorResponse::Source {
     return stream_;
   }
 
+  core::RefCounted* MaybeGetOwnedBufferRef() override {
+    // Copying a ByteBuffer shares ownership of the underlying slices, so
+    // holding a copy keeps the received payload alive for as long as any
+    // tensor aliases it.
+    return new OwnedGrpcByteBuffer(*buffer_);
+  }
+
  private:
   void DeleteStream() {
     if (stream_) {
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_worker_cache.h"
 
+#include <algorithm>
+
 #include "tensorflow/core/distributed_runtime/rpc/coordination/grpc_coordination_client.h"
 #include "tensorflow/core/distributed_runtime/rpc/eager/grpc_eager_client.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_remote_worker.h"
@@ -30,6 +32,22 @@ namespace tensorflow {
 
 namespace {
 
+// Number of completion queues from the worker cache pool reserved for bulk
+// tensor traffic (RecvTensor, RecvBuf).  When positive, each target gets a
+// control queue from the remaining pool and a bulk queue from the reserved
+// set, so large tensor completions do not delay latency-sensitive control
+// RPCs such as step setup.  Zero (the default) keeps all traffic for a
+// target on one queue.
+size_t NumBulkLaneQueues() {
+  static const size_t num_bulk_lane_queues = [] {
+    int64_t num_queues;
+    TF_CHECK_OK(ReadInt64FromEnvVar("TF_GRPC_WORKER_BULK_LANE_QUEUES",
+                                    /*default_val=*/0, &num_queues));
+    return num_queues < 0 ? 0 : static_cast<size_t>(num_queues);
+  }();
+  return num_bulk_lane_queues;
+}
+
 class GrpcWorkerCache : public WorkerCachePartial {
  public:
   explicit GrpcWorkerCache(std::shared_ptr<GrpcChannelCache> channel_cache,
@@ -59,9 +77,18 @@ class GrpcWorkerCache : public WorkerCachePartial {
       if (!channel) {
         return nullptr;
       }
-      size_t index = AssignWorkerToThread(target);
+      size_t ordinal = AssignWorkerToThread(target);
+      const size_t num_queues = worker_env_->CompletionQueueSize();
+      // Reserve the last NumBulkLaneQueues() queues for bulk tensor traffic,
+      // keeping at least one control queue.
+      const size_t num_bulk = std::min(NumBulkLaneQueues(), num_queues - 1);
+      const size_t num_control = num_queues - num_bulk;
+      const size_t control_index = ordinal % num_control;
+      const size_t bulk_index =
+          num_bulk == 0 ? control_index : num_control + ordinal % num_bulk;
       return NewGrpcRemoteWorker(
-          channel, worker_env_->GetCompletionQueue(index),
+          channel, worker_env_->GetCompletionQueue(control_index),
+          worker_env_->GetCompletionQueue(bulk_index),
           worker_env_->GetThreadPool(), &logger_, target);
     }
   }
@@ -99,14 +126,14 @@ class GrpcWorkerCache : public WorkerCachePartial {
  private:
   size_t AssignWorkerToThread(const string& target) {
     // Round-robin target assignment, but keeps the same target on the same
-    // polling thread always, as this is important for gRPC performance
+    // polling thread always, as this is important for gRPC performance.
+    // Returns the target's assignment ordinal; callers map it onto the
+    // control and bulk queue partitions.
     mutex_lock lock(assignment_mu_);
     auto it = target_assignments_.find(target);
     if (it == target_assignments_.end()) {
       it = target_assignments_
-               .insert(std::make_pair(target,
-                                      (next_round_robin_assignment_++) %
-                                          worker_env_->CompletionQueueSize()))
+               .insert(std::make_pair(target, next_round_robin_assignment_++))
                .first;
     }
     return it->second;
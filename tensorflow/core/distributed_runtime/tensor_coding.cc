@@ -15,9 +15,12 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/tensor_coding.h"
 
+#include <cstdint>
+
 #include "google/protobuf/any.pb.h"
 
 #include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
 
@@ -141,10 +144,34 @@ bool ReadNestedMessage(protobuf::io::CodedInputStream* input,
   return input->DecrementRecursionDepthAndPopLimit(p.first);
 }
 
+// A TensorBuffer that aliases memory owned by the RPC transport.  The
+// transport buffer is kept alive by a reference obtained from
+// TensorResponse::Source::MaybeGetOwnedBufferRef.
+class TransportTensorBuffer : public TensorBuffer {
+ public:
+  TransportTensorBuffer(void* data, size_t size, core::RefCounted* owner)
+      : TensorBuffer(data), size_(size), owner_(owner) {}
+  ~TransportTensorBuffer() override { owner_->Unref(); }
+
+  size_t size() const override { return size_; }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(size_);
+    proto->set_allocated_bytes(size_);
+    proto->set_allocator_name("rpc_transport");
+  }
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  size_t size_;
+  core::RefCounted* owner_;  // Owned reference.
+};
+
 }  // namespace
 
 bool TensorResponse::ParseTensorSubmessage(
-    protobuf::io::CodedInputStream* input, TensorProto* tensor_meta) {
+    protobuf::io::CodedInputStream* input, TensorProto* tensor_meta,
+    Source* source) {
   bool seen_tensor_content = false;
   while (true) {
     auto p = input->ReadTagWithCutoff(127);
@@ -195,12 +222,32 @@ bool TensorResponse::ParseTensorSubmessage(
         if (!ReadVarintSizeAsInt(input, &num_bytes)) return false;
         seen_tensor_content = true;
         TensorShape shape(tensor_meta->tensor_shape());
+        // If the source can extend the lifetime of the transport buffer and
+        // the content is contiguous and sufficiently aligned, alias the
+        // received bytes directly instead of copying them out.
+        const int64_t expected_bytes =
+            shape.num_elements() * DataTypeSize(tensor_meta->dtype());
+        const void* data = nullptr;
+        int direct_size = 0;
+        if (num_bytes > 0 && source != nullptr &&
+            static_cast<int64_t>(num_bytes) == expected_bytes &&
+            input->GetDirectBufferPointer(&data, &direct_size) &&
+            direct_size >= num_bytes &&
+            (EIGEN_MAX_ALIGN_BYTES == 0 ||
+             reinterpret_cast<uintptr_t>(data) % EIGEN_MAX_ALIGN_BYTES == 0)) {
+          core::RefCounted* owner = source->MaybeGetOwnedBufferRef();
+          if (owner != nullptr) {
+            auto* buf = new TransportTensorBuffer(const_cast<void*>(data),
+                                                 num_bytes, owner);
+            tensor_ = Tensor(tensor_meta->dtype(), shape, buf);
+            buf->Unref();
+            if (!input->Skip(num_bytes)) return false;
+            break;
+          }
+        }
         Tensor t(allocator_, tensor_meta->dtype(), shape);
         StringPiece buf = t.tensor_data();
         if (static_cast<size_t>(num_bytes) != buf.size()) return false;
-        // TODO(jeff,sanjay): Figure out a way to avoid this copy if
-        // the underlying ZeroCopyInputStream data is properly aligned
-        // and compatible with what allocator_ wants.
         if (!input->ReadRaw(const_cast<char*>(buf.data()), num_bytes))
           return false;
         tensor_ = std::move(t);
@@ -233,7 +280,7 @@ bool TensorResponse::ParseFast(Source* source) {
         std::pair<protobuf::io::CodedInputStream::Limit, int> p =
             input.IncrementRecursionDepthAndPushLimit(length);
         if (p.second < 0 ||
-            !ParseTensorSubmessage(&input, meta_.mutable_tensor())) {
+            !ParseTensorSubmessage(&input, meta_.mutable_tensor(), source)) {
           return false;
         }
         if (!input.DecrementRecursionDepthAndPopLimit(p.first)) {
@@ -20,6 +20,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/protobuf.h"
+#include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/protobuf/worker.pb.h"
 
@@ -63,6 +64,13 @@ class TensorResponse {
     // Ownership of the returned stream is retained by the Source and
     // should not be deleted by the caller.
     virtual ::tensorflow::protobuf::io::ZeroCopyInputStream* contents() = 0;
+
+    // Returns a new reference on an object that keeps the memory backing
+    // the most recent stream returned by contents() alive, or nullptr if
+    // the source cannot extend the lifetime of that memory.  When this
+    // returns non-null, ParseFrom may build a tensor whose buffer aliases
+    // the stream contents instead of copying them into a new allocation.
+    virtual core::RefCounted* MaybeGetOwnedBufferRef() { return nullptr; }
   };
 
   // Parse the RecvTensorResponse encoded in the data yielded by
@@ -92,7 +100,7 @@ class TensorResponse {
 
  private:
   bool ParseTensorSubmessage(protobuf::io::CodedInputStream* input,
-                             TensorProto* tensor_meta);
+                             TensorProto* tensor_meta, Source* source);
   bool ParseFast(Source* source);
   bool ParseSlow(Source* source);
 
@@ -15,6 +15,9 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/tensor_coding.h"
 
+#include <cstring>
+#include <memory>
+
 #include "tensorflow/core/framework/device_attributes.pb.h"
 #include "tensorflow/core/framework/device_base.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -22,7 +25,9 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mem.h"
 #include "tensorflow/core/platform/protobuf.h"
+#include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/platform/test_benchmark.h"
 #include "tensorflow/core/protobuf/worker.pb.h"
@@ -156,6 +161,70 @@ TEST_F(TensorResponseTest, Simple) {
 
 TEST_F(TensorResponseTest, StringTensor) { DoTestForStrings(DT_STRING); }
 
+// A source over a flat buffer that claims it can extend the lifetime of the
+// buffer, which lets ParseFrom alias aligned tensor content in place.
+class AliasingSource : public TensorResponse::Source {
+ public:
+  AliasingSource(const char* data, size_t size) : data_(data), size_(size) {}
+
+  protobuf::io::ZeroCopyInputStream* contents() override {
+    stream_ =
+        std::make_unique<protobuf::io::ArrayInputStream>(data_, size_);
+    return stream_.get();
+  }
+
+  core::RefCounted* MaybeGetOwnedBufferRef() override {
+    // The buffer outlives the parsed tensors in this test, so a plain
+    // refcount stand-in is sufficient.
+    return new core::RefCounted;
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  std::unique_ptr<protobuf::io::ArrayInputStream> stream_;
+};
+
+TEST_F(TensorResponseTest, AliasesAlignedTensorContent) {
+  Tensor src(DT_FLOAT, TensorShape({64}));
+  for (int i = 0; i < 64; ++i) {
+    src.flat<float>()(i) = static_cast<float>(i);
+  }
+  RecvTensorResponse proto;
+  proto.set_is_dead(false);
+  proto.set_send_start_micros(123456);
+  src.AsProtoTensorContent(proto.mutable_tensor());
+  string encoded;
+  proto.AppendToString(&encoded);
+
+  DummyDevice cpu_device(Env::Default());
+  // The offset of the tensor content within the message is fixed, so exactly
+  // one start offset per alignment period makes the content aligned enough to
+  // alias.  Every other offset must fall back to the copying path and still
+  // produce the right values.
+  const int alignment = EIGEN_MAX_ALIGN_BYTES > 0 ? EIGEN_MAX_ALIGN_BYTES : 64;
+  char* buffer = static_cast<char*>(
+      port::AlignedMalloc(encoded.size() + alignment, alignment));
+  int num_aliased = 0;
+  for (int offset = 0; offset < alignment; ++offset) {
+    char* start = buffer + offset;
+    memcpy(start, encoded.data(), encoded.size());
+    AliasingSource source(start, encoded.size());
+    TensorResponse response;
+    response.InitAlloc(&cpu_device, AllocatorAttributes());
+    Status s = response.ParseFrom(&source);
+    EXPECT_TRUE(s.ok());
+    const Tensor& result = response.tensor();
+    test::ExpectTensorEqual<float>(result, src);
+    const char* result_data = result.tensor_data().data();
+    if (result_data >= start && result_data < start + encoded.size()) {
+      ++num_aliased;
+    }
+  }
+  port::AlignedFree(buffer);
+  EXPECT_GE(num_aliased, 1);
+}
+
 string MakeFloatTensorTestCase(int num_elems) {
   std::vector<int8> v(num_elems);
   for (int i = 0; i < num_elems; i++) {
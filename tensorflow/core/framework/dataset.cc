@@ -21,6 +21,7 @@ limitations under the License.
 #include "tensorflow/core/framework/dataset.pb.h"
 #include "tensorflow/core/framework/device_base.h"
 #include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/resource_mgr.h"
 #include "tensorflow/core/framework/variant_encode_decode.h"
@@ -37,6 +38,7 @@ limitations under the License.
 #include "tensorflow/core/platform/strcat.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/public/version.h"
+#include "tensorflow/core/util/env_var.h"
 
 // On Windows, disable some macros that would break compile
 #if defined(PLATFORM_WINDOWS)
@@ -62,6 +64,24 @@ std::string UniqueNodeName(const std::string& base) {
   return strings::StrCat(base, "/", counter.fetch_add(1));
 }
 
+// Returns whether per-stage `GetNext()` latency and buffer occupancy
+// histograms should be exported (keyed by iterator prefix). Controlled by the
+// environment variable `TF_DATA_STAGE_METRICS`. The histogram cells are
+// resolved once per iterator, so leaving the collection enabled costs each
+// `GetNext()` call only two clock reads and two histogram additions.
+bool StageMetricsEnabled() {
+  static const bool enabled = [] {
+    bool value = false;
+    Status status =
+        ReadBoolFromEnvVar("TF_DATA_STAGE_METRICS", false, &value);
+    if (!status.ok()) {
+      LOG(ERROR) << status;
+    }
+    return value;
+  }();
+  return enabled;
+}
+
 // A wrapper class for storing a `DatasetBase` instance in a DT_VARIANT tensor.
 // Objects of the wrapper class own a reference on an instance of `DatasetBase`,
 // and the wrapper's copy constructor and destructor take care of managing the
@@ -497,6 +517,11 @@ void MemoryCheckpoint::Merge(MemoryCheckpoint* other) {
   }
 
   other->expired_prefixes_.clear();
+
+  // Like expired prefixes, updated names only need to be propagated once.
+  updated_names_.insert(other->updated_names_.begin(),
+                        other->updated_names_.end());
+  other->updated_names_.clear();
   VLOG(5) << "MemoryCheckpoint::Merge " << DebugString();
 }
 
@@ -507,6 +532,7 @@ void MemoryCheckpoint::Purge(const std::string& prefix) {
     str_values_.erase(id);
     tensor_values_.erase(id);
   }
+  updated_names_.insert(prefix);
   if (!is_root_) {
     expired_prefixes_.insert(prefix);
   } else {
@@ -517,16 +543,31 @@ void MemoryCheckpoint::Purge(const std::string& prefix) {
 }
 
 Status MemoryCheckpoint::Save(IteratorStateWriter* writer) const {
+  return Save(writer, /*names_to_skip=*/{});
+}
+
+Status MemoryCheckpoint::Save(
+    IteratorStateWriter* writer,
+    const absl::flat_hash_set<std::string>& names_to_skip) const {
   for (const auto& [id, value] : int_values_) {
     auto [prefix, key] = id_registry_->Get(id);
+    if (names_to_skip.contains(prefix)) {
+      continue;
+    }
     TF_RETURN_IF_ERROR(writer->WriteScalar(prefix, key, value));
   }
   for (const auto& [id, value] : str_values_) {
     auto [prefix, key] = id_registry_->Get(id);
+    if (names_to_skip.contains(prefix)) {
+      continue;
+    }
     TF_RETURN_IF_ERROR(writer->WriteScalar(prefix, key, value));
   }
   for (const auto& [id, value] : tensor_values_) {
     auto [prefix, key] = id_registry_->Get(id);
+    if (names_to_skip.contains(prefix)) {
+      continue;
+    }
     TF_RETURN_IF_ERROR(writer->WriteTensor(prefix, key, value));
   }
   return OkStatus();
@@ -1079,6 +1120,11 @@ DatasetBaseIterator::DatasetBaseIterator(const BaseParams& params)
     : params_(params) {
   params_.dataset->Ref();
   VLOG(2) << prefix() << " constructor";
+  if (StageMetricsEnabled()) {
+    stage_latency_cell_ = metrics::GetTFDataStageLatencySampler(params_.prefix);
+    stage_buffered_elements_cell_ =
+        metrics::GetTFDataStageBufferedElementsSampler(params_.prefix);
+  }
   strings::StrAppend(&traceme_metadata_, "name=", dataset()->metadata().name());
   strings::StrAppend(&traceme_metadata_, ",shapes=");
   auto& shapes = output_shapes();
@@ -1141,6 +1187,10 @@ Status DatasetBaseIterator::GetNext(IteratorContext* ctx,
   profiler::TraceMe activity([&] { return BuildTraceMeName(); },
                              profiler::TraceMeLevel::kInfo);
   DVLOG(3) << prefix() << " GetNext enter";
+  uint64 stage_start_us = 0;
+  if (TF_PREDICT_FALSE(stage_latency_cell_ != nullptr)) {
+    stage_start_us = EnvTime::NowMicros();
+  }
   auto model = ctx->model();
   bool output_was_recording =
       node_ && node_->output() && node_->output()->is_recording();
@@ -1175,6 +1225,12 @@ Status DatasetBaseIterator::GetNext(IteratorContext* ctx,
       node_->output()->record_start(now_nanos);
     }
   }
+  if (TF_PREDICT_FALSE(stage_latency_cell_ != nullptr)) {
+    stage_latency_cell_->Add(EnvTime::NowMicros() - stage_start_us);
+    if (node_) {
+      stage_buffered_elements_cell_->Add(node_->buffered_elements());
+    }
+  }
   if (TF_PREDICT_FALSE(errors::IsOutOfRange(s))) {
     s = errors::Internal("Iterator \"", params_.prefix,
                          "\" returned `OutOfRange`. This indicates an "
@@ -1224,6 +1280,65 @@ Status DatasetBaseIterator::Skip(IteratorContext* ctx, int num_to_skip,
   return s;
 }
 
+Status DatasetBaseIterator::GetNextN(
+    IteratorContext* ctx, int max_elements,
+    std::vector<std::vector<Tensor>>* out_elements, bool* end_of_sequence) {
+  profiler::TraceMe activity([&] { return BuildTraceMeName(); },
+                             profiler::TraceMeLevel::kInfo);
+  DVLOG(3) << prefix() << " GetNextN enter";
+  auto model = ctx->model();
+  bool output_was_recording =
+      node_ && node_->output() && node_->output()->is_recording();
+  if (collect_resource_usage(ctx)) {
+    int64_t now_nanos = EnvTime::NowNanos();
+    if (output_was_recording) {
+      node_->output()->record_stop(now_nanos);
+    }
+    node_->record_start(now_nanos);
+  }
+  out_elements->clear();
+  out_elements->reserve(max_elements);
+  *end_of_sequence = false;
+  Status s;
+  for (int i = 0; i < max_elements && !*end_of_sequence; ++i) {
+    std::vector<Tensor> element;
+    s = GetNextInternal(ctx, &element, end_of_sequence);
+    ctx->SaveCheckpoint(this);
+    if (!SymbolicCheckpointCompatible()) {
+      ctx->UpdateCheckpointStatus([this]() {
+        return errors::Unimplemented(
+            dataset()->type_string(),
+            " does not support symbolic checkpointing.");
+      });
+    }
+    if (!s.ok()) {
+      break;
+    }
+    if (!*end_of_sequence) {
+      DCHECK_EQ(element.size(), dataset()->output_dtypes().size());
+      RecordElement(ctx, &element);
+      out_elements->push_back(std::move(element));
+    }
+  }
+  if (collect_resource_usage(ctx)) {
+    int64_t now_nanos = EnvTime::NowNanos();
+    node_->record_stop(now_nanos);
+    if (output_was_recording) {
+      node_->output()->record_start(now_nanos);
+    }
+  }
+  if (TF_PREDICT_FALSE(errors::IsOutOfRange(s))) {
+    s = errors::Internal("Iterator \"", params_.prefix,
+                         "\" returned `OutOfRange`. This indicates an "
+                         "implementation error as `OutOfRange` errors are not "
+                         "expected to be returned here. Original message: ",
+                         s.message());
+    LOG(ERROR) << s;
+  }
+  DVLOG(3) << prefix() << " GetNextN exit";
+  return s;
+}
+
 Status DatasetBaseIterator::SkipInternal(IteratorContext* ctx, int num_to_skip,
                                          bool* end_of_sequence,
                                          int* num_skipped) {
@@ -53,6 +53,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/core/threadpool_interface.h"
+#include "tensorflow/core/lib/monitoring/sampler.h"
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/cpu_info.h"
@@ -493,6 +494,7 @@ class MemoryCheckpoint final : public IteratorStateWriter {
   Status WriteScalar(StringPiece name, StringPiece key, int64_t val) override {
     auto id = id_registry_->Add(string(name), string(key));
     int_values_[id] = val;
+    updated_names_.insert(string(name));
     return OkStatus();
   }
   Status WriteScalar(StringPiece key, const tstring& val) override {
@@ -504,6 +506,7 @@ class MemoryCheckpoint final : public IteratorStateWriter {
                      const tstring& val) override {
     auto id = id_registry_->Add(string(name), string(key));
     str_values_[id] = val;
+    updated_names_.insert(string(name));
     return OkStatus();
   }
   Status WriteTensor(StringPiece key, const Tensor& val) override {
@@ -515,6 +518,7 @@ class MemoryCheckpoint final : public IteratorStateWriter {
                      const Tensor& val) override {
     auto id = id_registry_->Add(string(name), string(key));
     tensor_values_[id] = val;
+    updated_names_.insert(string(name));
     return OkStatus();
   }
   // END implementation of `IteratorStateWriter` interface
@@ -538,6 +542,23 @@ class MemoryCheckpoint final : public IteratorStateWriter {
   // Stores the in-memory checkpoint to the given writer.
   Status Save(IteratorStateWriter* writer) const;
 
+  // Stores the in-memory checkpoint to the given writer, skipping entries
+  // whose iterator name is in `names_to_skip`. Used by incremental saves to
+  // avoid re-serializing iterators whose state is known to be unchanged.
+  Status Save(IteratorStateWriter* writer,
+              const absl::flat_hash_set<std::string>& names_to_skip) const;
+
+  // Returns the iterator names whose state was written, merged, or purged
+  // since the last call to `ClearUpdatedNames`. Used by incremental saves to
+  // decide which iterators need to be re-serialized.
+  const absl::flat_hash_set<std::string>& GetUpdatedNames() const {
+    return updated_names_;
+  }
+
+  // Clears the set of updated iterator names. Called after an incremental
+  // save has captured the corresponding state.
+  void ClearUpdatedNames() { updated_names_.clear(); }
+
   // Updates the status of the in-memory checkpoint with the given status.
   void UpdateStatus(Status status) { status_.Update(status); }
 
@@ -557,6 +578,10 @@ class MemoryCheckpoint final : public IteratorStateWriter {
   // Keeps track of expired prefixes for propagation. Cleaned after it's merged.
   absl::flat_hash_set<std::string> expired_prefixes_;
 
+  // Iterator names updated since the last `ClearUpdatedNames` call; see
+  // `GetUpdatedNames`.
+  absl::flat_hash_set<std::string> updated_names_;
+
   std::shared_ptr<IdRegistry> id_registry_;
 };
 
@@ -1086,6 +1111,30 @@ class IteratorBase : public Checkpointable {
     return Skip(&ctx, num_to_skip, end_of_sequence, num_skipped);
   }
 
+  // Gets up to `max_elements` of the next outputs from the range that this
+  // iterator is traversing, amortizing per-call overhead across elements.
+  //
+  // The produced elements are appended to `*out_elements`, which is cleared
+  // first. If the end of sequence is reached before `max_elements` outputs
+  // have been produced, `true` will be stored in `*end_of_sequence` and
+  // `*out_elements` will hold the outputs produced before the end of the
+  // sequence.
+  virtual Status GetNextN(IteratorContext* ctx, int max_elements,
+                          std::vector<std::vector<Tensor>>* out_elements,
+                          bool* end_of_sequence) {
+    out_elements->clear();
+    *end_of_sequence = false;
+    for (int i = 0; i < max_elements; ++i) {
+      std::vector<Tensor> element;
+      TF_RETURN_IF_ERROR(GetNext(ctx, &element, end_of_sequence));
+      if (*end_of_sequence) {
+        return OkStatus();
+      }
+      out_elements->push_back(std::move(element));
+    }
+    return OkStatus();
+  }
+
   // Returns a vector of DataType values, representing the respective
   // element types of each tuple component in the outputs of this
   // iterator.
@@ -1523,6 +1572,10 @@ class DatasetBaseIterator : public IteratorBase {
   Status Skip(IteratorContext* ctx, int num_to_skip, bool* end_of_sequence,
               int* num_skipped) final;
 
+  Status GetNextN(IteratorContext* ctx, int max_elements,
+                  std::vector<std::vector<Tensor>>* out_elements,
+                  bool* end_of_sequence) final;
+
   Status Save(SerializationContext* ctx, IteratorStateWriter* writer) final {
     VLOG(2) << "Attempting to save checkpoints on iterator (prefix: "
             << prefix() << ") from " << dataset()->DebugString();
@@ -1652,6 +1705,14 @@ class DatasetBaseIterator : public IteratorBase {
 
   string traceme_metadata_;
   BaseParams params_;
+
+  // Cells of the per-stage latency and buffer occupancy histograms, keyed by
+  // the iterator prefix, or `nullptr` if stage-level metrics collection is
+  // disabled. The cells are resolved once at construction time so that the
+  // per-`GetNext()` cost is limited to two clock reads and two histogram
+  // additions.
+  monitoring::SamplerCell* stage_latency_cell_ = nullptr;
+  monitoring::SamplerCell* stage_buffered_elements_cell_ = nullptr;
 };
 
 // Represents an iterator that is associated with a particular dataset
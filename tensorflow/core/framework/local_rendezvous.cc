@@ -141,13 +141,21 @@ LocalRendezvous::~LocalRendezvous() {
 }
 
 namespace {
-uint64 KeyHash(const StringPiece& k) { return Hash64(k.data(), k.size()); }
+// Prefers the hash cached in the parsed key (filled in by
+// Rendezvous::ParseKey, and cached across steps by the Send/Recv
+// kernels); keys built by hand fall back to hashing the string here.
+uint64 KeyHash(const Rendezvous::ParsedKey& k) {
+  const uint64 hash = k.KeyHash();
+  if (hash != 0) return hash;
+  const StringPiece key = k.FullKey();
+  return Hash64(key.data(), key.size());
+}
 }  // namespace
 
 Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
                              const Rendezvous::Args& send_args,
                              const Tensor& val, const bool is_dead) {
-  uint64 key_hash = KeyHash(key.FullKey());
+  uint64 key_hash = KeyHash(key);
   DVLOG(2) << "Send " << this << " " << key_hash << " " << key.FullKey();
 
   if (is_dead) {
@@ -226,7 +234,7 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
 void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
                                 const Rendezvous::Args& recv_args,
                                 Rendezvous::DoneCallback done) {
-  uint64 key_hash = KeyHash(key.FullKey());
+  uint64 key_hash = KeyHash(key);
   DVLOG(2) << "Recv " << this << " " << key_hash << " " << key.FullKey();
   tsl::core::RefCountPtr<Rendezvous> rc_keep_alive;
 
@@ -400,6 +408,9 @@ void LocalRendezvous::DoAbort(const Status& status) {
   {
     mutex_lock l(mu_);
     status_.Update(status);
+    // Publish the abort after `status_` is set, so that a caller observing
+    // `aborted_` in `status()` reads the non-OK status under `mu_`.
+    aborted_.store(true, std::memory_order_release);
   }
   LOG_EVERY_POW_2(INFO) << "Local rendezvous is aborting with status: "
                         << status;
@@ -436,6 +447,12 @@ void LocalRendezvous::DoAbort(const Status& status) {
 }
 
 Status LocalRendezvous::status() {
+  // Avoid taking `mu_` on the common (non-aborted) path: even a shared lock
+  // bounces the mutex cache line between cores when many same-process
+  // Send/Recv pairs run concurrently.
+  if (TF_PREDICT_TRUE(!aborted_.load(std::memory_order_acquire))) {
+    return OkStatus();
+  }
   tf_shared_lock ml(mu_);
   return status_;
 }
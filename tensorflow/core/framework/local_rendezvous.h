@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_LOCAL_RENDEZVOUS_H_
 #define TENSORFLOW_CORE_FRAMEWORK_LOCAL_RENDEZVOUS_H_
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -100,6 +101,12 @@ class LocalRendezvous {
 
   // Immutable set of buckets. This uses less memory than std::vector.
   const std::unique_ptr<TableBucket[]> table_buckets_;
+
+  // Fast-path flag for `status()`. Set to true (with release semantics) after
+  // `status_` has been updated to a non-OK value, so that Send/Recv calls on
+  // a healthy rendezvous can skip acquiring `mu_` entirely. `mu_` is only
+  // taken once the rendezvous has started aborting.
+  std::atomic<bool> aborted_{false};
   mutex mu_;
   Status status_ TF_GUARDED_BY(mu_);
 
@@ -161,6 +161,25 @@ auto* tf_data_get_next_duration_usecs_histogram =
         {tsl::monitoring::Buckets::Explicit(
             {2., 4., 8., 16., 32., 64., 128., 256., 512., 1024., 1e6})});
 
+auto* tf_data_stage_getnext_duration_usecs_histogram =
+    tsl::monitoring::Sampler<1>::New(
+        {"/tensorflow/data/stage_getnext_duration",
+         "Microseconds spent fetching an element from the given tf.data "
+         "iterator stage.",
+         "stage"},
+        // Power of 2 with bucket count 10 (1024 microseconds) and 1 second.
+        {tsl::monitoring::Buckets::Explicit(
+            {2., 4., 8., 16., 32., 64., 128., 256., 512., 1024., 1e6})});
+
+auto* tf_data_stage_buffered_elements_histogram =
+    tsl::monitoring::Sampler<1>::New(
+        {"/tensorflow/data/stage_buffered_elements",
+         "Number of elements buffered by the given tf.data iterator stage "
+         "when a `GetNext()` call on the stage completes.",
+         "stage"},
+        // Power of 2 with bucket count of 15 (from 1 to 16384 elements).
+        {tsl::monitoring::Buckets::Exponential(1, 2, 15)});
+
 auto* tf_data_used_vs_budget_ratio_histogram = tsl::monitoring::Sampler<0>::New(
     {"/tensorflow/data/used_vs_budget_ratio",
      "Ratio of tf.data used ram over ram budget when running optimization."},
@@ -225,6 +244,12 @@ auto* tf_data_service_cross_trainer_cache_size_bytes =
         "/tensorflow/data/service/cross_trainer_cache_size_bytes",
         "tf.data service cross-trainer cache memory usage in bytes.");
 
+auto* tf_data_service_cross_trainer_cache_evictions_counter =
+    tsl::monitoring::Counter<0>::New(
+        "/tensorflow/data/service/cross_trainer_cache_evictions",
+        "Number of elements evicted from tf.data service cross-trainer "
+        "caches.");
+
 auto* tf_data_service_snapshot_bytes_committed =
     tsl::monitoring::Counter<0>::New(
         "/tensorflow/data/service/snapshot_bytes_committed",
@@ -330,6 +355,13 @@ auto* tf_data_autotune_stopping_criteria_counter =
         "algorithm stopping criterion is met.",
         "name");
 
+auto* tf_data_autotune_parallelism_decision_counter =
+    tsl::monitoring::Counter<2>::New(
+        "/tensorflow/data/autotune_parallelism_decision",
+        "The number of times tf.data autotuning increased, decreased, or "
+        "held back a change to the parallelism of a node.",
+        "name", "decision");
+
 auto* tf_data_debug = tsl::monitoring::Counter<1>::New(
     "/tensorflow/data/debug",
     "The number of times this event occured, for debugging.", "event");
@@ -443,11 +475,46 @@ auto* eager_client_error_counter = tsl::monitoring::Counter<2>::New(
     "Count the errors in eager client as a central place.", "error_source",
     "error_type");
 
+auto* eager_op_cost_count = tsl::monitoring::Counter<1>::New(
+    "/tensorflow/core/eager_op_cost_count",
+    "Number of sampled eager op executions, by op type.", "op_type");
+
+auto* eager_op_cost_usecs = tsl::monitoring::Counter<1>::New(
+    "/tensorflow/core/eager_op_cost_usecs",
+    "Accumulated wall time in microseconds of sampled eager op executions, "
+    "by op type.",
+    "op_type");
+
+auto* eager_op_cost_bytes = tsl::monitoring::Counter<1>::New(
+    "/tensorflow/core/eager_op_cost_bytes",
+    "Accumulated input and output tensor bytes of sampled eager op "
+    "executions, by op type.",
+    "op_type");
+
 auto* mlir_bridge_first_phase_counter = tsl::monitoring::Counter<5>::New(
     "/tensorflow/core/tf_mlir_bridge_first_phase_v2_count",
     "Tracks processing state in first phase of mlir bridge", "bridge",
     "version", "device", "fallback", "result");
 
+auto* mlir_bridge_pass_time_usecs = tsl::monitoring::Counter<1>::New(
+    "/tensorflow/core/tf_mlir_bridge_pass_time_usecs",
+    "The total wall time spent in a single MLIR pass of the TF-to-XLA bridge "
+    "pass pipelines, in microseconds.",
+    "pass");
+
+auto* mlir_bridge_pass_ir_size = tsl::monitoring::Sampler<1>::New(
+    {"/tensorflow/core/tf_mlir_bridge_pass_ir_size",
+     "The number of MLIR operations in the IR observed after a single pass "
+     "of the TF-to-XLA bridge pass pipelines.",
+     "pass"},
+    // Power of 2 with bucket count 20 (> 1M operations).
+    {tsl::monitoring::Buckets::Exponential(1, 2, 20)});
+
+auto* mlir_bridge_lowering_cache_count = tsl::monitoring::Counter<1>::New(
+    "/tensorflow/core/tf_mlir_bridge_lowering_cache",
+    "Tracks hits and misses in the MLIR bridge cache of lowered modules.",
+    "status");
+
 auto* mlir_second_phase_count = tensorflow::monitoring::Counter<1>::New(
     "/tensorflow/core/tf2xla/api/v2/phase2_compilation_status" /*metric_name*/,
     "Counts the number of graphs that were analyzed prior deciding whether "
@@ -475,6 +542,32 @@ tsl::monitoring::Counter<2>* GetGraphOptimizationCounter() {
   return graph_optimization_counter;
 }
 
+tsl::monitoring::Counter<2>* GetGraphOptimizationEffectCounter() {
+  static auto* graph_optimization_effect_counter =
+      tsl::monitoring::Counter<2>::New(
+          "/tensorflow/core/graph_optimization_effect",
+          "The cumulative effect of each graph optimization pass on the "
+          "graph, keyed by pass name and effect kind.",
+          "name", "kind");
+  return graph_optimization_effect_counter;
+}
+
+void UpdateGraphOptimizationPassEffect(const string& pass_name,
+                                       int64_t node_delta,
+                                       int64_t byte_delta) {
+  auto* counter = GetGraphOptimizationEffectCounter();
+  if (node_delta >= 0) {
+    counter->GetCell(pass_name, "nodes_added")->IncrementBy(node_delta);
+  } else {
+    counter->GetCell(pass_name, "nodes_removed")->IncrementBy(-node_delta);
+  }
+  if (byte_delta >= 0) {
+    counter->GetCell(pass_name, "bytes_added")->IncrementBy(byte_delta);
+  } else {
+    counter->GetCell(pass_name, "bytes_removed")->IncrementBy(-byte_delta);
+  }
+}
+
 std::string GraphOptimizationSourceMapping(GraphOptimizationSource source) {
   switch (source) {
     case GraphOptimizationSource::kJit:
@@ -526,6 +619,16 @@ tsl::monitoring::GaugeCell<double>* GetTFDataPipelineProcessingTimeGauge(
   return tf_data_pipeline_processing_time->GetCell(id);
 }
 
+tsl::monitoring::SamplerCell* GetTFDataStageLatencySampler(
+    const string& stage) {
+  return tf_data_stage_getnext_duration_usecs_histogram->GetCell(stage);
+}
+
+tsl::monitoring::SamplerCell* GetTFDataStageBufferedElementsSampler(
+    const string& stage) {
+  return tf_data_stage_buffered_elements_histogram->GetCell(stage);
+}
+
 void RecordTFDataBytesFetched(int64_t num_bytes) {
   tf_data_bytes_fetched_counter->GetCell()->IncrementBy(num_bytes);
 }
@@ -675,6 +778,11 @@ void RecordTFDataServiceCrossTrainerCacheSizeBytes(size_t bytes) {
       static_cast<int64_t>(bytes));
 }
 
+void RecordTFDataServiceCrossTrainerCacheEvictions(int64_t num_elements) {
+  tf_data_service_cross_trainer_cache_evictions_counter->GetCell()
+      ->IncrementBy(num_elements);
+}
+
 void RecordTFDataServiceSnapshotBytesCommitted(int64_t bytes) {
   tf_data_service_snapshot_bytes_committed->GetCell()->IncrementBy(bytes);
 }
@@ -738,6 +846,12 @@ void RecordTFDataAutotuneStoppingCriteria(const string& name) {
   tf_data_autotune_stopping_criteria_counter->GetCell(name)->IncrementBy(1);
 }
 
+void RecordTFDataAutotuneParallelismDecision(const string& name,
+                                             const string& decision) {
+  tf_data_autotune_parallelism_decision_counter->GetCell(name, decision)
+      ->IncrementBy(1);
+}
+
 void RecordTFDataDebug(const string& event) {
   tf_data_debug->GetCell(event)->IncrementBy(1);
 }
@@ -961,6 +1075,21 @@ void UpdateTfMlirBridgeFirstPhaseCounter(const std::string& bridge_type,
       ->IncrementBy(1);
 }
 
+void UpdateTfMlirBridgePassTime(const std::string& pass_name,
+                                uint64 run_time_usecs) {
+  mlir_bridge_pass_time_usecs->GetCell(pass_name)->IncrementBy(run_time_usecs);
+}
+
+void RecordTfMlirBridgePassIrSize(const std::string& pass_name,
+                                  int64_t num_ops) {
+  mlir_bridge_pass_ir_size->GetCell(pass_name)->Add(num_ops);
+}
+
+void UpdateTfMlirBridgeLoweringCacheStatus(bool hit) {
+  mlir_bridge_lowering_cache_count->GetCell(hit ? "hit" : "miss")
+      ->IncrementBy(1);
+}
+
 // Records the activity of the second phase of the mlir bridge.
 void IncrementTfMlirBridgeSecondPhaseCounter(
     MlirBridgeSecondPhaseMetric metric) {
@@ -1029,6 +1158,13 @@ void UpdateEagerClientErrorCounter(const string& error_source,
   eager_client_error_counter->GetCell(error_source, error_type)->IncrementBy(1);
 }
 
+void UpdateEagerOpCost(const string& op_type, uint64 latency_usecs,
+                       uint64 bytes_touched) {
+  eager_op_cost_count->GetCell(op_type)->IncrementBy(1);
+  eager_op_cost_usecs->GetCell(op_type)->IncrementBy(latency_usecs);
+  eager_op_cost_bytes->GetCell(op_type)->IncrementBy(bytes_touched);
+}
+
 void UpdateTfMlirBridgeGraphAnalysisPerOp(
     const std::string& op_name, const std::string& construction_context,
     bool is_single_core_inference_mode, const std::string& num_replicas,
@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/framework/dataset_options.pb.h"
 #include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/lib/monitoring/gauge.h"
+#include "tensorflow/core/lib/monitoring/sampler.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/platform/types.h"
@@ -78,6 +79,22 @@ monitoring::CounterCell* GetTFDataElementsCounter(const string& name);
 monitoring::GaugeCell<std::function<std::string()>>* GetTFDataModelGauge(
     const string& id);
 
+// Returns a sampler that can be used to record the `GetNext()` latency (in
+// microseconds) of a tf.data iterator stage.
+//
+// The `stage` argument identifies the stage by its iterator prefix (e.g.
+// "Iterator::Prefetch::ParallelMapV2").
+monitoring::SamplerCell* GetTFDataStageLatencySampler(const string& stage);
+
+// Returns a sampler that can be used to record the number of elements buffered
+// by a tf.data iterator stage at the time a `GetNext()` call on the stage
+// completes.
+//
+// The `stage` argument identifies the stage by its iterator prefix (e.g.
+// "Iterator::Prefetch::ParallelMapV2").
+monitoring::SamplerCell* GetTFDataStageBufferedElementsSampler(
+    const string& stage);
+
 // Records the number of bytes fetched from tf.data.Dataset iterator.
 void RecordTFDataBytesFetched(int64_t num_bytes);
 
@@ -182,6 +199,10 @@ void RecordTFDataServiceCrossTrainerCacheQuery(bool cache_hit);
 // Records tf.data service cross-trainer cache memory usage in bytes.
 void RecordTFDataServiceCrossTrainerCacheSizeBytes(size_t bytes);
 
+// Records the number of elements evicted from tf.data service cross-trainer
+// caches.
+void RecordTFDataServiceCrossTrainerCacheEvictions(int64_t num_elements);
+
 // Records tf.data distributed snapshot bytes committed.
 void RecordTFDataServiceSnapshotBytesCommitted(int64_t bytes);
 
@@ -235,6 +256,12 @@ void RecordTFDataAutoShardRewriteBatchSize(
 // criterion is met.
 void RecordTFDataAutotuneStoppingCriteria(const string& name);
 
+// Records an autotuning parallelism decision for the tf.data node `name`.
+// `decision` is one of "increase", "decrease", or "hold" (a proposed
+// decrease that was suppressed by hysteresis).
+void RecordTFDataAutotuneParallelismDecision(const string& name,
+                                             const string& decision);
+
 // Records the number of times this event occured, for debugging.
 void RecordTFDataDebug(const string& event);
 
@@ -352,6 +379,21 @@ void UpdateTfMlirBridgeFirstPhaseCounter(const std::string& bridge_type,
                                          bool fallback_enabled,
                                          const std::string& result);
 
+// Accumulates the wall time spent in a single MLIR pass of the TF-to-XLA
+// bridge pass pipelines using the
+// tf_metadata.tf_mlir_bridge_pass_time_usecs metric.
+void UpdateTfMlirBridgePassTime(const std::string& pass_name,
+                                uint64 run_time_usecs);
+
+// Records the number of MLIR operations in the IR observed after a single
+// pass of the TF-to-XLA bridge pass pipelines.
+void RecordTfMlirBridgePassIrSize(const std::string& pass_name,
+                                  int64_t num_ops);
+
+// Records a lookup in the MLIR bridge cache of lowered modules. `hit` is true
+// if an identical lowering was found and reused.
+void UpdateTfMlirBridgeLoweringCacheStatus(bool hit);
+
 enum class Phase2XlaCompilerMetric {
   // Bridge phase 2 CompileSingleOp Xla Builder (old version) was successful
   kCompileSingleOpXlaBuilderSuccess,
@@ -516,6 +558,17 @@ class ScopedCounter final {
 // passes.
 monitoring::Counter<2>* GetGraphOptimizationCounter();
 
+// Returns a counter used to capture the cumulative effect of graph
+// optimization passes on the graph, keyed by pass name and effect kind
+// ("nodes_added", "nodes_removed", "bytes_added", "bytes_removed").
+monitoring::Counter<2>* GetGraphOptimizationEffectCounter();
+
+// Records the change a graph optimization pass made to the graph: the node
+// count delta and the serialized-size delta in bytes. Negative deltas mean
+// the pass shrank the graph.
+void UpdateGraphOptimizationPassEffect(const string& pass_name,
+                                       int64_t node_delta, int64_t byte_delta);
+
 // Updates metrics for time to distribute variables to all TPU hosts.
 void UpdateTpuVariableDistributionTime(const uint64 distribution_time_usecs);
 
@@ -544,6 +597,12 @@ void UpdateTpuErrorCounter(const string& op, const string& error_type);
 void UpdateEagerClientErrorCounter(const string& error_source,
                                    const string& error_type);
 
+// Records one sampled eager op execution for the per-op-type cost counters:
+// `latency_usecs` of wall time and `bytes_touched` input/output tensor bytes
+// attributed to `op_type`.
+void UpdateEagerOpCost(const string& op_type, uint64 latency_usecs,
+                       uint64 bytes_touched);
+
 }  // namespace metrics
 }  // namespace tensorflow
 
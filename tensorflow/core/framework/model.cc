@@ -348,15 +348,46 @@ inline void UpdateParameterValues(const Node::ParameterGradients& gradients,
   }
 }
 
+// Number of consecutive optimization rounds that must propose a lower
+// parallelism before a decrease is applied, and then only one step at a
+// time. Increases are applied immediately. This hysteresis keeps short load
+// dips from tearing down concurrency that will be needed again moments
+// later, which is expensive for ops that thrash threads on every change.
+constexpr int64_t kParallelismDownscaleRounds = 3;
+
 // Copies the parameter values (which are for optimization tuning) and updates
 // the state values (which are for the input pipeline to follow).
 inline void UpdateStateValues(Node::ModelParameters* parameters) {
   for (auto& pair : *parameters) {
     auto& parameter = pair.second;
-    VLOG(2) << "Setting tunable parameter " << pair.first
-            << ":: " << parameter->name << " to " << parameter->value;
     mutex_lock l(*parameter->state->mu);
-    parameter->state->value = parameter->value;
+    double new_value = parameter->value;
+    if (parameter->name == kParallelism) {
+      const double applied = parameter->state->value;
+      if (new_value < applied) {
+        if (++parameter->state->rounds_below_applied_value <
+            kParallelismDownscaleRounds) {
+          // Hold the current parallelism until the proposal persists.
+          metrics::RecordTFDataAutotuneParallelismDecision(pair.first, "hold");
+          new_value = applied;
+        } else {
+          // Downscale gradually, one step per round.
+          metrics::RecordTFDataAutotuneParallelismDecision(pair.first,
+                                                           "decrease");
+          new_value = std::max(new_value, applied - 1.0);
+          parameter->state->rounds_below_applied_value = 0;
+        }
+      } else {
+        if (new_value > applied) {
+          metrics::RecordTFDataAutotuneParallelismDecision(pair.first,
+                                                           "increase");
+        }
+        parameter->state->rounds_below_applied_value = 0;
+      }
+    }
+    VLOG(2) << "Setting tunable parameter " << pair.first
+            << ":: " << parameter->name << " to " << new_value;
+    parameter->state->value = new_value;
     parameter->state->cond_var->notify_all();
   }
 }
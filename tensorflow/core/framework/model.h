@@ -93,6 +93,10 @@ struct SharedState {
   const std::shared_ptr<mutex> mu;
   const std::shared_ptr<condition_variable> cond_var;
   const bool tunable;
+  // Number of consecutive optimization rounds in which autotuning proposed a
+  // value lower than the applied one. Guarded by `mu` and used to apply
+  // hysteresis to parallelism downscaling; see `UpdateStateValues`.
+  int64_t rounds_below_applied_value = 0;
 };
 
 // Represents a parameter.
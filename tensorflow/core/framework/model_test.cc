@@ -2704,6 +2704,147 @@ TEST_F(ModelTimingTest, OptimizeStageBased_CappedByParameterMax) {
   EXPECT_EQ(cell_reader.Read("parameter_max_exceeded:ParallelMapV2(id:1)"), 1);
 }
 
+// Returns the one-stage pipeline of `OptimizeStageBased_OneStage` with the
+// given parallelism already applied by the pipeline (the parameter's state
+// value). With a target time of 50 nanoseconds the optimizer proposes a
+// parallelism of 5 for this pipeline.
+std::string OneStageModelWithAppliedParallelism(int64_t applied_parallelism) {
+  return strings::Printf(R"pb(
+    nodes: {
+      key: 1
+      value: {
+        id: 1
+        name: "ParallelMapV2"
+        autotune: true
+        num_elements: 97
+        buffered_elements: 3
+        processing_time: 5000
+        bytes_produced: 10000
+        node_class: ASYNC_KNOWN_RATIO
+        ratio: 1
+        inputs: 2
+        parameters: {
+          name: "parallelism"
+          value: 4
+          state_value: %lld
+          min: 1
+          max: 16
+          tunable: true
+        }
+      }
+    }
+    nodes: {
+      key: 2
+      value: {
+        id: 2
+        name: "Map"
+        autotune: true
+        num_elements: 100
+        processing_time: 3000
+        node_class: KNOWN_RATIO
+        ratio: 1
+        inputs: 3
+      }
+    }
+    nodes: {
+      key: 3
+      value: {
+        id: 3
+        name: "SSTable"
+        autotune: true
+        num_elements: 100
+        processing_time: 1000
+        node_class: KNOWN_RATIO
+      }
+    }
+    output: 1
+  )pb",
+                         static_cast<long long>(applied_parallelism));
+}
+
+TEST_F(ModelTimingTest, OptimizeStageBased_HoldsThenStepsDownParallelism) {
+  BuildModelFromProto(OneStageModelWithAppliedParallelism(10));
+
+  CellReader<int64_t> cell_reader(
+      "/tensorflow/data/autotune_parallelism_decision");
+  CancellationManager cancellation_manager;
+  RamBudgetManager ram_budget_manager(0);
+  auto optimize = [&]() {
+    model_->Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(20),
+                     /*ram_budget_share=*/1.0,
+                     /*fixed_ram_budget=*/10000,
+                     /*model_input_time=*/50, ram_budget_manager,
+                     &cancellation_manager);
+  };
+
+  // The proposed parallelism of 5 is below the applied value of 10. The
+  // applied value must hold for `kParallelismDownscaleRounds` rounds and
+  // then decrease by a single step, rather than jumping to the proposal.
+  optimize();
+  EXPECT_EQ(10, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+  optimize();
+  EXPECT_EQ(10, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+  optimize();
+  EXPECT_EQ(9, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+  // The counter resets after a decrease, so the next step down again takes
+  // three rounds.
+  optimize();
+  EXPECT_EQ(9, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+  optimize();
+  EXPECT_EQ(9, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+  optimize();
+  EXPECT_EQ(8, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+
+  EXPECT_EQ(cell_reader.Read("ParallelMapV2(id:1)", "hold"), 4);
+  EXPECT_EQ(cell_reader.Read("ParallelMapV2(id:1)", "decrease"), 2);
+}
+
+TEST_F(ModelTimingTest, OptimizeStageBased_AppliesParallelismIncreaseAtOnce) {
+  BuildModelFromProto(OneStageModelWithAppliedParallelism(3));
+
+  CancellationManager cancellation_manager;
+  RamBudgetManager ram_budget_manager(0);
+  model_->Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(20),
+                   /*ram_budget_share=*/1.0,
+                   /*fixed_ram_budget=*/10000,
+                   /*model_input_time=*/50, ram_budget_manager,
+                   &cancellation_manager);
+
+  // Increases are not subject to the downscale hysteresis.
+  EXPECT_EQ(5, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+}
+
+TEST_F(ModelTimingTest, OptimizeStageBased_IncreaseResetsDownscaleCountdown) {
+  BuildModelFromProto(OneStageModelWithAppliedParallelism(10));
+
+  CancellationManager cancellation_manager;
+  RamBudgetManager ram_budget_manager(0);
+  auto optimize = [&](double model_input_time) {
+    model_->Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(20),
+                     /*ram_budget_share=*/1.0,
+                     /*fixed_ram_budget=*/10000, model_input_time,
+                     ram_budget_manager, &cancellation_manager);
+  };
+
+  // Two rounds of lower proposals leave the applied value one round away
+  // from a decrease.
+  optimize(/*model_input_time=*/50);
+  optimize(/*model_input_time=*/50);
+  EXPECT_EQ(10, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+  // A tiny target time drives the proposal to the parameter max of 16,
+  // above the applied value; the increase applies immediately.
+  optimize(/*model_input_time=*/1);
+  EXPECT_EQ(16, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+  // The increase also reset the countdown: lower proposals must again
+  // persist for three rounds before the first step down.
+  optimize(/*model_input_time=*/50);
+  EXPECT_EQ(16, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+  optimize(/*model_input_time=*/50);
+  EXPECT_EQ(16, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+  optimize(/*model_input_time=*/50);
+  EXPECT_EQ(15, GetNode(/*node_id=*/1)->parameter_value("parallelism"));
+}
+
 TEST_F(ModelTimingTest, OptimizeStageBased_TwoStages) {
   BuildModelFromProto(R"pb(
     nodes: {
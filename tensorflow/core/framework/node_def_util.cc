@@ -228,27 +228,35 @@ bool AttrSlice::EqualAttrs(AttrSlice other, Scratch* scratch) const {
 // The ... is to allow the caller to inject some value validation code.  Use
 // just ; if no additional validation code is needed.
 #define DEFINE_GET_ATTR(TYPE, FIELD, ATTR_TYPE, APPEND_OP, CAST, ...)         \
-  Status GetNodeAttr(const AttrSlice& attrs, StringPiece attr_name,           \
+  Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,      \
                      TYPE* value) {                                           \
-    const AttrValue* attr_value;                                              \
-    TF_RETURN_IF_ERROR(attrs.Find(attr_name, &attr_value));                   \
-    TF_RETURN_IF_ERROR(AttrValueHasType(*attr_value, ATTR_TYPE));             \
-    const auto& v = attr_value->FIELD();                                      \
+    TF_RETURN_IF_ERROR(AttrValueHasType(attr_value, ATTR_TYPE));              \
+    const auto& v = attr_value.FIELD();                                       \
     __VA_ARGS__;                                                              \
     *value = CAST;                                                            \
     return OkStatus();                                                        \
   }                                                                           \
   Status GetNodeAttr(const AttrSlice& attrs, StringPiece attr_name,           \
-                     std::vector<TYPE>* value) {                              \
+                     TYPE* value) {                                           \
     const AttrValue* attr_value;                                              \
     TF_RETURN_IF_ERROR(attrs.Find(attr_name, &attr_value));                   \
-    TF_RETURN_IF_ERROR(AttrValueHasType(*attr_value, "list(" ATTR_TYPE ")")); \
-    value->reserve(attr_value->list().FIELD().size());                        \
-    for (const auto& v : attr_value->list().FIELD()) {                        \
+    return GetNodeAttr(*attr_value, attr_name, value);                        \
+  }                                                                           \
+  Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,      \
+                     std::vector<TYPE>* value) {                              \
+    TF_RETURN_IF_ERROR(AttrValueHasType(attr_value, "list(" ATTR_TYPE ")"));  \
+    value->reserve(attr_value.list().FIELD().size());                         \
+    for (const auto& v : attr_value.list().FIELD()) {                         \
       __VA_ARGS__;                                                            \
       value->APPEND_OP(CAST);                                                 \
     }                                                                         \
     return OkStatus();                                                        \
+  }                                                                           \
+  Status GetNodeAttr(const AttrSlice& attrs, StringPiece attr_name,           \
+                     std::vector<TYPE>* value) {                              \
+    const AttrValue* attr_value;                                              \
+    TF_RETURN_IF_ERROR(attrs.Find(attr_name, &attr_value));                   \
+    return GetNodeAttr(*attr_value, attr_name, value);                        \
   }
 
 #define DEFINE_TRY_GET_ATTR(TYPE, FIELD, ATTR_TYPE, APPEND_OP, CAST, ...) \
@@ -346,6 +354,21 @@ bool HasNodeAttr(const NodeDef& node_def, StringPiece attr_name) {
   return node_def.attr().find(string(attr_name)) != node_def.attr().end();
 }
 
+AttrSlots::AttrSlots(const AttrSlice& attrs,
+                     std::initializer_list<StringPiece> attr_names) {
+  values_.reserve(attr_names.size());
+  names_.reserve(attr_names.size());
+  for (StringPiece name : attr_names) {
+    values_.push_back(attrs.Find(name));
+    names_.emplace_back(name);
+  }
+}
+
+Status AttrSlots::SlotNotFound(int slot) const {
+  return errors::NotFound("No attr named '", names_[slot],
+                          "' was found when resolving attr slots");
+}
+
 static const string& kEmptyString = *new string();
 
 const string& GetNodeAttrString(const AttrSlice& attrs, StringPiece attr_name) {
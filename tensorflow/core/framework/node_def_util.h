@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_NODE_DEF_UTIL_H_
 #define TENSORFLOW_CORE_FRAMEWORK_NODE_DEF_UTIL_H_
 
+#include <initializer_list>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -32,6 +33,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/flatmap.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/hash.h"
+#include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/stringpiece.h"
@@ -283,6 +285,117 @@ Status GetNodeAttr(const AttrSlice& attrs, StringPiece attr_name,
 Status GetNodeAttr(const AttrSlice& attrs, StringPiece attr_name,
                    std::vector<NameAttrList>* value);  // type: "list(func)"
 
+// Overloads that read the typed value out of an already resolved AttrValue
+// (e.g. one found ahead of time via AttrSlice::Find or AttrSlots).
+// `attr_name` is used only for error messages.
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   std::string* value);  // type: "string"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   tstring* value);  // type: "tstring"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   int64_t* value);  // type: "int"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   int32* value);  // type: "int"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   float* value);  // type: "float"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   bool* value);  // type: "bool"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   DataType* value);  // type: "type"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   TensorShapeProto* value);  // type: "shape"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   TensorShape* value);  // type: "shape"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   PartialTensorShape* value);  // type: "shape"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   Tensor* value);  // type: "tensor"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   NameAttrList* value);  // type: "func"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   std::vector<string>* value);  // type "list(string)"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   std::vector<tstring>* value);  // type "list(tstring)"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   std::vector<int64_t>* value);  // type "list(int)"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   std::vector<int32>* value);  // type "list(int)"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   std::vector<float>* value);  // type "list(float)"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   std::vector<bool>* value);  // type "list(bool)"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   std::vector<DataType>* value);  // type "list(type)"
+Status GetNodeAttr(
+    const AttrValue& attr_value, StringPiece attr_name,
+    std::vector<TensorShapeProto>* value);  // type "list(shape)"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   std::vector<TensorShape>* value);  // type "list(shape)"
+Status GetNodeAttr(
+    const AttrValue& attr_value, StringPiece attr_name,
+    std::vector<PartialTensorShape>* value);  // type "list(shape)"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   std::vector<Tensor>* value);  // type: "list(tensor)"
+Status GetNodeAttr(const AttrValue& attr_value, StringPiece attr_name,
+                   std::vector<NameAttrList>* value);  // type: "list(func)"
+
+// Resolves attr names to integer slots once, so that repeated attr reads
+// (e.g. from an OpKernel::Compute method) are array indexing rather than
+// string-keyed map lookups. The intended use is to build an AttrSlots in an
+// OpKernel constructor and store it as a kernel member; the slot for a name
+// is its index in the `attr_names` passed to the constructor:
+//
+//   enum : int { kAxis = 0, kKeepDims = 1 };
+//   explicit MyOp(OpKernelConstruction* ctx)
+//       : OpKernel(ctx), attrs_(ctx->def(), {"axis", "keep_dims"}) {}
+//   void Compute(OpKernelContext* ctx) override {
+//     int64_t axis;
+//     OP_REQUIRES_OK(ctx, attrs_.Get(kAxis, &axis));
+//     ...
+//   }
+//
+// AttrSlots borrows the AttrValues of the NodeDef (or AttrValueMap) it was
+// built from, which must outlive it. An OpKernel's NodeDef outlives the
+// kernel, so kernel members satisfy this.
+class AttrSlots {
+ public:
+  AttrSlots() = default;
+
+  // Resolves each name in `attr_names` against `attrs`. Names that are not
+  // present resolve to an empty slot; has_value() distinguishes them.
+  AttrSlots(const AttrSlice& attrs,
+            std::initializer_list<StringPiece> attr_names);
+
+  int num_slots() const { return static_cast<int>(values_.size()); }
+
+  // Returns true iff the attr for `slot` was present when the slots were
+  // resolved.
+  bool has_value(int slot) const { return values_[slot] != nullptr; }
+
+  // Returns the resolved attr value for `slot`, or nullptr if the attr was
+  // not present.
+  const AttrValue* value(int slot) const { return values_[slot]; }
+
+  // Sets *value to the typed value of the attr in `slot`. Returns a
+  // NotFound error if the attr was not present, and a non-ok status if it
+  // does not have a matching type, mirroring GetNodeAttr.
+  // REQUIRES: 0 <= slot < num_slots().
+  template <typename T>
+  Status Get(int slot, T* value) const {
+    DCHECK(slot >= 0 && slot < num_slots());
+    if (values_[slot] == nullptr) {
+      return SlotNotFound(slot);
+    }
+    return GetNodeAttr(*values_[slot], names_[slot], value);
+  }
+
+ private:
+  Status SlotNotFound(int slot) const;
+
+  std::vector<const AttrValue*> values_;
+  std::vector<std::string> names_;  // Only used for error messages.
+};
+
 // Look up the attr with name attr_name and set *value to its value.  If no
 // attr with attr_name is found in node_def, or the attr does not have
 // a matching type, false is returned.
@@ -335,6 +335,35 @@ void ExpectInvalidSyntax(const NodeDef& bad, const string& message) {
       << message;
 }
 
+TEST(NodeDefUtilTest, AttrSlots) {
+  NodeDef node_def;
+  node_def.set_name("n");
+  node_def.set_op("AnyOp");
+  AddNodeAttr("axis", 3, &node_def);
+  AddNodeAttr("keep_dims", true, &node_def);
+
+  enum : int { kAxis = 0, kKeepDims = 1, kMissing = 2 };
+  AttrSlots slots(node_def, {"axis", "keep_dims", "missing"});
+  EXPECT_EQ(3, slots.num_slots());
+  EXPECT_TRUE(slots.has_value(kAxis));
+  EXPECT_TRUE(slots.has_value(kKeepDims));
+  EXPECT_FALSE(slots.has_value(kMissing));
+
+  int32_t axis = 0;
+  TF_EXPECT_OK(slots.Get(kAxis, &axis));
+  EXPECT_EQ(3, axis);
+  bool keep_dims = false;
+  TF_EXPECT_OK(slots.Get(kKeepDims, &keep_dims));
+  EXPECT_TRUE(keep_dims);
+
+  // A missing attr is a NotFound error; a mismatched type is an error, as
+  // with GetNodeAttr.
+  int64_t missing;
+  EXPECT_TRUE(errors::IsNotFound(slots.Get(kMissing, &missing)));
+  string wrong_type;
+  EXPECT_FALSE(slots.Get(kAxis, &wrong_type).ok());
+}
+
 TEST(NodeDefUtilTest, ValidSyntax) {
   const NodeDef node_def = ToNodeDef(R"pb(
     name: 'n'
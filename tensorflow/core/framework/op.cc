@@ -83,6 +83,14 @@ Status OpRegistry::LookUp(const string& op_type_name,
 }
 
 const OpRegistrationData* OpRegistry::LookUp(const string& op_type_name) const {
+  if (const FrozenRegistry* frozen =
+          frozen_registry_.load(std::memory_order_acquire)) {
+    auto iter = frozen->find(op_type_name);
+    if (iter != frozen->end()) return iter->second;
+    // The snapshot is complete (registrations invalidate it), so a miss means
+    // the op is unregistered. Fall through so LookUpSlow's logging of
+    // unregistered ops still runs.
+  }
   {
     tf_shared_lock l(mu_);
     if (initialized_) {
@@ -183,6 +191,29 @@ void OpRegistry::Export(bool include_internal, OpList* ops) const {
 void OpRegistry::DeferRegistrations() {
   mutex_lock lock(mu_);
   initialized_ = false;
+  frozen_registry_.store(nullptr, std::memory_order_release);
+}
+
+void OpRegistry::Freeze() {
+  bool first_call = false;
+  {
+    mutex_lock lock(mu_);
+    first_call = MustCallDeferred();
+    if (frozen_registry_.load(std::memory_order_acquire) == nullptr) {
+      auto* frozen = new FrozenRegistry();
+      frozen->reserve(registry_.size());
+      for (const auto& entry : registry_) {
+        frozen->emplace(entry.first, entry.second.get());
+      }
+      // Superseded snapshots are intentionally leaked: concurrent lookups may
+      // still be reading them. Snapshots are only rebuilt after an
+      // invalidating registration, so the leak is bounded.
+      frozen_registry_.store(frozen, std::memory_order_release);
+    }
+  }
+  if (first_call) {
+    TF_QCHECK_OK(op_registry_validator_(*this));
+  }
 }
 
 void OpRegistry::ClearDeferredRegistrations() {
@@ -243,6 +274,11 @@ Status OpRegistry::RegisterAlreadyLocked(
            .second) {
     s = errors::AlreadyExists("Op with name ", op_reg_data->op_def.name());
   }
+  if (s.ok()) {
+    // Any frozen snapshot no longer covers the full registry; drop it so
+    // lookups fall back to the locked path until the next Freeze.
+    frozen_registry_.store(nullptr, std::memory_order_release);
+  }
   Status watcher_status = s;
   if (watcher_) {
     watcher_status = watcher_(s, op_reg_data_raw->op_def);
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_OP_H_
 #define TENSORFLOW_CORE_FRAMEWORK_OP_H_
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -139,6 +140,15 @@ class OpRegistry : public OpRegistryInterface {
   // Clear the registrations that have been deferred.
   void ClearDeferredRegistrations();
 
+  // Builds a read-only snapshot of the registry that LookUp consults without
+  // taking the registry mutex, so concurrent graph constructions stop
+  // contending on it. Intended to be called once op registration has quiesced
+  // (e.g. when a session is created). Ops registered after the freeze
+  // invalidate the snapshot; lookups then fall back to the locked path until
+  // Freeze is called again. Calling Freeze while the snapshot is still valid
+  // is a cheap no-op.
+  void Freeze();
+
  private:
   // Ensures that all the functions in deferred_ get called, their OpDef's
   // registered, and returns with deferred_ empty.  Returns true the first
@@ -166,6 +176,13 @@ class OpRegistry : public OpRegistryInterface {
       registry_ TF_GUARDED_BY(mu_);
   mutable bool initialized_ TF_GUARDED_BY(mu_);
 
+  // Read-only snapshot of registry_, published by Freeze and consulted by
+  // LookUp without taking mu_. Null when no valid snapshot exists. Values
+  // point at the OpRegistrationData owned by registry_, which is never
+  // erased, so entries stay valid for the process lifetime.
+  using FrozenRegistry = absl::flat_hash_map<string, const OpRegistrationData*>;
+  mutable std::atomic<const FrozenRegistry*> frozen_registry_{nullptr};
+
   // Registry watcher.
   mutable Watcher watcher_ TF_GUARDED_BY(mu_);
 
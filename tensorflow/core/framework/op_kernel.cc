@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/framework/op_kernel.h"
 
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
@@ -378,6 +379,10 @@ Allocator* OpKernelContext::get_allocator(AllocatorAttributes attr) {
   if (TF_PREDICT_FALSE(attr.scope_id > 0)) {
     allocator = params_->device->GetScopedAllocator(attr, step_id());
     CHECK(allocator);
+  } else if (params_->session_buffer_pool != nullptr && attr.value == 0) {
+    // Default-attribute allocations go through the session's recycling pool
+    // when one is installed (see LocalExecutorParams::session_buffer_pool).
+    allocator = params_->session_buffer_pool;
   } else {
     allocator = params_->device->GetAllocator(attr);
   }
@@ -850,6 +855,26 @@ Status OpKernelContext::allocate_temp(
   profiler::ScopedMemoryDebugAnnotation op_annotation(
       op_kernel().name_view().data(), step_id(), "temp", type,
       [&shape]() { return shape.DebugString(); });
+  Allocator* arena = params_->step_arena_allocator;
+  if (arena != nullptr && allocator_attr.value == 0 &&
+      allocator_attr.scope_id <= 0 &&
+      allocation_attr.freed_by_func == nullptr && !track_allocations() &&
+      !record_memory_consumption_ && !params_->log_memory) {
+    // Step-scoped temp buffer: bump-allocate from the per-step arena and
+    // skip the tracking paths, which are all disabled under this predicate.
+    Tensor new_temp(arena, type, shape,
+                    AllocationAttributes(allocation_attr.retry_on_failure,
+                                         /*allocation_will_be_logged=*/false,
+                                         /*freed_by_func=*/nullptr));
+    if (!new_temp.IsInitialized() && shape.num_elements() > 0) {
+      return errors::ResourceExhausted(
+          "OOM when allocating temporary tensor with shape",
+          shape.DebugString(), " and type ", DataTypeString(type), " on ",
+          params_->device->name(), " by allocator ", arena->Name());
+    }
+    *out_temp = std::move(new_temp);
+    return OkStatus();
+  }
   Status s =
       allocate_tensor(type, shape, out_temp, allocator_attr, allocation_attr);
   if (track_allocations() && s.ok() && out_temp->TotalBytes() > 0) {
@@ -1155,6 +1180,15 @@ struct KernelRegistry {
   mutex mu;
   std::unordered_multimap<string, KernelRegistration> registry
       TF_GUARDED_BY(mu);
+
+  // Read-only snapshot of `registry`, published by
+  // FreezeGlobalKernelRegistry and consulted by kernel lookups without
+  // taking `mu`. Null when no valid snapshot exists; registrations
+  // invalidate it. Values point at registrations owned by `registry`, whose
+  // nodes are stable, so entries stay valid for the process lifetime.
+  using Frozen =
+      std::unordered_map<string, std::vector<const KernelRegistration*>>;
+  std::atomic<const Frozen*> frozen{nullptr};
 };
 
 #if defined(_WIN32)
@@ -1326,6 +1360,22 @@ static KernelRegistry* GlobalKernelRegistryTyped() {
   return registry;
 }
 
+void FreezeGlobalKernelRegistry() {
+  KernelRegistry* typed_registry = GlobalKernelRegistryTyped();
+  mutex_lock l(typed_registry->mu);
+  if (typed_registry->frozen.load(std::memory_order_acquire) != nullptr) {
+    return;
+  }
+  auto* frozen = new KernelRegistry::Frozen();
+  for (const auto& entry : typed_registry->registry) {
+    (*frozen)[entry.first].push_back(&entry.second);
+  }
+  // Superseded snapshots are intentionally leaked: concurrent lookups may
+  // still be reading them. Snapshots are only rebuilt after an invalidating
+  // registration, so the leak is bounded.
+  typed_registry->frozen.store(frozen, std::memory_order_release);
+}
+
 namespace kernel_factory {
 
 void OpKernelRegistrar::InitInternal(const KernelDef* kernel_def,
@@ -1348,6 +1398,9 @@ void OpKernelRegistrar::InitInternal(const KernelDef* kernel_def,
   global_registry->registry.emplace(
       key,
       KernelRegistration(*kernel_def, kernel_class_name, std::move(factory)));
+  // Any frozen snapshot no longer covers the full registry; drop it so
+  // lookups fall back to the locked path until the next freeze.
+  global_registry->frozen.store(nullptr, std::memory_order_release);
   delete kernel_def;
 }
 
@@ -1390,29 +1443,52 @@ Status FindKernelRegistration(
 
   const string key = Key(node_op, device_type, label);
   auto typed_registry = GlobalKernelRegistryTyped();
-  tf_shared_lock lock(typed_registry->mu);
-  auto regs = typed_registry->registry.equal_range(key);
-  for (auto iter = regs.first; iter != regs.second; ++iter) {
+
+  // Collects the registrations stored under `k`. When a frozen snapshot is
+  // available this avoids taking the registry lock entirely. The collected
+  // pointers stay valid without the lock because registrations are never
+  // erased and multimap nodes are stable.
+  auto collect_candidates =
+      [typed_registry](const string& k,
+                       std::vector<const KernelRegistration*>* candidates) {
+        candidates->clear();
+        if (const KernelRegistry::Frozen* frozen =
+                typed_registry->frozen.load(std::memory_order_acquire)) {
+          // The snapshot is complete: registrations invalidate it.
+          auto iter = frozen->find(k);
+          if (iter != frozen->end()) *candidates = iter->second;
+          return;
+        }
+        tf_shared_lock lock(typed_registry->mu);
+        auto regs = typed_registry->registry.equal_range(k);
+        for (auto iter = regs.first; iter != regs.second; ++iter) {
+          candidates->push_back(&iter->second);
+        }
+      };
+
+  std::vector<const KernelRegistration*> candidates;
+  collect_candidates(key, &candidates);
+  for (const KernelRegistration* candidate : candidates) {
     // If there is a kernel registered for the op and device_type,
     // check that the attrs match.
     bool match;
-    TF_RETURN_IF_ERROR(KernelAttrsMatch(iter->second.def, node_attrs, &match));
+    TF_RETURN_IF_ERROR(KernelAttrsMatch(candidate->def, node_attrs, &match));
     if (match) {
       if (*reg != nullptr) {
-        if ((*reg)->def.priority() == iter->second.def.priority()) {
+        if ((*reg)->def.priority() == candidate->def.priority()) {
           return errors::InvalidArgument(
               "Multiple OpKernel registrations match NodeDef at the same "
               "priority '",
               FormatNodeDefForError(node_name, has_experimental_debug_info,
                                     experimental_debug_info),
               "': '", (*reg)->def.ShortDebugString(), "' and '",
-              iter->second.def.ShortDebugString(), "'");
-        } else if ((*reg)->def.priority() > iter->second.def.priority()) {
+              candidate->def.ShortDebugString(), "'");
+        } else if ((*reg)->def.priority() > candidate->def.priority()) {
           continue;
         }
-        // iter->second's priority is higher than *reg.
+        // candidate's priority is higher than *reg.
       }
-      *reg = &iter->second;
+      *reg = candidate;
     } else {
       *was_attr_mismatch = true;
     }
@@ -1422,13 +1498,12 @@ Status FindKernelRegistration(
   if (*reg == nullptr &&
       !IsSymbolicExecutionDevice(device_type.type_string())) {
     const string default_key = Key(node_op, DEVICE_DEFAULT, label);
-    auto regs = typed_registry->registry.equal_range(default_key);
-    for (auto iter = regs.first; iter != regs.second; ++iter) {
+    collect_candidates(default_key, &candidates);
+    for (const KernelRegistration* candidate : candidates) {
       // If there is a kernel registered for the op and device_type,
       // check that the attrs match.
       bool match;
-      TF_RETURN_IF_ERROR(
-          KernelAttrsMatch(iter->second.def, node_attrs, &match));
+      TF_RETURN_IF_ERROR(KernelAttrsMatch(candidate->def, node_attrs, &match));
       if (match) {
         if (*reg != nullptr) {
           return errors::InvalidArgument(
@@ -1436,9 +1511,9 @@ Status FindKernelRegistration(
               FormatNodeDefForError(node_name, has_experimental_debug_info,
                                     experimental_debug_info),
               "': '", (*reg)->def.ShortDebugString(), "' and '",
-              iter->second.def.ShortDebugString(), "'");
+              candidate->def.ShortDebugString(), "'");
         }
-        *reg = &iter->second;
+        *reg = candidate;
       } else {
         *was_attr_mismatch = true;
       }
@@ -700,6 +700,16 @@ class OpKernelContext {
 
     // For access to distributed coordination service.
     tsl::CoordinationServiceAgent* coordination_service_agent = nullptr;
+
+    // If non-null, a step-scoped arena that allocate_temp uses for
+    // default-attribute temporary buffers. Installed by the executor; slabs
+    // are reclaimed wholesale when the step finishes.
+    Allocator* step_arena_allocator = nullptr;
+
+    // If non-null, a session-lifetime recycling pool that get_allocator
+    // returns for default-attribute allocations, so output buffers are
+    // reused across steps. Installed by the executor.
+    Allocator* session_buffer_pool = nullptr;
   };
 
   // params must outlive the OpKernelContext.
@@ -1531,6 +1541,16 @@ KernelList GetFilteredRegisteredKernels(
 // Gets a list of all registered kernels for a given op
 KernelList GetRegisteredKernelsForOp(StringPiece op_name);
 
+// Builds a read-only snapshot of the global kernel registry that kernel
+// lookups consult without taking the registry mutex, so concurrent model
+// loads stop contending on it. Intended to be called once kernel
+// registration has quiesced (e.g. when a session is created, after any
+// dynamic kernel libraries have been loaded). Kernels registered after the
+// freeze invalidate the snapshot; lookups then fall back to the locked path
+// until this is called again. Calling it while the snapshot is still valid
+// is a cheap no-op.
+void FreezeGlobalKernelRegistry();
+
 namespace kernel_factory {
 
 // OpKernelFactory is responsible for creating OpKernels when TensorFlow needs
@@ -661,6 +661,14 @@ TEST_F(OpKernelBuilderTest, BuilderCPU) {
   EXPECT_EQ("not found", GetKernelClassName("BuildCPU", DEVICE_GPU, {}));
 }
 
+TEST_F(OpKernelBuilderTest, BuilderCPUFrozenRegistry) {
+  FreezeGlobalKernelRegistry();
+  // Lookups against the frozen snapshot behave like locked lookups.
+  ExpectSuccess("BuildCPU", DEVICE_CPU, {});
+  EXPECT_EQ("DummyKernel", GetKernelClassName("BuildCPU", DEVICE_CPU, {}));
+  ExpectFailure("BuildCPU", DEVICE_GPU, {}, error::NOT_FOUND);
+}
+
 REGISTER_OP("BuildGPU");
 REGISTER_KERNEL_BUILDER(Name("BuildGPU").Device(DEVICE_GPU), DummyKernel);
 
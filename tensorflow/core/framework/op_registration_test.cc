@@ -42,6 +42,24 @@ TEST(OpRegistrationTest, TestBasic) {
   EXPECT_EQ(op_list.op(0).name(), "Foo");
 }
 
+TEST(OpRegistrationTest, TestFreeze) {
+  std::unique_ptr<OpRegistry> registry(new OpRegistry);
+  Register("Foo", registry.get());
+  registry->Freeze();
+
+  // Frozen lookups resolve without consulting the locked registry.
+  EXPECT_NE(registry->LookUp("Foo"), nullptr);
+  EXPECT_EQ(registry->LookUp("Bar"), nullptr);
+
+  // Registering after the freeze invalidates the snapshot; the new op must
+  // still be found through the fallback path, and a re-freeze must cover it.
+  Register("Bar", registry.get());
+  EXPECT_NE(registry->LookUp("Bar"), nullptr);
+  registry->Freeze();
+  EXPECT_NE(registry->LookUp("Bar"), nullptr);
+  EXPECT_NE(registry->LookUp("Foo"), nullptr);
+}
+
 TEST(OpRegistrationTest, TestDuplicate) {
   std::unique_ptr<OpRegistry> registry(new OpRegistry);
   Register("Foo", registry.get());
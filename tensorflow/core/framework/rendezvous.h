@@ -71,11 +71,18 @@ class RendezvousInterface {
     ParsedKey& operator=(const ParsedKey& b);
     StringPiece FullKey() const { return buf_; }
 
+    // Hash of FullKey(), filled in by ParseKey. Send/Recv kernels cache
+    // their parsed keys, so a rendezvous keying off this hash avoids
+    // rehashing the key string on every step. Zero if the key has not
+    // been parsed.
+    uint64 KeyHash() const { return hash_; }
+
    private:
     friend class Rendezvous;
     friend class SendOp;
     friend class RecvOp;
     std::string buf_;
+    uint64 hash_ = 0;
   };
 
   // The caller is a tensor producer and it sends a message (a tensor
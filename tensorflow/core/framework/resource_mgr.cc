@@ -130,12 +130,30 @@ ResourceMgr::ResourceAndName& ResourceMgr::ResourceAndName::operator=(
   return *this;
 }
 
-ResourceMgr::ResourceMgr() : default_container_("localhost") {}
+namespace {
+
+// Number of lookups served by the locked path before a stale snapshot is
+// rebuilt; bounds rebuild work to an amortized constant per lookup.
+constexpr int64_t kSnapshotRebuildThreshold = 256;
+
+int64_t NextResourceMgrId() {
+  static std::atomic<int64_t> next_id{0};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+ResourceMgr::ResourceMgr()
+    : default_container_("localhost"), mgr_id_(NextResourceMgrId()) {}
 
 ResourceMgr::ResourceMgr(const string& default_container)
-    : default_container_(default_container) {}
+    : default_container_(default_container), mgr_id_(NextResourceMgrId()) {}
 
-ResourceMgr::~ResourceMgr() { Clear(); }
+ResourceMgr::~ResourceMgr() {
+  Clear();
+  mutex_lock l(mu_);
+  if (snapshot_ != nullptr) snapshot_->Unref();
+}
 
 void ResourceMgr::Clear() {
   // We do the deallocation outside of the lock to avoid a potential deadlock
@@ -145,6 +163,7 @@ void ResourceMgr::Clear() {
     mutex_lock l(mu_);
     tmp_containers = std::move(containers_);
     containers_.clear();  // reinitialize after move.
+    version_.fetch_add(1, std::memory_order_release);
   }
   for (const auto& p : tmp_containers) {
     delete p.second;
@@ -207,6 +226,7 @@ Status ResourceMgr::DoCreate(const string& container_name, TypeIndex type,
       auto iter = container->find({type.hash_code(), borrowed_name});
       if (iter != container->end()) {
         container->erase(iter);
+        version_.fetch_add(1, std::memory_order_release);
       }
     };
     resource_and_name.resource =
@@ -218,6 +238,7 @@ Status ResourceMgr::DoCreate(const string& container_name, TypeIndex type,
 
   auto st = container->insert(std::move(key_and_value));
   if (st.second) {
+    version_.fetch_add(1, std::memory_order_release);
     TF_RETURN_IF_ERROR(InsertDebugTypeName(type.hash_code(), type.name()));
     return OkStatus();
   }
@@ -227,11 +248,81 @@ Status ResourceMgr::DoCreate(const string& container_name, TypeIndex type,
 
 Status ResourceMgr::Lookup(const ResourceHandle& handle,
                            ResourceBase** resource) const {
+  if (TryFastLookup(handle.container(), handle.hash_code(), handle.name(),
+                    resource)) {
+    return OkStatus();
+  }
   tf_shared_lock l(mu_);
   return DoLookup(handle.container(), handle.hash_code(),
                   /*type_name=*/"ResourceBase", handle.name(), resource);
 }
 
+bool ResourceMgr::TryFastLookup(const string& container,
+                                uint64 type_hash_code, const string& name,
+                                ResourceBase** resource) const {
+  // One cached snapshot per thread. Steady-state lookups touch no shared
+  // mutable state besides the version counter (read-only for readers) and
+  // the looked-up resource's own refcount, so they cannot contend on mu_.
+  struct ThreadLocalSnapshot {
+    int64_t mgr_id = -1;
+    core::RefCountPtr<LookupSnapshot> snapshot;
+  };
+  static thread_local ThreadLocalSnapshot tl;
+
+  if (tl.mgr_id != mgr_id_ ||
+      tl.snapshot->version != version_.load(std::memory_order_acquire)) {
+    // The cached snapshot is missing or stale. Rebuilding costs
+    // O(#resources), so while mutations are ongoing (e.g. variable
+    // creation at model load) lookups fall through to the locked path and
+    // the snapshot is only rebuilt after kSnapshotRebuildThreshold of
+    // them.
+    if (stale_lookups_.fetch_add(1, std::memory_order_relaxed) <
+        kSnapshotRebuildThreshold) {
+      return false;
+    }
+    tl.snapshot = GetSnapshot();
+    tl.mgr_id = mgr_id_;
+    stale_lookups_.store(0, std::memory_order_relaxed);
+  }
+
+  const auto container_it = tl.snapshot->containers.find(container);
+  if (container_it == tl.snapshot->containers.end()) return false;
+  const auto it = container_it->second.find({type_hash_code, name});
+  if (it == container_it->second.end()) return false;
+  core::RefCountPtr<ResourceBase> strong = it->second.resource.GetNewRef();
+  if (strong == nullptr) return false;
+  *resource = strong.release();
+  return true;
+}
+
+core::RefCountPtr<ResourceMgr::LookupSnapshot> ResourceMgr::GetSnapshot()
+    const {
+  mutex_lock l(mu_);
+  const int64_t version = version_.load(std::memory_order_relaxed);
+  if (snapshot_ == nullptr || snapshot_->version != version) {
+    LookupSnapshot* snapshot = new LookupSnapshot;
+    snapshot->version = version;
+    for (const auto& p : containers_) {
+      SnapshotContainer& dst = snapshot->containers[p.first];
+      dst.reserve(p.second->size());
+      for (const auto& q : *p.second) {
+        core::RefCountPtr<ResourceBase> strong = q.second.GetResource();
+        if (strong == nullptr) continue;  // Already expired.
+        SnapshotEntry entry;
+        entry.resource = core::WeakPtr<ResourceBase>(strong.get());
+        entry.name = std::make_unique<std::string>(*q.second.name);
+        // As in DoCreate, the key borrows from the string in the value.
+        Key key(q.first.first, *entry.name);
+        dst.insert({key, std::move(entry)});
+      }
+    }
+    if (snapshot_ != nullptr) snapshot_->Unref();
+    snapshot_ = snapshot;
+  }
+  snapshot_->Ref();
+  return core::RefCountPtr<LookupSnapshot>(snapshot_);
+}
+
 Status ResourceMgr::DoLookup(const string& container, TypeIndex type,
                              const string& name,
                              ResourceBase** resource) const {
@@ -279,6 +370,7 @@ Status ResourceMgr::PopResourceAndName(const string& container,
   }
   std::swap(resource_and_name, iter->second);
   b->erase(iter);
+  version_.fetch_add(1, std::memory_order_release);
   return OkStatus();
 }
 
@@ -328,6 +420,7 @@ Status ResourceMgr::Cleanup(const string& container) {
     }
     b = iter->second;
     containers_.erase(iter);
+    version_.fetch_add(1, std::memory_order_release);
   }
   CHECK(b != nullptr);
   delete b;
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_RESOURCE_MGR_H_
 #define TENSORFLOW_CORE_FRAMEWORK_RESOURCE_MGR_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <typeindex>
@@ -273,10 +274,52 @@ class ResourceMgr {
   typedef absl::flat_hash_map<Key, ResourceAndName, KeyHash, KeyEqual>
       Container;
 
+  // An immutable copy of every (container, type, name) -> resource entry,
+  // backing the lock-free lookup fast path (see TryFastLookup). Entries
+  // hold weak references, so a snapshot retained by an idle thread cannot
+  // extend resource lifetimes. Uses the same borrowed-name key layout as
+  // Container.
+  struct SnapshotEntry {
+    core::WeakPtr<ResourceBase> resource;
+    std::unique_ptr<std::string> name;
+  };
+  typedef absl::flat_hash_map<Key, SnapshotEntry, KeyHash, KeyEqual>
+      SnapshotContainer;
+  struct LookupSnapshot : public core::RefCounted {
+    int64_t version;
+    absl::flat_hash_map<string, SnapshotContainer> containers;
+  };
+
   const std::string default_container_;
+  // Process-unique id, so per-thread snapshot caches can never confuse two
+  // managers that happen to reuse the same address.
+  const int64_t mgr_id_;
   mutable mutex mu_;
   absl::flat_hash_map<string, Container*> containers_ TF_GUARDED_BY(mu_);
 
+  // Incremented under mu_ by every mutation; lets readers validate cached
+  // snapshots without taking mu_.
+  mutable std::atomic<int64_t> version_{0};
+  mutable LookupSnapshot* snapshot_ TF_GUARDED_BY(mu_) = nullptr;
+  // Counts lookups served by the locked path since the snapshot went
+  // stale; the snapshot is only rebuilt once this passes a threshold, so
+  // rebuild work stays amortized constant per lookup while mutations are
+  // ongoing (e.g. variable creation at model load).
+  mutable std::atomic<int64_t> stale_lookups_{0};
+
+  // Performs the lookup against a per-thread cached snapshot, without
+  // taking mu_ in the steady state. Returns true on a hit, transferring a
+  // new strong reference to *resource; returns false if the caller must
+  // use the locked path (stale snapshot, miss, or expired resource).
+  bool TryFastLookup(const std::string& container, uint64 type_hash_code,
+                     const std::string& name, ResourceBase** resource) const
+      TF_LOCKS_EXCLUDED(mu_);
+
+  // Returns a strong reference to a snapshot at the current version,
+  // rebuilding it first if it is stale.
+  core::RefCountPtr<LookupSnapshot> GetSnapshot() const
+      TF_LOCKS_EXCLUDED(mu_);
+
   template <typename T, bool use_dynamic_cast = false>
   Status LookupInternal(const std::string& container, const std::string& name,
                         T** resource) const
@@ -659,6 +702,14 @@ template <typename T, bool use_dynamic_cast>
 Status ResourceMgr::Lookup(const std::string& container,
                            const std::string& name, T** resource) const {
   CheckDeriveFromResourceBase<T>();
+  ResourceBase* found = nullptr;
+  if (TryFastLookup(container, TypeIndex::Make<T>().hash_code(), name,
+                    &found)) {
+    // It's safe to down cast 'found' to T* since typeid(T).hash_code() is
+    // part of the snapshot key.
+    *resource = TypeCastFunctor<T, use_dynamic_cast>::Cast(found);
+    return OkStatus();
+  }
   tf_shared_lock l(mu_);
   return LookupInternal<T, use_dynamic_cast>(container, name, resource);
 }
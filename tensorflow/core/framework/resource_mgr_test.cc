@@ -31,6 +31,7 @@ limitations under the License.
 #include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/regexp.h"
 #include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/test_benchmark.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
 
 namespace tensorflow {
@@ -527,4 +528,36 @@ TEST(ResourceHandleTest, DeleteUsingResourceHandle) {
   EXPECT_NE(LookupResource<StubResource>(&ctx, p, &lookup_r).ok(), true);
 }
 
+TEST(ResourceMgrTest, SnapshotFastPathStaysCoherent) {
+  ResourceMgr rm;
+  TF_CHECK_OK(rm.Create("container", "r", new Resource("fast")));
+  // Drive enough lookups to rebuild the lock-free snapshot, and keep going
+  // once it serves hits.
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ("R/fast", Find<Resource>(rm, "container", "r"));
+  }
+  // Mutations must be visible to the very next lookup.
+  TF_CHECK_OK(rm.Delete<Resource>("container", "r"));
+  HasError(FindErr<Resource>(rm, "container", "r"), error::NOT_FOUND,
+           "Resource container/r");
+  TF_CHECK_OK(rm.Create("container", "r", new Resource("recreated")));
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ("R/recreated", Find<Resource>(rm, "container", "r"));
+  }
+}
+
+void BM_ResourceLookup(::testing::benchmark::State& state) {
+  static ResourceMgr* rm = []() {
+    ResourceMgr* rm = new ResourceMgr;
+    TF_CHECK_OK(rm->Create("container", "var0", new Resource("v")));
+    return rm;
+  }();
+  for (auto s : state) {
+    Resource* r;
+    TF_CHECK_OK(rm->Lookup("container", "var0", &r));
+    r->Unref();
+  }
+}
+BENCHMARK(BM_ResourceLookup)->ThreadRange(1, 64);
+
 }  // end namespace tensorflow
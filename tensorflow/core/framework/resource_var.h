@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_RESOURCE_VAR_H_
 #define TENSORFLOW_CORE_FRAMEWORK_RESOURCE_VAR_H_
 
+#include <atomic>
 #include <string>
 
 #include "tensorflow/core/framework/resource_base.h"
@@ -83,9 +84,56 @@ class Var : public ResourceBase {
   void Uninitialize() {
     // move frees the buffer of the tensor after unused goes out of scope.
     Tensor unused = std::move(tensor_);
+    MarkMutationStarted();
     is_initialized = false;
   }
 
+  // Snapshot sharing for copy-on-read reads.
+  //
+  // In copy-on-read mode every dense read must copy the variable's buffer. To
+  // avoid concurrent readers each producing their own copy of a large
+  // variable, readers may cache the copy here: the first reader installs its
+  // freshly produced copy and subsequent readers alias it, only incrementing
+  // the buffer's reference count. Writers advance a mutation generation (and
+  // drop the cached copy) before mutating the variable, so a snapshot can
+  // only be installed or returned while the variable is unchanged since the
+  // copy was taken. The snapshot mutex only guards the pointer swap and is
+  // never held while copying.
+
+  // Returns true and sets `*out` to a tensor aliasing the cached immutable
+  // copy of the variable's value, if one is installed.
+  bool GetReadSnapshot(Tensor* out) {
+    mutex_lock lock(snapshot_mu_);
+    if (!snapshot_valid_) return false;
+    *out = snapshot_;
+    return true;
+  }
+
+  // Installs `snapshot` as the cached copy, unless a mutation started after
+  // `generation` was sampled with `mutation_generation()`.
+  void InstallReadSnapshot(const Tensor& snapshot, int64_t generation) {
+    mutex_lock lock(snapshot_mu_);
+    if (generation != mutation_generation_.load(std::memory_order_acquire)) {
+      return;
+    }
+    snapshot_ = snapshot;
+    snapshot_valid_ = true;
+  }
+
+  int64_t mutation_generation() const {
+    return mutation_generation_.load(std::memory_order_acquire);
+  }
+
+  // Must be called by writers before mutating the variable's tensor. Drops
+  // the cached read snapshot and prevents in-flight readers from installing a
+  // copy taken before this point.
+  void MarkMutationStarted() {
+    mutation_generation_.fetch_add(1, std::memory_order_release);
+    mutex_lock lock(snapshot_mu_);
+    snapshot_valid_ = false;
+    snapshot_ = Tensor();
+  }
+
   Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override;
 
   std::string DebugString() const override {
@@ -115,6 +163,12 @@ class Var : public ResourceBase {
   Tensor tensor_;
   std::string debug_name_;
 
+  // See the "Snapshot sharing" comment above.
+  mutex snapshot_mu_;
+  Tensor snapshot_ TF_GUARDED_BY(snapshot_mu_);
+  bool snapshot_valid_ TF_GUARDED_BY(snapshot_mu_) = false;
+  std::atomic<int64_t> mutation_generation_{0};
+
   ~Var() override {}
   Var(const Var&) = delete;
   void operator=(const Var&) = delete;
@@ -996,8 +996,23 @@ void RunHandlerPool::Impl::RecomputePoolStats(
   int num_blocking_threads = run_handler_thread_pool()->NumBlockingThreads();
   int num_non_blocking_threads = num_threads - num_blocking_threads;
 
-  std::vector<int> request_idx_list = ChooseRequestsWithExponentialDistribution(
-      num_active_requests, num_blocking_threads);
+  // When enabled, partition threads among in-flight steps proportionally to
+  // their pending queue depths instead of only by request age.
+  static const bool use_queue_depth_scheduling = ParamFromEnvBoolWithDefault(
+      "TF_RUN_HANDLER_QUEUE_DEPTH_SCHEDULING", false);
+
+  std::vector<int> request_idx_list;
+  if (use_queue_depth_scheduling) {
+    std::vector<int64_t> queue_depths(num_active_requests);
+    for (int i = 0; i < num_active_requests; ++i) {
+      queue_depths[i] = thread_work_sources[i]->TaskQueueSize(true);
+    }
+    request_idx_list = ChooseRequestsWithQueueDepthWeighting(
+        num_active_requests, num_blocking_threads, queue_depths);
+  } else {
+    request_idx_list = ChooseRequestsWithExponentialDistribution(
+        num_active_requests, num_blocking_threads);
+  }
   for (int i = 0; i < num_blocking_threads; ++i) {
     VLOG(2) << "Set work for tid=" << i
             << " with start_request_idx=" << request_idx_list[i];
@@ -1005,8 +1020,17 @@ void RunHandlerPool::Impl::RecomputePoolStats(
         i, request_idx_list[i], version, thread_work_sources);
   }
 
-  request_idx_list = ChooseRequestsWithExponentialDistribution(
-      num_active_requests, num_non_blocking_threads);
+  if (use_queue_depth_scheduling) {
+    std::vector<int64_t> queue_depths(num_active_requests);
+    for (int i = 0; i < num_active_requests; ++i) {
+      queue_depths[i] = thread_work_sources[i]->TaskQueueSize(false);
+    }
+    request_idx_list = ChooseRequestsWithQueueDepthWeighting(
+        num_active_requests, num_non_blocking_threads, queue_depths);
+  } else {
+    request_idx_list = ChooseRequestsWithExponentialDistribution(
+        num_active_requests, num_non_blocking_threads);
+  }
   for (int i = 0; i < num_non_blocking_threads; ++i) {
     VLOG(2) << "Set work for tid=" << (i + num_blocking_threads)
             << " with start_request_idx=" << request_idx_list[i];
@@ -181,4 +181,33 @@ std::vector<int> ChooseRequestsWithExponentialDistribution(
   return request_idx_list;
 }
 
+std::vector<int> ChooseRequestsWithQueueDepthWeighting(
+    int num_active_requests, int num_threads,
+    const std::vector<int64_t>& queue_depths) {
+  std::vector<int> request_idx_list;
+  request_idx_list.resize(num_threads);
+
+  int64_t total_weight = 0;
+  for (int i = 0; i < num_active_requests; ++i) {
+    total_weight += queue_depths[i] + 1;
+  }
+
+  // Walk the threads and requests in lockstep, assigning thread `tid` to the
+  // request whose cumulative weight bucket contains `tid`'s share of the
+  // total weight.
+  int64_t cumulative_weight = 0;
+  int request_idx = 0;
+  for (int tid = 0; tid < num_threads; ++tid) {
+    const int64_t target =
+        (static_cast<int64_t>(tid) * total_weight) / num_threads;
+    while (request_idx < num_active_requests - 1 &&
+           cumulative_weight + queue_depths[request_idx] + 1 <= target) {
+      cumulative_weight += queue_depths[request_idx] + 1;
+      ++request_idx;
+    }
+    request_idx_list[tid] = request_idx;
+  }
+  return request_idx_list;
+}
+
 }  // namespace tensorflow
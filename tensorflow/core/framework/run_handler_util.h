@@ -54,6 +54,17 @@ void ComputeInterOpStealingRanges(int num_threads, int min_threads_per_domain,
 std::vector<int> ChooseRequestsWithExponentialDistribution(
     int num_active_requests, int num_threads);
 
+// As above, but distribute threads across requests proportionally to each
+// request's pending queue depth, so steps with deeper queues receive more
+// intra-op threads. `queue_depths` must have `num_active_requests` entries.
+// Each request is weighted by its queue depth plus one, so newly admitted
+// requests with empty queues still receive threads. Return a vector of size
+// num_threads which represents how threads should be distributed across
+// requests.
+std::vector<int> ChooseRequestsWithQueueDepthWeighting(
+    int num_active_requests, int num_threads,
+    const std::vector<int64_t>& queue_depths);
+
 // Look up environment variable named 'var_name' and return the value if it
 // exist and can be parsed. Return 'default_value' otherwise.
 double ParamFromEnvWithDefault(const char* var_name, double default_value);
@@ -30,6 +30,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -69,6 +70,38 @@ limitations under the License.
 
 namespace tensorflow {
 
+namespace internal {
+#ifndef NDEBUG
+namespace {
+std::atomic<int64_t> tensor_element_copies{0};
+std::atomic<int64_t> tensor_element_moves{0};
+}  // namespace
+
+int64_t TensorElementCopies() {
+  return tensor_element_copies.load(std::memory_order_relaxed);
+}
+int64_t TensorElementMoves() {
+  return tensor_element_moves.load(std::memory_order_relaxed);
+}
+void ResetTensorElementCounters() {
+  tensor_element_copies.store(0, std::memory_order_relaxed);
+  tensor_element_moves.store(0, std::memory_order_relaxed);
+}
+void RecordTensorElementCopies(int64_t n) {
+  tensor_element_copies.fetch_add(n, std::memory_order_relaxed);
+}
+void RecordTensorElementMoves(int64_t n) {
+  tensor_element_moves.fetch_add(n, std::memory_order_relaxed);
+}
+#else
+int64_t TensorElementCopies() { return 0; }
+int64_t TensorElementMoves() { return 0; }
+void ResetTensorElementCounters() {}
+void RecordTensorElementCopies(int64_t n) {}
+void RecordTensorElementMoves(int64_t n) {}
+#endif  // NDEBUG
+}  // namespace internal
+
 // Allow Tensors to be stored inside Variants with automatic
 // encoding/decoding when those Variants are themselves being decoded
 // in a Tensor's FromProto.
@@ -234,6 +267,7 @@ struct Helper<tstring> {
   // "out", which is usually the TensorProto::tensor_content.
   template <typename Destination>
   static void Encode(TensorBuffer* in, int64_t n, Destination* out) {
+    internal::RecordTensorElementCopies(n);
     port::EncodeStringList(in->base<const tstring>(), n, out);
   }
 
@@ -248,6 +282,7 @@ struct Helper<tstring> {
       buf->Unref();
       return nullptr;
     }
+    internal::RecordTensorElementCopies(n);
     return buf;
   }
 
@@ -303,6 +338,7 @@ struct Helper<Variant> {
   // "out", which is usually the TensorProto::tensor_content.
   template <typename Destination>
   static void Encode(TensorBuffer* in, int64_t n, Destination* out) {
+    internal::RecordTensorElementCopies(n);
     EncodeVariantList(in->base<const Variant>(), n,
                       port::NewStringListEncoder(out));
   }
@@ -319,6 +355,7 @@ struct Helper<Variant> {
       buf->Unref();
       return nullptr;
     }
+    internal::RecordTensorElementCopies(n);
     return buf;
   }
 
@@ -459,12 +496,16 @@ struct ProtoHelper<Variant> {
     return proto.variant_val().size();
   }
   static void Fill(const Variant* data, size_t n, TensorProto* proto) {
+    internal::RecordTensorElementCopies(n);
+    internal::RecordTensorElementMoves(n);
     auto* variant_values = proto->mutable_variant_val();
     variant_values->Clear();
     for (size_t i = 0; i < n; ++i) {
       VariantTensorData tmp;
       data[i].Encode(&tmp);
-      tmp.ToProto(variant_values->Add());
+      // `tmp` is dead after this iteration, so its metadata can be moved
+      // into the proto rather than copied.
+      tmp.MoveToProto(variant_values->Add());
     }
   }
 };
@@ -721,6 +762,7 @@ TensorBuffer* FromProtoField<Variant>(Allocator* a, const TensorProto& in,
     // in tensors. In all other cases, we decode all in_n elements of in and set
     // the remaining elements up to n to be the default Variant() value.
     const int64_t real_n = n < in_n ? n : in_n;
+    internal::RecordTensorElementCopies(real_n);
     for (int64_t i = 0; i < real_n; ++i) {
       data[i] = in.variant_val(i);
       if (!DecodeUnaryVariant(&data[i])) {
@@ -1354,7 +1396,7 @@ string SummarizeArrayInternal(int64_t limit, int64_t num_elts,
                               const TensorShape& tensor_shape, const T* array,
                               const bool print_v2) {
   string ret;
-  const absl::InlinedVector<int64_t, 4UL> shape = tensor_shape.dim_sizes();
+  const absl::InlinedVector<int64_t, 8UL> shape = tensor_shape.dim_sizes();
   if (shape.empty()) {
     for (int64_t i = 0; i < limit; ++i) {
       if (i > 0) strings::StrAppend(&ret, " ");
@@ -1097,6 +1097,22 @@ inline Tensor& Tensor::operator=(Tensor&& other) {
 
 // END_SKIP_DOXYGEN
 
+namespace internal {
+
+// Debug-mode counters for deep copies and moves of non-POD tensor elements
+// (tstring and Variant) performed by tensor buffer encode/decode paths.
+// String-heavy workloads can diff these around a region of interest to spot
+// elementwise deep copies that should be moves or buffer aliasing. The
+// counters are compiled out in optimized builds: the accessors return 0 and
+// the record functions are no-ops.
+int64_t TensorElementCopies();
+int64_t TensorElementMoves();
+void ResetTensorElementCounters();
+void RecordTensorElementCopies(int64_t n);
+void RecordTensorElementMoves(int64_t n);
+
+}  // namespace internal
+
 }  // namespace tensorflow
 
 #endif  // TENSORFLOW_CORE_FRAMEWORK_TENSOR_H_
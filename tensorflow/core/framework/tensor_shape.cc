@@ -345,7 +345,7 @@ void TensorShapeRep::SlowCopyFrom(const TensorShapeRep& b) {
       *(as64()->dims_) = *(b.as64()->dims_);
     } else {
       set_tag(REP_OUT_OF_LINE);
-      as64()->dims_ = new absl::InlinedVector<int64_t, 4UL>(*(b.as64()->dims_));
+      as64()->dims_ = new absl::InlinedVector<int64_t, 8UL>(*(b.as64()->dims_));
     }
   }
 }
@@ -493,7 +493,7 @@ void TensorShapeBase<Shape>::UnsafeAddDim(int64_t size,
     } else {
       set_tag(REP_OUT_OF_LINE);
       as64()->dims_ =
-          new absl::InlinedVector<int64_t, 4UL>(vals.begin(), vals.end());
+          new absl::InlinedVector<int64_t, 8UL>(vals.begin(), vals.end());
     }
   }
   set_ndims_byte(nd + 1);
@@ -571,8 +571,8 @@ Status TensorShapeBase<Shape>::InsertDimWithStatus(int d, int64_t size) {
 }
 
 template <class Shape>
-absl::InlinedVector<int64_t, 4UL> TensorShapeBase<Shape>::dim_sizes() const {
-  absl::InlinedVector<int64_t, 4UL> result;
+absl::InlinedVector<int64_t, 8UL> TensorShapeBase<Shape>::dim_sizes() const {
+  absl::InlinedVector<int64_t, 8UL> result;
   for (auto dim : *this) {
     result.push_back(dim.size);
   }
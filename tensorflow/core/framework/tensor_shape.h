@@ -87,7 +87,9 @@ class TensorShapeRep {
   // Rep16: Supports up to 6 dimensions where each dimension is < 2^16 - 1
   // Rep32: Supports up to 3 dimensions where each dimension is < 2^32 - 1
   // Rep64: Supports arbitrary dimensionality, 64-bit dimensions using
-  //        an out of line vector.
+  //        an out of line vector. The vector's inline capacity covers
+  //        ranks up to 8, so shapes that spill out of Rep16/Rep32 (e.g.
+  //        5-D and 6-D video models) cost one heap allocation, not two.
   // For PartialTensorShape, a dimension of static_cast<uint??>(-1) is unknown.
   // This value is not allowed in TensorShape either for format compatibility.
   struct Rep16 {
@@ -97,7 +99,7 @@ class TensorShapeRep {
     uint32 dims_[3];
   };
   struct Rep64 {
-    absl::InlinedVector<int64_t, 4UL>* dims_;
+    absl::InlinedVector<int64_t, 8UL>* dims_;
   };
 
   // We use the max value of uint16 or uint32 to represent unknown shapes, so
@@ -302,7 +304,9 @@ class TensorShapeBase : public TensorShapeRep {
 
   /// Returns sizes of all dimensions.
   // Returns an empty list for unknown rank PartialTensorShape.
-  absl::InlinedVector<int64_t, 4UL> dim_sizes() const;
+  // The inline capacity covers rank <= 8, so shape-manipulating hot paths
+  // (reshape/broadcast on up to 8-D tensors) do not allocate.
+  absl::InlinedVector<int64_t, 8UL> dim_sizes() const;
 
   /// Return true iff the rank and all of the dimensions are well defined
   // TODO(irving): Rename to is_fully_defined now that it's fast.
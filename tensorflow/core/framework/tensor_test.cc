@@ -449,6 +449,31 @@ TEST(Tensor_Variant, Marshal) {
   EXPECT_FLOAT_EQ(out->scalar<float>()(), 42.0f);
 }
 
+TEST(Tensor_String, ElementCopyCounters) {
+  // The copy/move counters are only live in debug builds; in optimized
+  // builds the accessors always return zero.
+#ifndef NDEBUG
+  internal::ResetTensorElementCounters();
+  Tensor t(DT_STRING, TensorShape({3}));
+  for (int64_t i = 0; i < 3; ++i) {
+    t.flat<tstring>()(i) = strings::StrCat("foo_", i);
+  }
+  TensorProto proto;
+  t.AsProtoTensorContent(&proto);
+  Tensor t2(t.dtype());
+  EXPECT_TRUE(t2.FromProto(proto));
+  // One elementwise deep copy per element on encode, one on decode.
+  EXPECT_EQ(internal::TensorElementCopies(), 6);
+
+  // Slicing must alias the buffer, not deep-copy elements.
+  internal::ResetTensorElementCounters();
+  Tensor slice = t.Slice(1, 3);
+  EXPECT_EQ(slice.NumElements(), 2);
+  EXPECT_EQ(internal::TensorElementCopies(), 0);
+  EXPECT_EQ(internal::TensorElementMoves(), 0);
+#endif  // NDEBUG
+}
+
 TEST(Tensor_Bool, Simple) {
   Tensor t(DT_BOOL, TensorShape({2, 2}));
   EXPECT_TRUE(t.shape().IsSameSize(TensorShape({2, 2})));
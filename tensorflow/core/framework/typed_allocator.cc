@@ -15,10 +15,98 @@ limitations under the License.
 
 #include "tensorflow/core/framework/typed_allocator.h"
 
+#include <cstdlib>
+
 #include "tensorflow/core/framework/variant.h"
+#include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/logging.h"
 
 namespace tensorflow {
 
+namespace {
+
+// Thread-local magazines of small buffers, bucketed into power-of-two size
+// classes from 64B to kMaxSmallAllocBytes. All blocks in a class were
+// allocated from the base CPU allocator with exactly the class size, so any
+// block on a freelist can serve any request mapped to that class.
+constexpr int kNumSizeClasses = 5;
+constexpr size_t kMinSizeClassBytes = 64;
+constexpr int kMagazineCapacity = 16;
+
+int SizeClassIndex(size_t num_bytes) {
+  int size_class = 0;
+  size_t class_bytes = kMinSizeClassBytes;
+  while (class_bytes < num_bytes) {
+    class_bytes <<= 1;
+    ++size_class;
+  }
+  DCHECK_LT(size_class, kNumSizeClasses);
+  return size_class;
+}
+
+size_t SizeClassBytes(int size_class) {
+  return kMinSizeClassBytes << size_class;
+}
+
+struct SmallAllocMagazine {
+  void* blocks[kNumSizeClasses][kMagazineCapacity];
+  int count[kNumSizeClasses] = {0};
+
+  ~SmallAllocMagazine() {
+    // Return cached blocks to the allocator they came from on thread exit.
+    for (int size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+      for (int i = 0; i < count[size_class]; ++i) {
+        cpu_allocator_base()->DeallocateRaw(blocks[size_class][i]);
+      }
+    }
+  }
+};
+
+SmallAllocMagazine* GetSmallAllocMagazine() {
+  static thread_local SmallAllocMagazine magazine;
+  return &magazine;
+}
+
+}  // namespace
+
+/* static */
+bool TypedAllocator::SmallAllocCacheEnabled() {
+  static const bool enabled = [] {
+    const char* val = std::getenv("TF_CPU_SMALL_ALLOC_CACHE");
+    if (val == nullptr) return false;
+    return str_util::Lowercase(val) == "true" || val == string("1");
+  }();
+  return enabled;
+}
+
+/* static */
+void* TypedAllocator::CachedAllocateRaw(
+    Allocator* raw_allocator, size_t num_bytes,
+    const AllocationAttributes& allocation_attr) {
+  const int size_class = SizeClassIndex(num_bytes);
+  SmallAllocMagazine* magazine = GetSmallAllocMagazine();
+  if (magazine->count[size_class] > 0) {
+    return magazine->blocks[size_class][--magazine->count[size_class]];
+  }
+  // Allocate the full class size so this block can be recycled for any
+  // request in the same class.
+  return raw_allocator->AllocateRaw(Allocator::kAllocatorAlignment,
+                                    SizeClassBytes(size_class),
+                                    allocation_attr);
+}
+
+/* static */
+void TypedAllocator::CachedDeallocateRaw(Allocator* raw_allocator, void* ptr,
+                                         size_t num_bytes) {
+  const int size_class = SizeClassIndex(num_bytes);
+  SmallAllocMagazine* magazine = GetSmallAllocMagazine();
+  if (magazine->count[size_class] < kMagazineCapacity) {
+    magazine->blocks[size_class][magazine->count[size_class]++] = ptr;
+    return;
+  }
+  raw_allocator->DeallocateRaw(ptr);
+}
+
 /* static */
 void TypedAllocator::RunVariantCtor(Variant* p, size_t n) {
   for (size_t i = 0; i < n; ++p, ++i) new (p) Variant();
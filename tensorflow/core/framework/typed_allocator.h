@@ -31,6 +31,10 @@ class Variant;
 // and destructors are invoked for complex types if necessary.
 class TypedAllocator {
  public:
+  // Buffers at or below this size are eligible for the thread-local
+  // small-allocation cache (see SmallAllocCacheEnabled()).
+  static constexpr size_t kMaxSmallAllocBytes = 1024;
+
   // May return NULL if the tensor has too many elements to represent in a
   // single allocation.
   template <typename T>
@@ -43,9 +47,14 @@ class TypedAllocator {
       return nullptr;
     }
 
-    void* p =
-        raw_allocator->AllocateRaw(Allocator::kAllocatorAlignment,
-                                   sizeof(T) * num_elements, allocation_attr);
+    const size_t num_bytes = sizeof(T) * num_elements;
+    void* p;
+    if (SmallAllocCacheEligible<T>(raw_allocator, num_bytes)) {
+      p = CachedAllocateRaw(raw_allocator, num_bytes, allocation_attr);
+    } else {
+      p = raw_allocator->AllocateRaw(Allocator::kAllocatorAlignment, num_bytes,
+                                     allocation_attr);
+    }
     T* typed_p = reinterpret_cast<T*>(p);
     if (typed_p) RunCtor<T>(raw_allocator, typed_p, num_elements);
     return typed_p;
@@ -56,11 +65,43 @@ class TypedAllocator {
                          size_t num_elements) {
     if (ptr) {
       RunDtor<T>(raw_allocator, ptr, num_elements);
-      raw_allocator->DeallocateRaw(ptr);
+      const size_t num_bytes = sizeof(T) * num_elements;
+      if (SmallAllocCacheEligible<T>(raw_allocator, num_bytes)) {
+        CachedDeallocateRaw(raw_allocator, ptr, num_bytes);
+      } else {
+        raw_allocator->DeallocateRaw(ptr);
+      }
     }
   }
 
+  // Whether the thread-local magazine for small allocations is enabled.
+  // Controlled by the TF_CPU_SMALL_ALLOC_CACHE environment variable
+  // (default false); read once at first use.
+  static bool SmallAllocCacheEnabled();
+
  private:
+  // The eligibility predicate must be a pure function of the type, the
+  // allocator identity, and the byte count, so that Allocate and Deallocate
+  // always agree on whether a buffer went through the cache.
+  template <typename T>
+  static bool SmallAllocCacheEligible(Allocator* raw_allocator,
+                                      size_t num_bytes) {
+    return is_simple_type<T>::value && num_bytes > 0 &&
+           num_bytes <= kMaxSmallAllocBytes && SmallAllocCacheEnabled() &&
+           raw_allocator == cpu_allocator_base();
+  }
+
+  // Serves a small allocation from the calling thread's magazine, falling
+  // back to `raw_allocator` (with the size rounded up to the size class) on
+  // an empty freelist.
+  static void* CachedAllocateRaw(Allocator* raw_allocator, size_t num_bytes,
+                                 const AllocationAttributes& allocation_attr);
+
+  // Returns a small buffer to the calling thread's magazine, or to
+  // `raw_allocator` when the magazine for its size class is full.
+  static void CachedDeallocateRaw(Allocator* raw_allocator, void* ptr,
+                                  size_t num_bytes);
+
   // No constructors or destructors are run for simple types
   template <typename T>
   static void RunCtor(Allocator* raw_allocator, T* p, size_t n) {
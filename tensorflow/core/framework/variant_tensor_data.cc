@@ -48,14 +48,26 @@ void VariantTensorData::ToProto(VariantTensorDataProto* proto) const {
   }
 }
 
+void VariantTensorData::MoveToProto(VariantTensorDataProto* proto) {
+  proto->set_type_name(std::move(type_name_));
+  proto->set_metadata(std::move(metadata_));
+  proto->clear_tensors();
+  for (const auto& tensor : tensors_) {
+    tensor.AsProtoField(proto->mutable_tensors()->Add());
+  }
+  type_name_.clear();
+  metadata_.clear();
+  tensors_.clear();
+}
+
 bool VariantTensorData::FromProto(VariantTensorDataProto proto) {
   // TODO(ebrevdo): Do this lazily.
-  set_type_name(proto.type_name());
-  set_metadata(proto.metadata());
+  type_name_ = std::move(*proto.mutable_type_name());
+  metadata_ = std::move(*proto.mutable_metadata());
   for (const auto& tensor : proto.tensors()) {
     Tensor tmp;
     if (!tmp.FromProto(tensor)) return false;
-    tensors_.push_back(tmp);
+    tensors_.push_back(std::move(tmp));
   }
   return true;
 }
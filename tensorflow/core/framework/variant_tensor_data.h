@@ -79,6 +79,9 @@ class VariantTensorData {
 
   // Conversion to and from VariantTensorDataProto
   void ToProto(VariantTensorDataProto* proto) const;
+  // Like ToProto, but moves the metadata string into the proto instead of
+  // copying it. *this is left empty.
+  void MoveToProto(VariantTensorDataProto* proto);
   // This allows optimizations via std::move.
   bool FromProto(VariantTensorDataProto proto);
   bool FromConstProto(const VariantTensorDataProto& proto);
@@ -514,6 +514,10 @@ void Graph::Copy(const Graph& src) {
   // Copy GraphDef versions
   set_versions(src.versions());
 
+  // Allocate all the node and edge objects up front, in two contiguous
+  // blocks, instead of one arena allocation per object below.
+  Reserve(src.num_nodes() - 2, src.num_edges());
+
   // Copy the nodes.
   // "Node in src" -> "Node in *dest"
   gtl::FlatMap<const Node*, Node*> node_map;
@@ -528,7 +532,6 @@ void Graph::Copy(const Graph& src) {
   }
 
   // Copy the edges
-  edges_.reserve(src.num_edges());
   for (const Edge* e : src.edges()) {
     Node* src_copy = node_map[e->src()];
     Node* dst_copy = node_map[e->dst()];
@@ -536,6 +539,29 @@ void Graph::Copy(const Graph& src) {
   }
 }
 
+void Graph::Reserve(int num_nodes, int num_edges) {
+  if (num_nodes > 0) {
+    nodes_.reserve(nodes_.size() + num_nodes);
+    free_nodes_.reserve(free_nodes_.size() + num_nodes);
+    Node* block = reinterpret_cast<Node*>(
+        arena_.AllocAligned(sizeof(Node) * num_nodes, alignof(Node)));
+    // Push in reverse so that AllocateNode, which pops from the back, hands
+    // the objects out in increasing address order.
+    for (int i = num_nodes - 1; i >= 0; --i) {
+      free_nodes_.push_back(new (&block[i]) Node);  // placement new
+    }
+  }
+  if (num_edges > 0) {
+    edges_.reserve(edges_.size() + num_edges);
+    free_edges_.reserve(free_edges_.size() + num_edges);
+    Edge* block = reinterpret_cast<Edge*>(
+        arena_.AllocAligned(sizeof(Edge) * num_edges, alignof(Edge)));
+    for (int i = num_edges - 1; i >= 0; --i) {
+      free_edges_.push_back(new (&block[i]) Edge);  // placement new
+    }
+  }
+}
+
 absl::StatusOr<Node*> Graph::AddNode(NodeDef node_def) {
   Status s;
   Node* out = AddNode(std::move(node_def), &s);
@@ -577,6 +577,15 @@ class Graph {
 
   void Copy(const Graph& src);
 
+  // Pre-allocates storage for `num_nodes` additional nodes and `num_edges`
+  // additional edges. The objects are carved out of two contiguous arena
+  // blocks and handed out by subsequent AddNode/AddEdge calls, which makes
+  // bulk construction (e.g. instantiating a large GraphDef, or Copy)
+  // allocation-cheap and keeps nodes and edges dense in memory. Counts that
+  // turn out too large only cost arena memory; counts that are too small
+  // fall back to one-at-a-time allocation.
+  void Reserve(int num_nodes, int num_edges);
+
   // Removes all nodes from this graph, including all edges from or to them.
   // No Node* references to the Graph are valid post.
   void Clear();
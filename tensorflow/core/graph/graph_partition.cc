@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/graph/graph_partition.h"
 
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <queue>
@@ -39,6 +40,9 @@ limitations under the License.
 #include "tensorflow/core/graph/node_builder.h"
 #include "tensorflow/core/graph/tensor_id.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/util/device_name_utils.h"
 #include "tensorflow/core/util/dump_graph.h"
@@ -1261,16 +1265,44 @@ Status Partition(const PartitionOptions& opts, Graph* g,
     flib_def = &g->flib_def();
   }
 
-  // Set versions, function library and send/recv incarnation.
-  for (auto& it : *partitions) {
-    GraphDef* gdef = &it.second;
+  // Set versions and function library for every partition. Pruning
+  // unreachable functions from `flib_def` scans each partition against the
+  // full library, which dominates partitioning time for graphs with many
+  // partitions and a large library; each partition is independent and only
+  // reads shared state, so the work is fanned out across threads. The
+  // debug info for each partition is built here for the same reason.
+  const auto finalize_partition = [g, flib_def, &debug_info_builders](
+                                      const string& name, GraphDef* gdef) {
     *gdef->mutable_versions() = g->versions();
-    // Prune unreachable functions from `flib_def` before adding them to `gdef`.
+    // Prune unreachable functions from `flib_def` before adding them to
+    // `gdef`.
     *gdef->mutable_library() = flib_def->ReachableDefinitions(*gdef).ToProto();
+    const auto& builder_iter = debug_info_builders.find(name);
+    if (builder_iter != debug_info_builders.end()) {
+      *gdef->mutable_debug_info() = builder_iter->second->Build();
+    }
+  };
+  if (partitions->size() > 1) {
+    thread::ThreadPool pool(
+        Env::Default(), "partition_finalize",
+        std::min<int>(partitions->size(), port::MaxParallelism()));
+    for (auto& it : *partitions) {
+      pool.Schedule([&finalize_partition, &it] {
+        finalize_partition(it.first, &it.second);
+      });
+    }
+    // The pool destructor waits for all scheduled work to finish.
+  } else {
+    for (auto& it : *partitions) {
+      finalize_partition(it.first, &it.second);
+    }
+  }
 
-    // Traverse the graph to fill every send/recv op's incarnation
-    // information.
-    SetIncarnation(opts, gdef);
+  // Traverse each partition to fill every send/recv op's incarnation
+  // information. `opts.get_incarnation` is a caller-supplied callback with
+  // no thread-safety contract, so this stays serial.
+  for (auto& it : *partitions) {
+    SetIncarnation(opts, &it.second);
   }
 
   // Set the start times for recvs at the very end.
@@ -1285,15 +1317,6 @@ Status Partition(const PartitionOptions& opts, Graph* g,
 
   VLOG(1) << "Added send/recv: controls=" << num_control
           << ", data=" << num_data;
-  // For each partition, build the GraphDebugInfo for all of its nodes' stack
-  // traces, and add it to the GraphDef for that partition.
-  for (auto& it : *partitions) {
-    const auto& builder_iter = debug_info_builders.find(it.first);
-    if (builder_iter != debug_info_builders.end()) {
-      GraphDef& gdef = it.second;
-      *gdef.mutable_debug_info() = builder_iter->second->Build();
-    }
-  }
   if (VLOG_IS_ON(2)) {
     for (auto& it : *partitions) {
       GraphDef* gdef = &it.second;
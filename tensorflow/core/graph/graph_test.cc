@@ -198,6 +198,29 @@ TEST_F(GraphTest, RemoveThenAdd) {
   VerifyGraphStats();
 }
 
+TEST_F(GraphTest, ReserveThenAdd) {
+  graph_.Reserve(/*num_nodes=*/3, /*num_edges=*/4);
+  Node* a = FromNodeDef("A", "OneOutput", 0);
+  Node* b = FromNodeDef("B", "OneInput", 1);
+  Node* c = AddNodeWithName("C");
+  graph_.AddEdge(a, 0, b, 0);
+  graph_.AddControlEdge(graph_.source_node(), a);
+  graph_.AddControlEdge(b, graph_.sink_node());
+
+  VerifyNodes(a, {graph_.source_node()}, {b});
+  VerifyNodes(b, {a}, {graph_.sink_node()});
+  VerifyNodes(c, {}, {});
+  EXPECT_EQ(5, graph_.num_node_ids());
+  VerifyGraphStats();
+
+  // Adding beyond the reservation falls back to one-at-a-time allocation.
+  Node* d = FromNodeDef("D", "OneInput", 1);
+  graph_.AddEdge(a, 0, d, 0);
+  graph_.AddControlEdge(c, d);
+  VerifyNodes(d, {a, c}, {});
+  VerifyGraphStats();
+}
+
 TEST_F(GraphTest, InNodesAndOutNodes) {
   Node* a = FromNodeDef("A", "OneOutput", 0);
   Node* b = AddNodeWithName("B");
@@ -48,14 +48,17 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/strings/numbers.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/denormal.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/setround.h"
 #include "tensorflow/core/platform/tensor_coding.h"
 #include "tensorflow/core/public/version.h"
 #include "tensorflow/core/util/bcast.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/overflow.h"
 #include "tensorflow/core/util/saved_tensor_slice_util.h"
 
@@ -67,6 +70,33 @@ using TensorVector = gtl::InlinedVector<TensorValue, 4>;
 const int64_t kMaxConstantSize = 100 * 1024;
 
 namespace {
+// Returns true iff incremental optimization was requested via the
+// TF_GRAPPLER_INCREMENTAL_OPTIMIZATION environment variable. When enabled,
+// Optimize() skips graphs that are byte-identical to the fixpoint it produced
+// on the previous meta-optimizer iteration.
+bool IncrementalOptimizationEnabled() {
+  static const bool enabled = [] {
+    bool enabled = false;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_GRAPPLER_INCREMENTAL_OPTIMIZATION",
+                                   /*default_val=*/false, &enabled));
+    return enabled;
+  }();
+  return enabled;
+}
+
+// Fingerprints 'graph' together with the feed and fetch node names of 'item',
+// which also affect the result of constant folding.
+uint64 GraphFingerprint(const GraphDef& graph, const GrapplerItem& item) {
+  uint64 fingerprint = DeterministicProtoHash64(graph);
+  for (const string& fetch : item.fetch) {
+    fingerprint = FingerprintCat64(fingerprint, Fingerprint64(fetch));
+  }
+  for (const auto& feed : item.feed) {
+    fingerprint = FingerprintCat64(fingerprint, Fingerprint64(feed.first));
+  }
+  return fingerprint;
+}
+
 template <typename T>
 bool AllValuesAre(const TensorProto& proto, const T& value) {
   Tensor tensor;
@@ -4063,6 +4093,18 @@ Status ConstantFolding::Optimize(Cluster* cluster, const GrapplerItem& item,
   // the same here.
   port::ScopedFlushDenormal flush;
   port::ScopedSetRound round(FE_TONEAREST);
+
+  // In incremental mode, skip graphs that are byte-identical to the fixpoint
+  // this instance produced on the previous invocation: the optimization below
+  // runs until it can make no more progress, so re-running it on its own
+  // output is a no-op that would still pay for full shape inference.
+  const bool incremental = IncrementalOptimizationEnabled();
+  if (incremental &&
+      previous_output_fingerprint_ == GraphFingerprint(item.graph, item)) {
+    *optimized_graph = item.graph;
+    return absl::OkStatus();
+  }
+
   nodes_to_preserve_ = item.NodesToPreserve();
   for (const auto& feed : item.feed) {
     feed_nodes_.insert(NodeName(feed.first));
@@ -4112,6 +4154,10 @@ Status ConstantFolding::Optimize(Cluster* cluster, const GrapplerItem& item,
   *optimized_graph->mutable_library() = item.graph.library();
   *optimized_graph->mutable_versions() = item.graph.versions();
 
+  if (incremental) {
+    previous_output_fingerprint_ = GraphFingerprint(*optimized_graph, item);
+  }
+
   return absl::OkStatus();
 }
 
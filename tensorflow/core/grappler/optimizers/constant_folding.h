@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_CONSTANT_FOLDING_H_
 #define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_CONSTANT_FOLDING_H_
 
+#include <optional>
+
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/types/span.h"
@@ -340,6 +342,11 @@ class ConstantFolding : public GraphOptimizer {
   bool graph_contains_assign_or_inplace_op_;
   bool disable_compressed_tensor_optimization_;
   bool fold_quantization_emulation_;
+  // Fingerprint of the graph produced by the previous Optimize() call on this
+  // instance, or nullopt if Optimize() has not run yet. Only maintained when
+  // incremental optimization is enabled (TF_GRAPPLER_INCREMENTAL_OPTIMIZATION)
+  // so that re-invocations on an already-folded graph can be skipped.
+  std::optional<uint64> previous_output_fingerprint_;
 };
 
 }  // end namespace grappler
@@ -0,0 +1,124 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/filter_map_fusion.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/mutable_graph_view.h"
+#include "tensorflow/core/grappler/op_types.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/platform/protobuf.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kFusedOpName[] = "FilterMapDataset";
+
+bool GetBoolAttr(const NodeDef& node, const string& key, bool default_value) {
+  const auto* attr = gtl::FindOrNull(node.attr(), key);
+  return attr ? attr->b() : default_value;
+}
+
+NodeDef MakeFilterMapNode(const NodeDef& filter_node, const NodeDef& map_node,
+                          MutableGraphView* graph) {
+  NodeDef fused_node;
+  fused_node.set_op(kFusedOpName);
+  graph_utils::SetUniqueGraphNodeName(kFusedOpName, graph->graph(),
+                                      &fused_node);
+
+  // Set the `input_dataset` input argument.
+  fused_node.add_input(filter_node.input(0));
+
+  // Set the `predicate_other_arguments` input arguments.
+  for (int i = 1; i < filter_node.input_size(); ++i) {
+    fused_node.add_input(filter_node.input(i));
+  }
+
+  // Set the `map_func_other_arguments` input arguments.
+  for (int i = 1; i < map_node.input_size(); ++i) {
+    fused_node.add_input(map_node.input(i));
+  }
+
+  auto predicate = filter_node.attr().at("predicate");
+  (*fused_node.mutable_attr())["predicate"] = std::move(predicate);
+  auto map_func = map_node.attr().at("f");
+  (*fused_node.mutable_attr())["map_func"] = std::move(map_func);
+
+  auto predicate_arguments_types = filter_node.attr().at("Targuments");
+  (*fused_node.mutable_attr())["Tpredicate_other_arguments"] =
+      std::move(predicate_arguments_types);
+  auto map_func_arguments_types = map_node.attr().at("Targuments");
+  (*fused_node.mutable_attr())["Tmap_func_other_arguments"] =
+      std::move(map_func_arguments_types);
+
+  graph_utils::CopyShapesAndTypesAttrs(map_node, &fused_node);
+  graph_utils::MaybeSetFusedMetadata(filter_node, map_node, &fused_node);
+
+  return fused_node;
+}
+
+}  // namespace
+
+Status FilterMapFusion::OptimizeAndCollectStats(Cluster* cluster,
+                                                const GrapplerItem& item,
+                                                GraphDef* output,
+                                                OptimizationStats* stats) {
+  *output = item.graph;
+  MutableGraphView graph(output);
+  absl::flat_hash_set<string> nodes_to_delete;
+  for (const NodeDef& node : item.graph.node()) {
+    if (node.op() != "MapDataset") continue;
+
+    // Use a more descriptive variable name now that we know the node type.
+    const NodeDef& map_node = node;
+    // The fused kernel runs the map function the way `MapDataset` does by
+    // default, so skip maps that opt out of inter-op parallelism or require
+    // synchronous execution.
+    if (!GetBoolAttr(map_node, "use_inter_op_parallelism",
+                     /*default_value=*/true) ||
+        GetBoolAttr(map_node, "force_synchronous", /*default_value=*/false)) {
+      continue;
+    }
+
+    const NodeDef* node2 = graph_utils::GetInputNode(map_node, graph);
+    if (node2->op() != "FilterDataset") continue;
+    const NodeDef& filter_node = *node2;
+
+    const auto* fused_node =
+        graph.AddNode(MakeFilterMapNode(filter_node, map_node, &graph));
+    TF_RETURN_IF_ERROR(
+        graph.UpdateFanouts(map_node.name(), fused_node->name()));
+
+    // Mark the `Filter` and `Map` nodes for removal.
+    nodes_to_delete.insert(filter_node.name());
+    nodes_to_delete.insert(map_node.name());
+    stats->num_changes++;
+  }
+
+  TF_RETURN_IF_ERROR(graph.DeleteNodes(nodes_to_delete));
+  return absl::OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(FilterMapFusion, "filter_map_fusion");
+
+}  // namespace grappler
+}  // namespace tensorflow
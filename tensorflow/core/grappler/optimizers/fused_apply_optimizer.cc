@@ -0,0 +1,232 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/fused_apply_optimizer.h"
+
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/platform/errors.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kApplyAdam[] = "ResourceApplyAdam";
+constexpr char kApplyGradientDescent[] = "ResourceApplyGradientDescent";
+constexpr char kFusedApplyAdam[] = "_FusedResourceApplyAdam";
+constexpr char kFusedApplyGradientDescent[] =
+    "_FusedResourceApplyGradientDescent";
+
+// Number of scalar hyperparameter inputs following the variable inputs:
+// {beta1_power, beta2_power, lr, beta1, beta2, epsilon} for Adam and {alpha}
+// for gradient descent.
+int NumScalarInputs(const NodeDef& node) {
+  return node.op() == kApplyAdam ? 6 : 1;
+}
+
+// Number of resource inputs per variable: {var, m, v} for Adam and {var} for
+// gradient descent.
+int NumResourceInputs(const NodeDef& node) {
+  return node.op() == kApplyAdam ? 3 : 1;
+}
+
+bool NodeIsOnCpu(const NodeDef& node) {
+  const string& device = node.device();
+  return device.empty() || absl::StrContains(device, DEVICE_CPU);
+}
+
+// Returns true if all of `node`'s fanouts are control edges into terminal
+// nodes (nodes with no fanouts of their own, e.g. the NoOp created by a
+// `tf.group` train op). Fusing such nodes cannot create a cycle: every path
+// out of the fused node ends immediately.
+bool HasOnlyTerminalControlFanouts(const NodeMap& node_map,
+                                   const NodeDef& node) {
+  for (const NodeDef* consumer : node_map.GetOutputs(node.name())) {
+    if (!node_map.GetOutputs(consumer->name()).empty()) return false;
+  }
+  return true;
+}
+
+// Key identifying a group of apply nodes that may be fused together: same op,
+// device, data type, attributes, and the same scalar hyperparameter tensors.
+string GroupingKey(const NodeDef& node) {
+  const int num_resources = NumResourceInputs(node);
+  const int num_scalars = NumScalarInputs(node);
+  std::vector<string> parts = {node.op(), node.device()};
+  if (node.attr().contains("T")) {
+    parts.push_back(DataTypeString(node.attr().at("T").type()));
+  }
+  if (node.attr().contains("use_locking")) {
+    parts.push_back(node.attr().at("use_locking").b() ? "L1" : "L0");
+  }
+  if (node.attr().contains("use_nesterov")) {
+    parts.push_back(node.attr().at("use_nesterov").b() ? "N1" : "N0");
+  }
+  for (int i = 0; i < num_scalars; ++i) {
+    parts.push_back(node.input(num_resources + i));
+  }
+  return absl::StrJoin(parts, ":");
+}
+
+// Builds the fused node replacing `members` (all sharing the same grouping
+// key) and rewires the control fanouts of the members to it.
+void FuseGroup(const std::vector<NodeDef*>& members, NodeMap* node_map,
+               GraphDef* graph, std::set<string>* nodes_to_delete) {
+  const NodeDef& first = *members[0];
+  const bool is_adam = first.op() == kApplyAdam;
+  const int num_resources = NumResourceInputs(first);
+  const int num_scalars = NumScalarInputs(first);
+  const int n = members.size();
+
+  NodeDef* fused = graph->add_node();
+  fused->set_name(
+      absl::StrCat(first.name(), "/_grouped_", is_adam ? "adam" : "sgd"));
+  fused->set_op(is_adam ? kFusedApplyAdam : kFusedApplyGradientDescent);
+  fused->set_device(first.device());
+
+  // Resource inputs, grouped slot-major: all vars, then all ms, then all vs.
+  for (int slot = 0; slot < num_resources; ++slot) {
+    for (const NodeDef* member : members) {
+      fused->add_input(member->input(slot));
+    }
+  }
+  // Shared scalar hyperparameters, taken from the first member (identical
+  // across the group by construction of the grouping key).
+  for (int i = 0; i < num_scalars; ++i) {
+    fused->add_input(first.input(num_resources + i));
+  }
+  // Gradients.
+  for (const NodeDef* member : members) {
+    fused->add_input(member->input(num_resources + num_scalars));
+  }
+  // Union of the members' control inputs, minus edges between members (they
+  // are subsumed by the fusion).
+  absl::flat_hash_set<string> member_names;
+  for (const NodeDef* member : members) member_names.insert(member->name());
+  absl::flat_hash_set<string> control_inputs;
+  for (const NodeDef* member : members) {
+    for (const string& input : member->input()) {
+      if (!IsControlInput(input)) continue;
+      if (member_names.contains(NodeName(input))) continue;
+      if (control_inputs.insert(input).second) fused->add_input(input);
+    }
+  }
+
+  (*fused->mutable_attr())["N"].set_i(n);
+  (*fused->mutable_attr())["T"] = first.attr().at("T");
+  (*fused->mutable_attr())["use_locking"] = first.attr().at("use_locking");
+  if (is_adam) {
+    (*fused->mutable_attr())["use_nesterov"] = first.attr().at("use_nesterov");
+  }
+  node_map->AddNode(fused->name(), fused);
+  for (const string& input : fused->input()) {
+    node_map->AddOutput(NodeName(input), fused->name());
+  }
+
+  // Rewire control fanouts of the members to the fused node.
+  const string fused_control = AsControlDependency(*fused);
+  for (const NodeDef* member : members) {
+    const auto consumers = node_map->GetOutputs(member->name());
+    for (NodeDef* consumer : consumers) {
+      bool already_depends = false;
+      for (const string& input : consumer->input()) {
+        if (input == fused_control) already_depends = true;
+      }
+      auto* inputs = consumer->mutable_input();
+      for (auto it = inputs->begin(); it != inputs->end();) {
+        if (IsControlInput(*it) && NodeName(*it) == member->name()) {
+          it = inputs->erase(it);
+        } else {
+          ++it;
+        }
+      }
+      if (!already_depends) {
+        consumer->add_input(fused_control);
+        node_map->AddOutput(fused->name(), consumer->name());
+      }
+    }
+    nodes_to_delete->insert(member->name());
+  }
+}
+
+}  // namespace
+
+Status FusedApplyOptimizer::Optimize(Cluster* cluster, const GrapplerItem& item,
+                                     GraphDef* optimized_graph) {
+  *optimized_graph = item.graph;
+  NodeMap node_map(optimized_graph);
+  const std::unordered_set<string> nodes_to_preserve = item.NodesToPreserve();
+
+  // Group candidates by their fusion key, in graph order for determinism.
+  absl::flat_hash_map<string, std::vector<NodeDef*>> groups;
+  std::vector<string> group_order;
+  for (NodeDef& node : *optimized_graph->mutable_node()) {
+    if (node.op() != kApplyAdam && node.op() != kApplyGradientDescent) {
+      continue;
+    }
+    if (!NodeIsOnCpu(node)) continue;
+    if (nodes_to_preserve.count(node.name()) > 0) continue;
+    if (!node.attr().contains("T")) continue;
+    if (!HasOnlyTerminalControlFanouts(node_map, node)) continue;
+    auto emplaced = groups.emplace(GroupingKey(node), std::vector<NodeDef*>());
+    if (emplaced.second) group_order.push_back(emplaced.first->first);
+    emplaced.first->second.push_back(&node);
+  }
+
+  std::set<string> nodes_to_delete;
+  for (const string& key : group_order) {
+    std::vector<NodeDef*>& candidates = groups[key];
+    // Drop candidates that share a resource input with an earlier member:
+    // updating the same variable twice must keep its two apply nodes.
+    absl::flat_hash_set<string> seen_resources;
+    std::vector<NodeDef*> members;
+    for (NodeDef* candidate : candidates) {
+      const int num_resources = NumResourceInputs(*candidate);
+      bool duplicate = false;
+      for (int i = 0; i < num_resources; ++i) {
+        if (seen_resources.contains(candidate->input(i))) duplicate = true;
+      }
+      if (duplicate) continue;
+      for (int i = 0; i < num_resources; ++i) {
+        seen_resources.insert(candidate->input(i));
+      }
+      members.push_back(candidate);
+    }
+    if (members.size() < 2) continue;
+    FuseGroup(members, &node_map, optimized_graph, &nodes_to_delete);
+  }
+
+  EraseNodesFromGraph(nodes_to_delete, optimized_graph);
+  return absl::OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(FusedApplyOptimizer, "fused_apply");
+
+}  // namespace grappler
+}  // namespace tensorflow
@@ -0,0 +1,58 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_FUSED_APPLY_OPTIMIZER_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_FUSED_APPLY_OPTIMIZER_H_
+
+#include <string>
+
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// Groups independent per-variable optimizer updates into multi-tensor apply
+// ops, so that a step updating thousands of small variables pays per-op
+// dispatch overhead once per group instead of once per variable.
+//
+// ResourceApplyAdam and ResourceApplyGradientDescent nodes placed on CPU that
+// share the same scalar hyperparameter tensors, data type and attributes are
+// replaced by a single _FusedResourceApplyAdam or
+// _FusedResourceApplyGradientDescent node updating all of their variables.
+// Only nodes whose control fanouts lead to terminal nodes (e.g. the train-op
+// NoOp group) are fused, which guarantees the rewrite cannot create a cycle.
+//
+// This is an opt-in pass: enable it by adding "fused_apply" to
+// `RewriterConfig.custom_optimizers`.
+class FusedApplyOptimizer : public CustomGraphOptimizer {
+ public:
+  Status Init(
+      const RewriterConfig_CustomGraphOptimizer* config = nullptr) override {
+    return absl::OkStatus();
+  }
+
+  std::string name() const override { return "fused_apply"; }
+
+  bool UsesFunctionLibrary() const override { return false; }
+
+  Status Optimize(Cluster* cluster, const GrapplerItem& item,
+                  GraphDef* optimized_graph) override;
+};
+
+}  // namespace grappler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_FUSED_APPLY_OPTIMIZER_H_
@@ -0,0 +1,208 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/fused_apply_optimizer.h"
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/grappler/utils/grappler_test.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+using test::function::NDef;
+
+constexpr char kDevice[] = "/job:localhost/replica:0/task:0/device:CPU:0";
+
+class FusedApplyOptimizerTest : public GrapplerTest {
+ protected:
+  // Adds the variable handles, gradient, and ResourceApplyAdam node for one
+  // variable named `name` to `nodes`, using the given hyperparameter nodes.
+  void AddAdamUpdate(const string& name, const string& lr,
+                     std::vector<NodeDef>* nodes) {
+    for (const string& slot : {"", "_m", "_v"}) {
+      nodes->push_back(NDef(name + slot, "VarHandleOp", {},
+                            {{"dtype", DT_FLOAT}, {"shape", TensorShape({2})}},
+                            kDevice));
+    }
+    nodes->push_back(NDef(name + "_grad", "Const", {},
+                          {{"dtype", DT_FLOAT}, {"value", Tensor(2.0f)}},
+                          kDevice));
+    nodes->push_back(
+        NDef(name + "_update", "ResourceApplyAdam",
+             {name, name + "_m", name + "_v", "beta1_power", "beta2_power", lr,
+              "beta1", "beta2", "epsilon", name + "_grad"},
+             {{"T", DT_FLOAT},
+              {"use_locking", false},
+              {"use_nesterov", false}},
+             kDevice));
+  }
+
+  NodeDef ScalarConst(const string& name, float value) {
+    return NDef(name, "Const", {},
+                {{"dtype", DT_FLOAT}, {"value", Tensor(value)}}, kDevice);
+  }
+};
+
+TEST_F(FusedApplyOptimizerTest, GroupsAdamUpdates) {
+  GrapplerItem item;
+  std::vector<NodeDef> nodes = {
+      ScalarConst("beta1_power", 0.9f), ScalarConst("beta2_power", 0.999f),
+      ScalarConst("lr", 0.001f),        ScalarConst("beta1", 0.9f),
+      ScalarConst("beta2", 0.999f),     ScalarConst("epsilon", 1e-8f),
+  };
+  AddAdamUpdate("var_a", "lr", &nodes);
+  AddAdamUpdate("var_b", "lr", &nodes);
+  AddAdamUpdate("var_c", "lr", &nodes);
+  nodes.push_back(NDef("train", "NoOp",
+                       {"^var_a_update", "^var_b_update", "^var_c_update"}, {},
+                       kDevice));
+  item.graph = test::function::GDef(nodes);
+  item.fetch = {"train"};
+
+  FusedApplyOptimizer optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int num_fused = 0;
+  const NodeDef* fused = nullptr;
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "ResourceApplyAdam");
+    if (node.op() == "_FusedResourceApplyAdam") {
+      ++num_fused;
+      fused = &node;
+    }
+  }
+  ASSERT_EQ(num_fused, 1);
+  EXPECT_EQ(fused->attr().at("N").i(), 3);
+  // var, m, v for each variable, six scalars, and one gradient per variable.
+  ASSERT_EQ(fused->input_size(), 3 * 3 + 6 + 3);
+  EXPECT_EQ(fused->input(0), "var_a");
+  EXPECT_EQ(fused->input(3), "var_a_m");
+  EXPECT_EQ(fused->input(6), "var_a_v");
+  EXPECT_EQ(fused->input(11), "lr");
+
+  // The train op now depends on the fused node instead of the members.
+  NodeMap node_map(&output);
+  const NodeDef* train = node_map.GetNode("train");
+  ASSERT_NE(train, nullptr);
+  ASSERT_EQ(train->input_size(), 1);
+  EXPECT_EQ(train->input(0), AsControlDependency(*fused));
+}
+
+TEST_F(FusedApplyOptimizerTest, DifferentHyperparametersNotGrouped) {
+  GrapplerItem item;
+  std::vector<NodeDef> nodes = {
+      ScalarConst("beta1_power", 0.9f), ScalarConst("beta2_power", 0.999f),
+      ScalarConst("lr", 0.001f),        ScalarConst("lr_2", 0.01f),
+      ScalarConst("beta1", 0.9f),       ScalarConst("beta2", 0.999f),
+      ScalarConst("epsilon", 1e-8f),
+  };
+  AddAdamUpdate("var_a", "lr", &nodes);
+  AddAdamUpdate("var_b", "lr_2", &nodes);
+  nodes.push_back(
+      NDef("train", "NoOp", {"^var_a_update", "^var_b_update"}, {}, kDevice));
+  item.graph = test::function::GDef(nodes);
+  item.fetch = {"train"};
+
+  FusedApplyOptimizer optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int num_apply = 0;
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "_FusedResourceApplyAdam");
+    if (node.op() == "ResourceApplyAdam") ++num_apply;
+  }
+  EXPECT_EQ(num_apply, 2);
+}
+
+TEST_F(FusedApplyOptimizerTest, NonTerminalFanoutNotGrouped) {
+  GrapplerItem item;
+  std::vector<NodeDef> nodes = {
+      ScalarConst("beta1_power", 0.9f), ScalarConst("beta2_power", 0.999f),
+      ScalarConst("lr", 0.001f),        ScalarConst("beta1", 0.9f),
+      ScalarConst("beta2", 0.999f),     ScalarConst("epsilon", 1e-8f),
+  };
+  AddAdamUpdate("var_a", "lr", &nodes);
+  AddAdamUpdate("var_b", "lr", &nodes);
+  // "after_a" has a fanout of its own, so fusing "var_a_update" could
+  // introduce a cycle; the group must be left alone.
+  nodes.push_back(NDef("after_a", "Identity", {"lr", "^var_a_update"},
+                       {{"T", DT_FLOAT}}, kDevice));
+  nodes.push_back(NDef("train", "NoOp", {"after_a", "^var_b_update"}, {},
+                       kDevice));
+  item.graph = test::function::GDef(nodes);
+  item.fetch = {"train"};
+
+  FusedApplyOptimizer optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "_FusedResourceApplyAdam");
+  }
+}
+
+TEST_F(FusedApplyOptimizerTest, GroupsGradientDescentUpdates) {
+  GrapplerItem item;
+  std::vector<NodeDef> nodes = {ScalarConst("alpha", 0.1f)};
+  for (const string& name : {"var_a", "var_b"}) {
+    nodes.push_back(NDef(name, "VarHandleOp", {},
+                         {{"dtype", DT_FLOAT}, {"shape", TensorShape({2})}},
+                         kDevice));
+    nodes.push_back(NDef(name + "_delta", "Const", {},
+                         {{"dtype", DT_FLOAT}, {"value", Tensor(2.0f)}},
+                         kDevice));
+    nodes.push_back(NDef(name + "_update", "ResourceApplyGradientDescent",
+                         {name, "alpha", name + "_delta"},
+                         {{"T", DT_FLOAT}, {"use_locking", false}}, kDevice));
+  }
+  nodes.push_back(
+      NDef("train", "NoOp", {"^var_a_update", "^var_b_update"}, {}, kDevice));
+  item.graph = test::function::GDef(nodes);
+  item.fetch = {"train"};
+
+  FusedApplyOptimizer optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int num_fused = 0;
+  const NodeDef* fused = nullptr;
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "ResourceApplyGradientDescent");
+    if (node.op() == "_FusedResourceApplyGradientDescent") {
+      ++num_fused;
+      fused = &node;
+    }
+  }
+  ASSERT_EQ(num_fused, 1);
+  EXPECT_EQ(fused->attr().at("N").i(), 2);
+  // Two vars, alpha, and two deltas.
+  ASSERT_EQ(fused->input_size(), 2 + 1 + 2);
+  EXPECT_EQ(fused->input(2), "alpha");
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
@@ -0,0 +1,477 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/inference/shape_specialization.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/op_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_shape.pb.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/grappler/op_types.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+namespace grappler {
+
+namespace {
+
+// Name scope holding the runtime dispatch machinery (shape extraction,
+// predicates and switches).
+constexpr char kDispatchPrefix[] = "shape_dispatch";
+// Name scope prefix of the cloned subgraphs; the batch size is appended.
+constexpr char kSpecializedPrefix[] = "specialized";
+// Suffix appended to fetch nodes of the original (generic) subgraph so the
+// fetch name can be taken over by the dispatching Merge node.
+constexpr char kGenericSuffix[] = "generic";
+
+std::vector<int64_t> BatchSizesFromEnv() {
+  string value;
+  TF_CHECK_OK(ReadStringFromEnvVar(
+      "TF_GRAPPLER_SHAPE_SPECIALIZATION_BATCH_SIZES", "", &value));
+  std::vector<int64_t> batch_sizes;
+  for (const absl::string_view size_str :
+       absl::StrSplit(value, ',', absl::SkipEmpty())) {
+    int64_t size;
+    if (!absl::SimpleAtoi(size_str, &size) || size <= 0) {
+      LOG(WARNING) << "Ignoring invalid batch size '" << size_str
+                   << "' in TF_GRAPPLER_SHAPE_SPECIALIZATION_BATCH_SIZES";
+      continue;
+    }
+    batch_sizes.push_back(size);
+  }
+  return batch_sizes;
+}
+
+// A placeholder can be specialized if its leading dimension is unknown: that
+// is the dimension the dispatch predicates test at runtime.
+bool IsSpecializablePlaceholder(const NodeDef& node) {
+  if (node.op() != "Placeholder") {
+    return false;
+  }
+  auto it = node.attr().find("shape");
+  if (it == node.attr().end() || !it->second.has_shape()) {
+    return false;
+  }
+  const TensorShapeProto& shape = it->second.shape();
+  return !shape.unknown_rank() && shape.dim_size() >= 1 &&
+         shape.dim(0).size() < 0;
+}
+
+// Rewrites the node name referenced by `input` (which may carry a control
+// prefix or an output port suffix) according to `renamed`. Inputs referencing
+// nodes absent from the map are returned unchanged.
+string RewriteInputName(const std::unordered_map<string, string>& renamed,
+                        const string& input) {
+  const bool is_control = !input.empty() && input[0] == '^';
+  const string stripped = is_control ? input.substr(1) : input;
+  const size_t colon = stripped.find(':');
+  auto it = renamed.find(stripped.substr(0, colon));
+  if (it == renamed.end()) {
+    return input;
+  }
+  string result = is_control ? absl::StrCat("^", it->second) : it->second;
+  if (colon != string::npos) {
+    absl::StrAppend(&result, stripped.substr(colon));
+  }
+  return result;
+}
+
+NodeDef* AddInt32Const(const string& name, const std::vector<int32_t>& values,
+                       bool scalar, const string& device, GraphDef* graph) {
+  NodeDef* node = graph->add_node();
+  node->set_name(name);
+  node->set_op("Const");
+  node->set_device(device);
+  (*node->mutable_attr())["dtype"].set_type(DT_INT32);
+  Tensor tensor(DT_INT32,
+                scalar ? TensorShape({})
+                       : TensorShape({static_cast<int64_t>(values.size())}));
+  for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+    tensor.flat<int32>()(i) = values[i];
+  }
+  tensor.AsProtoTensorContent(
+      (*node->mutable_attr())["value"].mutable_tensor());
+  return node;
+}
+
+NodeDef* AddLogicOp(const string& name, const string& op,
+                    const string& input_a, const string& input_b,
+                    const string& device, GraphDef* graph) {
+  NodeDef* node = graph->add_node();
+  node->set_name(name);
+  node->set_op(op);
+  node->set_device(device);
+  *node->add_input() = input_a;
+  *node->add_input() = input_b;
+  return node;
+}
+
+}  // namespace
+
+Status ShapeSpecializationOptimizer::Init(
+    const ::tensorflow::RewriterConfig_CustomGraphOptimizer* config) {
+  batch_sizes_.clear();
+  if (config != nullptr) {
+    auto it = config->parameter_map().find("batch_sizes");
+    if (it != config->parameter_map().end()) {
+      for (int64_t size : it->second.list().i()) {
+        if (size <= 0) {
+          return errors::InvalidArgument(
+              "Shape specialization batch sizes must be positive; got ", size);
+        }
+        batch_sizes_.push_back(size);
+      }
+    }
+  }
+  if (batch_sizes_.empty()) {
+    batch_sizes_ = BatchSizesFromEnv();
+  }
+  std::sort(batch_sizes_.begin(), batch_sizes_.end());
+  batch_sizes_.erase(std::unique(batch_sizes_.begin(), batch_sizes_.end()),
+                     batch_sizes_.end());
+  return absl::OkStatus();
+}
+
+Status ShapeSpecializationOptimizer::Optimize(Cluster* cluster,
+                                              const GrapplerItem& item,
+                                              GraphDef* optimized_graph) {
+  *optimized_graph = item.graph;
+  if (batch_sizes_.empty()) {
+    return absl::OkStatus();
+  }
+
+  // Collect the placeholders whose batch dimension the dispatch will test.
+  std::unordered_set<string> spec_placeholders;
+  std::vector<const NodeDef*> placeholder_nodes;
+  for (const NodeDef& node : item.graph.node()) {
+    if (IsSpecializablePlaceholder(node)) {
+      spec_placeholders.insert(node.name());
+      placeholder_nodes.push_back(&node);
+    }
+  }
+  if (spec_placeholders.empty()) {
+    return absl::OkStatus();
+  }
+
+  // Compute the transitive consumers of the specialized placeholders: this is
+  // the subgraph that gets cloned per batch size.
+  std::unordered_map<string, std::vector<const NodeDef*>> consumers;
+  for (const NodeDef& node : item.graph.node()) {
+    for (const string& input : node.input()) {
+      consumers[NodeName(input)].push_back(&node);
+    }
+  }
+  std::unordered_set<string> dependent;
+  std::queue<string> to_visit;
+  for (const string& name : spec_placeholders) {
+    to_visit.push(name);
+  }
+  while (!to_visit.empty()) {
+    const string current = to_visit.front();
+    to_visit.pop();
+    for (const NodeDef* consumer : consumers[current]) {
+      if (dependent.insert(consumer->name()).second) {
+        to_visit.push(consumer->name());
+      }
+    }
+  }
+  if (dependent.empty()) {
+    return absl::OkStatus();
+  }
+
+  // Cloning is only safe when the dependent subgraph is stateless and free of
+  // control flow, and when no dependent node is fed or must be preserved
+  // under its original name (fetch nodes are handled with a Merge below).
+  const std::unordered_set<string> preserve = item.NodesToPreserve();
+  std::unordered_set<string> fetch_names;
+  for (const string& fetch : item.fetch) {
+    const string fetch_node = NodeName(fetch);
+    const size_t colon = fetch.find(':');
+    if (colon != string::npos && fetch.substr(colon) != ":0" &&
+        dependent.count(fetch_node) > 0) {
+      VLOG(1) << "Not specializing: fetch " << fetch
+              << " reads a non-zero output port";
+      return absl::OkStatus();
+    }
+    fetch_names.insert(fetch_node);
+  }
+  for (const auto& feed : item.feed) {
+    if (dependent.count(NodeName(feed.first)) > 0) {
+      VLOG(1) << "Not specializing: feed " << feed.first
+              << " targets the dependent subgraph";
+      return absl::OkStatus();
+    }
+  }
+  std::unordered_map<string, const NodeDef*> name_to_node;
+  for (const NodeDef& node : item.graph.node()) {
+    name_to_node[node.name()] = &node;
+    if (absl::StartsWith(node.name(), kDispatchPrefix) ||
+        absl::StartsWith(node.name(), kSpecializedPrefix)) {
+      VLOG(1) << "Not specializing: graph was already specialized";
+      return absl::OkStatus();
+    }
+  }
+  for (const string& name : dependent) {
+    const NodeDef& node = *name_to_node[name];
+    const OpDef* op_def = nullptr;
+    if (!OpRegistry::Global()->LookUpOpDef(node.op(), &op_def).ok() ||
+        op_def->is_stateful() || ModifiesFrameInfo(node) || IsSwitch(node) ||
+        IsMerge(node) || IsNextIteration(node)) {
+      VLOG(1) << "Not specializing: node " << name << " (" << node.op()
+              << ") cannot be cloned";
+      return absl::OkStatus();
+    }
+    if (preserve.count(name) > 0 && fetch_names.count(name) == 0) {
+      VLOG(1) << "Not specializing: node " << name
+              << " must be preserved under its original name";
+      return absl::OkStatus();
+    }
+  }
+
+  // Rename the dependent fetch nodes (the Merge nodes added below take over
+  // the fetch names so callers observe the dispatched value) and route the
+  // original (generic) subgraph through the false output of a Switch per
+  // placeholder, so it only runs when no profiled size matches.
+  std::unordered_map<string, string> generic_renames;
+  for (const string& fetch : fetch_names) {
+    if (dependent.count(fetch) == 0) {
+      continue;
+    }
+    const string renamed = absl::StrCat(fetch, "/", kGenericSuffix);
+    if (name_to_node.count(renamed) > 0) {
+      VLOG(1) << "Not specializing: node name " << renamed << " already taken";
+      return absl::OkStatus();
+    }
+    generic_renames[fetch] = renamed;
+  }
+  std::unordered_map<string, string> generic_switches;
+  for (const NodeDef* placeholder : placeholder_nodes) {
+    generic_switches[placeholder->name()] = absl::StrCat(
+        kDispatchPrefix, "/", placeholder->name(), "/", kGenericSuffix);
+  }
+  for (NodeDef& node : *optimized_graph->mutable_node()) {
+    if (dependent.count(node.name()) == 0) {
+      continue;
+    }
+    for (string& input : *node.mutable_input()) {
+      input = RewriteInputName(generic_renames, input);
+      if (input.empty() || input[0] == '^') {
+        continue;  // Control edges from placeholders carry no data.
+      }
+      auto it = generic_switches.find(NodeName(input));
+      if (it != generic_switches.end()) {
+        input = it->second;
+      }
+    }
+    auto renamed = generic_renames.find(node.name());
+    if (renamed != generic_renames.end()) {
+      node.set_name(renamed->second);
+    }
+  }
+
+  // Build the dispatch predicates: one batch-dimension extraction per
+  // placeholder, one equality test per (placeholder, size) pair.
+  const string& dispatch_device = placeholder_nodes[0]->device();
+  AddInt32Const(absl::StrCat(kDispatchPrefix, "/slice_begin"), {0},
+                /*scalar=*/false, dispatch_device, optimized_graph);
+  AddInt32Const(absl::StrCat(kDispatchPrefix, "/slice_end"), {1},
+                /*scalar=*/false, dispatch_device, optimized_graph);
+  AddInt32Const(absl::StrCat(kDispatchPrefix, "/slice_strides"), {1},
+                /*scalar=*/false, dispatch_device, optimized_graph);
+  for (const NodeDef* placeholder : placeholder_nodes) {
+    const string scope =
+        absl::StrCat(kDispatchPrefix, "/", placeholder->name());
+    const DataType dtype = placeholder->attr().at("dtype").type();
+    NodeDef* shape = optimized_graph->add_node();
+    shape->set_name(absl::StrCat(scope, "/shape"));
+    shape->set_op("Shape");
+    shape->set_device(placeholder->device());
+    *shape->add_input() = placeholder->name();
+    (*shape->mutable_attr())["T"].set_type(dtype);
+    (*shape->mutable_attr())["out_type"].set_type(DT_INT32);
+
+    NodeDef* batch_dim = optimized_graph->add_node();
+    batch_dim->set_name(absl::StrCat(scope, "/batch_dim"));
+    batch_dim->set_op("StridedSlice");
+    batch_dim->set_device(placeholder->device());
+    *batch_dim->add_input() = shape->name();
+    *batch_dim->add_input() = absl::StrCat(kDispatchPrefix, "/slice_begin");
+    *batch_dim->add_input() = absl::StrCat(kDispatchPrefix, "/slice_end");
+    *batch_dim->add_input() = absl::StrCat(kDispatchPrefix, "/slice_strides");
+    (*batch_dim->mutable_attr())["T"].set_type(DT_INT32);
+    (*batch_dim->mutable_attr())["Index"].set_type(DT_INT32);
+    (*batch_dim->mutable_attr())["begin_mask"].set_i(0);
+    (*batch_dim->mutable_attr())["end_mask"].set_i(0);
+    (*batch_dim->mutable_attr())["ellipsis_mask"].set_i(0);
+    (*batch_dim->mutable_attr())["new_axis_mask"].set_i(0);
+    (*batch_dim->mutable_attr())["shrink_axis_mask"].set_i(1);
+  }
+
+  std::unordered_map<int64_t, string> match_preds;
+  for (int64_t size : batch_sizes_) {
+    AddInt32Const(absl::StrCat(kDispatchPrefix, "/size_", size),
+                  {static_cast<int32_t>(size)}, /*scalar=*/true,
+                  dispatch_device, optimized_graph);
+    string pred;
+    for (const NodeDef* placeholder : placeholder_nodes) {
+      NodeDef* equal = optimized_graph->add_node();
+      equal->set_name(absl::StrCat(kDispatchPrefix, "/", placeholder->name(),
+                                   "/eq_", size));
+      equal->set_op("Equal");
+      equal->set_device(placeholder->device());
+      *equal->add_input() =
+          absl::StrCat(kDispatchPrefix, "/", placeholder->name(), "/batch_dim");
+      *equal->add_input() = absl::StrCat(kDispatchPrefix, "/size_", size);
+      (*equal->mutable_attr())["T"].set_type(DT_INT32);
+      (*equal->mutable_attr())["incompatible_shape_error"].set_b(true);
+      if (pred.empty()) {
+        pred = equal->name();
+      } else {
+        NodeDef* both = AddLogicOp(
+            absl::StrCat(kDispatchPrefix, "/match_", size, "_and_",
+                         placeholder->name()),
+            "LogicalAnd", pred, equal->name(), dispatch_device,
+            optimized_graph);
+        pred = both->name();
+      }
+    }
+    match_preds[size] = pred;
+  }
+  string any_match;
+  for (int64_t size : batch_sizes_) {
+    if (any_match.empty()) {
+      any_match = match_preds[size];
+    } else {
+      NodeDef* either = AddLogicOp(
+          absl::StrCat(kDispatchPrefix, "/any_match_", size), "LogicalOr",
+          any_match, match_preds[size], dispatch_device, optimized_graph);
+      any_match = either->name();
+    }
+  }
+
+  // Add the per-placeholder switches: the false output of the generic switch
+  // feeds the original subgraph, the true output of each per-size switch
+  // feeds the corresponding clone through an EnsureShape node that pins the
+  // batch dimension, enabling static shape inference within the clone.
+  for (const NodeDef* placeholder : placeholder_nodes) {
+    const DataType dtype = placeholder->attr().at("dtype").type();
+    NodeDef* generic_switch = optimized_graph->add_node();
+    generic_switch->set_name(generic_switches[placeholder->name()]);
+    generic_switch->set_op("Switch");
+    generic_switch->set_device(placeholder->device());
+    *generic_switch->add_input() = placeholder->name();
+    *generic_switch->add_input() = any_match;
+    (*generic_switch->mutable_attr())["T"].set_type(dtype);
+
+    for (int64_t size : batch_sizes_) {
+      NodeDef* spec_switch = optimized_graph->add_node();
+      spec_switch->set_name(absl::StrCat(
+          kDispatchPrefix, "/", placeholder->name(), "/batch_", size));
+      spec_switch->set_op("Switch");
+      spec_switch->set_device(placeholder->device());
+      *spec_switch->add_input() = placeholder->name();
+      *spec_switch->add_input() = match_preds[size];
+      (*spec_switch->mutable_attr())["T"].set_type(dtype);
+
+      NodeDef* pinned = optimized_graph->add_node();
+      pinned->set_name(absl::StrCat(kSpecializedPrefix, "_", size, "/",
+                                    placeholder->name()));
+      pinned->set_op("EnsureShape");
+      pinned->set_device(placeholder->device());
+      *pinned->add_input() = absl::StrCat(spec_switch->name(), ":1");
+      (*pinned->mutable_attr())["T"].set_type(dtype);
+      TensorShapeProto pinned_shape = placeholder->attr().at("shape").shape();
+      pinned_shape.mutable_dim(0)->set_size(size);
+      *(*pinned->mutable_attr())["shape"].mutable_shape() = pinned_shape;
+    }
+  }
+
+  // Clone the dependent subgraph once per batch size. Since the EnsureShape
+  // nodes above reuse the clone naming scheme for the placeholders, input
+  // remapping is uniform: anything dependent or specialized moves into the
+  // clone's name scope, everything else is shared with the original graph.
+  for (int64_t size : batch_sizes_) {
+    std::unordered_map<string, string> clone_renames;
+    const string clone_prefix = absl::StrCat(kSpecializedPrefix, "_", size);
+    for (const string& name : dependent) {
+      clone_renames[name] = absl::StrCat(clone_prefix, "/", name);
+    }
+    for (const string& name : spec_placeholders) {
+      clone_renames[name] = absl::StrCat(clone_prefix, "/", name);
+    }
+    for (const string& name : dependent) {
+      NodeDef* clone = optimized_graph->add_node();
+      *clone = *name_to_node[name];
+      clone->set_name(clone_renames[name]);
+      for (string& input : *clone->mutable_input()) {
+        input = RewriteInputName(clone_renames, input);
+      }
+    }
+  }
+
+  // Merge the generic and specialized values under the original fetch names.
+  // Exactly one dispatch branch is live, so each Merge forwards the value of
+  // the branch that ran.
+  for (const auto& rename : generic_renames) {
+    const NodeDef& fetch_node = *name_to_node[rename.first];
+    const OpDef* op_def = nullptr;
+    TF_RETURN_IF_ERROR(
+        OpRegistry::Global()->LookUpOpDef(fetch_node.op(), &op_def));
+    DataType dtype;
+    TF_RETURN_IF_ERROR(OutputTypeForNode(fetch_node, *op_def, 0, &dtype));
+    NodeDef* merge = optimized_graph->add_node();
+    merge->set_name(rename.first);
+    merge->set_op("Merge");
+    merge->set_device(fetch_node.device());
+    *merge->add_input() = rename.second;
+    for (int64_t size : batch_sizes_) {
+      *merge->add_input() =
+          absl::StrCat(kSpecializedPrefix, "_", size, "/", rename.first);
+    }
+    (*merge->mutable_attr())["T"].set_type(dtype);
+    (*merge->mutable_attr())["N"].set_i(merge->input_size());
+  }
+
+  VLOG(1) << "Specialized " << dependent.size() << " nodes for "
+          << batch_sizes_.size() << " batch sizes across "
+          << placeholder_nodes.size() << " placeholders";
+  return absl::OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(ShapeSpecializationOptimizer,
+                            "shape_specialization");
+
+}  // namespace grappler
+}  // namespace tensorflow
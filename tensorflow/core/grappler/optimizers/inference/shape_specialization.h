@@ -0,0 +1,63 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_INFERENCE_SHAPE_SPECIALIZATION_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_INFERENCE_SHAPE_SPECIALIZATION_H_
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// Clones the subgraph fed by placeholders with an unknown leading (batch)
+// dimension once per profiled batch size, with the placeholder shapes pinned
+// to the concrete size in each clone. A runtime shape dispatch (Shape ->
+// Equal -> Switch per placeholder, Merge at each fetch) routes execution to
+// the matching clone, or to the original graph when no profiled size matches.
+//
+// Pinning the batch dimension lets downstream optimizers constant-fold shape
+// arithmetic and emit statically shaped allocations on the hot path, similar
+// to what bucketized compilation provides under XLA but for the regular
+// executor.
+//
+// The profiled sizes are taken from the "batch_sizes" parameter of the
+// rewriter config, or from the TF_GRAPPLER_SHAPE_SPECIALIZATION_BATCH_SIZES
+// environment variable (a comma-separated list) when the parameter is unset.
+// The pass leaves the graph unchanged when the subgraph to clone contains
+// stateful or control-flow ops, since those cannot safely be duplicated.
+class ShapeSpecializationOptimizer : public CustomGraphOptimizer {
+ public:
+  Status Init(
+      const ::tensorflow::RewriterConfig_CustomGraphOptimizer* config) override;
+
+  std::string name() const override { return "shape_specialization"; }
+
+  bool UsesFunctionLibrary() const override { return false; }
+
+  Status Optimize(Cluster* cluster, const GrapplerItem& item,
+                  GraphDef* optimized_graph) override;
+
+ private:
+  std::vector<int64_t> batch_sizes_;
+};
+
+}  // namespace grappler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_INFERENCE_SHAPE_SPECIALIZATION_H_
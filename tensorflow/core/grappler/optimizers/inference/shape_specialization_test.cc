@@ -0,0 +1,137 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/inference/shape_specialization.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/grappler/utils/grappler_test.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+class ShapeSpecializationTest : public GrapplerTest {
+ protected:
+  static RewriterConfig_CustomGraphOptimizer ConfigWithBatchSizes(
+      const std::vector<int64_t>& batch_sizes) {
+    RewriterConfig_CustomGraphOptimizer config;
+    auto* list = (*config.mutable_parameter_map())["batch_sizes"]
+                     .mutable_list();
+    for (int64_t size : batch_sizes) {
+      list->add_i(size);
+    }
+    return config;
+  }
+};
+
+TEST_F(ShapeSpecializationTest, SpecializesAndDispatchesByBatchSize) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  auto input = ops::Placeholder(s.WithOpName("input"), DT_FLOAT,
+                                ops::Placeholder::Shape({-1, 4}));
+  auto two = ops::Const(s.WithOpName("two"), 2.0f, {});
+  auto mul = ops::Mul(s.WithOpName("mul"), input, two);
+  auto output = ops::Identity(s.WithOpName("output"), mul);
+
+  GrapplerItem item;
+  item.fetch = {"output"};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  ShapeSpecializationOptimizer optimizer;
+  auto config = ConfigWithBatchSizes({8});
+  TF_ASSERT_OK(optimizer.Init(&config));
+  GraphDef optimized;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &optimized));
+
+  NodeMap node_map(&optimized);
+  NodeDef* merge = node_map.GetNode("output");
+  ASSERT_NE(merge, nullptr);
+  EXPECT_EQ(merge->op(), "Merge");
+  EXPECT_EQ(merge->input(0), "output/generic");
+  EXPECT_EQ(merge->input(1), "specialized_8/output");
+
+  NodeDef* pinned = node_map.GetNode("specialized_8/input");
+  ASSERT_NE(pinned, nullptr);
+  EXPECT_EQ(pinned->op(), "EnsureShape");
+  EXPECT_EQ(pinned->attr().at("shape").shape().dim(0).size(), 8);
+
+  NodeDef* generic = node_map.GetNode("output/generic");
+  ASSERT_NE(generic, nullptr);
+  EXPECT_EQ(generic->op(), "Identity");
+
+  // Both the specialized and the generic path must compute the same values
+  // as the original graph.
+  for (int batch : {8, 3}) {
+    Tensor input_t(DT_FLOAT, TensorShape({batch, 4}));
+    input_t.flat<float>().setRandom();
+    auto expected = EvaluateNodes(item.graph, item.fetch,
+                                  {{"input", input_t}});
+    auto actual = EvaluateNodes(optimized, item.fetch, {{"input", input_t}});
+    ASSERT_EQ(actual.size(), 1);
+    test::ExpectTensorEqual<float>(actual[0], expected[0]);
+  }
+}
+
+TEST_F(ShapeSpecializationTest, SkipsStatefulSubgraphs) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  auto input = ops::Placeholder(s.WithOpName("input"), DT_FLOAT,
+                                ops::Placeholder::Shape({-1, 4}));
+  auto shape = ops::Shape(s.WithOpName("shape"), input);
+  // RandomUniform is stateful, so the dependent subgraph cannot be cloned.
+  auto noise = ops::RandomUniform(s.WithOpName("noise"), shape, DT_FLOAT);
+  auto output = ops::Add(s.WithOpName("output"), input, noise);
+
+  GrapplerItem item;
+  item.fetch = {"output"};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  ShapeSpecializationOptimizer optimizer;
+  auto config = ConfigWithBatchSizes({8});
+  TF_ASSERT_OK(optimizer.Init(&config));
+  GraphDef optimized;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &optimized));
+
+  EXPECT_EQ(optimized.node_size(), item.graph.node_size());
+}
+
+TEST_F(ShapeSpecializationTest, NoOpWithoutBatchSizes) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  auto input = ops::Placeholder(s.WithOpName("input"), DT_FLOAT,
+                                ops::Placeholder::Shape({-1, 4}));
+  auto output = ops::Identity(s.WithOpName("output"), input);
+
+  GrapplerItem item;
+  item.fetch = {"output"};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  ShapeSpecializationOptimizer optimizer;
+  TF_ASSERT_OK(optimizer.Init(nullptr));
+  GraphDef optimized;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &optimized));
+
+  EXPECT_EQ(optimized.node_size(), item.graph.node_size());
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
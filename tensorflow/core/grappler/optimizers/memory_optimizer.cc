@@ -43,6 +43,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/protobuf/rewriter_config.pb.h"
 #include "tensorflow/core/util/device_name_utils.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace grappler {
@@ -56,6 +57,20 @@ const char* kRecomputeTriggerNodePrefix = "RecomputeTrigger";
 // recomputed.
 const char* kRecomputeHint = "_recompute_hint";
 
+// Peak memory target in bytes for the profile-guided recomputation mode, or 0
+// to disable it. When set, recompute candidates are chosen from the measured
+// peak-memory profile of the graph instead of the name-scope heuristics, which
+// only recognize targets under recomputation_targets_name_scope (by default
+// "gradients/") and therefore miss custom training loops.
+int64_t RecomputationTargetPeakBytes() {
+  // Read on each rewriting pass (rather than once per process) so the knob
+  // can be adjusted between optimization runs.
+  int64_t target_peak_bytes;
+  TF_CHECK_OK(ReadInt64FromEnvVar(
+      "TF_GRAPPLER_RECOMPUTATION_TARGET_PEAK_BYTES", 0, &target_peak_bytes));
+  return target_peak_bytes;
+}
+
 // Ops which we wouldn't mind recomputing to save memory.
 // TODO(allenl): Replace this list with a cost model.
 std::unordered_set<string> GetCheapToRecomputeOps() {
@@ -225,6 +240,102 @@ std::vector<RecomputedSubGraph> GetOpGroupsToRecompute(
   return subgraphs_to_recompute;
 }
 
+// Chooses recompute candidates and target nodes from the measured peak-memory
+// profile of `item` instead of matching node names against a name scope.
+// Candidates are producers of the largest tensors held live across the peak
+// whose late consumers (nodes that complete after the peak) can instead
+// trigger a recomputation; those late consumers become the targets. Selection
+// stops once the freed bytes are estimated to bring the peak under
+// `target_peak_bytes`. Returns false if no plan could be built, in which case
+// the caller should fall back to the name-scope heuristics.
+bool PlanProfileGuidedRecomputation(
+    Cluster* cluster, const GrapplerItem& item, const NodeMap& node_map,
+    int64_t target_peak_bytes,
+    const std::function<bool(const NodeDef&)>& is_recomputable,
+    std::unordered_set<string>* recompute_names,
+    std::unordered_set<string>* target_names) {
+  GraphMemory memory(item);
+  Status s = memory.InferStatically(cluster->GetDevices());
+  if (!s.ok()) {
+    VLOG(1) << "Failed to infer memory usage: " << s.message();
+    return false;
+  }
+  std::unordered_map<const NodeDef*, Costs::NanoSeconds> execution_times;
+  if (!EstimateEarliestExecutionTimes(item, cluster, &execution_times).ok()) {
+    return false;
+  }
+  // The execution times are keyed on nodes of item.graph; index them by name
+  // since the planning below works on a (topologically sorted) copy.
+  std::unordered_map<string, Costs::NanoSeconds> completion_times;
+  for (const auto& node_and_time : execution_times) {
+    completion_times[node_and_time.first->name()] = node_and_time.second;
+  }
+
+  for (const auto& device : cluster->GetDevices()) {
+    const GraphMemory::MemoryUsage& mem_usage =
+        memory.GetPeakMemoryUsage(device.first);
+    if (mem_usage.used_memory <= target_peak_bytes) {
+      continue;
+    }
+    int64_t required_savings = mem_usage.used_memory - target_peak_bytes;
+
+    Costs::Duration peak_time = -1;
+    for (const auto& live_tensor : mem_usage.live_tensors) {
+      if (live_tensor.allocation_time > peak_time) {
+        peak_time = live_tensor.allocation_time;
+      }
+    }
+
+    // Free the largest tensors first to minimize the number of recomputed
+    // subgraphs.
+    std::vector<const GraphMemory::LiveTensor*> ordered_tensors;
+    ordered_tensors.reserve(mem_usage.live_tensors.size());
+    for (const auto& live_tensor : mem_usage.live_tensors) {
+      ordered_tensors.push_back(&live_tensor);
+    }
+    std::sort(ordered_tensors.begin(), ordered_tensors.end(),
+              [](const GraphMemory::LiveTensor* first,
+                 const GraphMemory::LiveTensor* second) {
+                return first->memory_used > second->memory_used ||
+                       (first->memory_used == second->memory_used &&
+                        first->node < second->node);
+              });
+
+    for (const GraphMemory::LiveTensor* live_tensor : ordered_tensors) {
+      if (live_tensor->memory_used <= 1024) {
+        // Don't bother with small tensors.
+        break;
+      }
+      const NodeDef* producer = node_map.GetNode(live_tensor->node);
+      if (producer == nullptr || !is_recomputable(*producer)) {
+        continue;
+      }
+      // Recomputing only pays off for consumers which run after the peak:
+      // redirecting them to a recomputed copy lets the original tensor die
+      // before the peak instead of being held across it.
+      std::vector<const NodeDef*> late_consumers;
+      for (const NodeDef* consumer : node_map.GetOutputs(live_tensor->node)) {
+        auto it = completion_times.find(consumer->name());
+        if (it != completion_times.end() && it->second > peak_time) {
+          late_consumers.push_back(consumer);
+        }
+      }
+      if (late_consumers.empty()) {
+        continue;
+      }
+      recompute_names->insert(live_tensor->node);
+      for (const NodeDef* consumer : late_consumers) {
+        target_names->insert(consumer->name());
+      }
+      required_savings -= live_tensor->memory_used;
+      if (required_savings <= 0) {
+        break;
+      }
+    }
+  }
+  return !recompute_names->empty();
+}
+
 // Computes the maximum topological numbers of (1) target node components
 // (gradient nodes being fed by the recomputation), and (2) child recompute node
 // components for each recomputed node. We will not attach any control
@@ -442,7 +553,8 @@ void RecomputeSubgraph(
 
 void RecomputationRewritingPass(RewriterConfig::MemOptType optimization_level,
                                 const string& recomputation_targets_name_scope,
-                                GraphDef* graph, const GrapplerItem& item) {
+                                Cluster* cluster, GraphDef* graph,
+                                const GrapplerItem& item) {
   // The topological numberings and NodeMap will be stale as soon as we start
   // modifying the graph in RecomputeSubgraph. However, RecomputeSubgraph only
   // looks up nodes which were in the original graph, and preserves the graph
@@ -472,8 +584,44 @@ void RecomputationRewritingPass(RewriterConfig::MemOptType optimization_level,
                    "/" + recomputation_targets_name_scope)) != -1;
       };
 
-  if (optimization_level == RewriterConfig::RECOMPUTATION_HEURISTICS ||
-      optimization_level == RewriterConfig::HEURISTICS) {
+  const int64_t target_peak_bytes = RecomputationTargetPeakBytes();
+  bool planned_from_profile = false;
+  if (target_peak_bytes > 0 && cluster != nullptr) {
+    // Profile-guided mode: pick candidates and targets from the measured
+    // peak-memory profile. The manual level still only recomputes nodes that
+    // carry an explicit hint; the heuristic levels also admit cheap ops.
+    std::unordered_set<string> cheap_to_recompute_ops =
+        GetCheapToRecomputeOps();
+    const bool hinted_only = optimization_level == RewriterConfig::MANUAL;
+    std::unordered_set<string> recompute_names;
+    std::unordered_set<string> target_names;
+    if (PlanProfileGuidedRecomputation(
+            cluster, item, node_map, target_peak_bytes,
+            [&cheap_to_recompute_ops, &feeds,
+             hinted_only](const NodeDef& node) {
+              return feeds.count(node.name()) == 0 &&
+                     (node.attr().count(kRecomputeHint) > 0 ||
+                      (!hinted_only &&
+                       cheap_to_recompute_ops.count(node.op()) > 0));
+            },
+            &recompute_names, &target_names)) {
+      is_target = [target_names](const NodeDef& node) {
+        return target_names.count(node.name()) > 0;
+      };
+      recomputed_subgraphs = GetOpGroupsToRecompute(
+          graph, node_map,
+          [&recompute_names, &is_target](const NodeDef& node) {
+            return !is_target(node) && recompute_names.count(node.name()) > 0;
+          },
+          is_target);
+      planned_from_profile = true;
+    }
+  }
+
+  if (planned_from_profile) {
+    // The profile-guided plan replaces the name-scope heuristics below.
+  } else if (optimization_level == RewriterConfig::RECOMPUTATION_HEURISTICS ||
+             optimization_level == RewriterConfig::HEURISTICS) {
     // TODO(allenl): Handle ResNet-like architectures better. Right now all of
     // the cheap forward ops get grouped into a single subgraph which must
     // execute before gradients start executing (unless layers are manually
@@ -1396,7 +1544,7 @@ Status MemoryOptimizer::Optimize(Cluster* cluster, const GrapplerItem& item,
 
   if (run_recomputation_pass) {
     RecomputationRewritingPass(optimization_level_,
-                               recomputation_targets_name_scope_,
+                               recomputation_targets_name_scope_, cluster,
                                &optimized_item.graph, item);
   }
 
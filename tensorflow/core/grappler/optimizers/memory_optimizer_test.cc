@@ -448,6 +448,46 @@ TEST_F(MemoryOptimizerTest, AccumulationRewrites) {
   }
 }
 
+TEST_F(MemoryOptimizerTest, ProfileGuidedRecomputation) {
+  // With a target peak, candidates come from the measured memory profile, so
+  // nothing here needs to live under the "gradients/" name scope.
+  setenv("TF_GRAPPLER_RECOMPUTATION_TARGET_PEAK_BYTES", "1", 1 /* replace */);
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output v = ops::Variable(s.WithOpName("v").WithDevice("/gpu:0"),
+                           {128, 128, 8}, DT_FLOAT);
+  Output b = ops::Relu(s.WithOpName("b").WithDevice("/gpu:0"), v);
+  Output c = ops::Sqrt(s.WithOpName("c").WithDevice("/gpu:0"), b);
+  Output d = ops::Exp(s.WithOpName("d").WithDevice("/gpu:0"), c);
+  // Late consumer of b: keeps b live across the peak unless b is recomputed.
+  Output e = ops::Add(s.WithOpName("e").WithDevice("/gpu:0"), d, b);
+  Output f = ops::Add(s.WithOpName("f").WithDevice("/gpu:0"), e, v);
+
+  GrapplerItem item;
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  item.fetch = {"f"};
+
+  std::unique_ptr<VirtualCluster> cluster(CreateVirtualCluster());
+  MemoryOptimizer optimizer(RewriterConfig::RECOMPUTATION_HEURISTICS);
+  GraphDef output;
+  Status status = optimizer.Optimize(cluster.get(), item, &output);
+  unsetenv("TF_GRAPPLER_RECOMPUTATION_TARGET_PEAK_BYTES");
+  TF_EXPECT_OK(status);
+
+  NodeMap node_map(&output);
+  NodeDef* recomputed_b = node_map.GetNode("Recomputed/b");
+  ASSERT_NE(recomputed_b, nullptr);
+  EXPECT_EQ("v", recomputed_b->input(0));
+  NodeDef* transformed_e = node_map.GetNode("e");
+  ASSERT_NE(transformed_e, nullptr);
+  EXPECT_EQ("d", transformed_e->input(0));
+  EXPECT_EQ("Recomputed/b", transformed_e->input(1));
+  // The early consumer keeps reading the original tensor.
+  NodeDef* transformed_c = node_map.GetNode("c");
+  ASSERT_NE(transformed_c, nullptr);
+  EXPECT_EQ("b", transformed_c->input(0));
+}
+
 class RelaxAllocatorConstraintsTest : public GrapplerTest {};
 
 TEST_F(RelaxAllocatorConstraintsTest, SameDevice) {
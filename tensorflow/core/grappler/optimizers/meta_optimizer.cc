@@ -61,9 +61,12 @@ limitations under the License.
 #include "tensorflow/core/grappler/utils/tpu.h"
 #include "tensorflow/core/grappler/verifiers/structure_verifier.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/map_util.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/util/dump_graph.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/util.h"
 #include "tensorflow/core/util/xla_config_registry.h"
 
@@ -103,6 +106,34 @@ int NumIterations(const RewriterConfig& cfg) {
              : cfg.meta_optimizer_iterations();
 }
 
+// Whether TF_GRAPPLER_INCREMENTAL_OPTIMIZATION was set. In incremental mode
+// the iteration loop below terminates as soon as a full iteration leaves the
+// graph unchanged, instead of always running NumIterations() iterations.
+bool IncrementalOptimizationEnabled() {
+  static const bool enabled = [] {
+    bool enabled = false;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_GRAPPLER_INCREMENTAL_OPTIMIZATION",
+                                   /*default_val=*/false, &enabled));
+    return enabled;
+  }();
+  return enabled;
+}
+
+// Number of threads to use for optimizing the functions in the graph library.
+// Functions are optimized sequentially unless the
+// TF_GRAPPLER_FUNCTION_OPTIMIZATION_THREADS environment variable requests
+// more threads.
+int64_t NumFunctionOptimizationThreads() {
+  static const int64_t num_threads = [] {
+    int64_t num_threads = 1;
+    TF_CHECK_OK(
+        ReadInt64FromEnvVar("TF_GRAPPLER_FUNCTION_OPTIMIZATION_THREADS",
+                            /*default_val=*/1, &num_threads));
+    return std::max<int64_t>(num_threads, 1);
+  }();
+  return num_threads;
+}
+
 // Check if optimizer is allowed to run only once.
 bool IsRunOnceOptimizer(const string& name) {
   return name == "layout" || name == "memory_optimizer" ||
@@ -813,6 +844,13 @@ Status MetaOptimizer::OptimizeGraph(
     CompressConstants(optimized_graph);
   }
 
+  // In incremental mode, fingerprint the graph between iterations so that the
+  // loop can stop as soon as an iteration makes no more changes.
+  uint64 graph_fingerprint = 0;
+  if (IncrementalOptimizationEnabled()) {
+    graph_fingerprint = DeterministicProtoHash64(*optimized_graph);
+  }
+
   for (int iteration = 0; iteration < NumIterations(cfg_); ++iteration) {
     // Don't bother optimizing further if the graph is already tiny.
     if (optimized_graph->node_size() < min_graph_nodes) {
@@ -871,6 +909,15 @@ Status MetaOptimizer::OptimizeGraph(
     for (const auto& verifier : post_optimization_verifiers) {
       TF_RETURN_IF_ERROR(verifier->Verify(*optimized_graph));
     }
+    if (IncrementalOptimizationEnabled()) {
+      const uint64 new_fingerprint = DeterministicProtoHash64(*optimized_graph);
+      if (new_fingerprint == graph_fingerprint) {
+        VLOG(3) << "Stopping after iteration " << iteration
+                << ", the graph did not change";
+        break;
+      }
+      graph_fingerprint = new_fingerprint;
+    }
   }
 #ifndef ENABLE_MKL
   // ScopedAllocatorOptimizer must run last.
@@ -888,7 +935,10 @@ Status MetaOptimizer::OptimizeGraph(
                                    }) != optimization_result.results.end();
 
   // Record graph optimization result.
-  optimization_results_.push_back(optimization_result);
+  {
+    mutex_lock lock(optimization_results_mu_);
+    optimization_results_.push_back(optimization_result);
+  }
 
   if (is_optimized) {
     TF_RETURN_IF_ERROR(TopologicalSort(optimized_graph));
@@ -947,6 +997,8 @@ Status MetaOptimizer::RunOptimizer(
   timings.ReportAndStop();
 
   string message;
+  int64_t node_delta = 0;
+  int64_t byte_delta = 0;
   if (!status.ok()) {
     *optimized_graph = std::move(optimized_item->graph);
     if (absl::IsAborted(status)) {
@@ -966,9 +1018,15 @@ Status MetaOptimizer::RunOptimizer(
       LOG_EVERY_N_SEC(ERROR, 60) << optimizer->name() << " failed: " << message;
     }
   } else {
+    node_delta = optimized_graph->node_size() -
+                 static_cast<int64_t>(optimized_item->graph.node_size());
+    byte_delta = static_cast<int64_t>(optimized_graph->ByteSizeLong()) -
+                 static_cast<int64_t>(optimized_item->graph.ByteSizeLong());
+    tensorflow::metrics::UpdateGraphOptimizationPassEffect(
+        optimizer->name(), node_delta, byte_delta);
     message = strings::StrCat(
         PrintSizesBeforeAfter(optimized_item->graph, *optimized_graph),
-        ", time = ", duration_ms, "ms.");
+        ", bytes delta = ", byte_delta, ", time = ", duration_ms, "ms.");
     VLOG(1) << optimizer->name() << ": " << message;
   }
 
@@ -978,7 +1036,12 @@ Status MetaOptimizer::RunOptimizer(
         optimized_graph_function_library.release());
   }
 
-  OptimizerResult optimizer_result{optimizer->name(), message, status};
+  OptimizerResult optimizer_result{optimizer->name(),
+                                   message,
+                                   status,
+                                   duration_ms,
+                                   node_delta,
+                                   byte_delta};
   optimization_result->results.push_back(optimizer_result);
 
   if (!status.ok()) {
@@ -1055,7 +1118,10 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
       {kGrapplerCategory, "*"});
 
   VLOG(1) << "Starting optimization for grappler item: " << item.id;
-  optimization_results_.clear();
+  {
+    mutex_lock lock(optimization_results_mu_);
+    optimization_results_.clear();
+  }
 
   // Constructs a FunctionLibraryDefinition with functions that are reachable
   // from the nodes of the graph.
@@ -1166,13 +1232,19 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
 
   // Optimize each function only once.
   absl::flat_hash_set<string> optimized_funcs;
+  const int64_t num_function_threads = NumFunctionOptimizationThreads();
   while (optimize_function_library) {
     optimize_function_library = false;
+    GRAPPLER_RETURN_IF_DEADLINE_EXCEEDED();
 
-    int function_idx = 0;
+    // Collect the functions to optimize in this pass. Each pass optimizes
+    // against a frozen snapshot of 'flib': function bodies are independent of
+    // each other (replacing a function preserves its signature, which is all
+    // other functions can observe), so the functions of a pass can be
+    // optimized in any order, or concurrently. Specialized functions created
+    // by this pass are picked up by the next one.
+    std::vector<const FunctionDef*> funcs_to_optimize;
     for (const FunctionDef& func : optimized_graph->library().function()) {
-      GRAPPLER_RETURN_IF_DEADLINE_EXCEEDED();
-
       const string& func_name = func.signature().name();
 
       // Skip functions that are not reachable from the optimized graph.
@@ -1192,14 +1264,31 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
       // and in function instantiation.
       if (data::IsTFDataFunction(func)) continue;
 
-      VLOG(3) << "Optimize function: function=" << func_name << " ["
-              << function_idx++ << " of "
-              << optimized_graph->library().function_size() << "]";
-
       // Function optimization might specialize nested function calls, so we
       // have to reset the flag and do at least one more pass over the library.
       optimize_function_library = true;
       optimized_funcs.insert(func_name);
+      funcs_to_optimize.push_back(&func);
+    }
+
+    struct FunctionOptimizationResult {
+      Status status;
+      FunctionDef optimized_func;
+      // Specialized functions created while optimizing the function body that
+      // are not yet part of 'flib'.
+      std::vector<FunctionDef> new_funcs;
+    };
+    std::vector<FunctionOptimizationResult> func_results(
+        funcs_to_optimize.size());
+
+    // Optimizes the body of 'func' and fills in 'result'. Must not mutate any
+    // state shared with other invocations; in particular 'flib' stays frozen
+    // until the results are merged below.
+    const auto optimize_function =
+        [&](const FunctionDef& func,
+            FunctionOptimizationResult* result) -> Status {
+      const string& func_name = func.signature().name();
+      VLOG(3) << "Optimize function: function=" << func_name;
 
       // Make a GrapplerItem from a FunctionDef.
       GrapplerFunctionItem func_item;
@@ -1258,21 +1347,68 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
       }
 
       // Function body optimization might have created new specialized
-      // functions for each instantiation context. Add them to the library.
+      // functions for each instantiation context. Collect them so they can be
+      // added to the library when the results are merged.
       for (const FunctionDef& func_def :
            optimized_func_graph.library().function()) {
         if (flib.Find(func_def.signature().name()) == nullptr) {
-          TF_RETURN_IF_ERROR(flib.AddFunctionDef(func_def));
+          result->new_funcs.push_back(func_def);
         }
       }
 
       // Convert optimized graph back to FunctionDef.
-      FunctionDef optimized_func;
       func_item.SwapFunctionBody(std::move(optimized_func_graph));
-      TF_RETURN_IF_ERROR(MakeFunctionDef(func_item, flib, &optimized_func));
+      if (result->new_funcs.empty()) {
+        TF_RETURN_IF_ERROR(
+            MakeFunctionDef(func_item, flib, &result->optimized_func));
+      } else {
+        // MakeFunctionDef may need to resolve the newly created functions,
+        // which are not part of the frozen library yet.
+        FunctionLibraryDefinition extended_flib = flib;
+        for (const FunctionDef& func_def : result->new_funcs) {
+          TF_RETURN_IF_ERROR(extended_flib.AddFunctionDef(func_def));
+        }
+        TF_RETURN_IF_ERROR(MakeFunctionDef(func_item, extended_flib,
+                                           &result->optimized_func));
+      }
+
+      return absl::OkStatus();
+    };
+
+    if (num_function_threads > 1 && funcs_to_optimize.size() > 1) {
+      thread::ThreadPool pool(
+          Env::Default(), "grappler_function_optimization",
+          std::min<int64_t>(num_function_threads, funcs_to_optimize.size()));
+      for (int i = 0; i < funcs_to_optimize.size(); ++i) {
+        pool.Schedule([&, i]() {
+          func_results[i].status =
+              optimize_function(*funcs_to_optimize[i], &func_results[i]);
+        });
+      }
+      // The thread pool destructor joins all scheduled work.
+    } else {
+      for (int i = 0; i < funcs_to_optimize.size(); ++i) {
+        GRAPPLER_RETURN_IF_DEADLINE_EXCEEDED();
+        func_results[i].status =
+            optimize_function(*funcs_to_optimize[i], &func_results[i]);
+      }
+    }
+
+    // Merge the per-function results into the library, in the deterministic
+    // order in which the functions were collected.
+    for (FunctionOptimizationResult& result : func_results) {
+      TF_RETURN_IF_ERROR(result.status);
+
+      // Add the specialized functions created for each instantiation context.
+      for (const FunctionDef& func_def : result.new_funcs) {
+        if (flib.Find(func_def.signature().name()) == nullptr) {
+          TF_RETURN_IF_ERROR(flib.AddFunctionDef(func_def));
+        }
+      }
 
       // Replace optimized function with a new FunctionDef.
-      TF_RETURN_IF_ERROR(flib.ReplaceFunction(func_name, optimized_func));
+      TF_RETURN_IF_ERROR(flib.ReplaceFunction(
+          result.optimized_func.signature().name(), result.optimized_func));
     }
 
     // If optimized at least one function, update the graph library.
@@ -1321,6 +1457,7 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
 
 string MetaOptimizer::GetResultString() const {
   std::string result_string;
+  mutex_lock lock(optimization_results_mu_);
   for (const GraphOptimizationResult& graph_result : optimization_results_) {
     absl::StrAppend(&result_string,
                     "Optimization results for grappler item: ", graph_result.id,
@@ -346,7 +346,9 @@ bool IsCpuCompatibleDataType(const NodeDef* contraction,
             IsDataTypeSupportedByOneDNNOnThisCPU(dtype));
   }
   if (IsConv2D(*contraction)) {
-    return dtype == DT_FLOAT || dtype == DT_DOUBLE;
+    // bfloat16 is handled by the Eigen based fused kernel with float
+    // accumulation (see LaunchFusedConv2DOp<CPUDevice, Eigen::bfloat16>).
+    return dtype == DT_FLOAT || dtype == DT_DOUBLE || dtype == DT_BFLOAT16;
   } else if (IsMatMul(*contraction)) {
     return dtype == DT_FLOAT;
   } else {
@@ -1185,6 +1187,25 @@ bool FindContractionWithBiasAddAndAdd(const RemapperContext& ctx,
   return FindContractionWithBiasAddAndAdd(ctx, *node_view, matched);
 }
 
+// Matches the MatMul + BiasAdd + Add (residual) pattern for the default
+// (Eigen) CPU _FusedMatMul kernel, which supports it via a `kBiasAddWithAdd`
+// output kernel. Unlike the oneDNN pattern above, only MatMul contractions
+// and float data type are accepted.
+bool FindMatMulWithBiasAddAndAdd(const RemapperContext& ctx, int node_index,
+                                 ContractionWithBiasAddAndAdd* matched) {
+  if (ctx.xla_cpu_jit_disable_fusion) return false;
+
+  const auto* node_view = ctx.graph_view.GetNode(node_index);
+  if (!FindContractionWithBiasAddAndAdd(ctx, *node_view, matched))
+    return false;
+
+  const auto* contraction_def =
+      ctx.graph_view.GetNode(matched->contraction)->node();
+  if (!IsMatMul(*contraction_def)) return false;
+
+  return IsCpuCompatibleMatMul(ctx, contraction_def);
+}
+
 bool FindContractionWithBiasAndAddActivation(
     const RemapperContext& ctx, int node_index,
     ContractionWithBiasAndAddActivation* matched) {
@@ -1589,9 +1610,11 @@ bool FindMatMulBiasAddAndGelu(RemapperContext* ctx, int node_index,
                               std::map<string, int>* matched_nodes_map,
                               std::set<int>* remove_node_indices,
                               bool* is_gelu_approximate) {
-  // Gelu fusion is enabled with oneDNN or cublasLt or cuDNN library.
+  // Gelu fusion is enabled with oneDNN or cublasLt or cuDNN library, and for
+  // the approximate variant on the default (Eigen) CPU path.
+  const NodeDef* root_def = ctx->graph_view.GetNode(node_index)->node();
   if (!IsMKLEnabled() && !BlasLtMatmulEnabled() &&
-      !RuntimeFusionEnabled(cluster))
+      !RuntimeFusionEnabled(cluster) && !NodeIsOnCpu(root_def))
     return false;
 
   using utils::MatchingDirection;
@@ -1755,8 +1778,13 @@ bool FindMatMulBiasAddAndGelu(RemapperContext* ctx, int node_index,
     }
 
     // matmul_node is already the _FusedMatMul and we don't need to check its
-    // data type again.
-    if (!IsMKLEnabled() && !NodeIsOnGpu(matmul_node)) return false;
+    // data type again, except on the default (Eigen) CPU path which only
+    // registers the approximate Gelu epilogue for float and half.
+    if (!IsMKLEnabled() && !NodeIsOnGpu(matmul_node)) {
+      if (!NodeIsOnCpu(matmul_node)) return false;
+      DataType dtype = GetDataTypeFromAttr(*matmul_node, "T");
+      if (dtype != DT_FLOAT && dtype != DT_HALF) return false;
+    }
 
     // Currently, the fusion is not supported on CPU for transpose_a in the
     // MatMul op.
@@ -2956,6 +2984,164 @@ bool FindFusedBatchMatMul(RemapperContext* ctx, int node_index,
   return found_op_type_match;
 }
 
+// Finds the scaled dot-product attention core
+//
+//   BatchMatMulV2(Softmax(BatchMatMulV2(q, k) * scale [+ mask]), v)
+//
+// so that it can be rewritten into _FusedScaledDotProductAttention, which
+// computes the attention probabilities one block of query rows at a time and
+// never materializes the full attention score matrix.
+bool FindScaledDotProductAttention(RemapperContext* ctx, int node_index,
+                                   std::map<string, int>* matched_nodes_map,
+                                   std::set<int>* remove_node_indices,
+                                   std::vector<string>* input_node_names,
+                                   float* scale_value, bool* has_mask) {
+  using utils::MatchingDirection;
+  using utils::NodeStatus;
+  // clang-format off
+  utils::OpTypePattern masked_pattern =
+    {"BatchMatMulV2", "output", NodeStatus::kReplace,
+      {
+        {"Softmax", "softmax", NodeStatus::kRemove,
+          {
+            {"Add|AddV2", "mask_add", NodeStatus::kRemove,
+              {
+                {"Mul", "scale", NodeStatus::kRemove,
+                  {
+                    {"BatchMatMulV2", "qk_matmul", NodeStatus::kRemove},
+                    {"Const", "scale_value", NodeStatus::kRemain}
+                  }
+                },
+                {"*", "mask", NodeStatus::kRemain}
+              }
+            }
+          }
+        },
+        {"*", "value", NodeStatus::kRemain}
+      }
+    };
+
+  utils::OpTypePattern unmasked_pattern =
+    {"BatchMatMulV2", "output", NodeStatus::kReplace,
+      {
+        {"Softmax", "softmax", NodeStatus::kRemove,
+          {
+            {"Mul", "scale", NodeStatus::kRemove,
+              {
+                {"BatchMatMulV2", "qk_matmul", NodeStatus::kRemove},
+                {"Const", "scale_value", NodeStatus::kRemain}
+              }
+            }
+          }
+        },
+        {"*", "value", NodeStatus::kRemain}
+      }
+    };
+  // clang-format on
+
+  utils::SubGraphMatcher<MatchingDirection::kFollowInputs> graph_matcher(
+      &(ctx->graph_view));
+  matched_nodes_map->clear();
+  remove_node_indices->clear();
+  *has_mask = true;
+  bool found_op_type_match = graph_matcher.GetMatchedNodes(
+      masked_pattern, ctx->nodes_to_preserve,
+      ctx->graph_view.GetNode(node_index), matched_nodes_map,
+      remove_node_indices);
+  if (!found_op_type_match) {
+    matched_nodes_map->clear();
+    remove_node_indices->clear();
+    *has_mask = false;
+    found_op_type_match = graph_matcher.GetMatchedNodes(
+        unmasked_pattern, ctx->nodes_to_preserve,
+        ctx->graph_view.GetNode(node_index), matched_nodes_map,
+        remove_node_indices);
+  }
+  if (!found_op_type_match) return false;
+
+  // The fused kernel is implemented for float on CPU only.
+  NodeDef* output_node_def =
+      ctx->graph_view.GetNode(matched_nodes_map->at("output"))->node();
+  if (!NodeIsOnCpu(output_node_def)) return false;
+  if (GetDataTypeFromAttr(*output_node_def, "T") != DT_FLOAT) return false;
+
+  // The fused kernel computes query * key^T * scale; only the canonical
+  // adjoint settings of the two matmuls are supported.
+  const auto get_bool_attr = [](const NodeDef& node, const string& attr_name) {
+    auto attr_it = node.attr().find(attr_name);
+    return attr_it != node.attr().end() && attr_it->second.b();
+  };
+  NodeDef* qk_matmul_node_def =
+      ctx->graph_view.GetNode(matched_nodes_map->at("qk_matmul"))->node();
+  if (get_bool_attr(*qk_matmul_node_def, "adj_x") ||
+      !get_bool_attr(*qk_matmul_node_def, "adj_y")) {
+    return false;
+  }
+  if (get_bool_attr(*output_node_def, "adj_x") ||
+      get_bool_attr(*output_node_def, "adj_y")) {
+    return false;
+  }
+
+  // The scale must be a scalar constant so it can be baked into the fused
+  // node as an attribute.
+  NodeDef* scale_node_def =
+      ctx->graph_view.GetNode(matched_nodes_map->at("scale_value"))->node();
+  auto value_attr_it = scale_node_def->attr().find("value");
+  if (value_attr_it == scale_node_def->attr().end()) return false;
+  Tensor scale_tensor;
+  if (!scale_tensor.FromProto(value_attr_it->second.tensor()) ||
+      scale_tensor.NumElements() != 1 || scale_tensor.dtype() != DT_FLOAT) {
+    return false;
+  }
+  *scale_value = scale_tensor.flat<float>()(0);
+
+  if (!ctx->inferred_graph_properties) {
+    Status s = ctx->graph_properties.InferStatically(
+        /*assume_valid_feeds=*/true,
+        /*aggressive_shape_inference=*/false,
+        /*include_input_tensor_values=*/false,
+        /*include_output_tensor_values=*/true);
+    if (!s.ok()) return false;
+    ctx->inferred_graph_properties = true;
+  }
+  auto qk_props =
+      ctx->graph_properties.GetOutputProperties(qk_matmul_node_def->name());
+  if (qk_props.empty() || Rank(qk_props[0].shape()) != 4) return false;
+
+  if (*has_mask) {
+    // Each mask dimension must be 1 or match the corresponding attention
+    // score dimension: masks that would broadcast the scores up are not
+    // supported by the fused kernel. Unknown dimensions cannot be validated
+    // here, so reject them.
+    NodeDef* mask_node_def =
+        ctx->graph_view.GetNode(matched_nodes_map->at("mask"))->node();
+    auto mask_props =
+        ctx->graph_properties.GetOutputProperties(mask_node_def->name());
+    if (mask_props.empty() || Rank(mask_props[0].shape()) != 4) return false;
+    const auto& score_shape = qk_props[0].shape();
+    const auto& mask_shape = mask_props[0].shape();
+    for (int i = 0; i < 4; ++i) {
+      const int64_t mask_dim = mask_shape.dim(i).size();
+      const int64_t score_dim = score_shape.dim(i).size();
+      if (mask_dim == 1) continue;
+      if (mask_dim < 0 || score_dim < 0 || mask_dim != score_dim) {
+        return false;
+      }
+    }
+  }
+
+  input_node_names->clear();
+  input_node_names->push_back(qk_matmul_node_def->input(0));
+  input_node_names->push_back(qk_matmul_node_def->input(1));
+  input_node_names->push_back(output_node_def->input(1));
+  if (*has_mask) {
+    NodeDef* mask_add_node_def =
+        ctx->graph_view.GetNode(matched_nodes_map->at("mask_add"))->node();
+    input_node_names->push_back(mask_add_node_def->input(1));
+  }
+  return true;
+}
+
 // Helper function to check if the reduction axes for a given input
 // shape align with instance normalization's mean computation.
 // Mean reduction axes for instance norm are expected to be:
@@ -4369,6 +4555,39 @@ Status AddFusedBatchMatMul(RemapperContext* ctx,
   return absl::OkStatus();
 }
 
+Status AddFusedScaledDotProductAttention(
+    RemapperContext* ctx, const std::map<string, int>& matched_nodes_map,
+    const std::set<int>& remove_node_indices,
+    const std::vector<string>& input_node_names, float scale_value,
+    bool has_mask, std::vector<bool>* invalidated_nodes,
+    std::vector<bool>* nodes_to_delete) {
+  auto* output_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("output"))->node();
+
+  NodeDef fused_node;
+  fused_node.set_name(output_node->name());
+  fused_node.set_op("_FusedScaledDotProductAttention");
+  fused_node.set_device(output_node->device());
+  for (const auto& name : input_node_names) fused_node.add_input(name);
+
+  auto* attr = fused_node.mutable_attr();
+  SetAttrValue(DT_FLOAT, &(*attr)["T"]);
+  SetAttrValue(scale_value, &(*attr)["scale"]);
+  SetAttrValue(has_mask ? 1 : 0, &(*attr)["num_args"]);
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(fused_node), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+  (*invalidated_nodes)[matched_nodes_map.at("output")] = true;
+
+  for (const auto& node_idx : remove_node_indices) {
+    (*nodes_to_delete)[node_idx] = true;
+  }
+  return absl::OkStatus();
+}
+
 // Helper function to get data of type T from a given tensor and
 // return them in a vector and casted to type U.
 // Note - use this function only when type cast is safe from T to U.
@@ -4809,6 +5028,27 @@ bool RequiresInferredShapes(const RemapperContext& ctx, int node_index,
     return true;
   };
 
+  // Candidate for a FusedMatMul fusion (MatMul + BiasAdd + Add). The pattern
+  // matcher needs inferred shapes to rule out broadcasting adds.
+  const auto is_matmul_biasadd_add_candidate = [&]() -> bool {
+    if (!IsAdd(*node_def) && !IsAddN(*node_def)) return false;
+    if (!NodeIsOnCpu(node_def)) return false;
+    if (GetDataTypeFromAttr(*node_def, "T") != DT_FLOAT) return false;
+
+    if (node_view->NumRegularFanins() != 2) return false;
+    for (int port = 0; port < 2; ++port) {
+      const auto* fanin_node_view =
+          node_view->GetRegularFanin(port).node_view();
+      const auto* fanin_node_def = fanin_node_view->node();
+      if (!IsBiasAdd(*fanin_node_def)) continue;
+      if (fanin_node_view->NumRegularFanins() < 1) continue;
+      const auto* contraction_node_def =
+          fanin_node_view->GetRegularFanin(0).node_view()->node();
+      if (IsMatMul(*contraction_node_def)) return true;
+    }
+    return false;
+  };
+
   if (IsMKLEnabled())
     return is_batch_norm_candidate() || is_batch_norm_fusion_candidate() ||
            IsContractionWithAdd(ctx, node_index) ||
@@ -4819,7 +5059,8 @@ bool RequiresInferredShapes(const RemapperContext& ctx, int node_index,
          is_batch_norm_fusion_candidate() ||
          is_batch_norm_grad_fusion_candidate() ||
          is_matmul_gelu_exact_fusion_candidate() ||
-         is_act_biasadd_matmul_candidate();
+         is_act_biasadd_matmul_candidate() ||
+         is_matmul_biasadd_add_candidate();
 }
 
 inline bool IsXlaCpuGlobalJitOn() {
@@ -5091,6 +5332,37 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
       continue;
     }
 
+    // Remap the BatchMatMul-Mul-(Add-)Softmax-BatchMatMul attention core into
+    // _FusedScaledDotProductAttention.
+    matched_nodes_map.clear();
+    remove_node_indices.clear();
+    std::vector<string> sdpa_input_node_names;
+    float sdpa_scale = 1.0;
+    bool sdpa_has_mask = false;
+    if (allow_non_differentiable_rewrites &&
+        FindScaledDotProductAttention(&ctx, i, &matched_nodes_map,
+                                      &remove_node_indices,
+                                      &sdpa_input_node_names, &sdpa_scale,
+                                      &sdpa_has_mask)) {
+      TF_RETURN_IF_ERROR(AddFusedScaledDotProductAttention(
+          &ctx, matched_nodes_map, remove_node_indices, sdpa_input_node_names,
+          sdpa_scale, sdpa_has_mask, &invalidated_nodes, &nodes_to_delete));
+      continue;
+    }
+
+    // Remap MatMul+BiasAdd+Add into the _FusedMatMul with a residual addend.
+    // Checked before the plain MatMul+BiasAdd fusion below: nodes are visited
+    // in reverse topological order, so the Add root is seen first and wins
+    // over the smaller pattern.
+    ContractionWithBiasAddAndAdd matmul_with_bias_and_add;
+    if (!IsMKLEnabled() && allow_non_differentiable_rewrites &&
+        FindMatMulWithBiasAddAndAdd(ctx, i, &matmul_with_bias_and_add)) {
+      TF_RETURN_IF_ERROR(AddFusedContractionNode(
+          &ctx, matmul_with_bias_and_add, &invalidated_nodes,
+          &nodes_to_delete));
+      continue;
+    }
+
     // Fusions are disabled on XLA CPU in IsCpuCompatible(...) invoked by the
     // following fusions.
     //
@@ -1490,6 +1490,88 @@ TEST_F(RemapperTest, FuseMatmulWithAdd) {
   test::ExpectClose(tensors[0], tensors_expected[0], 1e-6);
 }
 
+class RemapperFuseScaledDotProductAttention : public RemapperTest {
+ public:
+  void RunTest(bool has_mask) {
+    using ::tensorflow::ops::Placeholder;
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+    auto query_shape = ops::Placeholder::Shape({2, 4, 8, 16});
+    auto key_shape = ops::Placeholder::Shape({2, 4, 8, 16});
+    auto value_shape = ops::Placeholder::Shape({2, 4, 8, 16});
+    auto mask_shape = ops::Placeholder::Shape({2, 1, 8, 8});
+
+    auto query = Placeholder(s.WithOpName("query"), DT_FLOAT, query_shape);
+    auto key = Placeholder(s.WithOpName("key"), DT_FLOAT, key_shape);
+    auto value = Placeholder(s.WithOpName("value"), DT_FLOAT, value_shape);
+    auto mask = Placeholder(s.WithOpName("mask"), DT_FLOAT, mask_shape);
+
+    auto qk = ops::BatchMatMulV2(s.WithOpName("qk"), query, key,
+                                 ops::BatchMatMulV2::AdjY(true));
+    auto scale = ops::Const(s.WithOpName("scale"), 0.25f, {});
+    auto scaled = ops::Mul(s.WithOpName("scaled"), qk, scale);
+    Output softmax_in = scaled;
+    if (has_mask) {
+      softmax_in = ops::AddV2(s.WithOpName("masked"), scaled, mask);
+    }
+    auto softmax = ops::Softmax(s.WithOpName("softmax"), softmax_in);
+    auto output = ops::BatchMatMulV2(s.WithOpName("output"), softmax, value);
+    auto fetch = ops::Identity(s.WithOpName("fetch"), output);
+
+    auto query_t = GenerateRandomTensor<DT_FLOAT>({2, 4, 8, 16});
+    auto key_t = GenerateRandomTensor<DT_FLOAT>({2, 4, 8, 16});
+    auto value_t = GenerateRandomTensor<DT_FLOAT>({2, 4, 8, 16});
+    auto mask_t = GenerateRandomTensor<DT_FLOAT>({2, 1, 8, 8});
+
+    GrapplerItem item;
+    item.fetch = {"fetch"};
+    item.feed = {{"query", query_t}, {"key", key_t}, {"value", value_t}};
+    if (has_mask) item.feed.emplace_back("mask", mask_t);
+    TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+    // Place all nodes on CPU.
+    for (int i = 0; i < item.graph.node_size(); ++i) {
+      item.graph.mutable_node(i)->set_device("/device:CPU:0");
+    }
+
+    Remapper optimizer(RewriterConfig::ON);
+    GraphDef output_graph;
+    TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output_graph));
+
+    int found = 0;
+    for (const NodeDef& node : output_graph.node()) {
+      if (node.name() == "output") {
+        EXPECT_EQ(node.op(), "_FusedScaledDotProductAttention");
+        ASSERT_GE(node.input_size(), 3);
+        EXPECT_EQ(node.input(0), "query");
+        EXPECT_EQ(node.input(1), "key");
+        EXPECT_EQ(node.input(2), "value");
+        EXPECT_EQ(node.attr().at("num_args").i(), has_mask ? 1 : 0);
+        if (has_mask) {
+          ASSERT_EQ(node.input_size(), 4);
+          EXPECT_EQ(node.input(3), "mask");
+        }
+        EXPECT_EQ(node.attr().at("scale").f(), 0.25f);
+        found++;
+      }
+    }
+    EXPECT_EQ(found, 1);
+
+    auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors_expected.size(), 1);
+    auto tensors = EvaluateNodes(output_graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors.size(), 1);
+    test::ExpectClose(tensors[0], tensors_expected[0], 1e-6);
+  }
+};
+
+TEST_F(RemapperFuseScaledDotProductAttention, WithoutMask) {
+  RunTest(/*has_mask=*/false);
+}
+TEST_F(RemapperFuseScaledDotProductAttention, WithMask) {
+  RunTest(/*has_mask=*/true);
+}
+
 class RemapperFuseSoftplusTanhMul : public RemapperTest {
  public:
   template <DataType DTYPE>
@@ -0,0 +1,163 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/stateless_random_fusion.h"
+
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/platform/errors.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kRandomUniform[] = "StatelessRandomUniform";
+constexpr char kFusedRandomUniform[] = "_FusedStatelessRandomUniform";
+
+bool NodeIsOnCpu(const NodeDef& node) {
+  const string& device = node.device();
+  return device.empty() || absl::StrContains(device, DEVICE_CPU);
+}
+
+bool IsConstNode(const NodeMap& node_map, const string& input) {
+  const NodeDef* producer = node_map.GetNode(NodeName(input));
+  return producer != nullptr && producer->op() == "Const";
+}
+
+// Key identifying a group of stateless random nodes that may be fused: same
+// device, the same constant shape tensor, and the same type attributes.
+string GroupingKey(const NodeDef& node) {
+  std::vector<string> parts = {node.device(), node.input(0)};
+  for (const char* attr : {"dtype", "T", "Tseed"}) {
+    parts.push_back(DataTypeString(node.attr().at(attr).type()));
+  }
+  return absl::StrJoin(parts, ":");
+}
+
+// Builds the fused node replacing `members` (all sharing the same grouping
+// key) and rewires the members' fanouts to its outputs.
+void FuseGroup(const std::vector<NodeDef*>& members, NodeMap* node_map,
+               GraphDef* graph, std::set<string>* nodes_to_delete) {
+  const NodeDef& first = *members[0];
+  const int n = members.size();
+
+  NodeDef* fused = graph->add_node();
+  fused->set_name(absl::StrCat(first.name(), "/_grouped_uniform"));
+  fused->set_op(kFusedRandomUniform);
+  fused->set_device(first.device());
+  fused->add_input(first.input(0));
+  for (const NodeDef* member : members) {
+    fused->add_input(member->input(1));
+  }
+  (*fused->mutable_attr())["N"].set_i(n);
+  for (const char* attr : {"dtype", "T", "Tseed"}) {
+    (*fused->mutable_attr())[attr] = first.attr().at(attr);
+  }
+  node_map->AddNode(fused->name(), fused);
+  for (const string& input : fused->input()) {
+    node_map->AddOutput(NodeName(input), fused->name());
+  }
+
+  // Rewire the fanouts of member i to output i of the fused node.
+  for (int i = 0; i < n; ++i) {
+    const NodeDef* member = members[i];
+    const string data_output =
+        i == 0 ? fused->name() : absl::StrCat(fused->name(), ":", i);
+    const string control_output = AsControlDependency(*fused);
+    const auto consumers = node_map->GetOutputs(member->name());
+    for (NodeDef* consumer : consumers) {
+      for (string& input : *consumer->mutable_input()) {
+        if (NodeName(input) != member->name()) continue;
+        input = IsControlInput(input) ? control_output : data_output;
+      }
+      // A consumer that depended on several members through control edges
+      // would now list the fused node more than once; keep a single edge.
+      bool seen_control = false;
+      auto* inputs = consumer->mutable_input();
+      for (auto it = inputs->begin(); it != inputs->end();) {
+        if (*it == control_output) {
+          if (seen_control) {
+            it = inputs->erase(it);
+            continue;
+          }
+          seen_control = true;
+        }
+        ++it;
+      }
+      node_map->AddOutput(fused->name(), consumer->name());
+    }
+    nodes_to_delete->insert(member->name());
+  }
+}
+
+}  // namespace
+
+Status StatelessRandomFusion::Optimize(Cluster* cluster,
+                                       const GrapplerItem& item,
+                                       GraphDef* optimized_graph) {
+  *optimized_graph = item.graph;
+  NodeMap node_map(optimized_graph);
+  const std::unordered_set<string> nodes_to_preserve = item.NodesToPreserve();
+
+  // Group candidates by their fusion key, in graph order for determinism.
+  // Restricting the shape and seed inputs to constants keeps the fused node
+  // free of any dependency on the members' fanouts, so no cycle can form.
+  absl::flat_hash_map<string, std::vector<NodeDef*>> groups;
+  std::vector<string> group_order;
+  for (NodeDef& node : *optimized_graph->mutable_node()) {
+    if (node.op() != kRandomUniform) continue;
+    if (!NodeIsOnCpu(node)) continue;
+    if (nodes_to_preserve.count(node.name()) > 0) continue;
+    if (node.input_size() != 2) continue;
+    if (!node.attr().contains("dtype") || !node.attr().contains("T") ||
+        !node.attr().contains("Tseed")) {
+      continue;
+    }
+    if (!IsConstNode(node_map, node.input(0)) ||
+        !IsConstNode(node_map, node.input(1))) {
+      continue;
+    }
+    auto emplaced = groups.emplace(GroupingKey(node), std::vector<NodeDef*>());
+    if (emplaced.second) group_order.push_back(emplaced.first->first);
+    emplaced.first->second.push_back(&node);
+  }
+
+  std::set<string> nodes_to_delete;
+  for (const string& key : group_order) {
+    const std::vector<NodeDef*>& members = groups[key];
+    if (members.size() < 2) continue;
+    FuseGroup(members, &node_map, optimized_graph, &nodes_to_delete);
+  }
+
+  EraseNodesFromGraph(nodes_to_delete, optimized_graph);
+  return absl::OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(StatelessRandomFusion, "stateless_random_fusion");
+
+}  // namespace grappler
+}  // namespace tensorflow
@@ -0,0 +1,59 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_STATELESS_RANDOM_FUSION_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_STATELESS_RANDOM_FUSION_H_
+
+#include <string>
+
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// Coalesces many small same-shape stateless random ops into one generation
+// pass, so that graphs issuing dozens of little random tensors per element
+// (typical for data augmentation pipelines) pay per-op dispatch overhead once
+// per group instead of once per tensor.
+//
+// StatelessRandomUniform nodes placed on CPU that share the same constant
+// shape tensor, data type, and seed/shape index types are replaced by a
+// single _FusedStatelessRandomUniform node. Every output keeps its own seed
+// and Philox stream, so the generated values are identical bit for bit to the
+// unfused ops. Only nodes whose shape and seed inputs are constants are
+// fused, which guarantees the rewrite cannot create a cycle.
+//
+// This is an opt-in pass: enable it by adding "stateless_random_fusion" to
+// `RewriterConfig.custom_optimizers`.
+class StatelessRandomFusion : public CustomGraphOptimizer {
+ public:
+  Status Init(
+      const RewriterConfig_CustomGraphOptimizer* config = nullptr) override {
+    return absl::OkStatus();
+  }
+
+  std::string name() const override { return "stateless_random_fusion"; }
+
+  bool UsesFunctionLibrary() const override { return false; }
+
+  Status Optimize(Cluster* cluster, const GrapplerItem& item,
+                  GraphDef* optimized_graph) override;
+};
+
+}  // namespace grappler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_STATELESS_RANDOM_FUSION_H_
@@ -0,0 +1,155 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/stateless_random_fusion.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/grappler/utils/grappler_test.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+using test::function::NDef;
+
+constexpr char kDevice[] = "/job:localhost/replica:0/task:0/device:CPU:0";
+
+class StatelessRandomFusionTest : public GrapplerTest {
+ protected:
+  NodeDef SeedConst(const string& name, int64_t seed0, int64_t seed1) {
+    return NDef(name, "Const", {},
+                {{"dtype", DT_INT64},
+                 {"value", test::AsTensor<int64_t>({seed0, seed1})}},
+                kDevice);
+  }
+
+  NodeDef Uniform(const string& name, const string& shape,
+                  const string& seed) {
+    return NDef(name, "StatelessRandomUniform", {shape, seed},
+                {{"dtype", DT_FLOAT}, {"T", DT_INT32}, {"Tseed", DT_INT64}},
+                kDevice);
+  }
+};
+
+TEST_F(StatelessRandomFusionTest, FusesSameShapeUniforms) {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("shape", "Const", {},
+            {{"dtype", DT_INT32}, {"value", test::AsTensor<int32>({2, 3})}},
+            kDevice),
+       SeedConst("seed_a", 1, 2), SeedConst("seed_b", 3, 4),
+       Uniform("rng_a", "shape", "seed_a"),
+       Uniform("rng_b", "shape", "seed_b"),
+       NDef("add", "Add", {"rng_a", "rng_b"}, {{"T", DT_FLOAT}}, kDevice)});
+  item.fetch = {"add"};
+
+  const std::vector<Tensor> tensors_expected =
+      EvaluateNodes(item.graph, item.fetch);
+
+  StatelessRandomFusion optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int num_fused = 0;
+  const NodeDef* fused = nullptr;
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "StatelessRandomUniform");
+    if (node.op() == "_FusedStatelessRandomUniform") {
+      ++num_fused;
+      fused = &node;
+    }
+  }
+  ASSERT_EQ(num_fused, 1);
+  EXPECT_EQ(fused->attr().at("N").i(), 2);
+  ASSERT_EQ(fused->input_size(), 3);
+  EXPECT_EQ(fused->input(0), "shape");
+  EXPECT_EQ(fused->input(1), "seed_a");
+  EXPECT_EQ(fused->input(2), "seed_b");
+
+  NodeMap node_map(&output);
+  const NodeDef* add = node_map.GetNode("add");
+  ASSERT_NE(add, nullptr);
+  EXPECT_EQ(add->input(0), fused->name());
+  EXPECT_EQ(add->input(1), absl::StrCat(fused->name(), ":1"));
+
+  // The fused op must generate exactly the values the unfused ops did.
+  const std::vector<Tensor> tensors = EvaluateNodes(output, item.fetch);
+  ASSERT_EQ(tensors.size(), tensors_expected.size());
+  test::ExpectTensorEqual<float>(tensors_expected[0], tensors[0]);
+}
+
+TEST_F(StatelessRandomFusionTest, NonConstSeedNotFused) {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("shape", "Const", {},
+            {{"dtype", DT_INT32}, {"value", test::AsTensor<int32>({2, 3})}},
+            kDevice),
+       SeedConst("seed_a", 1, 2),
+       NDef("seed_b", "Identity", {"seed_a"}, {{"T", DT_INT64}}, kDevice),
+       Uniform("rng_a", "shape", "seed_a"),
+       Uniform("rng_b", "shape", "seed_b"),
+       NDef("add", "Add", {"rng_a", "rng_b"}, {{"T", DT_FLOAT}}, kDevice)});
+  item.fetch = {"add"};
+
+  StatelessRandomFusion optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int num_uniform = 0;
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "_FusedStatelessRandomUniform");
+    if (node.op() == "StatelessRandomUniform") ++num_uniform;
+  }
+  EXPECT_EQ(num_uniform, 2);
+}
+
+TEST_F(StatelessRandomFusionTest, DifferentShapesNotFused) {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("shape_a", "Const", {},
+            {{"dtype", DT_INT32}, {"value", test::AsTensor<int32>({2, 3})}},
+            kDevice),
+       NDef("shape_b", "Const", {},
+            {{"dtype", DT_INT32}, {"value", test::AsTensor<int32>({4})}},
+            kDevice),
+       SeedConst("seed_a", 1, 2), SeedConst("seed_b", 3, 4),
+       Uniform("rng_a", "shape_a", "seed_a"),
+       Uniform("rng_b", "shape_b", "seed_b"),
+       NDef("out_a", "Identity", {"rng_a"}, {{"T", DT_FLOAT}}, kDevice),
+       NDef("out_b", "Identity", {"rng_b"}, {{"T", DT_FLOAT}}, kDevice)});
+  item.fetch = {"out_a", "out_b"};
+
+  StatelessRandomFusion optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "_FusedStatelessRandomUniform");
+  }
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
@@ -0,0 +1,200 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/weight_only_quantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/platform/errors.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kQuantizedMatMul[] = "_WeightOnlyQuantizedMatMul";
+
+bool NodeIsOnCpu(const NodeDef& node) {
+  const string& device = node.device();
+  return device.empty() || absl::StrContains(device, DEVICE_CPU);
+}
+
+bool GetBoolAttr(const NodeDef& node, const string& name) {
+  auto iter = node.attr().find(name);
+  return iter != node.attr().end() && iter->second.b();
+}
+
+// Symmetrically quantizes `weight` (as the logical [k, n] matrix, transposed
+// if `transpose_b`) into `quantized` and fills one scale per output column.
+// For 4-bit weights, rows are packed in pairs with the even row in the low
+// nibble, matching the _WeightOnlyQuantizedMatMul kernel.
+void QuantizeWeight(const Tensor& weight, bool transpose_b, int bits,
+                    int64_t k, int64_t n, Tensor* quantized, Tensor* scales) {
+  const auto w = weight.matrix<float>();
+  auto scale_vec = scales->vec<float>();
+  const float qmax = (bits == 8) ? 127.0f : 7.0f;
+
+  std::vector<int8> column(k);
+  auto q = quantized->matrix<int8>();
+  for (int64_t col = 0; col < n; ++col) {
+    float amax = 0.0f;
+    for (int64_t row = 0; row < k; ++row) {
+      const float v = transpose_b ? w(col, row) : w(row, col);
+      amax = std::max(amax, std::abs(v));
+    }
+    const float scale = amax > 0.0f ? amax / qmax : 1.0f;
+    scale_vec(col) = scale;
+    for (int64_t row = 0; row < k; ++row) {
+      const float v = transpose_b ? w(col, row) : w(row, col);
+      const float scaled = std::round(v / scale);
+      column[row] =
+          static_cast<int8>(std::max(-qmax, std::min(qmax, scaled)));
+    }
+    if (bits == 8) {
+      for (int64_t row = 0; row < k; ++row) {
+        q(row, col) = column[row];
+      }
+    } else {
+      for (int64_t row = 0; row < k; row += 2) {
+        q(row / 2, col) = static_cast<int8>((column[row] & 0x0F) |
+                                            (column[row + 1] << 4));
+      }
+    }
+  }
+}
+
+// Adds a Const node holding `value` to the graph.
+NodeDef* AddConstNode(const string& name, const string& device,
+                      const Tensor& value, NodeMap* node_map,
+                      GraphDef* graph) {
+  NodeDef* node = graph->add_node();
+  node->set_name(name);
+  node->set_op("Const");
+  node->set_device(device);
+  (*node->mutable_attr())["dtype"].set_type(value.dtype());
+  value.AsProtoTensorContent(
+      (*node->mutable_attr())["value"].mutable_tensor());
+  node_map->AddNode(name, node);
+  return node;
+}
+
+}  // namespace
+
+Status WeightOnlyQuantization::Init(
+    const RewriterConfig_CustomGraphOptimizer* config) {
+  if (config != nullptr) {
+    auto iter = config->parameter_map().find("weight_bits");
+    if (iter != config->parameter_map().end()) {
+      weight_bits_ = iter->second.i();
+      if (weight_bits_ != 4 && weight_bits_ != 8) {
+        return errors::InvalidArgument(
+            "weight_only_quantization: weight_bits must be 4 or 8, got ",
+            weight_bits_);
+      }
+    }
+  }
+  return absl::OkStatus();
+}
+
+Status WeightOnlyQuantization::Optimize(Cluster* cluster,
+                                        const GrapplerItem& item,
+                                        GraphDef* optimized_graph) {
+  *optimized_graph = item.graph;
+  NodeMap node_map(optimized_graph);
+
+  int num_rewritten = 0;
+  const int num_nodes = optimized_graph->node_size();
+  for (int i = 0; i < num_nodes; ++i) {
+    NodeDef* node = optimized_graph->mutable_node(i);
+    if (node->op() != "MatMul" || !NodeIsOnCpu(*node)) continue;
+    auto type_attr = node->attr().find("T");
+    if (type_attr == node->attr().end() ||
+        type_attr->second.type() != DT_FLOAT) {
+      continue;
+    }
+    if (GetBoolAttr(*node, "transpose_a")) continue;
+
+    const NodeDef* weight_node = node_map.GetNode(node->input(1));
+    if (weight_node == nullptr || weight_node->op() != "Const") continue;
+    auto value_attr = weight_node->attr().find("value");
+    if (value_attr == weight_node->attr().end()) continue;
+    Tensor weight;
+    if (!weight.FromProto(value_attr->second.tensor()) ||
+        weight.dtype() != DT_FLOAT || weight.dims() != 2) {
+      continue;
+    }
+    if (weight.NumElements() < kMinWeightElements) continue;
+
+    const bool transpose_b = GetBoolAttr(*node, "transpose_b");
+    const int64_t k = transpose_b ? weight.dim_size(1) : weight.dim_size(0);
+    const int64_t n = transpose_b ? weight.dim_size(0) : weight.dim_size(1);
+    // Packed int4 needs row pairs; odd inner dimensions keep int8 storage.
+    const int bits = (weight_bits_ == 4 && k % 2 == 0) ? 4 : 8;
+
+    Tensor quantized(DT_INT8, TensorShape({bits == 8 ? k : k / 2, n}));
+    Tensor scales(DT_FLOAT, TensorShape({n}));
+    QuantizeWeight(weight, transpose_b, bits, k, n, &quantized, &scales);
+
+    const string old_weight_input = node->input(1);
+    NodeDef* quantized_node =
+        AddConstNode(absl::StrCat(node->name(), "/weights_quantized"),
+                     node->device(), quantized, &node_map, optimized_graph);
+    NodeDef* scales_node =
+        AddConstNode(absl::StrCat(node->name(), "/weight_scales"),
+                     node->device(), scales, &node_map, optimized_graph);
+
+    // Rewrite the MatMul in place, keeping its name so fanouts are
+    // untouched. Control inputs (if any) follow the two data inputs.
+    const string activation_input = node->input(0);
+    std::vector<string> control_inputs(node->input().begin() + 2,
+                                       node->input().end());
+    node->set_op(kQuantizedMatMul);
+    node->clear_input();
+    node->add_input(activation_input);
+    node->add_input(quantized_node->name());
+    node->add_input(scales_node->name());
+    for (const string& control_input : control_inputs) {
+      node->add_input(control_input);
+    }
+    node->mutable_attr()->erase("transpose_a");
+    node->mutable_attr()->erase("transpose_b");
+    (*node->mutable_attr())["weight_bits"].set_i(bits);
+    node_map.RemoveOutput(NodeName(old_weight_input), node->name());
+    node_map.AddOutput(quantized_node->name(), node->name());
+    node_map.AddOutput(scales_node->name(), node->name());
+    ++num_rewritten;
+  }
+
+  VLOG(1) << "weight_only_quantization rewrote " << num_rewritten
+          << " MatMul node(s)";
+  return absl::OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(WeightOnlyQuantization,
+                            "weight_only_quantization");
+
+}  // namespace grappler
+}  // namespace tensorflow
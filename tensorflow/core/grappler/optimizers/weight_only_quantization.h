@@ -0,0 +1,64 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_WEIGHT_ONLY_QUANTIZATION_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_WEIGHT_ONLY_QUANTIZATION_H_
+
+#include <string>
+
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// Converts frozen fp32 Const + MatMul pairs on CPU into
+// _WeightOnlyQuantizedMatMul nodes whose weights are stored as int8 (or
+// packed int4) Consts with per-output-column scales. Activations stay fp32
+// and the weights are dequantized on the fly inside the kernel, so the
+// memory read per inference step shrinks 4-8x while the matmul numerics
+// change only by the weight quantization error.
+//
+// Only MatMul nodes with transpose_a == false and a float Const weight of at
+// least kMinWeightElements elements are rewritten; transpose_b is folded into
+// the quantized layout. The rewrite happens in place, keeping the MatMul's
+// node name, so fanouts are untouched.
+//
+// This is an opt-in pass: enable it by adding "weight_only_quantization" to
+// `RewriterConfig.custom_optimizers`. The optional parameter "weight_bits"
+// (4 or 8, default 8) selects the storage width; matmuls whose inner
+// dimension is odd fall back to int8 when 4 is requested.
+class WeightOnlyQuantization : public CustomGraphOptimizer {
+ public:
+  static constexpr int64_t kMinWeightElements = 256;
+
+  Status Init(
+      const RewriterConfig_CustomGraphOptimizer* config = nullptr) override;
+
+  std::string name() const override { return "weight_only_quantization"; }
+
+  bool UsesFunctionLibrary() const override { return false; }
+
+  Status Optimize(Cluster* cluster, const GrapplerItem& item,
+                  GraphDef* optimized_graph) override;
+
+ private:
+  int weight_bits_ = 8;
+};
+
+}  // namespace grappler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_WEIGHT_ONLY_QUANTIZATION_H_
@@ -0,0 +1,216 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/weight_only_quantization.h"
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/grappler/utils/grappler_test.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/protobuf/rewriter_config.pb.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+using test::function::NDef;
+
+constexpr char kDevice[] = "/job:localhost/replica:0/task:0/device:CPU:0";
+
+class WeightOnlyQuantizationTest : public GrapplerTest {
+ protected:
+  // Builds a [rows, cols] weight whose values quantize exactly: every row
+  // and every column contains +amax and all entries are multiples of
+  // amax / levels, so `levels`-level symmetric quantization is lossless
+  // whichever way the matrix is read.
+  Tensor WeightTensor(int64_t rows, int64_t cols, int levels) {
+    Tensor weight(DT_FLOAT, TensorShape({rows, cols}));
+    auto w = weight.matrix<float>();
+    const float step = 0.5f;
+    for (int64_t r = 0; r < rows; ++r) {
+      for (int64_t c = 0; c < cols; ++c) {
+        w(r, c) =
+            static_cast<float>((r + c) % (2 * levels + 1) - levels) * step;
+      }
+    }
+    const float amax = static_cast<float>(levels) * step;
+    for (int64_t c = 0; c < cols; ++c) w(0, c) = amax;
+    for (int64_t r = 0; r < rows; ++r) w(r, 0) = amax;
+    return weight;
+  }
+
+  Tensor ActivationTensor(int64_t rows, int64_t cols) {
+    Tensor activation(DT_FLOAT, TensorShape({rows, cols}));
+    auto a = activation.matrix<float>();
+    for (int64_t r = 0; r < rows; ++r) {
+      for (int64_t c = 0; c < cols; ++c) {
+        a(r, c) = static_cast<float>((r * cols + c) % 13) - 6.0f;
+      }
+    }
+    return activation;
+  }
+
+  NodeDef MatMulNode(const string& name, const string& a, const string& b,
+                     bool transpose_a, bool transpose_b) {
+    return NDef(name, "MatMul", {a, b},
+                {{"T", DT_FLOAT},
+                 {"transpose_a", transpose_a},
+                 {"transpose_b", transpose_b}},
+                kDevice);
+  }
+};
+
+TEST_F(WeightOnlyQuantizationTest, RewritesLargeConstMatMul) {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("a", "Const", {},
+            {{"dtype", DT_FLOAT}, {"value", ActivationTensor(4, 32)}},
+            kDevice),
+       NDef("w", "Const", {},
+            {{"dtype", DT_FLOAT}, {"value", WeightTensor(32, 16, 127)}},
+            kDevice),
+       MatMulNode("matmul", "a", "w", false, false)});
+  item.fetch = {"matmul"};
+
+  const std::vector<Tensor> tensors_expected =
+      EvaluateNodes(item.graph, item.fetch);
+
+  WeightOnlyQuantization optimizer;
+  TF_ASSERT_OK(optimizer.Init());
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  NodeMap node_map(&output);
+  const NodeDef* matmul = node_map.GetNode("matmul");
+  ASSERT_NE(matmul, nullptr);
+  EXPECT_EQ(matmul->op(), "_WeightOnlyQuantizedMatMul");
+  EXPECT_EQ(matmul->attr().at("weight_bits").i(), 8);
+  ASSERT_EQ(matmul->input_size(), 3);
+  EXPECT_EQ(matmul->input(0), "a");
+  EXPECT_EQ(matmul->input(1), "matmul/weights_quantized");
+  EXPECT_EQ(matmul->input(2), "matmul/weight_scales");
+
+  const NodeDef* quantized = node_map.GetNode("matmul/weights_quantized");
+  ASSERT_NE(quantized, nullptr);
+  EXPECT_EQ(quantized->op(), "Const");
+  EXPECT_EQ(quantized->attr().at("dtype").type(), DT_INT8);
+
+  // The weight values were chosen to quantize exactly, so the rewritten
+  // graph must reproduce the fp32 result up to summation order.
+  const std::vector<Tensor> tensors = EvaluateNodes(output, item.fetch);
+  ASSERT_EQ(tensors.size(), tensors_expected.size());
+  test::ExpectClose(tensors_expected[0], tensors[0]);
+}
+
+TEST_F(WeightOnlyQuantizationTest, Int4FoldsTransposeB) {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("a", "Const", {},
+            {{"dtype", DT_FLOAT}, {"value", ActivationTensor(4, 32)}},
+            kDevice),
+       NDef("w", "Const", {},
+            {{"dtype", DT_FLOAT}, {"value", WeightTensor(16, 32, 7)}},
+            kDevice),
+       MatMulNode("matmul", "a", "w", false, true)});
+  item.fetch = {"matmul"};
+
+  const std::vector<Tensor> tensors_expected =
+      EvaluateNodes(item.graph, item.fetch);
+
+  WeightOnlyQuantization optimizer;
+  RewriterConfig_CustomGraphOptimizer config;
+  (*config.mutable_parameter_map())["weight_bits"].set_i(4);
+  TF_ASSERT_OK(optimizer.Init(&config));
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  NodeMap node_map(&output);
+  const NodeDef* matmul = node_map.GetNode("matmul");
+  ASSERT_NE(matmul, nullptr);
+  EXPECT_EQ(matmul->op(), "_WeightOnlyQuantizedMatMul");
+  EXPECT_EQ(matmul->attr().at("weight_bits").i(), 4);
+  EXPECT_EQ(matmul->attr().count("transpose_b"), 0);
+
+  // transpose_b was folded into the layout: the packed weight holds two
+  // rows of the logical [32, 16] matrix per byte.
+  const NodeDef* quantized = node_map.GetNode("matmul/weights_quantized");
+  ASSERT_NE(quantized, nullptr);
+  Tensor packed;
+  ASSERT_TRUE(packed.FromProto(quantized->attr().at("value").tensor()));
+  EXPECT_EQ(packed.dim_size(0), 16);
+  EXPECT_EQ(packed.dim_size(1), 16);
+
+  const std::vector<Tensor> tensors = EvaluateNodes(output, item.fetch);
+  ASSERT_EQ(tensors.size(), tensors_expected.size());
+  test::ExpectClose(tensors_expected[0], tensors[0]);
+}
+
+TEST_F(WeightOnlyQuantizationTest, SmallOrNonConstWeightsNotRewritten) {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("a", "Const", {},
+            {{"dtype", DT_FLOAT}, {"value", ActivationTensor(4, 8)}},
+            kDevice),
+       NDef("w_small", "Const", {},
+            {{"dtype", DT_FLOAT}, {"value", WeightTensor(8, 4, 127)}},
+            kDevice),
+       NDef("w_dynamic", "Identity", {"a"}, {{"T", DT_FLOAT}}, kDevice),
+       MatMulNode("matmul_small", "a", "w_small", false, false),
+       MatMulNode("matmul_dynamic", "a", "w_dynamic", false, true)});
+  item.fetch = {"matmul_small", "matmul_dynamic"};
+
+  WeightOnlyQuantization optimizer;
+  TF_ASSERT_OK(optimizer.Init());
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "_WeightOnlyQuantizedMatMul");
+  }
+}
+
+TEST_F(WeightOnlyQuantizationTest, TransposedActivationsNotRewritten) {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("a", "Const", {},
+            {{"dtype", DT_FLOAT}, {"value", ActivationTensor(32, 4)}},
+            kDevice),
+       NDef("w", "Const", {},
+            {{"dtype", DT_FLOAT}, {"value", WeightTensor(32, 16, 127)}},
+            kDevice),
+       MatMulNode("matmul", "a", "w", true, false)});
+  item.fetch = {"matmul"};
+
+  WeightOnlyQuantization optimizer;
+  TF_ASSERT_OK(optimizer.Init());
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  NodeMap node_map(&output);
+  const NodeDef* matmul = node_map.GetNode("matmul");
+  ASSERT_NE(matmul, nullptr);
+  EXPECT_EQ(matmul->op(), "MatMul");
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
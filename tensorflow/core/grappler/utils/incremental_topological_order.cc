@@ -0,0 +1,158 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/utils/incremental_topological_order.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/grappler/utils/topological_sort.h"
+#include "tensorflow/core/platform/errors.h"
+
+namespace tensorflow {
+namespace grappler {
+
+Status IncrementalTopologicalOrder::Initialize() {
+  order_.clear();
+  next_order_index_ = 0;
+
+  std::vector<const NodeDef*> topo_order;
+  TF_RETURN_IF_ERROR(
+      ComputeTopologicalOrder(*graph_view_->graph(), &topo_order));
+  order_.reserve(topo_order.size());
+  for (const NodeDef* node : topo_order) {
+    order_[node->name()] = next_order_index_++;
+  }
+  return absl::OkStatus();
+}
+
+void IncrementalTopologicalOrder::OnNodeAdded(absl::string_view node_name) {
+  order_[std::string(node_name)] = next_order_index_++;
+}
+
+void IncrementalTopologicalOrder::OnNodeRemoved(absl::string_view node_name) {
+  order_.erase(node_name);
+}
+
+Status IncrementalTopologicalOrder::OnEdgeAdded(absl::string_view src_name,
+                                                absl::string_view dst_name) {
+  const auto src_it = order_.find(src_name);
+  const auto dst_it = order_.find(dst_name);
+  if (src_it == order_.end() || dst_it == order_.end()) {
+    return errors::InvalidArgument(
+        "Cannot register edge from '", src_name, "' to '", dst_name,
+        "': both nodes must be tracked (did you call OnNodeAdded?).");
+  }
+  const int lower_bound = dst_it->second;
+  const int upper_bound = src_it->second;
+  // The edge already agrees with the order.
+  if (upper_bound < lower_bound) return absl::OkStatus();
+
+  const NodeDef* src = graph_view_->GetNode(src_name);
+  const NodeDef* dst = graph_view_->GetNode(dst_name);
+  if (src == nullptr || dst == nullptr) {
+    return errors::InvalidArgument("Cannot register edge from '", src_name,
+                                   "' to '", dst_name,
+                                   "': node not found in the graph view.");
+  }
+
+  // Pearce-Kelly: only nodes whose position lies in the affected region
+  // [lower_bound, upper_bound] can need to move.
+
+  // Nodes reachable from dst within the affected region (dst included).
+  std::vector<const NodeDef*> forward;
+  {
+    absl::flat_hash_set<const NodeDef*> visited;
+    std::vector<const NodeDef*> stack = {dst};
+    while (!stack.empty()) {
+      const NodeDef* node = stack.back();
+      stack.pop_back();
+      if (!visited.insert(node).second) continue;
+      if (node == src) {
+        return errors::InvalidArgument("Edge from '", src_name, "' to '",
+                                       dst_name, "' creates a cycle.");
+      }
+      forward.push_back(node);
+      for (const auto& fanout :
+           graph_view_->GetFanouts(*node, /*include_controlled_nodes=*/true)) {
+        const auto it = order_.find(fanout.node->name());
+        if (it != order_.end() && it->second <= upper_bound) {
+          stack.push_back(fanout.node);
+        }
+      }
+    }
+  }
+
+  // Nodes that reach src within the affected region (src included).
+  std::vector<const NodeDef*> backward;
+  {
+    absl::flat_hash_set<const NodeDef*> visited;
+    std::vector<const NodeDef*> stack = {src};
+    while (!stack.empty()) {
+      const NodeDef* node = stack.back();
+      stack.pop_back();
+      if (!visited.insert(node).second) continue;
+      backward.push_back(node);
+      for (const auto& fanin :
+           graph_view_->GetFanins(*node, /*include_controlling_nodes=*/true)) {
+        const auto it = order_.find(fanin.node->name());
+        if (it != order_.end() && it->second >= lower_bound) {
+          stack.push_back(fanin.node);
+        }
+      }
+    }
+  }
+
+  // Reassign the union of the affected positions: nodes that reach src keep
+  // their relative order and come first, then the nodes reachable from dst.
+  const auto by_order = [this](const NodeDef* a, const NodeDef* b) {
+    return order_.at(a->name()) < order_.at(b->name());
+  };
+  std::sort(backward.begin(), backward.end(), by_order);
+  std::sort(forward.begin(), forward.end(), by_order);
+
+  std::vector<int> positions;
+  positions.reserve(backward.size() + forward.size());
+  for (const NodeDef* node : backward) {
+    positions.push_back(order_[node->name()]);
+  }
+  for (const NodeDef* node : forward) {
+    positions.push_back(order_[node->name()]);
+  }
+  std::sort(positions.begin(), positions.end());
+
+  int next = 0;
+  for (const NodeDef* node : backward) order_[node->name()] = positions[next++];
+  for (const NodeDef* node : forward) order_[node->name()] = positions[next++];
+  return absl::OkStatus();
+}
+
+int IncrementalTopologicalOrder::OrderIndex(
+    absl::string_view node_name) const {
+  const auto it = order_.find(node_name);
+  return it == order_.end() ? -1 : it->second;
+}
+
+bool IncrementalTopologicalOrder::OrderedBefore(
+    absl::string_view node_a, absl::string_view node_b) const {
+  return order_.at(node_a) < order_.at(node_b);
+}
+
+}  // namespace grappler
+}  // namespace tensorflow
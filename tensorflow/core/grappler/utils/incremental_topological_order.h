@@ -0,0 +1,100 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_UTILS_INCREMENTAL_TOPOLOGICAL_ORDER_H_
+#define TENSORFLOW_CORE_GRAPPLER_UTILS_INCREMENTAL_TOPOLOGICAL_ORDER_H_
+
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/grappler/mutable_graph_view.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// Maintains a topological order of a MutableGraphView across rewrites,
+// without re-deriving it from scratch after each mutation.
+//
+// Rewrite passes that repeatedly mutate a graph and need ordering
+// information (e.g. "is node A an ancestor of node B?") currently recompute
+// a full topological sort, making each rewrite step O(V+E). This class keeps
+// an order index per node and repairs it incrementally with the
+// Pearce-Kelly dynamic topological sort: a new edge that already agrees
+// with the order costs O(1), and one that does not only reorders the
+// affected region between the two endpoints, which is amortized
+// O(degree of the affected region) in practice.
+//
+// Usage: mutate the view first, then notify this class.
+//
+//   MutableGraphView view(&graph);
+//   IncrementalTopologicalOrder order(&view);
+//   TF_RETURN_IF_ERROR(order.Initialize());
+//   ...
+//   TF_RETURN_IF_ERROR(view.AddControllingFanin("b", {"a", -1}));
+//   TF_RETURN_IF_ERROR(order.OnEdgeAdded("a", "b"));
+//
+// Removing nodes or edges never invalidates a topological order, so only
+// OnNodeRemoved (which forgets the node) is needed for removals. This class
+// is not thread-safe.
+class IncrementalTopologicalOrder {
+ public:
+  // `graph_view` must outlive this object.
+  explicit IncrementalTopologicalOrder(const MutableGraphView* graph_view)
+      : graph_view_(graph_view) {}
+
+  // Computes the initial order from the view's graph. Returns an error if
+  // the graph is cyclic.
+  Status Initialize();
+
+  // Registers a node newly added to the view. New nodes have no fanins or
+  // fanouts inside the graph yet, so they are placed at the end of the
+  // order; edges reported afterwards move them where needed.
+  void OnNodeAdded(absl::string_view node_name);
+
+  // Forgets a node removed from the view.
+  void OnNodeRemoved(absl::string_view node_name);
+
+  // Registers a new edge (data or control) from `src_name` to `dst_name`,
+  // repairing the order if the edge contradicts it. Must be called after the
+  // edge exists in the view. Returns an error if the edge creates a cycle
+  // (the order is left unchanged) or if either node is not tracked.
+  Status OnEdgeAdded(absl::string_view src_name, absl::string_view dst_name);
+
+  // Returns the position of `node_name` in the maintained order, or -1 if
+  // the node is not tracked. Positions are comparable but not dense.
+  int OrderIndex(absl::string_view node_name) const;
+
+  // Returns true iff `node_a` comes strictly before `node_b` in the
+  // maintained order. Both nodes must be tracked.
+  bool OrderedBefore(absl::string_view node_a,
+                     absl::string_view node_b) const;
+
+ private:
+  const MutableGraphView* graph_view_;
+
+  // Node name to position in the topological order. Positions are unique
+  // but may have gaps (from removed nodes and order repairs).
+  absl::flat_hash_map<std::string, int> order_;
+
+  // Position to assign to the next node appended at the end of the order.
+  int next_order_index_ = 0;
+};
+
+}  // namespace grappler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_UTILS_INCREMENTAL_TOPOLOGICAL_ORDER_H_
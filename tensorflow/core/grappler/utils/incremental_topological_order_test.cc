@@ -0,0 +1,152 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/utils/incremental_topological_order.h"
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/grappler/mutable_graph_view.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+struct NodeConfig {
+  string name;
+  std::vector<string> inputs;
+};
+
+GraphDef CreateGraph(const std::vector<NodeConfig>& nodes) {
+  GraphDef graph;
+  for (const NodeConfig& node : nodes) {
+    NodeDef node_def;
+    node_def.set_name(node.name);
+    node_def.set_op("NotImportant");
+    for (const string& input : node.inputs) {
+      node_def.add_input(input);
+    }
+    *graph.add_node() = std::move(node_def);
+  }
+  return graph;
+}
+
+TEST(IncrementalTopologicalOrderTest, InitializeRespectsEdges) {
+  GraphDef graph = CreateGraph({
+      {"c", {"b"}},  //
+      {"a", {}},     //
+      {"b", {"a"}},  //
+  });
+  MutableGraphView view(&graph);
+  IncrementalTopologicalOrder order(&view);
+  TF_ASSERT_OK(order.Initialize());
+
+  EXPECT_TRUE(order.OrderedBefore("a", "b"));
+  EXPECT_TRUE(order.OrderedBefore("b", "c"));
+  EXPECT_TRUE(order.OrderedBefore("a", "c"));
+}
+
+TEST(IncrementalTopologicalOrderTest, ConsistentEdgeIsNoop) {
+  GraphDef graph = CreateGraph({
+      {"a", {}},     //
+      {"b", {"a"}},  //
+      {"c", {}},     //
+  });
+  MutableGraphView view(&graph);
+  IncrementalTopologicalOrder order(&view);
+  TF_ASSERT_OK(order.Initialize());
+
+  const int index_a = order.OrderIndex("a");
+  const int index_c = order.OrderIndex("c");
+
+  // "a" already precedes "c": registering the edge must not move anything.
+  TF_ASSERT_OK(view.AddControllingFanin("c", {"a", Graph::kControlSlot}));
+  TF_ASSERT_OK(order.OnEdgeAdded("a", "c"));
+  EXPECT_EQ(order.OrderIndex("a"), index_a);
+  EXPECT_EQ(order.OrderIndex("c"), index_c);
+}
+
+TEST(IncrementalTopologicalOrderTest, ContradictingEdgeRepairsOrder) {
+  GraphDef graph = CreateGraph({
+      {"a", {}},     //
+      {"b", {"a"}},  //
+      {"c", {"b"}},  //
+      {"d", {}},     //
+  });
+  MutableGraphView view(&graph);
+  IncrementalTopologicalOrder order(&view);
+  TF_ASSERT_OK(order.Initialize());
+  ASSERT_TRUE(order.OrderedBefore("a", "d"));
+
+  // Make "d" an ancestor of "b": "d" must move before "b" and "c", while
+  // "a" keeps preceding "b".
+  TF_ASSERT_OK(view.AddControllingFanin("b", {"d", Graph::kControlSlot}));
+  TF_ASSERT_OK(order.OnEdgeAdded("d", "b"));
+  EXPECT_TRUE(order.OrderedBefore("d", "b"));
+  EXPECT_TRUE(order.OrderedBefore("d", "c"));
+  EXPECT_TRUE(order.OrderedBefore("a", "b"));
+  EXPECT_TRUE(order.OrderedBefore("b", "c"));
+}
+
+TEST(IncrementalTopologicalOrderTest, AddedNodesJoinTheOrder) {
+  GraphDef graph = CreateGraph({
+      {"a", {}},     //
+      {"b", {"a"}},  //
+  });
+  MutableGraphView view(&graph);
+  IncrementalTopologicalOrder order(&view);
+  TF_ASSERT_OK(order.Initialize());
+
+  NodeDef new_node;
+  new_node.set_name("c");
+  new_node.set_op("NotImportant");
+  view.AddNode(std::move(new_node));
+  order.OnNodeAdded("c");
+  EXPECT_TRUE(order.OrderedBefore("b", "c"));
+
+  // The new node is moved where its edges require.
+  TF_ASSERT_OK(view.AddControllingFanin("a", {"c", Graph::kControlSlot}));
+  TF_ASSERT_OK(order.OnEdgeAdded("c", "a"));
+  EXPECT_TRUE(order.OrderedBefore("c", "a"));
+  EXPECT_TRUE(order.OrderedBefore("c", "b"));
+  EXPECT_TRUE(order.OrderedBefore("a", "b"));
+
+  order.OnNodeRemoved("c");
+  EXPECT_EQ(order.OrderIndex("c"), -1);
+}
+
+TEST(IncrementalTopologicalOrderTest, DetectsCycle) {
+  GraphDef graph = CreateGraph({
+      {"a", {}},     //
+      {"b", {"a"}},  //
+      {"c", {"b"}},  //
+  });
+  MutableGraphView view(&graph);
+  IncrementalTopologicalOrder order(&view);
+  TF_ASSERT_OK(order.Initialize());
+
+  TF_ASSERT_OK(view.AddControllingFanin("a", {"c", Graph::kControlSlot}));
+  EXPECT_FALSE(order.OnEdgeAdded("c", "a").ok());
+  // The order is left unchanged.
+  EXPECT_TRUE(order.OrderedBefore("a", "b"));
+  EXPECT_TRUE(order.OrderedBefore("b", "c"));
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
@@ -28,8 +28,26 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/stringpiece.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
+namespace {
+
+// Per-element cost estimate, in abstract Shard units, for the formatting
+// loops below; printf-style formatting dominates the per-element work.
+constexpr int64_t kFormatCostPerUnit = 100;
+
+// Runs `fn(start, end)` over [0, num_elements), sharded across the CPU
+// worker threads. Each element formats independently into its own output
+// string, so shards never contend.
+template <typename Fn>
+void ShardFormat(OpKernelContext* context, int64_t num_elements, Fn fn) {
+  auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+  Shard(worker_threads.num_threads, worker_threads.workers, num_elements,
+        kFormatCostPerUnit, std::move(fn));
+}
+
+}  // namespace
 
 class AsStringOp : public OpKernel {
  public:
@@ -169,12 +187,16 @@ class AsStringOp : public OpKernel {
                                             &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-#define ENCODE_TYPE(type, T, enc_str)                                     \
-  case (type): {                                                          \
-    const auto& input_flat = input_tensor->flat<T>();                     \
-    for (int i = 0; i < input_flat.size(); ++i) {                         \
-      output_flat(i) = strings::Printf((enc_str.c_str()), input_flat(i)); \
-    }                                                                     \
+#define ENCODE_TYPE(type, T, enc_str)                                      \
+  case (type): {                                                           \
+    const auto& input_flat = input_tensor->flat<T>();                      \
+    ShardFormat(context, input_flat.size(),                                \
+                [&](int64_t start, int64_t end) {                          \
+                  for (int64_t i = start; i < end; ++i) {                  \
+                    output_flat(i) =                                       \
+                        strings::Printf((enc_str.c_str()), input_flat(i)); \
+                  }                                                        \
+                });                                                        \
   } break
 
     switch (dtype) {
@@ -190,50 +212,78 @@ class AsStringOp : public OpKernel {
       ENCODE_TYPE(DT_DOUBLE, double, format_);
       case (DT_BOOL): {
         const auto& input_flat = input_tensor->flat<bool>();
-        for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = (input_flat(i)) ? "true" : "false";
-        }
+        ShardFormat(context, input_flat.size(),
+                    [&](int64_t start, int64_t end) {
+                      for (int64_t i = start; i < end; ++i) {
+                        output_flat(i) = (input_flat(i)) ? "true" : "false";
+                      }
+                    });
       } break;
       case (DT_STRING): {
         const auto& input_flat = input_tensor->flat<tstring>();
-        for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = strings::Printf(format_.c_str(),
-                                           StringPiece(input_flat(i)).data());
-        }
+        ShardFormat(context, input_flat.size(),
+                    [&](int64_t start, int64_t end) {
+                      for (int64_t i = start; i < end; ++i) {
+                        output_flat(i) =
+                            strings::Printf(format_.c_str(),
+                                            StringPiece(input_flat(i)).data());
+                      }
+                    });
       } break;
       case (DT_VARIANT): {
         const auto& input_flat = input_tensor->flat<Variant>();
-        for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = input_flat(i).DebugString();
-        }
+        ShardFormat(context, input_flat.size(),
+                    [&](int64_t start, int64_t end) {
+                      for (int64_t i = start; i < end; ++i) {
+                        output_flat(i) = input_flat(i).DebugString();
+                      }
+                    });
       } break;
       case (DT_HALF): {
         const auto& input_flat = input_tensor->flat<Eigen::half>();
-        for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = strings::Printf(format_.c_str(),
-                                           static_cast<float>(input_flat(i)));
-        }
+        ShardFormat(context, input_flat.size(),
+                    [&](int64_t start, int64_t end) {
+                      for (int64_t i = start; i < end; ++i) {
+                        output_flat(i) =
+                            strings::Printf(format_.c_str(),
+                                            static_cast<float>(input_flat(i)));
+                      }
+                    });
       } break;
       case (DT_BFLOAT16): {
         const auto& input_flat = input_tensor->flat<bfloat16>();
-        for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = strings::Printf(format_.c_str(),
-                                           static_cast<float>(input_flat(i)));
-        }
+        ShardFormat(context, input_flat.size(),
+                    [&](int64_t start, int64_t end) {
+                      for (int64_t i = start; i < end; ++i) {
+                        output_flat(i) =
+                            strings::Printf(format_.c_str(),
+                                            static_cast<float>(input_flat(i)));
+                      }
+                    });
       } break;
       case (DT_COMPLEX64): {
         const auto& input_flat = input_tensor->flat<complex64>();
-        for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = strings::Printf(
-              format_.c_str(), input_flat(i).real(), input_flat(i).imag());
-        }
+        ShardFormat(context, input_flat.size(),
+                    [&](int64_t start, int64_t end) {
+                      for (int64_t i = start; i < end; ++i) {
+                        output_flat(i) =
+                            strings::Printf(format_.c_str(),
+                                            input_flat(i).real(),
+                                            input_flat(i).imag());
+                      }
+                    });
       } break;
       case (DT_COMPLEX128): {
         const auto& input_flat = input_tensor->flat<complex128>();
-        for (int i = 0; i < input_flat.size(); ++i) {
-          output_flat(i) = strings::Printf(
-              format_.c_str(), input_flat(i).real(), input_flat(i).imag());
-        }
+        ShardFormat(context, input_flat.size(),
+                    [&](int64_t start, int64_t end) {
+                      for (int64_t i = start; i < end; ++i) {
+                        output_flat(i) =
+                            strings::Printf(format_.c_str(),
+                                            input_flat(i).real(),
+                                            input_flat(i).imag());
+                      }
+                    });
       } break;
       default:
         bool can_encode_type = false;
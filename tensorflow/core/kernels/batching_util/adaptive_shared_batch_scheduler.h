@@ -22,6 +22,7 @@ limitations under the License.
 #include <memory>
 #include <random>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -132,6 +133,24 @@ class AdaptiveSharedBatchScheduler
     // full_batch_scheduling_boost_micros==zero) for backward compatibility of
     // API.
     bool fifo_scheduling = false;
+
+    // If true, batch selection additionally enforces a weighted fair share of
+    // device time across queues. Each queue is entitled to a fraction of the
+    // device proportional to its weight (see QueueOptions.fair_share_weight);
+    // a queue whose in-flight batches are estimated to consume more than its
+    // share is passed over as long as some other queue with a schedulable
+    // batch remains within its share. If every queue with schedulable batches
+    // is above its share, the regular age-based selection applies, so the
+    // device never idles. Per-queue consumption is estimated from observed
+    // batch processing latencies, so queues whose batches run long are
+    // automatically throttled relative to their weight.
+    //
+    // Useful when several models are co-hosted on one device and a heavy
+    // model would otherwise starve a light one.
+    //
+    // Must be false if `fifo_scheduling` is true; otherwise an error is
+    // returned at scheduler creation time.
+    bool enable_weighted_fair_sharing = false;
   };
 
   // Ownership is shared between the caller of Create() and any queues created
@@ -171,6 +190,15 @@ class AdaptiveSharedBatchScheduler
 
     // If true, the padding will not be appended.
     bool disable_padding = false;
+
+    // The queue's relative weight when the scheduler is created with
+    // `enable_weighted_fair_sharing`; ignored otherwise. The queue is
+    // entitled to a fraction weight / (sum of the weights of all queues
+    // contending for the device) of the device time.
+    //
+    // Must be positive, or else an invalid argument error is returned at
+    // queue creation time.
+    double fair_share_weight = 1.0;
   };
 
   using BatchProcessor = std::function<void(std::unique_ptr<Batch<TaskType>>)>;
@@ -192,8 +220,11 @@ class AdaptiveSharedBatchScheduler
   explicit AdaptiveSharedBatchScheduler(const Options& options);
 
   // Tracks processing latency and adjusts in_flight_batches_limit to minimize.
+  // 'charged_cost' is the estimated device time charged against the batch's
+  // queue when the batch was dispatched; it is credited back on completion.
   void CallbackWrapper(const internal::ASBSBatch<TaskType>* batch,
-                       BatchProcessor callback, bool is_express);
+                       BatchProcessor callback, bool is_express,
+                       double charged_cost);
 
   // Schedules batch if in_flight_batches_limit_ is not met.
   void MaybeScheduleNextBatch() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
@@ -214,6 +245,29 @@ class AdaptiveSharedBatchScheduler
 
   void MaybeAdjustInflightLimit() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Returns true iff `queue` is estimated to be consuming more than its
+  // weighted share of device time. `total_weight` is the summed weight of the
+  // queues currently contending for the device, and `total_in_flight_cost` is
+  // the summed estimated device time of all in-flight batches.
+  bool QueueExceedsFairShare(const internal::ASBSQueue<TaskType>* queue,
+                             double total_weight,
+                             double total_in_flight_cost) const
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Charges `queue` for the estimated device time of a batch about to be
+  // dispatched, and returns the amount charged. Returns 0 if weighted fair
+  // sharing is disabled.
+  double ChargeQueueForBatch(const internal::ASBSQueue<TaskType>* queue)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Credits back an earlier charge of `charged_cost` against `queue`, and
+  // folds the batch's observed processing latency into the queue's moving
+  // average as feedback for future charges.
+  void SettleQueueCharge(const internal::ASBSQueue<TaskType>* queue,
+                         double charged_cost,
+                         double processing_latency_micros)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   // Notifies scheduler of non-empty batch which is eligible for processing.
   void AddBatch(const internal::ASBSBatch<TaskType>* batch);
 
@@ -237,6 +291,22 @@ class AdaptiveSharedBatchScheduler
   std::unordered_map<const internal::ASBSQueue<TaskType>*, BatchProcessor>
       queues_and_callbacks_ TF_GUARDED_BY(mu_);
 
+  // Per-queue state used for weighted fair sharing.
+  struct QueueShareStats {
+    // The queue's scheduling weight; see QueueOptions.fair_share_weight.
+    double weight = 1.0;
+    // Estimated device time consumed by the queue's in-flight batches.
+    double in_flight_cost_micros = 0;
+    // Exponential moving average of the queue's batch processing latency.
+    // Zero until the queue's first batch completes.
+    double avg_batch_latency_micros = 0;
+  };
+
+  // Fair-sharing state for the queues in `queues_and_callbacks_`.
+  // Used iff `options_.enable_weighted_fair_sharing` is true.
+  std::unordered_map<const internal::ASBSQueue<TaskType>*, QueueShareStats>
+      queue_share_stats_ TF_GUARDED_BY(mu_);
+
   mutex mu_;
 
   // Responsible for running the batch processing callbacks.
@@ -284,6 +354,10 @@ class AdaptiveSharedBatchScheduler
   // Current adjustment size (as a fraction of in_flight_batches_limit_).
   double step_size_multiplier_ TF_GUARDED_BY(mu_) = kMaxStepSizeMultiplier;
 
+  // Weight given to the most recent observation in the moving average of a
+  // queue's batch processing latency.
+  constexpr static double kLatencyEwmaWeight = 0.1;
+
   AdaptiveSharedBatchScheduler(const AdaptiveSharedBatchScheduler&) = delete;
   void operator=(const AdaptiveSharedBatchScheduler&) = delete;
 };
@@ -380,6 +454,9 @@ constexpr double AdaptiveSharedBatchScheduler<TaskType>::kMaxStepSizeMultiplier;
 template <typename TaskType>
 constexpr double AdaptiveSharedBatchScheduler<TaskType>::kMinStepSizeMultiplier;
 
+template <typename TaskType>
+constexpr double AdaptiveSharedBatchScheduler<TaskType>::kLatencyEwmaWeight;
+
 template <typename TaskType>
 Status AdaptiveSharedBatchScheduler<TaskType>::Create(
     const Options& options,
@@ -423,6 +500,11 @@ Status AdaptiveSharedBatchScheduler<TaskType>::Create(
         "greater than or equal to 1; was ",
         options.batches_to_average_over);
   }
+  if (options.enable_weighted_fair_sharing && options.fifo_scheduling) {
+    return errors::InvalidArgument(
+        "enable_weighted_fair_sharing is not supported when fifo_scheduling "
+        "is enabled.");
+  }
   scheduler->reset(new AdaptiveSharedBatchScheduler<TaskType>(options));
   return absl::OkStatus();
 }
@@ -467,11 +549,16 @@ Status AdaptiveSharedBatchScheduler<TaskType>::AddQueue(
           options.max_batch_size);
     }
   }
+  if (options.fair_share_weight <= 0) {
+    return errors::InvalidArgument("fair_share_weight must be positive; was ",
+                                   options.fair_share_weight);
+  }
   internal::ASBSQueue<TaskType>* asbs_queue_raw;
   queue->reset(asbs_queue_raw = new internal::ASBSQueue<TaskType>(
                    this->shared_from_this(), options));
   mutex_lock l(mu_);
   queues_and_callbacks_[asbs_queue_raw] = process_batch_callback;
+  queue_share_stats_[asbs_queue_raw].weight = options.fair_share_weight;
   return absl::OkStatus();
 }
 
@@ -507,6 +594,7 @@ void AdaptiveSharedBatchScheduler<TaskType>::RemoveQueue(
     const internal::ASBSQueue<TaskType>* queue) {
   mutex_lock l(mu_);
   queues_and_callbacks_.erase(queue);
+  queue_share_stats_.erase(queue);
 }
 
 template <typename TaskType>
@@ -516,11 +604,13 @@ void AdaptiveSharedBatchScheduler<TaskType>::MaybeScheduleNextBatchFIFO() {
     return;
   }
   fifo_batches_.pop_front();
+  const double charged_cost = ChargeQueueForBatch(batch->queue());
   // Queue may destroy itself after ReleaseBatch is called.
   batch->queue()->ReleaseBatch(batch);
-  batch_thread_pool_->Schedule(std::bind(
-      &AdaptiveSharedBatchScheduler<TaskType>::CallbackWrapper, this, batch,
-      queues_and_callbacks_[batch->queue()], false /* is express */));
+  batch_thread_pool_->Schedule(
+      std::bind(&AdaptiveSharedBatchScheduler<TaskType>::CallbackWrapper, this,
+                batch, queues_and_callbacks_[batch->queue()],
+                false /* is express */, charged_cost));
   in_flight_batches_++;
 }
 
@@ -537,10 +627,12 @@ void AdaptiveSharedBatchScheduler<
     if ((*it)->IsClosed()) {
       const internal::ASBSBatch<TaskType>* batch = *it;
       fifo_batches_.pop_front();
+      const double charged_cost = ChargeQueueForBatch(batch->queue());
       batch->queue()->ReleaseBatch(batch);
       batch_thread_pool_->Schedule(
           std::bind(&AdaptiveSharedBatchScheduler<TaskType>::CallbackWrapper,
-                    this, batch, queues_and_callbacks_[batch->queue()], true));
+                    this, batch, queues_and_callbacks_[batch->queue()], true,
+                    charged_cost));
       in_flight_express_batches_++;
       available_threads--;
     } else {
@@ -568,8 +660,30 @@ void AdaptiveSharedBatchScheduler<TaskType>::MaybeScheduleNextBatch() {
     return;
   }
 
+  // Aggregates for weighted fair sharing. A queue contends for the device if
+  // it has a batch awaiting scheduling or a batch in flight.
+  double total_weight = 0;
+  double total_in_flight_cost = 0;
+  if (options_.enable_weighted_fair_sharing) {
+    std::unordered_set<const internal::ASBSQueue<TaskType>*> contending_queues;
+    for (const internal::ASBSBatch<TaskType>* batch : batches_) {
+      contending_queues.insert(batch->queue());
+    }
+    for (const auto& entry : queue_share_stats_) {
+      total_in_flight_cost += entry.second.in_flight_cost_micros;
+      if (entry.second.in_flight_cost_micros > 0 ||
+          contending_queues.count(entry.first) > 0) {
+        total_weight += entry.second.weight;
+      }
+    }
+  }
+
   auto best_it = batches_.end();
   double best_score = (std::numeric_limits<double>::max)();
+  // The best batch among queues within their fair share; preferred over
+  // 'best_it' when weighted fair sharing is enabled.
+  auto best_within_share_it = batches_.end();
+  double best_within_share_score = (std::numeric_limits<double>::max)();
   int64_t now_micros = GetEnv()->NowMicros();
   for (auto it = batches_.begin(); it != batches_.end(); it++) {
     if ((*it)->schedulable_time_micros() > now_micros) continue;
@@ -581,19 +695,88 @@ void AdaptiveSharedBatchScheduler<TaskType>::MaybeScheduleNextBatch() {
       best_score = score;
       best_it = it;
     }
+    if (options_.enable_weighted_fair_sharing &&
+        !QueueExceedsFairShare((*it)->queue(), total_weight,
+                               total_in_flight_cost) &&
+        (best_within_share_it == batches_.end() ||
+         score < best_within_share_score)) {
+      best_within_share_score = score;
+      best_within_share_it = it;
+    }
+  }
+  // Prefer queues within their fair share; if every queue with a schedulable
+  // batch is above its share, fall back to the regular selection so the
+  // device never idles.
+  if (best_within_share_it != batches_.end()) {
+    best_it = best_within_share_it;
   }
   // No schedulable batches.
   if (best_it == batches_.end()) return;
   const internal::ASBSBatch<TaskType>* batch = *best_it;
   batches_.erase(best_it);
+  const double charged_cost = ChargeQueueForBatch(batch->queue());
   // Queue may destroy itself after ReleaseBatch is called.
   batch->queue()->ReleaseBatch(batch);
   batch_thread_pool_->Schedule(
       std::bind(&AdaptiveSharedBatchScheduler<TaskType>::CallbackWrapper, this,
-                batch, queues_and_callbacks_[batch->queue()], false));
+                batch, queues_and_callbacks_[batch->queue()], false,
+                charged_cost));
   in_flight_batches_++;
 }
 
+template <typename TaskType>
+bool AdaptiveSharedBatchScheduler<TaskType>::QueueExceedsFairShare(
+    const internal::ASBSQueue<TaskType>* queue, double total_weight,
+    double total_in_flight_cost) const {
+  if (total_weight <= 0 || total_in_flight_cost <= 0) {
+    return false;
+  }
+  auto it = queue_share_stats_.find(queue);
+  if (it == queue_share_stats_.end()) {
+    return false;
+  }
+  const double fair_share =
+      it->second.weight / total_weight * total_in_flight_cost;
+  return it->second.in_flight_cost_micros > fair_share;
+}
+
+template <typename TaskType>
+double AdaptiveSharedBatchScheduler<TaskType>::ChargeQueueForBatch(
+    const internal::ASBSQueue<TaskType>* queue) {
+  if (!options_.enable_weighted_fair_sharing) {
+    return 0;
+  }
+  auto it = queue_share_stats_.find(queue);
+  if (it == queue_share_stats_.end()) {
+    return 0;
+  }
+  // Until latency feedback is available, charge one microsecond per batch so
+  // that fair sharing degrades to balancing in-flight batch counts.
+  const double cost = std::max(it->second.avg_batch_latency_micros, 1.0);
+  it->second.in_flight_cost_micros += cost;
+  return cost;
+}
+
+template <typename TaskType>
+void AdaptiveSharedBatchScheduler<TaskType>::SettleQueueCharge(
+    const internal::ASBSQueue<TaskType>* queue, double charged_cost,
+    double processing_latency_micros) {
+  // The queue may have been removed while the batch was being processed.
+  auto it = queue_share_stats_.find(queue);
+  if (it == queue_share_stats_.end()) {
+    return;
+  }
+  it->second.in_flight_cost_micros =
+      std::max(0.0, it->second.in_flight_cost_micros - charged_cost);
+  if (it->second.avg_batch_latency_micros == 0) {
+    it->second.avg_batch_latency_micros = processing_latency_micros;
+  } else {
+    it->second.avg_batch_latency_micros =
+        (1 - kLatencyEwmaWeight) * it->second.avg_batch_latency_micros +
+        kLatencyEwmaWeight * processing_latency_micros;
+  }
+}
+
 template <typename TaskType>
 void AdaptiveSharedBatchScheduler<TaskType>::MaybeScheduleClosedBatches() {
   mutex_lock l(mu_);
@@ -616,10 +799,12 @@ void AdaptiveSharedBatchScheduler<
     if ((*it)->IsClosed()) {
       const internal::ASBSBatch<TaskType>* batch = *it;
       it = batches_.erase(it);
+      const double charged_cost = ChargeQueueForBatch(batch->queue());
       batch->queue()->ReleaseBatch(batch);
       batch_thread_pool_->Schedule(
           std::bind(&AdaptiveSharedBatchScheduler<TaskType>::CallbackWrapper,
-                    this, batch, queues_and_callbacks_[batch->queue()], true));
+                    this, batch, queues_and_callbacks_[batch->queue()], true,
+                    charged_cost));
       in_flight_express_batches_++;
       available_threads--;
     } else {
@@ -632,7 +817,7 @@ template <typename TaskType>
 void AdaptiveSharedBatchScheduler<TaskType>::CallbackWrapper(
     const internal::ASBSBatch<TaskType>* batch,
     AdaptiveSharedBatchScheduler<TaskType>::BatchProcessor callback,
-    bool is_express) {
+    bool is_express, double charged_cost) {
   tsl::profiler::TraceMeConsumer trace_me(
       [&] {
         return profiler::TraceMeEncode(
@@ -641,11 +826,17 @@ void AdaptiveSharedBatchScheduler<TaskType>::CallbackWrapper(
       },
       tsl::profiler::ContextType::kAdaptiveSharedBatchScheduler,
       batch->traceme_context_id());
+  const internal::ASBSQueue<TaskType>* queue = batch->queue();
   const int64_t start_time = batch->creation_time_micros();
+  const int64_t process_start_time = GetEnv()->NowMicros();
   callback(std::unique_ptr<Batch<TaskType>>(
       const_cast<internal::ASBSBatch<TaskType>*>(batch)));
   int64_t end_time = GetEnv()->NowMicros();
   mutex_lock l(mu_);
+  if (options_.enable_weighted_fair_sharing) {
+    SettleQueueCharge(queue, charged_cost,
+                      static_cast<double>(end_time - process_start_time));
+  }
   if (is_express) {
     in_flight_express_batches_--;
     MaybeScheduleClosedBatchesLocked();
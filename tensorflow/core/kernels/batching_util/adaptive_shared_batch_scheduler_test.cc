@@ -344,6 +344,103 @@ TEST(AdaptiveSharedBatchSchedulerTest, FIFO) {
   stop_teardown.Notify();
 }
 
+TEST(AdaptiveSharedBatchSchedulerTest, WeightedFairSharing) {
+  test_util::FakeClockEnv env(Env::Default());
+  Notification start_teardown, stop_teardown;
+  std::unique_ptr<Thread> teardown_thread =
+      CreateFakeClockAdvancerThread(&env, &start_teardown, &stop_teardown);
+  {
+    AdaptiveSharedBatchScheduler<FakeTask>::Options options;
+    options.env = &env;
+    options.initial_in_flight_batches_limit = 2;
+    options.num_batch_threads = 2;
+    options.batches_to_average_over = 1000;
+    options.enable_weighted_fair_sharing = true;
+    mutex mu;
+    std::vector<int> processed_batch_sizes;
+    Notification finish_first_batch, finish_second_batch;
+    auto heavy_queue_callback = [&](std::unique_ptr<Batch<FakeTask>> batch) {
+      if (batch->size() == 100) {
+        finish_first_batch.WaitForNotification();
+      } else if (batch->size() == 200) {
+        finish_second_batch.WaitForNotification();
+      }
+      mutex_lock l(mu);
+      processed_batch_sizes.push_back(batch->size());
+    };
+    auto light_queue_callback = [&](std::unique_ptr<Batch<FakeTask>> batch) {
+      mutex_lock l(mu);
+      processed_batch_sizes.push_back(batch->size());
+    };
+    std::shared_ptr<AdaptiveSharedBatchScheduler<FakeTask>> scheduler;
+    TF_ASSERT_OK(
+        AdaptiveSharedBatchScheduler<FakeTask>::Create(options, &scheduler));
+    AdaptiveSharedBatchScheduler<FakeTask>::QueueOptions queue_options;
+    queue_options.max_batch_size = 1000;
+    std::unique_ptr<BatchScheduler<FakeTask>> heavy_queue;
+    std::unique_ptr<BatchScheduler<FakeTask>> light_queue;
+    TF_ASSERT_OK(
+        scheduler->AddQueue(queue_options, heavy_queue_callback, &heavy_queue));
+    TF_ASSERT_OK(
+        scheduler->AddQueue(queue_options, light_queue_callback, &light_queue));
+
+    // Occupy both processing slots with batches from the heavy queue.
+    TF_ASSERT_OK(ScheduleTask(100, heavy_queue.get()));
+    while (heavy_queue->NumEnqueuedTasks() > 0) {
+    }
+    TF_ASSERT_OK(ScheduleTask(200, heavy_queue.get()));
+    while (heavy_queue->NumEnqueuedTasks() > 0) {
+    }
+
+    // Enqueue an older heavy batch and a younger light batch.
+    TF_ASSERT_OK(ScheduleTask(300, heavy_queue.get()));
+    env.AdvanceByMicroseconds(10);
+    TF_ASSERT_OK(ScheduleTask(50, light_queue.get()));
+
+    // Finish the first heavy batch. The heavy queue still has a batch in
+    // flight - its full fair share, since both queues have equal weights -
+    // so the light queue's younger batch is scheduled ahead of the heavy
+    // queue's older one. Once the light queue's batch completes, the heavy
+    // queue is the only one contending and its batch is scheduled despite
+    // the in-flight batch (the arbiter is work conserving).
+    finish_first_batch.Notify();
+    for (;;) {
+      mutex_lock l(mu);
+      if (processed_batch_sizes.size() >= 3) break;
+    }
+    finish_second_batch.Notify();
+    for (;;) {
+      mutex_lock l(mu);
+      if (processed_batch_sizes.size() >= 4) break;
+    }
+    {
+      mutex_lock l(mu);
+      EXPECT_EQ(processed_batch_sizes,
+                (std::vector<int>{100, 50, 300, 200}));
+    }
+    start_teardown.Notify();
+  }
+  stop_teardown.Notify();
+}
+
+TEST(AdaptiveSharedBatchSchedulerTest, BadWeightedFairSharingOptions) {
+  std::shared_ptr<AdaptiveSharedBatchScheduler<FakeTask>> scheduler;
+  AdaptiveSharedBatchScheduler<FakeTask>::Options options;
+  options.enable_weighted_fair_sharing = true;
+  options.fifo_scheduling = true;
+  EXPECT_FALSE(
+      AdaptiveSharedBatchScheduler<FakeTask>::Create(options, &scheduler).ok());
+  options.fifo_scheduling = false;
+  TF_ASSERT_OK(
+      AdaptiveSharedBatchScheduler<FakeTask>::Create(options, &scheduler));
+  auto queue_callback = [](std::unique_ptr<Batch<FakeTask>> batch) {};
+  AdaptiveSharedBatchScheduler<FakeTask>::QueueOptions queue_options;
+  queue_options.fair_share_weight = 0;
+  std::unique_ptr<BatchScheduler<FakeTask>> queue;
+  EXPECT_FALSE(
+      scheduler->AddQueue(queue_options, queue_callback, &queue).ok());
+}
+
 TEST(AdaptiveSharedBatchSchedulerTest, DeleteQueue) {
   AdaptiveSharedBatchScheduler<FakeTask>::Options options;
   options.initial_in_flight_batches_limit = 1;
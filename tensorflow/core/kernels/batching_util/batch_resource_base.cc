@@ -44,6 +44,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/request_cost.h"
 #include "tensorflow/core/common_runtime/request_cost_accessor.h"
 #include "tensorflow/core/common_runtime/request_cost_accessor_registry.h"
+#include "tensorflow/core/common_runtime/request_cost_context.h"
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/op_requires.h"
@@ -928,6 +929,10 @@ Status BatchResourceBase::SplitOutputTensors(
 void BatchResourceBase::CleanUpFunctionHelper(BatchTask& task,
                                               const Status& status) const {
   WithContext wc(task.propagated_context);
+  // Re-install the request's cost token, so work triggered by the done
+  // callback (e.g. the rest of the request's graph) is attributed to the
+  // originating request.
+  ScopedRequestCostContext request_cost_context(task.request_cost);
   if (!status.ok()) {
     if (!absl::StrContains(status.message(),
                            "Function was cancelled before it was started")) {
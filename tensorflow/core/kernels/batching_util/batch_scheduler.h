@@ -92,6 +92,14 @@ class BatchTask {
   virtual tsl::criticality::Criticality criticality() const {
     return tsl::criticality::Criticality::kCritical;
   }
+
+  // Returns the absolute deadline by which the task should finish processing,
+  // in microseconds in the Env::NowMicros() time domain, or the null value if
+  // the task has no deadline. Schedulers that support deadline-aware batch
+  // formation (see SharedBatchScheduler::QueueOptions::
+  // enable_deadline_aware_scheduling) use this to close a batch before its
+  // tightest deadline would be missed. It defaults to no deadline.
+  virtual std::optional<uint64> deadline_micros() const { return std::nullopt; }
 };
 
 // A thread-safe collection of BatchTasks. Tasks can be either added or removed
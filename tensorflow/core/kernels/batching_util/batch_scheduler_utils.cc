@@ -16,9 +16,16 @@ limitations under the License.
 #include "tensorflow/core/kernels/batching_util/batch_scheduler_utils.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "tensorflow/core/kernels/batching_util/batch_stats.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/types.h"
 
@@ -67,5 +74,66 @@ int32 GetPrevAllowedBatchSize(int batch_size,
   return *result;
 }
 
+int GetNextPowerOfTwoBucket(int sequence_length) {
+  DCHECK_GT(sequence_length, 0);
+  int bucket = 1;
+  while (bucket < sequence_length) {
+    bucket <<= 1;
+  }
+  return bucket;
+}
+
+std::string GetBucketedOpName(absl::string_view op_name, int padded_size) {
+  return absl::StrCat(op_name, "/bucket_", padded_size);
+}
+
+namespace {
+
+// Returns the mean cost across all batch sizes recorded for the given model
+// and op, giving each batch size the same weight, or std::nullopt if no costs
+// have been recorded yet.
+std::optional<absl::Duration> MeanRecordedCost(const std::string& model_name,
+                                               const std::string& op_name) {
+  ModelBatchStats& model_stats = GlobalBatchStats().model(model_name, op_name);
+  absl::Duration sum;
+  int64_t count = 0;
+  for (const int32 batch_size : model_stats.BatchSizes()) {
+    std::optional<absl::Duration> mean =
+        model_stats.batch_size(batch_size).tpu_cost().mean();
+    if (mean.has_value()) {
+      sum += *mean;
+      ++count;
+    }
+  }
+  if (count == 0) return std::nullopt;
+  return sum / count;
+}
+
+}  // namespace
+
+uint64 GetBucketedBatchTimeoutMicros(uint64 max_batch_timeout_micros,
+                                     const std::string& model_name,
+                                     const std::string& op_name,
+                                     int padded_size,
+                                     int largest_padded_size) {
+  DCHECK_GT(padded_size, 0);
+  DCHECK_GE(largest_padded_size, padded_size);
+  if (padded_size >= largest_padded_size) {
+    return max_batch_timeout_micros;
+  }
+  double cost_fraction =
+      static_cast<double>(padded_size) / largest_padded_size;
+  const std::optional<absl::Duration> bucket_cost = MeanRecordedCost(
+      model_name, GetBucketedOpName(op_name, padded_size));
+  const std::optional<absl::Duration> largest_bucket_cost = MeanRecordedCost(
+      model_name, GetBucketedOpName(op_name, largest_padded_size));
+  if (bucket_cost.has_value() && largest_bucket_cost.has_value() &&
+      *largest_bucket_cost > absl::ZeroDuration()) {
+    cost_fraction = absl::FDivDuration(*bucket_cost, *largest_bucket_cost);
+  }
+  cost_fraction = std::min(cost_fraction, 1.0);
+  return static_cast<uint64>(max_batch_timeout_micros * cost_fraction);
+}
+
 }  // namespace serving
 }  // namespace tensorflow
@@ -16,8 +16,19 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_KERNELS_BATCHING_UTIL_BATCH_SCHEDULER_UTILS_H_
 #define TENSORFLOW_CORE_KERNELS_BATCHING_UTIL_BATCH_SCHEDULER_UTILS_H_
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/kernels/batching_util/batch_scheduler.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/platform/types.h"
 
 namespace tensorflow {
@@ -36,6 +47,174 @@ int GetPrevAllowedBatchSize(int batch_size,
                             const std::vector<int32>& allowed_batch_sizes,
                             bool disable_padding);
 
+// Returns the smallest power of two greater than or equal to
+// 'sequence_length', which must be positive. Used to group variable-length
+// tasks into padded-shape buckets so that a task is only ever padded to the
+// next power-of-two boundary rather than to the longest sequence being
+// served.
+int GetNextPowerOfTwoBucket(int sequence_length);
+
+// Returns the batch-stats op name under which costs for the padded-shape
+// bucket 'padded_size' of 'op_name' are recorded, e.g. "op/bucket_128".
+// Per-bucket queues should register their processing costs in
+// GlobalBatchStats() under this name so that GetBucketedBatchTimeoutMicros
+// can tune each bucket's batch timeout independently.
+std::string GetBucketedOpName(absl::string_view op_name, int padded_size);
+
+// Returns the batch timeout to use for the padded-shape bucket 'padded_size',
+// scaled down from 'max_batch_timeout_micros' (the timeout of the largest
+// bucket) so that the queueing delay a task may pay stays proportional to its
+// bucket's processing cost. The per-bucket costs are read from
+// GlobalBatchStats() under the names produced by GetBucketedOpName; until
+// both buckets have cost statistics, the timeout is scaled by the ratio of
+// the padded sizes instead.
+uint64 GetBucketedBatchTimeoutMicros(uint64 max_batch_timeout_micros,
+                                     const std::string& model_name,
+                                     const std::string& op_name,
+                                     int padded_size, int largest_padded_size);
+
+// A batch scheduler that routes each task to one of several underlying
+// batching queues, keyed by the power-of-two bucket of the task's sequence
+// length, so that a batch only ever contains tasks padded to the same bucket
+// boundary.
+//
+// Bucket queues are created lazily, on the first task routed to them, via a
+// caller-supplied creator; the creator typically wraps
+// SharedBatchScheduler::AddQueue and derives the queue's batch timeout with
+// GetBucketedBatchTimeoutMicros.
+//
+// Type parameter TaskType must be a subclass of BatchTask.
+template <typename TaskType>
+class ShapeBucketizedBatchScheduler : public BatchScheduler<TaskType> {
+ public:
+  // Returns the (unpadded) sequence length of a task. The task is routed to
+  // the bucket given by GetNextPowerOfTwoBucket of this value.
+  using SequenceLengthFunc = std::function<int(const TaskType&)>;
+
+  // Creates the batching queue to use for the bucket 'padded_size'.
+  using BucketQueueCreator = std::function<Status(
+      int padded_size, std::unique_ptr<BatchScheduler<TaskType>>*)>;
+
+  static Status Create(
+      SequenceLengthFunc sequence_length_func,
+      BucketQueueCreator bucket_queue_creator,
+      std::unique_ptr<ShapeBucketizedBatchScheduler<TaskType>>* scheduler);
+
+  Status Schedule(std::unique_ptr<TaskType>* task) override;
+
+  // Returns the sum over all bucket queues.
+  size_t NumEnqueuedTasks() const override;
+
+  // Returns the sum over all bucket queues. Note that the capacity of the
+  // bucket a particular task routes to may be smaller.
+  size_t SchedulingCapacity() const override;
+
+  // Returns the maximum over all bucket queues, or 0 if no bucket queue has
+  // been created yet.
+  size_t max_task_size() const override;
+
+ private:
+  ShapeBucketizedBatchScheduler(SequenceLengthFunc sequence_length_func,
+                                BucketQueueCreator bucket_queue_creator);
+
+  // Returns the queue for 'padded_size', creating it if necessary.
+  Status GetOrCreateQueue(int padded_size, BatchScheduler<TaskType>** queue);
+
+  const SequenceLengthFunc sequence_length_func_;
+  const BucketQueueCreator bucket_queue_creator_;
+
+  mutable mutex mu_;
+
+  // Bucket queues, keyed by padded size. Queues are never removed, so raw
+  // pointers to the map's values remain valid while 'this' is alive.
+  std::map<int, std::unique_ptr<BatchScheduler<TaskType>>> queues_
+      TF_GUARDED_BY(mu_);
+};
+
+//////////
+// Implementation details follow. API users need not read.
+
+template <typename TaskType>
+Status ShapeBucketizedBatchScheduler<TaskType>::Create(
+    SequenceLengthFunc sequence_length_func,
+    BucketQueueCreator bucket_queue_creator,
+    std::unique_ptr<ShapeBucketizedBatchScheduler<TaskType>>* scheduler) {
+  if (sequence_length_func == nullptr) {
+    return errors::InvalidArgument("sequence_length_func must be set");
+  }
+  if (bucket_queue_creator == nullptr) {
+    return errors::InvalidArgument("bucket_queue_creator must be set");
+  }
+  scheduler->reset(new ShapeBucketizedBatchScheduler<TaskType>(
+      std::move(sequence_length_func), std::move(bucket_queue_creator)));
+  return absl::OkStatus();
+}
+
+template <typename TaskType>
+ShapeBucketizedBatchScheduler<TaskType>::ShapeBucketizedBatchScheduler(
+    SequenceLengthFunc sequence_length_func,
+    BucketQueueCreator bucket_queue_creator)
+    : sequence_length_func_(std::move(sequence_length_func)),
+      bucket_queue_creator_(std::move(bucket_queue_creator)) {}
+
+template <typename TaskType>
+Status ShapeBucketizedBatchScheduler<TaskType>::Schedule(
+    std::unique_ptr<TaskType>* task) {
+  const int sequence_length = sequence_length_func_(**task);
+  if (sequence_length <= 0) {
+    return errors::InvalidArgument(
+        "Task sequence length must be positive; was ", sequence_length);
+  }
+  BatchScheduler<TaskType>* queue;
+  TF_RETURN_IF_ERROR(
+      GetOrCreateQueue(GetNextPowerOfTwoBucket(sequence_length), &queue));
+  return queue->Schedule(task);
+}
+
+template <typename TaskType>
+size_t ShapeBucketizedBatchScheduler<TaskType>::NumEnqueuedTasks() const {
+  size_t num_enqueued_tasks = 0;
+  mutex_lock l(mu_);
+  for (const auto& [padded_size, queue] : queues_) {
+    num_enqueued_tasks += queue->NumEnqueuedTasks();
+  }
+  return num_enqueued_tasks;
+}
+
+template <typename TaskType>
+size_t ShapeBucketizedBatchScheduler<TaskType>::SchedulingCapacity() const {
+  size_t scheduling_capacity = 0;
+  mutex_lock l(mu_);
+  for (const auto& [padded_size, queue] : queues_) {
+    scheduling_capacity += queue->SchedulingCapacity();
+  }
+  return scheduling_capacity;
+}
+
+template <typename TaskType>
+size_t ShapeBucketizedBatchScheduler<TaskType>::max_task_size() const {
+  size_t max_task_size = 0;
+  mutex_lock l(mu_);
+  for (const auto& [padded_size, queue] : queues_) {
+    max_task_size = std::max(max_task_size, queue->max_task_size());
+  }
+  return max_task_size;
+}
+
+template <typename TaskType>
+Status ShapeBucketizedBatchScheduler<TaskType>::GetOrCreateQueue(
+    int padded_size, BatchScheduler<TaskType>** queue) {
+  mutex_lock l(mu_);
+  auto it = queues_.find(padded_size);
+  if (it == queues_.end()) {
+    std::unique_ptr<BatchScheduler<TaskType>> new_queue;
+    TF_RETURN_IF_ERROR(bucket_queue_creator_(padded_size, &new_queue));
+    it = queues_.emplace(padded_size, std::move(new_queue)).first;
+  }
+  *queue = it->second.get();
+  return absl::OkStatus();
+}
+
 }  // namespace serving
 }  // namespace tensorflow
 
@@ -15,7 +15,17 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/batching_util/batch_scheduler_utils.h"
 
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
+#include "absl/time/time.h"
+#include "tensorflow/core/kernels/batching_util/batch_scheduler.h"
+#include "tensorflow/core/kernels/batching_util/batch_stats.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
 
 namespace tensorflow {
 namespace serving {
@@ -66,6 +76,146 @@ TEST(GetPrevAllowedBatchSizeTest, GreaterThanMaxAllowedBatchSize) {
   EXPECT_EQ(GetPrevAllowedBatchSize(10, {2, 4, 8}, false), 8);
 }
 
+TEST(GetNextPowerOfTwoBucketTest, One) {
+  EXPECT_EQ(GetNextPowerOfTwoBucket(1), 1);
+}
+
+TEST(GetNextPowerOfTwoBucketTest, AlreadyPowerOfTwo) {
+  EXPECT_EQ(GetNextPowerOfTwoBucket(64), 64);
+}
+
+TEST(GetNextPowerOfTwoBucketTest, RoundsUp) {
+  EXPECT_EQ(GetNextPowerOfTwoBucket(3), 4);
+  EXPECT_EQ(GetNextPowerOfTwoBucket(65), 128);
+}
+
+TEST(GetBucketedOpNameTest, AppendsBucketSuffix) {
+  EXPECT_EQ(GetBucketedOpName("batch_op", 128), "batch_op/bucket_128");
+}
+
+TEST(GetBucketedBatchTimeoutMicrosTest, LargestBucketKeepsMaxTimeout) {
+  EXPECT_EQ(GetBucketedBatchTimeoutMicros(1000, "bucket_timeout_model_a",
+                                          "op", 128, 128),
+            1000);
+}
+
+TEST(GetBucketedBatchTimeoutMicrosTest, ScalesByPaddedSizeWithoutStats) {
+  EXPECT_EQ(GetBucketedBatchTimeoutMicros(1000, "bucket_timeout_model_b",
+                                          "op", 32, 128),
+            250);
+}
+
+TEST(GetBucketedBatchTimeoutMicrosTest, ScalesByRecordedCostRatio) {
+  GlobalBatchStats()
+      .model("bucket_timeout_model_c", GetBucketedOpName("op", 32))
+      .batch_size(4)
+      .tpu_cost()
+      .Register(absl::Milliseconds(10));
+  GlobalBatchStats()
+      .model("bucket_timeout_model_c", GetBucketedOpName("op", 128))
+      .batch_size(4)
+      .tpu_cost()
+      .Register(absl::Milliseconds(100));
+  EXPECT_EQ(GetBucketedBatchTimeoutMicros(1000, "bucket_timeout_model_c",
+                                          "op", 32, 128),
+            100);
+}
+
+class FakeTask : public BatchTask {
+ public:
+  explicit FakeTask(size_t sequence_length)
+      : sequence_length_(sequence_length) {}
+
+  size_t size() const override { return 1; }
+
+  size_t sequence_length() const { return sequence_length_; }
+
+ private:
+  const size_t sequence_length_;
+};
+
+// A scheduler stub that records the sequence lengths of the tasks scheduled
+// on it.
+class RecordingBatchScheduler : public BatchScheduler<FakeTask> {
+ public:
+  explicit RecordingBatchScheduler(std::vector<int>* sequence_lengths)
+      : sequence_lengths_(sequence_lengths) {}
+
+  Status Schedule(std::unique_ptr<FakeTask>* task) override {
+    sequence_lengths_->push_back((*task)->sequence_length());
+    task->reset();
+    return absl::OkStatus();
+  }
+
+  size_t NumEnqueuedTasks() const override {
+    return sequence_lengths_->size();
+  }
+
+  size_t SchedulingCapacity() const override { return 100; }
+
+  size_t max_task_size() const override { return 10; }
+
+ private:
+  std::vector<int>* sequence_lengths_;
+};
+
+TEST(ShapeBucketizedBatchSchedulerTest, RoutesTasksToPowerOfTwoBuckets) {
+  std::map<int, std::vector<int>> sequence_lengths_by_bucket;
+  std::unique_ptr<ShapeBucketizedBatchScheduler<FakeTask>> scheduler;
+  TF_ASSERT_OK(ShapeBucketizedBatchScheduler<FakeTask>::Create(
+      [](const FakeTask& task) {
+        return static_cast<int>(task.sequence_length());
+      },
+      [&](int padded_size, std::unique_ptr<BatchScheduler<FakeTask>>* queue) {
+        *queue = std::make_unique<RecordingBatchScheduler>(
+            &sequence_lengths_by_bucket[padded_size]);
+        return absl::OkStatus();
+      },
+      &scheduler));
+
+  for (const int sequence_length : {3, 4, 5, 100}) {
+    auto task = std::make_unique<FakeTask>(sequence_length);
+    TF_ASSERT_OK(scheduler->Schedule(&task));
+  }
+
+  ASSERT_EQ(sequence_lengths_by_bucket.size(), 3);
+  EXPECT_EQ(sequence_lengths_by_bucket[4], (std::vector<int>{3, 4}));
+  EXPECT_EQ(sequence_lengths_by_bucket[8], (std::vector<int>{5}));
+  EXPECT_EQ(sequence_lengths_by_bucket[128], (std::vector<int>{100}));
+  EXPECT_EQ(scheduler->NumEnqueuedTasks(), 4);
+  EXPECT_EQ(scheduler->SchedulingCapacity(), 300);
+  EXPECT_EQ(scheduler->max_task_size(), 10);
+}
+
+TEST(ShapeBucketizedBatchSchedulerTest, RejectsNonPositiveSequenceLength) {
+  std::unique_ptr<ShapeBucketizedBatchScheduler<FakeTask>> scheduler;
+  TF_ASSERT_OK(ShapeBucketizedBatchScheduler<FakeTask>::Create(
+      [](const FakeTask& task) { return 0; },
+      [](int padded_size, std::unique_ptr<BatchScheduler<FakeTask>>* queue) {
+        return absl::OkStatus();
+      },
+      &scheduler));
+
+  auto task = std::make_unique<FakeTask>(1);
+  EXPECT_FALSE(scheduler->Schedule(&task).ok());
+}
+
+TEST(ShapeBucketizedBatchSchedulerTest, RequiresCallbacks) {
+  std::unique_ptr<ShapeBucketizedBatchScheduler<FakeTask>> scheduler;
+  EXPECT_FALSE(ShapeBucketizedBatchScheduler<FakeTask>::Create(
+                   nullptr,
+                   [](int padded_size,
+                      std::unique_ptr<BatchScheduler<FakeTask>>* queue) {
+                     return absl::OkStatus();
+                   },
+                   &scheduler)
+                   .ok());
+  EXPECT_FALSE(ShapeBucketizedBatchScheduler<FakeTask>::Create(
+                   [](const FakeTask& task) { return 1; },
+                   nullptr, &scheduler)
+                   .ok());
+}
+
 }  // namespace
 
 }  // namespace serving
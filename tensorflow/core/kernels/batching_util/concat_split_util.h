@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_KERNELS_BATCHING_UTIL_CONCAT_SPLIT_UTIL_H_
 #define TENSORFLOW_CORE_KERNELS_BATCHING_UTIL_CONCAT_SPLIT_UTIL_H_
 
+#include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/ops_util.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -30,21 +31,78 @@ namespace concat_split_util {
 typedef Eigen::ThreadPoolDevice CPUDevice;
 typedef Eigen::GpuDevice GPUDevice;
 
+// Handles cases where the concatenation is a no-op because the inputs are
+// already laid out contiguously in memory. Aliases the existing buffers
+// instead of copying them, so callers must tolerate 'output' sharing buffers
+// with 'inputs'. Sets 'done==true' iff it found an applicable special case
+// and wrote to 'output'. Otherwise acts as a no-op.
+//
+// Requires that 'inputs' have already been validated to have matching ranks
+// and inner dimensions, and that 'output_shape' is their concatenated shape.
+template <typename T>
+Status ConcatEasyCases(OpKernelContext* context,
+                       const absl::Span<const Tensor> inputs,
+                       const TensorShape& output_shape, Tensor* output,
+                       bool* done) {
+  *done = false;
+
+  // Inputs without any elements don't contribute to the result.
+  std::vector<const Tensor*> nonempty_inputs;
+  nonempty_inputs.reserve(inputs.size());
+  for (const Tensor& input : inputs) {
+    if (input.NumElements() > 0) {
+      nonempty_inputs.push_back(&input);
+    }
+  }
+  if (nonempty_inputs.empty()) {
+    return absl::OkStatus();
+  }
+
+  // Special case 0: only one input has any elements, so the concatenation is
+  // that input (the inner dimensions match by validation, so its shape is
+  // exactly 'output_shape').
+  if (nonempty_inputs.size() == 1) {
+    *output = *nonempty_inputs[0];
+    *done = true;
+    return absl::OkStatus();
+  }
+
+  // Special case 1: the inputs are back-to-back slices that cover one buffer
+  // entirely, e.g. they were produced by splitting a batched tensor along
+  // the zeroth dimension (see SplitEasyCases below). The concatenation then
+  // reassembles exactly that buffer, so alias it instead of copying.
+  TensorBuffer* root_buffer =
+      const_cast<TensorBuffer*>(DMAHelper::buffer(nonempty_inputs[0]))
+          ->root_buffer();
+  const char* next_data = static_cast<const char*>(root_buffer->data());
+  size_t covered_bytes = 0;
+  for (const Tensor* input : nonempty_inputs) {
+    const TensorBuffer* buffer = DMAHelper::buffer(input);
+    if (const_cast<TensorBuffer*>(buffer)->root_buffer() != root_buffer ||
+        input->tensor_data().data() != next_data) {
+      return absl::OkStatus();
+    }
+    next_data += input->tensor_data().size();
+    covered_bytes += input->tensor_data().size();
+  }
+  if (covered_bytes == root_buffer->size()) {
+    *output = Tensor(DataTypeToEnum<T>::value, output_shape, root_buffer);
+    *done = true;
+  }
+  return absl::OkStatus();
+}
+
 // Concatenates 'inputs' into a single tensor along the zeroth dimension.
 // Requires that all elements of 'inputs' have element type T. Writes to
 // 'output' using 'context' for the allocation to ensure proper device
-// placement.
+// placement. When the inputs are already contiguous in memory the output
+// aliases them instead of copying (see ConcatEasyCases above).
 template <typename T>
 Status Concat(OpKernelContext* context, const absl::Span<const Tensor> inputs,
               Tensor* output) {
   const int input_dims = inputs[0].dims();
   const TensorShape& input_shape = inputs[0].shape();
 
-  // Note that we reduce the concat of k-dimensional tensors into a two
-  // dimensional concat. Assuming the dimensions of any input tensor are
-  // {y0, y1,...,ym-1}, we flatten it to {1, y}, where y = Prod_i(yi).
-  std::vector<std::unique_ptr<typename TTypes<T, 2>::ConstMatrix>> inputs_flat;
-  inputs_flat.reserve(inputs.size());
   int64_t output_dim0 = 0;
   for (size_t i = 0; i < inputs.size(); ++i) {
     const Tensor& input = inputs[i];
@@ -62,15 +120,32 @@ Status Concat(OpKernelContext* context, const absl::Span<const Tensor> inputs,
             "] = ", input.shape().DebugString());
       }
     }
+    output_dim0 += input.dim_size(0);
+  }
+
+  TensorShape output_shape(input_shape);
+  output_shape.set_dim(0, output_dim0);
+
+  bool easy_cases_done;
+  TF_RETURN_IF_ERROR(ConcatEasyCases<T>(context, inputs, output_shape, output,
+                                        &easy_cases_done));
+  if (easy_cases_done) {
+    return absl::OkStatus();
+  }
+
+  // Note that we reduce the concat of k-dimensional tensors into a two
+  // dimensional concat. Assuming the dimensions of any input tensor are
+  // {y0, y1,...,ym-1}, we flatten it to {1, y}, where y = Prod_i(yi).
+  std::vector<std::unique_ptr<typename TTypes<T, 2>::ConstMatrix>> inputs_flat;
+  inputs_flat.reserve(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const Tensor& input = inputs[i];
     if (input.NumElements() > 0) {
       inputs_flat.emplace_back(new typename TTypes<T, 2>::ConstMatrix(
           input.shaped<T, 2>({1, input.NumElements()})));
     }
-    output_dim0 += input.dim_size(0);
   }
 
-  TensorShape output_shape(input_shape);
-  output_shape.set_dim(0, output_dim0);
   AllocatorAttributes attr;
   attr.set_on_host(true);
   TF_RETURN_IF_ERROR(context->allocate_temp(DataTypeToEnum<T>::value,
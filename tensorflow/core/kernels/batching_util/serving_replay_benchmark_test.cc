@@ -0,0 +1,464 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// End-to-end serving benchmark that replays a recorded request trace through
+// the full serving path: request arrival (with recorded timing), batching via
+// SharedBatchScheduler, and a Session::Run that parses the serialized
+// tf.Example payloads with ParseExampleV2 and runs the model. It reports
+// throughput, latency percentiles, batch-size distribution and per-stage
+// (queue / batch assembly / session run) time, so successive TF releases can
+// be compared like-for-like on the same trace.
+//
+// The trace is a TFRecord file in which each record is an 8-byte
+// little-endian arrival timestamp in microseconds (relative timestamps are
+// fine; the first record's timestamp is treated as the origin) followed by a
+// serialized tensorflow.Example payload. When --trace_file is empty a
+// synthetic trace is generated (see --synthetic_* flags) so the benchmark
+// runs out of the box.
+//
+// The model is loaded from --saved_model_dir (the tensor named by
+// --input_tensor receives the 1-D string batch of serialized Examples and
+// --output_tensor is fetched). When --saved_model_dir is empty an in-process
+// ParseExampleV2 + MatMul model is built instead.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "tensorflow/cc/saved_model/loader.h"
+#include "tensorflow/cc/saved_model/tag_constants.h"
+#include "tensorflow/core/example/example.pb.h"
+#include "tensorflow/core/example/feature.pb.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/kernels/batching_util/batch_scheduler.h"
+#include "tensorflow/core/kernels/batching_util/shared_batch_scheduler.h"
+#include "tensorflow/core/lib/histogram/histogram.h"
+#include "tensorflow/core/lib/io/record_reader.h"
+#include "tensorflow/core/platform/coding.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/init_main.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/test_benchmark.h"
+#include "tensorflow/core/public/session.h"
+#include "tensorflow/core/util/command_line_flags.h"
+
+namespace tensorflow {
+namespace serving {
+namespace {
+
+using ::tensorflow::histogram::Histogram;
+
+// Model under benchmark. When saved_model_dir is empty, a synthetic
+// ParseExampleV2 + MatMul model is built in process.
+static string saved_model_dir;                   // NOLINT
+static string input_tensor = "serialized";       // NOLINT
+static string output_tensor = "scores";          // NOLINT
+
+// Trace to replay. When trace_file is empty a synthetic trace is generated.
+static string trace_file;  // NOLINT
+static double replay_speedup = 1.0;
+static int synthetic_num_requests = 20000;
+static double synthetic_qps = 2000.0;
+static int synthetic_feature_size = 16;
+
+// Batching configuration, mirroring what the serving binary would use.
+static int max_batch_size = 64;
+static int batch_timeout_micros = 2000;
+static int num_batch_threads = 4;
+static int max_enqueued_batches = 256;
+
+// One request from the trace: when it arrived (relative to the start of the
+// trace) and its serialized tf.Example payload.
+struct TraceRequest {
+  int64_t timestamp_micros;
+  tstring payload;
+};
+
+// Reads a trace from `path`. Each TFRecord holds an 8-byte little-endian
+// arrival timestamp in microseconds followed by the serialized payload.
+Status LoadTrace(const string& path, std::vector<TraceRequest>* trace) {
+  std::unique_ptr<RandomAccessFile> file;
+  TF_RETURN_IF_ERROR(Env::Default()->NewRandomAccessFile(path, &file));
+  io::SequentialRecordReader reader(file.get());
+  tstring record;
+  while (true) {
+    Status s = reader.ReadRecord(&record);
+    if (errors::IsOutOfRange(s)) break;
+    TF_RETURN_IF_ERROR(s);
+    if (record.size() < sizeof(uint64)) {
+      return errors::DataLoss("Trace record of ", record.size(),
+                              " bytes is too short to hold a timestamp");
+    }
+    TraceRequest request;
+    request.timestamp_micros =
+        static_cast<int64_t>(core::DecodeFixed64(record.data()));
+    request.payload.assign(record.data() + sizeof(uint64),
+                           record.size() - sizeof(uint64));
+    trace->push_back(std::move(request));
+  }
+  if (trace->empty()) {
+    return errors::InvalidArgument("Trace file ", path, " holds no requests");
+  }
+  // Recorded timestamps may be absolute; rebase on the first request.
+  const int64_t origin = trace->front().timestamp_micros;
+  for (TraceRequest& request : *trace) {
+    request.timestamp_micros -= origin;
+  }
+  return absl::OkStatus();
+}
+
+// Generates a uniform-rate trace of Examples with a single fixed-length float
+// feature "x", matching the synthetic model.
+std::vector<TraceRequest> SynthesizeTrace(int num_requests, double qps,
+                                          int feature_size) {
+  std::vector<TraceRequest> trace;
+  trace.reserve(num_requests);
+  const double interval_micros = 1'000'000.0 / qps;
+  for (int i = 0; i < num_requests; ++i) {
+    Example example;
+    Feature& feature =
+        (*example.mutable_features()->mutable_feature())["x"];
+    for (int j = 0; j < feature_size; ++j) {
+      feature.mutable_float_list()->add_value(
+          static_cast<float>((i + j) % 17) / 16.0f);
+    }
+    TraceRequest request;
+    request.timestamp_micros = static_cast<int64_t>(i * interval_micros);
+    request.payload = example.SerializeAsString();
+    trace.push_back(std::move(request));
+  }
+  return trace;
+}
+
+Status AddConstNode(const string& name, const Tensor& value,
+                    GraphDef* graph_def) {
+  return NodeDefBuilder(name, "Const")
+      .Attr("dtype", value.dtype())
+      .Attr("value", value)
+      .Finalize(graph_def->add_node());
+}
+
+// Builds the synthetic serving model: a 1-D string placeholder of serialized
+// Examples, ParseExampleV2 extracting the dense float feature "x" of
+// `feature_size` values, and a MatMul against fixed weights.
+Status BuildSyntheticModel(int feature_size,
+                           std::unique_ptr<Session>* session) {
+  GraphDef graph_def;
+  TF_RETURN_IF_ERROR(NodeDefBuilder(input_tensor, "Placeholder")
+                         .Attr("dtype", DT_STRING)
+                         .Attr("shape", PartialTensorShape({-1}))
+                         .Finalize(graph_def.add_node()));
+  TF_RETURN_IF_ERROR(
+      AddConstNode("names", Tensor(DT_STRING, {0}), &graph_def));
+  TF_RETURN_IF_ERROR(
+      AddConstNode("sparse_keys", Tensor(DT_STRING, {0}), &graph_def));
+  Tensor dense_keys(DT_STRING, {1});
+  dense_keys.vec<tstring>()(0) = "x";
+  TF_RETURN_IF_ERROR(AddConstNode("dense_keys", dense_keys, &graph_def));
+  TF_RETURN_IF_ERROR(
+      AddConstNode("ragged_keys", Tensor(DT_STRING, {0}), &graph_def));
+  // An empty default makes the feature required.
+  TF_RETURN_IF_ERROR(
+      AddConstNode("dense_default", Tensor(DT_FLOAT, {0}), &graph_def));
+  TF_RETURN_IF_ERROR(
+      NodeDefBuilder("parse", "ParseExampleV2")
+          .Input(input_tensor, 0, DT_STRING)
+          .Input("names", 0, DT_STRING)
+          .Input("sparse_keys", 0, DT_STRING)
+          .Input("dense_keys", 0, DT_STRING)
+          .Input("ragged_keys", 0, DT_STRING)
+          .Input(std::vector<NodeDefBuilder::NodeOut>{
+              {"dense_default", 0, DT_FLOAT}})
+          .Attr("num_sparse", 0)
+          .Attr("sparse_types", DataTypeVector{})
+          .Attr("ragged_value_types", DataTypeVector{})
+          .Attr("ragged_split_types", DataTypeVector{})
+          .Attr("dense_shapes",
+                std::vector<TensorShape>{TensorShape({feature_size})})
+          .Finalize(graph_def.add_node()));
+  Tensor weights(DT_FLOAT, {feature_size, 8});
+  auto weights_matrix = weights.matrix<float>();
+  for (int i = 0; i < feature_size; ++i) {
+    for (int j = 0; j < 8; ++j) {
+      weights_matrix(i, j) = static_cast<float>((i + 3 * j) % 7) - 3.0f;
+    }
+  }
+  TF_RETURN_IF_ERROR(AddConstNode("weights", weights, &graph_def));
+  // With no sparse or ragged outputs, dense_values is output 0 of "parse".
+  TF_RETURN_IF_ERROR(NodeDefBuilder(output_tensor, "MatMul")
+                         .Input("parse", 0, DT_FLOAT)
+                         .Input("weights", 0, DT_FLOAT)
+                         .Finalize(graph_def.add_node()));
+
+  session->reset(NewSession(SessionOptions()));
+  return (*session)->Create(graph_def);
+}
+
+// One in-flight request in the batching queue.
+class ServingTask : public BatchTask {
+ public:
+  explicit ServingTask(const TraceRequest* request)
+      : request_(request), enqueue_micros_(Env::Default()->NowMicros()) {}
+
+  size_t size() const override { return 1; }
+
+  const TraceRequest& request() const { return *request_; }
+  uint64 enqueue_micros() const { return enqueue_micros_; }
+
+ private:
+  const TraceRequest* const request_;
+  const uint64 enqueue_micros_;
+};
+
+// Replays a trace through a SharedBatchScheduler whose batches are executed
+// by Session::Run, and accumulates the serving metrics.
+class ServingReplayBenchmark {
+ public:
+  ServingReplayBenchmark(Session* session, const string& feed_name,
+                         const string& fetch_name,
+                         const std::vector<TraceRequest>& trace)
+      : session_(session),
+        feed_name_(feed_name),
+        fetch_name_(fetch_name),
+        trace_(trace) {
+    SharedBatchScheduler<ServingTask>::Options scheduler_options;
+    scheduler_options.thread_pool_name = "serving_replay";
+    scheduler_options.num_batch_threads = num_batch_threads;
+    TF_CHECK_OK(SharedBatchScheduler<ServingTask>::Create(scheduler_options,
+                                                          &scheduler_));
+    SharedBatchScheduler<ServingTask>::QueueOptions queue_options;
+    queue_options.input_batch_size_limit = max_batch_size;
+    queue_options.max_execution_batch_size = max_batch_size;
+    queue_options.batch_timeout_micros = batch_timeout_micros;
+    queue_options.max_enqueued_batches = max_enqueued_batches;
+    TF_CHECK_OK(scheduler_->AddQueue(
+        queue_options,
+        [this](std::unique_ptr<Batch<ServingTask>> batch) {
+          ProcessBatch(std::move(batch));
+        },
+        &queue_));
+  }
+
+  ServingReplayBenchmark(const ServingReplayBenchmark&) = delete;
+  ServingReplayBenchmark& operator=(const ServingReplayBenchmark&) = delete;
+
+  // Replays the whole trace, pacing arrivals by the recorded timestamps
+  // divided by --replay_speedup.
+  void Replay() {
+    replay_start_micros_ = Env::Default()->NowMicros();
+    for (const TraceRequest& request : trace_) {
+      const int64_t arrival_micros =
+          replay_start_micros_ +
+          static_cast<int64_t>(request.timestamp_micros / replay_speedup);
+      int64_t now_micros = Env::Default()->NowMicros();
+      while (now_micros < arrival_micros) {
+        if (arrival_micros - now_micros >= 1000) {
+          Env::Default()->SleepForMicroseconds(arrival_micros - now_micros -
+                                               500);
+        }
+        now_micros = Env::Default()->NowMicros();
+      }
+      auto task = std::make_unique<ServingTask>(&request);
+      Status s = queue_->Schedule(&task);
+      while (errors::IsUnavailable(s)) {
+        // The queue is full; the replayed client would see pushback. Retry
+        // shortly and account for the throttling in the report.
+        ++num_throttled_;
+        Env::Default()->SleepForMicroseconds(100);
+        s = queue_->Schedule(&task);
+      }
+      TF_CHECK_OK(s);
+    }
+  }
+
+  // Destroys the queue, which blocks until every scheduled task has been
+  // processed.
+  void WaitForCompletion() {
+    queue_.reset();
+    scheduler_.reset();
+  }
+
+  string Report() {
+    mutex_lock l(mu_);
+    const double duration_secs =
+        (last_completion_micros_ - replay_start_micros_) / 1e6;
+    const double throughput =
+        duration_secs > 0 ? num_completed_ / duration_secs : 0;
+    return absl::StrCat(
+        "requests=", num_completed_, " throttled=", num_throttled_,
+        " throughput=", throughput, "/s",
+        " latency_ms{p50=", latency_millis_.Percentile(50),
+        ",p99=", latency_millis_.Percentile(99),
+        ",p99.9=", latency_millis_.Percentile(99.9), "}",
+        " batch_size{mean=", batch_size_.Average(),
+        ",p50=", batch_size_.Percentile(50),
+        ",p99=", batch_size_.Percentile(99), "}",
+        " stage_ms{queue=", queue_millis_.Average(),
+        ",assembly=", assembly_millis_.Average(),
+        ",run=", run_millis_.Average(), "}");
+  }
+
+ private:
+  void ProcessBatch(std::unique_ptr<Batch<ServingTask>> batch) {
+    const uint64 batch_start_micros = Env::Default()->NowMicros();
+    const int num_tasks = batch->num_tasks();
+
+    // Batch assembly: concatenate the payloads into the feed tensor.
+    Tensor serialized(DT_STRING, {num_tasks});
+    auto serialized_vec = serialized.vec<tstring>();
+    for (int i = 0; i < num_tasks; ++i) {
+      serialized_vec(i) = batch->task(i).request().payload;
+    }
+    const uint64 assembled_micros = Env::Default()->NowMicros();
+
+    std::vector<Tensor> outputs;
+    TF_CHECK_OK(session_->Run({{feed_name_, serialized}}, {fetch_name_}, {},
+                              &outputs));
+    const uint64 done_micros = Env::Default()->NowMicros();
+
+    mutex_lock l(mu_);
+    batch_size_.Add(num_tasks);
+    assembly_millis_.Add((assembled_micros - batch_start_micros) / 1000.0);
+    run_millis_.Add((done_micros - assembled_micros) / 1000.0);
+    for (int i = 0; i < num_tasks; ++i) {
+      const uint64 enqueue_micros = batch->task(i).enqueue_micros();
+      queue_millis_.Add((batch_start_micros - enqueue_micros) / 1000.0);
+      latency_millis_.Add((done_micros - enqueue_micros) / 1000.0);
+    }
+    num_completed_ += num_tasks;
+    last_completion_micros_ = std::max(last_completion_micros_, done_micros);
+  }
+
+  Session* const session_;
+  const string feed_name_;
+  const string fetch_name_;
+  const std::vector<TraceRequest>& trace_;
+
+  std::shared_ptr<SharedBatchScheduler<ServingTask>> scheduler_;
+  std::unique_ptr<BatchScheduler<ServingTask>> queue_;
+
+  uint64 replay_start_micros_ = 0;
+  int64_t num_throttled_ = 0;
+
+  mutex mu_;
+  Histogram latency_millis_ TF_GUARDED_BY(mu_);
+  Histogram queue_millis_ TF_GUARDED_BY(mu_);
+  Histogram assembly_millis_ TF_GUARDED_BY(mu_);
+  Histogram run_millis_ TF_GUARDED_BY(mu_);
+  Histogram batch_size_ TF_GUARDED_BY(mu_);
+  int64_t num_completed_ TF_GUARDED_BY(mu_) = 0;
+  uint64 last_completion_micros_ TF_GUARDED_BY(mu_) = 0;
+};
+
+// Replays the trace once and reports the serving metrics as the benchmark
+// label. Iterations(1): the replay takes as long as the (speedup-adjusted)
+// trace and the interesting output is the metric report, not wall time.
+void ServingReplayBM(::testing::benchmark::State& state) {
+  std::vector<TraceRequest> trace;
+  if (trace_file.empty()) {
+    trace = SynthesizeTrace(synthetic_num_requests, synthetic_qps,
+                            synthetic_feature_size);
+  } else {
+    TF_CHECK_OK(LoadTrace(trace_file, &trace));
+  }
+
+  std::unique_ptr<Session> owned_session;
+  SavedModelBundle bundle;
+  Session* session = nullptr;
+  if (saved_model_dir.empty()) {
+    TF_CHECK_OK(BuildSyntheticModel(synthetic_feature_size, &owned_session));
+    session = owned_session.get();
+  } else {
+    TF_CHECK_OK(LoadSavedModel(SessionOptions(), RunOptions(),
+                               saved_model_dir, {kSavedModelTagServe},
+                               &bundle));
+    session = bundle.GetSession();
+  }
+
+  auto benchmark = std::make_unique<ServingReplayBenchmark>(
+      session, input_tensor, output_tensor, trace);
+  for (auto s : state) {
+    benchmark->Replay();
+  }
+  state.ResumeTiming();
+  benchmark->WaitForCompletion();
+  state.PauseTiming();
+  const string report = benchmark->Report();
+  LOG(INFO) << "Serving replay: " << report;
+  state.SetLabel(report);
+  state.SetItemsProcessed(trace.size());
+}
+BENCHMARK(ServingReplayBM)->UseRealTime()->Iterations(1);
+
+}  // namespace
+}  // namespace serving
+}  // namespace tensorflow
+
+int main(int argc, char** argv) {
+  const std::vector<tensorflow::Flag> flag_list = {
+      tensorflow::Flag("saved_model_dir", &tensorflow::serving::saved_model_dir,
+                       "SavedModel to benchmark; when empty a synthetic "
+                       "ParseExampleV2 + MatMul model is built in process."),
+      tensorflow::Flag("input_tensor", &tensorflow::serving::input_tensor,
+                       "Tensor fed with the 1-D string batch of serialized "
+                       "tf.Examples."),
+      tensorflow::Flag("output_tensor", &tensorflow::serving::output_tensor,
+                       "Tensor fetched per batch."),
+      tensorflow::Flag("trace_file", &tensorflow::serving::trace_file,
+                       "TFRecord request trace (8-byte little-endian arrival "
+                       "timestamp in microseconds, then the serialized "
+                       "tf.Example); when empty a synthetic trace is used."),
+      tensorflow::Flag("replay_speedup", &tensorflow::serving::replay_speedup,
+                       "Divide recorded inter-arrival gaps by this factor."),
+      tensorflow::Flag("synthetic_num_requests",
+                       &tensorflow::serving::synthetic_num_requests,
+                       "Number of requests in the synthetic trace."),
+      tensorflow::Flag("synthetic_qps", &tensorflow::serving::synthetic_qps,
+                       "Arrival rate of the synthetic trace."),
+      tensorflow::Flag("synthetic_feature_size",
+                       &tensorflow::serving::synthetic_feature_size,
+                       "Length of the float feature in synthetic requests."),
+      tensorflow::Flag("max_batch_size", &tensorflow::serving::max_batch_size,
+                       "Maximum batch size."),
+      tensorflow::Flag("batch_timeout_micros",
+                       &tensorflow::serving::batch_timeout_micros,
+                       "How long an incomplete batch may wait."),
+      tensorflow::Flag("num_batch_threads",
+                       &tensorflow::serving::num_batch_threads,
+                       "Number of batch processing threads."),
+      tensorflow::Flag("max_enqueued_batches",
+                       &tensorflow::serving::max_enqueued_batches,
+                       "Queue capacity in batches; beyond it the replay "
+                       "client is throttled."),
+  };
+  if (!tensorflow::Flags::Parse(&argc, argv, flag_list)) {
+    std::cout << tensorflow::Flags::Usage(argv[0], flag_list);
+    return -1;
+  }
+
+  ::benchmark::Initialize(&argc, argv);
+  tensorflow::port::InitMain(argv[0], &argc, &argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
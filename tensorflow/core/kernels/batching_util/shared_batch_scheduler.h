@@ -23,8 +23,11 @@ limitations under the License.
 #include <cstdint>
 #include <deque>
 #include <functional>
+#include <limits>
 #include <list>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -33,7 +36,9 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
 #include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorflow/core/kernels/batching_util/batch_input_task.h"
+#include "tensorflow/core/kernels/batching_util/batch_stats.h"
 #include "tensorflow/core/kernels/batching_util/batch_scheduler.h"
 #include "tensorflow/core/kernels/batching_util/batch_scheduler_utils.h"
 #include "tensorflow/core/kernels/batching_util/periodic_function.h"
@@ -269,6 +274,39 @@ class SharedBatchScheduler
     // effective only when enable_priority_queue is true.
     MixedPriorityBatchingPolicy mixed_priority_batching_policy =
         MixedPriorityBatchingPolicy::kLowPriorityPaddingWithMaxBatchSize;
+
+    // If true, the scheduler additionally closes the open batch as soon as
+    // waiting any longer would make the tightest task deadline unattainable:
+    // the batch becomes schedulable once the current time plus the estimated
+    // time to process the batch reaches the earliest deadline among its
+    // tasks. Tasks declare deadlines by overriding
+    // BatchTask::deadline_micros(); batches whose tasks have no deadline are
+    // governed by `batch_timeout_micros` alone, which also remains in effect
+    // as an upper bound on queueing delay.
+    //
+    // The processing-time estimate comes from `batch_cost_estimator` if set,
+    // and otherwise from the global batch statistics registry (see
+    // batch_stats.h) keyed by `model_name` and `op_name`. When no estimate is
+    // available the processing time is assumed to be zero, i.e. the batch is
+    // closed at the deadline itself.
+    //
+    // Must be false if `enable_lazy_split` is true; otherwise an error is
+    // returned at queue creation time.
+    bool enable_deadline_aware_scheduling = false;
+
+    // Returns an estimate of the time needed to process a batch of the given
+    // size, or the null value if no estimate is available. When set, this
+    // takes precedence over the batch-statistics lookup below.
+    // Used iff `enable_deadline_aware_scheduling` is true.
+    std::function<std::optional<absl::Duration>(int32_t batch_size)>
+        batch_cost_estimator;
+
+    // The model name and batch op name used to look up processing-time
+    // statistics in the global batch statistics registry.
+    // Used iff `enable_deadline_aware_scheduling` is true and
+    // `batch_cost_estimator` is unset.
+    std::string model_name;
+    std::string op_name;
   };
   Status AddQueue(const QueueOptions& options,
                   ProcessBatchCallback process_batch_callback,
@@ -476,6 +514,18 @@ class Queue {
   bool IsOpenBatchSchedulableAfterEagerSplit() const
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Updates 'open_batch_earliest_deadline_micros_' to account for 'task'
+  // having been added to the open batch. No-op unless
+  // `QueueOptions.enable_deadline_aware_scheduling` is true.
+  void TrackOpenBatchDeadline(const TaskType& task)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Returns an estimate of the time needed to process a batch of
+  // 'batch_size' tasks, in microseconds, from
+  // `QueueOptions.batch_cost_estimator` or the global batch statistics
+  // registry. Returns 0 if no estimate is available.
+  uint64 EstimatedBatchCostMicros(size_t batch_size) const;
+
   // Determines whether the low priority tasks in `low_priority_tasks_` can form
   // a batch on their own. If yes, returns a batch that is ready to be
   // processed. Otherwise, returns an empty unique_ptr.
@@ -590,6 +640,14 @@ class Queue {
   // task.
   uint64 open_batch_start_time_micros_ TF_GUARDED_BY(mu_);
 
+  // The earliest deadline among the tasks in the open (back-most) batch in
+  // 'high_priority_batches_', or the maximum uint64 value if none of its
+  // tasks has a deadline.
+  //
+  // Used iff `QueueOptions.enable_deadline_aware_scheduling` is true.
+  uint64 open_batch_earliest_deadline_micros_ TF_GUARDED_BY(mu_) =
+      std::numeric_limits<uint64>::max();
+
   // Whether this queue contains a batch that is eligible to be scheduled.
   // Used to keep track of when to call 'schedulable_batch_callback_'.
   bool schedulable_batch_ TF_GUARDED_BY(mu_) = false;
@@ -722,6 +780,12 @@ Status SharedBatchScheduler<TaskType>::AddQueueAfterRewritingOptions(
         "enable_large_batch_splitting is enabled.");
   }
 
+  if (options.enable_deadline_aware_scheduling && options.enable_lazy_split) {
+    return errors::InvalidArgument(
+        "enable_deadline_aware_scheduling is not supported when "
+        "enable_lazy_split is enabled.");
+  }
+
   if (options.enable_large_batch_splitting &&
       (options.input_batch_size_limit < options.max_execution_batch_size)) {
     return errors::InvalidArgument(
@@ -1042,6 +1106,7 @@ Status Queue<TaskType>::ScheduleWithoutOrEagerSplitImpl(
         },
         tsl::profiler::ContextType::kSharedBatchScheduler,
         batches.back()->traceme_context_id());
+    TrackOpenBatchDeadline(*output_tasks[i]);
     batches.back()->AddTask(std::move(output_tasks[i]));
   }
 
@@ -1398,6 +1463,7 @@ void Queue<TaskType>::StartNewBatch() {
   std::deque<std::unique_ptr<Batch<TaskType>>>& batches = GetBatches();
   batches.back()->Close();
   batches.emplace_back(new Batch<TaskType>(++traceme_context_id_counter_));
+  open_batch_earliest_deadline_micros_ = std::numeric_limits<uint64>::max();
 }
 
 template <typename TaskType>
@@ -1417,9 +1483,56 @@ bool Queue<TaskType>::IsOpenBatchSchedulableAfterEagerSplit() const {
   if (open_batch->empty()) {
     return false;
   }
-  return closed_ || open_batch->size() >= max_execution_batch_size() ||
-         env_->NowMicros() >=
-             open_batch_start_time_micros_ + options_.batch_timeout_micros;
+  if (closed_ || open_batch->size() >= max_execution_batch_size() ||
+      env_->NowMicros() >=
+          open_batch_start_time_micros_ + options_.batch_timeout_micros) {
+    return true;
+  }
+  if (options_.enable_deadline_aware_scheduling &&
+      open_batch_earliest_deadline_micros_ !=
+          std::numeric_limits<uint64>::max()) {
+    // Close the batch once waiting any longer would make the tightest
+    // deadline unattainable, given how long the batch is expected to take to
+    // process.
+    return env_->NowMicros() + EstimatedBatchCostMicros(open_batch->size()) >=
+           open_batch_earliest_deadline_micros_;
+  }
+  return false;
+}
+
+template <typename TaskType>
+void Queue<TaskType>::TrackOpenBatchDeadline(const TaskType& task) {
+  if (!options_.enable_deadline_aware_scheduling) {
+    return;
+  }
+
+  // The deadline is defined only when the task is a derived class of
+  // BatchTask.
+  if constexpr (std::is_base_of_v<BatchTask, TaskType>) {
+    const std::optional<uint64> deadline_micros = task.deadline_micros();
+    if (deadline_micros.has_value() &&
+        *deadline_micros < open_batch_earliest_deadline_micros_) {
+      open_batch_earliest_deadline_micros_ = *deadline_micros;
+    }
+  }
+}
+
+template <typename TaskType>
+uint64 Queue<TaskType>::EstimatedBatchCostMicros(size_t batch_size) const {
+  std::optional<absl::Duration> cost;
+  if (options_.batch_cost_estimator != nullptr) {
+    cost = options_.batch_cost_estimator(static_cast<int32_t>(batch_size));
+  } else {
+    cost = GlobalBatchStats()
+               .model(options_.model_name, options_.op_name)
+               .batch_size(static_cast<int32_t>(batch_size))
+               .tpu_cost()
+               .mean();
+  }
+  if (!cost.has_value() || *cost < absl::ZeroDuration()) {
+    return 0;
+  }
+  return static_cast<uint64>(absl::ToInt64Microseconds(*cost));
 }
 
 template <typename TaskType>
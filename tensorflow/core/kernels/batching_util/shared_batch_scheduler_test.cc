@@ -16,7 +16,10 @@ limitations under the License.
 #include "tensorflow/core/kernels/batching_util/shared_batch_scheduler.h"
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <thread>  // NOLINT(build/c++11)
 #include <tuple>
@@ -28,6 +31,7 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/time/time.h"
 #include "tensorflow/core/kernels/batching_util/batch_scheduler.h"
+#include "tensorflow/core/kernels/batching_util/batch_stats.h"
 #include "tensorflow/core/kernels/batching_util/fake_clock_env.h"
 #include "tensorflow/core/lib/core/notification.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
@@ -62,10 +66,22 @@ class FakeTask : public BatchTask {
     return criticality_;
   }
 
+  std::optional<uint64> deadline_micros() const override {
+    return deadline_micros_;
+  }
+
+  void set_deadline_micros(uint64 deadline_micros) {
+    deadline_micros_ = deadline_micros;
+  }
+
  private:
   const size_t size_;
   const tsl::criticality::Criticality criticality_;
 
+  // The absolute deadline of the task, if any. Only consulted by queues with
+  // `enable_deadline_aware_scheduling` set.
+  std::optional<uint64> deadline_micros_;
+
   FakeTask(const FakeTask&) = delete;
   void operator=(const FakeTask&) = delete;
 };
@@ -108,6 +124,19 @@ Status ScheduleTask(size_t task_size, BatchScheduler<FakeTask>* scheduler,
   return status;
 }
 
+// Creates a FakeTask of size 'task_size' with the given absolute deadline,
+// and calls 'scheduler->Schedule()' on that task. Returns the resulting
+// status.
+Status ScheduleTaskWithDeadline(size_t task_size, uint64 deadline_micros,
+                                BatchScheduler<FakeTask>* scheduler) {
+  std::unique_ptr<FakeTask> task(new FakeTask(task_size));
+  task->set_deadline_micros(deadline_micros);
+  Status status = scheduler->Schedule(&task);
+  // Schedule() should have consumed 'task' iff it returned Status::OK.
+  CHECK_EQ(status.ok(), task == nullptr);
+  return status;
+}
+
 // Helper function similar to the function above. Creates a FakeTask of size
 // 'task_size' and calls 'scheduler->Schedule()' on that task. Returns the
 // resulting status.
@@ -1063,6 +1092,160 @@ INSTANTIATE_TEST_SUITE_P(
                       std::make_tuple(/*enable_input_batch_split=*/false,
                                       /*enable_lazy_split=*/false)));
 
+// Creates QueueOptions with deadline-aware scheduling enabled. The batch
+// timeout is set high enough (relative to the deadlines used in the tests
+// below) that batches only close when a deadline demands it.
+QueueOptions CreateDeadlineAwareQueueOptions(
+    std::function<std::optional<absl::Duration>(int32_t batch_size)>
+        batch_cost_estimator) {
+  QueueOptions options = CreateQueueOptions(
+      /*max_execution_batch_size=*/10, /*input_batch_size_limit=*/10,
+      /*batch_timeout_micros=*/100 * 1000, /*max_enqueued_batches=*/2,
+      /*enable_large_batch_splitting=*/false, /*enable_lazy_split=*/false,
+      /*split_func=*/nullptr);
+  options.enable_deadline_aware_scheduling = true;
+  options.batch_cost_estimator = std::move(batch_cost_estimator);
+  return options;
+}
+
+TEST(SharedBatchSchedulerDeadlineTest, ClosesBatchWhenDeadlineSlackRunsOut) {
+  // Set up a fake clock, which only advances when we explicitly tell it to.
+  test_util::FakeClockEnv env(Env::Default());
+  Notification start_teardown, stop_teardown;
+  std::unique_ptr<Thread> teardown_thread =
+      CreateFakeClockAdvancerThread(&env, &start_teardown, &stop_teardown);
+
+  {
+    Notification batch_processed;
+    auto callback = [&batch_processed](std::unique_ptr<Batch<FakeTask>> batch) {
+      ASSERT_TRUE(batch->IsClosed());
+      EXPECT_EQ(1, batch->num_tasks());
+      batch_processed.Notify();
+    };
+
+    auto scheduler = CreateSharedBatchScheduler(1, &env);
+    auto queue = CreateQueue(
+        scheduler, CreateDeadlineAwareQueueOptions([](int32_t batch_size) {
+          return absl::Microseconds(100);
+        }),
+        callback);
+
+    // Submit an underfull batch whose task must finish by t=200us. Given the
+    // estimated processing cost of 100us, the batch should be closed at
+    // t=100us, well before the 100ms batch timeout.
+    TF_ASSERT_OK(ScheduleTaskWithDeadline(1, /*deadline_micros=*/200,
+                                          queue.get()));
+    env.AdvanceByMicroseconds(99);
+    Env::Default()->SleepForMicroseconds(10 * 1000 /* 10 milliseconds */);
+    EXPECT_FALSE(batch_processed.HasBeenNotified());
+    env.AdvanceByMicroseconds(1);
+    batch_processed.WaitForNotification();
+
+    start_teardown.Notify();
+  }
+  stop_teardown.Notify();
+}
+
+TEST(SharedBatchSchedulerDeadlineTest, TaskWithoutDeadlineObeysTimeout) {
+  test_util::FakeClockEnv env(Env::Default());
+  Notification start_teardown, stop_teardown;
+  std::unique_ptr<Thread> teardown_thread =
+      CreateFakeClockAdvancerThread(&env, &start_teardown, &stop_teardown);
+
+  {
+    Notification batch_processed;
+    auto callback = [&batch_processed](std::unique_ptr<Batch<FakeTask>> batch) {
+      ASSERT_TRUE(batch->IsClosed());
+      batch_processed.Notify();
+    };
+
+    auto scheduler = CreateSharedBatchScheduler(1, &env);
+    auto queue = CreateQueue(
+        scheduler, CreateDeadlineAwareQueueOptions([](int32_t batch_size) {
+          return absl::Microseconds(100);
+        }),
+        callback);
+
+    // A task without a deadline is governed by the batch timeout alone.
+    TF_ASSERT_OK(ScheduleTask(1, queue.get()));
+    env.AdvanceByMicroseconds(100 * 1000 - 1);
+    Env::Default()->SleepForMicroseconds(10 * 1000 /* 10 milliseconds */);
+    EXPECT_FALSE(batch_processed.HasBeenNotified());
+    env.AdvanceByMicroseconds(1);
+    batch_processed.WaitForNotification();
+
+    start_teardown.Notify();
+  }
+  stop_teardown.Notify();
+}
+
+TEST(SharedBatchSchedulerDeadlineTest, UsesCostFromGlobalBatchStats) {
+  // With no estimator configured, the processing cost comes from the global
+  // batch statistics registry, keyed by model name and op name.
+  GlobalBatchStats()
+      .model(/*model_name=*/"deadline_test_model", /*op_name=*/"batch")
+      .batch_size(1)
+      .tpu_cost()
+      .Register(absl::Microseconds(100));
+
+  test_util::FakeClockEnv env(Env::Default());
+  Notification start_teardown, stop_teardown;
+  std::unique_ptr<Thread> teardown_thread =
+      CreateFakeClockAdvancerThread(&env, &start_teardown, &stop_teardown);
+
+  {
+    Notification batch_processed;
+    auto callback = [&batch_processed](std::unique_ptr<Batch<FakeTask>> batch) {
+      ASSERT_TRUE(batch->IsClosed());
+      batch_processed.Notify();
+    };
+
+    auto scheduler = CreateSharedBatchScheduler(1, &env);
+    QueueOptions options =
+        CreateDeadlineAwareQueueOptions(/*batch_cost_estimator=*/nullptr);
+    options.model_name = "deadline_test_model";
+    options.op_name = "batch";
+    auto queue = CreateQueue(scheduler, options, callback);
+
+    TF_ASSERT_OK(ScheduleTaskWithDeadline(1, /*deadline_micros=*/200,
+                                          queue.get()));
+    env.AdvanceByMicroseconds(99);
+    Env::Default()->SleepForMicroseconds(10 * 1000 /* 10 milliseconds */);
+    EXPECT_FALSE(batch_processed.HasBeenNotified());
+    env.AdvanceByMicroseconds(1);
+    batch_processed.WaitForNotification();
+
+    start_teardown.Notify();
+  }
+  stop_teardown.Notify();
+}
+
+TEST(SharedBatchSchedulerDeadlineTest, InvalidWithLazySplit) {
+  auto callback = [](std::unique_ptr<Batch<FakeTask>> batch) {
+    // do nothing.
+  };
+
+  auto scheduler = CreateSharedBatchScheduler(2);
+
+  QueueOptions options = CreateQueueOptions(
+      /*max_execution_batch_size=*/10, /*input_batch_size_limit=*/10,
+      /*batch_timeout_micros=*/100 * 1000, /*max_enqueued_batches=*/2,
+      /*enable_large_batch_splitting=*/true, /*enable_lazy_split=*/true,
+      /*split_func=*/
+      [](std::unique_ptr<FakeTask>* input_task, int first_output_task_size,
+         int input_batch_size_limit,
+         std::vector<std::unique_ptr<FakeTask>>* output_tasks) {
+        return absl::OkStatus();
+      });
+  options.enable_deadline_aware_scheduling = true;
+  std::unique_ptr<Queue> queue;
+  EXPECT_THAT(
+      scheduler->AddQueue(options, callback, &queue),
+      testing::StatusIs(error::INVALID_ARGUMENT,
+                        "enable_deadline_aware_scheduling is not supported "
+                        "when enable_lazy_split is enabled."));
+}
+
 class SharedBatchSchedulerPriorityTest
     : public ::testing::TestWithParam<
           std::tuple<bool, bool, MixedPriorityBatchingPolicy>>,
@@ -15,6 +15,7 @@ limitations under the License.
 
 // See docs in ../ops/math_ops.cc.
 
+#include <algorithm>
 #include <atomic>
 
 #include "tensorflow/core/platform/errors.h"
@@ -133,28 +134,39 @@ struct BincountFunctor<CPUDevice, Tidx, T, false> {
         }
       }
     } else {
+      // Partial bins are indexed by a fixed block decomposition of the input
+      // rather than by worker id, so the per-bin accumulation order does not
+      // depend on which worker picked up which range and float weight sums
+      // are deterministic from run to run.
+      const int64_t num_blocks = num_threads;
+      const int64_t block_size = (arr_size + num_blocks - 1) / num_blocks;
       Tensor partial_bins_t;
       TF_RETURN_IF_ERROR(context->allocate_temp(
-          DataTypeToEnum<T>::value, TensorShape({num_threads, num_bins}),
+          DataTypeToEnum<T>::value, TensorShape({num_blocks, num_bins}),
           &partial_bins_t));
       auto partial_bins = partial_bins_t.matrix<T>();
       partial_bins.setZero();
-      thread_pool->ParallelForWithWorkerId(
-          arr_size, 8 /* cost */,
-          [&](int64_t start_ind, int64_t limit_ind, int64_t worker_id) {
-            if (weights.size()) {
-              for (int64_t i = start_ind; i < limit_ind; i++) {
-                Tidx value = arr_data[i];
-                if (value < num_bins) {
-                  partial_bins(worker_id, value) += weight_data[i];
+      thread_pool->ParallelFor(
+          num_blocks, 8 * block_size /* cost */,
+          [&](int64_t block_begin, int64_t block_end) {
+            for (int64_t block = block_begin; block < block_end; ++block) {
+              const int64_t start_ind = block * block_size;
+              const int64_t limit_ind =
+                  std::min<int64_t>(arr_size, start_ind + block_size);
+              if (weights.size()) {
+                for (int64_t i = start_ind; i < limit_ind; i++) {
+                  Tidx value = arr_data[i];
+                  if (value < num_bins) {
+                    partial_bins(block, value) += weight_data[i];
+                  }
                 }
-              }
-            } else {
-              for (int64_t i = start_ind; i < limit_ind; i++) {
-                Tidx value = arr_data[i];
-                if (value < num_bins) {
-                  // Complex numbers don't support "++".
-                  partial_bins(worker_id, value) += T(1);
+              } else {
+                for (int64_t i = start_ind; i < limit_ind; i++) {
+                  Tidx value = arr_data[i];
+                  if (value < num_bins) {
+                    // Complex numbers don't support "++".
+                    partial_bins(block, value) += T(1);
+                  }
                 }
               }
             }
@@ -180,6 +192,69 @@ struct BincountReduceFunctor<CPUDevice, Tidx, T, binary_output> {
     const int num_cols = in.dimension(1);
     ThreadPool* thread_pool =
         context->device()->tensorflow_cpu_worker_threads()->workers;
+
+    // Parallelizing over rows leaves most of the pool idle when there are
+    // only a few wide rows. In that case shard each row's columns into a
+    // fixed number of blocks with a partial bin array per block, and merge
+    // the blocks into the output row. Indexing partials by block id (rather
+    // than worker id) makes the merge order independent of scheduling, so
+    // float weight sums stay deterministic.
+    constexpr int64_t kMinColsPerRowShard = 1 << 15;
+    const int64_t num_blocks = thread_pool->NumThreads() + 1;
+    if (num_rows < num_blocks && num_cols >= kMinColsPerRowShard &&
+        num_blocks > 1) {
+      const int64_t block_cols = (num_cols + num_blocks - 1) / num_blocks;
+      Tensor partial_bins_t;
+      TF_RETURN_IF_ERROR(context->allocate_temp(
+          DataTypeToEnum<T>::value, TensorShape({num_blocks, num_bins}),
+          &partial_bins_t));
+      auto partial_bins = partial_bins_t.matrix<T>();
+      Eigen::array<int, 1> reduce_dim({0});
+      for (int64_t row = 0; row < num_rows; ++row) {
+        partial_bins.setZero();
+        thread_pool->ParallelFor(
+            num_blocks, 8 * block_cols /* cost */,
+            [&](int64_t block_begin, int64_t block_end) {
+              for (int64_t block = block_begin; block < block_end; ++block) {
+                const int64_t col_begin = block * block_cols;
+                const int64_t col_end =
+                    std::min<int64_t>(num_cols, col_begin + block_cols);
+                for (int64_t j = col_begin; j < col_end; ++j) {
+                  Tidx value = in(row, j);
+                  if (value < 0) {
+                    err_neg_val = value;
+                  } else if (value < num_bins) {
+                    if (binary_output) {
+                      partial_bins(block, value) = T(1);
+                    } else if (weights.size()) {
+                      partial_bins(block, value) += weights(row, j);
+                    } else {
+                      partial_bins(block, value) += T(1);
+                    }
+                  }
+                }
+              }
+            });
+        auto row_out = out.template chip<0>(row);
+        if (binary_output) {
+          // Merge with != / any rather than a max, which complex types do
+          // not support.
+          row_out.device(context->eigen_cpu_device()) =
+              ((row_out != T(0)) || (partial_bins != T(0)).any(reduce_dim))
+                  .template cast<T>();
+        } else {
+          row_out.device(context->eigen_cpu_device()) =
+              row_out + partial_bins.sum(reduce_dim);
+        }
+      }
+      if (err_neg_val < 0) {
+        return errors::InvalidArgument(absl::StrCat(
+            "Input 'in' must be non-negative! Negative input value found: ",
+            static_cast<int>(err_neg_val)));
+      }
+      return OkStatus();
+    }
+
     thread_pool->ParallelForWithWorkerId(
         num_rows, 8 /* cost */,
         [&](int64_t start_row, int64_t end_row, int64_t worker_id) {
@@ -45,6 +45,29 @@ static Graph* Bincount(int arr_size, int nbins) {
   return g;
 }
 
+static Graph* DenseBincount(int num_rows, int num_cols, int nbins) {
+  Graph* g = new Graph(OpRegistry::Global());
+
+  Tensor arr(DT_INT32, TensorShape({num_rows, num_cols}));
+  arr.flat<int32>() = arr.flat<int32>().setRandom().abs();
+
+  Tensor size(DT_INT32, TensorShape({}));
+  size.scalar<int32>()() = static_cast<int32>(nbins);
+
+  Tensor weights(DT_FLOAT, TensorShape({0}));
+
+  Node* node;
+  TF_CHECK_OK(NodeBuilder(g->NewName("n"), "DenseBincount")
+                  .Input(test::graph::Constant(g, arr))
+                  .Input(test::graph::Constant(g, size))
+                  .Input(test::graph::Constant(g, weights))
+                  .Attr("Tidx", DT_INT32)
+                  .Attr("T", DT_FLOAT)
+                  .Attr("binary_output", false)
+                  .Finalize(g, &node));
+  return g;
+}
+
 #define BM_BincountDev(K, NBINS, type)                                     \
   static void BM_Bincount##_##type##_##K##_##NBINS(                        \
       ::testing::benchmark::State& state) {                                \
@@ -66,6 +89,22 @@ BM_BincountDev(128, 1000, cpu);
 BM_BincountDev(128, 2000, cpu);
 BM_BincountDev(128, 5000, cpu);
 
+#define BM_DenseBincountDev(ROWS, COLS, NBINS, type)                  \
+  static void BM_DenseBincount##_##type##_##ROWS##_##COLS##_##NBINS(  \
+      ::testing::benchmark::State& state) {                           \
+    test::Benchmark(#type, DenseBincount(ROWS, COLS, NBINS),          \
+                    /*old_benchmark_api=*/false)                      \
+        .Run(state);                                                  \
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * \
+                            ROWS * COLS);                             \
+  }                                                                   \
+  BENCHMARK(BM_DenseBincount##_##type##_##ROWS##_##COLS##_##NBINS);
+
+// Few wide rows exercise the column-sharded path.
+BM_DenseBincountDev(1, 1048576, 1000, cpu);
+BM_DenseBincountDev(4, 1048576, 1000, cpu);
+BM_DenseBincountDev(128, 8192, 1000, cpu);
+
 BM_BincountDev(32, 1000, gpu);
 BM_BincountDev(32, 2000, gpu);
 BM_BincountDev(32, 5000, gpu);
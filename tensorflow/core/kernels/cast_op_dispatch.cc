@@ -0,0 +1,180 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/kernels/cast_op_dispatch.h"
+
+#include <cstdint>
+
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/util/env_var.h"
+
+// Per-function target attributes are the mechanism that lets us emit AVX-512
+// instructions from a translation unit compiled for the AVX2 baseline. They
+// are only available with GCC and Clang on x86-64.
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define TF_CAST_DISPATCH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace tensorflow {
+namespace internal {
+namespace {
+
+#ifdef TF_CAST_DISPATCH_X86
+
+bool CastRuntimeDispatchEnabled() {
+  static const bool enabled = [] {
+    bool result = true;
+    Status s = ReadBoolFromEnvVar("TF_CAST_RUNTIME_DISPATCH",
+                                  /*default_val=*/true, &result);
+    if (!s.ok()) {
+      LOG(ERROR) << s.message();
+    }
+    return result;
+  }();
+  return enabled;
+}
+
+// Rounds 16 floats to bfloat16 with round-to-nearest-even, quieting NaNs the
+// same way Eigen's scalar conversion does.
+__attribute__((target("avx512f,avx512bw"))) inline __m256i
+FloatToBFloat16Rne512(__m512 input) {
+  const __m512i bits = _mm512_castps_si512(input);
+  const __m512i lsb =
+      _mm512_and_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(1));
+  const __m512i rounding_bias =
+      _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7FFF));
+  const __m512i rounded =
+      _mm512_srli_epi32(_mm512_add_epi32(bits, rounding_bias), 16);
+  // Quiet NaN while preserving the sign bit, matching Eigen's
+  // float_to_bfloat16_rtne.
+  const __mmask16 nan_mask = _mm512_cmp_ps_mask(input, input, _CMP_UNORD_Q);
+  const __m512i sign =
+      _mm512_and_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(0x8000));
+  const __m512i quiet_nan =
+      _mm512_or_si512(sign, _mm512_set1_epi32(0x7FC0));
+  const __m512i result = _mm512_mask_mov_epi32(rounded, nan_mask, quiet_nan);
+  return _mm512_cvtepi32_epi16(result);
+}
+
+__attribute__((target("avx512f,avx512bw"))) void CastFloatToBFloat16Avx512(
+    const float* src, bfloat16* dst, int64_t n) {
+  uint16_t* out = reinterpret_cast<uint16_t*>(dst);
+  int64_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m512 input = _mm512_loadu_ps(src + i);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        FloatToBFloat16Rne512(input));
+  }
+  if (i < n) {
+    const __mmask16 tail = (1u << (n - i)) - 1;
+    const __m512 input = _mm512_maskz_loadu_ps(tail, src + i);
+    _mm256_mask_storeu_epi16(out + i, tail, FloatToBFloat16Rne512(input));
+  }
+}
+
+__attribute__((target("avx512bf16,avx512f,avx512bw,avx512vl"))) void
+CastFloatToBFloat16Avx512Bf16(const float* src, bfloat16* dst, int64_t n) {
+  uint16_t* out = reinterpret_cast<uint16_t*>(dst);
+  int64_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m512 input = _mm512_loadu_ps(src + i);
+    // GCC and Clang both allow same-size vector type punning via C-style
+    // casts; there is no dedicated __m256bh -> __m256i cast intrinsic.
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        (__m256i)_mm512_cvtneps_pbh(input));
+  }
+  if (i < n) {
+    const __mmask16 tail = (1u << (n - i)) - 1;
+    const __m512 input = _mm512_maskz_loadu_ps(tail, src + i);
+    _mm256_mask_storeu_epi16(out + i, tail,
+                             (__m256i)_mm512_cvtneps_pbh(input));
+  }
+}
+
+__attribute__((target("avx512f,avx512bw"))) void CastBFloat16ToFloatAvx512(
+    const bfloat16* src, float* dst, int64_t n) {
+  const uint16_t* in = reinterpret_cast<const uint16_t*>(src);
+  int64_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m256i input =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    const __m512i widened =
+        _mm512_slli_epi32(_mm512_cvtepu16_epi32(input), 16);
+    _mm512_storeu_ps(dst + i, _mm512_castsi512_ps(widened));
+  }
+  if (i < n) {
+    const __mmask16 tail = (1u << (n - i)) - 1;
+    const __m256i input = _mm256_maskz_loadu_epi16(tail, in + i);
+    const __m512i widened =
+        _mm512_slli_epi32(_mm512_cvtepu16_epi32(input), 16);
+    _mm512_mask_storeu_ps(dst + i, tail, _mm512_castsi512_ps(widened));
+  }
+}
+
+using FloatToBFloat16Fn = void (*)(const float*, bfloat16*, int64_t);
+using BFloat16ToFloatFn = void (*)(const bfloat16*, float*, int64_t);
+
+FloatToBFloat16Fn PickFloatToBFloat16() {
+  if (!CastRuntimeDispatchEnabled()) return nullptr;
+  if (port::TestCPUFeature(port::CPUFeature::AVX512_BF16) &&
+      port::TestCPUFeature(port::CPUFeature::AVX512VL)) {
+    return CastFloatToBFloat16Avx512Bf16;
+  }
+  if (port::TestCPUFeature(port::CPUFeature::AVX512F) &&
+      port::TestCPUFeature(port::CPUFeature::AVX512BW)) {
+    return CastFloatToBFloat16Avx512;
+  }
+  return nullptr;
+}
+
+BFloat16ToFloatFn PickBFloat16ToFloat() {
+  if (!CastRuntimeDispatchEnabled()) return nullptr;
+  if (port::TestCPUFeature(port::CPUFeature::AVX512F) &&
+      port::TestCPUFeature(port::CPUFeature::AVX512BW)) {
+    return CastBFloat16ToFloatAvx512;
+  }
+  return nullptr;
+}
+
+#endif  // TF_CAST_DISPATCH_X86
+
+}  // namespace
+
+bool TryBulkCastFloatToBFloat16(const float* src, bfloat16* dst, int64_t n) {
+#ifdef TF_CAST_DISPATCH_X86
+  static const FloatToBFloat16Fn fn = PickFloatToBFloat16();
+  if (fn == nullptr) return false;
+  fn(src, dst, n);
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool TryBulkCastBFloat16ToFloat(const bfloat16* src, float* dst, int64_t n) {
+#ifdef TF_CAST_DISPATCH_X86
+  static const BFloat16ToFloatFn fn = PickBFloat16ToFloat();
+  if (fn == nullptr) return false;
+  fn(src, dst, n);
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace internal
+}  // namespace tensorflow
@@ -0,0 +1,49 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_KERNELS_CAST_OP_DISPATCH_H_
+#define TENSORFLOW_CORE_KERNELS_CAST_OP_DISPATCH_H_
+
+#include <cstdint>
+
+#include "tensorflow/core/framework/bfloat16.h"
+
+namespace tensorflow {
+namespace internal {
+
+// Runtime-dispatched bulk conversion routines for the hottest `Cast`
+// dtype pairs.
+//
+// TensorFlow binaries are typically built for an AVX2 baseline, which pins
+// Eigen's compile-time ISA selection below what recent server CPUs support.
+// The routines below are compiled with per-function target attributes and
+// selected at runtime via `port::TestCPUFeature`, so a single binary uses
+// AVX-512 (and AVX512-BF16 where available) conversion instructions on
+// hardware that has them.
+//
+// Each routine returns true if a runtime-dispatched implementation handled
+// the conversion and false if the caller should fall back to the generic
+// Eigen path (non-x86 builds, old hardware, or when disabled via the
+// `TF_CAST_RUNTIME_DISPATCH` environment variable). Calling with `n == 0`
+// performs no work and only reports availability, which lets callers probe
+// before sharding a large conversion across threads. Conversions round to
+// nearest-even, matching Eigen's behavior.
+bool TryBulkCastFloatToBFloat16(const float* src, bfloat16* dst, int64_t n);
+bool TryBulkCastBFloat16ToFloat(const bfloat16* src, float* dst, int64_t n);
+
+}  // namespace internal
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_KERNELS_CAST_OP_DISPATCH_H_
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/cast_op_impl.h"
 
+#include "tensorflow/core/kernels/cast_op_dispatch.h"
 #include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
@@ -23,6 +24,27 @@ typedef Eigen::ThreadPoolDevice CPUDevice;
 typedef Eigen::GpuDevice GPUDevice;
 
 CastFunctorType GetCpuCastFromBfloat(DataType dst_dtype) {
+  if (dst_dtype == DT_FLOAT) {
+    return [](OpKernelContext* ctx, const Tensor& inp, Tensor* out,
+              bool truncate) {
+      // Widening to float is exact, so `truncate` is a no-op and the
+      // runtime-dispatched (e.g. AVX-512) path can serve both modes.
+      if (internal::TryBulkCastBFloat16ToFloat(nullptr, nullptr, 0)) {
+        const bfloat16* src = inp.flat<bfloat16>().data();
+        float* dst = out->flat<float>().data();
+        auto* workers = ctx->device()->tensorflow_cpu_worker_threads();
+        Shard(workers->num_threads, workers->workers, inp.NumElements(),
+              /*cost_per_unit=*/2, [src, dst](int64_t start, int64_t end) {
+                internal::TryBulkCastBFloat16ToFloat(src + start, dst + start,
+                                                     end - start);
+              });
+        return;
+      }
+      functor::CastFunctor<CPUDevice, float, bfloat16> func;
+      func(ctx->eigen_device<CPUDevice>(), out->flat<float>(),
+           inp.flat<bfloat16>(), truncate);
+    };
+  }
   CURRY_TYPES3(CAST_CASE, CPUDevice, bfloat16);
   CAST_CASE(CPUDevice, bfloat16, float8_e5m2);
   CAST_CASE(CPUDevice, bfloat16, float8_e4m3fn);
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/cast_op_impl.h"
 
+#include "tensorflow/core/kernels/cast_op_dispatch.h"
 #include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
@@ -23,6 +24,28 @@ typedef Eigen::ThreadPoolDevice CPUDevice;
 typedef Eigen::GpuDevice GPUDevice;
 
 CastFunctorType GetCpuCastFromFloat(DataType dst_dtype) {
+  if (dst_dtype == DT_BFLOAT16) {
+    return [](OpKernelContext* ctx, const Tensor& inp, Tensor* out,
+              bool truncate) {
+      // Probe for a runtime-dispatched (e.g. AVX-512) conversion; `truncate`
+      // requires round-toward-zero, which only the Eigen path implements.
+      if (!truncate &&
+          internal::TryBulkCastFloatToBFloat16(nullptr, nullptr, 0)) {
+        const float* src = inp.flat<float>().data();
+        bfloat16* dst = out->flat<bfloat16>().data();
+        auto* workers = ctx->device()->tensorflow_cpu_worker_threads();
+        Shard(workers->num_threads, workers->workers, inp.NumElements(),
+              /*cost_per_unit=*/2, [src, dst](int64_t start, int64_t end) {
+                internal::TryBulkCastFloatToBFloat16(src + start, dst + start,
+                                                     end - start);
+              });
+        return;
+      }
+      functor::CastFunctor<CPUDevice, bfloat16, float> func;
+      func(ctx->eigen_device<CPUDevice>(), out->flat<bfloat16>(),
+           inp.flat<float>(), truncate);
+    };
+  }
   CURRY_TYPES3(CAST_CASE, CPUDevice, float);
   CAST_CASE(CPUDevice, float, float8_e5m2);
   CAST_CASE(CPUDevice, float, float8_e4m3fn);
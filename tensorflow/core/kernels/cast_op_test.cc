@@ -14,6 +14,8 @@ limitations under the License.
 ==============================================================================*/
 
 #include <cstdint>
+#include <limits>
+#include <vector>
 
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
 #include "tensorflow/core/framework/fake_input.h"
@@ -158,6 +160,43 @@ TEST_CAST(uint4, uint4)
 
 // TODO(wicke): check conversions from/to bool, and bfloat16
 
+// Exercises the bulk float <-> bfloat16 conversions with enough elements to
+// cover both the full-width vector loop and the masked tail of the
+// runtime-dispatched implementations, including round-to-nearest-even.
+TEST_F(CastOpTest, BulkFloatToBFloat16) {
+  MakeOp(DT_FLOAT, DT_BFLOAT16, /*trunc=*/false);
+  constexpr int kNumElements = 37;
+  std::vector<float> values(kNumElements);
+  for (int i = 0; i < kNumElements; ++i) {
+    values[i] = 0.1f * i - 1.5f;
+  }
+  values[20] = std::numeric_limits<float>::infinity();
+  values[21] = -std::numeric_limits<float>::infinity();
+  AddInputFromArray<float>(TensorShape({kNumElements}), values);
+  TF_ASSERT_OK(RunOpKernel());
+  Tensor expected(allocator(), DT_BFLOAT16, TensorShape({kNumElements}));
+  for (int i = 0; i < kNumElements; ++i) {
+    expected.flat<bfloat16>()(i) = static_cast<bfloat16>(values[i]);
+  }
+  test::ExpectTensorEqual<bfloat16>(expected, *GetOutput(0));
+}
+
+TEST_F(CastOpTest, BulkBFloat16ToFloat) {
+  MakeOp(DT_BFLOAT16, DT_FLOAT, /*trunc=*/false);
+  constexpr int kNumElements = 37;
+  std::vector<bfloat16> values(kNumElements);
+  for (int i = 0; i < kNumElements; ++i) {
+    values[i] = static_cast<bfloat16>(0.25f * i - 3.0f);
+  }
+  AddInputFromArray<bfloat16>(TensorShape({kNumElements}), values);
+  TF_ASSERT_OK(RunOpKernel());
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({kNumElements}));
+  for (int i = 0; i < kNumElements; ++i) {
+    expected.flat<float>()(i) = static_cast<float>(values[i]);
+  }
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+}
+
 static void BM_cpu_float_int64(::testing::benchmark::State& state) {
   const int num = state.range(0);
   test::Benchmark("cpu", Cast<float, int64_t>(num), /*old_benchmark_api=*/false)
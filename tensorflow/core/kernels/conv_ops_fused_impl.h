@@ -52,7 +52,9 @@ limitations under the License.
 #include "tensorflow/core/kernels/conv_ops.h"
 #include "tensorflow/core/kernels/fused_eigen_output_kernels.h"
 #include "tensorflow/core/kernels/ops_util.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/profiler/lib/scoped_annotation.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/tensor_format.h"
 #include "tensorflow/core/util/use_cudnn.h"
 
@@ -306,6 +308,157 @@ struct LaunchFusedConv2DOp<CPUDevice, T> {
   }
 };
 
+// CPU-only implementation for bfloat16.  Eigen tensor contractions have no
+// vectorized bfloat16 kernels, and the fused output kernels are not defined
+// for the float accumulators used by SpatialConvolution<.., bfloat16>, so the
+// convolution, bias and activation all run in float and the result is cast
+// back to bfloat16 at the end (matching the float32 accumulation of the
+// unfused bfloat16 kernel).
+//
+// The filter would normally have to be converted to float on every call.
+// When TF_FUSED_CONV2D_BF16_WEIGHT_CACHE=1 the launcher caches the converted
+// filter, keyed on the identity of the filter buffer, so steady-state calls
+// skip the conversion entirely.  The cache assumes the filter buffer is never
+// mutated in place, which holds for serving graphs where the filter is a
+// constant, but not necessarily for training, hence the opt-in.
+template <>
+struct LaunchFusedConv2DOp<CPUDevice, Eigen::bfloat16> {
+  void operator()(OpKernelContext* context, bool use_cudnn,
+                  bool cudnn_use_autotune, const Tensor& input,
+                  const Tensor& filter, const FusedComputationType fusion,
+                  const FusedComputationArgs& fusion_args,
+                  const Conv2DParameters& params,
+                  const Conv2DDimensions& dimensions, Tensor* output) {
+    OP_REQUIRES(context, dimensions.in_depth == filter.dim_size(2),
+                errors::Unimplemented("Fused conv implementation does not "
+                                      "support grouped convolutions for now."));
+    OP_REQUIRES(context, params.data_format == FORMAT_NHWC,
+                errors::Unimplemented("Fused conv implementation only supports "
+                                      "NHWC tensor format for now."));
+    // FusedBatchNorm is folded into the filter and bias by Grappler in
+    // inference graphs, so only the BiasAdd based fusions are supported here.
+    OP_REQUIRES(context, BiasAddArgs<float>::IsSupported(fusion),
+                errors::Unimplemented("Fused conv implementation with bfloat16 "
+                                      "only supports BiasAdd based fusions on "
+                                      "CPU."));
+
+    const CPUDevice& d = context->eigen_device<CPUDevice>();
+
+    Tensor input_fp32;
+    OP_REQUIRES_OK(context,
+                   context->allocate_temp(DT_FLOAT, input.shape(), &input_fp32));
+    input_fp32.flat<float>().device(d) =
+        input.flat<Eigen::bfloat16>().template cast<float>();
+
+    Tensor filter_fp32;
+    OP_REQUIRES_OK(context, GetFloatFilter(context, filter, &filter_fp32));
+
+    // Bias of the following dimensions: [ output_depth ]
+    const Tensor& bias = context->input(2);
+    OP_REQUIRES(context, bias.dims() == 1,
+                errors::InvalidArgument("bias must be 1-dimensional",
+                                        bias.shape().DebugString()));
+    Tensor bias_fp32;
+    OP_REQUIRES_OK(context,
+                   context->allocate_temp(DT_FLOAT, bias.shape(), &bias_fp32));
+    bias_fp32.flat<float>().device(d) =
+        bias.flat<Eigen::bfloat16>().template cast<float>();
+
+    BiasAddArgs<float> bias_add_args;
+    bias_add_args.bias_add_data = bias_fp32.flat<float>().data();
+    if (fusion == FusedComputationType::kBiasAddWithLeakyRelu) {
+      bias_add_args.leakyrelu_alpha = fusion_args.leakyrelu_alpha;
+    }
+
+    Tensor output_fp32;
+    OP_REQUIRES_OK(context, context->allocate_temp(DT_FLOAT, output->shape(),
+                                                   &output_fp32));
+
+    LaunchFusedConv2DWithOutputKernel<float> conv2d(
+        dimensions.stride_rows, dimensions.stride_cols,
+        dimensions.dilation_rows, dimensions.dilation_cols, params.padding,
+        params.explicit_paddings);
+
+    switch (fusion) {
+      case FusedComputationType::kBiasAdd:
+        conv2d(WithBiasAdd<float>(bias_add_args), context, input_fp32,
+               filter_fp32, &output_fp32);
+        break;
+      case FusedComputationType::kBiasAddWithRelu:
+        conv2d(WithBiasAddAndRelu<float>(bias_add_args), context, input_fp32,
+               filter_fp32, &output_fp32);
+        break;
+      case FusedComputationType::kBiasAddWithRelu6:
+        conv2d(WithBiasAddAndRelu6<float>(bias_add_args), context, input_fp32,
+               filter_fp32, &output_fp32);
+        break;
+      case FusedComputationType::kBiasAddWithLeakyRelu:
+        conv2d(WithBiasAddAndLeakyRelu<float>(bias_add_args), context,
+               input_fp32, filter_fp32, &output_fp32);
+        break;
+      case FusedComputationType::kBiasAddWithElu:
+        conv2d(WithBiasAddAndElu<float>(bias_add_args), context, input_fp32,
+               filter_fp32, &output_fp32);
+        break;
+      default:
+        OP_REQUIRES_OK(context, errors::Internal("Fusion type is unsupported"));
+        break;
+    }
+
+    output->flat<Eigen::bfloat16>().device(d) =
+        output_fp32.flat<float>().template cast<Eigen::bfloat16>();
+  }
+
+ private:
+  // Converts the bfloat16 filter to float.  With weight caching enabled the
+  // cached conversion is reused when `filter` aliases the buffer seen on the
+  // previous call; a reference to the bfloat16 filter is retained so that its
+  // buffer cannot be recycled for another tensor while the cache is alive.
+  Status GetFloatFilter(OpKernelContext* context, const Tensor& filter,
+                        Tensor* filter_fp32) {
+    const CPUDevice& d = context->eigen_device<CPUDevice>();
+    if (!WeightCacheEnabled()) {
+      TF_RETURN_IF_ERROR(
+          context->allocate_temp(DT_FLOAT, filter.shape(), filter_fp32));
+      filter_fp32->flat<float>().device(d) =
+          filter.flat<Eigen::bfloat16>().template cast<float>();
+      return absl::OkStatus();
+    }
+
+    mutex_lock lock(mu_);
+    if (cached_filter_fp32_.NumElements() > 0 &&
+        cached_filter_.tensor_data().data() == filter.tensor_data().data() &&
+        cached_filter_.shape() == filter.shape()) {
+      *filter_fp32 = cached_filter_fp32_;
+      return absl::OkStatus();
+    }
+    TF_RETURN_IF_ERROR(
+        context->allocate_temp(DT_FLOAT, filter.shape(), filter_fp32));
+    filter_fp32->flat<float>().device(d) =
+        filter.flat<Eigen::bfloat16>().template cast<float>();
+    cached_filter_ = filter;
+    cached_filter_fp32_ = *filter_fp32;
+    return absl::OkStatus();
+  }
+
+  static bool WeightCacheEnabled() {
+    static const bool cache_enabled = [] {
+      bool enabled = false;
+      Status status = ReadBoolFromEnvVar("TF_FUSED_CONV2D_BF16_WEIGHT_CACHE",
+                                         /*default_val=*/false, &enabled);
+      if (!status.ok()) {
+        LOG(ERROR) << status.message();
+      }
+      return enabled;
+    }();
+    return cache_enabled;
+  }
+
+  mutex mu_;
+  Tensor cached_filter_ TF_GUARDED_BY(mu_);
+  Tensor cached_filter_fp32_ TF_GUARDED_BY(mu_);
+};
+
 template <>
 struct LaunchFusedConv2DOp<CPUDevice, int8>;
 
@@ -791,10 +944,9 @@ class FusedConv2DOp : public OpKernel {
       return;
     }
 
-    LaunchFusedConv2DOp<Device, T>()(context, use_cudnn_, cudnn_use_autotune_,
-                                     input, filter, fused_computation_,
-                                     fused_computation_args_, params_,
-                                     dimensions, output);
+    launcher_(context, use_cudnn_, cudnn_use_autotune_, input, filter,
+              fused_computation_, fused_computation_args_, params_, dimensions,
+              output);
   }
 
  private:
@@ -805,6 +957,11 @@ class FusedConv2DOp : public OpKernel {
   FusedComputationType fused_computation_ = FusedComputationType::kUndefined;
   FusedComputationArgs fused_computation_args_;
 
+  // The launcher is a member (rather than constructed per Compute call) so
+  // that launchers with state, e.g. the bfloat16 weight cache, persist across
+  // calls.
+  LaunchFusedConv2DOp<Device, T> launcher_;
+
   FusedConv2DOp(const FusedConv2DOp&) = delete;
   void operator=(const FusedConv2DOp&) = delete;
 };
@@ -27,22 +27,12 @@ limitations under the License.
 
 namespace tensorflow {
 
-// If we're using the alternative GEMM-based implementation of Conv2D for the
-// CPU implementation, don't register this EigenTensor-based version.
-#if !defined(USE_GEMM_FOR_CONV)
-TF_CALL_int8(REGISTER_FUSED_CPU_CONV2D);
-TF_CALL_qint8(REGISTER_FUSED_CPU_CONV2D);
-#endif  // !USE_GEMM_FOR_CONV
-
 #if GOOGLE_CUDA
 
 namespace functor {
 DECLARE_FUNCTOR_GPU_SPEC(int32);
 }  // namespace functor
 
-TF_CALL_int8(REGISTER_FUSED_GPU_CONV2D);
-TF_CALL_qint8(REGISTER_FUSED_GPU_CONV2D);
-
 #endif  // GOOGLE_CUDA
 
 template <typename T>
@@ -731,4 +721,19 @@ struct LaunchFusedConv2DOp<GPUDevice, qint8>
 
 #endif  // GOOGLE_CUDA
 
+// Kernel registrations come after the launcher specializations above, because
+// instantiating FusedConv2DOp requires the launcher to be a complete type.
+
+// If we're using the alternative GEMM-based implementation of Conv2D for the
+// CPU implementation, don't register this EigenTensor-based version.
+#if !defined(USE_GEMM_FOR_CONV)
+TF_CALL_int8(REGISTER_FUSED_CPU_CONV2D);
+TF_CALL_qint8(REGISTER_FUSED_CPU_CONV2D);
+#endif  // !USE_GEMM_FOR_CONV
+
+#if GOOGLE_CUDA
+TF_CALL_int8(REGISTER_FUSED_GPU_CONV2D);
+TF_CALL_qint8(REGISTER_FUSED_GPU_CONV2D);
+#endif  // GOOGLE_CUDA
+
 }  // namespace tensorflow
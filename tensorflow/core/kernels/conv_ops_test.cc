@@ -1361,5 +1361,45 @@ using FusedBatchNormDataTypes = ::testing::Types<float>;
 INSTANTIATE_TYPED_TEST_SUITE_P(Test, FusedConv2DWithBatchNormOpTest,
                                FusedBatchNormDataTypes);
 
+// The bfloat16 CPU kernel runs the convolution, bias and activation with
+// float accumulation and casts back to bfloat16 at the end.  The values below
+// are all exactly representable in bfloat16, so the output can be compared
+// exactly.
+class FusedConv2DBfloat16OpTest : public OpsTestBase {
+ protected:
+  void MakeFusedConv2DOp() {
+    TF_EXPECT_OK(NodeDefBuilder("fused_conv_op", "_FusedConv2D")
+                     .Input(FakeInput(DT_BFLOAT16))
+                     .Input(FakeInput(DT_BFLOAT16))
+                     .Input(FakeInput({DT_BFLOAT16}))
+                     .Input(FakeInput(0, DT_FLOAT))
+                     .Attr("T", DT_BFLOAT16)
+                     .Attr("num_args", 1)
+                     .Attr("strides", {1, 1, 1, 1})
+                     .Attr("padding", "SAME")
+                     .Attr("fused_ops", {"BiasAdd", "Relu"})
+                     .Finalize(node_def()));
+    TF_EXPECT_OK(InitOp());
+  }
+};
+
+TEST_F(FusedConv2DBfloat16OpTest, OneByOneConvolutionWithBiasAndRelu) {
+  MakeFusedConv2DOp();
+
+  // out = Relu(in * 2 + 0.5)
+  AddInputFromArray<bfloat16>(
+      TensorShape({1, 2, 2, 1}),
+      {bfloat16(-1.0f), bfloat16(0.25f), bfloat16(0.5f), bfloat16(1.0f)});
+  AddInputFromArray<bfloat16>(TensorShape({1, 1, 1, 1}), {bfloat16(2.0f)});
+  AddInputFromArray<bfloat16>(TensorShape({1}), {bfloat16(0.5f)});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_BFLOAT16, TensorShape({1, 2, 2, 1}));
+  test::FillValues<bfloat16>(
+      &expected,
+      {bfloat16(0.0f), bfloat16(1.0f), bfloat16(1.5f), bfloat16(2.5f)});
+  test::ExpectTensorEqual<bfloat16>(expected, *GetOutput(0));
+}
+
 #endif  // TENSORFLOW_USE_ROCM
 }  // namespace tensorflow
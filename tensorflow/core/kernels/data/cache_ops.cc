@@ -14,6 +14,11 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/cache_ops.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/data/compression_utils.h"
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
@@ -22,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/lib/random/philox_random.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/lib/random/random_distributions.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -29,6 +35,42 @@ namespace {
 
 constexpr char kMemoryCache[] = "MemoryCache";
 
+// Whether to store completed cache elements in compressed form.
+bool CacheCompressionEnabled() {
+  static const bool enabled = [] {
+    bool result = false;
+    Status s = ReadBoolFromEnvVar("TF_DATA_CACHE_COMPRESS",
+                                  /*default_val=*/false, &result);
+    if (!s.ok()) {
+      LOG(ERROR) << s;
+    }
+    return result;
+  }();
+  return enabled;
+}
+
+// The maximum number of recently read elements to keep in decompressed form.
+int64_t CacheCompressionHotElements() {
+  static const int64_t hot_elements = [] {
+    int64_t result = 128;
+    Status s = ReadInt64FromEnvVar("TF_DATA_CACHE_COMPRESS_HOT_ELEMENTS",
+                                   /*default_val=*/128, &result);
+    if (!s.ok()) {
+      LOG(ERROR) << s;
+    }
+    return result;
+  }();
+  return hot_elements;
+}
+
+size_t TotalBytes(const std::vector<Tensor>& element) {
+  size_t bytes = 0;
+  for (const Tensor& t : element) {
+    bytes += t.TotalBytes();
+  }
+  return bytes;
+}
+
 }  // namespace
 
 string MemoryCacheManager::DebugString() const { return kMemoryCache; }
@@ -38,7 +80,37 @@ void MemoryCache::Complete(std::vector<std::vector<Tensor>>&& cache) {
   if (!completed_) {
     cache_ = std::move(cache);
     completed_ = true;
+    if (CacheCompressionEnabled()) {
+      CompressLocked();
+    }
+  }
+}
+
+void MemoryCache::CompressLocked() {
+  size_t uncompressed_bytes = 0;
+  size_t compressed_bytes = 0;
+  compressed_cache_.resize(cache_.size());
+  for (size_t i = 0; i < cache_.size(); ++i) {
+    auto compressed = std::make_unique<CompressedElement>();
+    Status s = CompressElement(cache_[i], compressed.get());
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to compress cached element " << i
+                   << "; storing it uncompressed: " << s;
+      continue;
+    }
+    size_t element_bytes = TotalBytes(cache_[i]);
+    if (compressed->ByteSizeLong() >= element_bytes) {
+      // The element does not benefit from compression; keep it uncompressed.
+      continue;
+    }
+    uncompressed_bytes += element_bytes;
+    compressed_bytes += compressed->ByteSizeLong();
+    compressed_cache_[i] = std::move(compressed);
+    cache_[i].clear();
   }
+  VLOG(2) << "Compressed memory cache of " << cache_.size() << " elements ("
+          << uncompressed_bytes << " bytes down to " << compressed_bytes
+          << " bytes).";
 }
 
 bool MemoryCache::IsCompleted() {
@@ -46,26 +118,81 @@ bool MemoryCache::IsCompleted() {
   return completed_;
 }
 
+bool MemoryCache::IsCompressed() {
+  tf_shared_lock l(mu_);
+  return !compressed_cache_.empty();
+}
+
 void MemoryCache::Reset() {
   mutex_lock l(mu_);
   completed_ = false;
   cache_.clear();
+  compressed_cache_.clear();
+  hot_lru_.clear();
+  hot_elements_.clear();
 }
 
-const std::vector<Tensor>& MemoryCache::at(int64_t index) {
-  tf_shared_lock l(mu_);
-  DCHECK(index < cache_.size());
-  return cache_[index];
+Status MemoryCache::Get(int64_t index, std::vector<Tensor>* element) {
+  {
+    tf_shared_lock l(mu_);
+    DCHECK(index < cache_.size());
+    if (compressed_cache_.empty() || compressed_cache_[index] == nullptr) {
+      *element = cache_[index];
+      return absl::OkStatus();
+    }
+  }
+  // The element is stored compressed. Take an exclusive lock so that the hot
+  // set can be updated.
+  mutex_lock l(mu_);
+  if (compressed_cache_.empty() || compressed_cache_[index] == nullptr) {
+    // The cache was reset or recompleted between the two locks.
+    DCHECK(index < cache_.size());
+    *element = cache_[index];
+    return absl::OkStatus();
+  }
+  auto it = hot_elements_.find(index);
+  if (it != hot_elements_.end()) {
+    hot_lru_.splice(hot_lru_.begin(), hot_lru_, it->second.first);
+    *element = it->second.second;
+    return absl::OkStatus();
+  }
+  element->clear();
+  TF_RETURN_IF_ERROR(UncompressElement(*compressed_cache_[index], element));
+  int64_t hot_budget = CacheCompressionHotElements();
+  if (hot_budget > 0) {
+    hot_lru_.push_front(index);
+    hot_elements_[index] = std::make_pair(hot_lru_.begin(), *element);
+    while (hot_elements_.size() > static_cast<size_t>(hot_budget)) {
+      hot_elements_.erase(hot_lru_.back());
+      hot_lru_.pop_back();
+    }
+  }
+  return absl::OkStatus();
 }
 
-size_t MemoryCache::size() {
+Status MemoryCache::GetAll(std::vector<std::vector<Tensor>>* elements) {
   tf_shared_lock l(mu_);
-  return cache_.size();
+  if (compressed_cache_.empty()) {
+    *elements = cache_;
+    return absl::OkStatus();
+  }
+  elements->clear();
+  elements->reserve(cache_.size());
+  for (size_t i = 0; i < cache_.size(); ++i) {
+    std::vector<Tensor> element;
+    if (compressed_cache_[i] != nullptr) {
+      TF_RETURN_IF_ERROR(UncompressElement(*compressed_cache_[i], &element));
+    } else {
+      element = cache_[i];
+    }
+    elements->push_back(std::move(element));
+  }
+  return absl::OkStatus();
 }
 
-const std::vector<std::vector<Tensor>>& MemoryCache::data() {
+size_t MemoryCache::size() {
   tf_shared_lock l(mu_);
-  return cache_;
+  return cache_.size();
 }
 
 AnonymousMemoryCacheHandleOp::AnonymousMemoryCacheHandleOp(
@@ -16,7 +16,15 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_KERNELS_DATA_CACHE_OPS_H_
 #define TENSORFLOW_CORE_KERNELS_DATA_CACHE_OPS_H_
 
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/data/dataset_utils.h"
+#include "tensorflow/core/framework/dataset.pb.h"
 #include "tensorflow/core/framework/resource_mgr.h"
 
 namespace tensorflow {
@@ -27,6 +35,14 @@ namespace data {
 // The expected use is that a single `MemoryWriterIterator` populates the
 // cache with dataset elements. Once all elements are cached, the cache can
 // be used by one or more `MemoryReaderIterator`s.
+//
+// If the `TF_DATA_CACHE_COMPRESS` environment variable is set to true,
+// completed cache elements are stored as `CompressedElement` protos and
+// decompressed on read. Elements that do not shrink under compression are
+// kept uncompressed, and a bounded LRU set of recently read ("hot") elements
+// is kept in decompressed form to avoid repeatedly paying the decompression
+// cost for them. The size of the hot set is controlled by the
+// `TF_DATA_CACHE_COMPRESS_HOT_ELEMENTS` environment variable.
 class MemoryCache {
  public:
   MemoryCache() = default;
@@ -37,24 +53,46 @@ class MemoryCache {
   // Returns whether the cache is completed.
   bool IsCompleted();
 
+  // Returns whether any elements of the completed cache are stored in
+  // compressed form.
+  bool IsCompressed();
+
   // Resets the cache.
   void Reset();
 
-  // Returns the element at the given index.
-  const std::vector<Tensor>& at(int64_t index);
+  // Stores a copy of the element at the given index in `element`,
+  // decompressing it if it is stored compressed.
+  Status Get(int64_t index, std::vector<Tensor>* element);
+
+  // Stores a copy of the cache's elements in `elements`, decompressing any
+  // elements stored compressed.
+  Status GetAll(std::vector<std::vector<Tensor>>* elements);
 
   // Returns the size of the cache.
   size_t size();
 
-  // Returns a reference to the cache's data. The returned reference will be
-  // invalidated by any call to Reset().
-  const std::vector<std::vector<Tensor>>& data();
-
  private:
+  // Compresses the elements of `cache_`, keeping elements that do not shrink
+  // under compression (or fail to compress) in uncompressed form.
+  void CompressLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   mutex mu_;
   // Determines whether all elements of the dataset have been cached.
   bool completed_ TF_GUARDED_BY(mu_) = false;
   std::vector<std::vector<Tensor>> cache_ TF_GUARDED_BY(mu_);
+  // When compression is enabled, `compressed_cache_` is sized to match
+  // `cache_` and holds the compressed representation of each element, or
+  // nullptr for elements kept uncompressed in `cache_`. Empty when
+  // compression is disabled.
+  std::vector<std::unique_ptr<CompressedElement>> compressed_cache_
+      TF_GUARDED_BY(mu_);
+  // Recently read elements kept in decompressed form, in LRU order (most
+  // recently used first), along with their decompressed tensors.
+  std::list<int64_t> hot_lru_ TF_GUARDED_BY(mu_);
+  absl::flat_hash_map<int64_t,
+                      std::pair<std::list<int64_t>::iterator,
+                                std::vector<Tensor>>>
+      hot_elements_ TF_GUARDED_BY(mu_);
 };
 
 // A resource wrapping a shared instance of a memory cache.
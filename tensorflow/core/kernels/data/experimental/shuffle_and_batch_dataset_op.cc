@@ -0,0 +1,349 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/kernels/data/experimental/shuffle_and_batch_dataset_op.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/data/dataset_utils.h"
+#include "tensorflow/core/data/name_utils.h"
+#include "tensorflow/core/data/serialization_utils.h"
+#include "tensorflow/core/framework/dataset.h"
+#include "tensorflow/core/framework/partial_tensor_shape.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/random/philox_random.h"
+#include "tensorflow/core/lib/random/random.h"
+#include "tensorflow/core/lib/random/random_distributions.h"
+#include "tensorflow/core/util/batch_util.h"
+
+namespace tensorflow {
+namespace data {
+namespace experimental {
+
+/* static */ constexpr const char* const ShuffleAndBatchDatasetOp::kDatasetType;
+/* static */ constexpr const char* const
+    ShuffleAndBatchDatasetOp::kInputDataset;
+/* static */ constexpr const char* const ShuffleAndBatchDatasetOp::kBufferSize;
+/* static */ constexpr const char* const ShuffleAndBatchDatasetOp::kBatchSize;
+/* static */ constexpr const char* const ShuffleAndBatchDatasetOp::kSeed;
+/* static */ constexpr const char* const ShuffleAndBatchDatasetOp::kSeed2;
+/* static */ constexpr const char* const
+    ShuffleAndBatchDatasetOp::kDropRemainder;
+/* static */ constexpr const char* const ShuffleAndBatchDatasetOp::kOutputTypes;
+/* static */ constexpr const char* const
+    ShuffleAndBatchDatasetOp::kOutputShapes;
+
+namespace {
+
+constexpr char kNumRandomSamples[] = "num_random_samples";
+constexpr char kInputImplEmpty[] = "input_impl_empty";
+constexpr char kBuffer[] = "buffer";
+
+}  // namespace
+
+class ShuffleAndBatchDatasetOp::Dataset : public DatasetBase {
+ public:
+  Dataset(OpKernelContext* ctx, const DatasetBase* input, int64_t buffer_size,
+          int64_t batch_size, int64_t seed, int64_t seed2, bool drop_remainder)
+      : DatasetBase(DatasetContext(ctx)),
+        input_(input),
+        buffer_size_(buffer_size),
+        batch_size_(batch_size),
+        seeds_(seed, seed2),
+        drop_remainder_(drop_remainder) {
+    input_->Ref();
+    const auto& input_shapes = input_->output_shapes();
+    output_shapes_.reserve(input_shapes.size());
+    for (const auto& input_shape : input_shapes) {
+      if (drop_remainder_ || input_->Cardinality() == kInfiniteCardinality) {
+        output_shapes_.emplace_back(
+            PartialTensorShape({batch_size_}).Concatenate(input_shape));
+      } else {
+        output_shapes_.emplace_back(
+            PartialTensorShape({-1}).Concatenate(input_shape));
+      }
+    }
+  }
+
+  ~Dataset() override { input_->Unref(); }
+
+  std::unique_ptr<IteratorBase> MakeIteratorInternal(
+      const string& prefix) const override {
+    return std::make_unique<Iterator>(
+        Iterator::Params{this,
+                         name_utils::IteratorPrefix(kDatasetType, prefix)});
+  }
+
+  const DataTypeVector& output_dtypes() const override {
+    return input_->output_dtypes();
+  }
+
+  const std::vector<PartialTensorShape>& output_shapes() const override {
+    return output_shapes_;
+  }
+
+  string DebugString() const override {
+    name_utils::DatasetDebugStringParams params;
+    params.set_args(buffer_size_, batch_size_);
+    return name_utils::DatasetDebugString(kDatasetType, params);
+  }
+
+  int64_t CardinalityInternal(CardinalityOptions options) const override {
+    int64_t n = input_->Cardinality(options);
+    if (n == kInfiniteCardinality || n == kUnknownCardinality) {
+      return n;
+    }
+    return n / batch_size_ + (n % batch_size_ == 0 || drop_remainder_ ? 0 : 1);
+  }
+
+  Status InputDatasets(std::vector<const DatasetBase*>* inputs) const override {
+    inputs->push_back(input_);
+    return absl::OkStatus();
+  }
+
+  Status CheckExternalState() const override {
+    return input_->CheckExternalState();
+  }
+
+ protected:
+  Status AsGraphDefInternal(SerializationContext* ctx,
+                            DatasetGraphDefBuilder* b,
+                            Node** output) const override {
+    Node* input_graph_node = nullptr;
+    TF_RETURN_IF_ERROR(b->AddInputDataset(ctx, input_, &input_graph_node));
+    Node* buffer_size = nullptr;
+    Node* batch_size = nullptr;
+    Node* seed = nullptr;
+    Node* seed2 = nullptr;
+    Node* drop_remainder = nullptr;
+    TF_RETURN_IF_ERROR(b->AddScalar(buffer_size_, &buffer_size));
+    TF_RETURN_IF_ERROR(b->AddScalar(batch_size_, &batch_size));
+    TF_RETURN_IF_ERROR(b->AddScalar(seeds_.first, &seed));
+    TF_RETURN_IF_ERROR(b->AddScalar(seeds_.second, &seed2));
+    TF_RETURN_IF_ERROR(b->AddScalar(drop_remainder_, &drop_remainder));
+    TF_RETURN_IF_ERROR(
+        b->AddDataset(this,
+                      {input_graph_node, buffer_size, batch_size, seed, seed2,
+                       drop_remainder},
+                      output));
+    return absl::OkStatus();
+  }
+
+ private:
+  class Iterator : public DatasetIterator<Dataset> {
+   public:
+    explicit Iterator(const Params& params)
+        : DatasetIterator<Dataset>(params),
+          seeds_(MaybeOverrideSeeds(dataset()->seeds_)),
+          parent_generator_(seeds_.first, seeds_.second),
+          generator_(&parent_generator_) {}
+
+    Status Initialize(IteratorContext* ctx) override {
+      mutex_lock l(mu_);
+      buffer_.reserve(dataset()->buffer_size_);
+      return dataset()->input_->MakeIterator(ctx, this, prefix(),
+                                             &input_impl_);
+    }
+
+    Status GetNextInternal(IteratorContext* ctx,
+                           std::vector<Tensor>* out_tensors,
+                           bool* end_of_sequence) override {
+      mutex_lock l(mu_);
+      TF_RETURN_IF_ERROR(FillBuffer(ctx));
+      if (buffer_.empty()) {
+        *end_of_sequence = true;
+        return absl::OkStatus();
+      }
+      const int64_t batch_size = std::min<int64_t>(
+          dataset()->batch_size_, static_cast<int64_t>(buffer_.size()));
+      if (batch_size < dataset()->batch_size_ && dataset()->drop_remainder_) {
+        *end_of_sequence = true;
+        return absl::OkStatus();
+      }
+      out_tensors->clear();
+      for (int64_t i = 0; i < batch_size; ++i) {
+        // Sample an element uniformly from the shuffle buffer and compact
+        // the buffer with a swap-remove.
+        int64_t index = Random() % buffer_.size();
+        std::vector<Tensor> element = std::move(buffer_[index]);
+        if (static_cast<size_t>(index) != buffer_.size() - 1) {
+          buffer_[index] = std::move(buffer_.back());
+        }
+        buffer_.pop_back();
+        if (i == 0) {
+          // The first sampled element determines the component shapes;
+          // the batch components are allocated once, up front.
+          out_tensors->reserve(element.size());
+          for (size_t c = 0; c < element.size(); ++c) {
+            TensorShape batch_component_shape({batch_size});
+            batch_component_shape.AppendShape(element[c].shape());
+            out_tensors->emplace_back(ctx->allocator({}), element[c].dtype(),
+                                      batch_component_shape);
+            if (!out_tensors->back().IsInitialized()) {
+              return errors::ResourceExhausted(
+                  "Failed to allocate memory for the batch of component ", c);
+            }
+          }
+        }
+        // Copy (or, for variable-length components, move) the element
+        // straight into its final slot in the batch.
+        for (size_t c = 0; c < element.size(); ++c) {
+          TF_RETURN_IF_ERROR(batch_util::CopyElementToSlice(
+              std::move(element[c]), &out_tensors->at(c), i));
+        }
+        // Refill the vacated slot so subsequent draws for this batch still
+        // sample from a full shuffle window.
+        TF_RETURN_IF_ERROR(FillBuffer(ctx));
+      }
+      *end_of_sequence = false;
+      return absl::OkStatus();
+    }
+
+   protected:
+    std::shared_ptr<model::Node> CreateNode(
+        IteratorContext* ctx, model::Node::Args args) const override {
+      return model::MakeKnownRatioNode(std::move(args),
+                                       dataset()->batch_size_);
+    }
+
+    void ResetRngs() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      parent_generator_ = random::PhiloxRandom(seeds_.first, seeds_.second);
+      generator_ =
+          random::SingleSampleAdapter<random::PhiloxRandom>(&parent_generator_);
+      generator_.Skip(num_random_samples_);
+    }
+
+    Status SaveInternal(SerializationContext* ctx,
+                        IteratorStateWriter* writer) override {
+      mutex_lock l(mu_);
+      TF_RETURN_IF_ERROR(
+          writer->WriteScalar(full_name(kNumRandomSamples),
+                              num_random_samples_));
+      TF_RETURN_IF_ERROR(writer->WriteScalar(full_name(kSeed), seeds_.first));
+      TF_RETURN_IF_ERROR(writer->WriteScalar(full_name(kSeed2), seeds_.second));
+      if (input_impl_) {
+        TF_RETURN_IF_ERROR(SaveInput(ctx, writer, input_impl_));
+      } else {
+        TF_RETURN_IF_ERROR(
+            writer->WriteScalar(full_name(kInputImplEmpty), ""));
+      }
+      TF_RETURN_IF_ERROR(WriteElementsToCheckpoint(
+          writer, absl::StrCat(prefix(), "::", kBuffer), buffer_));
+      return absl::OkStatus();
+    }
+
+    Status RestoreInternal(IteratorContext* ctx,
+                           IteratorStateReader* reader) override {
+      mutex_lock l(mu_);
+      TF_RETURN_IF_ERROR(reader->ReadScalar(full_name(kNumRandomSamples),
+                                            &num_random_samples_));
+      int64_t seed;
+      TF_RETURN_IF_ERROR(reader->ReadScalar(full_name(kSeed), &seed));
+      int64_t seed2;
+      TF_RETURN_IF_ERROR(reader->ReadScalar(full_name(kSeed2), &seed2));
+      seeds_ = {seed, seed2};
+      ResetRngs();
+      if (!reader->Contains(full_name(kInputImplEmpty))) {
+        TF_RETURN_IF_ERROR(RestoreInput(ctx, reader, input_impl_));
+      } else {
+        input_impl_.reset();
+      }
+      TF_RETURN_IF_ERROR(ReadElementsFromCheckpoint(
+          ctx, reader, absl::StrCat(prefix(), "::", kBuffer), &buffer_));
+      return absl::OkStatus();
+    }
+
+   private:
+    // Tops the shuffle buffer up to `buffer_size` elements, or until the
+    // input is exhausted.
+    Status FillBuffer(IteratorContext* ctx) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      while (input_impl_ &&
+             buffer_.size() < static_cast<size_t>(dataset()->buffer_size_)) {
+        std::vector<Tensor> element;
+        bool end_of_input = false;
+        TF_RETURN_IF_ERROR(
+            input_impl_->GetNext(ctx, &element, &end_of_input));
+        if (end_of_input) {
+          input_impl_.reset();
+          break;
+        }
+        buffer_.push_back(std::move(element));
+      }
+      return absl::OkStatus();
+    }
+
+    random::SingleSampleAdapter<random::PhiloxRandom>::ResultType Random()
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      num_random_samples_++;
+      return generator_();
+    }
+
+    mutex mu_;
+    std::pair<int64_t, int64_t> seeds_ TF_GUARDED_BY(mu_);
+    std::unique_ptr<IteratorBase> input_impl_ TF_GUARDED_BY(mu_);
+    std::vector<std::vector<Tensor>> buffer_ TF_GUARDED_BY(mu_);
+    random::PhiloxRandom parent_generator_ TF_GUARDED_BY(mu_);
+    random::SingleSampleAdapter<random::PhiloxRandom> generator_
+        TF_GUARDED_BY(mu_);
+    int64_t num_random_samples_ TF_GUARDED_BY(mu_) = 0;
+  };
+
+  const DatasetBase* const input_;
+  const int64_t buffer_size_;
+  const int64_t batch_size_;
+  const std::pair<int64_t, int64_t> seeds_;
+  const bool drop_remainder_;
+  std::vector<PartialTensorShape> output_shapes_;
+};
+
+ShuffleAndBatchDatasetOp::ShuffleAndBatchDatasetOp(OpKernelConstruction* ctx)
+    : UnaryDatasetOpKernel(ctx) {}
+
+void ShuffleAndBatchDatasetOp::MakeDataset(OpKernelContext* ctx,
+                                           DatasetBase* input,
+                                           DatasetBase** output) {
+  int64_t buffer_size;
+  OP_REQUIRES_OK(ctx,
+                 ParseScalarArgument<int64_t>(ctx, kBufferSize, &buffer_size));
+  OP_REQUIRES(ctx, buffer_size > 0,
+              errors::InvalidArgument("buffer_size must be greater than zero."));
+  int64_t batch_size;
+  OP_REQUIRES_OK(ctx,
+                 ParseScalarArgument<int64_t>(ctx, kBatchSize, &batch_size));
+  OP_REQUIRES(ctx, batch_size > 0,
+              errors::InvalidArgument("batch_size must be greater than zero."));
+  int64_t seed;
+  OP_REQUIRES_OK(ctx, ParseScalarArgument<int64_t>(ctx, kSeed, &seed));
+  int64_t seed2;
+  OP_REQUIRES_OK(ctx, ParseScalarArgument<int64_t>(ctx, kSeed2, &seed2));
+  bool drop_remainder;
+  OP_REQUIRES_OK(
+      ctx, ParseScalarArgument<bool>(ctx, kDropRemainder, &drop_remainder));
+
+  *output = new Dataset(ctx, input, buffer_size, batch_size, seed, seed2,
+                        drop_remainder);
+}
+
+namespace {
+REGISTER_KERNEL_BUILDER(Name("ShuffleAndBatchDataset").Device(DEVICE_CPU),
+                        ShuffleAndBatchDatasetOp);
+}  // namespace
+}  // namespace experimental
+}  // namespace data
+}  // namespace tensorflow
@@ -0,0 +1,356 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/kernels/data/filter_map_dataset_op.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/function.h"
+#include "tensorflow/core/common_runtime/input_colocation_exemption_registry.h"
+#include "tensorflow/core/data/dataset_utils.h"
+#include "tensorflow/core/data/name_utils.h"
+#include "tensorflow/core/data/stats_utils.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/partial_tensor_shape.h"
+#include "tensorflow/core/framework/stats_aggregator.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/strings/str_util.h"
+
+namespace tensorflow {
+namespace data {
+
+// See documentation in ../../ops/dataset_ops.cc for a high-level
+// description of the following op.
+
+/* static */ constexpr const char* const FilterMapDatasetOp::kDatasetType;
+/* static */ constexpr const char* const FilterMapDatasetOp::kInputDataset;
+/* static */ constexpr const char* const
+    FilterMapDatasetOp::kPredicateOtherArguments;
+/* static */ constexpr const char* const
+    FilterMapDatasetOp::kMapFuncOtherArguments;
+/* static */ constexpr const char* const FilterMapDatasetOp::kPredicate;
+/* static */ constexpr const char* const FilterMapDatasetOp::kMapFunc;
+/* static */ constexpr const char* const
+    FilterMapDatasetOp::kTpredicateOtherArguments;
+/* static */ constexpr const char* const
+    FilterMapDatasetOp::kTmapFuncOtherArguments;
+/* static */ constexpr const char* const FilterMapDatasetOp::kOutputTypes;
+/* static */ constexpr const char* const FilterMapDatasetOp::kOutputShapes;
+
+constexpr char kInputImplEmpty[] = "input_impl_empty";
+constexpr char kFilteredElements[] = "filtered_elements";
+constexpr char kDroppedElements[] = "dropped_elements";
+
+class FilterMapDatasetOp::Dataset : public DatasetBase {
+ public:
+  Dataset(OpKernelContext* ctx, const DatasetBase* input,
+          std::unique_ptr<CapturedFunction> captured_predicate,
+          std::unique_ptr<CapturedFunction> captured_map_func,
+          const DataTypeVector& output_types,
+          const std::vector<PartialTensorShape>& output_shapes)
+      : DatasetBase(DatasetContext(ctx)),
+        input_(input),
+        captured_predicate_(std::move(captured_predicate)),
+        captured_map_func_(std::move(captured_map_func)),
+        output_types_(output_types),
+        output_shapes_(output_shapes) {
+    input_->Ref();
+  }
+
+  ~Dataset() override { input_->Unref(); }
+
+  std::unique_ptr<IteratorBase> MakeIteratorInternal(
+      const string& prefix) const override {
+    return std::make_unique<Iterator>(Iterator::Params{
+        this, name_utils::IteratorPrefix(kDatasetType, prefix)});
+  }
+
+  const DataTypeVector& output_dtypes() const override {
+    return output_types_;
+  }
+
+  const std::vector<PartialTensorShape>& output_shapes() const override {
+    return output_shapes_;
+  }
+
+  string DebugString() const override {
+    return name_utils::DatasetDebugString(kDatasetType);
+  }
+
+  Status InputDatasets(std::vector<const DatasetBase*>* inputs) const override {
+    inputs->push_back(input_);
+    return absl::OkStatus();
+  }
+
+  Status CheckExternalState() const override {
+    TF_RETURN_IF_ERROR(captured_predicate_->CheckExternalState());
+    TF_RETURN_IF_ERROR(captured_map_func_->CheckExternalState());
+    return input_->CheckExternalState();
+  }
+
+ protected:
+  Status AsGraphDefInternal(SerializationContext* ctx,
+                            DatasetGraphDefBuilder* b,
+                            Node** output) const override {
+    Node* input_graph_node;
+    TF_RETURN_IF_ERROR(b->AddInputDataset(ctx, input_, &input_graph_node));
+    std::vector<Node*> predicate_arguments;
+    DataTypeVector predicate_arguments_types;
+    TF_RETURN_IF_ERROR(captured_predicate_->AddToGraph(
+        ctx, b, &predicate_arguments, &predicate_arguments_types));
+    std::vector<Node*> map_func_arguments;
+    DataTypeVector map_func_arguments_types;
+    TF_RETURN_IF_ERROR(captured_map_func_->AddToGraph(
+        ctx, b, &map_func_arguments, &map_func_arguments_types));
+    AttrValue predicate;
+    b->BuildAttrValue(captured_predicate_->func(), &predicate);
+    AttrValue map_func;
+    b->BuildAttrValue(captured_map_func_->func(), &map_func);
+    AttrValue predicate_arguments_types_attr;
+    b->BuildAttrValue(predicate_arguments_types,
+                      &predicate_arguments_types_attr);
+    AttrValue map_func_arguments_types_attr;
+    b->BuildAttrValue(map_func_arguments_types, &map_func_arguments_types_attr);
+
+    TF_RETURN_IF_ERROR(b->AddDataset(
+        this, {{0, input_graph_node}},
+        {{1, predicate_arguments}, {2, map_func_arguments}},
+        {{kPredicate, predicate},
+         {kMapFunc, map_func},
+         {kTpredicateOtherArguments, predicate_arguments_types_attr},
+         {kTmapFuncOtherArguments, map_func_arguments_types_attr}},
+        output));
+    return absl::OkStatus();
+  }
+
+ private:
+  class Iterator : public DatasetIterator<Dataset> {
+   public:
+    explicit Iterator(const Params& params)
+        : DatasetIterator<Dataset>(params),
+          filtered_elements_(0),
+          dropped_elements_(0) {}
+
+    bool SymbolicCheckpointCompatible() const override { return true; }
+
+    Status Initialize(IteratorContext* ctx) override {
+      TF_RETURN_IF_ERROR(
+          dataset()->input_->MakeIterator(ctx, this, prefix(), &input_impl_));
+      TF_RETURN_IF_ERROR(dataset()->captured_predicate_->Instantiate(
+          ctx, &instantiated_predicate_));
+      return dataset()->captured_map_func_->Instantiate(
+          ctx, &instantiated_map_func_);
+    }
+
+    // NOTE: This method is thread-safe as long as `input_impl_` and the
+    // captured functions are thread-safe. However, if multiple threads enter
+    // this method, outputs may be observed in a non-deterministic order.
+    Status GetNextInternal(IteratorContext* ctx,
+                           std::vector<Tensor>* out_tensors,
+                           bool* end_of_sequence) override {
+      auto stats_aggregator = ctx->stats_aggregator();
+      bool matched;
+      do {
+        std::vector<Tensor> input_element;
+        {
+          tf_shared_lock l(mu_);
+          if (!input_impl_) {
+            *end_of_sequence = true;
+            return absl::OkStatus();
+          }
+          TF_RETURN_IF_ERROR(
+              input_impl_->GetNext(ctx, &input_element, end_of_sequence));
+        }
+        if (*end_of_sequence) {
+          mutex_lock l(mu_);
+          input_impl_.reset();
+          return absl::OkStatus();
+        }
+
+        std::vector<Tensor> predicate_result;
+        auto status = instantiated_predicate_->RunWithBorrowedArgs(
+            ctx, input_element, &predicate_result, model_node());
+        if (!status.ok()) {
+          return AddErrorContext(status);
+        }
+
+        if (predicate_result.size() != 1 ||
+            predicate_result[0].dtype() != DT_BOOL ||
+            predicate_result[0].NumElements() != 1) {
+          return errors::InvalidArgument(
+              "Filter predicate `predicate` must return a scalar bool.");
+        }
+        matched = predicate_result[0].scalar<bool>()();
+
+        if (!matched) {
+          // The map function is never invoked for rejected elements.
+          {
+            mutex_lock l(mu_);
+            dropped_elements_++;
+          }
+          if (stats_aggregator) {
+            mutex_lock l(mu_);
+            stats_aggregator->AddScalar(
+                stats_utils::DroppedElementsScalarName(dataset()->node_name()),
+                static_cast<float>(dropped_elements_), num_elements());
+
+            stats_aggregator->IncrementCounter(dataset()->node_name(),
+                                               stats_utils::kDroppedElements,
+                                               static_cast<float>(1));
+          }
+          continue;
+        }
+
+        {
+          mutex_lock l(mu_);
+          filtered_elements_++;
+        }
+        if (stats_aggregator) {
+          mutex_lock l(mu_);
+          stats_aggregator->AddScalar(
+              stats_utils::FilterdElementsScalarName(dataset()->node_name()),
+              static_cast<float>(filtered_elements_), num_elements());
+
+          stats_aggregator->IncrementCounter(dataset()->node_name(),
+                                             stats_utils::kFilteredElements,
+                                             static_cast<float>(1));
+        }
+        Status s = instantiated_map_func_->Run(ctx, std::move(input_element),
+                                               out_tensors, model_node());
+        if (errors::IsOutOfRange(s)) {
+          // `map_func` may deliberately raise `errors::OutOfRange` to
+          // indicate that we should terminate the iteration early.
+          *end_of_sequence = true;
+          return absl::OkStatus();
+        }
+        if (!s.ok()) {
+          return AddErrorContext(s);
+        }
+      } while (!matched);
+      *end_of_sequence = false;
+      return absl::OkStatus();
+    }
+
+   protected:
+    std::shared_ptr<model::Node> CreateNode(
+        IteratorContext* ctx, model::Node::Args args) const override {
+      return model::MakeUnknownRatioNode(std::move(args));
+    }
+
+    Status SaveInternal(SerializationContext* ctx,
+                        IteratorStateWriter* writer) override {
+      TF_RETURN_IF_ERROR(ctx->HandleCheckExternalStateStatus(
+          dataset()->captured_predicate_->CheckExternalState()));
+      TF_RETURN_IF_ERROR(ctx->HandleCheckExternalStateStatus(
+          dataset()->captured_map_func_->CheckExternalState()));
+      mutex_lock l(mu_);
+      TF_RETURN_IF_ERROR(writer->WriteScalar(
+          prefix(), kInputImplEmpty, static_cast<int64_t>(!input_impl_)));
+      if (input_impl_) {
+        TF_RETURN_IF_ERROR(SaveInput(ctx, writer, input_impl_));
+      }
+      TF_RETURN_IF_ERROR(
+          writer->WriteScalar(prefix(), kFilteredElements, filtered_elements_));
+      TF_RETURN_IF_ERROR(
+          writer->WriteScalar(prefix(), kDroppedElements, dropped_elements_));
+      return absl::OkStatus();
+    }
+
+    Status RestoreInternal(IteratorContext* ctx,
+                           IteratorStateReader* reader) override {
+      mutex_lock l(mu_);
+      int64_t input_empty;
+      TF_RETURN_IF_ERROR(
+          reader->ReadScalar(prefix(), kInputImplEmpty, &input_empty));
+      if (static_cast<bool>(input_empty)) {
+        input_impl_.reset();
+      } else {
+        TF_RETURN_IF_ERROR(RestoreInput(ctx, reader, input_impl_));
+      }
+      TF_RETURN_IF_ERROR(
+          reader->ReadScalar(prefix(), kFilteredElements, &filtered_elements_));
+      TF_RETURN_IF_ERROR(
+          reader->ReadScalar(prefix(), kDroppedElements, &dropped_elements_));
+      return absl::OkStatus();
+    }
+
+    data::TraceMeMetadata GetTraceMeMetadata() const override {
+      tf_shared_lock l(mu_);
+      data::TraceMeMetadata result;
+      result.push_back(std::make_pair(
+          "passed",
+          strings::Printf("%lld", static_cast<long long>(filtered_elements_))));
+      result.push_back(std::make_pair(
+          "filtered",
+          strings::Printf("%lld", static_cast<long long>(dropped_elements_))));
+      return result;
+    }
+
+   private:
+    mutable mutex mu_;
+    std::unique_ptr<IteratorBase> input_impl_ TF_GUARDED_BY(mu_);
+    int64_t filtered_elements_ TF_GUARDED_BY(mu_);
+    int64_t dropped_elements_ TF_GUARDED_BY(mu_);
+    std::unique_ptr<InstantiatedCapturedFunction> instantiated_predicate_;
+    std::unique_ptr<InstantiatedCapturedFunction> instantiated_map_func_;
+  };
+
+  const DatasetBase* const input_;
+  const std::unique_ptr<CapturedFunction> captured_predicate_;
+  const std::unique_ptr<CapturedFunction> captured_map_func_;
+  const DataTypeVector output_types_;
+  const std::vector<PartialTensorShape> output_shapes_;
+};
+
+FilterMapDatasetOp::FilterMapDatasetOp(OpKernelConstruction* ctx)
+    : UnaryDatasetOpKernel(ctx) {
+  OP_REQUIRES_OK(ctx, FunctionMetadata::Create(ctx, kPredicate, /*params=*/{},
+                                               &predicate_metadata_));
+  OP_REQUIRES(
+      ctx, predicate_metadata_->short_circuit_info().indices.size() <= 1,
+      errors::InvalidArgument(
+          "predicate function has more than one return value."));
+  OP_REQUIRES_OK(ctx, FunctionMetadata::Create(ctx, kMapFunc, /*params=*/{},
+                                               &map_func_metadata_));
+  OP_REQUIRES_OK(ctx, ctx->GetAttr(kOutputTypes, &output_types_));
+  OP_REQUIRES_OK(ctx, ctx->GetAttr(kOutputShapes, &output_shapes_));
+}
+
+void FilterMapDatasetOp::MakeDataset(OpKernelContext* ctx, DatasetBase* input,
+                                     DatasetBase** output) {
+  std::unique_ptr<CapturedFunction> captured_predicate;
+  OP_REQUIRES_OK(ctx, CapturedFunction::Create(ctx, predicate_metadata_,
+                                               kPredicateOtherArguments,
+                                               &captured_predicate));
+  std::unique_ptr<CapturedFunction> captured_map_func;
+  OP_REQUIRES_OK(ctx, CapturedFunction::Create(ctx, map_func_metadata_,
+                                               kMapFuncOtherArguments,
+                                               &captured_map_func));
+
+  *output =
+      new Dataset(ctx, input, std::move(captured_predicate),
+                  std::move(captured_map_func), output_types_, output_shapes_);
+}
+
+namespace {
+
+REGISTER_KERNEL_BUILDER(Name("FilterMapDataset").Device(DEVICE_CPU),
+                        FilterMapDatasetOp);
+REGISTER_INPUT_COLOCATION_EXEMPTION("FilterMapDataset");
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
@@ -0,0 +1,63 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_KERNELS_DATA_FILTER_MAP_DATASET_OP_H_
+#define TENSORFLOW_CORE_KERNELS_DATA_FILTER_MAP_DATASET_OP_H_
+
+#include "tensorflow/core/data/captured_function.h"
+#include "tensorflow/core/framework/dataset.h"
+
+namespace tensorflow {
+namespace data {
+
+// Fusion of `FilterDataset` followed by `MapDataset`, produced by the
+// `filter_map_fusion` grappler rewrite. The map function is only invoked for
+// elements accepted by the predicate, so rejected elements never pay the map
+// cost, and accepted elements pay the iterator dispatch overhead once instead
+// of twice.
+class FilterMapDatasetOp : public UnaryDatasetOpKernel {
+ public:
+  static constexpr const char* const kDatasetType = "FilterMap";
+  static constexpr const char* const kInputDataset = "input_dataset";
+  static constexpr const char* const kPredicateOtherArguments =
+      "predicate_other_arguments";
+  static constexpr const char* const kMapFuncOtherArguments =
+      "map_func_other_arguments";
+  static constexpr const char* const kPredicate = "predicate";
+  static constexpr const char* const kMapFunc = "map_func";
+  static constexpr const char* const kTpredicateOtherArguments =
+      "Tpredicate_other_arguments";
+  static constexpr const char* const kTmapFuncOtherArguments =
+      "Tmap_func_other_arguments";
+  static constexpr const char* const kOutputTypes = "output_types";
+  static constexpr const char* const kOutputShapes = "output_shapes";
+
+  explicit FilterMapDatasetOp(OpKernelConstruction* ctx);
+
+ protected:
+  void MakeDataset(OpKernelContext* ctx, DatasetBase* input,
+                   DatasetBase** output) override;
+
+ private:
+  class Dataset;
+  std::shared_ptr<FunctionMetadata> predicate_metadata_ = nullptr;
+  std::shared_ptr<FunctionMetadata> map_func_metadata_ = nullptr;
+  DataTypeVector output_types_;
+  std::vector<PartialTensorShape> output_shapes_;
+};
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_KERNELS_DATA_FILTER_MAP_DATASET_OP_H_
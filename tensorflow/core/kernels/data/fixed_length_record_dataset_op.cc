@@ -14,6 +14,9 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/fixed_length_record_dataset_op.h"
 
+#include <algorithm>
+
+#include "absl/memory/memory.h"
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/data/utils.h"
 #include "tensorflow/core/framework/metrics.h"
@@ -24,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/lib/io/random_inputstream.h"
 #include "tensorflow/core/lib/io/zlib_compression_options.h"
 #include "tensorflow/core/lib/io/zlib_inputstream.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -48,6 +52,27 @@ constexpr char kCurrentPos[] = "current_pos";
 constexpr char kZLIB[] = "ZLIB";
 constexpr char kGZIP[] = "GZIP";
 
+namespace {
+
+// Returns the chunk size for the chunked uncompressed read path, configured
+// via the TF_FIXED_LENGTH_RECORD_DATASET_CHUNK_BYTES environment variable.
+// Returns 0 if chunked reads are disabled (the default).
+int64_t FixedLengthRecordChunkBytes() {
+  static const int64_t chunk_bytes = []() {
+    int64_t value = 0;
+    Status status = ReadInt64FromEnvVar(
+        "TF_FIXED_LENGTH_RECORD_DATASET_CHUNK_BYTES", 0, &value);
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to read TF_FIXED_LENGTH_RECORD_DATASET_CHUNK_BYTES: "
+                 << status;
+    }
+    return value < 0 ? int64_t{0} : value;
+  }();
+  return chunk_bytes;
+}
+
+}  // namespace
+
 class FixedLengthRecordDatasetOp::Dataset : public DatasetBase {
  public:
   explicit Dataset(OpKernelContext* ctx, std::vector<string> filenames,
@@ -68,6 +93,12 @@ class FixedLengthRecordDatasetOp::Dataset : public DatasetBase {
     name_utils::IteratorPrefixParams params;
     params.op_version = op_version_;
     if (compression_type_.empty()) {
+      if (FixedLengthRecordChunkBytes() > 0) {
+        return std::make_unique<ChunkedUncompressedIterator>(
+            ChunkedUncompressedIterator::Params{
+                this,
+                name_utils::IteratorPrefix(kDatasetType, prefix, params)});
+      }
       return std::make_unique<UncompressedIterator>(
           UncompressedIterator::Params{
               this, name_utils::IteratorPrefix(kDatasetType, prefix, params)});
@@ -251,6 +282,266 @@ class FixedLengthRecordDatasetOp::Dataset : public DatasetBase {
     int64_t file_pos_limit_ TF_GUARDED_BY(mu_) = -1;
   };
 
+  // Reads the body of each uncompressed file in large record-aligned chunks
+  // and slices records out of the in-memory chunk, instead of issuing one
+  // buffered read per record. A background thread reads the next chunk while
+  // records are produced from the current one, so chunk I/O overlaps with
+  // downstream processing. Used when the
+  // TF_FIXED_LENGTH_RECORD_DATASET_CHUNK_BYTES environment variable is set to
+  // a positive chunk size.
+  class ChunkedUncompressedIterator : public DatasetIterator<Dataset> {
+   public:
+    explicit ChunkedUncompressedIterator(const Params& params)
+        : DatasetIterator<Dataset>(params) {}
+
+    ~ChunkedUncompressedIterator() override {
+      {
+        mutex_lock l(mu_);
+        cancelled_ = true;
+        read_cv_.notify_all();
+      }
+      // Joins the read thread before the file is destroyed.
+      read_thread_.reset();
+    }
+
+    Status GetNextInternal(IteratorContext* ctx,
+                           std::vector<Tensor>* out_tensors,
+                           bool* end_of_sequence) override {
+      mutex_lock l(mu_);
+      do {
+        // Slice the next record out of the current chunk.
+        if (chunk_offset_ < chunk_.size()) {
+          Tensor record_tensor(ctx->allocator({}), DT_STRING, {});
+          record_tensor.scalar<tstring>()().assign(
+              chunk_.data() + chunk_offset_, dataset()->record_bytes_);
+          chunk_offset_ += dataset()->record_bytes_;
+          out_tensors->emplace_back(std::move(record_tensor));
+          *end_of_sequence = false;
+          return absl::OkStatus();
+        }
+
+        if (file_) {
+          // The current chunk is exhausted: collect the prefetched one and
+          // immediately schedule the read of the chunk after it.
+          TF_RETURN_IF_ERROR(TakePrefetchedChunkLocked(l));
+          if (!chunk_.empty()) {
+            ScheduleReadLocked();
+            continue;
+          }
+          // We have reached the end of the current file, so maybe move on to
+          // next file.
+          file_.reset();
+          ++current_file_index_;
+        }
+
+        // Iteration ends when there are no more files to process.
+        if (current_file_index_ == dataset()->filenames_.size()) {
+          *end_of_sequence = true;
+          return absl::OkStatus();
+        }
+
+        // Actually move on to next file.
+        uint64 file_size;
+        const std::string& next_filename =
+            dataset()->filenames_[current_file_index_];
+        TF_RETURN_IF_ERROR(ctx->env()->GetFileSize(next_filename, &file_size));
+        file_pos_limit_ = file_size - dataset()->footer_bytes_;
+
+        uint64 body_size =
+            file_size - (dataset()->header_bytes_ + dataset()->footer_bytes_);
+
+        if (body_size % dataset()->record_bytes_ != 0) {
+          return errors::InvalidArgument(
+              "Excluding the header (", dataset()->header_bytes_,
+              " bytes) and footer (", dataset()->footer_bytes_,
+              " bytes), input file \"", next_filename, "\" has body length ",
+              body_size,
+              " bytes, which is not an exact multiple of the record length (",
+              dataset()->record_bytes_, " bytes).");
+        }
+        TF_RETURN_IF_ERROR(ctx->env()->NewRandomAccessFile(
+            TranslateFileName(next_filename), &file_));
+        next_read_pos_ = dataset()->header_bytes_;
+        ScheduleReadLocked();
+      } while (true);
+    }
+
+   protected:
+    Status SaveInternal(SerializationContext* ctx,
+                        IteratorStateWriter* writer) override {
+      mutex_lock l(mu_);
+      TF_RETURN_IF_ERROR(writer->WriteScalar(prefix(), kCurrentFileIndex,
+                                             current_file_index_));
+      // The consumed position: the start of the current chunk plus the bytes
+      // already sliced out of it. -1 if no file is open, matching the
+      // buffered iterators.
+      int64_t current_pos =
+          file_ ? chunk_start_pos_ + static_cast<int64_t>(chunk_offset_) : -1;
+      TF_RETURN_IF_ERROR(
+          writer->WriteScalar(prefix(), kCurrentPos, current_pos));
+      return absl::OkStatus();
+    }
+
+    Status RestoreInternal(IteratorContext* ctx,
+                           IteratorStateReader* reader) override {
+      mutex_lock l(mu_);
+      int64_t current_file_index;
+      TF_RETURN_IF_ERROR(
+          reader->ReadScalar(prefix(), kCurrentFileIndex, &current_file_index));
+      current_file_index_ = size_t(current_file_index);
+      int64_t current_pos;
+      TF_RETURN_IF_ERROR(
+          reader->ReadScalar(prefix(), kCurrentPos, &current_pos));
+
+      // Discard any in-flight chunk and resume reading at current_pos.
+      TF_RETURN_IF_ERROR(DiscardPrefetchedChunkLocked(l));
+      chunk_.clear();
+      chunk_offset_ = 0;
+      file_.reset();
+      if (current_pos >= 0) {  // There was an open file.
+        uint64 file_size;
+        const std::string& current_filename =
+            dataset()->filenames_[current_file_index_];
+        TF_RETURN_IF_ERROR(
+            ctx->env()->GetFileSize(current_filename, &file_size));
+        file_pos_limit_ = file_size - dataset()->footer_bytes_;
+        TF_RETURN_IF_ERROR(ctx->env()->NewRandomAccessFile(
+            TranslateFileName(current_filename), &file_));
+        next_read_pos_ = current_pos;
+        ScheduleReadLocked();
+      }
+      return absl::OkStatus();
+    }
+
+   private:
+    // Hands the next file range to the read thread. No-op if the file body is
+    // exhausted.
+    void ScheduleReadLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      if (next_read_pos_ >= file_pos_limit_) {
+        return;
+      }
+      if (!read_thread_) {
+        read_thread_ = absl::WrapUnique(Env::Default()->StartThread(
+            /*thread_options=*/{}, /*name=*/"tf_data_fixed_length_chunk_read",
+            [this] { ReadLoop(); }));
+      }
+      // Chunks are record-aligned so records never straddle chunks.
+      int64_t chunk_bytes = std::max(
+          dataset()->record_bytes_, FixedLengthRecordChunkBytes() /
+                                            dataset()->record_bytes_ *
+                                            dataset()->record_bytes_);
+      read_file_ = file_.get();
+      read_offset_ = next_read_pos_;
+      read_bytes_ = std::min(chunk_bytes, file_pos_limit_ - next_read_pos_);
+      next_read_pos_ += read_bytes_;
+      read_scheduled_ = true;
+      result_ready_ = false;
+      read_cv_.notify_all();
+    }
+
+    // Waits for the outstanding read, if any, and makes its chunk current.
+    // Leaves `chunk_` empty if no read was scheduled.
+    Status TakePrefetchedChunkLocked(mutex_lock& l)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      chunk_.clear();
+      chunk_offset_ = 0;
+      if (!read_scheduled_ && !result_ready_) {
+        return absl::OkStatus();
+      }
+      while (!result_ready_ && !cancelled_) {
+        result_cv_.wait(l);
+      }
+      if (cancelled_) {
+        return errors::Cancelled("Iterator was cancelled");
+      }
+      result_ready_ = false;
+      TF_RETURN_IF_ERROR(result_status_);
+      chunk_ = std::move(result_);
+      chunk_start_pos_ = read_offset_;
+      static monitoring::CounterCell* bytes_counter =
+          metrics::GetTFDataBytesReadCounter(kDatasetType);
+      bytes_counter->IncrementBy(chunk_.size());
+      return absl::OkStatus();
+    }
+
+    // Waits for the outstanding read, if any, and drops its result.
+    Status DiscardPrefetchedChunkLocked(mutex_lock& l)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      while (read_scheduled_ && !result_ready_ && !cancelled_) {
+        result_cv_.wait(l);
+      }
+      if (cancelled_) {
+        return errors::Cancelled("Iterator was cancelled");
+      }
+      read_scheduled_ = false;
+      result_ready_ = false;
+      result_.clear();
+      return absl::OkStatus();
+    }
+
+    // Body of the read thread: performs one scheduled chunk read at a time.
+    void ReadLoop() {
+      while (true) {
+        RandomAccessFile* file = nullptr;
+        int64_t offset = 0;
+        int64_t nbytes = 0;
+        {
+          mutex_lock l(mu_);
+          while (!cancelled_ && (!read_scheduled_ || result_ready_)) {
+            read_cv_.wait(l);
+          }
+          if (cancelled_) {
+            return;
+          }
+          file = read_file_;
+          offset = read_offset_;
+          nbytes = read_bytes_;
+        }
+        tstring buffer;
+        buffer.resize_uninitialized(nbytes);
+        StringPiece piece;
+        Status s = file->Read(offset, nbytes, &piece, buffer.mdata());
+        if (s.ok() && piece.data() != buffer.data()) {
+          buffer.assign(piece.data(), piece.size());
+        }
+        mutex_lock l(mu_);
+        read_scheduled_ = false;
+        result_status_ = s;
+        result_ = s.ok() ? std::move(buffer) : tstring();
+        result_ready_ = true;
+        result_cv_.notify_all();
+      }
+    }
+
+    mutex mu_;
+    size_t current_file_index_ TF_GUARDED_BY(mu_) = 0;
+    std::unique_ptr<RandomAccessFile> file_
+        TF_GUARDED_BY(mu_);  // must outlive the read thread's use of it
+    int64_t file_pos_limit_ TF_GUARDED_BY(mu_) = -1;
+    // File offset at which the next chunk read starts.
+    int64_t next_read_pos_ TF_GUARDED_BY(mu_) = 0;
+
+    // The chunk records are currently sliced from.
+    tstring chunk_ TF_GUARDED_BY(mu_);
+    size_t chunk_offset_ TF_GUARDED_BY(mu_) = 0;
+    int64_t chunk_start_pos_ TF_GUARDED_BY(mu_) = 0;
+
+    // The read request handed to the read thread and its result.
+    RandomAccessFile* read_file_ TF_GUARDED_BY(mu_) = nullptr;
+    int64_t read_offset_ TF_GUARDED_BY(mu_) = 0;
+    int64_t read_bytes_ TF_GUARDED_BY(mu_) = 0;
+    bool read_scheduled_ TF_GUARDED_BY(mu_) = false;
+    bool result_ready_ TF_GUARDED_BY(mu_) = false;
+    Status result_status_ TF_GUARDED_BY(mu_);
+    tstring result_ TF_GUARDED_BY(mu_);
+    bool cancelled_ TF_GUARDED_BY(mu_) = false;
+    // Notified when a read is scheduled.
+    condition_variable read_cv_;
+    // Notified when a read result is ready.
+    condition_variable result_cv_;
+    std::unique_ptr<Thread> read_thread_;
+  };
+
   class CompressedIterator : public DatasetIterator<Dataset> {
    public:
     explicit CompressedIterator(const Params& params)
@@ -21,7 +21,10 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
+#include "absl/strings/match.h"
 #include "absl/time/time.h"
 #include "tensorflow/core/activity_watcher/activity.h"
 #include "tensorflow/core/activity_watcher/activity_utils.h"
@@ -56,6 +59,7 @@ limitations under the License.
 #include "tensorflow/core/platform/tstring.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tsl/platform/statusor.h"
 
 namespace tensorflow {
@@ -78,6 +82,24 @@ bool SymbolicCheckpointEnabled(const Options& options) {
          options.symbolic_checkpoint();
 }
 
+// Returns whether `SerializeIterator` should reuse the serialized state of
+// iterators that have not changed since the previous save, controlled by the
+// TF_DATA_INCREMENTAL_ITERATOR_SAVE environment variable (default false).
+// Only effective when symbolic checkpointing is enabled for the dataset,
+// which is what maintains the per-iterator state deltas.
+bool IncrementalSaveEnabled() {
+  static const bool result = [] {
+    bool enabled = false;
+    Status s = ReadBoolFromEnvVar("TF_DATA_INCREMENTAL_ITERATOR_SAVE",
+                                  /*default_val=*/false, &enabled);
+    if (!s.ok()) {
+      LOG(ERROR) << s;
+    }
+    return enabled;
+  }();
+  return result;
+}
+
 }  // namespace
 
 /* static */ constexpr const char* const
@@ -151,6 +173,55 @@ Status IteratorResource::GetNext(OpKernelContext* ctx,
   return status;
 }
 
+Status IteratorResource::GetNextN(OpKernelContext* ctx, int64_t max_elements,
+                                  std::vector<std::vector<Tensor>>* out_elements,
+                                  bool* end_of_sequence) {
+  std::shared_ptr<State> captured_state;
+  {
+    tf_shared_lock l(mu_);
+    captured_state = iterator_state_;
+  }
+  auto iterator = captured_state->iterator();
+  if (!iterator) {
+    return errors::FailedPrecondition(
+        "GetNextN() failed because the iterator has not been initialized. "
+        "Ensure that you have run the initializer operation for this iterator "
+        "before getting the next element.");
+  }
+  auto* dataset = captured_state->dataset();
+  IteratorContext::Params params(ctx);
+  params.cancellation_manager = captured_state->cancellation_manager();
+  params.flr = captured_state->flr();
+  params.function_handle_cache = captured_state->function_handle_cache();
+  params.resource_mgr = captured_state->resource_mgr();
+  params.symbolic_checkpoint = SymbolicCheckpointEnabled(dataset->options());
+  params.thread_factory = unbounded_thread_pool_.get_thread_factory();
+  params.thread_pool = &unbounded_thread_pool_;
+  params.id_registry = captured_state->id_registry();
+  params.warm_start = dataset->options().warm_start();
+  params.model = captured_state->model();
+  std::function<void()> deregister_fn;
+  TF_RETURN_IF_ERROR(RegisterCancellationCallback(
+      ctx->cancellation_manager(),
+      [cm = params.cancellation_manager]() { cm->StartCancel(); },
+      &deregister_fn));
+  auto cleanup = gtl::MakeCleanup(std::move(deregister_fn));
+  IteratorContext iter_ctx(std::move(params));
+  const absl::Time start_time = metrics_collector_.RecordStart();
+  auto status = iterator->GetNextN(&iter_ctx, max_elements, out_elements,
+                                   end_of_sequence);
+  std::vector<Tensor> flattened;
+  for (const auto& element : *out_elements) {
+    flattened.insert(flattened.end(), element.begin(), element.end());
+  }
+  metrics_collector_.RecordStop(start_time, flattened);
+  const int64_t get_next_latency_micros =
+      env_.NowMicros() - absl::ToUnixMicros(start_time);
+  tf_dataz_metrics_collector_->RecordGetNextLatency(get_next_latency_micros);
+  captured_state->MergeCheckpoint(iter_ctx.checkpoint());
+  return status;
+}
+
 absl::Status IteratorResource::GetModelProto(std::string& model_proto) {
   std::shared_ptr<State> captured_state;
   {
@@ -214,6 +285,82 @@ Status IteratorResource::Save(OpKernelContext* ctx,
   return iterator->Save(&serialization_ctx, writer);
 }
 
+Status IteratorResource::SaveIncremental(
+    OpKernelContext* ctx, ExternalStatePolicy external_state_policy,
+    std::vector<std::shared_ptr<VariantTensorData>>* out) {
+  std::shared_ptr<State> captured_state;
+  {
+    tf_shared_lock l(mu_);
+    captured_state = iterator_state_;
+  }
+  auto iterator = captured_state->iterator();
+  if (!iterator) {
+    return errors::FailedPrecondition(
+        "Save() failed because the iterator has not been initialized. Ensure "
+        "that you have run the initializer operation for this iterator before "
+        "saving it.");
+  }
+  auto* dataset = captured_state->dataset();
+  if (!SymbolicCheckpointEnabled(dataset->options())) {
+    // Without symbolic checkpointing there is no delta tracking, so fall back
+    // to a full save.
+    VariantTensorDataWriter writer;
+    TF_RETURN_IF_ERROR(Save(ctx, external_state_policy, &writer));
+    std::vector<std::unique_ptr<VariantTensorData>> data;
+    writer.ReleaseData(&data);
+    out->reserve(data.size());
+    for (auto& it : data) {
+      out->push_back(std::move(it));
+    }
+    return absl::OkStatus();
+  }
+  const auto& checkpoint = captured_state->checkpoint();
+  if (!checkpoint.GetStatus().ok()) {
+    LOG(WARNING) << "Symbolic checkpointing failed: " << checkpoint.GetStatus();
+    return checkpoint.GetStatus();
+  }
+  mutex_lock l(save_cache_mu_);
+  // A cached entry is reusable if no update since the last save names it or a
+  // prefix of it (purges are tracked at prefix granularity).
+  const auto& updated_names = checkpoint.GetUpdatedNames();
+  absl::flat_hash_set<std::string> reusable_names;
+  for (const auto& [name, data] : save_cache_) {
+    bool updated = false;
+    for (const auto& updated_name : updated_names) {
+      if (absl::StartsWith(name, updated_name)) {
+        updated = true;
+        break;
+      }
+    }
+    if (!updated) {
+      reusable_names.insert(name);
+    }
+  }
+  captured_state->MarkCheckpointSaved();
+  VariantTensorDataWriter writer;
+  TF_RETURN_IF_ERROR(checkpoint.Save(&writer, reusable_names));
+  std::vector<std::unique_ptr<VariantTensorData>> fresh_data;
+  writer.ReleaseData(&fresh_data);
+  // Rebuild the cache from the reused entries and the freshly serialized
+  // state, dropping entries for iterators no longer in the checkpoint.
+  absl::flat_hash_map<std::string, std::shared_ptr<VariantTensorData>>
+      new_cache;
+  for (const auto& name : reusable_names) {
+    new_cache[name] = save_cache_[name];
+  }
+  for (auto& it : fresh_data) {
+    std::string name;
+    TF_RETURN_IF_ERROR(GetIteratorName(*it, &name));
+    new_cache[name] = std::move(it);
+  }
+  save_cache_ = std::move(new_cache);
+  out->reserve(save_cache_.size());
+  for (const auto& [name, data] : save_cache_) {
+    out->push_back(data);
+  }
+  return absl::OkStatus();
+}
+
 Status IteratorResource::Restore(OpKernelContext* ctx,
                                  IteratorStateReader* reader) {
   const DatasetBase* dataset;
@@ -273,6 +420,11 @@ Status IteratorResource::Restore(OpKernelContext* ctx,
   new_state->DowncastAndSetIteratorAndDataset(std::move(iterator_base),
                                               input_dataset);
   new_state->MergeCheckpoint(iter_ctx.checkpoint());
+  {
+    // The cached serialized state belongs to the replaced iterator state.
+    mutex_lock cache_l(save_cache_mu_);
+    save_cache_.clear();
+  }
   mutex_lock l(mu_);
   std::swap(iterator_state_, new_state);
   return absl::OkStatus();
@@ -326,6 +478,11 @@ Status IteratorResource::SetIteratorFromDataset(OpKernelContext* ctx,
   new_state->DowncastAndSetIteratorAndDataset(std::move(iterator), dataset);
   new_state->SetModel(iter_ctx.model());
   new_state->MergeCheckpoint(iter_ctx.checkpoint());
+  {
+    // The cached serialized state belongs to the replaced iterator state.
+    mutex_lock cache_l(save_cache_mu_);
+    save_cache_.clear();
+  }
   mutex_lock l(mu_);
   std::swap(iterator_state_, new_state);
   tf_dataz_metrics_collector_ = std::make_shared<TfDatazMetricsCollector>(
@@ -379,6 +536,25 @@ class IteratorVariantSerializer {
   Status InitializeFromIterator(OpKernelContext* ctx,
                                 ExternalStatePolicy external_state_policy,
                                 IteratorResource* iterator_resource) {
+    if (IncrementalSaveEnabled()) {
+      std::vector<std::shared_ptr<VariantTensorData>> data;
+      TF_RETURN_IF_ERROR(iterator_resource->SaveIncremental(
+          ctx, external_state_policy, &data));
+      variants_.clear();
+      variants_.reserve(data.size());
+      for (const auto& it : data) {
+        // The data may be shared with the resource's save cache, so wrap a
+        // copy. Tensors are copied shallowly.
+        IteratorStateVariant v;
+        TF_RETURN_IF_ERROR(
+            v.InitializeFromVariantData(std::make_unique<VariantTensorData>(
+                *it)));
+        variants_.push_back(v);
+      }
+      num_tensors_ = variants_.size();
+      can_serialize_ = true;
+      return absl::OkStatus();
+    }
     VariantTensorDataWriter writer;
     TF_RETURN_IF_ERROR(
         iterator_resource->Save(ctx, external_state_policy, &writer));
@@ -953,6 +1129,76 @@ Status IteratorGetNextOp::DoCompute(OpKernelContext* ctx) {
   return absl::OkStatus();
 }
 
+Status IteratorGetNextNOp::DoCompute(OpKernelContext* ctx) {
+  VLOG(3) << "IteratorGetNextNOp enter. iter_id=" << ctx->frame_iter().iter_id;
+  auto cleanup = gtl::MakeCleanup([ctx] {
+    VLOG(3) << "IteratorGetNextNOp exit. iter_id=" << ctx->frame_iter().iter_id;
+  });
+  activity_watcher::ActivityScope activity_scope([ctx = ctx]() {
+    return activity_watcher::ActivityFromContext(
+        ctx, "IteratorGetNextNOp::DoCompute",
+        activity_watcher::ActivityCategory::kDatasetOp);
+  });
+  tsl::profiler::TraceMe traceme(
+      [&] {
+        return tsl::profiler::TraceMeEncode(
+            "IteratorGetNextNOp::DoCompute",
+            {{"id", ctx->step_id()}, {"iter_num", ctx->frame_iter().iter_id}});
+      },
+      profiler::kInfo);
+  tensorflow::ResourceTagger tag(kTFDataResourceTag,
+                                 ctx->op_kernel().type_string());
+  metrics::RecordTFDataFetchOp("IteratorGetNextNOp");
+  IteratorResource* iterator;
+  TF_RETURN_IF_ERROR(LookupResource(ctx, HandleFromInput(ctx, 0), &iterator));
+  core::ScopedUnref unref_iterator(iterator);
+  const int num_components = iterator->output_dtypes().size();
+  if (num_components == 0 || output_types_.size() % num_components != 0) {
+    return errors::InvalidArgument(
+        "`output_types` must consist of the iterator's output types repeated "
+        "once per requested element. The iterator produces ", num_components,
+        " components but `output_types` has ", output_types_.size(),
+        " entries.");
+  }
+  const int64_t max_elements = output_types_.size() / num_components;
+  const DataTypeVector element_types(
+      output_types_.begin(), output_types_.begin() + num_components);
+  const std::vector<PartialTensorShape> element_shapes(
+      output_shapes_.begin(), output_shapes_.begin() + num_components);
+  std::vector<std::vector<Tensor>> elements;
+  bool end_of_sequence = false;
+
+  TF_RETURN_IF_ERROR(
+      iterator->GetNextN(ctx, max_elements, &elements, &end_of_sequence));
+  if (elements.empty()) {
+    return errors::OutOfRange("End of sequence");
+  }
+  Tensor* num_elements_t;
+  TF_RETURN_IF_ERROR(
+      ctx->allocate_output(0, TensorShape({}), &num_elements_t));
+  num_elements_t->scalar<int64_t>()() = elements.size();
+  for (int64_t i = 0; i < max_elements; ++i) {
+    if (i < elements.size()) {
+      std::vector<Tensor>& components = elements[i];
+      TF_RETURN_IF_ERROR(VerifyTypesMatch(element_types, components));
+      TF_RETURN_IF_ERROR(VerifyShapesCompatible(element_shapes, components));
+      RecordElementSize(components, &traceme);
+      for (int j = 0; j < num_components; ++j) {
+        ctx->set_output(1 + i * num_components + j, components[j]);
+      }
+    } else {
+      // Pad output slots past the end of the sequence with empty tensors;
+      // consumers should inspect `num_elements` to determine which outputs
+      // are valid.
+      for (int j = 0; j < num_components; ++j) {
+        ctx->set_output(1 + i * num_components + j,
+                        Tensor(element_types[j], TensorShape({0})));
+      }
+    }
+  }
+  return absl::OkStatus();
+}
+
 Status IteratorGetModelProtoOp::DoCompute(OpKernelContext* ctx) {
   IteratorResource* iterator = nullptr;
   TF_RETURN_IF_ERROR(LookupResource(ctx, HandleFromInput(ctx, 0), &iterator));
@@ -1199,6 +1445,11 @@ REGISTER_KERNEL_BUILDER(
 REGISTER_KERNEL_BUILDER(
     Name("IteratorGetNextSync").Device(DEVICE_GPU).Priority(1),
     IteratorGetNextOp);
+REGISTER_KERNEL_BUILDER(Name("IteratorGetNextN")
+                            .Device(DEVICE_CPU)
+                            .HostMemory("num_elements")
+                            .Priority(2),
+                        IteratorGetNextNOp);
 REGISTER_KERNEL_BUILDER(
     Name("IteratorGetNextAsOptional").Device(DEVICE_CPU).Priority(2),
     IteratorGetNextAsOptionalOp);
@@ -17,9 +17,11 @@ limitations under the License.
 #define TENSORFLOW_CORE_KERNELS_DATA_ITERATOR_OPS_H_
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/metric_utils.h"
 #include "tensorflow/core/data/tfdataz_metrics.h"
@@ -56,12 +58,33 @@ class IteratorResource : public ResourceBase {
   Status GetNext(OpKernelContext* ctx, std::vector<Tensor>* out_tensors,
                  bool* end_of_sequence);
 
+  // Gets up to `max_elements` of the next outputs from the iterator managed
+  // by this iterator resource in a single call, amortizing per-call overhead
+  // across elements.
+  //
+  // The produced elements are stored in `*out_elements`. If the end of
+  // sequence is reached before `max_elements` outputs have been produced,
+  // `true` will be stored in `*end_of_sequence` and `*out_elements` will hold
+  // the outputs produced before the end of the sequence.
+  Status GetNextN(OpKernelContext* ctx, int64_t max_elements,
+                  std::vector<std::vector<Tensor>>* out_elements,
+                  bool* end_of_sequence);
+
   absl::Status GetModelProto(std::string& model_proto);
 
   // Saves a checkpoint of the state of the iterator through the given `writer`.
   Status Save(OpKernelContext* ctx, ExternalStatePolicy external_state_policy,
               IteratorStateWriter* writer);
 
+  // Like `Save`, but produces the serialized state as one `VariantTensorData`
+  // per iterator and, when symbolic checkpointing is enabled for the
+  // iterator's dataset, reuses the serialized state of iterators that have
+  // not changed since the previous call so that frequent saves only pay for
+  // the state deltas. Falls back to a full save otherwise.
+  Status SaveIncremental(OpKernelContext* ctx,
+                         ExternalStatePolicy external_state_policy,
+                         std::vector<std::shared_ptr<VariantTensorData>>* out);
+
   // Restores the state of the iterator from a checkpoint created by `Save`.
   Status Restore(OpKernelContext* ctx, IteratorStateReader* reader);
 
@@ -131,6 +154,10 @@ class IteratorResource : public ResourceBase {
     // Merges the given checkpoint with the checkpoint of this state.
     void MergeCheckpoint(MemoryCheckpoint* other);
 
+    // Clears the set of iterator names whose checkpoint state changed, after
+    // an incremental save has captured the corresponding state.
+    void MarkCheckpointSaved() { checkpoint_.ClearUpdatedNames(); }
+
     void SetModel(std::shared_ptr<model::Model> model);
 
     std::shared_ptr<MemoryCheckpoint::IdRegistry> id_registry() {
@@ -161,6 +188,13 @@ class IteratorResource : public ResourceBase {
   std::shared_ptr<State> iterator_state_ TF_GUARDED_BY(mu_);
   const DataTypeVector output_dtypes_;
   const std::vector<PartialTensorShape> output_shapes_;
+  // Serialized per-iterator state from the most recent `SaveIncremental`
+  // call, keyed by iterator name. Entries are reused for iterators whose
+  // state has not changed since that save. Cleared whenever the iterator
+  // state is replaced.
+  mutex save_cache_mu_;
+  absl::flat_hash_map<std::string, std::shared_ptr<VariantTensorData>>
+      save_cache_ TF_GUARDED_BY(save_cache_mu_);
 };
 
 class IteratorHandleOp : public OpKernel {
@@ -275,6 +309,22 @@ class IteratorGetNextOp : public HybridAsyncOpKernel {
   std::vector<PartialTensorShape> output_shapes_;
 };
 
+class IteratorGetNextNOp : public HybridAsyncOpKernel {
+ public:
+  explicit IteratorGetNextNOp(OpKernelConstruction* ctx)
+      : HybridAsyncOpKernel(ctx, "tf_data_iterator_get_next_n") {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("output_types", &output_types_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("output_shapes", &output_shapes_));
+  }
+
+ protected:
+  Status DoCompute(OpKernelContext* ctx) override;
+
+ private:
+  DataTypeVector output_types_;
+  std::vector<PartialTensorShape> output_shapes_;
+};
+
 class IteratorGetModelProtoOp : public HybridAsyncOpKernel {
  public:
   explicit IteratorGetModelProtoOp(OpKernelConstruction* ctx)
@@ -107,6 +107,36 @@ TEST_F(IteratorOpsTest, CollectMetrics) {
   EXPECT_GT(iterator_busy.Delta(), 0.0);
 }
 
+TEST_F(IteratorOpsTest, GetNextN) {
+  RangeDatasetParams dataset_params = RangeDatasetParams(0, 10, 3);
+  TF_ASSERT_OK(Initialize(dataset_params));
+  TF_ASSERT_OK_AND_ASSIGN(core::RefCountPtr<IteratorResource> iter_resource,
+                          GetIteratorResource());
+
+  std::vector<std::vector<Tensor>> elements;
+  bool end_of_sequence = false;
+  TF_ASSERT_OK(iter_resource->GetNextN(dataset_ctx_.get(), /*max_elements=*/3,
+                                       &elements, &end_of_sequence));
+  EXPECT_FALSE(end_of_sequence);
+  ASSERT_EQ(elements.size(), 3);
+  for (int i = 0; i < 3; ++i) {
+    TF_EXPECT_OK(ExpectEqual(elements[i][0], Tensor(int64_t{i * 3})));
+  }
+
+  // The iterator runs out after the fourth element; the elements produced
+  // before the end of the sequence are still returned.
+  TF_ASSERT_OK(iter_resource->GetNextN(dataset_ctx_.get(), /*max_elements=*/3,
+                                       &elements, &end_of_sequence));
+  EXPECT_TRUE(end_of_sequence);
+  ASSERT_EQ(elements.size(), 1);
+  TF_EXPECT_OK(ExpectEqual(elements[0][0], Tensor(int64_t{9})));
+
+  TF_ASSERT_OK(iter_resource->GetNextN(dataset_ctx_.get(), /*max_elements=*/3,
+                                       &elements, &end_of_sequence));
+  EXPECT_TRUE(end_of_sequence);
+  EXPECT_TRUE(elements.empty());
+}
+
 }  // namespace
 }  // namespace data
 }  // namespace tensorflow
@@ -49,6 +49,7 @@ limitations under the License.
 #include "tensorflow/core/platform/stringprintf.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -123,6 +124,27 @@ constexpr double kDefaultPerIteratorPrefetchFactor = 2.0L;
 // Period between reporting dataset statistics.
 constexpr int kStatsReportingPeriodMillis = 1000;
 
+// Returns whether deterministic interleave may grant buffer credits to
+// non-head cycle elements. Without credits, deterministic mode idles every
+// worker whose element buffer is full while the consumer is blocked on the
+// head-of-line element. With credits, each time the consumer blocks, full
+// non-head elements are allowed to buffer one extra result (bounded at
+// `buffer_output_elements` extra results per element), trading memory for
+// worker utilization. Credits are returned as the extra results are
+// consumed.
+bool DeterministicCreditsEnabled() {
+  static const bool result = [] {
+    bool enabled = false;
+    Status s = ReadBoolFromEnvVar("TF_DATA_DETERMINISTIC_INTERLEAVE_CREDITS",
+                                  /*default_val=*/false, &enabled);
+    if (!s.ok()) {
+      LOG(ERROR) << s;
+    }
+    return enabled;
+  }();
+  return result;
+}
+
 inline int64_t CeilDiv(int64_t numerator, int64_t denominator) {
   return (numerator + denominator - 1) / denominator;
 }
@@ -431,6 +453,9 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
           if (deterministic_) {
             VLOG(3) << "Blocked waiting for element "
                     << current_elements_[cycle_index_]->id;
+            if (DeterministicCreditsEnabled()) {
+              GrantBufferCredits();
+            }
             current_elements_[cycle_index_]->cond_var.wait(l);
           } else {
             any_element_available_cond_var_.wait(l);
@@ -668,6 +693,13 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
       // Whether we tried to initialize the element, but the input iterator
       // was exhausted so we could produce no inputs.
       bool no_input TF_GUARDED_BY(&ParallelInterleaveIterator::mu_) = false;
+      // Number of results the element may buffer beyond
+      // `buffer_output_elements`. Credits are granted to non-head elements
+      // while the deterministic consumer is blocked on the head-of-line
+      // element and are returned as results are consumed. Always zero when
+      // credits are disabled; see `DeterministicCreditsEnabled`.
+      int64_t extra_buffer_credits
+          TF_GUARDED_BY(&ParallelInterleaveIterator::mu_) = 0;
       // Condition variable for communicating between current worker threads
       // and GetNext.
       condition_variable cond_var;
@@ -801,6 +833,11 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
           // We found a result.
           std::swap(*result, element->results.front());
           element->results.pop_front();
+          if (element->extra_buffer_credits > 0) {
+            // Return a credit granted while this element was at the head of
+            // the line so buffering decays back to `buffer_output_elements`.
+            element->extra_buffer_credits--;
+          }
           if (!element->active) {
             elements_to_process_.push_back(cycle_index_);
             current_workers_cond_var_.notify_one();
@@ -1109,7 +1146,8 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
         mutex_lock l(*mu_);
         element->results.push_back(std::move(result));
         NotifyElementUpdate(*element);
-        if (element->results.size() == dataset()->buffer_output_elements_) {
+        if (static_cast<int64_t>(element->results.size()) >=
+            BufferLimit(*element)) {
           break;
         }
       }
@@ -1203,7 +1241,41 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
         return true;
       }
       return element->iterator &&
-             element->results.size() < dataset()->buffer_output_elements_;
+             static_cast<int64_t>(element->results.size()) <
+                 BufferLimit(*element);
+    }
+
+    // The number of results `element` may buffer, including any credits it
+    // has been granted while the deterministic consumer was blocked.
+    int64_t BufferLimit(const Element& element)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      return dataset()->buffer_output_elements_ + element.extra_buffer_credits;
+    }
+
+    // Grants one buffer credit to every full non-head cycle element that is
+    // still producing results, so that workers stay busy prefetching while
+    // the deterministic consumer is blocked on the head-of-line element.
+    // Per-element credits are bounded by `buffer_output_elements`, which
+    // bounds per-element buffering at `2 * buffer_output_elements` results.
+    void GrantBufferCredits() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      for (int64_t i = 0; i <= last_valid_current_element_; ++i) {
+        if (i == cycle_index_) {
+          continue;
+        }
+        const std::shared_ptr<Element>& element = current_elements_[i];
+        if (!element || !element->initialized || !element->iterator ||
+            element->extra_buffer_credits >=
+                dataset()->buffer_output_elements_ ||
+            static_cast<int64_t>(element->results.size()) <
+                BufferLimit(*element)) {
+          continue;
+        }
+        element->extra_buffer_credits++;
+        if (!element->active) {
+          elements_to_process_.push_back(i);
+          current_workers_cond_var_.notify_one();
+        }
+      }
     }
 
     inline void IncrementCurrentWorkers() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
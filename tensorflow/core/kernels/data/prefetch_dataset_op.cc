@@ -15,9 +15,15 @@ limitations under the License.
 #include "tensorflow/core/kernels/data/prefetch_dataset_op.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <atomic>
 #include <deque>
 #include <limits>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "tensorflow/core/data/dataset_utils.h"
@@ -38,6 +44,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tsl/platform/mutex.h"
 
 namespace tensorflow {
@@ -65,6 +72,22 @@ constexpr char kSizeSuffix[] = ".size";
 constexpr char kCodeSuffix[] = ".code";
 constexpr char kErrorMessageSuffix[] = ".error_message";
 
+// Returns true if prefetch should move elements through a lock-free ring
+// buffer instead of the mutex-protected deque. Only takes effect for
+// iterators with a static buffer size and no slack; see `Iterator::ring_`.
+bool LockFreePrefetchRingEnabled() {
+  static bool result = [] {
+    bool lock_free = false;
+    Status s = ReadBoolFromEnvVar("TF_DATA_PREFETCH_LOCKFREE",
+                                  /*default_val=*/false, &lock_free);
+    if (!s.ok()) {
+      LOG(ERROR) << s.message();
+    }
+    return lock_free;
+  }();
+  return result;
+}
+
 }  // namespace
 
 class PrefetchDatasetOp::Dataset : public DatasetBase {
@@ -166,6 +189,13 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
               legacy_autotune_ ? 0 : params.dataset->buffer_size_, mu_,
               cond_var_)) {
       slack_us_ = 0;
+      // The lock-free ring requires a fixed capacity, so it is only used
+      // when the buffer size is static (neither autotune can resize it)
+      // and no slack accounting is requested.
+      if (LockFreePrefetchRingEnabled() && params.dataset->buffer_size_ > 0 &&
+          params.dataset->slack_period_ == 0) {
+        ring_ = std::make_unique<LockFreeRing>(params.dataset->buffer_size_);
+      }
     }
 
     ~Iterator() override {
@@ -204,6 +234,9 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
     Status GetNextInternal(IteratorContext* ctx,
                            std::vector<Tensor>* out_tensors,
                            bool* end_of_sequence) override {
+      if (ring_) {
+        return GetNextFromRing(ctx, out_tensors, end_of_sequence);
+      }
       const auto& stats_aggregator = ctx->stats_aggregator();
       {
         mutex_lock l(*mu_);
@@ -276,21 +309,30 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
       mutex_lock input_l(input_mu_);
       mutex_lock l(*mu_);
       TF_RETURN_IF_ERROR(SaveInput(ctx, writer, input_impl_));
+      if (ring_) {
+        // The producer is quiescent while `input_mu_` is held and GetNext
+        // does not run concurrently with Save, so the ring can be drained,
+        // serialized, and refilled in order.
+        std::vector<std::unique_ptr<BufferElement>> elements;
+        for (auto element = ring_->Pop(); element != nullptr;
+             element = ring_->Pop()) {
+          elements.push_back(std::move(element));
+        }
+        TF_RETURN_IF_ERROR(
+            writer->WriteScalar(prefix(), kBufferSize, elements.size()));
+        for (size_t i = 0; i < elements.size(); i++) {
+          TF_RETURN_IF_ERROR(WriteBufferElement(writer, i, *elements[i]));
+        }
+        for (auto& element : elements) {
+          // Cannot fail: the elements just vacated these slots.
+          ring_->TryPush(&element);
+        }
+        return absl::OkStatus();
+      }
       TF_RETURN_IF_ERROR(
           writer->WriteScalar(prefix(), kBufferSize, buffer_.size()));
       for (size_t i = 0; i < buffer_.size(); i++) {
-        auto& buffer_element = buffer_[i];
-        TF_RETURN_IF_ERROR(WriteStatus(writer, i, buffer_element.status));
-        if (buffer_element.status.ok()) {
-          TF_RETURN_IF_ERROR(writer->WriteScalar(
-              absl::StrCat(prefix(), "::", i),
-              absl::StrCat(kBuffer, kSizeSuffix), buffer_element.value.size()));
-          for (size_t j = 0; j < buffer_element.value.size(); j++) {
-            TF_RETURN_IF_ERROR(writer->WriteTensor(
-                absl::StrCat(prefix(), "::", i),
-                absl::StrCat(kBuffer, "[", j, "]"), buffer_element.value[j]));
-          }
-        }
+        TF_RETURN_IF_ERROR(WriteBufferElement(writer, i, buffer_[i]));
       }
       return absl::OkStatus();
     }
@@ -326,8 +368,10 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
       // right away to avoid introducing tracing overhead.
       if (mu_->try_lock()) {
         limit = buffer_limit();
-        size = buffer_.size();
-        if (!buffer_.empty()) {
+        // In ring mode, elements cannot be peeked without consuming them,
+        // so only the size is reported.
+        size = ring_ ? static_cast<int64_t>(ring_->size()) : buffer_.size();
+        if (!ring_ && !buffer_.empty()) {
           std::vector<std::string> shapes(buffer_.front().value.size());
           for (const auto& component : buffer_.front().value) {
             shapes.push_back(component.shape().DebugString());
@@ -375,6 +419,92 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
       MemoryCheckpoint checkpoint;
     };
 
+    // Bounded lock-free ring buffer that hands prefetched elements from the
+    // prefetch thread to GetNext callers when the buffer size is static.
+    // Slots carry sequence numbers (a Vyukov-style bounded queue) so the
+    // single producer and concurrent consumers synchronize through atomics
+    // alone; `mu_` and `cond_var_` are only touched when one side has to
+    // block on an empty or full buffer (see the `consumer_waiting_` /
+    // `producer_waiting_` handshake).
+    class LockFreeRing {
+     public:
+      explicit LockFreeRing(int64_t buffer_size) {
+        // One spare slot beyond `buffer_size`, rounded up to a power of two
+        // for cheap index masking. The logical capacity is enforced by the
+        // producer, which does not push while `size() >= buffer_size`.
+        size_t capacity = 1;
+        while (capacity < static_cast<size_t>(buffer_size) + 1) {
+          capacity <<= 1;
+        }
+        slots_ = std::vector<Slot>(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+          slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+      }
+
+      // Attempts to enqueue `*element`, leaving it in place on failure.
+      // Fails if the ring is physically full or the slot being recycled is
+      // still in the hands of a consumer. Called only by the producer
+      // thread (and by Save/Restore while the producer is quiescent).
+      bool TryPush(std::unique_ptr<BufferElement>* element) {
+        const size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[pos & (slots_.size() - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != pos) {
+          return false;
+        }
+        slot.element = std::move(*element);
+        slot.sequence.store(pos + 1, std::memory_order_release);
+        enqueue_pos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+      }
+
+      // Dequeues the oldest element, or returns nullptr if the ring is
+      // empty. Safe to call from concurrent consumers: a slot is claimed
+      // with a compare-exchange before its element is read.
+      std::unique_ptr<BufferElement> Pop() {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+          Slot& slot = slots_[pos & (slots_.size() - 1)];
+          const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+          const intptr_t dif =
+              static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+          if (dif < 0) {
+            return nullptr;
+          }
+          if (dif == 0) {
+            if (dequeue_pos_.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+              std::unique_ptr<BufferElement> element = std::move(slot.element);
+              slot.sequence.store(pos + slots_.size(),
+                                  std::memory_order_release);
+              return element;
+            }
+            // Lost the race to another consumer; `pos` was reloaded by the
+            // failed compare-exchange.
+          } else {
+            // Another consumer advanced past this slot; catch up.
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+          }
+        }
+      }
+
+      size_t size() const {
+        const size_t enqueue = enqueue_pos_.load(std::memory_order_acquire);
+        const size_t dequeue = dequeue_pos_.load(std::memory_order_acquire);
+        return enqueue >= dequeue ? enqueue - dequeue : 0;
+      }
+
+     private:
+      struct Slot {
+        std::atomic<size_t> sequence{0};
+        std::unique_ptr<BufferElement> element;
+      };
+
+      std::vector<Slot> slots_;
+      std::atomic<size_t> enqueue_pos_{0};  // Written only by the producer.
+      std::atomic<size_t> dequeue_pos_{0};
+    };
+
     Status RestoreBuffer(IteratorContext* const ctx,
                          IteratorStateReader* const reader)
         TF_EXCLUSIVE_LOCKS_REQUIRED(*mu_) {
@@ -408,6 +538,16 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
         }
         RecordBufferEnqueue(ctx, buffer_element.value);
       }
+      if (ring_) {
+        while (!buffer_.empty()) {
+          auto element =
+              std::make_unique<BufferElement>(std::move(buffer_.front()));
+          buffer_.pop_front();
+          // Cannot fail: the ring is empty and its physical capacity
+          // exceeds the logical buffer size that bounded the checkpoint.
+          ring_->TryPush(&element);
+        }
+      }
       return absl::OkStatus();
     }
 
@@ -499,6 +639,85 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
       return s;
     }
 
+    // GetNext implementation for the lock-free ring mode. In steady state
+    // an element is popped without touching `mu_`; the mutex is only taken
+    // to start the prefetch thread and to block while the ring is empty.
+    Status GetNextFromRing(IteratorContext* ctx,
+                           std::vector<Tensor>* out_tensors,
+                           bool* end_of_sequence) TF_LOCKS_EXCLUDED(*mu_) {
+      std::unique_ptr<BufferElement> element = ring_->Pop();
+      if (!element) {
+        mutex_lock l(*mu_);
+        TF_RETURN_IF_ERROR(EnsureThreadsStarted(ctx));
+        while (true) {
+          element = ring_->Pop();
+          if (element || prefetch_thread_finished_) {
+            break;
+          }
+          // Publish that this thread is about to block, then re-check, so
+          // that a racing push cannot be missed: the producer notifies
+          // under `mu_` whenever it observes `consumer_waiting_`. The flag
+          // is only cleared by the producer, since other consumers may be
+          // blocked too.
+          consumer_waiting_.store(true, std::memory_order_seq_cst);
+          element = ring_->Pop();
+          if (element) {
+            break;
+          }
+          RecordStop(ctx);
+          cond_var_->wait(l);
+          RecordStart(ctx);
+        }
+        if (!element) {
+          *end_of_sequence = true;
+          return absl::OkStatus();
+        }
+      }
+      const auto& stats_aggregator = ctx->stats_aggregator();
+      if (stats_aggregator) {
+        stats_aggregator->AddToHistogram(
+            stats_utils::BufferUtilizationHistogramName(dataset()->node_name()),
+            {static_cast<float>(ring_->size()) /
+             static_cast<float>(dataset()->buffer_size_)},
+            num_elements());
+        stats_aggregator->AddScalar(
+            stats_utils::BufferSizeScalarName(dataset()->node_name()),
+            static_cast<float>(ring_->size()), num_elements());
+        stats_aggregator->AddScalar(
+            stats_utils::BufferCapacityScalarName(dataset()->node_name()),
+            static_cast<float>(dataset()->buffer_size_), num_elements());
+      }
+      Status s = element->status;
+      if (s.ok()) {
+        tsl::profiler::TraceMe traceme(
+            [&] {
+              return tsl::profiler::TraceMeEncode(
+                  "PrefetchConsume", {{"element_id", element->uid}});
+            },
+            profiler::kInfo);
+        *out_tensors = std::move(element->value);
+        ctx->MergeCheckpoint(&element->checkpoint);
+        RecordBufferDequeue(ctx, *out_tensors);
+      } else {
+        RecordBufferDequeue(ctx, element->value);
+      }
+      *end_of_sequence = false;
+      // Wake the producer only if it is blocked on a full ring; in steady
+      // state no lock is taken and no wakeup is issued. The fence orders
+      // the `dequeue_pos_` advance in Pop() before the flag load; without
+      // it the store and the load may be reordered (store->load reordering
+      // is legal even on x86), letting this consumer read a stale `false`
+      // while the producer's re-check still sees a full ring -- and both
+      // sides block forever.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (producer_waiting_.load(std::memory_order_seq_cst)) {
+        mutex_lock l(*mu_);
+        producer_waiting_.store(false, std::memory_order_relaxed);
+        cond_var_->notify_all();
+      }
+      return s;
+    }
+
     Status EnsureThreadsStarted(IteratorContext* ctx)
         TF_EXCLUSIVE_LOCKS_REQUIRED(*mu_) {
       if (!prefetch_thread_) {
@@ -516,6 +735,10 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
     void PrefetchThread(const std::shared_ptr<IteratorContext>& ctx) {
       RecordStart(ctx.get());
       auto cleanup = gtl::MakeCleanup([this, ctx] { RecordStop(ctx.get()); });
+      if (ring_) {
+        PrefetchRingLoop(ctx);
+        return;
+      }
       // Keep track of where we are in an iteration "burst"
       int num_produced = 0;
       while (true) {
@@ -581,6 +804,114 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
       }
     }
 
+    // Producer loop for the lock-free ring mode. Mirrors the deque-based
+    // loop above, but publishes elements through `ring_` so that in steady
+    // state the producer and consumers never contend on `mu_`.
+    void PrefetchRingLoop(const std::shared_ptr<IteratorContext>& ctx) {
+      const size_t buffer_size = static_cast<size_t>(dataset()->buffer_size_);
+      while (true) {
+        // 1. Wait for a slot in the ring. Only this thread pushes, so a
+        // ring observed non-full stays non-full until the push below.
+        if (ring_->size() >= buffer_size) {
+          mutex_lock l(*mu_);
+          while (!cancelled_ && ring_->size() >= buffer_size) {
+            // As on the consumer side, publish intent to block before
+            // re-checking so a racing pop cannot be missed.
+            producer_waiting_.store(true, std::memory_order_seq_cst);
+            if (ring_->size() < buffer_size) {
+              break;
+            }
+            RecordStop(ctx.get());
+            cond_var_->wait(l);
+            RecordStart(ctx.get());
+          }
+          producer_waiting_.store(false, std::memory_order_relaxed);
+          if (cancelled_) {
+            prefetch_thread_finished_ = true;
+            cond_var_->notify_all();
+            return;
+          }
+        }
+
+        // 2. Read the next element. As in the deque-based loop, `input_mu_`
+        // is held until the element is in the ring, so SaveInternal cannot
+        // observe an element that is in neither the input nor the buffer.
+        mutex_lock input_l(input_mu_);
+        bool end_of_sequence = false;
+        auto element = std::make_unique<BufferElement>(ctx.get());
+        {
+          tsl::profiler::TraceMe traceme(
+              [&] {
+                return tsl::profiler::TraceMeEncode(
+                    "PrefetchProduce", {{"element_id", element->uid}});
+              },
+              profiler::kInfo);
+          element->status = input_impl_->GetNext(ctx.get(), &element->value,
+                                                 &end_of_sequence);
+          element->checkpoint.Merge(ctx->checkpoint());
+        }
+        if (element->status.ok() && end_of_sequence) {
+          mutex_lock l(*mu_);
+          prefetch_thread_finished_ = true;
+          cond_var_->notify_all();
+          return;
+        }
+
+        // 3. Publish the element. TryPush fails only transiently, when the
+        // slot being recycled is still in the hands of a consumer.
+        RecordBufferEnqueue(ctx.get(), element->value);
+        element->created_us = EnvTime::NowMicros();
+        while (!ring_->TryPush(&element)) {
+          mutex_lock l(*mu_);
+          if (cancelled_) {
+            // Pair the enqueue event of the element being dropped.
+            RecordBufferDequeue(ctx.get(), element->value);
+            prefetch_thread_finished_ = true;
+            cond_var_->notify_all();
+            return;
+          }
+          producer_waiting_.store(true, std::memory_order_seq_cst);
+          if (ring_->TryPush(&element)) {
+            producer_waiting_.store(false, std::memory_order_relaxed);
+            break;
+          }
+          RecordStop(ctx.get());
+          cond_var_->wait(l);
+          RecordStart(ctx.get());
+          producer_waiting_.store(false, std::memory_order_relaxed);
+        }
+        // Order the push (whose position stores are release only) before
+        // the flag load; see the matching fence in GetNextFromRing(). This
+        // closes the symmetric race where the consumer publishes
+        // `consumer_waiting_` just as this push fills the ring, the flag
+        // load is reordered before the push becomes visible, and both
+        // sides block forever on an untimed wait.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (consumer_waiting_.load(std::memory_order_seq_cst)) {
+          mutex_lock l(*mu_);
+          consumer_waiting_.store(false, std::memory_order_relaxed);
+          cond_var_->notify_all();
+        }
+      }
+    }
+
+    Status WriteBufferElement(IteratorStateWriter* writer, size_t index,
+                              const BufferElement& element)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(*mu_) {
+      TF_RETURN_IF_ERROR(WriteStatus(writer, index, element.status));
+      if (element.status.ok()) {
+        TF_RETURN_IF_ERROR(writer->WriteScalar(
+            absl::StrCat(prefix(), "::", index),
+            absl::StrCat(kBuffer, kSizeSuffix), element.value.size()));
+        for (size_t j = 0; j < element.value.size(); j++) {
+          TF_RETURN_IF_ERROR(writer->WriteTensor(
+              absl::StrCat(prefix(), "::", index),
+              absl::StrCat(kBuffer, "[", j, "]"), element.value[j]));
+        }
+      }
+      return absl::OkStatus();
+    }
+
     Status WriteStatus(IteratorStateWriter* writer, size_t index,
                        const Status& status) TF_EXCLUSIVE_LOCKS_REQUIRED(*mu_) {
       TF_RETURN_IF_ERROR(
@@ -636,6 +967,16 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
     const int64_t buffer_size_min_;
     std::unique_ptr<PrefetchAutotuner> auto_tuner_ TF_GUARDED_BY(*mu_);
     std::deque<BufferElement> buffer_ TF_GUARDED_BY(*mu_);
+    // Non-null iff this iterator uses the lock-free ring instead of
+    // `buffer_` (TF_DATA_PREFETCH_LOCKFREE with a static buffer size and
+    // no slack). Unused capacity aside, the two are interchangeable: the
+    // ring holds the same BufferElements in the same order.
+    std::unique_ptr<LockFreeRing> ring_;
+    // Edge-of-buffer handshake flags for ring mode. A side sets its flag
+    // before blocking on `cond_var_`; the other side checks the flag after
+    // every push/pop and, if set, grabs `mu_` and notifies.
+    std::atomic<bool> consumer_waiting_{false};
+    std::atomic<bool> producer_waiting_{false};
     bool cancelled_ TF_GUARDED_BY(*mu_) = false;
     bool prefetch_thread_finished_ TF_GUARDED_BY(*mu_) = false;
     const bool legacy_autotune_;
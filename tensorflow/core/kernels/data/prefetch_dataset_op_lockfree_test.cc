@@ -0,0 +1,137 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Tests for the TF_DATA_PREFETCH_LOCKFREE ring-buffer mode of
+// PrefetchDataset. These live in their own binary because the flag is
+// latched in a function-local static the first time an iterator is
+// constructed, so it must be set before any other test touches prefetch.
+
+#include "tensorflow/core/kernels/data/prefetch_dataset_op.h"
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/data/dataset_test_base.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+constexpr char kNodeName[] = "prefetch_dataset";
+
+class PrefetchDatasetOpLockFreeTest : public DatasetOpsTestBase {
+ protected:
+  void SetUp() override {
+    setenv("TF_DATA_PREFETCH_LOCKFREE", "true", /*overwrite=*/1);
+    DatasetOpsTestBase::SetUp();
+  }
+};
+
+class PrefetchDatasetParams : public DatasetParams {
+ public:
+  template <typename T>
+  PrefetchDatasetParams(T input_dataset_params, int64_t buffer_size,
+                        string node_name)
+      : DatasetParams({DT_INT64}, {PartialTensorShape({})},
+                      std::move(node_name)),
+        buffer_size_(buffer_size) {
+    input_dataset_params_.push_back(std::make_unique<T>(input_dataset_params));
+    iterator_prefix_ =
+        name_utils::IteratorPrefix(input_dataset_params.dataset_type(),
+                                   input_dataset_params.iterator_prefix());
+  }
+
+  std::vector<Tensor> GetInputTensors() const override {
+    return {CreateTensor<int64_t>(TensorShape({}), {buffer_size_})};
+  }
+
+  Status GetInputNames(std::vector<string>* input_names) const override {
+    input_names->clear();
+    input_names->emplace_back(PrefetchDatasetOp::kInputDataset);
+    input_names->emplace_back(PrefetchDatasetOp::kBufferSize);
+    return absl::OkStatus();
+  }
+
+  Status GetAttributes(AttributeVector* attr_vector) const override {
+    attr_vector->clear();
+    attr_vector->emplace_back("output_types", output_dtypes_);
+    attr_vector->emplace_back("output_shapes", output_shapes_);
+    attr_vector->emplace_back("slack_period", int64_t{0});
+    attr_vector->emplace_back("legacy_autotune", true);
+    attr_vector->emplace_back("buffer_size_min", int64_t{0});
+    attr_vector->emplace_back("metadata", "");
+    return absl::OkStatus();
+  }
+
+  string dataset_type() const override {
+    return PrefetchDatasetOp::kDatasetType;
+  }
+
+ private:
+  int64_t buffer_size_;
+};
+
+PrefetchDatasetParams LockFreePrefetchDatasetParams(int64_t num_elements,
+                                                    int64_t buffer_size) {
+  return PrefetchDatasetParams(
+      /*input_dataset_params=*/RangeDatasetParams(0, num_elements, 1),
+      /*buffer_size=*/buffer_size,
+      /*node_name=*/kNodeName);
+}
+
+// Stress test for the `consumer_waiting_` / `producer_waiting_` wakeup
+// handshake. With a single-element ring every push fills the ring and
+// every pop empties it, so the producer and consumer continually race at
+// exactly the boundary where a lost wakeup deadlocks both sides; a missing
+// fence shows up as a hang rather than a wrong element. Several iterator
+// rounds give the race more chances to fire.
+TEST_F(PrefetchDatasetOpLockFreeTest, StressSingleElementBuffer) {
+  constexpr int64_t kNumElements = 2000;
+  constexpr int kNumRounds = 5;
+  auto dataset_params = LockFreePrefetchDatasetParams(kNumElements,
+                                                      /*buffer_size=*/1);
+  std::vector<Tensor> expected_outputs;
+  expected_outputs.reserve(kNumElements);
+  for (int64_t i = 0; i < kNumElements; ++i) {
+    expected_outputs.push_back(CreateTensor<int64_t>(TensorShape({}), {i}));
+  }
+  TF_ASSERT_OK(InitializeRuntime(dataset_params));
+  std::unique_ptr<TestDataset> dataset;
+  TF_ASSERT_OK(MakeDataset(dataset_params, &dataset));
+  for (int round = 0; round < kNumRounds; ++round) {
+    std::unique_ptr<TestIterator> iterator;
+    TF_ASSERT_OK(MakeIterator(dataset_params, *dataset, &iterator));
+    TF_ASSERT_OK(CheckIteratorGetNext(iterator.get(), expected_outputs,
+                                      /*compare_order=*/true));
+  }
+}
+
+// A larger ring keeps both sides off the boundary most of the time, which
+// exercises the steady-state path where neither `mu_` nor `cond_var_` is
+// touched.
+TEST_F(PrefetchDatasetOpLockFreeTest, GetNextLargerBuffer) {
+  constexpr int64_t kNumElements = 1000;
+  auto dataset_params = LockFreePrefetchDatasetParams(kNumElements,
+                                                      /*buffer_size=*/4);
+  std::vector<Tensor> expected_outputs;
+  expected_outputs.reserve(kNumElements);
+  for (int64_t i = 0; i < kNumElements; ++i) {
+    expected_outputs.push_back(CreateTensor<int64_t>(TensorShape({}), {i}));
+  }
+  TF_ASSERT_OK(Initialize(dataset_params));
+  TF_ASSERT_OK(CheckIteratorGetNext(expected_outputs, /*compare_order=*/true));
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
@@ -15,19 +15,26 @@ limitations under the License.
 #include "tensorflow/core/kernels/data/tf_record_dataset_op.h"
 
 #include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
 
+#include "absl/strings/string_view.h"
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/data/utils.h"
 #include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/hash/crc32c.h"
 #include "tensorflow/core/lib/io/buffered_inputstream.h"
 #include "tensorflow/core/lib/io/inputbuffer.h"
 #include "tensorflow/core/lib/io/random_inputstream.h"
 #include "tensorflow/core/lib/io/record_reader.h"
 #include "tensorflow/core/lib/io/zlib_compression_options.h"
 #include "tensorflow/core/lib/io/zlib_inputstream.h"
+#include "tensorflow/core/platform/coding.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -59,6 +66,124 @@ bool is_cloud_tpu_gcs_fs() {
   return false;
 }
 
+// Returns true if uncompressed TFRecord files should be memory-mapped and
+// read zero-copy instead of being copied record by record into tstrings.
+bool MmapModeEnabled() {
+  static bool result = [] {
+    bool mmap_enabled = false;
+    Status s = ReadBoolFromEnvVar("TF_TFRECORD_DATASET_MMAP",
+                                  /*default_val=*/false, &mmap_enabled);
+    if (!s.ok()) {
+      LOG(ERROR) << s.message();
+    }
+    return mmap_enabled;
+  }();
+  return result;
+}
+
+// Returns true if the payload checksum of every record should be verified in
+// mmap mode. By default only record headers (and the first record of each
+// file) are verified; the payload CRC pass is what the zero-copy path is
+// trying to avoid.
+bool MmapVerifyDataCrc() {
+  static bool result = [] {
+    bool verify = false;
+    Status s = ReadBoolFromEnvVar("TF_TFRECORD_DATASET_MMAP_VERIFY_CRC",
+                                  /*default_val=*/false, &verify);
+    if (!s.ok()) {
+      LOG(ERROR) << s.message();
+    }
+    return verify;
+  }();
+  return result;
+}
+
+// Reads records sequentially from a memory-mapped TFRecord file. ReadRecord
+// returns string_views pointing directly into the mapped pages, so records
+// are never copied; callers must keep the region alive for as long as any
+// returned view (see Dataset::RetainRegion).
+//
+// Record length CRCs are always checked (they are 8 cheap bytes and guard
+// the framing); payload CRCs are checked for the first record of the file
+// and, when `verify_data_crc` is set, for every record.
+class MmapRecordReader {
+ public:
+  MmapRecordReader(const ReadOnlyMemoryRegion* region, bool verify_data_crc)
+      : base_(static_cast<const char*>(region->data())),
+        size_(region->length()),
+        verify_data_crc_(verify_data_crc) {}
+
+  Status ReadRecord(absl::string_view* record) {
+    const bool first_record = offset_ == 0;
+    uint64 length;
+    TF_RETURN_IF_ERROR(ReadHeader(&length));
+    const char* data = base_ + offset_ + io::RecordReader::kHeaderSize;
+    if (verify_data_crc_ || first_record) {
+      const uint32 masked_crc = core::DecodeFixed32(data + length);
+      if (crc32c::Unmask(masked_crc) != crc32c::Value(data, length)) {
+        return errors::DataLoss("corrupted record at ", offset_);
+      }
+    }
+    *record = absl::string_view(data, length);
+    offset_ += io::RecordReader::kHeaderSize + length +
+               io::RecordReader::kFooterSize;
+    return absl::OkStatus();
+  }
+
+  Status SkipRecords(int64_t num_to_skip, int64_t* num_skipped) {
+    *num_skipped = 0;
+    while (*num_skipped < num_to_skip) {
+      uint64 length;
+      TF_RETURN_IF_ERROR(ReadHeader(&length));
+      offset_ += io::RecordReader::kHeaderSize + length +
+                 io::RecordReader::kFooterSize;
+      (*num_skipped)++;
+    }
+    return absl::OkStatus();
+  }
+
+  uint64 TellOffset() const { return offset_; }
+
+  Status SeekOffset(uint64 offset) {
+    if (offset > size_) {
+      return errors::InvalidArgument(
+          "Trying to seek offset: ", offset,
+          " which is larger than the mapped file size: ", size_);
+    }
+    offset_ = offset;
+    return absl::OkStatus();
+  }
+
+ private:
+  // Validates the record framing at `offset_` and returns the payload
+  // length. Does not advance `offset_`.
+  Status ReadHeader(uint64* length) {
+    if (offset_ == size_) {
+      return errors::OutOfRange("eof");
+    }
+    if (offset_ + io::RecordReader::kHeaderSize > size_) {
+      return errors::DataLoss("truncated record header at ", offset_);
+    }
+    const char* header = base_ + offset_;
+    *length = core::DecodeFixed64(header);
+    const uint32 masked_crc = core::DecodeFixed32(header + sizeof(uint64));
+    if (crc32c::Unmask(masked_crc) != crc32c::Value(header, sizeof(uint64))) {
+      return errors::DataLoss("corrupted record length at ", offset_);
+    }
+    if (offset_ + io::RecordReader::kHeaderSize + *length +
+            io::RecordReader::kFooterSize >
+        size_) {
+      return errors::DataLoss("truncated record at ", offset_);
+    }
+    return absl::OkStatus();
+  }
+
+  const char* const base_;
+  const uint64 size_;
+  const bool verify_data_crc_;
+  uint64 offset_ = 0;
+};
+
 class TFRecordDatasetOp::Dataset : public DatasetBase {
  public:
   explicit Dataset(OpKernelContext* ctx, std::vector<string> filenames,
@@ -70,7 +195,8 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
         options_(io::RecordReaderOptions::CreateRecordReaderOptions(
             compression_type)),
         byte_offsets_(std::move(byte_offsets)),
-        op_version_(op_version) {
+        op_version_(op_version),
+        mmap_enabled_(MmapModeEnabled() && compression_type.empty()) {
     if (buffer_size > 0) {
       options_.buffer_size = buffer_size;
     }
@@ -125,6 +251,17 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
   }
 
  private:
+  // Takes ownership of `region` and keeps it alive until the dataset is
+  // destroyed: string_view-backed record tensors handed out in mmap mode
+  // may flow arbitrarily far down the input pipeline, so the mapped pages
+  // must outlive the reading iterator.
+  const ReadOnlyMemoryRegion* RetainRegion(
+      std::unique_ptr<ReadOnlyMemoryRegion> region) const {
+    mutex_lock l(regions_mu_);
+    retained_regions_.push_back(std::move(region));
+    return retained_regions_.back().get();
+  }
+
   class Iterator : public DatasetIterator<Dataset> {
    public:
     explicit Iterator(const Params& params)
@@ -138,8 +275,40 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       out_tensors->reserve(1);
       mutex_lock l(mu_);
       do {
-        // We are currently processing a file, so try to read the next record.
-        if (reader_) {
+        // We are currently processing a memory-mapped file, so try to slice
+        // out the next record without copying it.
+        if (mmap_reader_) {
+          absl::string_view record;
+          Status s = mmap_reader_->ReadRecord(&record);
+          if (s.ok()) {
+            static monitoring::CounterCell* bytes_counter =
+                metrics::GetTFDataBytesReadCounter(kDatasetType);
+            bytes_counter->IncrementBy(record.size());
+            out_tensors->emplace_back(ctx->allocator({}), DT_STRING,
+                                      TensorShape({}));
+            // The tensor views the mapped pages, which stay alive as long
+            // as the dataset (see RetainRegion).
+            out_tensors->back().scalar<tstring>()().assign_as_view(
+                record.data(), record.size());
+            *end_of_sequence = false;
+            return absl::OkStatus();
+          }
+          if (!errors::IsOutOfRange(s)) {
+            // In case of other errors e.g., DataLoss, we still move forward
+            // the file index so that it works with ignore_errors.
+            // Otherwise the same file will repeat.
+            ResetStreamsLocked();
+            ++current_file_index_;
+            return s;
+          }
+
+          // We have reached the end of the current file, so maybe move on to
+          // next file.
+          ResetStreamsLocked();
+          ++current_file_index_;
+        } else if (reader_) {
+          // We are currently processing a file, so try to read the next
+          // record.
           out_tensors->emplace_back(ctx->allocator({}), DT_STRING,
                                     TensorShape({}));
           Status s =
@@ -185,7 +354,29 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       do {
         // We are currently processing a file, so try to skip reading
         // the next (num_to_skip - *num_skipped) record.
-        if (reader_) {
+        if (mmap_reader_) {
+          int64_t last_num_skipped;
+          Status s = mmap_reader_->SkipRecords(num_to_skip - *num_skipped,
+                                               &last_num_skipped);
+          *num_skipped += last_num_skipped;
+          if (s.ok()) {
+            *end_of_sequence = false;
+            return absl::OkStatus();
+          }
+          if (!errors::IsOutOfRange(s)) {
+            // In case of other errors e.g., DataLoss, we still move forward
+            // the file index so that it works with ignore_errors.
+            // Otherwise the same file will repeat.
+            ResetStreamsLocked();
+            ++current_file_index_;
+            return s;
+          }
+
+          // We have reached the end of the current file, so maybe move on to
+          // next file.
+          ResetStreamsLocked();
+          ++current_file_index_;
+        } else if (reader_) {
           int last_num_skipped;
           Status s = reader_->SkipRecords(num_to_skip - *num_skipped,
                                           &last_num_skipped);
@@ -231,7 +422,10 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       TF_RETURN_IF_ERROR(writer->WriteScalar(prefix(), kCurrentFileIndex,
                                              current_file_index_));
 
-      if (reader_) {
+      if (mmap_reader_) {
+        TF_RETURN_IF_ERROR(
+            writer->WriteScalar(prefix(), kOffset, mmap_reader_->TellOffset()));
+      } else if (reader_) {
         TF_RETURN_IF_ERROR(
             writer->WriteScalar(prefix(), kOffset, reader_->TellOffset()));
       }
@@ -250,7 +444,11 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
         int64_t offset;
         TF_RETURN_IF_ERROR(reader->ReadScalar(prefix(), kOffset, &offset));
         TF_RETURN_IF_ERROR(SetupStreamsLocked(ctx->env()));
-        TF_RETURN_IF_ERROR(reader_->SeekOffset(offset));
+        if (mmap_reader_) {
+          TF_RETURN_IF_ERROR(mmap_reader_->SeekOffset(offset));
+        } else {
+          TF_RETURN_IF_ERROR(reader_->SeekOffset(offset));
+        }
       }
       return absl::OkStatus();
     }
@@ -264,6 +462,27 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
             " >= filenames_.size():", dataset()->filenames_.size());
       }
 
+      if (dataset()->mmap_enabled_) {
+        std::unique_ptr<ReadOnlyMemoryRegion> region;
+        Status s = env->NewReadOnlyMemoryRegionFromFile(
+            TranslateFileName(dataset()->filenames_[current_file_index_]),
+            &region);
+        if (s.ok()) {
+          mmap_reader_ = std::make_unique<MmapRecordReader>(
+              dataset()->RetainRegion(std::move(region)), MmapVerifyDataCrc());
+          if (!dataset()->byte_offsets_.empty()) {
+            TF_RETURN_IF_ERROR(mmap_reader_->SeekOffset(
+                dataset()->byte_offsets_[current_file_index_]));
+          }
+          return absl::OkStatus();
+        }
+        // Fall back to the copying reader, e.g. for file systems that do
+        // not support memory mapping.
+        VLOG(1) << "Could not memory-map "
+                << dataset()->filenames_[current_file_index_] << ": "
+                << s.message();
+      }
+
       // Actually move on to next file.
       TF_RETURN_IF_ERROR(env->NewRandomAccessFile(
           TranslateFileName(dataset()->filenames_[current_file_index_]),
@@ -279,6 +498,7 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
 
     // Resets all reader streams.
     void ResetStreamsLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      mmap_reader_.reset();
       reader_.reset();
       file_.reset();
     }
@@ -290,6 +510,9 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
     // we must destroy `reader_` before `file_`.
     std::unique_ptr<RandomAccessFile> file_ TF_GUARDED_BY(mu_);
     std::unique_ptr<io::SequentialRecordReader> reader_ TF_GUARDED_BY(mu_);
+    // Non-null while the current file is read zero-copy from a mapped
+    // region; `reader_` and `file_` stay null in that case.
+    std::unique_ptr<MmapRecordReader> mmap_reader_ TF_GUARDED_BY(mu_);
   };
 
   const std::vector<string> filenames_;
@@ -297,6 +520,13 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
   io::RecordReaderOptions options_;
   const std::vector<int64_t> byte_offsets_;
   const int op_version_;
+  const bool mmap_enabled_;
+  // Mapped regions backing zero-copy record tensors, kept until the dataset
+  // is destroyed. Virtual address space is cheap; the resident pages are
+  // reclaimed by the OS under memory pressure.
+  mutable mutex regions_mu_;
+  mutable std::vector<std::unique_ptr<ReadOnlyMemoryRegion>> retained_regions_
+      TF_GUARDED_BY(regions_mu_);
 };
 
 TFRecordDatasetOp::TFRecordDatasetOp(OpKernelConstruction* ctx)
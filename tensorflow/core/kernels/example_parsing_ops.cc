@@ -15,8 +15,10 @@ limitations under the License.
 
 // See docs in ../ops/parsing_ops.cc.
 
+#include <memory>
 #include <numeric>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "absl/base/call_once.h"
@@ -30,6 +32,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/array_slice.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/util/example_proto_fast_parsing.h"
 #include "tensorflow/core/util/example_proto_helper.h"
@@ -251,11 +254,67 @@ class ParseExampleOp : public OpKernel {
     auto names_t = names->flat<tstring>();
     absl::Span<const tstring> slice(serialized_t.data(), serialized_t.size());
     absl::Span<const tstring> names_slice(names_t.data(), names_t.size());
+    std::shared_ptr<const example::FastParseExamplePlan> plan;
+    TF_RETURN_IF_ERROR(GetOrCompilePlan(config, &plan));
     return FastParseExample(
-        config, slice, names_slice,
+        config, *plan, slice, names_slice,
         ctx->device()->tensorflow_cpu_worker_threads()->workers, result);
   }
 
+  // Returns a parse plan for `config`, reusing the previously compiled plan
+  // while the feature keys are unchanged.  The keys are inputs to the op, but
+  // in practice they are almost always constants, so after the first call the
+  // plan is reused for the lifetime of the kernel.  (The dtypes come from
+  // attrs and cannot change, so comparing keys is sufficient.)
+  Status GetOrCompilePlan(
+      const example::FastParseExampleConfig& config,
+      std::shared_ptr<const example::FastParseExamplePlan>* plan) const {
+    auto keys_match = [&config](const std::vector<tstring>& dense,
+                                const std::vector<tstring>& sparse,
+                                const std::vector<tstring>& ragged) {
+      if (dense.size() != config.dense.size() ||
+          sparse.size() != config.sparse.size() ||
+          ragged.size() != config.ragged.size()) {
+        return false;
+      }
+      for (size_t d = 0; d < dense.size(); ++d) {
+        if (dense[d] != config.dense[d].feature_name) return false;
+      }
+      for (size_t d = 0; d < sparse.size(); ++d) {
+        if (sparse[d] != config.sparse[d].feature_name) return false;
+      }
+      for (size_t d = 0; d < ragged.size(); ++d) {
+        if (ragged[d] != config.ragged[d].feature_name) return false;
+      }
+      return true;
+    };
+
+    mutex_lock l(mu_);
+    if (plan_ != nullptr &&
+        keys_match(plan_dense_keys_, plan_sparse_keys_, plan_ragged_keys_)) {
+      *plan = plan_;
+      return absl::OkStatus();
+    }
+    auto new_plan = std::make_shared<example::FastParseExamplePlan>();
+    TF_RETURN_IF_ERROR(
+        example::FastParseExamplePlan::Compile(config, new_plan.get()));
+    plan_dense_keys_.clear();
+    plan_sparse_keys_.clear();
+    plan_ragged_keys_.clear();
+    for (const auto& d : config.dense) {
+      plan_dense_keys_.push_back(d.feature_name);
+    }
+    for (const auto& s : config.sparse) {
+      plan_sparse_keys_.push_back(s.feature_name);
+    }
+    for (const auto& r : config.ragged) {
+      plan_ragged_keys_.push_back(r.feature_name);
+    }
+    plan_ = std::move(new_plan);
+    *plan = plan_;
+    return absl::OkStatus();
+  }
+
   Status WriteOutput(const example::Result& result,
                      OpKernelContext* ctx) const {
     OpOutputList dense_values;
@@ -290,6 +349,14 @@ class ParseExampleOp : public OpKernel {
   ParseExampleAttrs attrs_;
   int op_version_;
   absl::once_flag flag_;
+
+  // Cached parse plan and the feature keys it was compiled for.  Guarded by a
+  // mutex because Compute may run concurrently for the same kernel instance.
+  mutable mutex mu_;
+  std::vector<tstring> plan_dense_keys_ TF_GUARDED_BY(mu_);
+  std::vector<tstring> plan_sparse_keys_ TF_GUARDED_BY(mu_);
+  std::vector<tstring> plan_ragged_keys_ TF_GUARDED_BY(mu_);
+  std::shared_ptr<const example::FastParseExamplePlan> plan_ TF_GUARDED_BY(mu_);
 };
 
 REGISTER_KERNEL_BUILDER(Name("ParseExample").Device(DEVICE_CPU),
@@ -50,6 +50,34 @@ void FIFOQueue::DequeueLocked(OpKernelContext* ctx, Tuple* tuple) {
 
 void FIFOQueue::TryEnqueue(const Tuple& tuple, OpKernelContext* ctx,
                            DoneCallback callback) {
+  // Fast path: if the queue is open, has spare capacity and no enqueue
+  // attempts are already waiting (which would have to complete first to
+  // keep FIFO order), the element can be added under a single lock
+  // acquisition, skipping the cancellation registration and the attempt
+  // machinery entirely. This is the common case for steady-state
+  // producer/consumer pipelines and avoids convoying on the queue mutex.
+  {
+    bool enqueued = false;
+    bool flush_needed = false;
+    {
+      mutex_lock l(mu_);
+      if (!closed_ && enqueue_attempts_.empty() &&
+          queues_[0].size() < static_cast<size_t>(capacity_)) {
+        for (int i = 0; i < num_components(); ++i) {
+          queues_[i].push_back(tuple[i]);
+        }
+        enqueued = true;
+        // The new element may satisfy a blocked dequeue attempt.
+        flush_needed = !dequeue_attempts_.empty();
+      }
+    }
+    if (enqueued) {
+      if (flush_needed) FlushUnlocked();
+      callback();
+      return;
+    }
+  }
+
   CancellationManager* cm = ctx->cancellation_manager();
   CancellationToken token = cm->get_cancellation_token();
   bool already_cancelled;
@@ -153,6 +181,30 @@ void FIFOQueue::TryEnqueueMany(const Tuple& tuple, OpKernelContext* ctx,
 }
 
 void FIFOQueue::TryDequeue(OpKernelContext* ctx, CallbackWithTuple callback) {
+  // Fast path mirroring TryEnqueue: when an element is ready and no dequeue
+  // attempts are queued ahead of us, pop it under a single lock acquisition
+  // and skip the attempt machinery. Valid for closed queues too, which may
+  // still be drained.
+  {
+    Tuple tuple;
+    bool dequeued = false;
+    bool flush_needed = false;
+    {
+      mutex_lock l(mu_);
+      if (dequeue_attempts_.empty() && !queues_[0].empty()) {
+        DequeueLocked(ctx, &tuple);
+        dequeued = true;
+        // The freed capacity may unblock a waiting enqueue attempt.
+        flush_needed = !enqueue_attempts_.empty();
+      }
+    }
+    if (dequeued) {
+      if (flush_needed) FlushUnlocked();
+      callback(tuple);
+      return;
+    }
+  }
+
   CancellationManager* cm = ctx->cancellation_manager();
   CancellationToken token = cm->get_cancellation_token();
   bool already_cancelled;
@@ -123,6 +123,15 @@ Status InitializeFusedComputation(
     }
   }
 
+  if (*fused_computation == FusedComputationType::kBiasAddWithAdd) {
+    if (num_args != 2) {
+      return errors::InvalidArgument(
+          "Fused ", kernel_name,
+          " with BiasAdd and Add must have two extra arguments: bias and "
+          "addend");
+    }
+  }
+
   if (*fused_computation == FusedComputationType::kFusedBatchNorm ||
       *fused_computation == FusedComputationType::kFusedBatchNormWithRelu ||
       *fused_computation == FusedComputationType::kFusedBatchNormWithRelu6 ||
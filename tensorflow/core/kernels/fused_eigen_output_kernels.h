@@ -46,6 +46,7 @@ enum class FusedComputationType {
   kBiasAddWithLeakyRelu,
   kBiasAddWithGeluApproximate,
   kBiasAddWithGeluExact,
+  kBiasAddWithAdd,
   kFusedBatchNorm,
   kFusedBatchNormWithRelu,
   kFusedBatchNormWithRelu6,
@@ -136,6 +137,23 @@ struct Elu {
   };
 };
 
+// Applies the tanh-based `GeluApproximate` to the passed input expression:
+//   0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+struct GeluApproximate {
+  template <typename XprType>
+  static auto apply(XprType expr) {
+    using Scalar = typename XprType::Scalar;
+    const Scalar kSqrtTwoOverPi = static_cast<Scalar>(0.7978845608028654);
+    const Scalar kEmpirical = static_cast<Scalar>(0.044715);
+    return expr *
+           (((expr + expr.cube() * expr.constant(kEmpirical)) *
+             expr.constant(kSqrtTwoOverPi))
+                .tanh() +
+            expr.constant(static_cast<Scalar>(1))) *
+           expr.constant(static_cast<Scalar>(0.5));
+  };
+};
+
 // Applies `LeakyRelu` to the passed input expression.
 struct LeakyRelu {
   template <typename XprType>
@@ -156,6 +174,12 @@ struct BiasAddArgs {
   const T* bias_add_data = nullptr;
   float leakyrelu_alpha;
 
+  // Used by the `kBiasAddWithAdd` (residual) fusion only: an addend with the
+  // same shape as the contraction output, stored row-major with `addend_ld`
+  // elements between consecutive rows.
+  const T* addend_data = nullptr;
+  int64_t addend_ld = 0;
+
   static bool IsSupported(FusedComputationType fusion) {
     return fusion == FusedComputationType::kBiasAdd ||
            fusion == FusedComputationType::kBiasAddWithRelu ||
@@ -163,7 +187,9 @@ struct BiasAddArgs {
            fusion == FusedComputationType::kBiasAddWithTanh ||
            fusion == FusedComputationType::kBiasAddWithSigmoid ||
            fusion == FusedComputationType::kBiasAddWithElu ||
-           fusion == FusedComputationType::kBiasAddWithLeakyRelu;
+           fusion == FusedComputationType::kBiasAddWithLeakyRelu ||
+           fusion == FusedComputationType::kBiasAddWithGeluApproximate ||
+           fusion == FusedComputationType::kBiasAddWithAdd;
   }
 };
 
@@ -292,6 +318,49 @@ struct BiasAddOutputKernel<T, LeakyRelu> {
   float leakyrelu_alpha;
 };
 
+// Output kernel that fuses BiasAdd and a residual Add into the output of
+// tensor contraction. The addend must have the same shape as the contraction
+// output. Only valid for MatMul contractions, where every column of an output
+// block is a slice of an output row starting at offset `i` (see the layout
+// notes above), so the matching addend slice starts at row `j + col`, column
+// `i`.
+template <typename T>
+struct BiasAddAndAddOutputKernel {
+  explicit BiasAddAndAddOutputKernel(const BiasAddArgs<T>& args)
+      : bias_data(args.bias_add_data),
+        addend_data(args.addend_data),
+        addend_ld(args.addend_ld) {}
+
+  template <typename StorageIndex, typename Scalar>
+  EIGEN_ALWAYS_INLINE void operator()(
+      const ContractionOutputMapper<Scalar, StorageIndex>& output_mapper,
+      const Eigen::TensorContractionParams& params, StorageIndex i,
+      StorageIndex j, StorageIndex num_rows, StorageIndex num_cols) const {
+    DCHECK(params.swapped_arguments);
+
+    const T* bias_base = bias_data + i;
+    typename TTypes<T>::UnalignedConstTensor bias(bias_base, num_rows);
+
+    for (int col = 0; col < num_cols; ++col) {
+      Scalar* output_base = &output_mapper(0, col);
+      typename TTypes<Scalar>::UnalignedTensor output(output_base, num_rows);
+      const T* addend_base = addend_data + (j + col) * addend_ld + i;
+      typename TTypes<T>::UnalignedConstTensor addend(addend_base, num_rows);
+      if constexpr (std::is_same_v<Scalar, T>) {
+        output = output + bias + addend;
+      } else {
+        output = output + bias.template cast<Scalar>() +
+                 addend.template cast<Scalar>();
+      }
+    }
+  }
+
+ private:
+  const T* bias_data;
+  const T* addend_data;
+  int64_t addend_ld;
+};
+
 // Output kernel that fuses FusedBatchNorm operation into the output of tensor
 // contraction + activation function defined by Activation.
 template <typename T, typename Activation = Identity>
@@ -398,6 +467,10 @@ using WithBiasAddAndElu = BiasAddOutputKernel<T, Elu>;
 template <typename T>
 using WithBiasAddAndLeakyRelu = BiasAddOutputKernel<T, LeakyRelu>;
 template <typename T>
+using WithBiasAddAndGeluApproximate = BiasAddOutputKernel<T, GeluApproximate>;
+template <typename T>
+using WithBiasAddAndAdd = BiasAddAndAddOutputKernel<T>;
+template <typename T>
 using WithFusedBatchNorm = FusedBatchNormOutputKernel<T>;
 template <typename T>
 using WithFusedBatchNormAndRelu = FusedBatchNormOutputKernel<T, Relu>;
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include <functional>
 #include <memory>
+#include <numeric>
 #include <vector>
 
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
@@ -176,6 +177,35 @@ TEST_F(GatherOpTest, HighRank) {
   test::ExpectTensorEqual<float>(expected, *GetOutput(0));
 }
 
+TEST_F(GatherOpTest, ManyIndices_TwoD32) {
+  MakeOp(DT_FLOAT, DT_INT32);
+
+  // Use enough indices to exercise the software-prefetched copy loop beyond
+  // its prefetch distance.
+  constexpr int kNumRows = 16;
+  constexpr int kNumIndices = 40;
+  std::vector<float> params(kNumRows * 3);
+  std::iota(params.begin(), params.end(), 0.0f);
+  std::vector<int32> indices(kNumIndices);
+  for (int i = 0; i < kNumIndices; ++i) {
+    indices[i] = (i * 7) % kNumRows;
+  }
+  AddInputFromArray<float>(TensorShape({kNumRows, 3}), params);
+  AddInputFromArray<int32>(TensorShape({kNumIndices}), indices);
+  AddInputFromArray<int32>(TensorShape({}), {0});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({kNumIndices, 3}));
+  std::vector<float> expected_values(kNumIndices * 3);
+  for (int i = 0; i < kNumIndices; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      expected_values[i * 3 + j] = params[indices[i] * 3 + j];
+    }
+  }
+  test::FillValues<float>(&expected, expected_values);
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+}
+
 TEST_F(GatherOpTest, Error_IndexOutOfRange) {
   MakeOp(DT_FLOAT, DT_INT32);
 
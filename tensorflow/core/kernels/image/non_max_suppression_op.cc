@@ -364,10 +364,21 @@ void DoNMSPerClass(int batch_idx, int class_idx, const float* boxes_data,
   std::vector<int> selected;
   Candidate next_candidate;
 
-  int candidate_box_data_idx, selected_box_data_idx, class_box_idx;
+  // Structure-of-arrays copy of the boxes selected so far, with coordinates
+  // canonicalized and areas precomputed. This makes the suppression check
+  // below a tight loop over contiguous floats that the compiler can
+  // vectorize, instead of gathering strided coordinates and re-deriving the
+  // same mins/maxes/areas for every candidate.
+  std::vector<float> sel_ymin, sel_xmin, sel_ymax, sel_xmax, sel_area;
+  sel_ymin.reserve(size_per_class);
+  sel_xmin.reserve(size_per_class);
+  sel_ymax.reserve(size_per_class);
+  sel_xmax.reserve(size_per_class);
+  sel_area.reserve(size_per_class);
+
+  int candidate_box_data_idx, class_box_idx;
   class_box_idx = (q > 1) ? class_idx : 0;
 
-  float iou;
   while (selected.size() < size_per_class &&
          !candidate_priority_queue.empty()) {
     next_candidate = candidate_priority_queue.top();
@@ -375,20 +386,41 @@ void DoNMSPerClass(int batch_idx, int class_idx, const float* boxes_data,
 
     candidate_box_data_idx = (next_candidate.box_index * q + class_box_idx) * 4;
 
-    // Overlapping boxes are likely to have similar scores,
-    // therefore we iterate through the previously selected boxes backwards
-    // in order to see if `next_candidate` should be suppressed.
+    const float* box = boxes_data + candidate_box_data_idx;
+    const float ymin = Eigen::numext::mini<float>(box[0], box[2]);
+    const float xmin = Eigen::numext::mini<float>(box[1], box[3]);
+    const float ymax = Eigen::numext::maxi<float>(box[0], box[2]);
+    const float xmax = Eigen::numext::maxi<float>(box[1], box[3]);
+    const float area = (ymax - ymin) * (xmax - xmin);
+
+    // A degenerate candidate has IoU 0 with everything and is never
+    // suppressed. A degenerate selected box contributes an intersection of 0
+    // below, so it never suppresses anything either, matching IOU().
     bool should_select = true;
-    for (int j = selected.size() - 1; j >= 0; --j) {
-      selected_box_data_idx = (selected[j] * q + class_box_idx) * 4;
-      iou = IOU(boxes_data, candidate_box_data_idx, selected_box_data_idx);
-      if (iou > iou_threshold) {
-        should_select = false;
-        break;
+    if (area > 0) {
+      bool suppressed = false;
+      const int num_selected = sel_area.size();
+      for (int j = 0; j < num_selected; ++j) {
+        const float inter_h =
+            Eigen::numext::mini<float>(ymax, sel_ymax[j]) -
+            Eigen::numext::maxi<float>(ymin, sel_ymin[j]);
+        const float inter_w =
+            Eigen::numext::mini<float>(xmax, sel_xmax[j]) -
+            Eigen::numext::maxi<float>(xmin, sel_xmin[j]);
+        const float intersection = Eigen::numext::maxi<float>(inter_h, 0.0f) *
+                                   Eigen::numext::maxi<float>(inter_w, 0.0f);
+        const float iou = intersection / (area + sel_area[j] - intersection);
+        suppressed |= (iou > iou_threshold);
       }
+      should_select = !suppressed;
     }
 
     if (should_select) {
+      sel_ymin.push_back(ymin);
+      sel_xmin.push_back(xmin);
+      sel_ymax.push_back(ymax);
+      sel_xmax.push_back(xmax);
+      sel_area.push_back(area);
       // Add the selected box to the result candidate. Sorted by score
       result_candidate_vec[selected.size() + size_per_class * class_idx] = {
           next_candidate.box_index,
@@ -138,6 +138,18 @@ struct LaunchFusedMatMulOp<CPUDevice, T> {
       }
     }
 
+    if (fusion == FusedComputationType::kBiasAddWithAdd) {
+      // The residual addend is passed as the extra argument after the bias.
+      const Tensor& addend = context->input(3);
+      OP_REQUIRES(context, addend.shape() == output->shape(),
+                  errors::InvalidArgument(
+                      "addend must have the same shape as the output: ",
+                      addend.shape().DebugString(), " vs. ",
+                      output->shape().DebugString()));
+      bias_add_args.addend_data = addend.flat<T>().data();
+      bias_add_args.addend_ld = output->dim_size(1);
+    }
+
     switch (fusion) {
       case FusedComputationType::kBiasAdd:
         executeWithOutputKernel(WithBiasAdd<T>(bias_add_args));
@@ -160,6 +172,13 @@ struct LaunchFusedMatMulOp<CPUDevice, T> {
       case FusedComputationType::kBiasAddWithLeakyRelu:
         executeWithOutputKernel(WithBiasAddAndLeakyRelu<T>(bias_add_args));
         break;
+      case FusedComputationType::kBiasAddWithGeluApproximate:
+        executeWithOutputKernel(
+            WithBiasAddAndGeluApproximate<T>(bias_add_args));
+        break;
+      case FusedComputationType::kBiasAddWithAdd:
+        executeWithOutputKernel(WithBiasAddAndAdd<T>(bias_add_args));
+        break;
       case FusedComputationType::kUndefined:
         OP_REQUIRES_OK(context, errors::Internal("Fusion type is undefined"));
         break;
@@ -640,6 +659,8 @@ class FusedMatMulOp : public OpKernel {
           {FCT::kBiasAddWithSigmoid, {"BiasAdd", "Sigmoid"}},
           {FCT::kBiasAddWithElu, {"BiasAdd", "Elu"}},
           {FCT::kBiasAddWithLeakyRelu, {"BiasAdd", "LeakyRelu"}},
+          {FCT::kBiasAddWithGeluApproximate, {"BiasAdd", "GeluApproximate"}},
+          {FCT::kBiasAddWithAdd, {"BiasAdd", "Add"}},
       };
     } else if (std::is_same<Device, GPUDevice>::value) {
       patterns = {
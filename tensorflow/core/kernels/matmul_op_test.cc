@@ -173,6 +173,29 @@ class FusedMatMulOpTest : public OpsTestBase {
     RunAndFetch(root, "with_activation", output, allow_gpu_device);
   }
 
+  void RunMatMulWithBiasAndAdd(const Tensor& lhs_data, const Tensor& rhs_data,
+                               const Tensor& bias_data,
+                               const Tensor& addend_data, bool transpose_a,
+                               bool transpose_b, Tensor* output) {
+    Scope root = tensorflow::Scope::NewRootScope();
+
+    ops::MatMul matmul = ops::MatMul(
+        root.WithOpName("matmul"),
+        ops::Const(root.WithOpName("lhs"), Input::Initializer(lhs_data)),
+        ops::Const(root.WithOpName("rhs"), Input::Initializer(rhs_data)),
+        ops::MatMul::Attrs().TransposeA(transpose_a).TransposeB(transpose_b));
+
+    ops::BiasAdd with_bias = ops::BiasAdd(
+        root.WithOpName("with_bias"), matmul,
+        ops::Const(root.WithOpName("bias"), Input::Initializer(bias_data)));
+
+    ops::AddV2(
+        root.WithOpName("with_add"), with_bias,
+        ops::Const(root.WithOpName("addend"), Input::Initializer(addend_data)));
+
+    RunAndFetch(root, "with_add", output, /*allow_gpu_device=*/false);
+  }
+
   void RunFusedMatMulOp(const Tensor& lhs_data, const Tensor& rhs_data,
                         const std::vector<Tensor>& args_data,
                         const std::vector<string>& fused_ops, bool transpose_a,
@@ -320,6 +343,38 @@ class FusedMatMulOpTest : public OpsTestBase {
     VerifyBiasAddTensorsNear(m, k, n, transpose_a, transpose_b, run_default,
                              run_fused);
   }
+
+  // Verifies that computing MatMul+BiasAdd+Add in a graph is identical to
+  // FusedMatMul with a residual addend. The addend fusion is implemented only
+  // for CPU.
+  void VerifyMatMulWithBiasAndAdd(int m, int k, int n, bool transpose_a,
+                                  bool transpose_b) {
+    DataType dtype = DataTypeToEnum<T>::v();
+
+    Tensor addend(dtype, {m, n});
+    addend.flat<T>() = addend.flat<T>().setRandom();
+
+    const BiasAddGraphRunner run_default =
+        [&](const Tensor& input_data, const Tensor& filter_data,
+            const Tensor& bias_data, Tensor* out) {
+          RunMatMulWithBiasAndAdd(input_data, filter_data, bias_data, addend,
+                                  transpose_a, transpose_b, out);
+          return false;
+        };
+
+    const BiasAddGraphRunner run_fused =
+        [&](const Tensor& input_data, const Tensor& filter_data,
+            const Tensor& bias_data, Tensor* out) {
+          bool skipped = false;
+          RunFusedMatMulOp(input_data, filter_data, {bias_data, addend},
+                           {"BiasAdd", "Add"}, transpose_a, transpose_b, out,
+                           /*allow_gpu_device=*/false, &skipped);
+          return skipped;
+        };
+
+    VerifyBiasAddTensorsNear(m, k, n, transpose_a, transpose_b, run_default,
+                             run_fused);
+  }
 };
 
 // MatMul with BatchNorm can be tested only with `T=float`, because default
@@ -405,6 +460,17 @@ TYPED_TEST_P(FusedMatMulWithBiasOpTest, MatMul1x256x1WithActivation) {
   }
 }
 
+TYPED_TEST_P(FusedMatMulWithBiasOpTest, MatMul256x128x64WithAdd) {
+  this->VerifyMatMulWithBiasAndAdd(256, 128, 64, false, false);
+  this->VerifyMatMulWithBiasAndAdd(256, 128, 64, true, false);
+  this->VerifyMatMulWithBiasAndAdd(256, 128, 64, false, true);
+  this->VerifyMatMulWithBiasAndAdd(256, 128, 64, true, true);
+}
+
+TYPED_TEST_P(FusedMatMulWithBiasOpTest, MatMul1x256x256WithAdd) {
+  this->VerifyMatMulWithBiasAndAdd(1, 256, 256, false, false);
+}
+
 REGISTER_TYPED_TEST_SUITE_P(FusedMatMulWithBiasOpTest,       //
                             MatMul256x128x64,                //
                             MatMul1x256x256,                 //
@@ -413,7 +479,9 @@ REGISTER_TYPED_TEST_SUITE_P(FusedMatMulWithBiasOpTest,       //
                             MatMul256x128x64WithActivation,  //
                             MatMul1x256x256WithActivation,   //
                             MatMul256x256x1WithActivation,   //
-                            MatMul1x256x1WithActivation);
+                            MatMul1x256x1WithActivation,     //
+                            MatMul256x128x64WithAdd,         //
+                            MatMul1x256x256WithAdd);
 
 // TODO(ezhulenev): Add support for more data types.
 using FusedBiasAddDataTypes = ::testing::Types<float, Eigen::half>;
@@ -0,0 +1,148 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// CPU kernel for _WeightOnlyQuantizedMatMul: fp32 activations times weights
+// stored as int8 or packed int4, with per-output-column scales. The weights
+// stay quantized in memory; each worker dequantizes one small column tile at
+// a time into a scratch buffer and multiplies it with Eigen, so the working
+// set read from memory per output is the quantized weights, not an fp32 copy.
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+
+#include "Eigen/Core"  // from @eigen_archive
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/op_requires.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+namespace {
+
+using RowMajorMatrix =
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+class WeightOnlyQuantizedMatMulOp : public OpKernel {
+ public:
+  explicit WeightOnlyQuantizedMatMulOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("weight_bits", &weight_bits_));
+    OP_REQUIRES(context, weight_bits_ == 4 || weight_bits_ == 8,
+                errors::InvalidArgument("weight_bits must be 4 or 8, got ",
+                                        weight_bits_));
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    const Tensor& a = ctx->input(0);
+    const Tensor& b = ctx->input(1);
+    const Tensor& scales = ctx->input(2);
+
+    OP_REQUIRES(ctx, TensorShapeUtils::IsMatrix(a.shape()),
+                errors::InvalidArgument("a must be a matrix, got shape ",
+                                        a.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsMatrix(b.shape()),
+                errors::InvalidArgument("b must be a matrix, got shape ",
+                                        b.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsVector(scales.shape()),
+                errors::InvalidArgument("scales must be a vector, got shape ",
+                                        scales.shape().DebugString()));
+
+    const int64_t m = a.dim_size(0);
+    const int64_t k = a.dim_size(1);
+    const int64_t n = b.dim_size(1);
+    const int64_t values_per_byte = 8 / weight_bits_;
+    OP_REQUIRES(ctx, b.dim_size(0) * values_per_byte == k,
+                errors::InvalidArgument(
+                    "b holds ", b.dim_size(0) * values_per_byte,
+                    " weights per column but a has inner dimension ", k));
+    OP_REQUIRES(ctx, scales.dim_size(0) == n,
+                errors::InvalidArgument("scales must have one entry per "
+                                        "output column; got ",
+                                        scales.dim_size(0), " for ", n,
+                                        " columns"));
+
+    Tensor* out = nullptr;
+    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, TensorShape({m, n}), &out));
+    if (m == 0 || n == 0) return;
+    if (k == 0) {
+      out->flat<float>().setZero();
+      return;
+    }
+
+    const float* a_data = a.flat<float>().data();
+    const int8* b_data = b.flat<int8>().data();
+    const float* scale_data = scales.flat<float>().data();
+    float* out_data = out->flat<float>().data();
+
+    // One unit of work dequantizes a [k, kColBlock] weight tile and computes
+    // the matching output columns.
+    constexpr int64_t kColBlock = 64;
+    const int64_t num_blocks = (n + kColBlock - 1) / kColBlock;
+    const int weight_bits = weight_bits_;
+    auto work = [&](int64_t start, int64_t limit) {
+      RowMajorMatrix tile(k, kColBlock);
+      for (int64_t block = start; block < limit; ++block) {
+        const int64_t col0 = block * kColBlock;
+        const int64_t cols = std::min(kColBlock, n - col0);
+        if (weight_bits == 8) {
+          for (int64_t kk = 0; kk < k; ++kk) {
+            const int8* row = b_data + kk * n + col0;
+            for (int64_t j = 0; j < cols; ++j) {
+              tile(kk, j) =
+                  static_cast<float>(row[j]) * scale_data[col0 + j];
+            }
+          }
+        } else {
+          for (int64_t kk = 0; kk < k; ++kk) {
+            const int8* row = b_data + (kk / 2) * n + col0;
+            const bool high_nibble = (kk & 1) != 0;
+            for (int64_t j = 0; j < cols; ++j) {
+              const int8 packed = row[j];
+              const int8 value =
+                  high_nibble
+                      ? static_cast<int8>(packed >> 4)
+                      : static_cast<int8>(static_cast<int8>(packed << 4) >> 4);
+              tile(kk, j) =
+                  static_cast<float>(value) * scale_data[col0 + j];
+            }
+          }
+        }
+        Eigen::Map<const RowMajorMatrix> a_matrix(a_data, m, k);
+        Eigen::Map<RowMajorMatrix, 0, Eigen::OuterStride<>> out_block(
+            out_data + col0, m, cols, Eigen::OuterStride<>(n));
+        out_block.noalias() = a_matrix * tile.topLeftCorner(k, cols);
+      }
+    };
+    // Dequantization reads k * kColBlock bytes and the GEMM performs
+    // 2 * m * k flops per column in the block.
+    const int64_t cost_per_block = k * kColBlock * (2 * m + 2);
+    auto worker_threads = *(ctx->device()->tensorflow_cpu_worker_threads());
+    Shard(worker_threads.num_threads, worker_threads.workers, num_blocks,
+          cost_per_block, work);
+  }
+
+ private:
+  int weight_bits_;
+};
+
+REGISTER_KERNEL_BUILDER(Name("_WeightOnlyQuantizedMatMul").Device(DEVICE_CPU),
+                        WeightOnlyQuantizedMatMulOp);
+
+}  // namespace
+}  // namespace tensorflow
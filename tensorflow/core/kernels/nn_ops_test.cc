@@ -1513,6 +1513,11 @@ BM_TopKCPU(32, 100, 2, 16, "topk_r_32_c_100_k_2_th_16");
 BM_TopKCPU(32, 100, 10, 16, "topk_r_32_c_100_k_10_th_16");
 BM_TopKCPU(32, 100, 50, 16, "topk_r_32_c_100_k_50_th_16");
 BM_TopKCPU(32, 100, 100, 16, "topk_r_32_c_100_k_100_th_16");
+// Wide single-row shapes with large k exercise the sharded per-row
+// selection path.
+BM_TopKCPU(1, 1048576, 1000, 16, "topk_r_1_c_1M_k_1000_th_16");
+BM_TopKCPU(1, 8388608, 1000, 16, "topk_r_1_c_8M_k_1000_th_16");
+BM_TopKCPU(4, 1048576, 1000, 16, "topk_r_4_c_1M_k_1000_th_16");
 BM_TopKCPU(128, 100, 1, 16, "topk_r_128_c_100_k_1_th_16");
 BM_TopKCPU(128, 100, 2, 16, "topk_r_128_c_100_k_2_th_16");
 BM_TopKCPU(128, 100, 10, 16, "topk_r_128_c_100_k_10_th_16");
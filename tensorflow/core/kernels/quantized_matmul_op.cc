@@ -28,6 +28,8 @@ limitations under the License.
 #include "tensorflow/core/kernels/reference_gemm.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
@@ -147,14 +149,30 @@ class QuantizedMatMulOp : public OpKernel {
     const size_t ldb = b.dim_size(1);
     const size_t ldc = n;
 
+    // When the weight operand is transposed, gemmlowp has to walk it with a
+    // stride of `ldb` while packing, every invocation. Serving weights are
+    // immutable, so optionally cache a row-major copy of the transposed
+    // weight once and hand gemmlowp the contiguous layout instead.
+    const T2* gemm_b_data = b_data;
+    bool gemm_transpose_b = transpose_b_;
+    size_t gemm_ldb = ldb;
+    Tensor b_transposed;
+    if (transpose_b_ && WeightCacheEnabled()) {
+      OP_REQUIRES_OK(context, GetTransposedWeight(context, b, &b_transposed));
+      gemm_b_data = b_transposed.flat<T2>().data();
+      gemm_transpose_b = false;
+      gemm_ldb = n;
+    }
+
     if (meta::IsSupportedAndEnabled() && std::is_same<T1, quint8>() &&
         std::is_same<T2, quint8>() && std::is_same<Toutput, qint32>() &&
         (offset_c == 0) && (mult_c == 1) && (shift_c == 0) &&
         (transpose_c == false) && (k <= 2048)) {
       // Gemmlowp/meta code path works on 32 & 64 bit Arm with NEON Simd and
       // allows optimized quantized 8bit to 32bit gemm.
-      meta::QuantizedGemm(context, transpose_a_, transpose_b_, a_data, b_data,
-                          c_data, m, n, k, -offset_a, -offset_b, lda, ldb, ldc);
+      meta::QuantizedGemm(context, transpose_a_, gemm_transpose_b, a_data,
+                          gemm_b_data, c_data, m, n, k, -offset_a, -offset_b,
+                          lda, gemm_ldb, ldc);
     } else if (std::is_same<T1, quint8>() && std::is_same<T2, quint8>() &&
                std::is_same<Toutput, qint32>() && (offset_c == 0) &&
                (mult_c == 1) && (shift_c == 0) && (transpose_c == false)) {
@@ -162,30 +180,31 @@ class QuantizedMatMulOp : public OpKernel {
       // types, so check if we meet those requirements and fall back to a slower
       // reference implementation if not.
       if (transpose_a_) {
-        if (transpose_b_) {
-          GemmlowpMultiply<true, true, false>(context, a_data, b_data, c_data,
-                                              m, n, k, offset_a, offset_b, lda,
-                                              ldb, ldc);
+        if (gemm_transpose_b) {
+          GemmlowpMultiply<true, true, false>(context, a_data, gemm_b_data,
+                                              c_data, m, n, k, offset_a,
+                                              offset_b, lda, gemm_ldb, ldc);
         } else {
-          GemmlowpMultiply<true, false, false>(context, a_data, b_data, c_data,
-                                               m, n, k, offset_a, offset_b, lda,
-                                               ldb, ldc);
+          GemmlowpMultiply<true, false, false>(context, a_data, gemm_b_data,
+                                               c_data, m, n, k, offset_a,
+                                               offset_b, lda, gemm_ldb, ldc);
         }
       } else {
-        if (transpose_b_) {
-          GemmlowpMultiply<false, true, false>(context, a_data, b_data, c_data,
-                                               m, n, k, offset_a, offset_b, lda,
-                                               ldb, ldc);
+        if (gemm_transpose_b) {
+          GemmlowpMultiply<false, true, false>(context, a_data, gemm_b_data,
+                                               c_data, m, n, k, offset_a,
+                                               offset_b, lda, gemm_ldb, ldc);
         } else {
-          GemmlowpMultiply<false, false, false>(context, a_data, b_data, c_data,
-                                                m, n, k, offset_a, offset_b,
-                                                lda, ldb, ldc);
+          GemmlowpMultiply<false, false, false>(context, a_data, gemm_b_data,
+                                                c_data, m, n, k, offset_a,
+                                                offset_b, lda, gemm_ldb, ldc);
         }
       }
     } else {
       ReferenceGemm<T1, T2, Toutput>(
-          transpose_a_, transpose_b_, transpose_c, m, n, k, a_data, offset_a,
-          lda, b_data, offset_b, ldb, c_data, shift_c, offset_c, mult_c, ldc);
+          transpose_a_, gemm_transpose_b, transpose_c, m, n, k, a_data,
+          offset_a, lda, gemm_b_data, offset_b, gemm_ldb, c_data, shift_c,
+          offset_c, mult_c, ldc);
     }
 
     float min_c_value;
@@ -202,8 +221,58 @@ class QuantizedMatMulOp : public OpKernel {
   }
 
  private:
+  // Returns a row-major (pre-transposed) copy of `weight`, reusing the
+  // cached copy when the weight buffer and shape match the previous call.
+  // The cache retains a reference to `weight` so its buffer cannot be
+  // recycled for another tensor while the cache is alive, which keeps the
+  // address comparison below sound for constant weights.
+  Status GetTransposedWeight(OpKernelContext* context, const Tensor& weight,
+                             Tensor* transposed) {
+    mutex_lock lock(mu_);
+    if (cached_weight_.NumElements() > 0 &&
+        cached_weight_.tensor_data().data() == weight.tensor_data().data() &&
+        cached_weight_.shape() == weight.shape()) {
+      *transposed = cached_weight_transposed_;
+      return absl::OkStatus();
+    }
+    Tensor weight_t;
+    TF_RETURN_IF_ERROR(context->allocate_temp(
+        DataTypeToEnum<T2>::value,
+        TensorShape({weight.dim_size(1), weight.dim_size(0)}), &weight_t));
+    auto src = weight.matrix<T2>();
+    auto dst = weight_t.matrix<T2>();
+    for (int64_t i = 0; i < src.dimension(0); ++i) {
+      for (int64_t j = 0; j < src.dimension(1); ++j) {
+        dst(j, i) = src(i, j);
+      }
+    }
+    cached_weight_ = weight;
+    cached_weight_transposed_ = weight_t;
+    *transposed = weight_t;
+    return absl::OkStatus();
+  }
+
+  // The cache assumes the weight operand is constant across invocations, as
+  // it is in frozen inference graphs, so it is opt-in.
+  static bool WeightCacheEnabled() {
+    static bool cache_enabled = [] {
+      bool enabled = false;
+      Status status = ReadBoolFromEnvVar("TF_QUANTIZED_MATMUL_WEIGHT_CACHE",
+                                         /*default_val=*/false, &enabled);
+      if (!status.ok()) {
+        LOG(ERROR) << status.message();
+      }
+      return enabled;
+    }();
+    return cache_enabled;
+  }
+
   bool transpose_a_;
   bool transpose_b_;
+
+  mutex mu_;
+  Tensor cached_weight_ TF_GUARDED_BY(mu_);
+  Tensor cached_weight_transposed_ TF_GUARDED_BY(mu_);
 };
 
 REGISTER_KERNEL_BUILDER(Name("QuantizedMatMul")
@@ -88,9 +88,37 @@ struct FillPhiloxRandomTask<Distribution, false> {
     gen.Skip(start_group);
     int64_t offset = start_group * kGroupSize;
 
-    // First fill all the full-size groups
+    // First fill all the full-size groups, four counter blocks per iteration.
+    // The four Philox invocations are data independent, which lets the
+    // compiler keep several counter blocks in flight (vectorizing across them
+    // where profitable) instead of serializing on one running generator. The
+    // generated stream is unchanged: block `index + k` is exactly the base
+    // generator skipped ahead to group `index + k`.
     int64_t limit_group_full = std::min(limit_group, size / kGroupSize);
-    for (int64_t index = start_group; index < limit_group_full; ++index) {
+    int64_t index = start_group;
+    for (; index + 4 <= limit_group_full; index += 4) {
+      PhiloxRandom gen0 = gen;
+      PhiloxRandom gen1 = gen;
+      gen1.Skip(1);
+      PhiloxRandom gen2 = gen;
+      gen2.Skip(2);
+      PhiloxRandom gen3 = gen;
+      gen3.Skip(3);
+      auto samples0 = dist(&gen0);
+      auto samples1 = dist(&gen1);
+      auto samples2 = dist(&gen2);
+      auto samples3 = dist(&gen3);
+      std::copy(&samples0[0], &samples0[0] + kGroupSize, data + offset);
+      std::copy(&samples1[0], &samples1[0] + kGroupSize,
+                data + offset + kGroupSize);
+      std::copy(&samples2[0], &samples2[0] + kGroupSize,
+                data + offset + 2 * kGroupSize);
+      std::copy(&samples3[0], &samples3[0] + kGroupSize,
+                data + offset + 3 * kGroupSize);
+      gen.Skip(4);
+      offset += 4 * kGroupSize;
+    }
+    for (; index < limit_group_full; ++index) {
       auto samples = dist(&gen);
       std::copy(&samples[0], &samples[0] + kGroupSize, data + offset);
       offset += kGroupSize;
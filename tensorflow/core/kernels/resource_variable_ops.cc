@@ -86,6 +86,7 @@ limitations under the License.
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/determinism.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/util.h"
 
 namespace tensorflow {
@@ -141,6 +142,24 @@ Status CopyVariable(int output_idx, OpKernelContext* ctx, const Tensor* t) {
   return absl::OkStatus();
 }
 
+// Whether dense reads of copy-on-read variables may share one cached copy of
+// the value instead of each producing their own (see the snapshot-sharing
+// comment in resource_var.h). Off by default; with hogwild-style sparse
+// writers (use_locking=false) a shared copy may briefly linger behind a write
+// that overlapped the copy, so this is opt-in.
+bool ReadSnapshotSharingEnabled() {
+  static bool enabled = [] {
+    bool enabled = false;
+    Status status = ReadBoolFromEnvVar("TF_VARIABLE_READ_SNAPSHOT_SHARING",
+                                       /*default_value=*/false, &enabled);
+    if (!status.ok()) {
+      LOG(ERROR) << status.message();
+    }
+    return enabled;
+  }();
+  return enabled;
+}
+
 }  // namespace
 
 void ReadVariableOp::Compute(OpKernelContext* ctx) {
@@ -168,7 +187,18 @@ void ReadVariableOp::Compute(OpKernelContext* ctx) {
             DataTypeString(dtype_), " got ", DataTypeString(t->dtype())));
     ctx->set_output(0, *t);
   } else {
-    OP_REQUIRES_OK(ctx, CopyVariable(0, ctx, t));
+    if (ReadSnapshotSharingEnabled()) {
+      Tensor snapshot;
+      if (variable->GetReadSnapshot(&snapshot)) {
+        ctx->set_output(0, snapshot);
+        return;
+      }
+      const int64_t generation = variable->mutation_generation();
+      OP_REQUIRES_OK(ctx, CopyVariable(0, ctx, t));
+      variable->InstallReadSnapshot(*ctx->mutable_output(0), generation);
+    } else {
+      OP_REQUIRES_OK(ctx, CopyVariable(0, ctx, t));
+    }
   }
 }
 
@@ -216,7 +246,18 @@ void ReadVariablesOp::Compute(OpKernelContext* ctx) {
                     " with wrong dtype. Expected ", DataTypeString(dtypes_[i]),
                     " got ", DataTypeString(variables[i]->tensor()->dtype())));
     if (variables[i]->copy_on_read_mode.load()) {
-      OP_REQUIRES_OK(ctx, CopyVariable(i, ctx, variables[i]->tensor()));
+      if (ReadSnapshotSharingEnabled()) {
+        Tensor snapshot;
+        if (variables[i]->GetReadSnapshot(&snapshot)) {
+          ctx->set_output(i, snapshot);
+          continue;
+        }
+        const int64_t generation = variables[i]->mutation_generation();
+        OP_REQUIRES_OK(ctx, CopyVariable(i, ctx, variables[i]->tensor()));
+        variables[i]->InstallReadSnapshot(*ctx->mutable_output(i), generation);
+      } else {
+        OP_REQUIRES_OK(ctx, CopyVariable(i, ctx, variables[i]->tensor()));
+      }
     } else {
       const Tensor& t = *variables[i]->tensor();
       ctx->set_output(i, t);
@@ -461,6 +502,7 @@ class AssignVariableOp : public OpKernel {
               variable->tensor()->shape().DebugString(), " got ",
               value.shape().DebugString()));
     }
+    variable->MarkMutationStarted();
     if (variable->copy_on_read_mode.load()) {
       AllocatorAttributes attr;
       attr.set_gpu_compatible(true);
@@ -528,6 +570,7 @@ class AssignVariableOp<Device, Variant> : public OpKernel {
                     "Trying to assign variable with wrong dtype. Expected ",
                     DataTypeString(variable->tensor()->dtype()), " got ",
                     DataTypeString(DT_VARIANT)));
+    variable->MarkMutationStarted();
     variable->is_initialized = true;
     *variable->tensor() = Tensor(DT_VARIANT, value.shape());
 
@@ -621,6 +664,7 @@ class AssignUpdateVariableOp : public OpKernel {
     OP_REQUIRES(context, var_tensor->dtype() == value.dtype(),
                 errors::InvalidArgument(
                     "DType of variable handle and value does not match."));
+    variable->MarkMutationStarted();
     OP_REQUIRES_OK(
         context, PrepareToUpdateVariable<Device, T>(
                      context, var_tensor, variable->copy_on_read_mode.load()));
@@ -1124,6 +1168,7 @@ class ResourceScatterUpdateOp : public OpKernel {
                     "DType of scatter resource and updates does not match."));
 
     OP_REQUIRES_OK(c, EnsureSparseVariableAccess<Device, T>(c, v.get()));
+    v->MarkMutationStarted();
     const bool is_non_pod_dtype =
         update_dtype == DT_STRING || update_dtype == DT_VARIANT;
     if (is_non_pod_dtype || use_exclusive_lock_) {
@@ -29,11 +29,14 @@ limitations under the License.
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/kernels/save_restore_tensor.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/public/session_options.h"
 #include "tensorflow/core/public/version.h"
+#include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
 
 namespace tensorflow {
 namespace {
@@ -356,5 +359,57 @@ TEST_F(RestoreV2OpTest, RestoreAfterSaveV2) { RunTest("SaveV2"); }
 TEST_F(RestoreV2OpTest, RestoreAfterSaveSlicesV1) { RunTest("SaveSlices"); }
 TEST_F(RestoreV2OpTest, RestoreAfterSaveV1) { RunTest("Save"); }
 
+TEST_F(RestoreV2OpTest, RestoreFromDeltaCheckpointChain) {
+  const string base_prefix = io::JoinPath(testing::TmpDir(), "delta_base");
+  const string delta_prefix = io::JoinPath(testing::TmpDir(), "delta_head");
+
+  // The base checkpoint holds both tensors; the delta checkpoint holds only
+  // the changed one and a sidecar pointing at the base.
+  {
+    BundleWriter writer(Env::Default(), base_prefix);
+    TF_ASSERT_OK(writer.Add(
+        "tensor_unchanged", MakeInput<float>(TensorShape({4}), [](int x) {
+          return static_cast<float>(x + 1);
+        })));
+    TF_ASSERT_OK(writer.Add(
+        "tensor_changed",
+        MakeInput<float>(TensorShape({4}), [](int x) { return 0.f; })));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  {
+    BundleWriter writer(Env::Default(), delta_prefix);
+    TF_ASSERT_OK(writer.Add(
+        "tensor_changed", MakeInput<float>(TensorShape({4}), [](int x) {
+          return static_cast<float>(2 * x);
+        })));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  TF_ASSERT_OK(WriteStringToFile(
+      Env::Default(), DeltaCheckpointBaseFilename(delta_prefix), base_prefix));
+
+  TF_ASSERT_OK(NodeDefBuilder("myop", "RestoreV2")
+                   .Input(FakeInput())  // prefix
+                   .Input(FakeInput())  // tensor_names
+                   .Input(FakeInput())  // shape_and_slices
+                   .Attr("dtypes", {DT_FLOAT, DT_FLOAT})
+                   .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+  AddInput<tstring>(TensorShape({}),
+                    [&delta_prefix](int x) -> tstring { return delta_prefix; });
+  AddInput<tstring>(TensorShape({2}), [](int x) -> tstring {
+    return x == 0 ? "tensor_unchanged" : "tensor_changed";
+  });
+  AddInput<tstring>(TensorShape({2}),
+                    [](int x) -> tstring { return "" /* no slice */; });
+  TF_ASSERT_OK(RunOpKernel());
+
+  // "tensor_unchanged" is missing from the delta bundle and is read from
+  // the base checkpoint; "tensor_changed" comes from the delta itself.
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(static_cast<float>(i + 1), GetOutput(0)->flat<float>()(i));
+    EXPECT_EQ(static_cast<float>(2 * i), GetOutput(1)->flat<float>()(i));
+  }
+}
+
 }  // namespace
 }  // namespace tensorflow
@@ -303,10 +303,20 @@ struct RestoreOp {
             << restored_full_shape.num_elements();
     Tensor* restored_tensor;
     if (shape_and_slice.empty()) {
-      // Lookup the full tensor.
-      TF_RETURN_IF_ERROR(
-          context->allocate_output(idx, restored_full_shape, &restored_tensor));
-      TF_RETURN_IF_ERROR(reader->Lookup(tensor_name, restored_tensor));
+      if (reader->use_mmap()) {
+        // Let the reader adopt the tensor bytes from the memory-mapped data
+        // file and forward the resulting tensor, instead of pre-allocating
+        // the output and copying into it.
+        Tensor mmap_tensor;
+        TF_RETURN_IF_ERROR(reader->Lookup(tensor_name, &mmap_tensor));
+        context->set_output(idx, mmap_tensor);
+        restored_tensor = context->mutable_output(idx);
+      } else {
+        // Lookup the full tensor.
+        TF_RETURN_IF_ERROR(context->allocate_output(idx, restored_full_shape,
+                                                    &restored_tensor));
+        TF_RETURN_IF_ERROR(reader->Lookup(tensor_name, restored_tensor));
+      }
     } else {
       // Lookup the slice.
       TensorShape parsed_full_shape;
@@ -358,10 +368,19 @@ struct RestoreOp {
   DataType dtype;
 
   ::tensorflow::Status status;
+
+  // Reader that holds this tensor.  With delta checkpoints this may be the
+  // reader of a base checkpoint rather than of the restore's own prefix; it
+  // always corresponds to "reader_prefix".
+  BundleReader* source_reader = nullptr;
 };
 
 }  // namespace
 
+string DeltaCheckpointBaseFilename(const string& prefix) {
+  return strings::StrCat(prefix, ".delta-base");
+}
+
 Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
                         const Tensor& tensor_names,
                         const Tensor& shape_and_slices,
@@ -383,14 +402,55 @@ Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
   BundleReader default_reader(env, prefix_string, {&cache, false});
   TF_RETURN_IF_ERROR(default_reader.status());
 
-  TF_RETURN_IF_ERROR(default_reader.SortForSequentialAccess<RestoreOp>(
-      restore_ops, [](const RestoreOp& op) { return op.tensor_name; }));
+  // A delta checkpoint (written by SaveV2 when TF_BUNDLE_DELTA_SAVE_MAX_CHAIN
+  // is set) holds only the tensors that changed since its base checkpoint;
+  // the remaining tensors are read from the chain of base checkpoints
+  // recorded in sidecar files.
+  std::vector<string> base_prefixes;
+  std::vector<std::unique_ptr<BundleReader>> base_readers;
+  {
+    string cur_prefix = prefix_string;
+    string base_prefix;
+    // The depth bound guards against sidecar cycles.
+    while (base_prefixes.size() < 128 &&
+           tsl::ReadFileToString(env, DeltaCheckpointBaseFilename(cur_prefix),
+                                 &base_prefix)
+               .ok()) {
+      base_readers.push_back(std::make_unique<BundleReader>(
+          env, base_prefix, BundleReader::Options{&cache, false}));
+      TF_RETURN_IF_ERROR(base_readers.back()->status());
+      base_prefixes.push_back(base_prefix);
+      cur_prefix = base_prefix;
+    }
+  }
+  for (RestoreOp& restore_op : restore_ops) {
+    restore_op.source_reader = &default_reader;
+    if (!base_readers.empty() &&
+        !default_reader.Contains(restore_op.tensor_name)) {
+      for (size_t j = 0; j < base_readers.size(); ++j) {
+        if (base_readers[j]->Contains(restore_op.tensor_name)) {
+          restore_op.source_reader = base_readers[j].get();
+          restore_op.reader_prefix = base_prefixes[j];
+          break;
+        }
+      }
+      // If no reader in the chain contains the tensor, the lookups below
+      // fail against the default reader with the usual NotFound error.
+    }
+  }
+
+  if (base_readers.empty()) {
+    // With a base chain, ops read from several bundles and a single reader
+    // cannot order them; skip the sort in that case.
+    TF_RETURN_IF_ERROR(default_reader.SortForSequentialAccess<RestoreOp>(
+        restore_ops, [](const RestoreOp& op) { return op.tensor_name; }));
+  }
 
   std::vector<string> mismatched_errors;
   for (const RestoreOp& restore_op : restore_ops) {
     TensorShape restored_full_shape;
     DataType original_dtype;
-    TF_RETURN_IF_ERROR(default_reader.LookupDtypeAndShape(
+    TF_RETURN_IF_ERROR(restore_op.source_reader->LookupDtypeAndShape(
         restore_op.tensor_name, &original_dtype, &restored_full_shape));
     if (restore_op.dtype != original_dtype) {
       string error_msg = strings::StrCat(
@@ -410,7 +470,7 @@ Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
   std::vector<RestoreOp*> large_restore_ops;
   std::vector<RestoreOp*> small_restore_ops;
   for (RestoreOp& restore_op : restore_ops) {
-    if (restore_op.is_large_shape(&default_reader)) {
+    if (restore_op.is_large_shape(restore_op.source_reader)) {
       large_restore_ops.push_back(&restore_op);
     } else {
       small_restore_ops.push_back(&restore_op);
@@ -458,7 +518,7 @@ Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
 
     // Read small tensors from the op thread.
     for (auto* op : small_restore_ops) {
-      TF_RETURN_IF_ERROR(op->run(&default_reader));
+      TF_RETURN_IF_ERROR(op->run(op->source_reader));
     }
 
     // Wait for all scheduled work to finish and check the status of all
@@ -55,6 +55,12 @@ void RestoreTensor(OpKernelContext* context,
 
 // V2 checkpoint format.
 
+// Name of the sidecar file written next to a delta checkpoint (see
+// TF_BUNDLE_DELTA_SAVE_MAX_CHAIN in save_restore_v2_ops.cc).  It holds the
+// prefix of the checkpoint the delta is based on; tensors missing from the
+// delta bundle are restored from that base chain.
+string DeltaCheckpointBaseFilename(const string& prefix);
+
 // Invokes the V2 checkpoint read path to read tensors.
 //
 // "context" is only used for allocating outputs.  In particular, the inputs are
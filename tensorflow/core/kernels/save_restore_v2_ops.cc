@@ -15,27 +15,40 @@ limitations under the License.
 
 // See docs in ../ops/io_ops.cc.
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <memory>
+#include <numeric>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/resource_mgr.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/kernels/checkpoint_callback_manager.h"
 #include "tensorflow/core/kernels/save_restore_tensor.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/logging.h"  // IWYU pragma: keep
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/saved_tensor_slice_util.h"
 #include "tensorflow/core/util/tensor_bundle/naming.h"
 #include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/tensor_slice_reader.h"
 
 namespace tensorflow {
@@ -90,6 +103,65 @@ void ValidateInputs(bool is_save_op, OpKernelContext* context,
   }
 }
 
+// Number of bundle shards that SaveV2 writes concurrently.  With N > 1
+// shards, the tensors are spread across N BundleWriters that run on their
+// own threads, each flushing and closing its own data file, and the
+// per-shard bundles are merged into the final bundle with MergeBundles(),
+// which renames the data files in place and rewrites only the index.  The
+// default of 1 keeps the serial single-writer path.
+int ParallelSaveShards() {
+  static const int num_shards = [] {
+    int64_t shards;
+    TF_CHECK_OK(ReadInt64FromEnvVar("TF_BUNDLE_PARALLEL_SAVE_SHARDS",
+                                    /*default_val=*/1, &shards));
+    return static_cast<int>(std::max(int64_t{1}, shards));
+  }();
+  return num_shards;
+}
+
+// Maximum number of delta checkpoints that SaveV2 may chain before writing
+// a full checkpoint again (the compaction policy).  When set above 0, a
+// SaveV2 kernel fingerprints the tensors it writes and subsequent saves
+// write only the tensors whose content changed, recording the previous
+// checkpoint's prefix in a sidecar file so that RestoreV2 can read the
+// unchanged tensors from the base chain.  0 (the default) disables delta
+// checkpointing.
+int64_t DeltaSaveMaxChain() {
+  int64_t max_chain;
+  // Read once per save (rather than memoized) so that tests can vary the
+  // setting; a save is far more expensive than the environment lookup.
+  TF_CHECK_OK(ReadInt64FromEnvVar("TF_BUNDLE_DELTA_SAVE_MAX_CHAIN",
+                                  /*default_val=*/0, &max_chain));
+  return max_chain;
+}
+
+// Whether SaveV2 returns as soon as it has snapshotted its inputs and runs
+// serialization and file I/O on a background thread.  The training step
+// then only pays for copying the variables; the next save through the same
+// kernel (and the kernel's destruction) joins the pending write and
+// surfaces its status.  Anything that reads the checkpoint right after the
+// save step must be ordered behind that join, so shard prefixes that a
+// MergeV2Checkpoints op consumes in the same step (see
+// IsShardedTempPrefix()) always take the synchronous path.
+bool AsyncSaveEnabled() {
+  bool enabled;
+  TF_CHECK_OK(ReadBoolFromEnvVar("TF_BUNDLE_ASYNC_SAVE",
+                                 /*default_val=*/false, &enabled));
+  return enabled;
+}
+
+// Returns true if `prefix` is one shard of a sharded save.  The saver graph
+// writes shards to "<user prefix>_temp/part-NNNNN-of-NNNNN" (or
+// "<user prefix>.part-NNNNN-of-NNNNN" on object stores) and runs
+// MergeV2Checkpoints on them later in the same step; nothing in the graph
+// can order that merge behind a background write, so such bundles must be
+// complete when Compute() returns.
+bool IsShardedTempPrefix(const string& prefix) {
+  const absl::string_view base = io::Basename(prefix);
+  return (absl::StartsWith(base, "part-") && absl::StrContains(base, "-of-")) ||
+         absl::StrContains(base, ".part-");
+}
+
 }  // namespace
 
 // Saves a list of named tensors using the tensor bundle library.
@@ -97,6 +169,17 @@ class SaveV2 : public OpKernel {
  public:
   explicit SaveV2(OpKernelConstruction* context) : OpKernel(context) {}
 
+  ~SaveV2() override {
+    // Joins a save that is still running in the background.  Its status can
+    // no longer be surfaced to a caller, so log it here.
+    pending_async_save_.reset();
+    mutex_lock l(async_mu_);
+    if (!async_save_status_.ok()) {
+      LOG(ERROR) << "Asynchronous checkpoint save failed: "
+                 << async_save_status_;
+    }
+  }
+
   void Compute(OpKernelContext* context) override {
     const Tensor& prefix = context->input(0);
     const Tensor& tensor_names = context->input(1);
@@ -111,57 +194,63 @@ class SaveV2 : public OpKernel {
     const auto& tensor_names_flat = tensor_names.flat<tstring>();
     const auto& shape_and_slices_flat = shape_and_slices.flat<tstring>();
 
-    BundleWriter writer(Env::Default(), prefix_string);
-    OP_REQUIRES_OK(context, writer.status());
-    VLOG(1) << "BundleWriter, prefix_string: " << prefix_string;
+    if (AsyncSaveEnabled() && !IsShardedTempPrefix(prefix_string)) {
+      AsyncSave(context, num_tensors, prefix_string);
+      return;
+    }
 
-    for (int i = 0; i < num_tensors; ++i) {
-      const string& tensor_name = tensor_names_flat(i);
-      const Tensor& tensor = context->input(i + kFixedInputs);
-      VLOG(2) << "Starting save of " << tensor_name;
-
-      if (!shape_and_slices_flat(i).empty()) {
-        const string& shape_spec = shape_and_slices_flat(i);
-        TensorShape shape;
-        TensorSlice slice(tensor.dims());
-        TensorShape slice_shape;
-
-        OP_REQUIRES_OK(context, checkpoint::ParseShapeAndSlice(
-                                    shape_spec, &shape, &slice, &slice_shape));
-        OP_REQUIRES(context, slice_shape.IsSameSize(tensor.shape()),
-                    errors::InvalidArgument("Slice in shape_and_slice "
-                                            "specification does not match the "
-                                            "shape of the tensor to  save: ",
-                                            shape_spec, ", tensor: ",
-                                            tensor.shape().DebugString()));
-
-        OP_REQUIRES_OK(context,
-                       writer.AddSlice(tensor_name, shape, slice, tensor));
-      } else {
-        OP_REQUIRES_OK(context, writer.Add(tensor_name, tensor));
-      }
+    DeltaPlan delta_plan;
+    if (DeltaSaveMaxChain() > 0) {
+      PlanDeltaSave(context, num_tensors, &delta_plan);
+    }
 
-      if (VLOG_IS_ON(5)) {
-        if (tensor.dtype() == DT_FLOAT) {
-          const float* t_data = tensor.flat<float>().data();
-          float min = std::numeric_limits<float>::infinity();
-          float max = -std::numeric_limits<float>::infinity();
-          double avg = 0.0;
-          for (int i = 0; i < tensor.NumElements(); ++i) {
-            if (t_data[i] < min) min = t_data[i];
-            if (t_data[i] > max) max = t_data[i];
-            avg += t_data[i];
+    const int num_shards = std::min(ParallelSaveShards(), num_tensors);
+    if (num_shards > 1 && !delta_plan.is_delta) {
+      OP_REQUIRES_OK(context, ParallelSave(context, prefix_string, num_shards));
+    } else {
+      BundleWriter writer(Env::Default(), prefix_string);
+      OP_REQUIRES_OK(context, writer.status());
+      VLOG(1) << "BundleWriter, prefix_string: " << prefix_string;
+
+      for (int i = 0; i < num_tensors; ++i) {
+        const string& tensor_name = tensor_names_flat(i);
+        const Tensor& tensor = context->input(i + kFixedInputs);
+        if (delta_plan.is_delta && !delta_plan.write_tensor[i]) {
+          VLOG(2) << "Skipping save of unchanged tensor " << tensor_name;
+          continue;
+        }
+        VLOG(2) << "Starting save of " << tensor_name;
+
+        OP_REQUIRES_OK(context, AddTensorToWriter(tensor_name,
+                                                  shape_and_slices_flat(i),
+                                                  tensor, &writer));
+
+        if (VLOG_IS_ON(5)) {
+          if (tensor.dtype() == DT_FLOAT) {
+            const float* t_data = tensor.flat<float>().data();
+            float min = std::numeric_limits<float>::infinity();
+            float max = -std::numeric_limits<float>::infinity();
+            double avg = 0.0;
+            for (int i = 0; i < tensor.NumElements(); ++i) {
+              if (t_data[i] < min) min = t_data[i];
+              if (t_data[i] > max) max = t_data[i];
+              avg += t_data[i];
+            }
+            VLOG(5) << " min " << min << " max " << max << " avg "
+                    << avg / tensor.NumElements() << " total elts "
+                    << tensor.NumElements();
           }
-          VLOG(5) << " min " << min << " max " << max << " avg "
-                  << avg / tensor.NumElements() << " total elts "
-                  << tensor.NumElements();
         }
+
+        VLOG(2) << "Done save of " << tensor_name;
       }
+      OP_REQUIRES_OK(context, writer.Finish());
+      VLOG(1) << "Done BundleWriter, prefix_string: " << prefix_string;
+    }
 
-      VLOG(2) << "Done save of " << tensor_name;
+    if (DeltaSaveMaxChain() > 0) {
+      OP_REQUIRES_OK(context, CommitDeltaSave(prefix_string, &delta_plan));
     }
-    OP_REQUIRES_OK(context, writer.Finish());
-    VLOG(1) << "Done BundleWriter, prefix_string: " << prefix_string;
 
     ResourceMgr* resource_manager = context->resource_manager();
     if (resource_manager != nullptr) {
@@ -182,6 +271,282 @@ class SaveV2 : public OpKernel {
       checkpoint_callback_manager->Unref();
     }
   }
+
+ private:
+  // The plan for one save under delta checkpointing: whether the save is a
+  // delta, which tensors it writes, and the content fingerprints that become
+  // the reference for the next save.
+  struct DeltaPlan {
+    bool is_delta = false;
+    string base_prefix;  // Previous checkpoint; only set when is_delta.
+    std::vector<bool> write_tensor;
+    std::unordered_map<string, uint64> fingerprints;
+  };
+
+  // Decides which tensors the current save needs to write.  Leaves
+  // plan->is_delta false (all tensors written) when a full checkpoint is
+  // due: on the first save through this kernel and whenever the chain of
+  // deltas since the last full checkpoint reaches DeltaSaveMaxChain().
+  void PlanDeltaSave(OpKernelContext* context, int num_tensors,
+                     DeltaPlan* plan) {
+    const int kFixedInputs = 3;  // Prefix, tensor names, shape_and_slices.
+    const auto& tensor_names_flat = context->input(1).flat<tstring>();
+    const auto& shape_and_slices_flat = context->input(2).flat<tstring>();
+
+    plan->write_tensor.assign(num_tensors, true);
+    plan->fingerprints.reserve(num_tensors);
+    for (int i = 0; i < num_tensors; ++i) {
+      const Tensor& tensor = context->input(i + kFixedInputs);
+      // Sliced saves and non-memcpy dtypes (whose buffers hold pointers,
+      // not content) are always written and never fingerprinted.
+      if (!shape_and_slices_flat(i).empty() ||
+          !DataTypeCanUseMemcpy(tensor.dtype())) {
+        continue;
+      }
+      plan->fingerprints[tensor_names_flat(i)] =
+          Fingerprint64(tensor.tensor_data());
+    }
+
+    mutex_lock l(mu_);
+    if (last_prefix_.empty() || delta_chain_len_ >= DeltaSaveMaxChain()) {
+      return;  // Full save.
+    }
+    plan->is_delta = true;
+    plan->base_prefix = last_prefix_;
+    for (int i = 0; i < num_tensors; ++i) {
+      auto it = plan->fingerprints.find(tensor_names_flat(i));
+      if (it == plan->fingerprints.end()) continue;
+      auto prev = delta_fingerprints_.find(it->first);
+      if (prev != delta_fingerprints_.end() && prev->second == it->second) {
+        plan->write_tensor[i] = false;
+      }
+    }
+  }
+
+  // Records a finished save as the base for the next delta; for a delta
+  // save, also writes the sidecar file that points RestoreV2 at the base
+  // checkpoint.
+  Status CommitDeltaSave(const string& prefix_string, DeltaPlan* plan) {
+    if (plan->is_delta) {
+      TF_RETURN_IF_ERROR(WriteStringToFile(
+          Env::Default(), DeltaCheckpointBaseFilename(prefix_string),
+          plan->base_prefix));
+    }
+    mutex_lock l(mu_);
+    last_prefix_ = prefix_string;
+    delta_chain_len_ = plan->is_delta ? delta_chain_len_ + 1 : 0;
+    delta_fingerprints_ = std::move(plan->fingerprints);
+    return absl::OkStatus();
+  }
+
+  // Everything a background save needs after Compute() has returned: the
+  // snapshotted tensor values, the delta plan, and the callback manager (a
+  // ref is held until the write finishes).
+  struct SaveSnapshot {
+    string prefix;
+    std::vector<string> tensor_names;
+    std::vector<string> shape_specs;
+    std::vector<Tensor> tensors;
+    bool use_delta = false;
+    DeltaPlan delta_plan;
+    checkpoint::CheckpointCallbackManager* callback_manager = nullptr;
+  };
+
+  // Snapshots the inputs and writes the checkpoint on a background thread.
+  // The snapshot is a deep copy, so in-place updates to the variables by
+  // subsequent training steps do not leak into the checkpoint; the step
+  // only pays for the copy.
+  void AsyncSave(OpKernelContext* context, int num_tensors,
+                 const string& prefix_string) {
+    const int kFixedInputs = 3;  // Prefix, tensor names, shape_and_slices.
+    const auto& tensor_names_flat = context->input(1).flat<tstring>();
+    const auto& shape_and_slices_flat = context->input(2).flat<tstring>();
+
+    // Join the previous background save first: this keeps at most one save
+    // in flight, lets the delta state settle, and surfaces a previous
+    // failure on this step instead of losing it.
+    pending_async_save_.reset();
+    {
+      mutex_lock l(async_mu_);
+      OP_REQUIRES_OK(context, async_save_status_);
+    }
+
+    auto snapshot = std::make_shared<SaveSnapshot>();
+    snapshot->prefix = prefix_string;
+    if (DeltaSaveMaxChain() > 0) {
+      snapshot->use_delta = true;
+      PlanDeltaSave(context, num_tensors, &snapshot->delta_plan);
+    }
+    for (int i = 0; i < num_tensors; ++i) {
+      if (snapshot->use_delta && snapshot->delta_plan.is_delta &&
+          !snapshot->delta_plan.write_tensor[i]) {
+        continue;
+      }
+      snapshot->tensor_names.push_back(tensor_names_flat(i));
+      snapshot->shape_specs.push_back(shape_and_slices_flat(i));
+      snapshot->tensors.push_back(
+          tensor::DeepCopy(context->input(i + kFixedInputs)));
+    }
+
+    ResourceMgr* resource_manager = context->resource_manager();
+    if (resource_manager != nullptr) {
+      OP_REQUIRES_OK(
+          context,
+          resource_manager
+              ->LookupOrCreate<checkpoint::CheckpointCallbackManager>(
+                  resource_manager->default_container(),
+                  std::string(
+                      checkpoint::kCheckpointCallbackManagerResourceName),
+                  &snapshot->callback_manager,
+                  [](checkpoint::CheckpointCallbackManager** out) {
+                    *out = new checkpoint::CheckpointCallbackManager();
+                    return absl::OkStatus();
+                  }));
+    }
+
+    pending_async_save_.reset(Env::Default()->StartThread(
+        ThreadOptions(), "async_checkpoint_save",
+        [this, snapshot] { WriteSnapshot(snapshot.get()); }));
+  }
+
+  // Runs on the background thread started by AsyncSave().
+  void WriteSnapshot(SaveSnapshot* snapshot) {
+    Status s = [&]() -> Status {
+      BundleWriter writer(Env::Default(), snapshot->prefix);
+      TF_RETURN_IF_ERROR(writer.status());
+      for (size_t i = 0; i < snapshot->tensors.size(); ++i) {
+        TF_RETURN_IF_ERROR(AddTensorToWriter(snapshot->tensor_names[i],
+                                             snapshot->shape_specs[i],
+                                             snapshot->tensors[i], &writer));
+      }
+      TF_RETURN_IF_ERROR(writer.Finish());
+      if (snapshot->use_delta) {
+        TF_RETURN_IF_ERROR(
+            CommitDeltaSave(snapshot->prefix, &snapshot->delta_plan));
+      }
+      return absl::OkStatus();
+    }();
+    if (snapshot->callback_manager != nullptr) {
+      if (s.ok()) {
+        snapshot->callback_manager->Save(snapshot->prefix);
+      }
+      snapshot->callback_manager->Unref();
+    }
+    mutex_lock l(async_mu_);
+    async_save_status_.Update(s);
+  }
+
+  // Adds "tensor" (a full tensor or, if "shape_spec" is non-empty, a slice)
+  // to "writer" under "tensor_name".
+  static Status AddTensorToWriter(const string& tensor_name,
+                                  const string& shape_spec,
+                                  const Tensor& tensor, BundleWriter* writer) {
+    if (!shape_spec.empty()) {
+      TensorShape shape;
+      TensorSlice slice(tensor.dims());
+      TensorShape slice_shape;
+      TF_RETURN_IF_ERROR(checkpoint::ParseShapeAndSlice(shape_spec, &shape,
+                                                        &slice, &slice_shape));
+      if (!slice_shape.IsSameSize(tensor.shape())) {
+        return errors::InvalidArgument(
+            "Slice in shape_and_slice specification does not match the "
+            "shape of the tensor to  save: ",
+            shape_spec, ", tensor: ", tensor.shape().DebugString());
+      }
+      return writer->AddSlice(tensor_name, shape, slice, tensor);
+    }
+    return writer->Add(tensor_name, tensor);
+  }
+
+  // Writes the checkpoint as "num_shards" bundles built concurrently under
+  // temporary prefixes, then merges them under "prefix_string".  Tensors are
+  // balanced across shards by size (largest first, onto the least-filled
+  // shard) so that the slowest writer finishes as early as possible.
+  Status ParallelSave(OpKernelContext* context, const string& prefix_string,
+                      int num_shards) {
+    const int kFixedInputs = 3;  // Prefix, tensor names, shape_and_slices.
+    const Tensor& tensor_names = context->input(1);
+    const Tensor& shape_and_slices = context->input(2);
+    const int num_tensors = static_cast<int>(tensor_names.NumElements());
+    const auto& tensor_names_flat = tensor_names.flat<tstring>();
+    const auto& shape_and_slices_flat = shape_and_slices.flat<tstring>();
+
+    std::vector<int> order(num_tensors);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+      return context->input(a + kFixedInputs).TotalBytes() >
+             context->input(b + kFixedInputs).TotalBytes();
+    });
+    std::vector<std::vector<int>> shard_tensors(num_shards);
+    std::vector<int64_t> shard_bytes(num_shards, 0);
+    for (int i : order) {
+      const int shard =
+          std::min_element(shard_bytes.begin(), shard_bytes.end()) -
+          shard_bytes.begin();
+      shard_tensors[shard].push_back(i);
+      shard_bytes[shard] += context->input(i + kFixedInputs).TotalBytes();
+    }
+
+    std::vector<tstring> shard_prefixes;
+    shard_prefixes.reserve(num_shards);
+    for (int s = 0; s < num_shards; ++s) {
+      shard_prefixes.push_back(
+          strings::StrCat(prefix_string, "_temp/part-", s, "-of-", num_shards));
+    }
+
+    VLOG(1) << "Parallel BundleWriter, prefix_string: " << prefix_string
+            << ", num_shards: " << num_shards;
+    std::vector<Status> statuses(num_shards);
+    {
+      thread::ThreadPool pool(Env::Default(), "parallel_bundle_save",
+                              num_shards);
+      for (int s = 0; s < num_shards; ++s) {
+        pool.Schedule([context, &tensor_names_flat,
+                       &shape_and_slices_flat, &shard_tensors, &shard_prefixes,
+                       &statuses, s] {
+          BundleWriter writer(Env::Default(), shard_prefixes[s]);
+          statuses[s] = writer.status();
+          if (!statuses[s].ok()) return;
+          for (int i : shard_tensors[s]) {
+            statuses[s] = AddTensorToWriter(
+                tensor_names_flat(i), shape_and_slices_flat(i),
+                context->input(i + kFixedInputs), &writer);
+            if (!statuses[s].ok()) return;
+          }
+          // Flushes and closes this shard's data file; the other shards'
+          // writers do the same concurrently.
+          statuses[s] = writer.Finish();
+        });
+      }
+    }  // Joins the writer threads.
+    for (const Status& s : statuses) {
+      TF_RETURN_IF_ERROR(s);
+    }
+    // Renames the shards' data files into place and writes the final index
+    // in a single pass; also cleans up the per-shard metadata files.
+    TF_RETURN_IF_ERROR(
+        MergeBundles(Env::Default(), shard_prefixes, prefix_string));
+    // Best-effort removal of the (now empty) temporary directory.
+    Env::Default()
+        ->DeleteDir(string(io::Dirname(shard_prefixes[0])))
+        .IgnoreError();
+    VLOG(1) << "Done parallel BundleWriter, prefix_string: " << prefix_string;
+    return absl::OkStatus();
+  }
+
+  // Delta-checkpoint state; a SaveV2 kernel instance is reused across
+  // checkpoints, so the previous save's prefix and content fingerprints are
+  // kept here.
+  mutex mu_;
+  string last_prefix_ TF_GUARDED_BY(mu_);
+  int64_t delta_chain_len_ TF_GUARDED_BY(mu_) = 0;
+  std::unordered_map<string, uint64> delta_fingerprints_ TF_GUARDED_BY(mu_);
+
+  // Async-save state (TF_BUNDLE_ASYNC_SAVE).  Destroying the thread joins
+  // it; async_save_status_ is only read after such a join.
+  std::unique_ptr<Thread> pending_async_save_;
+  mutex async_mu_;
+  Status async_save_status_ TF_GUARDED_BY(async_mu_);
 };
 REGISTER_KERNEL_BUILDER(Name("SaveV2").Device(DEVICE_CPU), SaveV2);
 
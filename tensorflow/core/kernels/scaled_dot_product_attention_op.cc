@@ -0,0 +1,225 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Implements the _FusedScaledDotProductAttention op, created by the grappler
+// remapper from BatchMatMul-Mul-(Add-)Softmax-BatchMatMul subgraphs:
+//
+//   output = softmax(query * key^T * scale + mask) * value
+//
+// The attention probabilities are computed one block of query rows at a time,
+// so only a [query_block, k_len] tile of the attention matrix is ever
+// materialized instead of the full [q_len, k_len] matrix that the unfused
+// subgraph produces.
+//
+// Currently supported only on CPU device.
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <cstdint>
+
+#include "Eigen/Core"  // from @eigen_archive
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+
+namespace {
+
+// Number of query rows processed per sharded work unit. The per-unit scratch
+// tile has kQueryBlockSize * k_len elements, small enough to stay cache
+// resident for typical sequence lengths.
+constexpr int64_t kQueryBlockSize = 128;
+
+using ConstMatrixMap = Eigen::Map<
+    const Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
+using MatrixMap = Eigen::Map<
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
+using ConstRowVectorMap = Eigen::Map<const Eigen::RowVectorXf>;
+
+}  // namespace
+
+class ScaledDotProductAttentionOp : public OpKernel {
+ public:
+  explicit ScaledDotProductAttentionOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("scale", &scale_));
+    int num_args;
+    OP_REQUIRES_OK(context, context->GetAttr("num_args", &num_args));
+    OP_REQUIRES(context, num_args == 0 || num_args == 1,
+                errors::InvalidArgument(
+                    "_FusedScaledDotProductAttention accepts at most one "
+                    "additional mask argument; got ",
+                    num_args));
+    has_mask_ = num_args == 1;
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& query = context->input(0);
+    const Tensor& key = context->input(1);
+    const Tensor& value = context->input(2);
+
+    OP_REQUIRES(context,
+                query.dims() == 4 && key.dims() == 4 && value.dims() == 4,
+                errors::InvalidArgument(
+                    "query, key and value must be rank-4 tensors; got ranks ",
+                    query.dims(), ", ", key.dims(), " and ", value.dims()));
+
+    const int64_t batch = query.dim_size(0);
+    const int64_t heads = query.dim_size(1);
+    const int64_t q_len = query.dim_size(2);
+    const int64_t head_dim = query.dim_size(3);
+    const int64_t k_len = key.dim_size(2);
+    const int64_t value_dim = value.dim_size(3);
+
+    OP_REQUIRES(context,
+                key.dim_size(0) == batch && key.dim_size(1) == heads &&
+                    key.dim_size(3) == head_dim,
+                errors::InvalidArgument("key shape ", key.shape().DebugString(),
+                                        " is incompatible with query shape ",
+                                        query.shape().DebugString()));
+    OP_REQUIRES(
+        context,
+        value.dim_size(0) == batch && value.dim_size(1) == heads &&
+            value.dim_size(2) == k_len,
+        errors::InvalidArgument("value shape ", value.shape().DebugString(),
+                                " is incompatible with key shape ",
+                                key.shape().DebugString()));
+
+    const float* mask_data = nullptr;
+    int64_t mask_dims[4] = {1, 1, 1, 1};
+    if (has_mask_) {
+      const Tensor& mask = context->input(3);
+      OP_REQUIRES(context, mask.dims() == 4,
+                  errors::InvalidArgument("mask must be a rank-4 tensor; got ",
+                                          mask.shape().DebugString()));
+      const int64_t score_dims[4] = {batch, heads, q_len, k_len};
+      for (int i = 0; i < 4; ++i) {
+        mask_dims[i] = mask.dim_size(i);
+        OP_REQUIRES(
+            context, mask_dims[i] == 1 || mask_dims[i] == score_dims[i],
+            errors::InvalidArgument("mask shape ", mask.shape().DebugString(),
+                                    " does not broadcast against attention "
+                                    "score shape [",
+                                    batch, ", ", heads, ", ", q_len, ", ",
+                                    k_len, "]"));
+      }
+      mask_data = mask.flat<float>().data();
+    }
+
+    Tensor* output;
+    OP_REQUIRES_OK(context,
+                   context->allocate_output(
+                       0, TensorShape({batch, heads, q_len, value_dim}),
+                       &output));
+    if (output->NumElements() == 0) return;
+    if (k_len == 0) {
+      // With no keys there are no attention scores to normalize; skip the
+      // softmax (whose row reductions are undefined on zero-length rows) and
+      // match the unfused subgraph, whose final BatchMatMul contracts over
+      // zero elements and produces zeros.
+      output->flat<float>().setZero();
+      return;
+    }
+
+    const float* query_data = query.flat<float>().data();
+    const float* key_data = key.flat<float>().data();
+    const float* value_data = value.flat<float>().data();
+    float* output_data = output->flat<float>().data();
+
+    const int64_t num_query_blocks =
+        (q_len + kQueryBlockSize - 1) / kQueryBlockSize;
+    const int64_t total_units = batch * heads * num_query_blocks;
+    const float scale = scale_;
+
+    auto compute_blocks = [&](int64_t begin, int64_t end) {
+      Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+          scores(kQueryBlockSize, k_len);
+      for (int64_t unit = begin; unit < end; ++unit) {
+        const int64_t block = unit % num_query_blocks;
+        const int64_t batch_head = unit / num_query_blocks;
+        const int64_t b = batch_head / heads;
+        const int64_t n = batch_head % heads;
+
+        const int64_t row_begin = block * kQueryBlockSize;
+        const int64_t rows = std::min(kQueryBlockSize, q_len - row_begin);
+
+        ConstMatrixMap q_mat(
+            query_data + (batch_head * q_len + row_begin) * head_dim, rows,
+            head_dim);
+        ConstMatrixMap k_mat(key_data + batch_head * k_len * head_dim, k_len,
+                             head_dim);
+        ConstMatrixMap v_mat(value_data + batch_head * k_len * value_dim,
+                             k_len, value_dim);
+        MatrixMap out_mat(
+            output_data + (batch_head * q_len + row_begin) * value_dim, rows,
+            value_dim);
+
+        auto scores_block = scores.topRows(rows);
+        scores_block.noalias() = q_mat * k_mat.transpose();
+        scores_block *= scale;
+
+        if (mask_data != nullptr) {
+          const int64_t mask_b = mask_dims[0] == 1 ? 0 : b;
+          const int64_t mask_n = mask_dims[1] == 1 ? 0 : n;
+          for (int64_t r = 0; r < rows; ++r) {
+            const int64_t mask_q =
+                mask_dims[2] == 1 ? 0 : row_begin + r;
+            const float* mask_row =
+                mask_data +
+                ((mask_b * mask_dims[1] + mask_n) * mask_dims[2] + mask_q) *
+                    mask_dims[3];
+            if (mask_dims[3] == 1) {
+              scores_block.row(r).array() += mask_row[0];
+            } else {
+              scores_block.row(r) += ConstRowVectorMap(mask_row, k_len);
+            }
+          }
+        }
+
+        // Row-wise softmax, subtracting the row max for numerical stability.
+        for (int64_t r = 0; r < rows; ++r) {
+          auto row = scores_block.row(r).array();
+          row = (row - row.maxCoeff()).exp();
+          row /= row.sum();
+        }
+
+        out_mat.noalias() = scores_block * v_mat;
+      }
+    };
+
+    // Each unit computes a [rows, k_len] score tile and a [rows, value_dim]
+    // output tile.
+    const int64_t cost_per_unit =
+        kQueryBlockSize * k_len * (head_dim + value_dim + 4);
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    Shard(worker_threads.num_threads, worker_threads.workers, total_units,
+          cost_per_unit, compute_blocks);
+  }
+
+ private:
+  float scale_;
+  bool has_mask_;
+};
+
+REGISTER_KERNEL_BUILDER(Name("_FusedScaledDotProductAttention")
+                            .Device(DEVICE_CPU)
+                            .TypeConstraint<float>("T"),
+                        ScaledDotProductAttentionOp);
+
+}  // namespace tensorflow
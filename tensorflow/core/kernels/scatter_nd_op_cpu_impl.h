@@ -20,7 +20,9 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
 #include <atomic>
+#include <vector>
 
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 
@@ -127,6 +129,18 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
           batch_strides[dim + 1] * output_shape_prefix[dim + 1];
     }
 
+    // For large scatters, bucket the updates by contiguous ranges of output
+    // rows and apply the buckets in parallel. Each output row belongs to
+    // exactly one bucket and updates within a bucket are applied in input
+    // order, so the result — including the floating point accumulation order
+    // on index collisions — is identical to the serial loop below.
+    if (IXDIM > 0 && d.numThreads() > 1 && Toutput.dimension(0) > 1 &&
+        batch_size * static_cast<Eigen::DenseIndex>(slice_size) >=
+            kMinWorkForParallel) {
+      return ParallelScatter(d, slice_size, output_shape_prefix, batch_strides,
+                             Tindices, Tupdates, Toutput);
+    }
+
     for (Eigen::DenseIndex loc = 0; loc < batch_size; ++loc) {
       Index i = 0;
       bool out_of_bounds = false;
@@ -153,6 +167,107 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
 
     return error_loc;
   }
+
+ private:
+  // Minimum number of updated elements before the bucketed parallel
+  // implementation pays for its bookkeeping.
+  static constexpr Eigen::DenseIndex kMinWorkForParallel = 1 << 16;
+
+  static Index ParallelScatter(
+      const CPUDevice& d, const Index slice_size,
+      const Eigen::array<Eigen::DenseIndex, IXDIM>& output_shape_prefix,
+      const Index* batch_strides,
+      typename TTypes<Index, 2>::ConstTensor Tindices,
+      typename TTypes<T, 2>::ConstTensor Tupdates,
+      typename TTypes<T, 2>::Tensor Toutput) {
+    const Eigen::DenseIndex batch_size = Tindices.dimension(0);
+    const Eigen::DenseIndex num_rows = Toutput.dimension(0);
+
+    // Phase 1: resolve every update to its output row, in parallel. Bad
+    // indices are marked with row -1; as in the serial loop, the last one
+    // is reported and the rest of the updates are still applied.
+    std::vector<Index> target_rows(batch_size);
+    std::atomic<Index> error_loc{-1};
+    const Eigen::TensorOpCost resolve_cost(IXDIM * sizeof(Index),
+                                           sizeof(Index), IXDIM);
+    d.parallelFor(batch_size, resolve_cost,
+                  [&](Eigen::DenseIndex begin, Eigen::DenseIndex end) {
+                    for (Eigen::DenseIndex loc = begin; loc < end; ++loc) {
+                      Index i = 0;
+                      bool out_of_bounds = false;
+                      for (int dim = 0; dim < IXDIM; ++dim) {
+                        const Index ix_d =
+                            internal::SubtleMustCopy(Tindices(loc, dim));
+                        out_of_bounds |=
+                            !FastBoundsCheck(ix_d, output_shape_prefix[dim]);
+                        i += ix_d * batch_strides[dim];
+                      }
+                      if (TF_PREDICT_FALSE(out_of_bounds)) {
+                        Index prev = error_loc.load(std::memory_order_relaxed);
+                        while (prev < static_cast<Index>(loc) &&
+                               !error_loc.compare_exchange_weak(
+                                   prev, static_cast<Index>(loc))) {
+                        }
+                        target_rows[loc] = -1;
+                      } else {
+                        target_rows[loc] = i;
+                      }
+                    }
+                  });
+
+    // Phase 2: counting sort of the updates into buckets of contiguous output
+    // rows. Scanning `loc` in order keeps every bucket sorted by input
+    // position, making the intra-bucket apply order deterministic.
+    const Eigen::DenseIndex num_buckets =
+        std::min<Eigen::DenseIndex>(d.numThreads(), num_rows);
+    const Eigen::DenseIndex rows_per_bucket =
+        (num_rows + num_buckets - 1) / num_buckets;
+    std::vector<Eigen::DenseIndex> bucket_starts(num_buckets + 1, 0);
+    for (Eigen::DenseIndex loc = 0; loc < batch_size; ++loc) {
+      if (target_rows[loc] < 0) continue;
+      ++bucket_starts[target_rows[loc] / rows_per_bucket + 1];
+    }
+    for (Eigen::DenseIndex b = 0; b < num_buckets; ++b) {
+      bucket_starts[b + 1] += bucket_starts[b];
+    }
+    std::vector<Eigen::DenseIndex> sorted_locs(bucket_starts[num_buckets]);
+    std::vector<Eigen::DenseIndex> cursors(bucket_starts.begin(),
+                                           bucket_starts.end() - 1);
+    for (Eigen::DenseIndex loc = 0; loc < batch_size; ++loc) {
+      if (target_rows[loc] < 0) continue;
+      sorted_locs[cursors[target_rows[loc] / rows_per_bucket]++] = loc;
+    }
+
+    // Phase 3: apply the buckets in parallel. Buckets own disjoint row
+    // ranges, so no two threads ever touch the same output row, and slices
+    // are copied inline rather than re-entering the thread pool.
+    Eigen::DefaultDevice inline_device;
+    const double work_per_bucket =
+        static_cast<double>(batch_size) / num_buckets * slice_size;
+    const Eigen::TensorOpCost apply_cost(2 * work_per_bucket * sizeof(T),
+                                         work_per_bucket * sizeof(T),
+                                         work_per_bucket);
+    d.parallelFor(
+        num_buckets, apply_cost,
+        [&](Eigen::DenseIndex begin, Eigen::DenseIndex end) {
+          for (Eigen::DenseIndex b = begin; b < end; ++b) {
+            for (Eigen::DenseIndex k = bucket_starts[b];
+                 k < bucket_starts[b + 1]; ++k) {
+              const Eigen::DenseIndex loc = sorted_locs[k];
+              auto input_chip = Toutput.template chip<0>(target_rows[loc]);
+              auto output_chip = input_chip;
+              auto update_chip = Tupdates.template chip<0>(loc);
+              update_executor::UpdateExecutor<
+                  Eigen::DefaultDevice, decltype(input_chip),
+                  decltype(update_chip), decltype(output_chip),
+                  OP>::Execute(inline_device, input_chip, update_chip,
+                               output_chip);
+            }
+          }
+        });
+
+    return error_loc.load(std::memory_order_relaxed);
+  }
 };
 
 #define REGISTER_SCATTER_ND_FULL(T, Index, op)                               \
@@ -175,6 +175,56 @@ TEST_F(ScatterNdUpdateOpTest, HigherRank) {
   test::ExpectTensorEqual<float>(expected, params_tensor);
 }
 
+class ScatterNdAddOpTest : public OpsTestBase {
+ protected:
+  void MakeOp(DataType variable_ref_type, DataType index_type) {
+    TF_ASSERT_OK(NodeDefBuilder("myop", "ScatterNdAdd")
+                     .Input(FakeInput(variable_ref_type))
+                     .Input(FakeInput(index_type))
+                     .Input(FakeInput(RemoveRefType(variable_ref_type)))
+                     .Finalize(node_def()));
+    TF_ASSERT_OK(InitOp());
+  }
+};
+
+// Large scatter with many index collisions; big enough to take the bucketed
+// parallel path in the CPU functor, which must accumulate collisions in the
+// same order as the serial loop.
+TEST_F(ScatterNdAddOpTest, LargeWithDuplicateIndices) {
+  MakeOp(DT_FLOAT_REF, DT_INT32);
+
+  constexpr int kNumRows = 32;
+  constexpr int kSliceSize = 8;
+  constexpr int kNumUpdates = 16384;
+
+  std::vector<float> params(kNumRows * kSliceSize, 0);
+  std::vector<int32> indices(kNumUpdates);
+  std::vector<float> updates(kNumUpdates * kSliceSize);
+  std::vector<float> expected(params);
+  for (int loc = 0; loc < kNumUpdates; ++loc) {
+    const int32 row = (loc * 7) % kNumRows;
+    indices[loc] = row;
+    for (int j = 0; j < kSliceSize; ++j) {
+      const float value = (loc + j) % 5;
+      updates[loc * kSliceSize + j] = value;
+      expected[row * kSliceSize + j] += value;
+    }
+  }
+
+  // Feed and run
+  AddInputFromArray<float>(TensorShape({kNumRows, kSliceSize}), params);
+  AddInputFromArray<int32>(TensorShape({kNumUpdates, 1}), indices);
+  AddInputFromArray<float>(TensorShape({kNumUpdates, kSliceSize}), updates);
+  TF_ASSERT_OK(RunOpKernel());
+
+  // Check the new state of the input
+  Tensor params_tensor = *mutable_input(0).tensor;
+  Tensor expected_tensor(allocator(), DT_FLOAT,
+                         TensorShape({kNumRows, kSliceSize}));
+  test::FillValues<float>(&expected_tensor, expected);
+  test::ExpectTensorEqual<float>(expected_tensor, params_tensor);
+}
+
 TEST_F(ScatterNdUpdateOpTest, Error_IndexOutOfRange) {
   MakeOp(DT_FLOAT_REF, DT_INT32);
 
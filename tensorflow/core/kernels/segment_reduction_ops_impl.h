@@ -51,8 +51,10 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/bfloat16.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/util/determinism.h"
 #include "tensorflow/core/util/util.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 #include "tensorflow/core/common_runtime/gpu/gpu_event_mgr.h"
@@ -618,79 +620,97 @@ class SparseSegmentReductionOpBase : public OpKernel {
                 errors::InvalidArgument("segment ids must be >= 0"));
     auto output_flat = output->flat_outer_dims<T>();
 
-    // If we use DT_BFLOAT16 or DT_HALF, we need to use DT_FLOAT for
-    // accumulation. We create a temp tensor to perform this accumulation for
-    // every segment.
-    Tensor temp;
-    if (input.dtype() == DT_BFLOAT16 || input.dtype() == DT_HALF) {
-      TensorShape temp_shape = output_shape;
-      OP_REQUIRES_OK(context, temp_shape.SetDimWithStatus(/*d=*/0, /*size=*/1));
-      temp = tensorflow::Tensor(DT_FLOAT, temp_shape);
-    }
-    auto temp_flat = temp.flat_outer_dims<float>();
-
-    int64_t start = 0, end = 1;
-    // Index from which the output is not initialized.
-    SegmentId uninitialized_index = 0;
-    SegmentId out_index = internal::SubtleMustCopy(segment_vec(start));
-
-    while (true) {
-      // We initialize next_index to 0 to avoid "warning: 'next_index' may be
-      // used uninitialized in this function" in the Mac build (since the
-      // compiler isn't smart enough to realize the code is safe).
-      SegmentId next_index = 0;
-      if (end < num_indices) {
-        next_index = internal::SubtleMustCopy(segment_vec(end));
-        if (out_index == next_index) {
-          ++end;
-          continue;
-        }
-        // We have a new segment here.  Verify that the segment ids are growing.
-        OP_REQUIRES(context, out_index < next_index,
+    // Discover the segment boundaries up front, validating that the segment
+    // ids are sorted and in range. The boundary list lets the reduction
+    // below run in parallel: each segment accumulates rows from the input
+    // directly into its own output row, so segments are independent.
+    std::vector<int64_t> segment_starts;
+    std::vector<SegmentId> segment_out_indices;
+    {
+      SegmentId prev_out_index = 0;
+      for (int64_t i = 0; i < num_indices; ++i) {
+        const SegmentId id = internal::SubtleMustCopy(segment_vec(i));
+        if (i > 0 && id == prev_out_index) continue;
+        // We have a new segment here.  Verify that the segment ids are
+        // growing.
+        OP_REQUIRES(context, i == 0 || prev_out_index < id,
                     errors::InvalidArgument("segment ids are not increasing"));
+        OP_REQUIRES(
+            context, FastBoundsCheck(id, output_rows),
+            errors::InvalidArgument(
+                "Segment id ", id, " out of range [0, ", output_rows,
+                "), possibly because 'segment_ids' input is not sorted."));
+        segment_starts.push_back(i);
+        segment_out_indices.push_back(id);
+        prev_out_index = id;
       }
-
-      OP_REQUIRES(
-          context, FastBoundsCheck(out_index, output_rows),
-          errors::InvalidArgument(
-              "Segment id ", out_index, " out of range [0, ", output_rows,
-              "), possibly because 'segment_ids' input is not sorted."));
-
-      // If there is a gap between two indices, we need to set that gap to the
-      // default value.
-      if (out_index > uninitialized_index) {
-        Eigen::DSizes<Eigen::DenseIndex, 2> gap_slice_shape(
-            out_index - uninitialized_index, num_col);
-        Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor>, Eigen::Unaligned>
-            gap_slice(&output_flat(uninitialized_index, 0), gap_slice_shape);
-        gap_slice.setConstant(default_value_);
-      }
-
-      auto out = output_flat.template chip<0>(out_index);
-      auto temp = temp_flat.template chip<0>(0);
-      const int bad_offset = Reduce<T, Index>(input_flat, indices_vec, start,
-                                              end - start, out, temp);
-      OP_REQUIRES(context, bad_offset < 0,
-                  errors::InvalidArgument(
-                      "Bad: indices[", start + bad_offset,
-                      "] == ", indices_vec(start + bad_offset),
-                      " out of range [0, ", input_flat.dimension(0), ")"));
-
-      start = end;
-      ++end;
-      uninitialized_index = out_index + 1;
-      out_index = next_index;
-      if (end > num_indices) break;
+      segment_starts.push_back(num_indices);
     }
+    const int64_t num_present_segments = segment_out_indices.size();
 
-    // Fill the gap at the end with the default value.
-    if (uninitialized_index < output_rows) {
-      Eigen::DSizes<Eigen::DenseIndex, 2> gap_slice_shape(
-          output_rows - uninitialized_index, num_col);
+    // Set output rows with no corresponding segment ids to the default value.
+    SegmentId uninitialized_index = 0;
+    auto fill_gap = [&](SegmentId gap_begin, SegmentId gap_end) {
+      Eigen::DSizes<Eigen::DenseIndex, 2> gap_slice_shape(gap_end - gap_begin,
+                                                          num_col);
       Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor>, Eigen::Unaligned>
-          gap_slice(&output_flat(uninitialized_index, 0), gap_slice_shape);
+          gap_slice(&output_flat(gap_begin, 0), gap_slice_shape);
       gap_slice.setConstant(default_value_);
+    };
+    for (int64_t s = 0; s < num_present_segments; ++s) {
+      if (segment_out_indices[s] > uninitialized_index) {
+        fill_gap(uninitialized_index, segment_out_indices[s]);
+      }
+      uninitialized_index = segment_out_indices[s] + 1;
+    }
+    if (uninitialized_index < output_rows) {
+      fill_gap(uninitialized_index, output_rows);
     }
+
+    // Reduce the segments in parallel across the intra-op pool. Shard hands
+    // each worker a contiguous range of segments, i.e. a contiguous range of
+    // output rows. The only shared state is the bad-index report.
+    mutex mu;
+    int64_t bad_index_pos = -1;
+    const DataType dtype = input.dtype();
+    auto work = [&](int64_t seg_begin, int64_t seg_end) {
+      // If we use DT_BFLOAT16 or DT_HALF, we need to use DT_FLOAT for
+      // accumulation. Each shard gets its own scratch row.
+      Tensor temp;
+      if (dtype == DT_BFLOAT16 || dtype == DT_HALF) {
+        TensorShape temp_shape = output_shape;
+        temp_shape.set_dim(/*d=*/0, /*size=*/1);
+        temp = tensorflow::Tensor(DT_FLOAT, temp_shape);
+      }
+      auto temp_flat = temp.flat_outer_dims<float>();
+      for (int64_t s = seg_begin; s < seg_end; ++s) {
+        const int64_t start = segment_starts[s];
+        const int64_t num = segment_starts[s + 1] - start;
+        auto out = output_flat.template chip<0>(segment_out_indices[s]);
+        auto temp_chip = temp_flat.template chip<0>(0);
+        const int bad_offset = Reduce<T, Index>(input_flat, indices_vec, start,
+                                                num, out, temp_chip);
+        if (bad_offset >= 0) {
+          mutex_lock l(mu);
+          if (bad_index_pos < 0 || start + bad_offset < bad_index_pos) {
+            bad_index_pos = start + bad_offset;
+          }
+          return;
+        }
+      }
+    };
+    auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    const int64_t avg_segment_cost =
+        std::max<int64_t>(1, num_indices * num_col * sizeof(T) /
+                                 num_present_segments);
+    Shard(worker_threads->num_threads, worker_threads->workers,
+          num_present_segments, avg_segment_cost, work);
+
+    OP_REQUIRES(context, bad_index_pos < 0,
+                errors::InvalidArgument(
+                    "Bad: indices[", bad_index_pos,
+                    "] == ", indices_vec(bad_index_pos),
+                    " out of range [0, ", input_flat.dimension(0), ")"));
   }
 
  private:
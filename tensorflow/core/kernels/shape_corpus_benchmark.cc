@@ -0,0 +1,308 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Replays a JSON corpus of op shapes (typically captured from profiler traces
+// of production jobs) as kernel-level CPU benchmarks, reporting per-entry
+// GFLOP/s and bytes/s plus the achieved fraction of the machine's roofline.
+// This catches regressions on shapes — tall-skinny matmuls, high-rank
+// transposes — that the hand-written per-kernel benchmarks do not cover.
+//
+// Usage:
+//   bazel run -c opt //tensorflow/core/kernels:shape_corpus_benchmark -- \
+//     --corpus=/path/to/corpus.json --peak_gflops=3000 --peak_gbps=200
+//
+// The corpus is a JSON array of entries:
+//   [{"name": "tall_skinny_matmul",
+//     "op": "MatMul",
+//     "inputs": [{"dtype": "float", "shape": [4096, 16]},
+//                {"dtype": "float", "shape": [16, 16]}],
+//     "attrs": {"transpose_a": false}},
+//    {"name": "rank5_transpose",
+//     "op": "Transpose",
+//     "inputs": [{"dtype": "float", "shape": [8, 4, 32, 32, 16]},
+//                {"dtype": "int32", "shape": [5], "value": [0, 3, 1, 2, 4]}]}]
+//
+// Integer inputs may carry a "value" list for operands whose contents matter
+// (permutations, reduction axes); all other inputs are filled with ones.
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "json/json.h"
+#include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/graph/testlib.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/init_main.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/test_benchmark.h"
+#include "tensorflow/core/util/command_line_flags.h"
+
+namespace tensorflow {
+namespace {
+
+struct InputSpec {
+  DataType dtype;
+  TensorShape shape;
+  std::vector<int64_t> value;  // Optional; only for integer inputs.
+};
+
+struct BenchmarkSpec {
+  string name;
+  string op;
+  std::vector<InputSpec> inputs;
+  Json::Value attrs;
+};
+
+Status ParseCorpus(const string& text, std::vector<BenchmarkSpec>* specs) {
+  Json::Value root;
+  Json::Reader reader;
+  if (!reader.parse(text, root) || !root.isArray()) {
+    return errors::InvalidArgument(
+        "Corpus must be a JSON array of benchmark entries: ",
+        reader.getFormattedErrorMessages());
+  }
+  for (const Json::Value& entry : root) {
+    BenchmarkSpec spec;
+    spec.name = entry["name"].asString();
+    spec.op = entry["op"].asString();
+    if (spec.name.empty() || spec.op.empty()) {
+      return errors::InvalidArgument(
+          "Every corpus entry needs a \"name\" and an \"op\"");
+    }
+    for (const Json::Value& input : entry["inputs"]) {
+      InputSpec input_spec;
+      if (!DataTypeFromString(input["dtype"].asString(), &input_spec.dtype)) {
+        return errors::InvalidArgument("Unknown dtype in entry ", spec.name,
+                                       ": ", input["dtype"].asString());
+      }
+      for (const Json::Value& dim : input["shape"]) {
+        TF_RETURN_IF_ERROR(input_spec.shape.AddDimWithStatus(dim.asInt64()));
+      }
+      for (const Json::Value& v : input["value"]) {
+        input_spec.value.push_back(v.asInt64());
+      }
+      spec.inputs.push_back(std::move(input_spec));
+    }
+    spec.attrs = entry["attrs"];
+    specs->push_back(std::move(spec));
+  }
+  return absl::OkStatus();
+}
+
+Status MakeInputTensor(const InputSpec& spec, Tensor* out) {
+  *out = Tensor(spec.dtype, spec.shape);
+  switch (spec.dtype) {
+    case DT_FLOAT:
+      out->flat<float>().setConstant(1.0f);
+      break;
+    case DT_DOUBLE:
+      out->flat<double>().setConstant(1.0);
+      break;
+    case DT_HALF:
+      out->flat<Eigen::half>().setConstant(Eigen::half(1.0f));
+      break;
+    case DT_BFLOAT16:
+      out->flat<bfloat16>().setConstant(bfloat16(1.0f));
+      break;
+    case DT_BOOL:
+      out->flat<bool>().setConstant(true);
+      break;
+    case DT_INT32: {
+      auto flat = out->flat<int32>();
+      flat.setConstant(1);
+      for (int64_t i = 0;
+           i < std::min<int64_t>(spec.value.size(), flat.size()); ++i) {
+        flat(i) = static_cast<int32>(spec.value[i]);
+      }
+      break;
+    }
+    case DT_INT64: {
+      auto flat = out->flat<int64_t>();
+      flat.setConstant(1);
+      for (int64_t i = 0;
+           i < std::min<int64_t>(spec.value.size(), flat.size()); ++i) {
+        flat(i) = spec.value[i];
+      }
+      break;
+    }
+    default:
+      return errors::Unimplemented("Corpus input dtype not supported: ",
+                                   DataTypeString(spec.dtype));
+  }
+  return absl::OkStatus();
+}
+
+// Analytic flop and byte counts for the op classes we model explicitly. Other
+// ops fall back to a bandwidth-only estimate of one read and one write of
+// every input element, and report no GFLOP/s.
+void EstimateFlopsAndBytes(const BenchmarkSpec& spec, double* flops,
+                           double* bytes) {
+  double input_bytes = 0;
+  for (const InputSpec& input : spec.inputs) {
+    input_bytes +=
+        input.shape.num_elements() * DataTypeSize(input.dtype);
+  }
+  *flops = 0;
+  *bytes = 2 * input_bytes;
+  if ((spec.op == "MatMul" || spec.op == "BatchMatMul" ||
+       spec.op == "BatchMatMulV2") &&
+      spec.inputs.size() >= 2) {
+    const TensorShape& a = spec.inputs[0].shape;
+    const TensorShape& b = spec.inputs[1].shape;
+    if (a.dims() < 2 || b.dims() < 2) return;
+    const bool transpose_a = spec.attrs.get("transpose_a", false).asBool() ||
+                             spec.attrs.get("adj_x", false).asBool();
+    const bool transpose_b = spec.attrs.get("transpose_b", false).asBool() ||
+                             spec.attrs.get("adj_y", false).asBool();
+    const int64_t m = a.dim_size(transpose_a ? a.dims() - 1 : a.dims() - 2);
+    const int64_t k = a.dim_size(transpose_a ? a.dims() - 2 : a.dims() - 1);
+    const int64_t n = b.dim_size(transpose_b ? b.dims() - 2 : b.dims() - 1);
+    int64_t batch = 1;
+    for (int i = 0; i < a.dims() - 2; ++i) batch *= a.dim_size(i);
+    const int64_t element_size = DataTypeSize(spec.inputs[0].dtype);
+    *flops = 2.0 * batch * m * n * k;
+    *bytes = input_bytes + 1.0 * batch * m * n * element_size;
+  } else if (spec.op == "Transpose" || spec.op == "ConjugateTranspose") {
+    *bytes = 2.0 * spec.inputs[0].shape.num_elements() *
+             DataTypeSize(spec.inputs[0].dtype);
+  }
+}
+
+Status BuildGraph(const BenchmarkSpec& spec, Graph* graph) {
+  std::vector<NodeBuilder::NodeOut> inputs;
+  for (const InputSpec& input : spec.inputs) {
+    Tensor t;
+    TF_RETURN_IF_ERROR(MakeInputTensor(input, &t));
+    inputs.emplace_back(test::graph::Constant(graph, t));
+  }
+  NodeBuilder builder(graph->NewName(spec.name), spec.op);
+  for (const NodeBuilder::NodeOut& input : inputs) {
+    builder.Input(input);
+  }
+  for (const string& attr : spec.attrs.getMemberNames()) {
+    const Json::Value& value = spec.attrs[attr];
+    if (value.isBool()) {
+      builder.Attr(attr, value.asBool());
+    } else if (value.isIntegral()) {
+      builder.Attr(attr, static_cast<int64_t>(value.asInt64()));
+    } else if (value.isDouble()) {
+      builder.Attr(attr, value.asFloat());
+    } else if (value.isArray()) {
+      std::vector<int64_t> ints;
+      for (const Json::Value& v : value) ints.push_back(v.asInt64());
+      builder.Attr(attr, ints);
+    } else if (value.isString()) {
+      DataType dtype;
+      if (DataTypeFromString(value.asString(), &dtype)) {
+        builder.Attr(attr, dtype);
+      } else {
+        builder.Attr(attr, value.asString());
+      }
+    } else {
+      return errors::InvalidArgument("Unsupported attr value for ", attr,
+                                     " in entry ", spec.name);
+    }
+  }
+  Node* unused;
+  return builder.Finalize(graph, &unused);
+}
+
+void RunShapeBenchmark(const BenchmarkSpec& spec, float peak_gflops,
+                       float peak_gbps, ::benchmark::State& state) {
+  Graph* graph = new Graph(OpRegistry::Global());
+  Status status = BuildGraph(spec, graph);
+  if (!status.ok()) {
+    delete graph;
+    state.SkipWithError(std::string(status.message()).c_str());
+    return;
+  }
+
+  double flops, bytes;
+  EstimateFlopsAndBytes(spec, &flops, &bytes);
+
+  test::Benchmark("cpu", graph, /*old_benchmark_api=*/false).Run(state);
+
+  state.SetBytesProcessed(static_cast<int64_t>(bytes) * state.iterations());
+  if (flops > 0) {
+    state.counters["FLOP/s"] = ::benchmark::Counter(
+        flops, ::benchmark::Counter::kIsIterationInvariantRate);
+  }
+  // Percentage of the roofline bound: compute-peak for flop-heavy entries
+  // limited by their arithmetic intensity, memory bandwidth for the rest.
+  if (peak_gflops > 0 && peak_gbps > 0) {
+    const double attainable_flops_per_sec =
+        flops > 0 ? std::min<double>(peak_gflops * 1e9,
+                                     flops / bytes * peak_gbps * 1e9)
+                  : 0;
+    const double per_iteration_fraction =
+        flops > 0 ? flops / attainable_flops_per_sec
+                  : bytes / (peak_gbps * 1e9);
+    state.counters["roofline_pct"] = ::benchmark::Counter(
+        100.0 * per_iteration_fraction,
+        ::benchmark::Counter::kIsIterationInvariantRate);
+  }
+}
+
+}  // namespace
+}  // namespace tensorflow
+
+int main(int argc, char** argv) {
+  tensorflow::string corpus_path;
+  float peak_gflops = 0;
+  float peak_gbps = 0;
+  std::vector<tensorflow::Flag> flag_list = {
+      tensorflow::Flag("corpus", &corpus_path,
+                       "path to the JSON corpus of op shapes to replay"),
+      tensorflow::Flag("peak_gflops", &peak_gflops,
+                       "peak GFLOP/s of this machine, for roofline reporting"),
+      tensorflow::Flag("peak_gbps", &peak_gbps,
+                       "peak memory bandwidth in GB/s, for roofline "
+                       "reporting"),
+  };
+  const tensorflow::string usage =
+      tensorflow::Flags::Usage(argv[0], flag_list);
+  if (!tensorflow::Flags::Parse(&argc, argv, flag_list) ||
+      corpus_path.empty()) {
+    LOG(ERROR) << usage;
+    return 2;
+  }
+  tensorflow::port::InitMain(argv[0], &argc, &argv);
+
+  tensorflow::string corpus_text;
+  TF_CHECK_OK(tensorflow::ReadFileToString(tensorflow::Env::Default(),
+                                           corpus_path, &corpus_text));
+  std::vector<tensorflow::BenchmarkSpec> specs;
+  TF_CHECK_OK(tensorflow::ParseCorpus(corpus_text, &specs));
+
+  for (const tensorflow::BenchmarkSpec& spec : specs) {
+    ::benchmark::RegisterBenchmark(
+        ("BM_" + spec.name).c_str(),
+        [spec, peak_gflops, peak_gbps](::benchmark::State& state) {
+          tensorflow::RunShapeBenchmark(spec, peak_gflops, peak_gbps, state);
+        });
+  }
+  ::benchmark::Initialize(&argc, argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -19,12 +19,15 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/sparse_tensor_dense_matmul_op.h"
 
+#include <vector>
+
 #include "Eigen/Core"  // from @eigen_archive
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/kernels/fill_functor.h"
 #include "tensorflow/core/platform/bfloat16.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 
@@ -251,13 +254,99 @@ Status MOutOfBoundsError(int64_t m, std::size_t i, int lhs_index_a,
                                  "] out of bounds (>=", out_dim0, ")");
 }
 
+// Groups the COO entries of A by output row into a CSR-style structure
+// (row offsets plus a permutation of the nnz entries), then shards the rows
+// of the output across the intra-op pool. Because every output row is
+// produced by exactly one shard, the accumulation needs no synchronization.
+// All index bounds are validated during the grouping pass, so the sharded
+// loop below cannot fail.
+template <typename T, typename Tsum, typename Tindices, bool ADJ_A, bool ADJ_B>
+Status SparseTensorDenseMatMulParallelImpl(
+    OpKernelContext* ctx, typename TTypes<Tsum>::Matrix out,
+    typename TTypes<Tindices>::ConstMatrix a_indices,
+    typename TTypes<T>::ConstVec a_values, typename TTypes<T>::ConstMatrix b) {
+  const std::size_t nnz = a_values.size();
+  const std::size_t rhs_right = (ADJ_B ? b.dimension(0) : b.dimension(1));
+  const std::size_t lhs_right = (ADJ_B ? b.dimension(1) : b.dimension(0));
+  const int lhs_index_a = ADJ_A ? 1 : 0;
+  const int rhs_index_a = ADJ_A ? 0 : 1;
+  const int64_t out_rows = out.dimension(0);
+
+  // Counting sort of the nnz entries by output row.
+  std::vector<int64_t> row_offsets(out_rows + 1, 0);
+  for (std::size_t i = 0; i < nnz; ++i) {
+    const Tindices m = internal::SubtleMustCopy(a_indices(i, lhs_index_a));
+    const Tindices k = internal::SubtleMustCopy(a_indices(i, rhs_index_a));
+    if (!FastBoundsCheck(k, lhs_right)) {
+      return KOutOfBoundsError(k, i, rhs_index_a, lhs_right);
+    }
+    if (!FastBoundsCheck(m, out_rows)) {
+      return MOutOfBoundsError(m, i, lhs_index_a, out_rows);
+    }
+    ++row_offsets[m + 1];
+  }
+  for (int64_t m = 0; m < out_rows; ++m) {
+    row_offsets[m + 1] += row_offsets[m];
+  }
+  std::vector<int64_t> permutation(nnz);
+  {
+    std::vector<int64_t> next_slot(row_offsets.begin(),
+                                   row_offsets.end() - 1);
+    for (std::size_t i = 0; i < nnz; ++i) {
+      const Tindices m = a_indices(i, lhs_index_a);
+      permutation[next_slot[m]++] = i;
+    }
+  }
+
+  const int b_chip_index = ADJ_B ? 1 : 0;
+  auto worker_threads = *(ctx->device()->tensorflow_cpu_worker_threads());
+  // Charge each row its average share of the multiply-accumulate work.
+  const int64_t cost_per_row =
+      static_cast<int64_t>(nnz) * rhs_right / out_rows + 1;
+
+  auto shard_rows = [&](const auto& b_passed) {
+    Shard(worker_threads.num_threads, worker_threads.workers, out_rows,
+          cost_per_row, [&](int64_t row_start, int64_t row_end) {
+            for (int64_t m = row_start; m < row_end; ++m) {
+              for (int64_t s = row_offsets[m]; s < row_offsets[m + 1]; ++s) {
+                const int64_t i = permutation[s];
+                const Tindices k = a_indices(i, rhs_index_a);
+                const T a_value =
+                    (ADJ_A) ? MaybeConj(a_values(i)) : a_values(i);
+                out.template chip<0>(m) +=
+                    b_passed.template chip<b_chip_index>(k)
+                        .template cast<Tsum>() *
+                    static_cast<Tsum>(a_value);
+              }
+            }
+          });
+  };
+
+  if (ADJ_B) {
+    // Perform transpose and conjugation on B once, since we chip out B's
+    // columns in the nnz loop.
+    Eigen::array<int, 2> shuffle{1, 0};  // preserve dimension order
+    Eigen::Tensor<T, 2, Eigen::ColMajor> col_major_conj_b =
+        b.swap_layout().shuffle(shuffle).conjugate();
+    shard_rows(col_major_conj_b);
+  } else {
+    shard_rows(b);
+  }
+  return absl::OkStatus();
+}
+
 template <typename T, typename Tsum, typename Tindices, bool ADJ_A, bool ADJ_B>
 Status SparseTensorDenseMatMulImpl(
-    typename TTypes<Tsum>::Matrix out,
+    OpKernelContext* ctx, typename TTypes<Tsum>::Matrix out,
     typename TTypes<Tindices>::ConstMatrix a_indices,
     typename TTypes<T>::ConstVec a_values, typename TTypes<T>::ConstMatrix b) {
   // Vectorize certain operations above this size.
   static constexpr std::size_t kNumVectorize = 32;
+  // Minimum multiply-accumulate work before grouping the entries by output
+  // row and sharding the rows across the intra-op pool pays for the extra
+  // counting-sort pass. Smaller problems stay on the single-threaded paths
+  // below, which historically beat naive multi-threading over the nnz loop.
+  static constexpr int64_t kMinWorkForParallel = 1 << 17;
 
   const std::size_t nnz = a_values.size();
   const std::size_t rhs_right = (ADJ_B ? b.dimension(0) : b.dimension(1));
@@ -265,9 +354,14 @@ Status SparseTensorDenseMatMulImpl(
   const int lhs_index_a = ADJ_A ? 1 : 0;
   const int rhs_index_a = ADJ_A ? 0 : 1;
 
-  // TODO(ebrevdo): After many failed experiments, can't find a multi-threaded
-  // approach that achieves the performance of the single threaded
-  // one.  Perhaps Eigen threadpool implementation is just too slow?
+  auto worker_threads = ctx->device()->tensorflow_cpu_worker_threads();
+  if (worker_threads->num_threads > 1 && out.dimension(0) > 1 &&
+      rhs_right >= kNumVectorize &&
+      static_cast<int64_t>(nnz) * rhs_right >= kMinWorkForParallel) {
+    return SparseTensorDenseMatMulParallelImpl<T, Tsum, Tindices, ADJ_A,
+                                               ADJ_B>(ctx, out, a_indices,
+                                                      a_values, b);
+  }
 
   if (rhs_right < kNumVectorize) {
     // Disable vectorization if the RHS of output is too small
@@ -340,7 +434,7 @@ struct SparseTensorDenseMatMulFunctor<CPUDevice, T, Tindices, ADJ_A, ADJ_B> {
       temp_out.setZero();
       TF_RETURN_IF_ERROR(
           SparseTensorDenseMatMulImpl<T, Tsum, Tindices, ADJ_A, ADJ_B>(
-              temp_out, a_indices, a_values, b));
+              ctx, temp_out, a_indices, a_values, b));
       out = temp_out.template cast<T>();
     } else {
       out.setZero();
@@ -350,7 +444,7 @@ struct SparseTensorDenseMatMulFunctor<CPUDevice, T, Tindices, ADJ_A, ADJ_B> {
           *reinterpret_cast<typename TTypes<Tsum>::Matrix*>(&out);
       TF_RETURN_IF_ERROR(
           SparseTensorDenseMatMulImpl<T, Tsum, Tindices, ADJ_A, ADJ_B>(
-              out_workaround, a_indices, a_values, b));
+              ctx, out_workaround, a_indices, a_values, b));
     }
     return OkStatus();
   }
@@ -110,6 +110,50 @@ class StatelessRandomOp : public StatelessRandomOpBase {
   }
 };
 
+// Generates the outputs of a group of same-shape StatelessRandomUniform ops
+// in one kernel invocation. Created by the "stateless_random_fusion" grappler
+// pass to amortize per-op dispatch overhead over many small random tensors.
+// Each output is filled from its own seed with its own Philox stream, so the
+// fused values match the unfused ops bit for bit.
+template <typename Device, class Distribution>
+class FusedStatelessRandomOp : public OpKernel {
+ public:
+  explicit FusedStatelessRandomOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("N", &num_outputs_));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    typedef typename Distribution::ResultElementType T;
+    const Tensor& shape_t = context->input(0);
+    TensorShape shape;
+    OP_REQUIRES_OK(context, tensor::MakeShape(shape_t, &shape));
+
+    for (int i = 0; i < num_outputs_; ++i) {
+      const Tensor& seed_t = context->input(1 + i);
+      OP_REQUIRES(context, seed_t.dims() == 1 && seed_t.dim_size(0) == 2,
+                  errors::InvalidArgument("seed must have shape [2], not ",
+                                          seed_t.shape().DebugString()));
+      Tensor* output;
+      OP_REQUIRES_OK(context, context->allocate_output(i, shape, &output));
+      if (shape.num_elements() == 0) continue;
+
+      random::PhiloxRandom::Key key;
+      random::PhiloxRandom::ResultType counter;
+      OP_REQUIRES_OK(context, GenerateKey(seed_t, &key, &counter));
+
+      auto flat = output->flat<T>();
+      functor::FillPhiloxRandom<Device, Distribution>()(
+          context, context->eigen_device<Device>(), /*key=*/nullptr,
+          /*counter=*/nullptr, random::PhiloxRandom(counter, key), flat.data(),
+          flat.size(), Distribution());
+    }
+  }
+
+ private:
+  int num_outputs_;
+};
+
 template <typename Device, typename IntType>
 class StatelessRandomUniformIntOp : public StatelessRandomOpBase {
  public:
@@ -255,10 +299,25 @@ class StatelessRandomPoissonOp : public StatelessRandomOpBase {
 #define REGISTER_FULL_INT_CPU(TYPE) REGISTER_FULL_INT(CPU, TYPE)
 #define REGISTER_FULL_INT_GPU(TYPE) REGISTER_FULL_INT(GPU, TYPE)
 
+#define REGISTER_FUSED_UNIFORM_CPU(TYPE)                             \
+  REGISTER_KERNEL_BUILDER(                                           \
+      Name("_FusedStatelessRandomUniform")                           \
+          .Device(DEVICE_CPU)                                        \
+          .HostMemory("shape")                                       \
+          .HostMemory("seed")                                        \
+          .TypeConstraint<TYPE>("dtype"),                            \
+      FusedStatelessRandomOp<CPUDevice, random::UniformDistribution< \
+                                            random::PhiloxRandom, TYPE> >)
+
 TF_CALL_half(REGISTER_CPU);
 TF_CALL_bfloat16(REGISTER_CPU);
 TF_CALL_float(REGISTER_CPU);
 TF_CALL_double(REGISTER_CPU);
+TF_CALL_half(REGISTER_FUSED_UNIFORM_CPU);
+TF_CALL_bfloat16(REGISTER_FUSED_UNIFORM_CPU);
+TF_CALL_float(REGISTER_FUSED_UNIFORM_CPU);
+TF_CALL_double(REGISTER_FUSED_UNIFORM_CPU);
+#undef REGISTER_FUSED_UNIFORM_CPU
 TF_CALL_int32(REGISTER_INT_CPU);
 TF_CALL_int64(REGISTER_INT_CPU);
 TF_CALL_uint32(REGISTER_FULL_INT_CPU);
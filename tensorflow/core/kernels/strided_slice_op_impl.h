@@ -83,7 +83,7 @@ void HandleStridedSliceCase(OpKernelContext* context,
                             bool is_simple_slice, Tensor* result) {
   typedef typename proxy_type<Device, T>::type Proxy;
 
-  gtl::InlinedVector<int64_t, 4> processing_dims = processing_shape.dim_sizes();
+  gtl::InlinedVector<int64_t, 8> processing_dims = processing_shape.dim_sizes();
   if (is_simple_slice) {
     Eigen::DSizes<Eigen::DenseIndex, NDIM> begin_di;
     Eigen::DSizes<Eigen::DenseIndex, NDIM> sizes_di;
@@ -119,7 +119,7 @@ void HandleStridedSliceGradCase(OpKernelContext* context,
                                 const absl::Span<const int64_t>& strides,
                                 const TensorShape& processing_shape,
                                 bool is_simple_slice, Tensor* result) {
-  gtl::InlinedVector<int64_t, 4> processing_dims = processing_shape.dim_sizes();
+  gtl::InlinedVector<int64_t, 8> processing_dims = processing_shape.dim_sizes();
 
   Eigen::DSizes<Eigen::DenseIndex, NDIM> begin_di;
   Eigen::DSizes<Eigen::DenseIndex, NDIM> end_di;
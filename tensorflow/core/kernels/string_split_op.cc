@@ -16,6 +16,7 @@ limitations under the License.
 // See docs in ../ops/string_ops.cc.
 
 #include <string>
+#include <vector>
 
 #include "tensorflow/core/framework/kernel_def_builder.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -24,6 +25,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/core/stringpiece.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 namespace {
@@ -157,6 +159,18 @@ std::vector<StringPiece> SplitV2(const tstring& str, StringPiece sep,
   return result;
 }
 
+// Estimates the cost of tokenizing one input string, for sharding the
+// per-row loops below across the CPU worker threads: the average byte
+// length of the inputs plus a fixed per-row overhead.
+int64_t SplitCostPerUnit(const TTypes<tstring>::ConstVec& input_vec) {
+  const int64_t batch_size = input_vec.dimension(0);
+  int64_t input_bytes = 0;
+  for (int64_t i = 0; i < batch_size; ++i) {
+    input_bytes += input_vec(i).size();
+  }
+  return 10 + (batch_size > 0 ? input_bytes / batch_size : 0);
+}
+
 }  // namespace
 
 class StringSplitOp : public OpKernel {
@@ -189,25 +203,32 @@ class StringSplitOp : public OpKernel {
                                 delimiter_tensor->shape().DebugString()));
     const auto delimiter_vec = delimiter_tensor->flat<tstring>();
     const tstring& delimiter = delimiter_vec(0);
-    // Empty delimiter means split the input character by character.
-    std::vector<StringPiece> tokens;
-    // Guess that we'll be unpacking a handful of tokens per example.
-    static constexpr int kReserveSize = 4;
-    tokens.reserve(batch_size * kReserveSize);
+
+    // Tokenize each input string. Rows are independent, so shard them across
+    // the CPU worker threads. Tokens are StringPieces into the input tensor,
+    // so no per-token copies are made here.
+    // Note: an empty delimiter means split the input character by character.
+    std::vector<std::vector<StringPiece>> tokens(batch_size);
+    const int64_t cost_per_unit = SplitCostPerUnit(input_vec);
+    auto worker_threads = *(ctx->device()->tensorflow_cpu_worker_threads());
+    Shard(worker_threads.num_threads, worker_threads.workers, batch_size,
+          cost_per_unit, [&](int64_t start, int64_t end) {
+            for (int64_t i = start; i < end; ++i) {
+              tokens[i] = skip_empty_ ? Split(input_vec(i), delimiter,
+                                              str_util::SkipEmpty())
+                                      : Split(input_vec(i), delimiter,
+                                              str_util::AllowEmpty());
+            }
+          });
 
     int64_t output_size = 0;
     int64_t max_num_entries = 0;
-    std::vector<int64_t> num_indices(batch_size);
+    std::vector<int64_t> row_offsets(batch_size);
     for (int64_t i = 0; i < batch_size; ++i) {
-      std::vector<StringPiece> parts =
-          skip_empty_ ? Split(input_vec(i), delimiter, str_util::SkipEmpty())
-                      : Split(input_vec(i), delimiter, str_util::AllowEmpty());
-      int64_t n_entries = parts.size();
-      num_indices[i] = n_entries;
+      row_offsets[i] = output_size;
+      const int64_t n_entries = tokens[i].size();
       output_size += n_entries;
       max_num_entries = std::max(max_num_entries, n_entries);
-      tokens.insert(tokens.end(), std::make_move_iterator(parts.begin()),
-                    std::make_move_iterator(parts.end()));
     }
 
     Tensor* sp_indices_t;
@@ -224,15 +245,20 @@ class StringSplitOp : public OpKernel {
     auto sp_shape = sp_shape_t->vec<int64_t>();
     sp_shape(0) = batch_size;
     sp_shape(1) = max_num_entries;
-    size_t c = 0;
-    for (size_t i = 0; i < batch_size; ++i) {
-      for (size_t j = 0; j < num_indices[i]; ++j) {
-        sp_indices(c, 0) = i;
-        sp_indices(c, 1) = j;
-        sp_tokens(c).assign(tokens[c].data(), tokens[c].size());
-        ++c;
-      }
-    }
+    // Copy each row's tokens directly into the preallocated outputs at the
+    // offsets computed above. Rows write disjoint ranges, so this loop
+    // shards as well.
+    Shard(worker_threads.num_threads, worker_threads.workers, batch_size,
+          cost_per_unit, [&](int64_t start, int64_t end) {
+            for (int64_t i = start; i < end; ++i) {
+              int64_t c = row_offsets[i];
+              for (size_t j = 0; j < tokens[i].size(); ++j, ++c) {
+                sp_indices(c, 0) = i;
+                sp_indices(c, 1) = j;
+                sp_tokens(c).assign(tokens[i][j].data(), tokens[i][j].size());
+              }
+            }
+          });
   }
 
  private:
@@ -263,21 +289,28 @@ class StringSplitV2Op : public OpKernel {
                                         sep_tensor->shape().DebugString()));
     const auto sep_vec = sep_tensor->flat<tstring>();
     StringPiece sep(sep_vec(0));
-    std::vector<StringPiece> tokens;
-    // Guess that we'll be unpacking a handful of tokens per example.
-    static constexpr int kReserveSize = 4;
-    tokens.reserve(batch_size * kReserveSize);
+
+    // Tokenize each input string. Rows are independent, so shard them across
+    // the CPU worker threads. Tokens are StringPieces into the input tensor,
+    // so no per-token copies are made here.
+    std::vector<std::vector<StringPiece>> tokens(batch_size);
+    const int64_t cost_per_unit = SplitCostPerUnit(input_vec);
+    auto worker_threads = *(ctx->device()->tensorflow_cpu_worker_threads());
+    Shard(worker_threads.num_threads, worker_threads.workers, batch_size,
+          cost_per_unit, [&](int64_t start, int64_t end) {
+            for (int64_t i = start; i < end; ++i) {
+              tokens[i] = SplitV2(input_vec(i), sep, maxsplit_);
+            }
+          });
 
     int64_t output_size = 0;
     int64_t max_num_entries = 0;
-    std::vector<int64_t> num_indices(batch_size);
+    std::vector<int64_t> row_offsets(batch_size);
     for (int64_t i = 0; i < batch_size; ++i) {
-      std::vector<StringPiece> parts = SplitV2(input_vec(i), sep, maxsplit_);
-      int64_t n_entries = parts.size();
-      num_indices[i] = n_entries;
+      row_offsets[i] = output_size;
+      const int64_t n_entries = tokens[i].size();
       output_size += n_entries;
       max_num_entries = std::max(max_num_entries, n_entries);
-      tokens.insert(tokens.end(), parts.begin(), parts.end());
     }
 
     Tensor* sp_indices_t;
@@ -294,15 +327,20 @@ class StringSplitV2Op : public OpKernel {
     auto sp_shape = sp_shape_t->vec<int64_t>();
     sp_shape(0) = batch_size;
     sp_shape(1) = max_num_entries;
-    size_t c = 0;
-    for (size_t i = 0; i < batch_size; ++i) {
-      for (size_t j = 0; j < num_indices[i]; ++j) {
-        sp_indices(c, 0) = i;
-        sp_indices(c, 1) = j;
-        sp_tokens(c).assign(tokens[c].data(), tokens[c].size());
-        ++c;
-      }
-    }
+    // Copy each row's tokens directly into the preallocated outputs at the
+    // offsets computed above. Rows write disjoint ranges, so this loop
+    // shards as well.
+    Shard(worker_threads.num_threads, worker_threads.workers, batch_size,
+          cost_per_unit, [&](int64_t start, int64_t end) {
+            for (int64_t i = start; i < end; ++i) {
+              int64_t c = row_offsets[i];
+              for (size_t j = 0; j < tokens[i].size(); ++j, ++c) {
+                sp_indices(c, 0) = i;
+                sp_indices(c, 1) = j;
+                sp_tokens(c).assign(tokens[i][j].data(), tokens[i][j].size());
+              }
+            }
+          });
   }
 
  private:
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <errno.h>
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 
@@ -26,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/strings/numbers.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 
@@ -50,13 +52,42 @@ class StringToNumberOp : public OpKernel {
                                             &output_tensor));
     auto output_flat = output_tensor->flat<OutputType>();
 
-    for (int i = 0; i < input_flat.size(); ++i) {
-      OP_REQUIRES(
-          context,
-          strings::SafeStringToNumeric<OutputType>(input_flat(i),
-                                                   &output_flat(i)),
-          errors::InvalidArgument(kErrorMessage, input_flat(i).c_str()));
+    const int64_t num_elements = input_flat.size();
+
+    // Each element parses independently, so shard the batch across the CPU
+    // worker threads. The cost estimate charges for scanning the bytes of
+    // each string plus a fixed per-element parsing overhead.
+    int64_t input_bytes = 0;
+    for (int64_t i = 0; i < num_elements; ++i) {
+      input_bytes += input_flat(i).size();
     }
+    const int64_t cost_per_unit =
+        10 + (num_elements > 0 ? input_bytes / num_elements : 0);
+
+    // Tracks the smallest failing element index so the error message is
+    // deterministic regardless of how the shards interleave.
+    std::atomic<int64_t> first_invalid_index(-1);
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    Shard(worker_threads.num_threads, worker_threads.workers, num_elements,
+          cost_per_unit, [&](int64_t start, int64_t end) {
+            for (int64_t i = start; i < end; ++i) {
+              if (!strings::SafeStringToNumeric<OutputType>(input_flat(i),
+                                                            &output_flat(i))) {
+                int64_t expected = first_invalid_index.load();
+                while ((expected < 0 || i < expected) &&
+                       !first_invalid_index.compare_exchange_weak(expected,
+                                                                  i)) {
+                }
+                return;
+              }
+            }
+          });
+
+    const int64_t invalid_index = first_invalid_index.load();
+    OP_REQUIRES(
+        context, invalid_index < 0,
+        errors::InvalidArgument(kErrorMessage,
+                                input_flat(invalid_index).c_str()));
   }
 };
 
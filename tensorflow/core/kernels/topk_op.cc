@@ -161,6 +161,71 @@ struct TopKFunctor<CPUDevice, T, Tidx> {
       return OkStatus();
     }
 
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+
+    // For a handful of very wide rows with large k -- e.g. retrieval scoring
+    // with k in the hundreds over millions of candidates -- the per-row heap
+    // below leaves all but num_rows workers idle. Instead, shard each row's
+    // columns across the intra-op pool: every worker runs a partition-based
+    // select (std::nth_element, expected linear time) over its chunk, and the
+    // surviving num_chunks * k candidates -- far fewer than num_cols -- are
+    // merged on the calling thread. Chunk selection and merge both use the
+    // value-descending, index-ascending order of the heap path, so the output
+    // is identical, ties included.
+    constexpr int64_t kMinColsPerParallelRowSelect = 1 << 16;
+    // Keep chunks large enough that per-chunk selection dominates the merge.
+    const int64_t parallel_chunk_cols =
+        std::max<int64_t>(4 * static_cast<int64_t>(k),
+                          (num_cols + worker_threads.num_threads - 1) /
+                              std::max(worker_threads.num_threads, 1));
+    const int64_t num_chunks = num_cols / parallel_chunk_cols;
+    if (k < num_cols && num_rows < worker_threads.num_threads &&
+        num_cols >= kMinColsPerParallelRowSelect && num_chunks >= 2) {
+      std::vector<Tidx> candidates(num_chunks * k);
+      for (int64_t b = 0; b < num_rows; ++b) {
+        const T* input_data = &input(b, 0);
+        const auto stable_comp = [input_data](const int32_t a,
+                                              const int32_t b) {
+          if (input_data[b] < input_data[a]) {
+            return true;
+          } else if (input_data[b] > input_data[a]) {
+            return false;
+          } else {
+            return a < b;
+          }
+        };
+        auto select_chunks = [&](int64_t chunk_begin, int64_t chunk_end) {
+          std::vector<Tidx> chunk_indices;
+          for (int64_t chunk = chunk_begin; chunk < chunk_end; ++chunk) {
+            const int64_t col_begin = chunk * parallel_chunk_cols;
+            // The last chunk absorbs the remainder columns.
+            const int64_t col_end = chunk == num_chunks - 1
+                                        ? num_cols
+                                        : col_begin + parallel_chunk_cols;
+            chunk_indices.resize(col_end - col_begin);
+            std::iota(chunk_indices.begin(), chunk_indices.end(),
+                      static_cast<Tidx>(col_begin));
+            std::nth_element(chunk_indices.begin(), chunk_indices.begin() + k,
+                             chunk_indices.end(), stable_comp);
+            std::copy(chunk_indices.begin(), chunk_indices.begin() + k,
+                      candidates.begin() + chunk * k);
+          }
+        };
+        const double select_cost =
+            static_cast<double>(parallel_chunk_cols) *
+            (3 * Eigen::TensorOpCost::AddCost<Tidx>() +
+             Eigen::TensorOpCost::AddCost<T>());
+        Shard(worker_threads.num_threads, worker_threads.workers, num_chunks,
+              static_cast<int64_t>(select_cost), select_chunks);
+        std::partial_sort(candidates.begin(), candidates.begin() + k,
+                          candidates.end(), stable_comp);
+        std::copy(candidates.begin(), candidates.begin() + k, &indices(b, 0));
+        std::transform(&indices(b, 0), &indices(b, k), &values(b, 0),
+                       [b, &input](const Tidx loc) { return input(b, loc); });
+      }
+      return OkStatus();
+    }
+
     auto SortIndices = [&](int64_t start_batch, int64_t limit_batch) {
       for (int32_t b = start_batch; b < limit_batch; ++b) {
         const T* input_data = &input(b, 0);
@@ -247,7 +312,6 @@ struct TopKFunctor<CPUDevice, T, Tidx> {
     const int64_t final_cost = (total_cost >= static_cast<double>(kint64max))
                                    ? kint64max
                                    : static_cast<int64_t>(total_cost);
-    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
     Shard(worker_threads.num_threads, worker_threads.workers, num_rows,
           final_cost, SortIndices);
 
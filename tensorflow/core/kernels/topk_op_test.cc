@@ -0,0 +1,94 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/kernels/ops_util.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class TopKOpTest : public OpsTestBase {
+ protected:
+  void MakeOp() {
+    TF_EXPECT_OK(NodeDefBuilder("topk_op", "TopKV2")
+                     .Input(FakeInput(DT_FLOAT))
+                     .Input(FakeInput(DT_INT32))
+                     .Attr("sorted", true)
+                     .Finalize(node_def()));
+    TF_EXPECT_OK(InitOp());
+  }
+};
+
+TEST_F(TopKOpTest, Simple) {
+  MakeOp();
+  AddInputFromArray<float>(TensorShape({2, 4}), {3, 1, 4, 2, 5, 8, 6, 7});
+  AddInputFromArray<int32>(TensorShape({}), {2});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected_values(allocator(), DT_FLOAT, TensorShape({2, 2}));
+  test::FillValues<float>(&expected_values, {4, 3, 8, 7});
+  test::ExpectTensorEqual<float>(expected_values, *GetOutput(0));
+  Tensor expected_indices(allocator(), DT_INT32, TensorShape({2, 2}));
+  test::FillValues<int32>(&expected_indices, {2, 0, 1, 3});
+  test::ExpectTensorEqual<int32>(expected_indices, *GetOutput(1));
+}
+
+// A single wide row with large k exercises the sharded per-row selection
+// path; results must be identical to a reference partial sort, including
+// tie-breaking by ascending index.
+TEST_F(TopKOpTest, WideRowLargeK) {
+  MakeOp();
+  constexpr int kNumCols = 1 << 17;
+  constexpr int kK = 1000;
+  std::vector<float> data(kNumCols);
+  for (int i = 0; i < kNumCols; ++i) {
+    // Deterministic pseudo-random values with many ties.
+    data[i] = static_cast<float>((i * 2654435761u) % 4096u);
+  }
+  AddInputFromArray<float>(TensorShape({kNumCols}), data);
+  AddInputFromArray<int32>(TensorShape({}), {kK});
+  TF_ASSERT_OK(RunOpKernel());
+
+  std::vector<int32> reference(kNumCols);
+  std::iota(reference.begin(), reference.end(), 0);
+  std::partial_sort(reference.begin(), reference.begin() + kK,
+                    reference.end(), [&data](int32 a, int32 b) {
+                      if (data[b] < data[a]) return true;
+                      if (data[a] < data[b]) return false;
+                      return a < b;
+                    });
+
+  Tensor expected_values(allocator(), DT_FLOAT, TensorShape({kK}));
+  Tensor expected_indices(allocator(), DT_INT32, TensorShape({kK}));
+  for (int i = 0; i < kK; ++i) {
+    expected_indices.flat<int32>()(i) = reference[i];
+    expected_values.flat<float>()(i) = data[reference[i]];
+  }
+  test::ExpectTensorEqual<float>(expected_values, *GetOutput(0));
+  test::ExpectTensorEqual<int32>(expected_indices, *GetOutput(1));
+}
+
+}  // namespace
+}  // namespace tensorflow
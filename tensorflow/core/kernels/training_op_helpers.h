@@ -283,10 +283,12 @@ absl::Status GetInputTensorFromVariable(OpKernelContext* ctx, int input,
     TF_RETURN_IF_ERROR(LookupResource(ctx, HandleFromInput(ctx, input), &var));
     if (sparse) {
       var->mu()->assert_held_shared();
+      var->MarkMutationStarted();
       *out = *var->tensor();
       return absl::OkStatus();
     }
     var->mu()->assert_held();
+    var->MarkMutationStarted();
     TF_RETURN_IF_ERROR(PrepareToUpdateVariable<Device, T>(
         ctx, var->tensor(), var->copy_on_read_mode.load()));
     *out = *var->tensor();
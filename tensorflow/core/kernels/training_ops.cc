@@ -17,6 +17,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/training_ops.h"
 
 #include <algorithm>  // NOLINT
+#include <vector>
 
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -1040,6 +1041,63 @@ REGISTER_KERNELS(GPU, complex128);
 #undef REGISTER_CPU_KERNELS
 #undef REGISTER_KERNELS
 
+// Applies gradient descent to `N` variables in one kernel invocation. Created
+// by the "fused_apply" grappler pass to amortize per-op dispatch overhead when
+// a training step updates many small variables.
+template <typename Device, typename T>
+class FusedApplyGradientDescentOp : public OpKernel {
+ public:
+  explicit FusedApplyGradientDescentOp(OpKernelConstruction* ctx)
+      : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("N", &num_tensors_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("use_locking", &use_exclusive_lock_));
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    const bool sparse = false;
+    std::vector<int> var_ids(num_tensors_);
+    for (int i = 0; i < num_tensors_; ++i) var_ids[i] = i;
+    auto locks = MaybeLockVariableInputMutexesInOrder<Device, T>(
+        ctx, use_exclusive_lock_, sparse, var_ids);
+
+    const Tensor& alpha = ctx->input(num_tensors_);
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(alpha.shape()),
+                errors::InvalidArgument("alpha is not a scalar: ",
+                                        alpha.shape().DebugString()));
+
+    const Device& device = ctx->template eigen_device<Device>();
+    for (int i = 0; i < num_tensors_; ++i) {
+      Tensor var;
+      OP_REQUIRES_OK(ctx, GetInputTensorFromVariable<Device, T>(
+                              ctx, i, use_exclusive_lock_, sparse, &var));
+      OP_REQUIRES(ctx, var.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(i)));
+      const Tensor& delta = ctx->input(num_tensors_ + 1 + i);
+      OP_REQUIRES(
+          ctx, var.shape().IsSameSize(delta.shape()),
+          errors::InvalidArgument("var and delta do not have the same shape",
+                                  var.shape().DebugString(), " ",
+                                  delta.shape().DebugString()));
+      functor::ApplyGradientDescent<Device, T>()(
+          device, var.flat<T>(), alpha.scalar<T>(), delta.flat<T>());
+    }
+  }
+
+ private:
+  int num_tensors_;
+  bool use_exclusive_lock_;
+};
+
+#define REGISTER_KERNELS(T)                                          \
+  REGISTER_KERNEL_BUILDER(Name("_FusedResourceApplyGradientDescent") \
+                              .Device(DEVICE_CPU)                    \
+                              .TypeConstraint<T>("T"),               \
+                          FusedApplyGradientDescentOp<CPUDevice, T>);
+TF_CALL_FLOAT_TYPES(REGISTER_KERNELS);
+#undef REGISTER_KERNELS
+
 template <typename Device, typename T>
 class ApplyAdadeltaOp : public OpKernel {
  public:
@@ -3654,6 +3712,117 @@ REGISTER_KERNELS(GPU, complex128);
 #undef REGISTER_CPU_KERNELS
 #undef REGISTER_KERNELS
 
+// Applies the Adam update to `N` variables in one kernel invocation, sharing
+// the scalar hyperparameters. Created by the "fused_apply" grappler pass to
+// amortize per-op dispatch overhead when a training step updates many small
+// variables.
+template <typename Device, typename T>
+class FusedApplyAdamOp : public OpKernel {
+ public:
+  explicit FusedApplyAdamOp(OpKernelConstruction* ctx) : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("N", &num_tensors_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("use_locking", &use_exclusive_lock_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("use_nesterov", &use_nesterov_));
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    const bool sparse = false;
+    const int n = num_tensors_;
+    std::vector<int> var_ids(3 * n);
+    for (int i = 0; i < 3 * n; ++i) var_ids[i] = i;
+    auto locks = MaybeLockVariableInputMutexesInOrder<Device, T>(
+        ctx, use_exclusive_lock_, sparse, var_ids);
+
+    const Tensor& beta1_power = ctx->input(3 * n);
+    const Tensor& beta2_power = ctx->input(3 * n + 1);
+    const Tensor& lr = ctx->input(3 * n + 2);
+    const Tensor& beta1 = ctx->input(3 * n + 3);
+    const Tensor& beta2 = ctx->input(3 * n + 4);
+    const Tensor& epsilon = ctx->input(3 * n + 5);
+
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta1_power.shape()),
+                errors::InvalidArgument("beta1_power is not a scalar: ",
+                                        beta1_power.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta2_power.shape()),
+                errors::InvalidArgument("beta2_power is not a scalar: ",
+                                        beta2_power.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(lr.shape()),
+                errors::InvalidArgument("lr is not a scalar : ",
+                                        lr.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta1.shape()),
+                errors::InvalidArgument("beta1 is not a scalar: ",
+                                        beta1.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta2.shape()),
+                errors::InvalidArgument("beta2 is not a scalar: ",
+                                        beta2.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(epsilon.shape()),
+                errors::InvalidArgument("epsilon is not a scalar: ",
+                                        epsilon.shape().DebugString()));
+
+    const Device& device = ctx->template eigen_device<Device>();
+    for (int i = 0; i < n; ++i) {
+      Tensor var;
+      OP_REQUIRES_OK(ctx, GetInputTensorFromVariable<Device, T>(
+                              ctx, i, use_exclusive_lock_, sparse, &var));
+      Tensor m;
+      OP_REQUIRES_OK(ctx, GetInputTensorFromVariable<Device, T>(
+                              ctx, n + i, use_exclusive_lock_, sparse, &m));
+      Tensor v;
+      OP_REQUIRES_OK(ctx,
+                     GetInputTensorFromVariable<Device, T>(
+                         ctx, 2 * n + i, use_exclusive_lock_, sparse, &v));
+      OP_REQUIRES(ctx, var.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(i)));
+      OP_REQUIRES(ctx, m.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(n + i)));
+      OP_REQUIRES(ctx, v.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(2 * n + i)));
+
+      const Tensor& grad = ctx->input(3 * n + 6 + i);
+      OP_REQUIRES(
+          ctx, var.shape().IsSameSize(m.shape()),
+          errors::InvalidArgument("var and m do not have the same shape",
+                                  var.shape().DebugString(), " ",
+                                  m.shape().DebugString()));
+      OP_REQUIRES(
+          ctx, var.shape().IsSameSize(v.shape()),
+          errors::InvalidArgument("var and v do not have the same shape",
+                                  var.shape().DebugString(), " ",
+                                  v.shape().DebugString()));
+      OP_REQUIRES(
+          ctx, var.shape().IsSameSize(grad.shape()),
+          errors::InvalidArgument("var and grad do not have the same shape",
+                                  var.shape().DebugString(), " ",
+                                  grad.shape().DebugString()));
+
+      functor::ApplyAdam<Device, T>()(
+          device, var.flat<T>(), m.flat<T>(), v.flat<T>(),
+          beta1_power.scalar<T>(), beta2_power.scalar<T>(), lr.scalar<T>(),
+          beta1.scalar<T>(), beta2.scalar<T>(), epsilon.scalar<T>(),
+          grad.flat<T>(), use_nesterov_);
+    }
+  }
+
+ private:
+  int num_tensors_;
+  bool use_exclusive_lock_;
+  bool use_nesterov_;
+};
+
+#define REGISTER_KERNELS(T)                                \
+  REGISTER_KERNEL_BUILDER(Name("_FusedResourceApplyAdam")  \
+                              .Device(DEVICE_CPU)          \
+                              .TypeConstraint<T>("T"),     \
+                          FusedApplyAdamOp<CPUDevice, T>);
+TF_CALL_FLOAT_TYPES(REGISTER_KERNELS);
+#undef REGISTER_KERNELS
+
 template <typename Device, typename T>
 class ApplyAdamWithAmsgradOp : public OpKernel {
  public:
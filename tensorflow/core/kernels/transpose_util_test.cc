@@ -13,6 +13,9 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#define EIGEN_USE_THREADS
+
+#include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/kernels/transpose_functor.h"
@@ -130,4 +133,52 @@ TEST_F(TransposeUtilTest, NonSingletonDimensionAlignment) {
                                                      {0, 1, 2, 5, 4, 3}));
 }
 
+// Transposes a (possibly batched) matrix through DoTranspose and checks the
+// result element-wise against the definition of the permutation.  The shapes
+// used below are large enough to take the tiled CPU path, including partial
+// tiles on both edges.
+template <typename T>
+void TestMatrixTranspose(int64_t batch, int64_t rows, int64_t cols) {
+  Eigen::ThreadPool tp(4);
+  Eigen::ThreadPoolDevice device(&tp, 4);
+
+  const DataType dtype = DataTypeToEnum<T>::value;
+  Tensor in(dtype, TensorShape({batch, rows, cols}));
+  auto in_flat = in.flat<T>();
+  for (int64_t i = 0; i < in_flat.size(); ++i) {
+    in_flat(i) = static_cast<T>(i % 251);
+  }
+
+  Tensor out(dtype, TensorShape({batch, cols, rows}));
+  TF_ASSERT_OK(DoTranspose(device, in, {0, 2, 1}, &out));
+
+  Tensor expected(dtype, TensorShape({batch, cols, rows}));
+  auto expected_flat = expected.flat<T>();
+  for (int64_t b = 0; b < batch; ++b) {
+    for (int64_t r = 0; r < rows; ++r) {
+      for (int64_t c = 0; c < cols; ++c) {
+        expected_flat((b * cols + c) * rows + r) =
+            in_flat((b * rows + r) * cols + c);
+      }
+    }
+  }
+  test::ExpectTensorEqual<T>(expected, out);
+}
+
+TEST(TransposeTiledTest, LargeMatrixFloat) {
+  TestMatrixTranspose<float>(1, 300, 170);
+}
+
+TEST(TransposeTiledTest, BatchedMatrixFloat) {
+  TestMatrixTranspose<float>(3, 170, 130);
+}
+
+TEST(TransposeTiledTest, LargeMatrixUint8) {
+  TestMatrixTranspose<uint8>(1, 200, 150);
+}
+
+TEST(TransposeTiledTest, LargeMatrixDouble) {
+  TestMatrixTranspose<double>(2, 150, 140);
+}
+
 }  // namespace tensorflow
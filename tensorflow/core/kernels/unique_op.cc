@@ -13,9 +13,11 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <functional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/framework/bounds_check.h"
@@ -23,7 +25,9 @@ limitations under the License.
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/core/blocking_counter.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/bfloat16.h"
 
@@ -39,6 +43,9 @@ typedef Eigen::ThreadPoolDevice CPUDevice;
 template <typename T, typename TIndex>
 struct UniqueOpHashMap {
   using map_type = absl::flat_hash_map<T, TIndex>;
+  // Whether the sharded parallel implementation may be used. It requires
+  // reflexive equality, because merged elements are re-found by value.
+  static constexpr bool kSupportsParallel = true;
 };
 
 // NOTE(mrry): For `tstring` elements, we use an `absl::string_view` key to
@@ -46,26 +53,32 @@ struct UniqueOpHashMap {
 template <typename TIndex>
 struct UniqueOpHashMap<tstring, TIndex> {
   using map_type = absl::flat_hash_map<absl::string_view, TIndex>;
+  static constexpr bool kSupportsParallel = true;
 };
 
 // NOTE(mrry): `absl::flat_hash_map<float, ...>` does not allow `NaN` as a key,
 // because `NaN != NaN`, so we fall back to `std::unordered_map<>` for
-// floating-point types.
+// floating-point types. The parallel implementation is also disabled: it
+// looks elements up by value after the merge, which never finds a `NaN`.
 template <typename TIndex>
 struct UniqueOpHashMap<float, TIndex> {
   using map_type = std::unordered_map<float, TIndex>;
+  static constexpr bool kSupportsParallel = false;
 };
 template <typename TIndex>
 struct UniqueOpHashMap<double, TIndex> {
   using map_type = std::unordered_map<double, TIndex>;
+  static constexpr bool kSupportsParallel = false;
 };
 template <typename TIndex>
 struct UniqueOpHashMap<Eigen::half, TIndex> {
   using map_type = std::unordered_map<Eigen::half, TIndex>;
+  static constexpr bool kSupportsParallel = false;
 };
 template <typename TIndex>
 struct UniqueOpHashMap<bfloat16, TIndex> {
   using map_type = std::unordered_map<bfloat16, TIndex>;
+  static constexpr bool kSupportsParallel = false;
 };
 
 // `UniqueOp` computes the unique elements in the input tensor.
@@ -151,12 +164,19 @@ class UniqueOp : public OpKernel {
       const int64_t N = static_cast<int64_t>(Tin.size());
 
       typename UniqueOpHashMap<T, TIndex>::map_type uniq;
-      uniq.reserve(2 * N);
-      for (Eigen::Index i = 0, j = 0; i < N; ++i) {
-        auto it = uniq.emplace(Tin(i), j);
-        idx_vec(i) = it.first->second;
-        if (it.second) {
-          ++j;
+      auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
+      if (UniqueOpHashMap<T, TIndex>::kSupportsParallel &&
+          N >= kParallelizationThreshold && worker_threads->num_threads > 1) {
+        ParallelUniquify(Tin, N, worker_threads->num_threads,
+                         worker_threads->workers, &uniq, idx_vec);
+      } else {
+        uniq.reserve(2 * N);
+        for (Eigen::Index i = 0, j = 0; i < N; ++i) {
+          auto it = uniq.emplace(Tin(i), j);
+          idx_vec(i) = it.first->second;
+          if (it.second) {
+            ++j;
+          }
         }
       }
 
@@ -237,6 +257,95 @@ class UniqueOp : public OpKernel {
       }
     }
   }
+
+ private:
+  // Inputs smaller than this are uniquified with the sequential
+  // implementation; the parallel one pays two hash passes plus a merge, which
+  // only amortizes on large inputs.
+  static constexpr int64_t kParallelizationThreshold = 1 << 19;
+
+  // Uniquifies `Tin` across worker threads: each shard builds a map from
+  // element to its first occurrence within the shard; the shard maps are then
+  // merged in shard order, so every element keeps its smallest first-occurrence
+  // index, and renumbered into dense ids ordered by first occurrence. This
+  // preserves the semantics of the sequential implementation exactly. A second
+  // sharded pass fills `idx_vec` with read-only lookups.
+  void ParallelUniquify(const typename TTypes<T>::ConstFlat& Tin, int64_t N,
+                        int num_threads, thread::ThreadPool* workers,
+                        typename UniqueOpHashMap<T, TIndex>::map_type* uniq,
+                        typename TTypes<TIndex>::Vec idx_vec) {
+    const int num_shards = std::min<int64_t>(
+        num_threads, (N + kParallelizationThreshold - 1) /
+                         kParallelizationThreshold);
+    auto shard_begin = [&](int s) { return N * s / num_shards; };
+
+    std::vector<typename UniqueOpHashMap<T, TIndex>::map_type> shard_uniq(
+        num_shards);
+    {
+      BlockingCounter counter(num_shards - 1);
+      auto build_shard = [&](int s) {
+        const int64_t begin = shard_begin(s);
+        const int64_t end = shard_begin(s + 1);
+        auto& shard = shard_uniq[s];
+        shard.reserve(2 * (end - begin));
+        for (int64_t i = begin; i < end; ++i) {
+          shard.emplace(Tin(i), static_cast<TIndex>(i));
+        }
+      };
+      for (int s = 1; s < num_shards; ++s) {
+        workers->Schedule([&build_shard, &counter, s]() {
+          build_shard(s);
+          counter.DecrementCount();
+        });
+      }
+      build_shard(0);
+      counter.Wait();
+    }
+
+    // Merge in shard order: shards cover increasing index ranges, so inserting
+    // only absent keys keeps the smallest first-occurrence index per element.
+    *uniq = std::move(shard_uniq[0]);
+    for (int s = 1; s < num_shards; ++s) {
+      for (const auto& it : shard_uniq[s]) {
+        uniq->emplace(it.first, it.second);
+      }
+    }
+
+    // Renumber the first-occurrence indices into dense ids. Entry pointers are
+    // stable because the map is not modified structurally past this point.
+    std::vector<std::pair<TIndex, TIndex*>> order;
+    order.reserve(uniq->size());
+    for (auto& it : *uniq) {
+      order.emplace_back(it.second, &it.second);
+    }
+    std::sort(order.begin(), order.end(),
+              [](const std::pair<TIndex, TIndex*>& lhs,
+                 const std::pair<TIndex, TIndex*>& rhs) {
+                return lhs.first < rhs.first;
+              });
+    for (size_t j = 0; j < order.size(); ++j) {
+      *order[j].second = static_cast<TIndex>(j);
+    }
+
+    {
+      BlockingCounter counter(num_shards - 1);
+      auto fill_shard = [&](int s) {
+        const int64_t begin = shard_begin(s);
+        const int64_t end = shard_begin(s + 1);
+        for (int64_t i = begin; i < end; ++i) {
+          idx_vec(i) = uniq->find(Tin(i))->second;
+        }
+      };
+      for (int s = 1; s < num_shards; ++s) {
+        workers->Schedule([&fill_shard, &counter, s]() {
+          fill_shard(s);
+          counter.DecrementCount();
+        });
+      }
+      fill_shard(0);
+      counter.Wait();
+    }
+  }
 };
 
 #define REGISTER_UNIQUE(type)                                      \
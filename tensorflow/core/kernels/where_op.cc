@@ -23,8 +23,11 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/where_op.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
+#include <vector>
+
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -33,6 +36,9 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/tensor_types.h"
 #include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/blocking_counter.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/types.h"
@@ -140,6 +146,15 @@ class WhereCPUOp : public OpKernel {
 
     const int input_dims = input.dims();
 
+    auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    if (input_dims >= 1 && input_dims <= 8 &&
+        input.NumElements() >= kMinElementsForParallel &&
+        worker_threads->num_threads > 1) {
+      ComputeParallel(context, input, input_dims, worker_threads->num_threads,
+                      worker_threads->workers);
+      return;
+    }
+
     int64_t num_true;
     TTypes<int64_t>::UnalignedScalar num_true_t(&num_true);
 
@@ -191,6 +206,91 @@ class WhereCPUOp : public OpKernel {
   }
 
  private:
+  // Minimum input size before the sharded single-pass implementation pays for
+  // its staging overhead.
+  static constexpr int64_t kMinElementsForParallel = 1 << 16;
+  static constexpr int64_t kMinElementsPerShard = 1 << 13;
+
+  // Single pass over the input, parallelized over shards: every shard stages
+  // the flat positions of its nonzero elements, the output is allocated once
+  // from the summed shard sizes, and the staged positions are compacted into
+  // it in parallel. This replaces the count-then-gather double scan of the
+  // functor path for large inputs.
+  void ComputeParallel(OpKernelContext* context, const Tensor& input,
+                       int input_dims, int num_threads,
+                       thread::ThreadPool* workers) {
+    const T* flat = input.flat<T>().data();
+    const int64_t num_elements = input.NumElements();
+    const int64_t num_shards = std::max<int64_t>(
+        2, std::min<int64_t>(num_threads, num_elements / kMinElementsPerShard));
+    const int64_t elements_per_shard =
+        (num_elements + num_shards - 1) / num_shards;
+
+    std::vector<std::vector<int64_t>> staged(num_shards);
+    {
+      auto stage_shard = [&](int64_t shard) {
+        const int64_t begin = shard * elements_per_shard;
+        const int64_t end =
+            std::min(num_elements, begin + elements_per_shard);
+        std::vector<int64_t>& positions = staged[shard];
+        for (int64_t n = begin; n < end; ++n) {
+          if (flat[n] != T(0)) positions.push_back(n);
+        }
+      };
+      BlockingCounter counter(num_shards - 1);
+      for (int64_t shard = 1; shard < num_shards; ++shard) {
+        workers->Schedule([&stage_shard, &counter, shard] {
+          stage_shard(shard);
+          counter.DecrementCount();
+        });
+      }
+      stage_shard(0);
+      counter.Wait();
+    }
+
+    std::vector<int64_t> offsets(num_shards + 1, 0);
+    for (int64_t shard = 0; shard < num_shards; ++shard) {
+      offsets[shard + 1] = offsets[shard] + staged[shard].size();
+    }
+    const int64_t num_true = offsets[num_shards];
+
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(
+                                0, TensorShape({num_true, input_dims}),
+                                &output));
+    if (num_true == 0) return;
+
+    gtl::InlinedVector<int64_t, 8> strides(input_dims);
+    strides[input_dims - 1] = 1;
+    for (int i = input_dims - 2; i >= 0; --i) {
+      strides[i] = strides[i + 1] * input.dim_size(i + 1);
+    }
+
+    auto output_matrix = output->matrix<int64_t>();
+    {
+      auto compact_shard = [&](int64_t shard) {
+        int64_t row = offsets[shard];
+        for (const int64_t position : staged[shard]) {
+          int64_t remaining = position;
+          for (int i = 0; i < input_dims; ++i) {
+            output_matrix(row, i) = remaining / strides[i];
+            remaining -= output_matrix(row, i) * strides[i];
+          }
+          ++row;
+        }
+      };
+      BlockingCounter counter(num_shards - 1);
+      for (int64_t shard = 1; shard < num_shards; ++shard) {
+        workers->Schedule([&compact_shard, &counter, shard] {
+          compact_shard(shard);
+          counter.DecrementCount();
+        });
+      }
+      compact_shard(0);
+      counter.Wait();
+    }
+  }
+
   WhereCPUOp(const WhereCPUOp&) = delete;
   void operator=(const WhereCPUOp&) = delete;
 };
@@ -64,6 +64,28 @@ TEST(ThreadPool, DoWork) {
   }
 }
 
+TEST(ThreadPool, ScheduleWorkItems) {
+  for (int num_threads = 1; num_threads < kNumThreads; num_threads += 7) {
+    fprintf(stderr, "Testing with %d threads\n", num_threads);
+    const int kWorkItems = 1000;
+    std::vector<std::atomic<bool>> work(kWorkItems);
+    for (int i = 0; i < kWorkItems; i++) {
+      work[i] = false;
+    }
+    ThreadPool pool(Env::Default(), "test", num_threads);
+    absl::BlockingCounter counter(kWorkItems);
+    pool.ScheduleWorkItems(kWorkItems, /*max_parallelism=*/num_threads,
+                           [&work, &counter](int64_t i) {
+                             ASSERT_FALSE(work[i].exchange(true));
+                             counter.DecrementCount();
+                           });
+    counter.Wait();
+    for (int i = 0; i < kWorkItems; i++) {
+      ASSERT_TRUE(work[i]);
+    }
+  }
+}
+
 void RunWithFixedBlockSize(int64_t block_size, int64_t total,
                            ThreadPool* threads) {
   mutex mu;
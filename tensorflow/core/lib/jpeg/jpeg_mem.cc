@@ -322,7 +322,18 @@ uint8* UncompressLow(const void* srcdata, FewerArgsForCompiler* argball) {
         memcpy(output_line, tempdata + mcu_align_offset, min_stride);
       }
     } else {
-      num_lines_read = jpeg_read_scanlines(&cinfo, &output_line, 1);
+      // Read as many scanlines as libjpeg is willing to return per call
+      // (rec_outbuf_height, at most 4) to amortize its per-call overhead.
+      // This is particularly noticeable for scaled decodes (ratio > 1),
+      // where each scanline is cheap to produce.
+      JSAMPLE* lines[4];
+      const int max_lines = std::min(
+          {max_scanlines_to_read - static_cast<int>(cinfo.output_scanline),
+           cinfo.rec_outbuf_height, 4});
+      for (int i = 0; i < max_lines; ++i) {
+        lines[i] = output_line + static_cast<int64_t>(i) * stride;
+      }
+      num_lines_read = jpeg_read_scanlines(&cinfo, lines, max_lines);
     }
     // Handle error cases
     if (num_lines_read == 0) {
@@ -351,9 +362,12 @@ uint8* UncompressLow(const void* srcdata, FewerArgsForCompiler* argball) {
       }
       break;
     }
-    DCHECK_EQ(num_lines_read, 1);
-    TF_ANNOTATE_MEMORY_IS_INITIALIZED(output_line, min_stride);
-    output_line += stride;
+    DCHECK_GE(num_lines_read, 1);
+    for (int i = 0; i < num_lines_read; ++i) {
+      TF_ANNOTATE_MEMORY_IS_INITIALIZED(
+          output_line + static_cast<int64_t>(i) * stride, min_stride);
+    }
+    output_line += static_cast<int64_t>(num_lines_read) * stride;
   }
   delete[] tempdata;
   tempdata = nullptr;
@@ -0,0 +1,43 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_LIB_MONITORING_SHARDED_COUNTER_H_
+#define TENSORFLOW_CORE_LIB_MONITORING_SHARDED_COUNTER_H_
+
+#include "tsl/lib/monitoring/sharded_counter.h"
+#ifdef IS_MOBILE_PLATFORM
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/types.h"
+#else
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/monitoring/collection_registry.h"
+#include "tensorflow/core/lib/monitoring/metric_def.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#endif
+// NOLINTBEGIN(misc-unused-using-decls)
+namespace tensorflow {
+namespace monitoring {
+
+using tsl::monitoring::ShardedCounter;
+using tsl::monitoring::ShardedCounterCell;
+
+}  // namespace monitoring
+}  // namespace tensorflow
+// NOLINTEND(misc-unused-using-decls)
+#endif  // TENSORFLOW_CORE_LIB_MONITORING_SHARDED_COUNTER_H_
@@ -0,0 +1,87 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/lib/monitoring/sharded_counter.h"
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace monitoring {
+namespace {
+
+auto* sharded_counter_with_labels =
+    ShardedCounter<1>::New("/tensorflow/test/sharded_counter_with_labels",
+                           "Sharded counter with one label.", "MyLabel");
+
+TEST(LabeledShardedCounterTest, InitializedWithZero) {
+  EXPECT_EQ(0, sharded_counter_with_labels->GetCell("Empty")->value());
+}
+
+TEST(LabeledShardedCounterTest, GetCell) {
+  auto* cell = sharded_counter_with_labels->GetCell("GetCellOp");
+  EXPECT_EQ(0, cell->value());
+
+  cell->IncrementBy(42);
+  EXPECT_EQ(42, cell->value());
+
+  auto* same_cell = sharded_counter_with_labels->GetCell("GetCellOp");
+  EXPECT_EQ(42, same_cell->value());
+
+  same_cell->IncrementBy(58);
+  EXPECT_EQ(100, cell->value());
+  EXPECT_EQ(100, same_cell->value());
+}
+
+TEST(LabeledShardedCounterDeathTest, DiesOnDecrement) {
+  EXPECT_DEBUG_DEATH(
+      { sharded_counter_with_labels->GetCell("DyingOp")->IncrementBy(-1); },
+      "decrement");
+}
+
+auto* sharded_counter_without_labels = ShardedCounter<0>::New(
+    "/tensorflow/test/sharded_counter_without_labels",
+    "Sharded counter without any labels.");
+
+TEST(UnlabeledShardedCounterTest, InitializedWithZero) {
+  EXPECT_EQ(0, sharded_counter_without_labels->GetCell()->value());
+}
+
+TEST(UnlabeledShardedCounterTest, ConcurrentIncrementsAggregateOnRead) {
+  auto* cell = sharded_counter_without_labels->GetCell();
+  const int64_t initial_value = cell->value();
+
+  constexpr int kNumThreads = 8;
+  constexpr int kIncrementsPerThread = 1000;
+  {
+    std::vector<std::unique_ptr<Thread>> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+      threads.emplace_back(Env::Default()->StartThread(
+          ThreadOptions(), "incrementer", [cell] {
+            for (int j = 0; j < kIncrementsPerThread; ++j) {
+              cell->IncrementBy(1);
+            }
+          }));
+    }
+  }
+  EXPECT_EQ(initial_value + kNumThreads * kIncrementsPerThread, cell->value());
+}
+
+}  // namespace
+}  // namespace monitoring
+}  // namespace tensorflow
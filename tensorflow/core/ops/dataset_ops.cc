@@ -327,6 +327,25 @@ REGISTER_OP("FilterDataset")
                                                            "output_types"))
     .SetShapeFn(shape_inference::ScalarShape);
 
+// Fusion of FilterDataset followed by MapDataset, created by the
+// `filter_map_fusion` rewrite. The map function is only invoked for elements
+// accepted by the predicate.
+REGISTER_OP("FilterMapDataset")
+    .Input("input_dataset: variant")
+    .Input("predicate_other_arguments: Tpredicate_other_arguments")
+    .Input("map_func_other_arguments: Tmap_func_other_arguments")
+    .Output("handle: variant")
+    .Attr("predicate: func")
+    .Attr("map_func: func")
+    .Attr("Tpredicate_other_arguments: list(type) >= 0")
+    .Attr("Tmap_func_other_arguments: list(type) >= 0")
+    .Attr("output_types: list(type) >= 1")
+    .Attr("output_shapes: list(shape) >= 1")
+    .Attr("metadata: string = ''")
+    .SetTypeConstructor(full_type::VariadicTensorContainer(TFT_DATASET,
+                                                           "output_types"))
+    .SetShapeFn(shape_inference::ScalarShape);
+
 REGISTER_OP("DatasetFingerprint")
     .Input("input_dataset: variant")
     .Output("fingerprint: uint64")
@@ -956,6 +975,33 @@ REGISTER_OP("IteratorGetNext")
     .Attr("output_shapes: list(shape) >= 1")
     .SetShapeFn(shape_inference::DatasetIteratorShape);
 
+REGISTER_OP("IteratorGetNextN")
+    .Input("iterator: resource")
+    .Output("num_elements: int64")
+    .Output("components: output_types")
+    .Attr("output_types: list(type) >= 1")
+    .Attr("output_shapes: list(shape) >= 1")
+    .SetShapeFn([](shape_inference::InferenceContext* c) {
+      shape_inference::ShapeHandle unused;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 0, &unused));
+      c->set_output(0, c->Scalar());
+      std::vector<PartialTensorShape> output_shapes;
+      TF_RETURN_IF_ERROR(c->GetAttr("output_shapes", &output_shapes));
+      const int output_shapes_size = output_shapes.size();
+      if (output_shapes_size != c->num_outputs() - 1) {
+        return errors::InvalidArgument(
+            "`output_shapes` must be the same length as `output_types` (",
+            output_shapes.size(), " vs. ", c->num_outputs() - 1);
+      }
+      for (size_t i = 0; i < output_shapes.size(); ++i) {
+        shape_inference::ShapeHandle output_shape_handle;
+        TF_RETURN_IF_ERROR(c->MakeShapeFromPartialTensorShape(
+            output_shapes[i], &output_shape_handle));
+        c->set_output(static_cast<int>(i) + 1, output_shape_handle);
+      }
+      return OkStatus();
+    });
+
 REGISTER_OP("IteratorGetNextSync")
     .Input("iterator: resource")
     .Output("components: output_types")
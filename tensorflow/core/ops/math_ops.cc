@@ -937,6 +937,37 @@ _FusedConv2D output.
 expected to create these operators.
 )doc");
 
+REGISTER_OP("_FusedScaledDotProductAttention")
+    .Input("query: T")
+    .Input("key: T")
+    .Input("value: T")
+    .Input("args: num_args * T")
+    .Output("output: T")
+    .Attr("T: {float}")
+    .Attr("num_args: int >= 0")
+    .Attr("scale: float = 1.0")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle query;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 4, &query));
+      ShapeHandle value;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(2), 4, &value));
+      ShapeHandle output;
+      TF_RETURN_IF_ERROR(c->ReplaceDim(query, 3, c->Dim(value, 3), &output));
+      c->set_output(0, output);
+      return absl::OkStatus();
+    })
+    .Doc(R"doc(
+Computes softmax(query * key^T * scale + mask) * value in one fused kernel,
+without materializing the full attention score matrix.
+
+The inputs are rank-4 tensors of shape [batch, heads, seq_len, head_dim]. The
+optional additive mask is specified by `args` and must broadcast against the
+attention scores of shape [batch, heads, q_len, k_len].
+
+*NOTE*: Do not invoke this operator directly in Python. Grappler is
+expected to create these operators.
+)doc");
+
 // --------------------------------------------------------------------------
 
 // For operations where the output is a reduction function along some
@@ -1932,6 +1963,42 @@ REGISTER_OP("QuantizedMatMul")
       return absl::OkStatus();
     });
 
+// Internal op computing a = fp32 activations times weight-only-quantized
+// weights, dequantized on the fly inside the GEMM. `b` holds the quantized
+// weights: int8 values for weight_bits = 8, or two signed 4-bit values per
+// byte (even row in the low nibble) for weight_bits = 4, so its row count is
+// K or K / 2 respectively. `scales` holds one dequantization scale per output
+// column. Created by the "weight_only_quantization" grappler pass; not
+// exposed in any public API.
+REGISTER_OP("_WeightOnlyQuantizedMatMul")
+    .Input("a: T")
+    .Input("b: int8")
+    .Input("scales: float")
+    .Output("product: T")
+    .Attr("T: {float} = DT_FLOAT")
+    .Attr("weight_bits: int = 8")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle a, b, scales;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 2, &a));
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(1), 2, &b));
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(2), 1, &scales));
+      int weight_bits;
+      TF_RETURN_IF_ERROR(c->GetAttr("weight_bits", &weight_bits));
+      if (weight_bits != 4 && weight_bits != 8) {
+        return errors::InvalidArgument("weight_bits must be 4 or 8, got ",
+                                       weight_bits);
+      }
+      DimensionHandle k_unpacked;
+      TF_RETURN_IF_ERROR(
+          c->Multiply(c->Dim(b, 0), 8 / weight_bits, &k_unpacked));
+      DimensionHandle k;
+      TF_RETURN_IF_ERROR(c->Merge(c->Dim(a, 1), k_unpacked, &k));
+      DimensionHandle n;
+      TF_RETURN_IF_ERROR(c->Merge(c->Dim(b, 1), c->Dim(scales, 0), &n));
+      c->set_output(0, c->Matrix(c->Dim(a, 0), n));
+      return absl::OkStatus();
+    });
+
 // Note: This op is not commutative w.r.t. to all its inputs.
 REGISTER_OP("QuantizedMul")
     .Input("x: T1")
@@ -479,7 +479,7 @@ REGISTER_OP("_FusedConv2D")
     .Input("args: TArgs")
     .Input("host_args : num_host_args * float")
     .Output("output: T")
-    .Attr("T: {half, float, double, int8, qint8}")
+    .Attr("T: {half, bfloat16, float, double, int8, qint8}")
     .Attr("TArgs: list(type)")
     .Attr("num_args: int >= 0")
     .Attr("num_host_args: int >= 0 =0")
@@ -52,6 +52,35 @@ REGISTER_STATELESS_OP("StatelessTruncatedNormal");
 
 #undef REGISTER_STATELESS_OP
 
+// Internal op grouping several same-shape StatelessRandomUniform ops into one
+// kernel invocation. Created by the "stateless_random_fusion" grappler pass;
+// not exposed in any public API. Output i is generated from seed i exactly as
+// the corresponding unfused op would generate it.
+REGISTER_OP("_FusedStatelessRandomUniform")
+    .Input("shape: T")
+    .Input("seed: N * Tseed")
+    .Output("output: N * dtype")
+    .Attr("N: int >= 1")
+    .Attr("dtype: {half,bfloat16,float,double} = DT_FLOAT")
+    .Attr("T: {int32, int64} = DT_INT32")
+    .Attr("Tseed: {int32, int64} = DT_INT64")
+    .SetShapeFn([](InferenceContext* c) {
+      int32_t n;
+      TF_RETURN_IF_ERROR(c->GetAttr("N", &n));
+      ShapeHandle seed;
+      DimensionHandle unused;
+      for (int i = 0; i < n; ++i) {
+        TF_RETURN_IF_ERROR(c->WithRank(c->input(1 + i), 1, &seed));
+        TF_RETURN_IF_ERROR(c->WithValue(c->Dim(seed, 0), 2, &unused));
+      }
+      ShapeHandle out;
+      TF_RETURN_IF_ERROR(c->MakeShapeFromShapeTensor(0, &out));
+      for (int i = 0; i < n; ++i) {
+        c->set_output(i, out);
+      }
+      return absl::OkStatus();
+    });
+
 REGISTER_OP("StatelessRandomUniformInt")
     .Input("shape: T")
     .Input("seed: Tseed")
@@ -104,6 +104,30 @@ REGISTER_OP("ResourceApplyGradientDescent")
     .Attr("use_locking: bool = false")
     .SetShapeFn(ApplyGradientDescentShapeFn<true>);
 
+static Status FusedResourceApplyGradientDescentShapeFn(InferenceContext* c) {
+  int32_t n;
+  TF_RETURN_IF_ERROR(c->GetAttr("N", &n));
+  ShapeHandle unused;
+  TF_RETURN_IF_ERROR(c->WithRank(c->input(n), 0, &unused));  // alpha
+  for (int i = 0; i < n; ++i) {
+    ShapeHandle s = ShapeOrHandleShape<true>(c, i);            // var
+    TF_RETURN_IF_ERROR(c->Merge(s, c->input(n + 1 + i), &s));  // delta
+  }
+  return absl::OkStatus();
+}
+
+// Internal op that applies gradient descent to `N` variables in one kernel
+// invocation. Created by the "fused_apply" grappler pass; not exposed in any
+// public API.
+REGISTER_OP("_FusedResourceApplyGradientDescent")
+    .Input("var: N * resource")
+    .Input("alpha: T")
+    .Input("delta: N * T")
+    .Attr("N: int >= 1")
+    .Attr("T: numbertype")
+    .Attr("use_locking: bool = false")
+    .SetShapeFn(FusedResourceApplyGradientDescentShapeFn);
+
 template <bool is_sparse, bool is_resource>
 Status ApplyProximalGradientDescentShapeFn(InferenceContext* c) {
   ShapeHandle unused;
@@ -831,6 +855,45 @@ REGISTER_OP("ResourceApplyAdam")
     .Attr("use_nesterov: bool = false")
     .SetShapeFn(ApplyAdamShapeFn</*is_resource=*/true>);
 
+static Status FusedResourceApplyAdamShapeFn(InferenceContext* c) {
+  int32_t n;
+  TF_RETURN_IF_ERROR(c->GetAttr("N", &n));
+  ShapeHandle unused;
+  for (int j = 0; j < 6; ++j) {  // beta1_power, beta2_power, lr, beta1,
+                                 // beta2, epsilon
+    TF_RETURN_IF_ERROR(c->WithRank(c->input(3 * n + j), 0, &unused));
+  }
+  for (int i = 0; i < n; ++i) {
+    ShapeHandle s = ShapeOrHandleShape<true>(c, i);  // var
+    TF_RETURN_IF_ERROR(
+        c->Merge(s, ShapeOrHandleShape<true>(c, n + i), &s));  // m
+    TF_RETURN_IF_ERROR(
+        c->Merge(s, ShapeOrHandleShape<true>(c, 2 * n + i), &s));  // v
+    TF_RETURN_IF_ERROR(c->Merge(s, c->input(3 * n + 6 + i), &s));  // grad
+  }
+  return absl::OkStatus();
+}
+
+// Internal op that applies the Adam update to `N` variables in one kernel
+// invocation, sharing the scalar hyperparameters. Created by the
+// "fused_apply" grappler pass; not exposed in any public API.
+REGISTER_OP("_FusedResourceApplyAdam")
+    .Input("var: N * resource")
+    .Input("m: N * resource")
+    .Input("v: N * resource")
+    .Input("beta1_power: T")
+    .Input("beta2_power: T")
+    .Input("lr: T")
+    .Input("beta1: T")
+    .Input("beta2: T")
+    .Input("epsilon: T")
+    .Input("grad: N * T")
+    .Attr("N: int >= 1")
+    .Attr("T: numbertype")
+    .Attr("use_locking: bool = false")
+    .Attr("use_nesterov: bool = false")
+    .SetShapeFn(FusedResourceApplyAdamShapeFn);
+
 template <bool is_resource>
 static Status ApplyAdamWithAmsgradShapeFn(InferenceContext* c) {
   ShapeHandle unused;
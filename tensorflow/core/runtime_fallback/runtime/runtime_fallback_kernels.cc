@@ -754,15 +754,26 @@ void CoreRTTensorHandleToFallbackTensorInternal(
     assert(tensor_avref.IsAvailable());
     assert(!tensor_avref.IsError());
     auto& tensor = tensor_avref.get();
-    if (!tensor.IsTensorType(DenseHostTensor::kTensorType) ||
-        !src_device.IsDeviceType(tfrt::CpuDevice::kDeviceType) ||
-        !dst_device.IsDeviceType(tfrt::CpuDevice::kDeviceType)) {
-      return tfrt::ConvertTensor(exec_ctx, tensor,
-                                 /*src=*/src_device,
-                                 /*dst=*/dst_device,
-                                 KernelFallbackTensor::kTensorType);
+    // Pass through tensors that kernel fallback can already read directly:
+    // a KernelFallbackTensor wraps a tensorflow::Tensor, and a host
+    // DenseHostTensor is unwrapped by TFRTTensorToTFTensor without copying.
+    // This keeps the tensorflow::Tensor representation across chains of
+    // consecutive fallback kernels instead of bouncing every tensor through
+    // the conversion registry (and a fresh AsyncValue) at each boundary.
+    const bool same_device = (&src_device == &dst_device) ||
+                             (src_device.name() == dst_device.name());
+    const bool cpu_to_cpu =
+        src_device.IsDeviceType(tfrt::CpuDevice::kDeviceType) &&
+        dst_device.IsDeviceType(tfrt::CpuDevice::kDeviceType);
+    if ((tensor.IsTensorType(KernelFallbackTensor::kTensorType) &&
+         (same_device || cpu_to_cpu)) ||
+        (tensor.IsTensorType(DenseHostTensor::kTensorType) && cpu_to_cpu)) {
+      return tensor_avref;
     }
-    return tensor_avref;
+    return tfrt::ConvertTensor(exec_ctx, tensor,
+                               /*src=*/src_device,
+                               /*dst=*/dst_device,
+                               KernelFallbackTensor::kTensorType);
   };
 
   auto dst_device = exec_ctx.host()->GetDeviceRef(device);
@@ -14,7 +14,10 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/summary/summary_file_writer.h"
 
+#include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -55,27 +58,47 @@ class SummaryFileWriter : public SummaryWriterInterface {
     string sep = absl::StartsWith(filename_suffix, ".") ? "" : ".";
     const string uniquified_filename_suffix = absl::StrCat(
         ".", pid, ".", file_id_counter.fetch_add(1), sep, filename_suffix);
+    {
+      mutex_lock wl(writer_mu_);
+      events_writer_ =
+          std::make_unique<EventsWriter>(io::JoinPath(logdir, "events"));
+      TF_RETURN_WITH_CONTEXT_IF_ERROR(
+          events_writer_->InitWithSuffix(uniquified_filename_suffix),
+          "Could not initialize events writer.");
+    }
     mutex_lock ml(mu_);
-    events_writer_ =
-        std::make_unique<EventsWriter>(io::JoinPath(logdir, "events"));
-    TF_RETURN_WITH_CONTEXT_IF_ERROR(
-        events_writer_->InitWithSuffix(uniquified_filename_suffix),
-        "Could not initialize events writer.");
     last_flush_ = env_->NowMicros();
     is_initialized_ = true;
+    // Events are committed by a background thread so that writers never
+    // block on compression or file I/O.
+    flush_thread_.reset(env_->StartThread(
+        ThreadOptions(), "summary_file_writer", [this]() { FlushLoop(); }));
     return absl::OkStatus();
   }
 
   Status Flush() override {
-    mutex_lock ml(mu_);
-    if (!is_initialized_) {
-      return errors::FailedPrecondition("Class was not properly initialized.");
+    {
+      mutex_lock ml(mu_);
+      if (!is_initialized_) {
+        return errors::FailedPrecondition(
+            "Class was not properly initialized.");
+      }
     }
-    return InternalFlush();
+    return CommitPending();
   }
 
   ~SummaryFileWriter() override {
-    (void)Flush();  // Ignore errors.
+    bool initialized;
+    {
+      mutex_lock ml(mu_);
+      initialized = is_initialized_;
+      stop_ = true;
+      wake_cv_.notify_all();
+    }
+    flush_thread_.reset();  // Joins.
+    if (initialized) {
+      (void)CommitPending();  // Ignore errors.
+    }
   }
 
   Status WriteTensor(int64_t global_step, Tensor t, const string& tag,
@@ -152,10 +175,20 @@ class SummaryFileWriter : public SummaryWriterInterface {
 
   Status WriteEvent(std::unique_ptr<Event> event) override {
     mutex_lock ml(mu_);
+    if (!status_.ok()) return status_;
+    // Coalesce summaries logged for the same step (e.g. many scalars) into
+    // one Event so they are serialized and written as a single record.
+    if (!queue_.empty() && event->has_summary()) {
+      Event* back = queue_.back().get();
+      if (back->has_summary() && back->step() == event->step()) {
+        back->mutable_summary()->MergeFrom(event->summary());
+        return absl::OkStatus();
+      }
+    }
     queue_.emplace_back(std::move(event));
     if (queue_.size() > max_queue_ ||
         env_->NowMicros() - last_flush_ > 1000 * flush_millis_) {
-      return InternalFlush();
+      wake_cv_.notify_one();
     }
     return absl::OkStatus();
   }
@@ -167,28 +200,64 @@ class SummaryFileWriter : public SummaryWriterInterface {
     return static_cast<double>(env_->NowMicros()) / 1.0e6;
   }
 
-  Status InternalFlush() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-    for (const std::unique_ptr<Event>& e : queue_) {
+  // Writes all queued events and flushes them to disk. Serialized by
+  // writer_mu_, which also keeps batches in queue order when the caller
+  // races with the background thread.
+  Status CommitPending() TF_LOCKS_EXCLUDED(mu_, writer_mu_) {
+    mutex_lock wl(writer_mu_);
+    std::vector<std::unique_ptr<Event>> batch;
+    {
+      mutex_lock ml(mu_);
+      batch.swap(queue_);
+      last_flush_ = env_->NowMicros();
+    }
+    for (const std::unique_ptr<Event>& e : batch) {
       events_writer_->WriteEvent(*e);
     }
-    queue_.clear();
-    TF_RETURN_WITH_CONTEXT_IF_ERROR(events_writer_->Flush(),
-                                    "Could not flush events file.");
-    last_flush_ = env_->NowMicros();
+    const Status s = events_writer_->Flush();
+    if (!s.ok()) {
+      mutex_lock ml(mu_);
+      status_.Update(s);
+    }
+    TF_RETURN_WITH_CONTEXT_IF_ERROR(s, "Could not flush events file.");
     return absl::OkStatus();
   }
 
-  bool is_initialized_;
+  void FlushLoop() {
+    while (true) {
+      {
+        mutex_lock ml(mu_);
+        while (!stop_ &&
+               (queue_.empty() ||
+                (queue_.size() <= max_queue_ &&
+                 env_->NowMicros() - last_flush_ <= 1000 * flush_millis_))) {
+          WaitForMilliseconds(&ml, &wake_cv_, std::max(flush_millis_, 1));
+        }
+        // Events still queued at shutdown are committed by the destructor
+        // after it joins this thread.
+        if (stop_) return;
+      }
+      (void)CommitPending();  // Errors are sticky in status_.
+    }
+  }
+
+  bool is_initialized_ TF_GUARDED_BY(mu_);
   const int max_queue_;
   const int flush_millis_;
-  uint64 last_flush_;
+  uint64 last_flush_ TF_GUARDED_BY(mu_);
   Env* env_;
   mutex mu_;
+  condition_variable wake_cv_;
+  bool stop_ TF_GUARDED_BY(mu_) = false;
+  // The first error hit by a background commit, returned by later writes.
+  Status status_ TF_GUARDED_BY(mu_);
   std::vector<std::unique_ptr<Event>> queue_ TF_GUARDED_BY(mu_);
+  mutex writer_mu_ TF_ACQUIRED_BEFORE(mu_);
   // A pointer to allow deferred construction.
-  std::unique_ptr<EventsWriter> events_writer_ TF_GUARDED_BY(mu_);
+  std::unique_ptr<EventsWriter> events_writer_ TF_GUARDED_BY(writer_mu_);
   std::vector<std::pair<string, SummaryMetadata>> registered_summaries_
       TF_GUARDED_BY(mu_);
+  std::unique_ptr<Thread> flush_thread_;
 };
 
 }  // namespace
@@ -28,11 +28,14 @@ namespace tensorflow {
 /// makes this summary writer suitable for file systems like GCS.
 ///
 /// It will enqueue up to max_queue summaries, and flush at least every
-/// flush_millis milliseconds. The summaries will be written to the
-/// directory specified by logdir and with the filename suffixed by
-/// filename_suffix. The caller owns a reference to result if the
-/// returned status is ok. The Env object must not be destroyed until
-/// after the returned writer.
+/// flush_millis milliseconds. Summaries logged for the same step are
+/// coalesced into a single Event, and queued events are committed to
+/// the file by a background thread, so writing never blocks the caller
+/// on file I/O; call Flush() to force the events to disk. The summaries
+/// will be written to the directory specified by logdir and with the
+/// filename suffixed by filename_suffix. The caller owns a reference to
+/// result if the returned status is ok. The Env object must not be
+/// destroyed until after the returned writer.
 Status CreateSummaryFileWriter(int max_queue, int flush_millis,
                                const string& logdir,
                                const string& filename_suffix, Env* env,
@@ -143,6 +143,25 @@ TEST_F(SummaryFileWriterTest, WriteScalar) {
       }));
 }
 
+TEST_F(SummaryFileWriterTest, ScalarsOfOneStepAreCoalesced) {
+  TF_CHECK_OK(SummaryTestHelper(
+      "coalesce_test",
+      [](SummaryWriterInterface* writer) {
+        Tensor one(DT_FLOAT, TensorShape({}));
+        one.scalar<float>()() = 1.0;
+        TF_RETURN_IF_ERROR(writer->WriteScalar(2, one, "first"));
+        TF_RETURN_IF_ERROR(writer->WriteScalar(2, one, "second"));
+        TF_RETURN_IF_ERROR(writer->Flush());
+        return absl::OkStatus();
+      },
+      [](const Event& e) {
+        EXPECT_EQ(e.step(), 2);
+        CHECK_EQ(e.summary().value_size(), 2);
+        EXPECT_EQ(e.summary().value(0).tag(), "first");
+        EXPECT_EQ(e.summary().value(1).tag(), "second");
+      }));
+}
+
 TEST_F(SummaryFileWriterTest, WriteHistogram) {
   TF_CHECK_OK(SummaryTestHelper("hist_test",
                                 [](SummaryWriterInterface* writer) {
@@ -96,6 +96,13 @@ struct GraphExecutionOptions {
     // Number of times to record costs before resetting Op cost estimates.
     // However, a reset always occurs after the first execution.
     int updates_per_interval = 1;
+
+    // Number of initial executions measured before the one-time
+    // recompilation when `version` is `kOnce`. Op costs are averaged over
+    // these executions, which smooths per-op latency noise in graphs that
+    // mix tiny and large ops, at the cost of delaying the re-specialized
+    // executable. Must be >= 1.
+    int measurement_steps = 1;
   };
 
   CostAnalysisOptions cost_analysis_options;
@@ -1043,6 +1043,15 @@ CostRecorder* GraphExecutor::LoadedClientGraph::MaybeGetCostRecorder(
     return nullptr;
   }
   const auto& options = graph_executor_->options().cost_analysis_options;
+  if (options.version == Options::CostAnalysisOptions::kOnce) {
+    // Record every execution until `measurement_steps` executions have been
+    // measured; the costs averaged over them drive the one-time
+    // recompilation.
+    cost_analysis_data_.is_available = false;
+    *do_recompilation =
+        1 + cost_analysis_data_.num_cost_updates >= options.measurement_steps;
+    return cost_analysis_data_.cost_recorder.get();
+  }
   absl::Duration elapsed_duration = now - cost_analysis_data_.start_time;
   double intended_num_updates = absl::ToDoubleSeconds(elapsed_duration) /
                                 absl::ToDoubleSeconds(options.reset_interval) *
@@ -1146,10 +1155,14 @@ GraphExecutor::LoadedClientGraph::LoadedClientGraph(
       latency_sampler_(latency_sampler) {
   const auto& options = graph_executor_->options().cost_analysis_options;
   if (options.version != Options::CostAnalysisOptions::kDisabled) {
-    // Initialize in a way that ensures recompilation on the first run.
+    // Initialize in a way that ensures recompilation on the first run for
+    // kPeriodic, and after `measurement_steps` runs for kOnce.
     cost_analysis_data_.start_time = absl::Now() - options.reset_interval;
     cost_analysis_data_.is_available = true;
-    cost_analysis_data_.num_cost_updates = options.updates_per_interval - 1;
+    cost_analysis_data_.num_cost_updates =
+        options.version == Options::CostAnalysisOptions::kOnce
+            ? 0
+            : options.updates_per_interval - 1;
     cost_analysis_data_.cost_recorder = std::make_unique<CostRecorder>();
     if (executable_context_->IsForMlrt()) {
       cost_analysis_data_.tf_mlir_with_op_keys =
@@ -119,6 +119,43 @@ constexpr uint8 kVarintTag(uint32 tag) { return (tag << 3) | 0; }
 constexpr uint8 kDelimitedTag(uint32 tag) { return (tag << 3) | 2; }
 constexpr uint8 kFixed32Tag(uint32 tag) { return (tag << 3) | 5; }
 
+// Counts the varints in [p, end): each varint's final byte has the
+// continuation bit clear. The loop is branch-free and auto-vectorizes, so a
+// packed payload can be sized in one cheap scan before decoding.
+inline size_t CountVarints(const uint8* p, const uint8* end) {
+  size_t n = 0;
+  while (p < end) n += (*p++ < 0x80);
+  return n;
+}
+
+// Decodes every varint in [p, end) into `out`, writing at most `max_elements`
+// values (additional values are decoded and discarded, mirroring how
+// LimitedArraySlice absorbs overflow). Returns false if the range ends in the
+// middle of a varint or a varint is longer than ten bytes.
+inline bool DecodePackedVarints(const uint8* p, const uint8* end, int64_t* out,
+                                size_t max_elements) {
+  int64_t* out_end = out + max_elements;
+  while (p < end) {
+    uint64 result;
+    if (*p < 0x80) {
+      // Single-byte values dominate feature data; keep this path tight.
+      result = *p++;
+    } else {
+      result = 0;
+      int shift = 0;
+      uint8 b;
+      do {
+        if (p == end || shift > 63) return false;
+        b = *p++;
+        result |= static_cast<uint64>(b & 0x7f) << shift;
+        shift += 7;
+      } while (b & 0x80);
+    }
+    if (out < out_end) *out++ = static_cast<int64_t>(result);
+  }
+  return true;
+}
+
 namespace parsed {
 
 // ParseDataType has to be called first, then appropriate ParseZzzzList.
@@ -307,10 +344,30 @@ class Feature {
         if (!stream.ReadVarint32(&packed_length)) return false;
         auto packed_limit = stream.PushLimit(packed_length);
 
-        while (!stream.ExpectAtEnd()) {
-          protobuf_uint64 n;  // There is no API for int64
-          if (!stream.ReadVarint64(&n)) return false;
-          int64_list->push_back(static_cast<int64_t>(n));
+        // The stream aliases one flat buffer, so the packed payload is a
+        // single contiguous byte range. Size the output with one vectorized
+        // scan and decode straight into it, instead of going through
+        // CodedInputStream with a push_back per value.
+        if (packed_length > 0) {
+          const void* data_ptr;
+          int data_size;
+          if (!stream.GetDirectBufferPointer(&data_ptr, &data_size) ||
+              data_size < static_cast<int>(packed_length)) {
+            return false;
+          }
+          const uint8* data = static_cast<const uint8*>(data_ptr);
+          const size_t initial_size = int64_list->size();
+          int64_list->resize(initial_size +
+                             CountVarints(data, data + packed_length));
+          // The available buffer can be smaller than what we requested in
+          // resize in case of a LimitedArraySlice.
+          const size_t max_elements = int64_list->size() - initial_size;
+          if (!DecodePackedVarints(data, data + packed_length,
+                                   int64_list->data() + initial_size,
+                                   max_elements)) {
+            return false;
+          }
+          stream.Skip(packed_length);
         }
 
         stream.PopLimit(packed_limit);
@@ -517,6 +574,18 @@ bool TestFastParse(const string& serialized, Example* example) {
 
 // -----------------------------------------------------------------------------
 
+// Enumeration for distinguishing feature types.
+// Note: FastParseSequenceExample constructs a map that includes Type values,
+// and relies on the fact that they are default-initialized to Dense.
+enum class Type { Dense, Sparse, Ragged };
+
+struct SeededHasher {
+  uint64 operator()(StringPiece s) const {
+    return Hash64(s.data(), s.size(), seed);
+  }
+  uint64 seed{0xDECAFCAFFE};
+};
+
 namespace {
 
 using Config = FastParseExampleConfig;
@@ -541,11 +610,6 @@ void ParallelFor(const std::function<void(size_t)>& f, size_t n,
   }
 }
 
-// Enumeration for distinguishing feature types.
-// Note: FastParseSequenceExample constructs a map that includes Type values,
-// and relies on the fact that they are default-initialized to Dense.
-enum class Type { Dense, Sparse, Ragged };
-
 // Note: We use SparseBuffer for sparse, ragged, and dense_varlen features.
 struct SparseBuffer {
   // Features are in one of the 3 vectors below depending on config's dtype.
@@ -560,13 +624,6 @@ struct SparseBuffer {
   std::vector<size_t> example_end_indices;
 };
 
-struct SeededHasher {
-  uint64 operator()(StringPiece s) const {
-    return Hash64(s.data(), s.size(), seed);
-  }
-  uint64 seed{0xDECAFCAFFE};
-};
-
 void LogDenseFeatureDataLoss(StringPiece feature_name) {
   LOG(WARNING) << "Data loss! Feature '" << feature_name
                << "' is present in multiple concatenated "
@@ -1131,50 +1188,54 @@ void CopySparseBufferToTensor(DataType dtype, size_t offset, SparseBuffer* src,
   }
 }
 
-}  // namespace
-
-Status FastParseExample(const Config& config,
-                        absl::Span<const tstring> serialized,
-                        absl::Span<const tstring> example_names,
-                        thread::ThreadPool* thread_pool, Result* result) {
-  DCHECK(result != nullptr);
-  // Check config so we can safely CHECK(false) in switches on config.*.dtype
-  TF_RETURN_IF_ERROR(CheckConfigDataTypes(config));
-
-  if (config.collect_feature_stats) {
-    result->feature_stats.resize(serialized.size());
-  }
-
-  size_t config_size =
+// Builds the feature_name -> (config position, feature type) index used to
+// dispatch features while parsing.  `config_index` must be sized for the
+// total number of features in `config`.  On the (extremely unlikely) event
+// of a hash collision the index is rebuilt with a fresh seed.
+Status BuildConfigIndex(
+    const Config& config, SeededHasher* hasher,
+    PresizedCuckooMap<std::pair<size_t, Type>>* config_index) {
+  const size_t config_size =
       config.dense.size() + config.sparse.size() + config.ragged.size();
-  SeededHasher hasher;
-  // Build config index.
-  PresizedCuckooMap<std::pair<size_t, Type>> config_index(config_size);
   bool ok = true;
   for (size_t i = 0; i < 1000; ++i) {
     for (size_t d = 0; d < config.dense.size(); ++d) {
-      ok &= config_index.InsertUnique(hasher(config.dense[d].feature_name),
-                                      {d, Type::Dense});
+      ok &= config_index->InsertUnique((*hasher)(config.dense[d].feature_name),
+                                       {d, Type::Dense});
     }
     for (size_t d = 0; d < config.sparse.size(); ++d) {
-      ok &= config_index.InsertUnique(hasher(config.sparse[d].feature_name),
-                                      {d, Type::Sparse});
+      ok &= config_index->InsertUnique((*hasher)(config.sparse[d].feature_name),
+                                       {d, Type::Sparse});
     }
     for (size_t d = 0; d < config.ragged.size(); ++d) {
-      ok &= config_index.InsertUnique(hasher(config.ragged[d].feature_name),
-                                      {d, Type::Ragged});
+      ok &= config_index->InsertUnique((*hasher)(config.ragged[d].feature_name),
+                                       {d, Type::Ragged});
     }
     if (ok) break;
     LOG(WARNING) << "Collision found. This should happen only if you have "
                     "around 2^32 entries in your config.";
-    hasher.seed++;
-    config_index.Clear(config_size);
+    hasher->seed++;
+    config_index->Clear(config_size);
     ok = true;
   }
   if (!ok) {
     return errors::Internal(
         "Could not avoid collision. This should not happen.");
   }
+  return absl::OkStatus();
+}
+
+// Shared implementation of the FastParseExample overloads; expects a config
+// that passed CheckConfigDataTypes() and a feature index built for it.
+Status FastParseExampleImpl(
+    const Config& config,
+    const PresizedCuckooMap<std::pair<size_t, Type>>& config_index,
+    const SeededHasher& hasher, absl::Span<const tstring> serialized,
+    absl::Span<const tstring> example_names, thread::ThreadPool* thread_pool,
+    Result* result) {
+  if (config.collect_feature_stats) {
+    result->feature_stats.resize(serialized.size());
+  }
 
   // Allocate dense output for fixed length dense values
   // (variable-length dense and sparse and ragged have to be buffered).
@@ -1447,6 +1508,86 @@ Status FastParseExample(const Config& config,
   return absl::OkStatus();
 }
 
+}  // namespace
+
+// Holds the schema-derived state that FastParseExample otherwise rebuilds on
+// every call: the hash seed and the feature-name dispatch index.
+struct FastParseExamplePlan::Impl {
+  explicit Impl(size_t config_size) : config_index(config_size) {}
+
+  // Feature counts of the compiled config, used to cheaply reject per-call
+  // configs that do not match the compiled schema.
+  size_t num_dense = 0;
+  size_t num_sparse = 0;
+  size_t num_ragged = 0;
+  SeededHasher hasher;
+  PresizedCuckooMap<std::pair<size_t, Type>> config_index;
+};
+
+FastParseExamplePlan::FastParseExamplePlan() = default;
+FastParseExamplePlan::~FastParseExamplePlan() = default;
+FastParseExamplePlan::FastParseExamplePlan(FastParseExamplePlan&&) = default;
+FastParseExamplePlan& FastParseExamplePlan::operator=(FastParseExamplePlan&&) =
+    default;
+
+/* static */ Status FastParseExamplePlan::Compile(
+    const FastParseExampleConfig& config, FastParseExamplePlan* plan) {
+  DCHECK(plan != nullptr);
+  TF_RETURN_IF_ERROR(CheckConfigDataTypes(config));
+  const size_t config_size =
+      config.dense.size() + config.sparse.size() + config.ragged.size();
+  auto impl = std::make_unique<Impl>(config_size);
+  impl->num_dense = config.dense.size();
+  impl->num_sparse = config.sparse.size();
+  impl->num_ragged = config.ragged.size();
+  TF_RETURN_IF_ERROR(
+      BuildConfigIndex(config, &impl->hasher, &impl->config_index));
+  plan->impl_ = std::move(impl);
+  return absl::OkStatus();
+}
+
+Status FastParseExample(const Config& config,
+                        absl::Span<const tstring> serialized,
+                        absl::Span<const tstring> example_names,
+                        thread::ThreadPool* thread_pool, Result* result) {
+  DCHECK(result != nullptr);
+  // Check config so we can safely CHECK(false) in switches on config.*.dtype
+  TF_RETURN_IF_ERROR(CheckConfigDataTypes(config));
+
+  const size_t config_size =
+      config.dense.size() + config.sparse.size() + config.ragged.size();
+  SeededHasher hasher;
+  PresizedCuckooMap<std::pair<size_t, Type>> config_index(config_size);
+  TF_RETURN_IF_ERROR(BuildConfigIndex(config, &hasher, &config_index));
+
+  return FastParseExampleImpl(config, config_index, hasher, serialized,
+                              example_names, thread_pool, result);
+}
+
+Status FastParseExample(const Config& config, const FastParseExamplePlan& plan,
+                        absl::Span<const tstring> serialized,
+                        absl::Span<const tstring> example_names,
+                        thread::ThreadPool* thread_pool, Result* result) {
+  DCHECK(result != nullptr);
+  if (plan.impl_ == nullptr) {
+    return errors::FailedPrecondition(
+        "FastParseExamplePlan has not been compiled.");
+  }
+  if (config.dense.size() != plan.impl_->num_dense ||
+      config.sparse.size() != plan.impl_->num_sparse ||
+      config.ragged.size() != plan.impl_->num_ragged) {
+    return errors::InvalidArgument(
+        "FastParseExamplePlan was compiled for a different config: expected ",
+        plan.impl_->num_dense, " dense, ", plan.impl_->num_sparse,
+        " sparse and ", plan.impl_->num_ragged, " ragged features, got ",
+        config.dense.size(), ", ", config.sparse.size(), " and ",
+        config.ragged.size(), ".");
+  }
+  return FastParseExampleImpl(config, plan.impl_->config_index,
+                              plan.impl_->hasher, serialized, example_names,
+                              thread_pool, result);
+}
+
 Status FastParseSingleExample(const Config& config, StringPiece serialized,
                               Result* result) {
   DCHECK(result != nullptr);
@@ -1463,33 +1604,8 @@ Status FastParseSingleExample(const Config& config, StringPiece serialized,
   size_t config_size =
       config.dense.size() + config.sparse.size() + config.ragged.size();
   SeededHasher hasher;
-  // Build config index.
   PresizedCuckooMap<std::pair<size_t, Type>> config_index(config_size);
-  bool ok = true;
-  for (size_t i = 0; i < 1000; ++i) {
-    for (size_t d = 0; d < config.dense.size(); ++d) {
-      ok &= config_index.InsertUnique(hasher(config.dense[d].feature_name),
-                                      {d, Type::Dense});
-    }
-    for (size_t d = 0; d < config.sparse.size(); ++d) {
-      ok &= config_index.InsertUnique(hasher(config.sparse[d].feature_name),
-                                      {d, Type::Sparse});
-    }
-    for (size_t d = 0; d < config.ragged.size(); ++d) {
-      ok &= config_index.InsertUnique(hasher(config.ragged[d].feature_name),
-                                      {d, Type::Ragged});
-    }
-    if (ok) break;
-    LOG(WARNING) << "Collision found. This should happen only if you have "
-                    "around 2^32 entries in your config.";
-    hasher.seed++;
-    config_index.Clear(config_size);
-    ok = true;
-  }
-  if (!ok) {
-    return errors::Internal(
-        "Could not avoid collision. This should not happen.");
-  }
+  TF_RETURN_IF_ERROR(BuildConfigIndex(config, &hasher, &config_index));
 
   result->sparse_indices.reserve(config.sparse.size());
   result->sparse_values.reserve(config.sparse.size());
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_UTIL_EXAMPLE_PROTO_FAST_PARSING_H_
 #define TENSORFLOW_CORE_UTIL_EXAMPLE_PROTO_FAST_PARSING_H_
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -139,6 +140,47 @@ Status FastParseExample(const FastParseExampleConfig& config,
                         absl::Span<const tstring> example_names,
                         thread::ThreadPool* thread_pool, Result* result);
 
+class FastParseExamplePlan;
+
+// As above, but reuses `plan`, compiled once with FastParseExamplePlan::
+// Compile(), instead of re-deriving the feature dispatch tables from `config`
+// on every call.  `config` must describe the same schema (feature names and
+// dtypes, in the same order) as the config the plan was compiled from; tensor
+// contents such as dense defaults may differ between calls.
+Status FastParseExample(const FastParseExampleConfig& config,
+                        const FastParseExamplePlan& plan,
+                        absl::Span<const tstring> serialized,
+                        absl::Span<const tstring> example_names,
+                        thread::ThreadPool* thread_pool, Result* result);
+
+// A schema-specialized parse plan for FastParseExample.  Compiling a plan
+// performs the configuration work that is otherwise repeated on every call
+// (dtype validation and feature-name index construction), so callers that
+// parse the same schema for many batches -- e.g. serving graphs -- pay for
+// it only once.
+class FastParseExamplePlan {
+ public:
+  FastParseExamplePlan();
+  ~FastParseExamplePlan();
+  FastParseExamplePlan(FastParseExamplePlan&& other);
+  FastParseExamplePlan& operator=(FastParseExamplePlan&& other);
+
+  // Validates `config` and builds the feature-name dispatch index for it.
+  // On success `plan` is ready for use with FastParseExample().
+  static Status Compile(const FastParseExampleConfig& config,
+                        FastParseExamplePlan* plan);
+
+ private:
+  friend Status FastParseExample(const FastParseExampleConfig& config,
+                                 const FastParseExamplePlan& plan,
+                                 absl::Span<const tstring> serialized,
+                                 absl::Span<const tstring> example_names,
+                                 thread::ThreadPool* thread_pool,
+                                 Result* result);
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 // TODO(mrry): Move the hash table construction into the config object.
 typedef FastParseExampleConfig FastParseSingleExampleConfig;
 
@@ -429,6 +429,51 @@ TEST(TestFastParseExample, Empty) {
   EXPECT_TRUE(status.ok()) << status;
 }
 
+TEST(FastParse, CompiledPlanMatchesUncompiled) {
+  const size_t kNumExamples = 7;
+  std::vector<tstring> serialized(kNumExamples, ExampleWithSomeFeatures());
+
+  FastParseExampleConfig config;
+  AddDenseFeature("bytes_list", DT_STRING, {2}, false, 2, &config);
+  AddSparseFeature("float_list", DT_FLOAT, &config);
+  AddSparseFeature("int64_list", DT_INT64, &config);
+
+  FastParseExamplePlan plan;
+  TF_CHECK_OK(FastParseExamplePlan::Compile(config, &plan));
+
+  Result expected;
+  TF_CHECK_OK(FastParseExample(config, serialized, {}, nullptr, &expected));
+  Result result;
+  TF_CHECK_OK(
+      FastParseExample(config, plan, serialized, {}, nullptr, &result));
+
+  ASSERT_EQ(expected.dense_values.size(), result.dense_values.size());
+  for (size_t d = 0; d < expected.dense_values.size(); ++d) {
+    EXPECT_EQ(expected.dense_values[d].DebugString(),
+              result.dense_values[d].DebugString());
+  }
+  ASSERT_EQ(expected.sparse_values.size(), result.sparse_values.size());
+  for (size_t d = 0; d < expected.sparse_values.size(); ++d) {
+    EXPECT_EQ(expected.sparse_indices[d].DebugString(),
+              result.sparse_indices[d].DebugString());
+    EXPECT_EQ(expected.sparse_values[d].DebugString(),
+              result.sparse_values[d].DebugString());
+    EXPECT_EQ(expected.sparse_shapes[d].DebugString(),
+              result.sparse_shapes[d].DebugString());
+  }
+}
+
+TEST(FastParse, UncompiledPlanIsRejected) {
+  FastParseExampleConfig config;
+  config.sparse.push_back({"test", DT_STRING});
+  FastParseExamplePlan plan;
+  Result result;
+  Status status =
+      FastParseExample(config, plan, absl::Span<const tstring>(),
+                       absl::Span<const tstring>(), nullptr, &result);
+  EXPECT_FALSE(status.ok());
+}
+
 }  // namespace
 }  // namespace example
 }  // namespace tensorflow
@@ -19,11 +19,15 @@ limitations under the License.
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 
 #include <algorithm>
+#include <map>
+#include <tuple>
+#include <utility>
 
 #include "absl/base/casts.h"
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/stream_executor.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/gpu_cuda_alias.h"
@@ -108,6 +112,58 @@ namespace tensorflow {
 
 inline int DivUp(int a, int b) { return (a + b - 1) / b; }
 
+namespace internal {
+
+// Process-lifetime cache for occupancy calculator results. The results are
+// pure functions of the kernel symbol, the device and the query parameters,
+// so they can be computed once and reused; elementwise ops otherwise repeat
+// the same occupancy query on every one of the thousands of launches per
+// step, which is measurable when launch overhead dominates.
+class OccupancyCache {
+ public:
+  enum Kind {
+    kMaxPotentialBlockSize,
+    kMaxActiveBlocksPerMultiprocessor,
+  };
+
+  static OccupancyCache* Global() {
+    static OccupancyCache* cache = new OccupancyCache;
+    return cache;
+  }
+
+  // Returns true and fills in the cached result of an earlier query with the
+  // same key, or returns false if the query has to be performed.
+  bool Lookup(Kind kind, const void* func, int device,
+              size_t dynamic_shared_memory_size, int block_size_limit,
+              int* block_count, int* thread_per_block) {
+    mutex_lock l(mu_);
+    auto iter = configs_.find(
+        Key{kind, func, device, dynamic_shared_memory_size, block_size_limit});
+    if (iter == configs_.end()) return false;
+    *block_count = iter->second.first;
+    *thread_per_block = iter->second.second;
+    return true;
+  }
+
+  void Insert(Kind kind, const void* func, int device,
+              size_t dynamic_shared_memory_size, int block_size_limit,
+              int block_count, int thread_per_block) {
+    mutex_lock l(mu_);
+    configs_[Key{kind, func, device, dynamic_shared_memory_size,
+                 block_size_limit}] = {block_count, thread_per_block};
+  }
+
+ private:
+  using Key = std::tuple<int, const void*, int, size_t, int>;
+
+  OccupancyCache() = default;
+
+  mutex mu_;
+  std::map<Key, std::pair<int, int>> configs_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace internal
+
 struct GpuLaunchConfig {
   // Logical number of thread that works on the elements. If each logical
   // thread works on exactly a single element, this is the same as the working
@@ -162,17 +218,33 @@ GpuLaunchConfig GetGpuLaunchConfig(int work_element_count,
   int block_count = 0;
   int thread_per_block = 0;
 
+  int device = 0;
 #if GOOGLE_CUDA
-  cudaError_t err = cudaOccupancyMaxPotentialBlockSize(
-      &block_count, &thread_per_block, func, dynamic_shared_memory_size,
-      block_size_limit);
-  CHECK_EQ(err, cudaSuccess);
+  cudaGetDevice(&device);
 #elif TENSORFLOW_USE_ROCM
-  hipError_t err = hipOccupancyMaxPotentialBlockSize(
-      &block_count, &thread_per_block, func, dynamic_shared_memory_size,
-      block_size_limit);
-  CHECK_EQ(err, hipSuccess);
+  CHECK_EQ(hipGetDevice(&device), hipSuccess);
+#endif
+  internal::OccupancyCache* cache = internal::OccupancyCache::Global();
+  if (!cache->Lookup(internal::OccupancyCache::kMaxPotentialBlockSize,
+                     reinterpret_cast<const void*>(func), device,
+                     dynamic_shared_memory_size, block_size_limit, &block_count,
+                     &thread_per_block)) {
+#if GOOGLE_CUDA
+    cudaError_t err = cudaOccupancyMaxPotentialBlockSize(
+        &block_count, &thread_per_block, func, dynamic_shared_memory_size,
+        block_size_limit);
+    CHECK_EQ(err, cudaSuccess);
+#elif TENSORFLOW_USE_ROCM
+    hipError_t err = hipOccupancyMaxPotentialBlockSize(
+        &block_count, &thread_per_block, func, dynamic_shared_memory_size,
+        block_size_limit);
+    CHECK_EQ(err, hipSuccess);
 #endif
+    cache->Insert(internal::OccupancyCache::kMaxPotentialBlockSize,
+                  reinterpret_cast<const void*>(func), device,
+                  dynamic_shared_memory_size, block_size_limit, block_count,
+                  thread_per_block);
+  }
 
   block_count =
       std::min(block_count, DivUp(work_element_count, thread_per_block));
@@ -196,15 +268,33 @@ GpuLaunchConfig GetGpuLaunchConfigFixedBlockSize(
   GpuLaunchConfig config;
   int block_count = 0;
 
+  int device = 0;
 #if GOOGLE_CUDA
-  cudaError_t err = cudaOccupancyMaxActiveBlocksPerMultiprocessor(
-      &block_count, func, fixed_block_size, dynamic_shared_memory_size);
-  CHECK_EQ(err, cudaSuccess);
+  cudaGetDevice(&device);
 #elif TENSORFLOW_USE_ROCM
-  hipError_t err = hipOccupancyMaxActiveBlocksPerMultiprocessor(
-      &block_count, func, fixed_block_size, dynamic_shared_memory_size);
-  CHECK_EQ(err, hipSuccess);
+  CHECK_EQ(hipGetDevice(&device), hipSuccess);
 #endif
+  internal::OccupancyCache* cache = internal::OccupancyCache::Global();
+  int unused_thread_per_block = fixed_block_size;
+  if (!cache->Lookup(
+          internal::OccupancyCache::kMaxActiveBlocksPerMultiprocessor,
+          reinterpret_cast<const void*>(func), device,
+          dynamic_shared_memory_size, fixed_block_size, &block_count,
+          &unused_thread_per_block)) {
+#if GOOGLE_CUDA
+    cudaError_t err = cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+        &block_count, func, fixed_block_size, dynamic_shared_memory_size);
+    CHECK_EQ(err, cudaSuccess);
+#elif TENSORFLOW_USE_ROCM
+    hipError_t err = hipOccupancyMaxActiveBlocksPerMultiprocessor(
+        &block_count, func, fixed_block_size, dynamic_shared_memory_size);
+    CHECK_EQ(err, hipSuccess);
+#endif
+    cache->Insert(internal::OccupancyCache::kMaxActiveBlocksPerMultiprocessor,
+                  reinterpret_cast<const void*>(func), device,
+                  dynamic_shared_memory_size, fixed_block_size, block_count,
+                  fixed_block_size);
+  }
   block_count = std::min(block_count * d.getNumGpuMultiProcessors(),
                          DivUp(work_element_count, fixed_block_size));
 
@@ -310,10 +400,20 @@ Gpu3DLaunchConfig GetGpu3DLaunchConfig(int xdim, int ydim, int zdim,
   int thread_per_block = 0;
 
 #if GOOGLE_CUDA
-  cudaError_t err = cudaOccupancyMaxPotentialBlockSize(
-      &block_count, &thread_per_block, func, dynamic_shared_memory_size,
-      block_size_limit);
-  CHECK_EQ(err, cudaSuccess);
+  internal::OccupancyCache* cache = internal::OccupancyCache::Global();
+  if (!cache->Lookup(internal::OccupancyCache::kMaxPotentialBlockSize,
+                     reinterpret_cast<const void*>(func), dev,
+                     dynamic_shared_memory_size, block_size_limit, &block_count,
+                     &thread_per_block)) {
+    cudaError_t err = cudaOccupancyMaxPotentialBlockSize(
+        &block_count, &thread_per_block, func, dynamic_shared_memory_size,
+        block_size_limit);
+    CHECK_EQ(err, cudaSuccess);
+    cache->Insert(internal::OccupancyCache::kMaxPotentialBlockSize,
+                  reinterpret_cast<const void*>(func), dev,
+                  dynamic_shared_memory_size, block_size_limit, block_count,
+                  thread_per_block);
+  }
 #elif TENSORFLOW_USE_ROCM
   // ROCM TODO re-enable this after hipOccupancyMaxPotentialBlockSize is
   // implemented
@@ -23,6 +23,7 @@ limitations under the License.
 #include "absl/base/call_once.h"
 #include "absl/synchronization/mutex.h"
 #include "xla/tsl/util/byte_swap_array.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
@@ -46,6 +47,7 @@ limitations under the License.
 #include "tensorflow/core/platform/mem.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/random.h"
+#include "tensorflow/core/platform/snappy.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/stringprintf.h"
 #include "tensorflow/core/platform/tstring.h"
@@ -66,6 +68,9 @@ namespace tensorflow {
 const int kTensorBundleMinProducer = 0;
 const int kTensorBundleMinConsumer = 0;
 const int kTensorBundleVersion = 1;
+// Version declared by bundles that may contain compressed entries (see
+// Options::compress); readers predating compression reject them cleanly.
+const int kTensorBundleCompressedVersion = 2;
 
 // Size of our input buffer for streaming reads
 static const int kBufferSize = 1024 * 1024;
@@ -255,6 +260,122 @@ Status WriteTensor(const Tensor& val, tsl::BufferedWritableFile* out,
   return out->Append(StringPiece(buf, *bytes_written));
 }
 
+// De-interleaves the bytes of "num_elems" elements of width "elem_size" so
+// that the bytes at the same position within an element become contiguous
+// (byte-stream-split).  Floating-point data compresses considerably better
+// in this layout because the exponent bytes form long repetitive runs.
+void ByteStreamSplit(const char* in, size_t num_elems, size_t elem_size,
+                     char* out) {
+  for (size_t b = 0; b < elem_size; ++b) {
+    for (size_t e = 0; e < num_elems; ++e) {
+      out[b * num_elems + e] = in[e * elem_size + b];
+    }
+  }
+}
+
+// Inverse of ByteStreamSplit().
+void ByteStreamJoin(const char* in, size_t num_elems, size_t elem_size,
+                    char* out) {
+  for (size_t b = 0; b < elem_size; ++b) {
+    for (size_t e = 0; e < num_elems; ++e) {
+      out[e * elem_size + b] = in[b * num_elems + e];
+    }
+  }
+}
+
+// The codec used for "dtype" when bundle compression is on.
+// REQUIRES: DataTypeCanUseMemcpy(dtype)
+BundleEntryProto::CompressionCodec CompressionCodecForDtype(DataType dtype) {
+  switch (dtype) {
+    case DT_FLOAT:
+    case DT_DOUBLE:
+    case DT_HALF:
+    case DT_BFLOAT16:
+      return BundleEntryProto::BYTE_SPLIT_SNAPPY;
+    default:
+      return BundleEntryProto::SNAPPY;
+  }
+}
+
+// Compresses and serializes the data bytes of the non-string tensor "val",
+// recording the codec and the raw byte count in "*entry".  Falls back to
+// WriteTensor() (leaving the codec as NONE) when compression does not
+// shrink the bytes.  "bytes_written" is treated as in WriteTensor().
+// REQUIRES: DataTypeCanUseMemcpy(val.dtype())
+Status WriteCompressedTensor(const Tensor& val, tsl::BufferedWritableFile* out,
+                             BundleEntryProto* entry, size_t* bytes_written) {
+  const size_t num_bytes = val.TotalBytes();
+  const char* buf = GetBackingBuffer(val);
+  const BundleEntryProto::CompressionCodec codec =
+      CompressionCodecForDtype(val.dtype());
+  string split;  // Only used for BYTE_SPLIT_SNAPPY.
+  const char* to_compress = buf;
+  if (codec == BundleEntryProto::BYTE_SPLIT_SNAPPY && num_bytes > 0) {
+    const size_t elem_size = DataTypeSize(val.dtype());
+    split.resize(num_bytes);
+    ByteStreamSplit(buf, num_bytes / elem_size, elem_size, &split[0]);
+    to_compress = split.data();
+  }
+  string compressed;
+  if (!port::Snappy_Compress(to_compress, num_bytes, &compressed) ||
+      compressed.size() >= num_bytes) {
+    return WriteTensor(val, out, bytes_written);
+  }
+  entry->set_codec(codec);
+  entry->set_uncompressed_size(num_bytes);
+  *bytes_written = compressed.size();
+  VLOG(1) << "Appending " << *bytes_written << " compressed bytes to file ("
+          << num_bytes << " raw)";
+  return out->Append(compressed);
+}
+
+// Reads the compressed bytes of "entry" from "buffered_file" (already
+// positioned at entry.offset()) and decompresses them into "ret"'s backing
+// buffer.  "*actual_crc32c" is computed over the compressed bytes as they
+// appear in the file.
+// REQUIRES: DataTypeCanUseMemcpy(entry.dtype()) and a codec other than NONE
+Status ReadCompressedTensor(io::InputBuffer* buffered_file,
+                            const BundleEntryProto& entry, Tensor* ret,
+                            uint32* actual_crc32c) {
+  string compressed(entry.size(), '\0');
+  size_t unused_bytes_read;
+  TF_RETURN_IF_ERROR(
+      buffered_file->ReadNBytes(entry.size(), &compressed[0],
+                                &unused_bytes_read));
+  *actual_crc32c = crc32c::Value(compressed.data(), compressed.size());
+
+  const size_t raw_size = ret->TotalBytes();
+  size_t uncompressed_length = 0;
+  if (!port::Snappy_GetUncompressedLength(compressed.data(), compressed.size(),
+                                          &uncompressed_length) ||
+      uncompressed_length != raw_size) {
+    return errors::DataLoss("Invalid compressed bundle entry: uncompressed ",
+                            "length ", uncompressed_length, "; expected ",
+                            raw_size);
+  }
+  char* backing_buffer = const_cast<char*>(ret->tensor_data().data());
+  if (entry.codec() == BundleEntryProto::SNAPPY) {
+    if (!port::Snappy_Uncompress(compressed.data(), compressed.size(),
+                                 backing_buffer)) {
+      return errors::DataLoss("Snappy decompression failed");
+    }
+    return absl::OkStatus();
+  }
+  if (entry.codec() != BundleEntryProto::BYTE_SPLIT_SNAPPY) {
+    return errors::Unimplemented("Unsupported bundle compression codec: ",
+                                 entry.codec());
+  }
+  string split(raw_size, '\0');
+  if (!port::Snappy_Uncompress(compressed.data(), compressed.size(),
+                               &split[0])) {
+    return errors::DataLoss("Snappy decompression failed");
+  }
+  const size_t elem_size = DataTypeSize(ret->dtype());
+  ByteStreamJoin(split.data(), raw_size / elem_size, elem_size,
+                 backing_buffer);
+  return absl::OkStatus();
+}
+
 // Serializes string tensor "val".  "bytes_written" is treated in the same
 // fashion as WriteTensor().
 //
@@ -428,6 +549,12 @@ Status PadAlignment(tsl::BufferedWritableFile* out, int alignment,
 
 BundleWriter::BundleWriter(Env* env, StringPiece prefix, const Options& options)
     : env_(env), options_(options), prefix_(prefix), out_(nullptr), size_(0) {
+  if (!options_.compress) {
+    bool compress_env = false;
+    Status s = ReadBoolFromEnvVar("TF_TENSOR_BUNDLE_COMPRESS",
+                                  /*default_val=*/false, &compress_env);
+    options_.compress = s.ok() && compress_env;
+  }
   status_ = env_->HasAtomicMove(prefix_, &use_temp_file_);
   if (!status_.ok()) return;
 
@@ -476,6 +603,10 @@ Status BundleWriter::Add(StringPiece key, const Tensor& val) {
     status_ = WriteStringTensor(val, out_.get(), &data_bytes_written, &crc32c);
   } else if (val.dtype() == DT_VARIANT) {
     status_ = WriteVariantTensor(val, out_.get(), &data_bytes_written, &crc32c);
+  } else if (options_.compress) {
+    status_ =
+        WriteCompressedTensor(val, out_.get(), entry, &data_bytes_written);
+    crc32c = out_->crc32();
   } else {
     status_ = WriteTensor(val, out_.get(), &data_bytes_written);
     crc32c = out_->crc32();
@@ -563,8 +694,16 @@ Status BundleWriter::Finish() {
     header.set_endianness(BundleHeaderProto::LITTLE);
     if (!port::kLittleEndian) header.set_endianness(BundleHeaderProto::BIG);
     VersionDef* version = header.mutable_version();
-    version->set_producer(kTensorBundleVersion);
-    version->set_min_consumer(kTensorBundleMinConsumer);
+    if (options_.compress) {
+      // Declared for all compressing writers, not per actual entry, so that
+      // the shards of a sharded save carry identical versions and can be
+      // merged by MergeBundles().
+      version->set_producer(kTensorBundleCompressedVersion);
+      version->set_min_consumer(kTensorBundleCompressedVersion);
+    } else {
+      version->set_producer(kTensorBundleVersion);
+      version->set_min_consumer(kTensorBundleMinConsumer);
+    }
 
     builder.Add(kHeaderEntryKey, header.SerializeAsString());
 
@@ -785,7 +924,14 @@ BundleReader::BundleReader(Env* env, StringPiece prefix, Options options)
       iter_(nullptr),
       need_to_swap_bytes_(false),
       enable_multi_threading_for_testing_(
-          options.enable_multi_threading_for_testing) {
+          options.enable_multi_threading_for_testing),
+      use_mmap_(options.use_mmap) {
+  if (!use_mmap_) {
+    bool mmap_env = false;
+    Status s = ReadBoolFromEnvVar("TF_TENSOR_BUNDLE_MMAP_RESTORE",
+                                  /*default_val=*/false, &mmap_env);
+    use_mmap_ = s.ok() && mmap_env;
+  }
   if (cache_ == nullptr) {
     // Make a cache for use just by this BundleReader.
     owned_cache_ = std::make_unique<BundleCache>(env);
@@ -835,7 +981,7 @@ BundleReader::BundleReader(Env* env, StringPiece prefix, Options options)
        !port::kLittleEndian)) {
     need_to_swap_bytes_ = true;
   }
-  status_ = CheckVersions(header.version(), kTensorBundleVersion,
+  status_ = CheckVersions(header.version(), kTensorBundleCompressedVersion,
                           kTensorBundleMinProducer, "Checkpoint", "checkpoint");
 }
 
@@ -877,6 +1023,46 @@ Status BundleReader::GetBundleEntryProto(StringPiece key,
   return absl::OkStatus();
 }
 
+namespace {
+
+// Tensor buffer backed by a slice of a memory-mapped bundle data file. The
+// mapping is shared by every tensor adopted from the same shard and is
+// unmapped when the reader and the last such tensor are gone.
+class MmapTensorBuffer : public TensorBuffer {
+ public:
+  MmapTensorBuffer(std::shared_ptr<ReadOnlyMemoryRegion> region, void* data,
+                   size_t size)
+      : TensorBuffer(data), region_(std::move(region)), size_(size) {}
+
+  size_t size() const override { return size_; }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(size_);
+    proto->set_allocated_bytes(size_);
+    proto->set_allocator_name("mmap");
+  }
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  std::shared_ptr<ReadOnlyMemoryRegion> region_;
+  size_t size_;
+};
+
+}  // namespace
+
+Status BundleReader::GetMmapRegion(
+    int32_t shard_id, std::shared_ptr<ReadOnlyMemoryRegion>* region) {
+  auto it = mmap_regions_.find(shard_id);
+  if (it == mmap_regions_.end()) {
+    std::unique_ptr<ReadOnlyMemoryRegion> mapped;
+    TF_RETURN_IF_ERROR(env_->NewReadOnlyMemoryRegionFromFile(
+        DataFilename(prefix_, shard_id, num_shards_), &mapped));
+    it = mmap_regions_.emplace(shard_id, std::move(mapped)).first;
+  }
+  *region = it->second;
+  return absl::OkStatus();
+}
+
 Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
   Tensor* ret = val;
   const TensorShape stored_shape(TensorShape(entry.shape()));
@@ -884,12 +1070,16 @@ Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
     ret = new Tensor(entry.dtype(), stored_shape);
   }
 
-  // Validates the "size" field.
+  // Validates the "size" field.  For compressed entries, "size" is the
+  // compressed extent; the raw byte count is in "uncompressed_size".
   if (entry.dtype() != DT_STRING && entry.dtype() != DT_VARIANT) {
-    if (entry.size() != ret->TotalBytes()) {
+    const int64_t raw_size = entry.codec() == BundleEntryProto::NONE
+                                 ? entry.size()
+                                 : entry.uncompressed_size();
+    if (raw_size != ret->TotalBytes()) {
       return errors::DataLoss("Invalid size in bundle entry: key ", key(),
-                              "; stored size ", entry.size(),
-                              "; expected size ", ret->TotalBytes());
+                              "; stored size ", raw_size, "; expected size ",
+                              ret->TotalBytes());
     }
   } else if (entry.dtype() == DT_STRING) {
     // Relaxes the check for string tensors as follows:
@@ -906,6 +1096,46 @@ Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
     }
   }
 
+  // In mmap mode, adopt suitably aligned uncompressed tensor bytes directly
+  // from the mapped data file instead of copying them into a fresh
+  // allocation. Only possible when the caller did not pre-allocate `val`
+  // (ret is then owned by us and can be replaced). Misaligned entries,
+  // byte-swapped bundles, and string/variant tensors fall through to the
+  // copying path below.
+  if (use_mmap_ && ret != val && DataTypeCanUseMemcpy(entry.dtype()) &&
+      entry.codec() == BundleEntryProto::NONE && !need_to_swap_bytes_ &&
+      entry.size() > 0) {
+    std::shared_ptr<ReadOnlyMemoryRegion> region;
+    Status mmap_status = GetMmapRegion(entry.shard_id(), &region);
+    if (!mmap_status.ok()) {
+      // The file system does not support mapping; stop trying.
+      VLOG(1) << "Disabling mmap restore for bundle " << prefix_ << ": "
+              << mmap_status;
+      use_mmap_ = false;
+    } else if (entry.offset() + entry.size() <= region->length()) {
+      char* data =
+          const_cast<char*>(static_cast<const char*>(region->data())) +
+          entry.offset();
+      if (reinterpret_cast<uintptr_t>(data) % Allocator::kAllocatorAlignment ==
+          0) {
+        const uint32 mapped_crc32c = crc32c::Value(data, entry.size());
+        if (crc32c::Unmask(entry.crc32c()) != mapped_crc32c) {
+          return errors::DataLoss(
+              "TensorBundle at ", prefix_, " shard ", entry.shard_id(), " (",
+              entry.size(), " bytes): Checksum does not match: stored ",
+              strings::Printf("%08u", crc32c::Unmask(entry.crc32c())),
+              " vs. calculated on the mapped bytes ", mapped_crc32c);
+        }
+        auto* buf =
+            new MmapTensorBuffer(std::move(region), data, entry.size());
+        delete ret;
+        *val = Tensor(entry.dtype(), stored_shape, buf);
+        buf->Unref();
+        return absl::OkStatus();
+      }
+    }
+  }
+
   // Open the data file if it has not been opened.
   io::InputBuffer* buffered_file = data_[entry.shard_id()];
   if (buffered_file == nullptr) {
@@ -920,7 +1150,16 @@ Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
   TF_RETURN_IF_ERROR(buffered_file->Seek(entry.offset()));
   uint32 actual_crc32c = 0;
 
-  if (DataTypeCanUseMemcpy(entry.dtype())) {
+  if (DataTypeCanUseMemcpy(entry.dtype()) &&
+      entry.codec() != BundleEntryProto::NONE) {
+    TF_RETURN_IF_ERROR(
+        ReadCompressedTensor(buffered_file, entry, ret, &actual_crc32c));
+    // As in the raw path, the checksum covers the bytes in file order, so
+    // byte-swapping happens after it has been computed.
+    if (need_to_swap_bytes_) {
+      TF_RETURN_IF_ERROR(ByteSwapTensor(ret));
+    }
+  } else if (DataTypeCanUseMemcpy(entry.dtype())) {
     char* backing_buffer = const_cast<char*>((ret->tensor_data().data()));
     size_t unused_bytes_read;
     if (entry.size() > kBufferSize || enable_multi_threading_for_testing_) {
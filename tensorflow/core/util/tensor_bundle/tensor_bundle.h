@@ -101,6 +101,7 @@ namespace tensorflow {
 extern const int kTensorBundleMinProducer;
 extern const int kTensorBundleMinConsumer;
 extern const int kTensorBundleVersion;
+extern const int kTensorBundleCompressedVersion;
 
 // The empty string, hence always the first key in the metadata table.  Its
 // corresponding value is a BundleHeaderProto.
@@ -119,6 +120,15 @@ class BundleWriter {
     // Alignment, in bytes, for tensor data.
     // Must be >= 1. The default size of 1 densely packs tensors.
     int data_alignment{1};
+
+    // If true, tensor data is compressed, with a codec chosen per dtype
+    // (floating-point dtypes are byte-stream-split before snappy; other
+    // plain-old-data dtypes use plain snappy; strings and variants are
+    // stored raw).  Entries that do not shrink are stored raw as well.
+    // Bundles with compressed entries require a reader that understands
+    // them; older readers reject them with a version error.  Can also be
+    // turned on for all writers with TF_TENSOR_BUNDLE_COMPRESS=true.
+    bool compress = false;
   };
   BundleWriter(Env* env, absl::string_view prefix,
                const Options& options = Options());
@@ -154,7 +164,7 @@ class BundleWriter {
 
  private:
   Env* const env_;  // Not owned.
-  const Options options_;
+  Options options_;  // Not const: compress can be enabled by environment.
   const std::string prefix_;
   std::string metadata_path_;
   std::string data_path_;
@@ -212,6 +222,16 @@ class BundleReader {
 
     // For tests only.
     bool enable_multi_threading_for_testing = false;
+
+    // If true, memory-maps the bundle's data files and, where possible,
+    // adopts suitably aligned uncompressed tensor bytes directly from the
+    // mapping instead of copying them into fresh allocations. Restored
+    // tensors then share pages with other processes reading the same
+    // checkpoint, and no anonymous memory is allocated for them. Entries
+    // that cannot be mapped (strings, variants, misaligned data, or
+    // byte-swapped bundles) fall back to the copying path. Can also be
+    // turned on for all readers with TF_TENSOR_BUNDLE_MMAP_RESTORE=true.
+    bool use_mmap = false;
   };
   BundleReader(Env* env, absl::string_view prefix, Options options);
 
@@ -308,6 +328,12 @@ class BundleReader {
   // REQUIRES: status().ok() && Valid()
   absl::string_view value() const { return iter_->value(); }
 
+  // Whether this reader adopts tensor data from memory-mapped data files
+  // when possible (see Options::use_mmap). Callers that pre-allocate the
+  // destination tensor can skip that allocation when this returns true and
+  // let Lookup() produce the tensor instead.
+  bool use_mmap() const { return use_mmap_; }
+
   std::string DebugString();
 
  private:
@@ -341,9 +367,20 @@ class BundleReader {
   table::Cache* index_cache_;
   table::Iterator* iter_;
 
+  // Returns the (possibly cached) memory mapping of the given data file
+  // shard. Only used when use_mmap_ is set.
+  Status GetMmapRegion(int32_t shard_id,
+                       std::shared_ptr<ReadOnlyMemoryRegion>* region)
+      TF_MUST_USE_RESULT;
+
   // Owned InputBuffer objects. cache_ owns the underlying RandomAccessFiles.
   std::unordered_map<int32_t, io::InputBuffer*> data_;
 
+  // Memory mappings of the data file shards, shared with the buffers of the
+  // tensors adopted from them. Only populated when use_mmap_ is set.
+  std::unordered_map<int32_t, std::shared_ptr<ReadOnlyMemoryRegion>>
+      mmap_regions_;
+
   // Maps each partitioned tensor's key to its stored slices (represented in a
   // TensorSliceSet).  Populated on-demand.
   std::unordered_map<std::string, checkpoint::TensorSliceSet*> tensor_slices_;
@@ -360,6 +397,10 @@ class BundleReader {
 
   bool enable_multi_threading_for_testing_ = false;
 
+  // Whether to adopt tensor data from memory-mapped data files. Cleared if
+  // the underlying file system does not support memory mapping.
+  bool use_mmap_ = false;
+
   BundleReader(const BundleReader&) = delete;
   void operator=(const BundleReader&) = delete;
 };
@@ -24,6 +24,7 @@ limitations under the License.
 #endif  // _WIN32
 
 #include "absl/status/status.h"
+#include "tensorflow/core/framework/tensor_description.pb.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/framework/types.pb.h"
@@ -557,6 +558,67 @@ TEST(TensorBundleTest, Basic) {
   TestBasic<bfloat16>();
 }
 
+TEST(TensorBundleTest, CompressedRoundtrip) {
+  {
+    BundleWriter::Options options;
+    options.compress = true;
+    BundleWriter writer(Env::Default(), Prefix("compressed"), options);
+    TF_EXPECT_OK(writer.Add("floats", Constant_100x100<float>(3.f)));
+    TF_EXPECT_OK(writer.Add("ints", Constant_100x100<int32>(7)));
+    TF_EXPECT_OK(
+        writer.Add("strings", test::AsTensor<tstring>({"hello", "world"})));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  // Constant tensors compress well; the data file must be far smaller than
+  // the raw float and int32 bytes.
+  uint64 data_file_size = 0;
+  TF_ASSERT_OK(Env::Default()->GetFileSize(
+      DataFilename(Prefix("compressed"), 0, 1), &data_file_size));
+  EXPECT_LT(data_file_size, 2 * 100 * 100 * sizeof(float) / 10);
+
+  BundleReader reader(Env::Default(), Prefix("compressed"));
+  TF_ASSERT_OK(reader.status());
+  Expect<float>(&reader, "floats", Constant_100x100<float>(3.f));
+  Expect<int32>(&reader, "ints", Constant_100x100<int32>(7));
+  Expect<tstring>(&reader, "strings",
+                  test::AsTensor<tstring>({"hello", "world"}));
+}
+
+TEST(TensorBundleTest, MmapRestore) {
+  {
+    BundleWriter writer(Env::Default(), Prefix("mmap"));
+    TF_EXPECT_OK(writer.Add("floats", Constant_2x3(3.f)));
+    TF_EXPECT_OK(
+        writer.Add("strings", test::AsTensor<tstring>({"hello", "world"})));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  BundleReader::Options options;
+  options.use_mmap = true;
+  BundleReader reader(Env::Default(), Prefix("mmap"), options);
+  TF_ASSERT_OK(reader.status());
+  EXPECT_TRUE(reader.use_mmap());
+
+  // An empty destination adopts the mapped bytes directly; the first entry
+  // in the shard starts at offset 0 and is therefore aligned.
+  Tensor val;
+  TF_ASSERT_OK(reader.Lookup("floats", &val));
+  test::ExpectTensorEqual<float>(val, Constant_2x3(3.f));
+  TensorDescription desc;
+  val.FillDescription(&desc);
+  EXPECT_EQ(desc.allocation_description().allocator_name(), "mmap");
+
+  // String tensors fall back to the copying path.
+  Tensor strings;
+  TF_ASSERT_OK(reader.Lookup("strings", &strings));
+  test::ExpectTensorEqual<tstring>(
+      strings, test::AsTensor<tstring>({"hello", "world"}));
+
+  // A pre-allocated destination is filled in place as before.
+  Tensor preallocated(DT_FLOAT, TensorShape({2, 3}));
+  TF_ASSERT_OK(reader.Lookup("floats", &preallocated));
+  test::ExpectTensorEqual<float>(preallocated, Constant_2x3(3.f));
+}
+
 TEST(TensorBundleTest, Endianness) {
   TestEndianness<float>();
   TestEndianness<double>();
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "xla/tsl/util/env_var.h"
 #include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/env_time.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tsl/profiler/lib/traceme.h"
 
@@ -43,6 +44,48 @@ bool UseEigenParallelFor() {
   return result;
 }
 
+// Same shard-size computation as Sharder::Do, but publishes all shards to
+// the pool through ThreadPool::ScheduleWorkItems, so the per-Schedule cost
+// is paid once per participating worker rather than once per shard.
+void ShardWithBulkSchedule(int64_t total, int64_t cost_per_unit,
+                           const Sharder::Work& work,
+                           thread::ThreadPool* workers, int max_parallelism) {
+  tsl::profiler::TraceMe trace_me([=]() {
+    return tsl::profiler::TraceMeEncode("ShardWithBulkSchedule",
+                                        {{"cost_per_unit", cost_per_unit},
+                                         {"total", total},
+                                         {"max_parallelism", max_parallelism}});
+  });
+  cost_per_unit = std::max(int64_t{1}, cost_per_unit);
+  // See Sharder::Do for the reasoning behind the shard-count heuristics.
+  static const int64_t kMinCostPerShard = 10000;
+  const int num_shards =
+      std::max<int>(1, std::min(static_cast<int64_t>(max_parallelism),
+                                total * cost_per_unit / kMinCostPerShard));
+  const int64_t block_size = (total + num_shards - 1) / num_shards;
+  CHECK_GT(block_size, 0);  // total > 0 guarantees this.
+  if (block_size >= total) {
+    work(0, total);
+    return;
+  }
+  // The 1st shard is done by the caller thread, the rest are claimed from a
+  // shared counter by at most max_parallelism - 1 pool threads.
+  const int num_shards_used = (total + block_size - 1) / block_size;
+  BlockingCounter counter(num_shards_used - 1);
+  workers->ScheduleWorkItems(
+      num_shards_used - 1, max_parallelism - 1,
+      [&work, &counter, block_size, total](int64_t shard_index) {
+        const int64_t start = block_size * (shard_index + 1);
+        const int64_t limit = std::min(start + block_size, total);
+        work(start, limit);        // Compute the shard.
+        counter.DecrementCount();  // The shard is done.
+      });
+
+  // Inline execute the 1st shard.
+  work(0, std::min(block_size, total));
+  counter.Wait();
+}
+
 }  // namespace
 
 /* ABSL_CONST_INIT */ thread_local int per_thread_max_parallelism = 1000000;
@@ -77,10 +120,29 @@ void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
     workers->ParallelFor(total, cost_per_unit, work);
     return;
   }
-  Sharder::Do(
-      total, cost_per_unit, work,
-      [&workers](Sharder::Closure c) { workers->Schedule(c); },
-      max_parallelism);
+  ShardWithBulkSchedule(total, cost_per_unit, work, workers, max_parallelism);
+}
+
+void ShardingCostEstimator::Record(int64_t units, int64_t elapsed_ns) {
+  if (units <= 0) return;
+  const int64_t measured = std::max(int64_t{1}, elapsed_ns / units);
+  const int64_t old = cost_per_unit_.load(std::memory_order_relaxed);
+  // Racing updates may drop a sample; the estimate still converges.
+  cost_per_unit_.store(old == 0 ? measured : (3 * old + measured) / 4,
+                       std::memory_order_relaxed);
+}
+
+void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
+           ShardingCostEstimator* cost, int64_t initial_cost_per_unit,
+           const std::function<void(int64_t, int64_t)>& work) {
+  Shard(max_parallelism, workers, total,
+        cost->EstimatedCostPerUnit(initial_cost_per_unit),
+        [cost, &work](int64_t start, int64_t limit) {
+          const uint64 start_ns = EnvTime::NowNanos();
+          work(start, limit);
+          cost->Record(limit - start,
+                       static_cast<int64_t>(EnvTime::NowNanos() - start_ns));
+        });
 }
 
 // DEPRECATED: Prefer threadpool->ParallelFor with SchedulingStrategy, which
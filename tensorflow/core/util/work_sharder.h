@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_UTIL_WORK_SHARDER_H_
 #define TENSORFLOW_CORE_UTIL_WORK_SHARDER_H_
 
+#include <atomic>
 #include <functional>
 
 #include "tensorflow/core/lib/core/threadpool.h"
@@ -59,6 +60,43 @@ namespace tensorflow {
 void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
            int64_t cost_per_unit, std::function<void(int64_t, int64_t)> work);
 
+// Learns the per-unit cost of a Shard() callsite from measured shard
+// execution times, replacing a caller-provided cost-per-unit guess. Define
+// one static instance per callsite so the learned value persists for the
+// lifetime of the process:
+//
+//   static ShardingCostEstimator* cost = new ShardingCostEstimator;
+//   Shard(max_parallelism, workers, total, cost, initial_cost_per_unit,
+//         work);
+//
+// Thread-safe. The estimate is an exponential moving average of the
+// measured nanoseconds per unit, so shard counts converge within a few
+// calls even when the initial guess is off by orders of magnitude.
+class ShardingCostEstimator {
+ public:
+  // Returns the learned cost estimate in nanoseconds per unit, or
+  // `initial_cost_per_unit` if nothing has been measured yet.
+  int64_t EstimatedCostPerUnit(int64_t initial_cost_per_unit) const {
+    const int64_t learned = cost_per_unit_.load(std::memory_order_relaxed);
+    return learned > 0 ? learned : initial_cost_per_unit;
+  }
+
+  // Records that `units` units of work took `elapsed_ns` nanoseconds.
+  void Record(int64_t units, int64_t elapsed_ns);
+
+ private:
+  std::atomic<int64_t> cost_per_unit_{0};
+};
+
+// Same as Shard() above, but derives cost_per_unit from `cost`, a
+// per-callsite estimator updated with the measured execution time of every
+// shard. `initial_cost_per_unit` seeds the first call, before any
+// measurements exist. `cost` must outlive the call; a static instance per
+// callsite is the intended usage.
+void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
+           ShardingCostEstimator* cost, int64_t initial_cost_per_unit,
+           const std::function<void(int64_t, int64_t)>& work);
+
 // Each thread has an associated option to express the desired maximum
 // parallelism. Its default is a very large quantity.
 //
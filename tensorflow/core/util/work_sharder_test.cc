@@ -79,6 +79,31 @@ TEST(Shard, Basic) {
   }
 }
 
+TEST(Shard, Adaptive) {
+  thread::ThreadPool threads(Env::Default(), "test", 16);
+  ShardingCostEstimator cost;
+  // The initial guess is off by orders of magnitude; the estimator should
+  // learn a positive per-unit cost from the measured shards while the work
+  // itself is still executed exactly once per unit.
+  for (int iter = 0; iter < 4; ++iter) {
+    constexpr int64_t kTotal = 1000;
+    mutex mu;
+    int64_t num_done_work = 0;
+    std::vector<bool> work(kTotal, false);
+    Shard(4, &threads, kTotal, &cost, /*initial_cost_per_unit=*/1000000,
+          [&mu, &num_done_work, &work](int64_t start, int64_t limit) {
+            mutex_lock l(mu);
+            for (; start < limit; ++start) {
+              EXPECT_FALSE(work[start]);  // No duplicate
+              ++num_done_work;
+              work[start] = true;
+            }
+          });
+    EXPECT_EQ(num_done_work, kTotal);
+    EXPECT_GT(cost.EstimatedCostPerUnit(/*initial_cost_per_unit=*/0), 0);
+  }
+}
+
 TEST(Shard, OverflowTest) {
   thread::ThreadPool threads(Env::Default(), "test", 3);
   for (auto workers : {1, 2, 3}) {
@@ -51,6 +51,21 @@ StatusOr<const mlir::Value> EmitAllScatter(
     const Layout& original_layout, const Layout& desired_layout,
     llvm::SmallPtrSet<mlir::Operation*, 4>* newly_created_ops = nullptr);
 
+// Returns true if the relayout from `src_layout` to `tgt_layout` can be
+// performed by a single all-to-all, i.e. one tensor dimension is becoming
+// more sharded while another is becoming less sharded on the same mesh
+// dimension.
+bool CanUseAllToAll(const dtensor::Layout& src_layout,
+                    const dtensor::Layout& tgt_layout);
+
+// Emits an all-to-all collective to convert `input` from `src_layout` to
+// `tgt_layout`. The layouts must satisfy CanUseAllToAll. `input` must have
+// static shapes.
+StatusOr<mlir::Value> EmitAllToAll(
+    mlir::OpBuilder& builder, mlir::Value input,
+    const dtensor::Layout& src_layout, const dtensor::Layout& tgt_layout,
+    llvm::SmallPtrSet<mlir::Operation*, 4>* newly_created_ops = nullptr);
+
 // Emits splits and calls EmitAllGather (once) to relayout from the src layout
 // to the tgt layout on a single mesh.
 // Shape of input is expected to be the local shape for src_layout.
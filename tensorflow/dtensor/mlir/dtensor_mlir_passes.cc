@@ -226,6 +226,12 @@ void CreateDTensorMLIRPass(const mlir::TF::StandardPipelineOptions &options,
   // const only had one usage) as part of layout propagation.
   pm->addPass(mlir::createCSEPass());
 
+  // Fuses or eliminates adjacent relayout collectives, e.g. an AllGather
+  // followed by an AllScatter inserted at consecutive op boundaries. This
+  // must run before the AllGather collectives are lowered away.
+  pm->addNestedPass<mlir::func::FuncOp>(
+      CreateDTensorRelayoutFusionOptimization());
+
   // Lower the AllGather collectives. This has to happen before the all reduce
   // optimizations and AllGather may emit an AllReduce.
   pm->addPass(CreateDTensorAllGatherLoweringPass());
@@ -0,0 +1,199 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <memory>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "llvm/ADT/STLExtras.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"  // from @llvm-project
+#include "mlir/IR/Builders.h"  // from @llvm-project
+#include "mlir/IR/Operation.h"  // from @llvm-project
+#include "mlir/IR/Value.h"  // from @llvm-project
+#include "mlir/IR/Visitors.h"  // from @llvm-project
+#include "mlir/Pass/Pass.h"  // from @llvm-project
+#include "mlir/Support/LLVM.h"  // from @llvm-project
+#include "mlir/Support/LogicalResult.h"  // from @llvm-project
+#include "tensorflow/dtensor/cc/dstatus.h"
+#include "tensorflow/dtensor/cc/tensor_layout.h"
+#include "tensorflow/dtensor/mlir/collectives.h"
+#include "tensorflow/dtensor/mlir/ir/tf_dtensor.h"
+
+namespace tensorflow {
+namespace dtensor {
+
+namespace {
+#define GEN_PASS_DEF_DTENSORRELAYOUTFUSIONOPTIMIZATION
+#include "tensorflow/dtensor/mlir/dtensor_passes.h.inc"
+
+// Extracts the input and output layouts if `op` is a relayout collective
+// (DTensorAllGather or DTensorAllScatter). Returns false otherwise.
+bool GetRelayoutLayouts(mlir::Operation* op, Layout* input_layout,
+                        Layout* output_layout) {
+  if (auto all_gather = mlir::dyn_cast<mlir::TF::DTensorAllGatherOp>(op)) {
+    *input_layout = all_gather.getInputLayout();
+    *output_layout = all_gather.getOutputLayout();
+    return true;
+  }
+  if (auto all_scatter = mlir::dyn_cast<mlir::TF::DTensorAllScatterOp>(op)) {
+    *input_layout = all_scatter.getInputLayout();
+    *output_layout = all_scatter.getOutputLayout();
+    return true;
+  }
+  return false;
+}
+
+// How a composed relayout from `src` to `tgt` can be emitted as a single op.
+enum class RelayoutKind {
+  kIdentity,    // `src` and `tgt` are the same layout; no collective needed.
+  kAllGather,   // Every changed dimension becomes less sharded.
+  kAllScatter,  // Every changed dimension becomes more sharded.
+  kAllToAll,    // One mesh dimension moves from one tensor axis to another.
+  kUnsupported,
+};
+
+RelayoutKind ClassifyRelayout(const Layout& src, const Layout& tgt) {
+  if (src.rank() != tgt.rank() || !(src.mesh() == tgt.mesh()))
+    return RelayoutKind::kUnsupported;
+
+  bool gathers = false;
+  bool scatters = false;
+  for (int i = 0; i < src.rank(); ++i) {
+    if (src.sharding_spec(i) == tgt.sharding_spec(i)) continue;
+    if (Layout::IsShardedDimension(src.sharding_spec(i)) &&
+        Layout::IsUnshardedDimension(tgt.sharding_spec(i))) {
+      gathers = true;
+    } else if (Layout::IsUnshardedDimension(src.sharding_spec(i)) &&
+               Layout::IsShardedDimension(tgt.sharding_spec(i))) {
+      scatters = true;
+    } else {
+      // The dimension is sharded on different mesh dimensions in `src` and
+      // `tgt`; no single relayout collective expresses this.
+      return RelayoutKind::kUnsupported;
+    }
+  }
+  if (!gathers && !scatters) return RelayoutKind::kIdentity;
+  if (!scatters) return RelayoutKind::kAllGather;
+  if (!gathers) return RelayoutKind::kAllScatter;
+  if (CanUseAllToAll(src, tgt)) return RelayoutKind::kAllToAll;
+  return RelayoutKind::kUnsupported;
+}
+
+// Replaces `consumer(producer(x))`, a pair of adjacent relayout collectives
+// where `producer`'s only use is `consumer`, with a single relayout from
+// `producer`'s input layout directly to `consumer`'s output layout. The
+// common case is an AllGather followed by an AllScatter inserted at
+// consecutive op boundaries: the pair either cancels out completely, folds
+// into a cheaper single collective, or becomes an AllToAll when one mesh
+// dimension simply moves to a different tensor axis.
+mlir::LogicalResult ApplyOptimization(mlir::func::FuncOp function) {
+  std::vector<mlir::Operation*> ops_to_delete;
+  function.walk([&](mlir::Operation* op) {
+    Layout consumer_input_layout;
+    Layout consumer_output_layout;
+    if (!GetRelayoutLayouts(op, &consumer_input_layout,
+                            &consumer_output_layout))
+      return;
+
+    mlir::Operation* producer = op->getOperand(0).getDefiningOp();
+    if (!producer || !producer->hasOneUse()) return;
+    if (llvm::is_contained(ops_to_delete, producer)) return;
+
+    Layout producer_input_layout;
+    Layout producer_output_layout;
+    if (!GetRelayoutLayouts(producer, &producer_input_layout,
+                            &producer_output_layout))
+      return;
+    // The layouts at the shared edge must agree, otherwise the composition
+    // below is not meaningful.
+    if (!(producer_output_layout == consumer_input_layout)) return;
+
+    const Layout& src_layout = producer_input_layout;
+    const Layout& tgt_layout = consumer_output_layout;
+    const RelayoutKind kind = ClassifyRelayout(src_layout, tgt_layout);
+    if (kind == RelayoutKind::kUnsupported) return;
+
+    mlir::Value producer_input = producer->getOperand(0);
+    mlir::Value result = op->getResult(0);
+
+    if (kind == RelayoutKind::kIdentity) {
+      if (producer_input.getType() != result.getType()) return;
+      VLOG(2) << "Eliminating relayout pair that composes to the identity.";
+      result.replaceAllUsesWith(producer_input);
+      ops_to_delete.push_back(op);
+      ops_to_delete.push_back(producer);
+      return;
+    }
+
+    mlir::OpBuilder builder(op);
+    StatusOr<mlir::Value> fused;
+    switch (kind) {
+      case RelayoutKind::kAllGather:
+        fused = EmitAllGather(builder, producer_input, src_layout, tgt_layout);
+        break;
+      case RelayoutKind::kAllScatter:
+        fused = EmitAllScatter(builder, producer_input, src_layout, tgt_layout);
+        break;
+      case RelayoutKind::kAllToAll:
+        fused = EmitAllToAll(builder, producer_input, src_layout, tgt_layout);
+        break;
+      default:
+        return;
+    }
+    if (!fused.ok()) {
+      // E.g. the local shape is not static; leave the pair untouched.
+      VLOG(2) << "Could not fuse relayout pair: " << fused.status().message();
+      return;
+    }
+    if (fused->getType() != result.getType()) {
+      if (mlir::Operation* dead = fused->getDefiningOp()) dead->erase();
+      return;
+    }
+
+    VLOG(2) << "Fusing adjacent relayout collectives from "
+            << src_layout.ToString() << " to " << tgt_layout.ToString();
+    result.replaceAllUsesWith(*fused);
+    ops_to_delete.push_back(op);
+    ops_to_delete.push_back(producer);
+  });
+
+  for (mlir::Operation* op : ops_to_delete) {
+    op->erase();
+  }
+  return mlir::success();
+}
+
+// MLIR pass that fuses or eliminates adjacent relayout collectives
+// (AllGather/AllScatter chains) so that consecutive ops with compatible
+// layouts do not round-trip through a full AllGather plus slice.
+struct DTensorRelayoutFusionOptimization
+    : public impl::DTensorRelayoutFusionOptimizationBase<
+          DTensorRelayoutFusionOptimization> {
+  void runOnOperation() override {
+    mlir::func::FuncOp function = getOperation();
+
+    if (mlir::failed(ApplyOptimization(function))) return signalPassFailure();
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+CreateDTensorRelayoutFusionOptimization() {
+  return std::make_unique<DTensorRelayoutFusionOptimization>();
+}
+
+}  // namespace dtensor
+}  // namespace tensorflow
@@ -0,0 +1,76 @@
+// RUN: dtensor-opt %s -split-input-file -dtensor-relayout-fusion-optimization -verify-diagnostics | FileCheck %s
+
+// Adjacent AllGather+AllScatter that compose to the identity are removed.
+
+// CHECK-LABEL: func @all_gather_all_scatter_cancel
+func.func @all_gather_all_scatter_cancel(
+    %arg0: tensor<4x4xf32>) -> tensor<4x4xf32> {
+  // CHECK-NOT:  "tf.DTensorAllGather"
+  // CHECK-NOT:  "tf.DTensorAllScatter"
+  // CHECK:      tf_device.return %arg0
+  %0 = "tf_device.cluster"() ({
+    %1 = "tf.DTensorAllGather"(%arg0) {input_layout = #dtensor.layout<sharding_specs:x,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>, output_layout = #dtensor.layout<sharding_specs:unsharded,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>} : (tensor<4x4xf32>) -> tensor<8x4xf32>
+    %2 = "tf.DTensorAllScatter"(%1) {input_layout = #dtensor.layout<sharding_specs:unsharded,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>, output_layout = #dtensor.layout<sharding_specs:x,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>} : (tensor<8x4xf32>) -> tensor<4x4xf32>
+    tf_device.return %2 : tensor<4x4xf32>
+  }) {_mesh = "TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3"} : () -> tensor<4x4xf32>
+  func.return %0 : tensor<4x4xf32>
+}
+
+// -----
+
+// An AllGather+AllScatter pair that moves one mesh dimension to a different
+// tensor axis becomes a single AllToAll.
+
+// CHECK-LABEL: func @all_gather_all_scatter_to_all_to_all
+func.func @all_gather_all_scatter_to_all_to_all(
+    %arg0: tensor<4x4xf32>) -> tensor<8x2xf32> {
+  // CHECK:      %[[ALL_TO_ALL:.*]] = "tf.DTensorAllToAll"(%arg0)
+  // CHECK-SAME: (tensor<4x4xf32>) -> tensor<8x2xf32>
+  // CHECK-NOT:  "tf.DTensorAllGather"
+  // CHECK-NOT:  "tf.DTensorAllScatter"
+  // CHECK:      tf_device.return %[[ALL_TO_ALL]]
+  %0 = "tf_device.cluster"() ({
+    %1 = "tf.DTensorAllGather"(%arg0) {input_layout = #dtensor.layout<sharding_specs:x,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>, output_layout = #dtensor.layout<sharding_specs:unsharded,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>} : (tensor<4x4xf32>) -> tensor<8x4xf32>
+    %2 = "tf.DTensorAllScatter"(%1) {input_layout = #dtensor.layout<sharding_specs:unsharded,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>, output_layout = #dtensor.layout<sharding_specs:unsharded,x, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>} : (tensor<8x4xf32>) -> tensor<8x2xf32>
+    tf_device.return %2 : tensor<8x2xf32>
+  }) {_mesh = "TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3"} : () -> tensor<8x2xf32>
+  func.return %0 : tensor<8x2xf32>
+}
+
+// -----
+
+// Two consecutive AllGathers collapse into one.
+
+// CHECK-LABEL: func @all_gather_all_gather_fold
+func.func @all_gather_all_gather_fold(
+    %arg0: tensor<4x4xf32>) -> tensor<8x8xf32> {
+  // CHECK:      %[[GATHER:.*]] = "tf.DTensorAllGather"(%arg0)
+  // CHECK-SAME: input_layout = #dtensor.layout<sharding_specs:x,y
+  // CHECK-SAME: output_layout = #dtensor.layout<sharding_specs:unsharded,unsharded
+  // CHECK-SAME: (tensor<4x4xf32>) -> tensor<8x8xf32>
+  // CHECK-NOT:  "tf.DTensorAllGather"
+  // CHECK:      tf_device.return %[[GATHER]]
+  %0 = "tf_device.cluster"() ({
+    %1 = "tf.DTensorAllGather"(%arg0) {input_layout = #dtensor.layout<sharding_specs:x,y, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>, output_layout = #dtensor.layout<sharding_specs:x,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>} : (tensor<4x4xf32>) -> tensor<4x8xf32>
+    %2 = "tf.DTensorAllGather"(%1) {input_layout = #dtensor.layout<sharding_specs:x,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>, output_layout = #dtensor.layout<sharding_specs:unsharded,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>} : (tensor<4x8xf32>) -> tensor<8x8xf32>
+    tf_device.return %2 : tensor<8x8xf32>
+  }) {_mesh = "TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3"} : () -> tensor<8x8xf32>
+  func.return %0 : tensor<8x8xf32>
+}
+
+// -----
+
+// No fusion when the producer has more than one use.
+
+// CHECK-LABEL: func @no_fusion_multiple_uses
+func.func @no_fusion_multiple_uses(
+    %arg0: tensor<4x4xf32>) -> (tensor<8x4xf32>, tensor<4x4xf32>) {
+  // CHECK:      "tf.DTensorAllGather"
+  // CHECK:      "tf.DTensorAllScatter"
+  %0:2 = "tf_device.cluster"() ({
+    %1 = "tf.DTensorAllGather"(%arg0) {input_layout = #dtensor.layout<sharding_specs:x,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>, output_layout = #dtensor.layout<sharding_specs:unsharded,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>} : (tensor<4x4xf32>) -> tensor<8x4xf32>
+    %2 = "tf.DTensorAllScatter"(%1) {input_layout = #dtensor.layout<sharding_specs:unsharded,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>, output_layout = #dtensor.layout<sharding_specs:x,unsharded, mesh:TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3>} : (tensor<8x4xf32>) -> tensor<4x4xf32>
+    tf_device.return %1, %2 : tensor<8x4xf32>, tensor<4x4xf32>
+  }) {_mesh = "TPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:TPU:0,/job:localhost/task:0/device:TPU:1,/job:localhost/task:0/device:TPU:2,/job:localhost/task:0/device:TPU:3"} : () -> (tensor<8x4xf32>, tensor<4x4xf32>)
+  func.return %0#0, %0#1 : tensor<8x4xf32>, tensor<4x4xf32>
+}
@@ -413,7 +413,16 @@ TfLiteStatus ArenaPlanner::AcquireNonPersistentMemory() {
 }
 
 bool ArenaPlanner::HasNonPersistentMemory() {
-  return has_nonpersistent_memory_;
+  // A shared arena buffer may have been reallocated or released by the
+  // planner of another subgraph, in which case the tensor data pointers
+  // resolved against it are no longer valid and the memory must be
+  // re-acquired.
+  return has_nonpersistent_memory_ && arena_.IsBufferCurrent();
+}
+
+void ArenaPlanner::SetSharedArenaBuffer(
+    std::shared_ptr<ResizableAlignedBuffer> buffer) {
+  arena_.SetUnderlyingBuffer(std::move(buffer));
 }
 
 void ArenaPlanner::DumpDebugInfo(const std::vector<int>& execution_plan) const {
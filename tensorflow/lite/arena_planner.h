@@ -30,8 +30,6 @@ limitations under the License.
 
 namespace tflite {
 
-constexpr const int kDefaultArenaAlignment = 64;
-
 // A memory planner that makes all the allocations using arenas.
 //
 // Before a model is executed by the interpreter, this class determines when
@@ -72,6 +70,14 @@ class ArenaPlanner : public MemoryPlanner {
   // Returns the base arena location for a given allocation type.
   std::intptr_t BasePointer(TfLiteAllocationType type);
 
+  // Makes the non-persistent arena allocate from `buffer`, which may be
+  // shared with the planners of other subgraphs that are never in flight at
+  // the same time. When another planner resizes or releases the shared
+  // buffer, this planner reports that it has no non-persistent memory until
+  // its allocations have been committed and resolved again. Must be called
+  // before PlanAllocations().
+  void SetSharedArenaBuffer(std::shared_ptr<ResizableAlignedBuffer> buffer);
+
  private:
   // Check whether the input tensor's memory may be shared the output tensor.
   // tensor_changed: true if the output tensor modifies the tensor data. For
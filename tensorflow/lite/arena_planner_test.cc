@@ -966,6 +966,41 @@ TEST_F(ArenaPlannerTest, ModifiedGraph_DeallocateNonPersistentArena) {
   EXPECT_EQ(GetOffset(3), GetOffsetAfter(1));
 }
 
+TEST_F(ArenaPlannerTest, SharedArenaBufferInvalidation) {
+  TestGraph graph({0, 1},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {2}, {}},     // First op
+                      {{2, 0}, {4, 5}, {}},  // Second op
+                      {{4, 5}, {3}, {}}      // Third op
+                  },
+                  {3});
+  graph_ = &graph;
+  context_.ReportError = ReportError;
+  planner_ = std::make_unique<ArenaPlanner>(
+      &context_, std::unique_ptr<GraphInfo>(new TestGraphInfo(&graph)),
+      /*preserve_all_tensors=*/false, kTensorAlignment);
+  auto shared_buffer =
+      std::make_shared<ResizableAlignedBuffer>(kDefaultArenaAlignment,
+                                               /*subgraph_index=*/0);
+  planner_->SetSharedArenaBuffer(shared_buffer);
+  ASSERT_EQ(planner_->ResetAllocations(), kTfLiteOk);
+  ASSERT_EQ(planner_->PlanAllocations(), kTfLiteOk);
+  Execute(0, graph.nodes().size() - 1);
+  EXPECT_TRUE(HasNonPersistentMemory());
+  EXPECT_FALSE(IsUnallocated(3));
+
+  // Simulate the planner of another subgraph releasing the shared buffer:
+  // this planner must report that its memory is gone, and recover by
+  // re-acquiring it.
+  shared_buffer->Release();
+  EXPECT_FALSE(HasNonPersistentMemory());
+  AcquireNonPersistentMemory();
+  EXPECT_TRUE(HasNonPersistentMemory());
+  EXPECT_FALSE(IsUnallocated(3));
+  EXPECT_EQ(GetOffset(1), 4);
+}
+
 TEST_F(ArenaPlannerTest, ComplexGraph) {
   TestGraph graph({0},
                   {
@@ -41,6 +41,7 @@ limitations under the License.
 #include "tensorflow/lite/profiling/root_profiler.h"
 #include "tensorflow/lite/profiling/telemetry/c/telemetry_setting.h"
 #include "tensorflow/lite/profiling/telemetry/telemetry.h"
+#include "tensorflow/lite/simple_memory_arena.h"
 #include "tensorflow/lite/stderr_reporter.h"
 #include "tensorflow/lite/util.h"
 
@@ -500,6 +501,18 @@ TfLiteStatus Interpreter::ApplyOptionsImpl(InterpreterOptions* options) {
   return kTfLiteOk;
 }
 
+void Interpreter::ShareArenaAcrossSubgraphs(
+    const std::vector<std::vector<int>>& groups) {
+  for (const std::vector<int>& group : groups) {
+    if (group.size() < 2) continue;
+    auto buffer = std::make_shared<ResizableAlignedBuffer>(
+        kDefaultArenaAlignment, group.front());
+    for (int subgraph_index : group) {
+      subgraphs_[subgraph_index]->SetSharedArenaBuffer(buffer);
+    }
+  }
+}
+
 TfLiteStatus Interpreter::EnableCancellation() {
   cancellation_enabled_ = true;
   for (auto& subgraph : subgraphs_) {
@@ -519,6 +532,11 @@ void Interpreter::AddProfiler(std::unique_ptr<Profiler> profiler) {
   SetSubgraphProfiler();
 }
 
+TfLiteStatus Interpreter::EnsureSubgraphBuilt(int subgraph_index) {
+  if (!lazy_subgraph_builder_) return kTfLiteOk;
+  return lazy_subgraph_builder_(subgraph_index);
+}
+
 impl::SignatureRunner* Interpreter::GetSignatureRunner(
     const char* signature_key) {
   auto iter = signature_runner_map_.find(signature_key);
@@ -526,6 +544,14 @@ impl::SignatureRunner* Interpreter::GetSignatureRunner(
     return &(iter->second);
   }
 
+  // Build the signature's subgraphs first if their parsing was deferred, so
+  // the default delegates below also cover them.
+  const int lazy_subgraph_index = GetSubgraphIndexFromSignature(signature_key);
+  if (lazy_subgraph_index >= 0 &&
+      EnsureSubgraphBuilt(lazy_subgraph_index) != kTfLiteOk) {
+    return nullptr;
+  }
+
   // Default delegates are applied once for all subgraphs. Only returns error
   // when the status is kTfLiteError. For other statuses, it will fall back to
   // the default implementation.
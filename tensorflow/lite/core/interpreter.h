@@ -830,6 +830,11 @@ class Interpreter {
   // Applies TFLite default delegates.
   TfLiteStatus ApplyLazyDelegateProviders();
 
+  // Parses `subgraph_index` (and the subgraphs it invokes) if its
+  // construction was deferred by the InterpreterBuilder. No-op when lazy
+  // subgraph building is disabled or the subgraph is already built.
+  TfLiteStatus EnsureSubgraphBuilt(int subgraph_index);
+
   // Private non-experimental implementation of ModifyGraphWithDelegate.
   // Unlike ModifyGraphWithDelegate, ModifyGraphWithDelegateImpl is defined in
   // interpreter.cc rather than in interpreter_experimental.cc, so it can be
@@ -905,6 +910,12 @@ class Interpreter {
 
   TfLiteStatus ApplyOptionsImpl(InterpreterOptions* options);
 
+  // Gives each group of subgraphs in `groups` one shared buffer for their
+  // non-persistent activation tensors. The groups are computed by the
+  // InterpreterBuilder so that the subgraphs of a group are never in flight
+  // at the same time; see InterpreterOptions::SetShareArenaAcrossSubgraphs.
+  void ShareArenaAcrossSubgraphs(const std::vector<std::vector<int>>& groups);
+
   // A pure C data structure used to communicate with the pure C plugin
   // interface. To avoid copying tensor metadata, this is also the definitive
   // structure to store tensors.
@@ -938,6 +949,13 @@ class Interpreter {
   // nullptr if necessary.
   std::unique_ptr<ExternalCpuBackendContext> own_external_cpu_backend_context_;
 
+  // Shared handle to the memory backing the model's constant tensors. Every
+  // interpreter built from the same FlatBufferModel holds the same handle,
+  // so N instances cost one copy of the read-only weights plus N activation
+  // arenas, and the weight memory stays mapped even if the FlatBufferModel
+  // is destroyed before the interpreters.
+  std::shared_ptr<Allocation> model_allocation_;
+
   // Subgraphs
   std::vector<std::unique_ptr<Subgraph>> subgraphs_;
 
@@ -961,6 +979,12 @@ class Interpreter {
   using TfLiteDelegateCreators = std::vector<TfLiteDelegateCreator>;
   TfLiteDelegateCreators lazy_delegate_providers_;
 
+  // Parses a model subgraph whose construction was deferred by the
+  // InterpreterBuilder. Set only when lazy subgraph building is enabled;
+  // invoked with the entry subgraph index before a signature runner for it
+  // is created. See InterpreterBuilder::SetLazySubgraphBuilding.
+  std::function<TfLiteStatus(int)> lazy_subgraph_builder_;
+
   // List of SignatureDefs obtained from the model.
   std::vector<internal::SignatureDef> signature_defs_;
 
@@ -22,6 +22,7 @@ limitations under the License.
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -226,7 +227,8 @@ InterpreterBuilder::InterpreterBuilder(
       op_resolver_(op_resolver),
       error_reporter_(ValidateErrorReporter(model.error_reporter())),
       metadata_(model.ReadAllMetadata()),
-      allocation_(model.allocation()) {
+      allocation_(model.allocation()),
+      shared_allocation_(model.SharedAllocation()) {
   if (options_experimental) {
     options_ = *options_experimental;
   }
@@ -743,6 +745,286 @@ TfLiteStatus InterpreterBuilder::SetNumThreads(int num_threads) {
   return kTfLiteOk;
 }
 
+namespace {
+
+// Computes groups of subgraphs whose non-persistent tensors can be allocated
+// from one shared arena buffer. Two subgraphs may only share a buffer when
+// they are never in flight at the same time, so grouping is restricted to
+// subgraphs invoked by exactly one WHILE or IF op: those re-acquire their
+// memory on every invocation of the hosting op, which makes it safe for
+// another group member to have resized the buffer in between. Within a group,
+// no subgraph may be an ancestor of another (an ancestor's tensors stay live
+// while its descendants run), and no two subgraphs may live under the same
+// WHILE op (a loop's cond/body stay resolved for the whole duration of the
+// loop, without re-acquiring memory between iterations).
+std::vector<std::vector<int>> ComputeArenaSharingGroups(
+    const ::tflite::Model* model) {
+  auto* subgraphs = model->subgraphs();
+  const int num_subgraphs = subgraphs->size();
+  // host_edges[child] lists (host subgraph, loop id) pairs, where `loop id`
+  // identifies the WHILE op instance through which the child is invoked, or
+  // is -1 when the hosting op is not a loop.
+  std::vector<std::vector<std::pair<int, int>>> host_edges(num_subgraphs);
+  std::vector<int> reference_count(num_subgraphs, 0);
+  // True for subgraphs invoked through ops whose invocation pattern does not
+  // guarantee safe sharing (CALL_ONCE and the StableHLO control flow ops), or
+  // exported as signatures, which may be invoked at arbitrary times.
+  std::vector<bool> unsafe_reference(num_subgraphs, false);
+  int num_loops = 0;
+  for (int i = 0; i < num_subgraphs; ++i) {
+    auto* operators = (*subgraphs)[i]->operators();
+    if (!operators) continue;
+    for (const auto* op : *operators) {
+      auto add_edge = [&](int child, int loop_id, bool safe) {
+        if (child <= 0 || child >= num_subgraphs || child == i) return;
+        host_edges[child].push_back({i, loop_id});
+        ++reference_count[child];
+        if (!safe) unsafe_reference[child] = true;
+      };
+      if (const auto* options = op->builtin_options_as_WhileOptions()) {
+        const int loop_id = num_loops++;
+        add_edge(options->cond_subgraph_index(), loop_id, /*safe=*/true);
+        add_edge(options->body_subgraph_index(), loop_id, /*safe=*/true);
+      } else if (const auto* options = op->builtin_options_as_IfOptions()) {
+        add_edge(options->then_subgraph_index(), -1, /*safe=*/true);
+        add_edge(options->else_subgraph_index(), -1, /*safe=*/true);
+      } else if (const auto* options =
+                     op->builtin_options_as_CallOnceOptions()) {
+        add_edge(options->init_subgraph_index(), -1, /*safe=*/false);
+      } else if (const auto* options =
+                     op->builtin_options_2_as_StablehloWhileOptions()) {
+        const int loop_id = num_loops++;
+        add_edge(options->cond_subgraph_index(), loop_id, /*safe=*/false);
+        add_edge(options->body_subgraph_index(), loop_id, /*safe=*/false);
+      } else if (const auto* options =
+                     op->builtin_options_2_as_StablehloReduceOptions()) {
+        add_edge(options->body_subgraph_index(), -1, /*safe=*/false);
+      } else if (const auto* options =
+                     op->builtin_options_2_as_StablehloReduceWindowOptions()) {
+        add_edge(options->body_subgraph_index(), -1, /*safe=*/false);
+      } else if (const auto* options =
+                     op->builtin_options_2_as_StablehloScatterOptions()) {
+        add_edge(options->update_computation_subgraph_index(), -1,
+                 /*safe=*/false);
+      } else if (const auto* options =
+                     op->builtin_options_2_as_StablehloSortOptions()) {
+        add_edge(options->comparator_subgraph_index(), -1, /*safe=*/false);
+      } else if (const auto* options =
+                     op->builtin_options_2_as_StableHLOCompositeOptions()) {
+        add_edge(options->decomposition_subgraph_index(), -1, /*safe=*/false);
+      }
+    }
+  }
+  if (const auto* signature_defs = model->signature_defs()) {
+    for (const auto* signature_def : *signature_defs) {
+      const int32_t subgraph_index = signature_def->subgraph_index();
+      if (subgraph_index >= 0 && subgraph_index < num_subgraphs) {
+        unsafe_reference[subgraph_index] = true;
+      }
+    }
+  }
+
+  // Propagate ancestors and enclosing loops to a fixed point. The host edges
+  // form a DAG, so `num_subgraphs` passes always suffice; the iteration cap
+  // turns a (malformed) cyclic model into conservative supersets instead of
+  // an endless loop.
+  std::vector<std::set<int>> ancestors(num_subgraphs);
+  std::vector<std::set<int>> enclosing_loops(num_subgraphs);
+  bool changed = true;
+  for (int pass = 0; changed && pass <= num_subgraphs; ++pass) {
+    changed = false;
+    for (int i = 0; i < num_subgraphs; ++i) {
+      for (const auto& edge : host_edges[i]) {
+        const int host = edge.first;
+        const int loop_id = edge.second;
+        const size_t old_size =
+            ancestors[i].size() + enclosing_loops[i].size();
+        ancestors[i].insert(host);
+        ancestors[i].insert(ancestors[host].begin(), ancestors[host].end());
+        if (loop_id >= 0) enclosing_loops[i].insert(loop_id);
+        enclosing_loops[i].insert(enclosing_loops[host].begin(),
+                                  enclosing_loops[host].end());
+        changed |=
+            ancestors[i].size() + enclosing_loops[i].size() != old_size;
+      }
+    }
+  }
+
+  auto conflict = [&](int a, int b) {
+    if (ancestors[a].count(b) || ancestors[b].count(a)) return true;
+    for (int loop_id : enclosing_loops[a]) {
+      if (enclosing_loops[b].count(loop_id)) return true;
+    }
+    return false;
+  };
+
+  std::vector<std::vector<int>> groups;
+  for (int i = 1; i < num_subgraphs; ++i) {
+    if (reference_count[i] != 1 || unsafe_reference[i]) continue;
+    auto group_it = std::find_if(
+        groups.begin(), groups.end(), [&](const std::vector<int>& group) {
+          return std::none_of(group.begin(), group.end(),
+                              [&](int member) { return conflict(i, member); });
+        });
+    if (group_it != groups.end()) {
+      group_it->push_back(i);
+    } else {
+      groups.push_back({i});
+    }
+  }
+  // Only groups with at least two members actually share memory.
+  groups.erase(std::remove_if(groups.begin(), groups.end(),
+                              [](const std::vector<int>& group) {
+                                return group.size() < 2;
+                              }),
+               groups.end());
+  return groups;
+}
+
+// Appends the indices of the subgraphs directly invoked by `subgraph`'s
+// control flow operators to `children`.
+void AppendChildSubgraphIndices(const ::tflite::SubGraph* subgraph,
+                                std::vector<int>* children) {
+  auto* operators = subgraph->operators();
+  if (!operators) return;
+  for (const auto* op : *operators) {
+    auto add_child = [&](int child) {
+      if (child >= 0) children->push_back(child);
+    };
+    if (const auto* options = op->builtin_options_as_WhileOptions()) {
+      add_child(options->cond_subgraph_index());
+      add_child(options->body_subgraph_index());
+    } else if (const auto* options = op->builtin_options_as_IfOptions()) {
+      add_child(options->then_subgraph_index());
+      add_child(options->else_subgraph_index());
+    } else if (const auto* options = op->builtin_options_as_CallOnceOptions()) {
+      add_child(options->init_subgraph_index());
+    } else if (const auto* options =
+                   op->builtin_options_2_as_StablehloWhileOptions()) {
+      add_child(options->cond_subgraph_index());
+      add_child(options->body_subgraph_index());
+    } else if (const auto* options =
+                   op->builtin_options_2_as_StablehloReduceOptions()) {
+      add_child(options->body_subgraph_index());
+    } else if (const auto* options =
+                   op->builtin_options_2_as_StablehloReduceWindowOptions()) {
+      add_child(options->body_subgraph_index());
+    } else if (const auto* options =
+                   op->builtin_options_2_as_StablehloScatterOptions()) {
+      add_child(options->update_computation_subgraph_index());
+    } else if (const auto* options =
+                   op->builtin_options_2_as_StablehloSortOptions()) {
+      add_child(options->comparator_subgraph_index());
+    } else if (const auto* options =
+                   op->builtin_options_2_as_StableHLOCompositeOptions()) {
+      add_child(options->decomposition_subgraph_index());
+    }
+  }
+}
+
+}  // namespace
+
+TfLiteStatus InterpreterBuilder::BuildSubgraph(
+    Interpreter* interpreter, int subgraph_index,
+    TfLiteTelemetrySubgraphInfo* subgraph_info) {
+  const tflite::SubGraph* subgraph = (*model_->subgraphs())[subgraph_index];
+  tflite::Subgraph* modified_subgraph = interpreter->subgraph(subgraph_index);
+  modified_subgraph->allocation_ = allocation_;
+  auto operators = subgraph->operators();
+  auto tensors = subgraph->tensors();
+  if (!tensors) {
+    TF_LITE_REPORT_ERROR(error_reporter_,
+                         "Did not get tensors in subgraph %d.\n",
+                         subgraph_index);
+    return kTfLiteError;
+  }
+  if (modified_subgraph->AddTensors(tensors->size()) != kTfLiteOk) {
+    return kTfLiteError;
+  }
+  // Parse inputs/outputs
+  modified_subgraph->SetInputs(FlatBufferIntArrayToVector(subgraph->inputs()));
+  modified_subgraph->SetOutputs(
+      FlatBufferIntArrayToVector(subgraph->outputs()));
+
+  // Finally setup nodes and tensors
+  // Parse tensors before nodes as ParseNodes checks input tensors for the
+  // nodes.
+  if (ParseTensors(model_->buffers(), tensors, modified_subgraph,
+                   subgraph_info) != kTfLiteOk)
+    return kTfLiteError;
+  if (operators && ParseNodes(operators, modified_subgraph) != kTfLiteOk)
+    return kTfLiteError;
+
+  std::vector<int> variables;
+  for (int i = 0; i < modified_subgraph->tensors_size(); ++i) {
+    auto* tensor = modified_subgraph->tensor(i);
+    if (tensor->is_variable) {
+      variables.push_back(i);
+    }
+  }
+  modified_subgraph->SetVariables(std::move(variables));
+  if (subgraph->name()) {
+    modified_subgraph->SetName(subgraph->name()->c_str());
+  }
+  return kTfLiteOk;
+}
+
+std::vector<bool> InterpreterBuilder::ComputeDeferredSubgraphs() const {
+  if (!lazy_subgraph_building_) return {};
+  auto* subgraphs = model_->subgraphs();
+  const int num_subgraphs = subgraphs->size();
+  if (num_subgraphs <= 1) return {};
+  // Delegates (and the Flex delegate) are applied while the interpreter is
+  // built and would miss subgraphs parsed later, and arena sharing groups
+  // pair subgraphs that must exist when the groups are installed. Fall back
+  // to eager building in those configurations.
+  if (!delegates_.empty() || has_flex_op_ ||
+      options_.GetShareArenaAcrossSubgraphs()) {
+    return {};
+  }
+  // Everything reachable from the primary subgraph is built eagerly; the
+  // rest (auxiliary signature entry points and their children) is deferred.
+  std::vector<bool> deferred(num_subgraphs, true);
+  std::vector<int> stack = {0};
+  while (!stack.empty()) {
+    const int subgraph_index = stack.back();
+    stack.pop_back();
+    if (subgraph_index >= num_subgraphs || !deferred[subgraph_index]) {
+      continue;
+    }
+    deferred[subgraph_index] = false;
+    AppendChildSubgraphIndices((*subgraphs)[subgraph_index], &stack);
+  }
+  if (std::none_of(deferred.begin(), deferred.end(),
+                   [](bool is_deferred) { return is_deferred; })) {
+    return {};
+  }
+  return deferred;
+}
+
+TfLiteStatus InterpreterBuilder::BuildDeferredSubgraphs(
+    Interpreter* interpreter, int root_subgraph_index,
+    std::vector<bool>* deferred) {
+  auto* subgraphs = model_->subgraphs();
+  std::vector<int> stack = {root_subgraph_index};
+  while (!stack.empty()) {
+    const int subgraph_index = stack.back();
+    stack.pop_back();
+    if (subgraph_index < 0 ||
+        subgraph_index >= static_cast<int>(deferred->size()) ||
+        !(*deferred)[subgraph_index]) {
+      continue;
+    }
+    if (BuildSubgraph(interpreter, subgraph_index,
+                      /*subgraph_info=*/nullptr) != kTfLiteOk) {
+      return kTfLiteError;
+    }
+    (*deferred)[subgraph_index] = false;
+    AppendChildSubgraphIndices((*subgraphs)[subgraph_index], &stack);
+  }
+  return kTfLiteOk;
+}
+
 TfLiteStatus InterpreterBuilder::operator()(
     std::unique_ptr<Interpreter>* interpreter, int num_threads) {
   TfLiteStatus status = SetNumThreads(num_threads);
@@ -805,6 +1087,10 @@ TfLiteStatus InterpreterBuilder::operator()(
   }
 
   *interpreter = std::make_unique<Interpreter>(error_reporter_);
+  // Retain the model's memory: all interpreters built from one
+  // FlatBufferModel reference a single copy of the read-only weights, which
+  // stays mapped for as long as any of them is alive.
+  (*interpreter)->model_allocation_ = shared_allocation_;
   if (subgraphs->size() > 1) {
     (*interpreter)->AddSubgraphs(subgraphs->size() - 1);
   }
@@ -826,54 +1112,31 @@ TfLiteStatus InterpreterBuilder::operator()(
     telemetry_settings->subgraph_infos.resize(subgraphs->size());
   }
 
+  const std::vector<bool> deferred_subgraphs = ComputeDeferredSubgraphs();
   for (int subgraph_index = 0; subgraph_index < subgraphs->size();
        ++subgraph_index) {
-    const tflite::SubGraph* subgraph = (*subgraphs)[subgraph_index];
-    tflite::Subgraph* modified_subgraph =
-        (*interpreter)->subgraph(subgraph_index);
-    modified_subgraph->allocation_ = allocation_;
+    if (!deferred_subgraphs.empty() && deferred_subgraphs[subgraph_index]) {
+      continue;
+    }
     auto* subgraph_info =
         telemetry_registered
             ? &telemetry_settings->subgraph_infos[subgraph_index]
             : nullptr;
-    auto operators = subgraph->operators();
-    auto tensors = subgraph->tensors();
-    if (!tensors) {
-      TF_LITE_REPORT_ERROR(error_reporter_,
-                           "Did not get tensors in subgraph %d.\n",
-                           subgraph_index);
-      return cleanup_and_error();
-    }
-    if (modified_subgraph->AddTensors(tensors->size()) != kTfLiteOk) {
-      return cleanup_and_error();
-    }
-    // Parse inputs/outputs
-    modified_subgraph->SetInputs(
-        FlatBufferIntArrayToVector(subgraph->inputs()));
-    modified_subgraph->SetOutputs(
-        FlatBufferIntArrayToVector(subgraph->outputs()));
-
-    // Finally setup nodes and tensors
-    // Parse tensors before nodes as ParseNodes checks input tensors for the
-    // nodes.
-    if (ParseTensors(buffers, tensors, modified_subgraph, subgraph_info) !=
-        kTfLiteOk)
-      return cleanup_and_error();
-    if (operators && ParseNodes(operators, modified_subgraph) != kTfLiteOk)
+    if (BuildSubgraph(interpreter->get(), subgraph_index, subgraph_info) !=
+        kTfLiteOk) {
       return cleanup_and_error();
-
-    std::vector<int> variables;
-    for (int i = 0; i < modified_subgraph->tensors_size(); ++i) {
-      auto* tensor = modified_subgraph->tensor(i);
-      if (tensor->is_variable) {
-        variables.push_back(i);
-      }
-    }
-    modified_subgraph->SetVariables(std::move(variables));
-    if (subgraph->name()) {
-      modified_subgraph->SetName(subgraph->name()->c_str());
     }
   }
+  if (!deferred_subgraphs.empty()) {
+    // The closure below captures this builder; SetLazySubgraphBuilding
+    // documents that the builder must outlive the interpreter.
+    auto deferred = std::make_shared<std::vector<bool>>(deferred_subgraphs);
+    (*interpreter)->lazy_subgraph_builder_ =
+        [this, interp = interpreter->get(), deferred](int subgraph_index) {
+          return BuildDeferredSubgraphs(interp, subgraph_index,
+                                        deferred.get());
+        };
+  }
 
   if (ParseSignatureDefs(model_->signature_defs(), interpreter->get()) !=
       kTfLiteOk) {
@@ -884,6 +1147,11 @@ TfLiteStatus InterpreterBuilder::operator()(
     return cleanup_and_error();
   }
 
+  if (options_.GetShareArenaAcrossSubgraphs()) {
+    (*interpreter)
+        ->ShareArenaAcrossSubgraphs(ComputeArenaSharingGroups(model_));
+  }
+
   if (ShouldCreateLazyDelegateProviders(num_fp32_tensors_)) {
     (*interpreter)->lazy_delegate_providers_ =
         op_resolver_.GetDelegateCreators();
@@ -127,6 +127,25 @@ class InterpreterBuilder {
     telemetry_profiler_ = std::move(profiler);
   }
 
+  /// Defers parsing of subgraphs that are not reachable from the primary
+  /// subgraph until a signature runner using them is created, so building an
+  /// interpreter for a model with auxiliary signatures (e.g. scoring heads or
+  /// optional decoders next to the main decode path) only pays for the
+  /// subgraphs the main signature actually invokes.
+  ///
+  /// When enabled, the `InterpreterBuilder` and the `op_resolver` must
+  /// outlive any `Interpreter` created by `operator()`, since deferred
+  /// subgraphs are parsed through them on first use. Lazy building falls back
+  /// to eager building when delegates were added to the builder or arena
+  /// sharing across subgraphs is requested; delegates applied to the
+  /// interpreter afterwards cover lazily built subgraphs only if applied
+  /// after the corresponding signature runner has been created.
+  ///
+  /// WARNING: This is an experimental API and subject to change.
+  void SetLazySubgraphBuilding(bool enable) {
+    lazy_subgraph_building_ = enable;
+  }
+
  private:
   TfLiteStatus BuildLocalIndexToRegistrationMapping();
   TfLiteStatus ParseNodes(
@@ -147,6 +166,18 @@ class InterpreterBuilder {
           signature_def_list,
       Interpreter* interpreter);
   void ParseConversionMetadata(TfLiteTelemetryInterpreterSettings* settings);
+  // Parses the tensors and nodes of one model subgraph into the
+  // interpreter's subgraph with the same index.
+  TfLiteStatus BuildSubgraph(Interpreter* interpreter, int subgraph_index,
+                             TfLiteTelemetrySubgraphInfo* subgraph_info);
+  // Returns per-subgraph flags marking the subgraphs whose parsing is
+  // deferred, or an empty vector when everything is built eagerly.
+  std::vector<bool> ComputeDeferredSubgraphs() const;
+  // Builds `root_subgraph_index` and the deferred subgraphs reachable from
+  // it, clearing their flags in `deferred`.
+  TfLiteStatus BuildDeferredSubgraphs(Interpreter* interpreter,
+                                      int root_subgraph_index,
+                                      std::vector<bool>* deferred);
 
   const ::tflite::Model* model_;
   const OpResolver& op_resolver_;
@@ -162,8 +193,13 @@ class InterpreterBuilder {
   std::vector<TfLiteRegistration> unresolved_custom_ops_;
   std::vector<BuiltinOperator> flatbuffer_op_index_to_registration_types_;
   const Allocation* allocation_ = nullptr;
+  // Shared handle to the model's memory; attached to every interpreter this
+  // builder creates so the weight memory outlives the FlatBufferModel. Null
+  // when building from a raw tflite::Model pointer.
+  std::shared_ptr<Allocation> shared_allocation_;
 
   bool has_flex_op_ = false;
+  bool lazy_subgraph_building_ = false;
   int num_fp32_tensors_ = 0;
   int num_threads_ = -1;
   InterpreterOptions options_;
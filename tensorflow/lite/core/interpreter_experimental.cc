@@ -191,6 +191,9 @@ async::AsyncSignatureRunner* Interpreter::GetAsyncSignatureRunner(
   }
   for (const auto& signature : signature_defs_) {
     if (signature.signature_key == signature_key) {
+      if (EnsureSubgraphBuilt(signature.subgraph_index) != kTfLiteOk) {
+        return nullptr;
+      }
       auto status = async_signature_runner_map_.insert(
           {signature_key, async::AsyncSignatureRunner(
                               &signature, subgraph(signature.subgraph_index))});
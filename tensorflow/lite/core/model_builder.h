@@ -218,6 +218,15 @@ class FlatBufferModel {
   ErrorReporter* error_reporter() const { return error_reporter_; }
   const Allocation* allocation() const { return allocation_.get(); }
 
+  /// Returns a shared handle to the memory backing this model. Every
+  /// interpreter built from this model retains one of these handles, so N
+  /// instances share a single copy of the read-only weight memory and the
+  /// memory stays valid even if the FlatBufferModel is destroyed first. Note
+  /// that only memory owned by the model's Allocation is covered; a
+  /// caller-owned buffer passed to BuildFromBuffer must still outlive the
+  /// interpreters.
+  std::shared_ptr<Allocation> SharedAllocation() const { return allocation_; }
+
   // Returns the minimum runtime version from the flatbuffer. This runtime
   // version encodes the minimum required interpreter version to run the
   // flatbuffer model. If the minimum version can't be determined, an empty
@@ -274,8 +283,10 @@ class FlatBufferModel {
   /// the interpreter is created
   ErrorReporter* error_reporter_;
   /// The allocator used for holding memory of the model. Note that this will
-  /// be null if the client provides a tflite::Model directly.
-  std::unique_ptr<Allocation> allocation_;
+  /// be null if the client provides a tflite::Model directly. Held through a
+  /// shared_ptr so that interpreters built from this model can retain the
+  /// memory past the model's own lifetime (see SharedAllocation()).
+  std::shared_ptr<Allocation> allocation_;
 };
 
 }  // namespace impl
@@ -265,6 +265,34 @@ TEST(BasicFlatBufferModel, TestModelInInterpreter) {
   }
 }
 
+TEST(BasicFlatBufferModel, TestWeightMemorySharedAcrossInterpreters) {
+  auto model = FlatBufferModel::BuildFromFile(
+      "tensorflow/lite/testdata/test_model.bin");
+  ASSERT_TRUE(model);
+
+  std::unique_ptr<Interpreter> first;
+  ASSERT_EQ(InterpreterBuilder(*model, TrivialResolver(&dummy_reg))(&first),
+            kTfLiteOk);
+  std::unique_ptr<Interpreter> second;
+  ASSERT_EQ(InterpreterBuilder(*model, TrivialResolver(&dummy_reg))(&second),
+            kTfLiteOk);
+
+  // Constant tensors of both instances point at the same mapping; the
+  // weights are not duplicated per interpreter.
+  TfLiteTensor* first_weights = first->tensor(0);
+  TfLiteTensor* second_weights = second->tensor(0);
+  ASSERT_EQ(first_weights->allocation_type, kTfLiteMmapRo);
+  ASSERT_NE(first_weights->data.raw, nullptr);
+  ASSERT_EQ(first_weights->data.raw, second_weights->data.raw);
+
+  // Each interpreter retains a shared handle on the model's memory, so the
+  // weights stay readable after the FlatBufferModel itself is destroyed.
+  const char first_byte = first_weights->data.raw_const[0];
+  model.reset();
+  EXPECT_EQ(first_weights->data.raw_const[0], first_byte);
+  EXPECT_EQ(second_weights->data.raw_const[0], first_byte);
+}
+
 TEST(BasicFlatBufferModel, TestWithNumThreads) {
   TestErrorReporter reporter;
   auto model = FlatBufferModel::BuildFromFile(
@@ -45,6 +45,9 @@ limitations under the License.
 
 namespace tflite {
 
+class ResizableAlignedBuffer;  // Forward declaration, see
+                               // simple_memory_arena.h.
+
 #ifndef DOXYGEN_SKIP
 class SingleOpModel;  // Class for friend declarations.
 
@@ -286,6 +289,15 @@ class Subgraph {
   // AllocateTensors needs to be called before next invocation.
   TfLiteStatus ReleaseMemory();
 
+  // WARNING: Experimental interface, subject to change
+  // Makes this subgraph allocate its non-persistent activation tensors from
+  // `buffer`, which may be shared with other subgraphs that are never in
+  // flight at the same time (e.g. the bodies of unrelated control flow ops).
+  // Must be called before AllocateTensors.
+  void SetSharedArenaBuffer(std::shared_ptr<ResizableAlignedBuffer> buffer) {
+    shared_arena_buffer_ = std::move(buffer);
+  }
+
   // Update allocations for all tensors. This will redim dependent tensors using
   // the input tensor dimensionality as given. This is relatively expensive.
   // If you know that your sizes are not changing, you need not call this.
@@ -1068,6 +1080,11 @@ class Subgraph {
 
   std::unique_ptr<MemoryPlanner> memory_planner_;
 
+  // When set, the memory planner allocates non-persistent tensors from this
+  // buffer, which may be shared with other subgraphs; see
+  // SetSharedArenaBuffer.
+  std::shared_ptr<ResizableAlignedBuffer> shared_arena_buffer_;
+
   // Maps tensor index to custom allocation for all applicable tensors.
   std::map<int, TfLiteCustomAllocation> custom_allocations_;
 
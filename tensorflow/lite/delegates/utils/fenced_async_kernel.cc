@@ -0,0 +1,342 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/delegates/utils/fenced_async_kernel.h"
+
+#include <unistd.h>
+
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/async/c/async_kernel.h"
+#include "tensorflow/lite/async/c/task.h"
+#include "tensorflow/lite/async/c/types.h"
+#include "tensorflow/lite/async/interop/c/attribute_map.h"
+#include "tensorflow/lite/async/interop/c/constants.h"
+#include "tensorflow/lite/async/interop/c/types.h"
+#include "tensorflow/lite/c/c_api_opaque.h"
+#include "tensorflow/lite/c/c_api_types.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/delegates/utils/async_type_helpers.h"
+#include "tensorflow/lite/delegates/utils/sync_fence.h"
+#include "tensorflow/lite/minimal_logging.h"
+
+namespace tflite::delegates::utils {
+namespace {
+
+// Returns true if `tensor_index` is an input of the delegated `node`.
+bool IsNodeInput(const TfLiteOpaqueNode* node, int tensor_index) {
+  const int* inputs = nullptr;
+  int num_inputs = 0;
+  if (TfLiteOpaqueNodeInputs(node, &inputs, &num_inputs) != kTfLiteOk) {
+    return false;
+  }
+  for (int i = 0; i < num_inputs; ++i) {
+    if (inputs[i] == tensor_index) return true;
+  }
+  return false;
+}
+
+// Returns the fence fd wrapped by `sync`, or -1 if there is none. By
+// convention (shared with the GPU delegate) the synchronization object holds
+// a pointer to the fd.
+int FenceFd(TfLiteSynchronization* sync) {
+  if (sync == nullptr) return -1;
+  void* sync_obj = TfLiteSynchronizationGetPtr(sync);
+  if (sync_obj == nullptr) return -1;
+  return *static_cast<int*>(sync_obj);
+}
+
+}  // namespace
+
+FencedAsyncKernel::FencedAsyncKernel(EvalFn eval_fn)
+    : eval_fn_(std::move(eval_fn)) {}
+
+TfLiteStatus FencedAsyncKernel::RegisterBuffer(
+    TfLiteOpaqueContext* context, TfLiteIoType io_type,
+    const TfLiteBackendBuffer* buffer, const TfLiteAttributeMap* attrs,
+    TfLiteBufferHandle handle) {
+  if (buffer == nullptr || TfLiteBackendBufferGetPtr(buffer) == nullptr) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                    "FencedAsyncKernel: RegisterBuffer called with null "
+                    "buffer.");
+    return kTfLiteError;
+  }
+  const char* buffer_type = nullptr;
+  if (attrs != nullptr &&
+      TfLiteAttributeMapGetStringBufferAttr(
+          attrs, kTfLiteBufferAttrKeyResourceTypeName, &buffer_type) &&
+      std::strcmp(buffer_type, kBufferTypeHostMemory) != 0) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                    "FencedAsyncKernel: unsupported buffer type %s.",
+                    buffer_type);
+    return kTfLiteError;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!buffers_.emplace(handle, TfLiteBackendBufferGetPtr(buffer)).second) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                    "FencedAsyncKernel: duplicate buffer handle %d.", handle);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus FencedAsyncKernel::RegisterBufferSlice(
+    TfLiteOpaqueContext* context, TfLiteBufferHandle buffer_pool,
+    const TfLiteAttributeMap* attrs, TfLiteBufferHandle handle) {
+  size_t offset = 0;
+  if (attrs != nullptr) {
+    TfLiteAttributeMapGetSizeTBufferAttr(attrs, kTfLiteBufferAttrKeyOffset,
+                                         &offset);
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = buffers_.find(buffer_pool);
+  if (it == buffers_.end()) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                    "FencedAsyncKernel: unknown buffer pool handle %d.",
+                    buffer_pool);
+    return kTfLiteError;
+  }
+  if (!buffers_
+           .emplace(handle, static_cast<char*>(it->second) + offset)
+           .second) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                    "FencedAsyncKernel: duplicate buffer handle %d.", handle);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus FencedAsyncKernel::UnregisterBuffer(TfLiteOpaqueContext* context,
+                                                 TfLiteBufferHandle handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (buffers_.erase(handle) == 0) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                    "FencedAsyncKernel: unknown buffer handle %d.", handle);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+const std::vector<const char*>& FencedAsyncKernel::SupportedBufferTypes(
+    TfLiteIoType io_type) const {
+  static const std::vector<const char*>* const kBufferTypes =
+      new std::vector<const char*>{kBufferTypeHostMemory};
+  return *kBufferTypes;
+}
+
+const std::vector<const char*>& FencedAsyncKernel::SupportedSynchronizations(
+    TfLiteIoType io_type) const {
+  static const std::vector<const char*>* const kInputSyncTypes =
+      new std::vector<const char*>{kTfLiteSyncTypeNoSyncObj,
+                                   kSyncTypeSyncFenceFd};
+  // Sync fences cannot be created from user space, so output buffers are
+  // ready when Wait() returns.
+  static const std::vector<const char*>* const kOutputSyncTypes =
+      new std::vector<const char*>{kTfLiteSyncTypeNoSyncObj};
+  return io_type == kTfLiteIoTypeInput ? *kInputSyncTypes : *kOutputSyncTypes;
+}
+
+bool FencedAsyncKernel::ReconcileRestrictions(
+    const TfLiteOpaqueContext* context, const TfLiteOpaqueNode* node,
+    int tensor_index, const TfLiteAttributeMap* user_provided_attributes,
+    TfLiteAttributeMap* merged, TfLiteAttributeMap* conflict) const {
+  if (user_provided_attributes == nullptr || merged == nullptr) return false;
+  TfLiteAttributeMapCopy(user_provided_attributes, merged);
+  if (TfLiteAttributeMapIsBufferAttributeMap(user_provided_attributes)) {
+    const char* buffer_type = nullptr;
+    if (TfLiteAttributeMapGetStringBufferAttr(
+            user_provided_attributes, kTfLiteBufferAttrKeyResourceTypeName,
+            &buffer_type) &&
+        std::strcmp(buffer_type, kBufferTypeHostMemory) != 0) {
+      if (conflict != nullptr) {
+        TfLiteAttributeMapSetStringBufferAttr(
+            conflict, kTfLiteBufferAttrKeyResourceTypeName,
+            kBufferTypeHostMemory);
+      }
+      return false;
+    }
+    return true;
+  }
+  if (TfLiteAttributeMapIsSyncAttributeMap(user_provided_attributes)) {
+    const char* sync_type = nullptr;
+    if (!TfLiteAttributeMapGetStringSyncAttr(
+            user_provided_attributes,
+            kTfLiteSynchronizationAttrKeyObjectTypeName, &sync_type)) {
+      return true;
+    }
+    const bool is_input = IsNodeInput(node, tensor_index);
+    const bool supported =
+        std::strcmp(sync_type, kTfLiteSyncTypeNoSyncObj) == 0 ||
+        (is_input && std::strcmp(sync_type, kSyncTypeSyncFenceFd) == 0);
+    if (!supported && conflict != nullptr) {
+      TfLiteAttributeMapSetStringSyncAttr(
+          conflict, kTfLiteSynchronizationAttrKeyObjectTypeName,
+          kTfLiteSyncTypeNoSyncObj);
+    }
+    return supported;
+  }
+  return false;
+}
+
+TfLiteStatus FencedAsyncKernel::SetAttributes(TfLiteOpaqueContext* context,
+                                              TfLiteOpaqueNode* node,
+                                              int tensor_index,
+                                              const TfLiteAttributeMap* attrs) {
+  if (attrs == nullptr) return kTfLiteError;
+  if (TfLiteAttributeMapIsSyncAttributeMap(attrs)) {
+    const char* sync_type = nullptr;
+    if (TfLiteAttributeMapGetStringSyncAttr(
+            attrs, kTfLiteSynchronizationAttrKeyObjectTypeName, &sync_type) &&
+        std::strcmp(sync_type, kSyncTypeSyncFenceFd) == 0 &&
+        !IsNodeInput(node, tensor_index)) {
+      TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                      "FencedAsyncKernel: sync fence output synchronization "
+                      "is not supported.");
+      return kTfLiteError;
+    }
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus FencedAsyncKernel::SetBufferAttributes(
+    const TfLiteBackendBuffer* buffer, const TfLiteAttributeMap* attrs) {
+  if (buffer == nullptr || attrs == nullptr) return kTfLiteError;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = buffer_attributes_.find(TfLiteBackendBufferGetPtr(buffer));
+  if (it == buffer_attributes_.end()) {
+    it = buffer_attributes_
+             .emplace(TfLiteBackendBufferGetPtr(buffer),
+                      CreateScopedTfLiteAttrMap(kTfLiteAttrMapTypeBuffer))
+             .first;
+  }
+  TfLiteAttributeMapCopy(attrs, it->second.get());
+  return kTfLiteOk;
+}
+
+TfLiteStatus FencedAsyncKernel::GetBufferAttributes(
+    const TfLiteBackendBuffer* buffer, TfLiteAttributeMap* attrs) {
+  if (buffer == nullptr || attrs == nullptr) return kTfLiteError;
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = buffer_attributes_.find(TfLiteBackendBufferGetPtr(buffer));
+  if (it == buffer_attributes_.end()) return kTfLiteError;
+  TfLiteAttributeMapCopy(it->second.get(), attrs);
+  return kTfLiteOk;
+}
+
+TfLiteStatus FencedAsyncKernel::Prepare(TfLiteOpaqueContext* context,
+                                        TfLiteOpaqueNode* node) {
+  return kTfLiteOk;
+}
+
+TfLiteStatus FencedAsyncKernel::Eval(TfLiteOpaqueContext* context,
+                                     TfLiteOpaqueNode* node,
+                                     TfLiteExecutionTask* task) {
+  const int* inputs = nullptr;
+  int num_inputs = 0;
+  if (TfLiteOpaqueNodeInputs(node, &inputs, &num_inputs) != kTfLiteOk) {
+    return kTfLiteError;
+  }
+  // Snapshot the (deduplicated) input fence fds on the invoking thread; the
+  // sync objects themselves belong to the application and may be reused for
+  // the next frame.
+  std::set<int> fds;
+  for (int i = 0; i < num_inputs; ++i) {
+    const int fd = FenceFd(TfLiteExecutionTaskGetSyncByIndex(task, inputs[i]));
+    if (fd >= 0) fds.insert(fd);
+  }
+
+  auto* state = GetTaskState(task);
+  if (state == nullptr) {
+    state = new TaskState();
+    TfLiteExecutionTaskSetDelegateExecutionData(task, kernel(), state);
+  } else {
+    // The task is being re-scheduled after Wait(); reclaim the previous
+    // worker before reusing the state.
+    if (state->worker.joinable()) state->worker.join();
+    state->done = false;
+  }
+
+  state->worker = std::thread(
+      [this, context, node, task, state,
+       fds = std::vector<int>(fds.begin(), fds.end())]() {
+        TfLiteStatus status = kTfLiteOk;
+        // Inference starts once every input fence has signalled.
+        if (!WaitForAllFds(fds).has_value()) {
+          TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                          "FencedAsyncKernel: waiting for input sync fences "
+                          "failed.");
+          status = kTfLiteError;
+        }
+        // The kernel owns the input fences once the execution is scheduled.
+        for (const int fd : fds) close(fd);
+        if (status == kTfLiteOk) {
+          status = eval_fn_(context, node, [this, task](int tensor_index) {
+            return GetBufferPtr(
+                TfLiteExecutionTaskGetBufferByIndex(task, tensor_index));
+          });
+        }
+        TfLiteExecutionTaskSetStatus(task, status);
+        {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          state->done = true;
+        }
+        state->cv.notify_all();
+      });
+  return kTfLiteOk;
+}
+
+TfLiteStatus FencedAsyncKernel::Wait(TfLiteOpaqueContext* context,
+                                     TfLiteExecutionTask* task) {
+  TaskState* state = GetTaskState(task);
+  if (state != nullptr) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [state] { return state->done; });
+  }
+  return TfLiteExecutionTaskGetStatus(task);
+}
+
+TfLiteStatus FencedAsyncKernel::Finish(TfLiteOpaqueContext* context,
+                                       TfLiteExecutionTask* task) {
+  TaskState* state = GetTaskState(task);
+  if (state != nullptr) {
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      state->cv.wait(lock, [state] { return state->done; });
+    }
+    if (state->worker.joinable()) state->worker.join();
+    delete state;
+    TfLiteExecutionTaskSetDelegateExecutionData(task, kernel(), nullptr);
+  }
+  return TfLiteExecutionTaskGetStatus(task);
+}
+
+void* FencedAsyncKernel::GetBufferPtr(TfLiteBufferHandle handle) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = buffers_.find(handle);
+  return it != buffers_.end() ? it->second : nullptr;
+}
+
+FencedAsyncKernel::TaskState* FencedAsyncKernel::GetTaskState(
+    TfLiteExecutionTask* task) const {
+  return static_cast<TaskState*>(
+      TfLiteExecutionTaskGetDelegateExecutionData(
+          task, const_cast<FencedAsyncKernel*>(this)->kernel()));
+}
+
+}  // namespace tflite::delegates::utils
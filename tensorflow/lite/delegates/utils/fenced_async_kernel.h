@@ -0,0 +1,145 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_DELEGATES_UTILS_FENCED_ASYNC_KERNEL_H_
+#define TENSORFLOW_LITE_DELEGATES_UTILS_FENCED_ASYNC_KERNEL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tensorflow/lite/async/backend_async_kernel_interface.h"
+#include "tensorflow/lite/async/c/types.h"
+#include "tensorflow/lite/async/interop/c/attribute_map.h"
+#include "tensorflow/lite/c/c_api_types.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/delegates/utils/async_type_helpers.h"
+
+namespace tflite::delegates::utils {
+
+// Buffer object type for buffers that are plain host memory (e.g. the CPU
+// mapping of a camera frame). The TfLiteBackendBuffer wraps the raw pointer
+// to the start of the memory.
+constexpr char kBufferTypeHostMemory[] = "host_memory";
+
+// Reference TfLiteAsyncKernel implementation with fence-driven scheduling
+// for backends that compute on host-visible memory.
+//
+// Eval() never blocks the invoking thread: it snapshots the input sync fence
+// fds attached to the task and hands the execution to a worker that waits
+// for all of them to signal before running the delegated computation, so
+// AsyncSignatureRunner::InvokeAsync() can be called as soon as a producer
+// (e.g. the camera) has queued a frame, and inference starts when the
+// frame's fence signals. Hardware-backed kernels (e.g. the GPU delegate on
+// Android) should instead forward the fence to the driver so no host thread
+// has to wake up at all; this class documents and tests the task contract
+// they need to follow.
+//
+// Input synchronizations of type kSyncTypeSyncFenceFd and
+// kTfLiteSyncTypeNoSyncObj are supported; the fence fds are closed by the
+// kernel after they signal, per the async kernel contract. Since a sync
+// fence cannot be created from user space, output synchronizations only
+// support kTfLiteSyncTypeNoSyncObj: output buffers are ready when Wait()
+// returns.
+//
+// WARNING: This is an experimental API and subject to change.
+class FencedAsyncKernel : public BackendAsyncKernelInterface {
+ public:
+  // Resolves the registered host memory attached to `tensor_index` of the
+  // task being evaluated. Returns nullptr if no buffer is attached.
+  using BufferResolver = std::function<void*(int tensor_index)>;
+
+  // Evaluates the delegated partition. Called on a worker thread after all
+  // input fences have signalled; must read inputs from and write outputs to
+  // the memory returned by `buffer_for_tensor`.
+  using EvalFn = std::function<TfLiteStatus(
+      TfLiteOpaqueContext* context, TfLiteOpaqueNode* node,
+      const BufferResolver& buffer_for_tensor)>;
+
+  explicit FencedAsyncKernel(EvalFn eval_fn);
+
+  // Buffer operations.
+  TfLiteStatus RegisterBuffer(TfLiteOpaqueContext* context,
+                              TfLiteIoType io_type,
+                              const TfLiteBackendBuffer* buffer,
+                              const TfLiteAttributeMap* attrs,
+                              TfLiteBufferHandle handle) override;
+  TfLiteStatus RegisterBufferSlice(TfLiteOpaqueContext* context,
+                                   TfLiteBufferHandle buffer_pool,
+                                   const TfLiteAttributeMap* attrs,
+                                   TfLiteBufferHandle handle) override;
+  TfLiteStatus UnregisterBuffer(TfLiteOpaqueContext* context,
+                                TfLiteBufferHandle handle) override;
+
+  // Reconciliations.
+  const std::vector<const char*>& SupportedBufferTypes(
+      TfLiteIoType io_type) const override;
+  const std::vector<const char*>& SupportedSynchronizations(
+      TfLiteIoType io_type) const override;
+  bool ReconcileRestrictions(const TfLiteOpaqueContext* context,
+                             const TfLiteOpaqueNode* node, int tensor_index,
+                             const TfLiteAttributeMap* user_provided_attributes,
+                             TfLiteAttributeMap* merged,
+                             TfLiteAttributeMap* conflict) const override;
+  TfLiteStatus SetAttributes(TfLiteOpaqueContext* context,
+                             TfLiteOpaqueNode* node, int tensor_index,
+                             const TfLiteAttributeMap* attrs) override;
+  TfLiteStatus SetBufferAttributes(const TfLiteBackendBuffer* buffer,
+                                   const TfLiteAttributeMap* attrs) override;
+  TfLiteStatus GetBufferAttributes(const TfLiteBackendBuffer* buffer,
+                                   TfLiteAttributeMap* attrs) override;
+  TfLiteStatus Prepare(TfLiteOpaqueContext* context,
+                       TfLiteOpaqueNode* node) override;
+
+  // Execution.
+  TfLiteStatus Eval(TfLiteOpaqueContext* context, TfLiteOpaqueNode* node,
+                    TfLiteExecutionTask* task) override;
+  TfLiteStatus Wait(TfLiteOpaqueContext* context,
+                    TfLiteExecutionTask* task) override;
+  TfLiteStatus Finish(TfLiteOpaqueContext* context,
+                      TfLiteExecutionTask* task) override;
+
+ private:
+  // Per-task execution state, attached to the task as delegate execution
+  // data. The worker thread is joined when the task is re-scheduled or
+  // finished; Wait() only blocks on the condition variable so that multiple
+  // threads may wait on the same task.
+  struct TaskState {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    std::thread worker;
+  };
+
+  // Returns the host memory registered under `handle`, or nullptr.
+  void* GetBufferPtr(TfLiteBufferHandle handle) const;
+
+  // Returns the task state attached to `task`, or nullptr.
+  TaskState* GetTaskState(TfLiteExecutionTask* task) const;
+
+  const EvalFn eval_fn_;
+
+  mutable std::mutex mutex_;
+  // Mapping from buffer handle to the registered host memory.
+  std::map<TfLiteBufferHandle, void*> buffers_;
+  // Attributes attached to registered buffers, keyed by the wrapped pointer.
+  std::map<const void*, ScopedTfLiteAttrMap> buffer_attributes_;
+};
+
+}  // namespace tflite::delegates::utils
+
+#endif  // TENSORFLOW_LITE_DELEGATES_UTILS_FENCED_ASYNC_KERNEL_H_
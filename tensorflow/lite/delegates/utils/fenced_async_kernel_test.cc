@@ -0,0 +1,221 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/delegates/utils/fenced_async_kernel.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "tensorflow/lite/core/async/async_signature_runner.h"
+#include "tensorflow/lite/core/async/c/task.h"
+#include "tensorflow/lite/core/async/interop/c/attribute_map.h"
+#include "tensorflow/lite/core/async/interop/c/types.h"
+#include "tensorflow/lite/core/async/testing/test_backend.h"
+#include "tensorflow/lite/core/c/c_api_types.h"
+#include "tensorflow/lite/core/c/common.h"
+#include "tensorflow/lite/core/interpreter.h"
+#include "tensorflow/lite/core/kernels/builtin_op_kernels.h"
+#include "tensorflow/lite/interpreter_test_util.h"
+
+namespace tflite::delegates::utils {
+namespace {
+
+// Delegates an ADD node with inputs {0, 0} and output {1} to a
+// FencedAsyncKernel that doubles the input buffer into the output buffer.
+class FencedAsyncKernelTest : public InterpreterTest {
+ protected:
+  void SetUp() override {
+    kernel_ = std::make_unique<FencedAsyncKernel>(
+        [](TfLiteOpaqueContext* context, TfLiteOpaqueNode* node,
+           const FencedAsyncKernel::BufferResolver& buffer_for_tensor)
+            -> TfLiteStatus {
+          const float* input = static_cast<float*>(buffer_for_tensor(0));
+          float* output = static_cast<float*>(buffer_for_tensor(1));
+          if (input == nullptr || output == nullptr) return kTfLiteError;
+          for (int i = 0; i < 3; ++i) output[i] = input[i] + input[i];
+          return kTfLiteOk;
+        });
+    backend_ = std::make_unique<async::testing::TestBackend>(kernel_->kernel());
+
+    interpreter_->AddTensors(2);
+    interpreter_->SetInputs({0});
+    interpreter_->SetOutputs({1});
+    TfLiteQuantizationParams quant;
+    interpreter_->SetTensorParametersReadWrite(0, kTfLiteFloat32, "x", {3},
+                                               quant);
+    interpreter_->SetTensorParametersReadWrite(1, kTfLiteFloat32, "a", {3},
+                                               quant);
+    TfLiteRegistration* reg = ops::builtin::Register_ADD();
+    void* builtin_data = malloc(sizeof(int));
+    interpreter_->AddNodeWithParameters({0, 0}, {1}, nullptr, 0, builtin_data,
+                                        reg);
+    interpreter_->ModifyGraphWithDelegate(backend_->get_delegate());
+    BuildSignature("serving_default", {{"input", 0}}, {{"output", 1}});
+    runner_ = interpreter_->GetAsyncSignatureRunner("serving_default");
+    ASSERT_NE(runner_, nullptr);
+
+    RegisterHostBuffer(kTfLiteIoTypeInput, input_data_, &input_handle_);
+    RegisterHostBuffer(kTfLiteIoTypeOutput, output_data_, &output_handle_);
+  }
+
+  void RegisterHostBuffer(TfLiteIoType io_type, float* data,
+                          TfLiteBufferHandle* handle) {
+    TfLiteBackendBuffer* buffer = TfLiteBackendBufferCreate();
+    TfLiteBackendBufferSetPtr(buffer, data);
+    TfLiteAttributeMap* attrs =
+        TfLiteAttributeMapCreate(kTfLiteAttrMapTypeBuffer);
+    TfLiteAttributeMapSetStringBufferAttr(
+        attrs, kTfLiteBufferAttrKeyResourceTypeName, kBufferTypeHostMemory);
+    EXPECT_EQ(runner_->RegisterBuffer(io_type, buffer, attrs, handle),
+              kTfLiteOk);
+    TfLiteAttributeMapDelete(attrs);
+    TfLiteBackendBufferDelete(buffer);
+  }
+
+  std::unique_ptr<FencedAsyncKernel> kernel_;
+  std::unique_ptr<async::testing::TestBackend> backend_;
+  async::AsyncSignatureRunner* runner_ = nullptr;
+
+  float input_data_[3] = {};
+  float output_data_[3] = {};
+  TfLiteBufferHandle input_handle_ = kTfLiteNullBufferHandle;
+  TfLiteBufferHandle output_handle_ = kTfLiteNullBufferHandle;
+};
+
+TEST_F(FencedAsyncKernelTest, InvokeWithoutFence) {
+  auto* task = runner_->CreateTask();
+  ASSERT_EQ(TfLiteExecutionTaskSetBuffer(task, kTfLiteIoTypeInput, "input",
+                                         input_handle_),
+            kTfLiteOk);
+  ASSERT_EQ(TfLiteExecutionTaskSetBuffer(task, kTfLiteIoTypeOutput, "output",
+                                         output_handle_),
+            kTfLiteOk);
+
+  for (int i = 0; i < 3; ++i) input_data_[i] = i + 1;
+  EXPECT_EQ(runner_->InvokeAsync(task), kTfLiteOk);
+  EXPECT_EQ(runner_->Wait(task), kTfLiteOk);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(output_data_[i], 2.0f * (i + 1));
+  }
+  EXPECT_EQ(runner_->Finish(task), kTfLiteOk);
+}
+
+TEST_F(FencedAsyncKernelTest, InferenceStartsWhenInputFenceSignals) {
+  auto* task = runner_->CreateTask();
+  ASSERT_EQ(TfLiteExecutionTaskSetBuffer(task, kTfLiteIoTypeInput, "input",
+                                         input_handle_),
+            kTfLiteOk);
+  ASSERT_EQ(TfLiteExecutionTaskSetBuffer(task, kTfLiteIoTypeOutput, "output",
+                                         output_handle_),
+            kTfLiteOk);
+
+  // A pipe read end stands in for the producer's sync fence fd: it polls
+  // readable (i.e. "signals") once a byte is written to the other end.
+  int pipe_fds[2];
+  ASSERT_EQ(pipe(pipe_fds), 0);
+  TfLiteSynchronization* sync = TfLiteSynchronizationCreate();
+  TfLiteSynchronizationSetPtr(sync, &pipe_fds[0]);
+  ASSERT_EQ(TfLiteExecutionTaskSetSync(task, kTfLiteIoTypeInput, "input", sync),
+            kTfLiteOk);
+
+  for (int i = 0; i < 3; ++i) input_data_[i] = i + 1;
+  EXPECT_EQ(runner_->InvokeAsync(task), kTfLiteOk);
+  // The worker is blocked on the fence, so the output is untouched.
+  EXPECT_EQ(output_data_[0], 0.0f);
+
+  // Signal the fence; the worker closes the read end per the contract.
+  char byte = 0;
+  ASSERT_EQ(write(pipe_fds[1], &byte, 1), 1);
+  EXPECT_EQ(runner_->Wait(task), kTfLiteOk);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(output_data_[i], 2.0f * (i + 1));
+  }
+
+  EXPECT_EQ(runner_->Finish(task), kTfLiteOk);
+  TfLiteSynchronizationDelete(sync);
+  close(pipe_fds[1]);
+}
+
+TEST_F(FencedAsyncKernelTest, TaskIsReusableAcrossFrames) {
+  auto* task = runner_->CreateTask();
+  ASSERT_EQ(TfLiteExecutionTaskSetBuffer(task, kTfLiteIoTypeInput, "input",
+                                         input_handle_),
+            kTfLiteOk);
+  ASSERT_EQ(TfLiteExecutionTaskSetBuffer(task, kTfLiteIoTypeOutput, "output",
+                                         output_handle_),
+            kTfLiteOk);
+  TfLiteSynchronization* sync = TfLiteSynchronizationCreate();
+  ASSERT_EQ(TfLiteExecutionTaskSetSync(task, kTfLiteIoTypeInput, "input", sync),
+            kTfLiteOk);
+
+  for (int frame = 1; frame <= 2; ++frame) {
+    int pipe_fds[2];
+    ASSERT_EQ(pipe(pipe_fds), 0);
+    TfLiteSynchronizationSetPtr(sync, &pipe_fds[0]);
+    for (int i = 0; i < 3; ++i) input_data_[i] = frame * (i + 1);
+
+    EXPECT_EQ(runner_->InvokeAsync(task), kTfLiteOk);
+    char byte = 0;
+    ASSERT_EQ(write(pipe_fds[1], &byte, 1), 1);
+    EXPECT_EQ(runner_->Wait(task), kTfLiteOk);
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(output_data_[i], 2.0f * frame * (i + 1));
+    }
+    close(pipe_fds[1]);
+  }
+
+  EXPECT_EQ(runner_->Finish(task), kTfLiteOk);
+  TfLiteSynchronizationDelete(sync);
+}
+
+TEST_F(FencedAsyncKernelTest, ReconcilesSyncFenceOnInputOnly) {
+  TfLiteAttributeMap* user =
+      TfLiteAttributeMapCreate(kTfLiteAttrMapTypeSync);
+  TfLiteAttributeMapSetStringSyncAttr(
+      user, kTfLiteSynchronizationAttrKeyObjectTypeName, kSyncTypeSyncFenceFd);
+  TfLiteAttributeMap* merged =
+      TfLiteAttributeMapCreate(kTfLiteAttrMapTypeSync);
+  TfLiteAttributeMap* conflict =
+      TfLiteAttributeMapCreate(kTfLiteAttrMapTypeSync);
+
+  EXPECT_TRUE(runner_->ReconcileRestrictions(kTfLiteIoTypeInput, "input", user,
+                                             merged, conflict));
+  EXPECT_FALSE(runner_->ReconcileRestrictions(kTfLiteIoTypeOutput, "output",
+                                              user, merged, conflict));
+
+  TfLiteAttributeMapDelete(conflict);
+  TfLiteAttributeMapDelete(merged);
+  TfLiteAttributeMapDelete(user);
+}
+
+TEST_F(FencedAsyncKernelTest, RejectsUnknownBufferType) {
+  float data[3] = {};
+  TfLiteBackendBuffer* buffer = TfLiteBackendBufferCreate();
+  TfLiteBackendBufferSetPtr(buffer, data);
+  TfLiteAttributeMap* attrs =
+      TfLiteAttributeMapCreate(kTfLiteAttrMapTypeBuffer);
+  TfLiteAttributeMapSetStringBufferAttr(
+      attrs, kTfLiteBufferAttrKeyResourceTypeName, "unknown_buffer_type");
+  TfLiteBufferHandle handle = kTfLiteNullBufferHandle;
+  EXPECT_EQ(runner_->RegisterBuffer(kTfLiteIoTypeInput, buffer, attrs, &handle),
+            kTfLiteError);
+  TfLiteAttributeMapDelete(attrs);
+  TfLiteBackendBufferDelete(buffer);
+}
+
+}  // namespace
+}  // namespace tflite::delegates::utils
@@ -41,6 +41,7 @@ limitations under the License.
 #include "tensorflow/lite/core/c/builtin_op_data.h"
 #include "tensorflow/lite/core/c/common.h"
 #include "tensorflow/lite/core/subgraph.h"
+#include "tensorflow/lite/delegates/serialization.h"
 #include "tensorflow/lite/delegates/xnnpack/quantization_util.h"
 #include "tensorflow/lite/delegates/xnnpack/weight_cache.h"
 #include "tensorflow/lite/kernels/cpu_backend_context.h"
@@ -560,6 +561,14 @@ class Delegate {
                    "XNNPack weight cache not enabled.");
       }
     }
+
+    // Set up caching of the delegation plan, if requested.
+    if (options_.serialization_dir && options_.model_token) {
+      delegates::SerializationParams serialization_params = {
+          options_.model_token, options_.serialization_dir};
+      serialization_ =
+          std::make_unique<delegates::Serialization>(serialization_params);
+    }
   }
 
   TfLiteIntArray* PrepareOpsToDelegate(TfLiteContext* context);
@@ -651,6 +660,10 @@ class Delegate {
 
   xnn_workspace_t workspace() const { return workspace_.get(); }
 
+  size_t runtime_cache_capacity() const {
+    return options_.runtime_cache_capacity;
+  }
+
   TfLiteStatus AssociateVariableWithTensor(int local_id,
                                            const TfLiteTensor* tensor,
                                            TfLiteContext* logging_context) {
@@ -707,6 +720,14 @@ class Delegate {
   }
 
  private:
+  TfLiteIntArray* PrepareOpsToDelegateImpl(TfLiteContext* context,
+                                           bool try_cached_plan);
+
+  // Key under which the delegation plan is cached. Incorporates the delegate
+  // features that influence which nodes are delegable, including the ones
+  // forced at compile time.
+  std::string DelegationPlanId() const;
+
   TfLiteDelegate delegate_ = {
       reinterpret_cast<void*>(this),  // .data_
       DelegatePrepare,                // .Prepare
@@ -746,6 +767,10 @@ class Delegate {
   // If no weight cache is provided and a cache is set in the delegate options,
   // this will be used as a weight cache.
   MMapWeightCacheProvider weight_cache_provider_;
+
+  // Persists the delegation plan across process restarts when
+  // serialization_dir & model_token are set in the delegate options.
+  std::unique_ptr<delegates::Serialization> serialization_;
 };
 
 class Subgraph {
@@ -1153,8 +1178,20 @@ class Subgraph {
       return nullptr;
     }
 
-    return new Subgraph(delegate, runtime_ptr, externals, external_inputs,
-                        external_outputs, tflite_tensor_to_xnnpack);
+    // The XNNPACK subgraph is only kept alive when additional runtimes may
+    // need to be compiled for other input-shape buckets. Persistent tensors
+    // are allocated per runtime, so the runtime cache is disabled for models
+    // with variable operators, and a partition without external inputs has
+    // no shapes to bucket on.
+    if (!delegate.enable_subgraph_reshaping() ||
+        delegate.runtime_cache_capacity() == 0 ||
+        !delegate.GetAllVariableTensors().empty() || external_inputs.empty()) {
+      subgraph.reset();
+    }
+
+    return new Subgraph(delegate, runtime_ptr, std::move(subgraph), flags,
+                        externals, external_inputs, external_outputs,
+                        tflite_tensor_to_xnnpack);
   }
 
   TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node,
@@ -1173,30 +1210,51 @@ class Subgraph {
     }
 
     if (enable_subgraph_reshaping) {
+      bool need_reshape = true;
+      if (subgraph_ != nullptr) {
+        // Runtime cache enabled: activate the runtime compiled for the
+        // current input shapes. Reshaping can be skipped both on a cache hit
+        // and when the shapes did not change since the last Prepare call.
+        const std::vector<size_t> shape_key = InputShapeKey(context);
+        if (shape_key != active_shape_key_) {
+          bool cache_hit = false;
+          if (ActivateRuntimeForShape(context, shape_key, &cache_hit) !=
+              kTfLiteOk) {
+            return kTfLiteError;
+          }
+          need_reshape = !cache_hit;
+        } else {
+          need_reshape = false;
+        }
+      }
       xnn_status status = xnn_status_invalid_state;
-      for (int i = 0; i < inputs_.size(); ++i) {
-        const TfLiteTensor* tensor = &context->tensors[inputs_[i]];
-        const int dims_count = NumDimensions(tensor);
-        std::array<size_t, XNN_MAX_TENSOR_DIMS> xnn_dims;
-        std::copy(&tensor->dims->data[0], &tensor->dims->data[dims_count],
-                  xnn_dims.begin());
-        status = xnn_reshape_external_value(
-            runtime_.get(), tflite_tensor_to_xnnpack_[inputs_[i]], dims_count,
-            xnn_dims.data());
+      if (need_reshape) {
+        for (int i = 0; i < inputs_.size(); ++i) {
+          const TfLiteTensor* tensor = &context->tensors[inputs_[i]];
+          const int dims_count = NumDimensions(tensor);
+          std::array<size_t, XNN_MAX_TENSOR_DIMS> xnn_dims;
+          std::copy(&tensor->dims->data[0], &tensor->dims->data[dims_count],
+                    xnn_dims.begin());
+          status = xnn_reshape_external_value(
+              runtime_.get(), tflite_tensor_to_xnnpack_[inputs_[i]],
+              dims_count, xnn_dims.data());
+          if (status != xnn_status_success) {
+            TF_LITE_KERNEL_LOG(
+                context, "XNNPack delegate failed to reshape external value");
+            return kTfLiteError;
+          }
+        }
+        status = xnn_reshape_runtime(runtime_.get());
         if (status != xnn_status_success) {
-          TF_LITE_KERNEL_LOG(
-              context, "XNNPack delegate failed to reshape external value");
+          TF_LITE_KERNEL_LOG(context,
+                             "XNNPack delegate failed to reshape runtime");
           return kTfLiteError;
         }
+      }
+      for (int i = 0; i < inputs_.size(); ++i) {
         // signal that setup must be called.
         externals_[inputs_[i]] = nullptr;
       }
-      status = xnn_reshape_runtime(runtime_.get());
-      if (status != xnn_status_success) {
-        TF_LITE_KERNEL_LOG(context,
-                           "XNNPack delegate failed to reshape runtime");
-        return kTfLiteError;
-      }
 
       for (int i = 0; i < outputs_.size(); ++i) {
         TfLiteTensor* tensor = &context->tensors[outputs_[i]];
@@ -7495,10 +7553,14 @@ class Subgraph {
 
  private:
   Subgraph(Delegate& delegate, xnn_runtime_t runtime,
-           const std::unordered_set<int>& externals, std::vector<int>& inputs,
-           std::vector<int>& outputs,
+           std::unique_ptr<xnn_subgraph, decltype(&xnn_delete_subgraph)>
+               subgraph,
+           uint32_t runtime_flags, const std::unordered_set<int>& externals,
+           std::vector<int>& inputs, std::vector<int>& outputs,
            std::unordered_map<int, uint32_t>& tflite_tensor_to_xnnpack)
-      : runtime_(runtime, &xnn_delete_runtime) {
+      : runtime_(runtime, &xnn_delete_runtime),
+        subgraph_(std::move(subgraph)),
+        runtime_flags_(runtime_flags) {
     for (int t : externals) {
       externals_[t] = nullptr;
     }
@@ -7510,10 +7572,93 @@ class Subgraph {
     delegate_ = &delegate;
   }
 
+  // Returns the flattened input shapes used to key the runtime cache. Each
+  // input contributes its rank followed by its dimensions, so shapes of
+  // different ranks cannot alias.
+  std::vector<size_t> InputShapeKey(TfLiteContext* context) const {
+    std::vector<size_t> shape_key;
+    for (int t : inputs_) {
+      const TfLiteTensor* tensor = &context->tensors[t];
+      const int dims_count = NumDimensions(tensor);
+      shape_key.push_back(dims_count);
+      for (int k = 0; k < dims_count; ++k) {
+        shape_key.push_back(tensor->dims->data[k]);
+      }
+    }
+    return shape_key;
+  }
+
+  // Makes the runtime compiled for `shape_key` the active one, stashing the
+  // previously active runtime for later reuse. On a cache miss a new runtime
+  // is compiled from the retained XNNPACK subgraph (packed weights are shared
+  // through the weights cache) and the least recently used bucket is evicted
+  // once the cache exceeds its capacity. `cache_hit` tells the caller whether
+  // the activated runtime has already been reshaped for `shape_key`.
+  TfLiteStatus ActivateRuntimeForShape(TfLiteContext* context,
+                                       const std::vector<size_t>& shape_key,
+                                       bool* cache_hit) {
+    *cache_hit = false;
+    if (!active_shape_key_.empty()) {
+      CachedRuntime& stashed = runtime_cache_[active_shape_key_];
+      stashed.runtime = std::move(runtime_);
+      stashed.last_used = ++runtime_cache_tick_;
+    }
+    const auto it = runtime_cache_.find(shape_key);
+    if (it != runtime_cache_.end()) {
+      runtime_ = std::move(it->second.runtime);
+      runtime_cache_.erase(it);
+      *cache_hit = true;
+    } else {
+      xnn_runtime_t runtime_ptr = nullptr;
+      const xnn_status status = xnn_create_runtime_v4(
+          subgraph_.get(), delegate_->weights_cache(), delegate_->workspace(),
+          delegate_->threadpool(), runtime_flags_, &runtime_ptr);
+      if (status != xnn_status_success) {
+        TF_LITE_KERNEL_LOG(
+            context, "failed to create XNNPACK runtime for new input shapes");
+        return kTfLiteError;
+      }
+      runtime_.reset(runtime_ptr);
+      while (runtime_cache_.size() > delegate_->runtime_cache_capacity()) {
+        auto lru = runtime_cache_.begin();
+        for (auto candidate = runtime_cache_.begin();
+             candidate != runtime_cache_.end(); ++candidate) {
+          if (candidate->second.last_used < lru->second.last_used) {
+            lru = candidate;
+          }
+        }
+        runtime_cache_.erase(lru);
+      }
+    }
+    active_shape_key_ = shape_key;
+    return kTfLiteOk;
+  }
+
   // XNNPACK Runtime (subgraph + workspace) with smart-pointer for lifetime
   // management.
   std::unique_ptr<xnn_runtime, decltype(&xnn_delete_runtime)> runtime_{
       nullptr, &xnn_delete_runtime};
+  // XNNPACK subgraph the runtime was built from. Only kept alive when the
+  // runtime cache is enabled, to compile runtimes for additional input-shape
+  // buckets; null otherwise.
+  std::unique_ptr<xnn_subgraph, decltype(&xnn_delete_subgraph)> subgraph_{
+      nullptr, &xnn_delete_subgraph};
+  // Flags that were passed to xnn_create_runtime_v4 when building runtime_,
+  // reused for runtimes compiled for other input-shape buckets.
+  uint32_t runtime_flags_ = 0;
+  // Inactive runtimes already reshaped for previously seen input shapes,
+  // keyed by the flattened input shapes (see InputShapeKey).
+  struct CachedRuntime {
+    std::unique_ptr<xnn_runtime, decltype(&xnn_delete_runtime)> runtime{
+        nullptr, &xnn_delete_runtime};
+    uint64_t last_used = 0;
+  };
+  std::map<std::vector<size_t>, CachedRuntime> runtime_cache_;
+  // Monotonic counter backing the least-recently-used eviction order.
+  uint64_t runtime_cache_tick_ = 0;
+  // Input shapes runtime_ was last reshaped for; empty until the first
+  // Prepare call with the runtime cache enabled.
+  std::vector<size_t> active_shape_key_;
   // Mapping from TFLite Tensor IDs for input/output tensors in the delegated
   // subgraph to their data locations.
   std::unordered_map<int, void*> externals_;
@@ -7539,6 +7684,25 @@ class Subgraph {
 };
 
 TfLiteIntArray* Delegate::PrepareOpsToDelegate(TfLiteContext* context) {
+  return PrepareOpsToDelegateImpl(context, /*try_cached_plan=*/true);
+}
+
+std::string Delegate::DelegationPlanId() const {
+  uint32_t features = options_.flags;
+  if (force_fp16()) {
+    features |= TFLITE_XNNPACK_DELEGATE_FLAG_FORCE_FP16;
+  }
+  if (enable_latest_operators()) {
+    features |= TFLITE_XNNPACK_DELEGATE_FLAG_ENABLE_LATEST_OPERATORS;
+  }
+  if (enable_subgraph_reshaping()) {
+    features |= TFLITE_XNNPACK_DELEGATE_FLAG_ENABLE_SUBGRAPH_RESHAPING;
+  }
+  return "XNNPackDelegationPlan_v1_" + std::to_string(features);
+}
+
+TfLiteIntArray* Delegate::PrepareOpsToDelegateImpl(TfLiteContext* context,
+                                                  bool try_cached_plan) {
   // Clear previous data, in case the delegate is reused without re-creation.
   static_unpacked_data_map_.clear();
   static_unpacked_data_.clear();
@@ -7552,6 +7716,25 @@ TfLiteIntArray* Delegate::PrepareOpsToDelegate(TfLiteContext* context) {
     return nullptr;
   }
 
+  // Try to reuse a delegation plan cached by a previous process. With a
+  // cached plan, membership in the plan replaces the per-node supportability
+  // analysis below. Models with variable operators are excluded because
+  // visiting every node is what associates variables with their tensors.
+  std::unordered_set<int> cached_plan;
+  bool use_cached_plan = false;
+  if (try_cached_plan && serialization_ != nullptr && !support_variable_ops()) {
+    TfLiteIntArray* cached_nodes = nullptr;
+    if (delegates::GetDelegatedNodes(context, serialization_.get(),
+                                     DelegationPlanId(),
+                                     &cached_nodes) == kTfLiteOk &&
+        cached_nodes != nullptr) {
+      cached_plan.insert(cached_nodes->data,
+                         cached_nodes->data + cached_nodes->size);
+      TfLiteIntArrayFree(cached_nodes);
+      use_cached_plan = true;
+    }
+  }
+
   // Mapping for quasi-static (unpacked from static) tensor index to the node
   // index that produced it.
   std::unordered_map<int, int> quasi_static_tensors_producers;
@@ -7659,10 +7842,15 @@ TfLiteIntArray* Delegate::PrepareOpsToDelegate(TfLiteContext* context) {
       variable_handles[node_index] = node->outputs->data[0];
     }
 
-    if (Subgraph::VisitNode(
-            /*subgraph=*/nullptr, /*delegate=*/*this, context, registration,
-            node, node_index, quasi_static_tensors,
-            std::unordered_map<int, uint32_t>()) != kTfLiteOk) {
+    const bool node_supported =
+        use_cached_plan
+            ? cached_plan.count(node_index) != 0
+            : Subgraph::VisitNode(/*subgraph=*/nullptr, /*delegate=*/*this,
+                                  context, registration, node, node_index,
+                                  quasi_static_tensors,
+                                  std::unordered_map<int, uint32_t>()) ==
+                  kTfLiteOk;
+    if (!node_supported) {
       // If a non-delegated node consumes output of a node that unpacks static
       // data, that node shouldn't be delegated.
       for (int j = 0; j < node->inputs->size; j++) {
@@ -7912,6 +8100,33 @@ TfLiteIntArray* Delegate::PrepareOpsToDelegate(TfLiteContext* context) {
   std::sort(&nodes_to_delegate->data[0],
             &nodes_to_delegate->data[nodes_to_delegate->size]);
 
+  if (use_cached_plan) {
+    // The replayed plan must match the cached one exactly; a mismatch means
+    // the cached plan is stale (e.g. the model changed under the same model
+    // token), so redo the full analysis.
+    bool plan_matches =
+        static_cast<size_t>(nodes_to_delegate->size) == cached_plan.size();
+    for (int i = 0; plan_matches && i < nodes_to_delegate->size; ++i) {
+      plan_matches = cached_plan.count(nodes_to_delegate->data[i]) != 0;
+    }
+    if (!plan_matches) {
+      TFLITE_LOG_PROD(tflite::TFLITE_LOG_WARNING,
+                      "Cached XNNPack delegation plan is stale, re-running "
+                      "the full partitioning analysis.");
+      TfLiteIntArrayFree(nodes_to_delegate);
+      return PrepareOpsToDelegateImpl(context, /*try_cached_plan=*/false);
+    }
+  } else if (serialization_ != nullptr && !support_variable_ops()) {
+    // Best-effort: a failure to persist the plan only costs the next cold
+    // start the full analysis again.
+    if (delegates::SaveDelegatedNodes(context, serialization_.get(),
+                                      DelegationPlanId(),
+                                      nodes_to_delegate) != kTfLiteOk) {
+      TFLITE_LOG_PROD(tflite::TFLITE_LOG_WARNING,
+                      "Failed to persist the XNNPack delegation plan.");
+    }
+  }
+
 #ifdef XNNPACK_DELEGATE_TEST_MODE
   // In the test mode build (used by unit tests), XNNPACK delegate claims to
   // support all operators in the execution plan to disable fallback to the
@@ -73,6 +73,32 @@ typedef struct {
   // To keep backwards compatibility with the previous caching mechanism, the
   // weight cache will only be loaded from this if `weight_cache` is undefined.
   const char* weight_cache_file_path;
+  // Directory where the delegation plan (the set of delegated nodes) is
+  // cached across process restarts, so that warm starts skip the per-node
+  // supportability analysis. Requires `model_token` to also be set. Ignored
+  // when TFLITE_XNNPACK_DELEGATE_FLAG_VARIABLE_OPERATORS is enabled.
+  // It is the client's responsibility to use an application-specific
+  // location; on Android, `getCodeCacheDir()` is recommended.
+  //
+  // WARNING: This API is experimental and subject to change.
+  const char* serialization_dir;
+  // Unique token identifying the model data, used to key the cached
+  // delegation plan. Must change whenever the model changes; clients can use
+  // tflite::delegates::StrFingerprint() on the flatbuffer to generate one.
+  //
+  // WARNING: This API is experimental and subject to change.
+  const char* model_token;
+  // Number of input-shape buckets for which compiled XNNPACK runtimes are
+  // kept alive per delegated partition. When inputs are resized among a
+  // small set of recurring shapes (e.g. a few aspect ratios), switching back
+  // to a previously seen shape reuses the runtime compiled for it instead of
+  // reshaping from scratch. Each bucket holds on to its intermediate-tensor
+  // workspace, so keep this small. 0 (the default) disables the cache.
+  // Only effective when TFLITE_XNNPACK_DELEGATE_FLAG_ENABLE_SUBGRAPH_RESHAPING
+  // is enabled; ignored for models with variable operators.
+  //
+  // WARNING: This API is experimental and subject to change.
+  size_t runtime_cache_capacity;
 } TfLiteXNNPackDelegateOptions;
 
 // Returns a structure with the default XNNPack delegate options.
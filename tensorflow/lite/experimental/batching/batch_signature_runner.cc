@@ -0,0 +1,112 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/batching/batch_signature_runner.h"
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/core/api/op_resolver.h"
+#include "tensorflow/lite/core/c/common.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/interpreter_builder.h"
+#include "tensorflow/lite/minimal_logging.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/signature_runner.h"
+
+namespace tflite {
+namespace batching {
+namespace {
+
+// Resizes the leading dimension of every input of `runner` to `batch_size`.
+TfLiteStatus ResizeInputsToBatchSize(SignatureRunner* runner, int batch_size) {
+  for (const char* input_name : runner->input_names()) {
+    const TfLiteTensor* input = runner->input_tensor(input_name);
+    if (input == nullptr) return kTfLiteError;
+    if (input->dims->size == 0) continue;  // Scalars have no batch dimension.
+    std::vector<int> dims(input->dims->data,
+                          input->dims->data + input->dims->size);
+    dims[0] = batch_size;
+    TF_LITE_ENSURE_STATUS(runner->ResizeInputTensor(input_name, dims));
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+std::unique_ptr<BatchSignatureRunner> BatchSignatureRunner::Create(
+    const FlatBufferModel& model, const OpResolver& op_resolver,
+    const char* signature_key, const std::vector<int>& batch_sizes) {
+  const std::set<int> sorted_batch_sizes(batch_sizes.begin(),
+                                         batch_sizes.end());
+  std::vector<Plan> plans;
+  plans.reserve(sorted_batch_sizes.size());
+  for (const int batch_size : sorted_batch_sizes) {
+    if (batch_size <= 0) {
+      TFLITE_LOG(TFLITE_LOG_ERROR,
+                 "BatchSignatureRunner: invalid batch size %d.", batch_size);
+      return nullptr;
+    }
+    Plan plan;
+    plan.batch_size = batch_size;
+    if (InterpreterBuilder(model, op_resolver)(&plan.interpreter) !=
+            kTfLiteOk ||
+        plan.interpreter == nullptr) {
+      TFLITE_LOG(TFLITE_LOG_ERROR,
+                 "BatchSignatureRunner: failed to build interpreter.");
+      return nullptr;
+    }
+    plan.runner = plan.interpreter->GetSignatureRunner(signature_key);
+    if (plan.runner == nullptr) {
+      TFLITE_LOG(TFLITE_LOG_ERROR,
+                 "BatchSignatureRunner: signature '%s' not found.",
+                 signature_key);
+      return nullptr;
+    }
+    if (ResizeInputsToBatchSize(plan.runner, batch_size) != kTfLiteOk ||
+        plan.runner->AllocateTensors() != kTfLiteOk) {
+      TFLITE_LOG(TFLITE_LOG_ERROR,
+                 "BatchSignatureRunner: failed to allocate tensors for "
+                 "batch size %d.",
+                 batch_size);
+      return nullptr;
+    }
+    plans.push_back(std::move(plan));
+  }
+  return std::unique_ptr<BatchSignatureRunner>(
+      new BatchSignatureRunner(std::move(plans)));
+}
+
+BatchSignatureRunner::BatchSignatureRunner(std::vector<Plan> plans)
+    : plans_(std::move(plans)) {}
+
+SignatureRunner* BatchSignatureRunner::GetRunnerForBatchSize(int batch_size) {
+  for (Plan& plan : plans_) {
+    if (plan.batch_size == batch_size) return plan.runner;
+  }
+  return nullptr;
+}
+
+int BatchSignatureRunner::SmallestPreparedBatchSize(int batch_size) const {
+  for (const Plan& plan : plans_) {
+    if (plan.batch_size >= batch_size) return plan.batch_size;
+  }
+  return 0;
+}
+
+}  // namespace batching
+}  // namespace tflite
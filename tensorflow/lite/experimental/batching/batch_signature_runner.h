@@ -0,0 +1,82 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_BATCHING_BATCH_SIGNATURE_RUNNER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_BATCHING_BATCH_SIGNATURE_RUNNER_H_
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/lite/core/api/op_resolver.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/signature_runner.h"
+
+namespace tflite {
+namespace batching {
+
+// Serves one model signature at a fixed set of batch sizes without paying
+// AllocateTensors() per request.
+//
+// Resizing a signature input re-plans the subgraph's memory arena and
+// re-prepares every kernel on the next AllocateTensors() call, which is too
+// expensive to run on the hot path when batch sizes vary per request. This
+// class prepares one SignatureRunner per batch size up front — each backed by
+// its own interpreter, all built from the same FlatBufferModel so the
+// read-only weight memory exists once — with the leading dimension of every
+// signature input resized to the batch size and tensors fully allocated.
+// Requests are then dispatched to the pre-allocated runner for their batch
+// size, and switching between batch sizes touches no allocations.
+//
+// WARNING: This is an experimental API and subject to change.
+class BatchSignatureRunner {
+ public:
+  // Creates a runner for `signature_key` prepared at each of `batch_sizes`
+  // (duplicates are ignored). `model` and `op_resolver` must outlive the
+  // returned object. Returns nullptr when the signature does not exist or an
+  // interpreter cannot be built and allocated for one of the batch sizes.
+  static std::unique_ptr<BatchSignatureRunner> Create(
+      const FlatBufferModel& model, const OpResolver& op_resolver,
+      const char* signature_key, const std::vector<int>& batch_sizes);
+
+  // Returns the pre-allocated SignatureRunner for exactly `batch_size`, or
+  // nullptr if that batch size was not prepared. The returned runner stays
+  // valid for the lifetime of this object; callers must not resize its
+  // inputs.
+  SignatureRunner* GetRunnerForBatchSize(int batch_size);
+
+  // Returns the smallest prepared batch size that can hold `batch_size`
+  // samples, or 0 if no prepared batch size is large enough. Callers can pad
+  // their request up to the returned size.
+  int SmallestPreparedBatchSize(int batch_size) const;
+
+ private:
+  // One prepared batch size: an interpreter with the signature's inputs
+  // resized and allocated, and the signature runner borrowed from it.
+  struct Plan {
+    int batch_size;
+    std::unique_ptr<Interpreter> interpreter;
+    SignatureRunner* runner;
+  };
+
+  explicit BatchSignatureRunner(std::vector<Plan> plans);
+
+  // Prepared batch sizes, sorted ascending by batch_size.
+  std::vector<Plan> plans_;
+};
+
+}  // namespace batching
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_BATCHING_BATCH_SIGNATURE_RUNNER_H_
@@ -0,0 +1,95 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/batching/batch_signature_runner.h"
+
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "tensorflow/lite/core/c/common.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/signature_runner.h"
+
+namespace tflite {
+namespace batching {
+namespace {
+
+// The "add" signature computes output_0 = x + 2 on a resizable 1-D input.
+constexpr char kModelPath[] = "tensorflow/lite/testdata/multi_signatures.bin";
+
+class BatchSignatureRunnerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    model_ = FlatBufferModel::BuildFromFile(kModelPath);
+    ASSERT_NE(model_, nullptr);
+  }
+
+  std::unique_ptr<FlatBufferModel> model_;
+  ops::builtin::BuiltinOpResolver resolver_;
+};
+
+TEST_F(BatchSignatureRunnerTest, InvokesPreparedBatchSizes) {
+  std::unique_ptr<BatchSignatureRunner> batch_runner =
+      BatchSignatureRunner::Create(*model_, resolver_, "add", {1, 2, 4});
+  ASSERT_NE(batch_runner, nullptr);
+
+  for (const int batch_size : {1, 2, 4}) {
+    SignatureRunner* runner = batch_runner->GetRunnerForBatchSize(batch_size);
+    ASSERT_NE(runner, nullptr);
+    TfLiteTensor* input = runner->input_tensor("x");
+    ASSERT_NE(input, nullptr);
+    ASSERT_EQ(input->dims->data[0], batch_size);
+    for (int i = 0; i < batch_size; ++i) {
+      input->data.f[i] = static_cast<float>(i);
+    }
+    ASSERT_EQ(runner->Invoke(), kTfLiteOk);
+    const TfLiteTensor* output = runner->output_tensor("output_0");
+    ASSERT_NE(output, nullptr);
+    for (int i = 0; i < batch_size; ++i) {
+      EXPECT_EQ(output->data.f[i], i + 2.f);
+    }
+  }
+}
+
+TEST_F(BatchSignatureRunnerTest, UnpreparedBatchSizeReturnsNull) {
+  std::unique_ptr<BatchSignatureRunner> batch_runner =
+      BatchSignatureRunner::Create(*model_, resolver_, "add", {1, 2, 4});
+  ASSERT_NE(batch_runner, nullptr);
+  EXPECT_EQ(batch_runner->GetRunnerForBatchSize(3), nullptr);
+}
+
+TEST_F(BatchSignatureRunnerTest, SmallestPreparedBatchSize) {
+  std::unique_ptr<BatchSignatureRunner> batch_runner =
+      BatchSignatureRunner::Create(*model_, resolver_, "add", {2, 4, 4, 1});
+  ASSERT_NE(batch_runner, nullptr);
+  EXPECT_EQ(batch_runner->SmallestPreparedBatchSize(1), 1);
+  EXPECT_EQ(batch_runner->SmallestPreparedBatchSize(3), 4);
+  EXPECT_EQ(batch_runner->SmallestPreparedBatchSize(4), 4);
+  EXPECT_EQ(batch_runner->SmallestPreparedBatchSize(5), 0);
+}
+
+TEST_F(BatchSignatureRunnerTest, UnknownSignatureFailsCreate) {
+  EXPECT_EQ(BatchSignatureRunner::Create(*model_, resolver_, "dummy", {1}),
+            nullptr);
+}
+
+TEST_F(BatchSignatureRunnerTest, InvalidBatchSizeFailsCreate) {
+  EXPECT_EQ(BatchSignatureRunner::Create(*model_, resolver_, "add", {0}),
+            nullptr);
+}
+
+}  // namespace
+}  // namespace batching
+}  // namespace tflite
@@ -0,0 +1,179 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/pipelining/pipelined_frame_runner.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/core/api/op_resolver.h"
+#include "tensorflow/lite/core/c/c_api_types.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/interpreter_builder.h"
+#include "tensorflow/lite/interpreter_options.h"
+#include "tensorflow/lite/minimal_logging.h"
+#include "tensorflow/lite/model_builder.h"
+
+namespace tflite {
+namespace pipelining {
+
+// One pipeline slot: an interpreter plus the worker thread that invokes it.
+struct PipelinedFrameRunner::Slot {
+  explicit Slot(std::unique_ptr<Interpreter> interpreter)
+      : interpreter(std::move(interpreter)) {
+    worker = std::thread([this] { Work(); });
+  }
+
+  ~Slot() {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      shutdown = true;
+    }
+    cv.notify_all();
+    worker.join();
+  }
+
+  // Asynchronously invokes the interpreter on the worker thread. Must not be
+  // called again before Wait() has returned.
+  void Invoke() {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      invoke_requested = true;
+      done = false;
+    }
+    cv.notify_all();
+  }
+
+  // Blocks until the invocation scheduled by Invoke() has finished and
+  // returns its status.
+  TfLiteStatus Wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return done; });
+    return status;
+  }
+
+  void Work() {
+    while (true) {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [this] { return invoke_requested || shutdown; });
+      if (invoke_requested) {
+        invoke_requested = false;
+        lock.unlock();
+        TfLiteStatus invoke_status = interpreter->Invoke();
+        lock.lock();
+        status = invoke_status;
+        done = true;
+        cv.notify_all();
+      } else if (shutdown) {
+        return;
+      }
+    }
+  }
+
+  std::unique_ptr<Interpreter> interpreter;
+  // The `consume` callback of the frame currently occupying this slot.
+  FrameFn consume;
+  bool has_pending_frame = false;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool invoke_requested = false;
+  bool done = true;
+  bool shutdown = false;
+  TfLiteStatus status = kTfLiteOk;
+  std::thread worker;
+};
+
+std::unique_ptr<PipelinedFrameRunner> PipelinedFrameRunner::Create(
+    const FlatBufferModel& model, const OpResolver& op_resolver,
+    const InterpreterOptions& options) {
+  const int depth = options.GetPipelineDepth();
+  std::vector<std::unique_ptr<Slot>> slots;
+  slots.reserve(depth);
+  for (int i = 0; i < depth; ++i) {
+    std::unique_ptr<Interpreter> interpreter;
+    if (InterpreterBuilder(model, op_resolver, &options)(&interpreter) !=
+            kTfLiteOk ||
+        interpreter == nullptr) {
+      TFLITE_LOG(TFLITE_LOG_ERROR,
+                 "PipelinedFrameRunner: failed to build interpreter.");
+      return nullptr;
+    }
+    if (depth > 1 && !interpreter->variables().empty()) {
+      TFLITE_LOG(TFLITE_LOG_ERROR,
+                 "PipelinedFrameRunner: stateful models (models with "
+                 "variable tensors) cannot be pipelined.");
+      return nullptr;
+    }
+    if (interpreter->AllocateTensors() != kTfLiteOk) {
+      TFLITE_LOG(TFLITE_LOG_ERROR,
+                 "PipelinedFrameRunner: failed to allocate tensors.");
+      return nullptr;
+    }
+    slots.push_back(std::make_unique<Slot>(std::move(interpreter)));
+  }
+  return std::unique_ptr<PipelinedFrameRunner>(
+      new PipelinedFrameRunner(std::move(slots)));
+}
+
+PipelinedFrameRunner::PipelinedFrameRunner(
+    std::vector<std::unique_ptr<Slot>> slots)
+    : slots_(std::move(slots)) {}
+
+PipelinedFrameRunner::~PipelinedFrameRunner() {
+  // Wait for in-flight frames so no worker touches its interpreter while the
+  // slots are destroyed. The `consume` callbacks are intentionally not run.
+  for (const std::unique_ptr<Slot>& slot : slots_) {
+    if (slot->has_pending_frame) slot->Wait();
+  }
+}
+
+TfLiteStatus PipelinedFrameRunner::Schedule(const FrameFn& fill,
+                                            FrameFn consume) {
+  Slot* slot = slots_[next_slot_].get();
+  next_slot_ = (next_slot_ + 1) % slots_.size();
+  const TfLiteStatus retired_status = RetireFrame(slot);
+  fill(slot->interpreter.get());
+  slot->consume = std::move(consume);
+  slot->has_pending_frame = true;
+  slot->Invoke();
+  return retired_status;
+}
+
+TfLiteStatus PipelinedFrameRunner::Drain() {
+  TfLiteStatus status = kTfLiteOk;
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    Slot* slot = slots_[(next_slot_ + i) % slots_.size()].get();
+    const TfLiteStatus slot_status = RetireFrame(slot);
+    if (status == kTfLiteOk) status = slot_status;
+  }
+  return status;
+}
+
+TfLiteStatus PipelinedFrameRunner::RetireFrame(Slot* slot) {
+  if (!slot->has_pending_frame) return kTfLiteOk;
+  const TfLiteStatus status = slot->Wait();
+  slot->has_pending_frame = false;
+  FrameFn consume = std::move(slot->consume);
+  slot->consume = nullptr;
+  if (status == kTfLiteOk && consume) consume(slot->interpreter.get());
+  return status;
+}
+
+}  // namespace pipelining
+}  // namespace tflite
@@ -0,0 +1,102 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_PIPELINING_PIPELINED_FRAME_RUNNER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_PIPELINING_PIPELINED_FRAME_RUNNER_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/lite/core/api/op_resolver.h"
+#include "tensorflow/lite/core/c/c_api_types.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/interpreter_options.h"
+#include "tensorflow/lite/model_builder.h"
+
+namespace tflite {
+namespace pipelining {
+
+// Overlaps the execution of consecutive frames of a streaming model across
+// cores.
+//
+// A single interpreter executes its node schedule serially, so on a
+// multi-core device a streaming model is bounded by single-frame latency.
+// This runner keeps a ring of pipeline slots, each owning an interpreter
+// built from the same FlatBufferModel and a worker thread, and processes up
+// to `InterpreterOptions::GetPipelineDepth()` consecutive frames in parallel,
+// one per slot. The interpreters share the model's read-only weight memory,
+// so the per-slot cost is one set of activation buffers. Frames always
+// retire in the order they were scheduled.
+//
+// Because frames execute concurrently, the model must be stateless: Create()
+// fails for models with variable tensors when the pipeline depth is larger
+// than one.
+//
+// WARNING: This is an experimental API and subject to change.
+class PipelinedFrameRunner {
+ public:
+  // Callback run on the scheduling thread to fill the input tensors of an
+  // interpreter before its frame runs, or to read the output tensors after
+  // the frame has finished.
+  using FrameFn = std::function<void(Interpreter*)>;
+
+  // Creates a runner with `options.GetPipelineDepth()` pipeline slots whose
+  // interpreters are built from `model` with `op_resolver` and `options`.
+  // `model` and `op_resolver` must outlive the runner. Returns nullptr when
+  // an interpreter cannot be built or the model is not supported.
+  static std::unique_ptr<PipelinedFrameRunner> Create(
+      const FlatBufferModel& model, const OpResolver& op_resolver,
+      const InterpreterOptions& options);
+
+  // Drains all in-flight frames, without running their `consume` callbacks.
+  ~PipelinedFrameRunner();
+
+  PipelinedFrameRunner(const PipelinedFrameRunner&) = delete;
+  PipelinedFrameRunner& operator=(const PipelinedFrameRunner&) = delete;
+
+  // Schedules one frame. `fill` runs on the calling thread to populate the
+  // input tensors of a free slot, after which the frame is invoked on the
+  // slot's worker thread. Blocks while all slots are busy, and runs the
+  // `consume` callback of the frame that previously occupied the slot before
+  // `fill`. Returns the status of that retired frame's invocation; its
+  // `consume` callback is not run when the invocation failed.
+  TfLiteStatus Schedule(const FrameFn& fill, FrameFn consume);
+
+  // Blocks until all in-flight frames have finished, running their `consume`
+  // callbacks in scheduling order. Returns the status of the first failed
+  // invocation, if any.
+  TfLiteStatus Drain();
+
+ private:
+  struct Slot;
+
+  explicit PipelinedFrameRunner(
+      std::vector<std::unique_ptr<Slot>> slots);
+
+  // Waits for the in-flight frame of `slot`, if any, and runs its `consume`
+  // callback on the calling thread.
+  TfLiteStatus RetireFrame(Slot* slot);
+
+  std::vector<std::unique_ptr<Slot>> slots_;
+  // The slot the next frame is scheduled on. Slots are used round-robin, so
+  // the frame retired when a slot is reused is always the oldest one.
+  size_t next_slot_ = 0;
+};
+
+}  // namespace pipelining
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_PIPELINING_PIPELINED_FRAME_RUNNER_H_
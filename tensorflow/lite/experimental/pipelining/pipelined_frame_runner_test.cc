@@ -0,0 +1,129 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/pipelining/pipelined_frame_runner.h"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tensorflow/lite/core/c/c_api_types.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/interpreter_options.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+
+namespace tflite {
+namespace pipelining {
+namespace {
+
+// The test model computes output = input + input + input on a [1, 8, 8, 3]
+// float tensor.
+constexpr char kModelPath[] = "tensorflow/lite/testdata/add.bin";
+constexpr int kNumElements = 1 * 8 * 8 * 3;
+
+class PipelinedFrameRunnerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    model_ = FlatBufferModel::BuildFromFile(kModelPath);
+    ASSERT_NE(model_, nullptr);
+  }
+
+  std::unique_ptr<PipelinedFrameRunner> CreateRunner(int depth) {
+    InterpreterOptions options;
+    options.SetPipelineDepth(depth);
+    return PipelinedFrameRunner::Create(*model_, resolver_, options);
+  }
+
+  // Schedules `num_frames` frames where frame `f` feeds the constant `f` and
+  // returns the first output element of each frame, in retirement order.
+  std::vector<float> RunFrames(PipelinedFrameRunner* runner, int num_frames) {
+    std::vector<float> results;
+    for (int f = 0; f < num_frames; ++f) {
+      EXPECT_EQ(runner->Schedule(
+                    [f](Interpreter* interpreter) {
+                      float* input = interpreter->typed_input_tensor<float>(0);
+                      for (int i = 0; i < kNumElements; ++i) {
+                        input[i] = static_cast<float>(f);
+                      }
+                    },
+                    [&results](Interpreter* interpreter) {
+                      results.push_back(
+                          interpreter->typed_output_tensor<float>(0)[0]);
+                    }),
+                kTfLiteOk);
+    }
+    EXPECT_EQ(runner->Drain(), kTfLiteOk);
+    return results;
+  }
+
+  std::unique_ptr<FlatBufferModel> model_;
+  ops::builtin::BuiltinOpResolver resolver_;
+};
+
+TEST_F(PipelinedFrameRunnerTest, FramesRetireInOrder) {
+  std::unique_ptr<PipelinedFrameRunner> runner = CreateRunner(/*depth=*/3);
+  ASSERT_NE(runner, nullptr);
+
+  constexpr int kNumFrames = 16;
+  std::vector<float> results = RunFrames(runner.get(), kNumFrames);
+
+  ASSERT_EQ(results.size(), kNumFrames);
+  for (int f = 0; f < kNumFrames; ++f) {
+    EXPECT_EQ(results[f], 3.f * f);
+  }
+}
+
+TEST_F(PipelinedFrameRunnerTest, DepthOneRunsSerially) {
+  std::unique_ptr<PipelinedFrameRunner> runner = CreateRunner(/*depth=*/1);
+  ASSERT_NE(runner, nullptr);
+
+  std::vector<float> results = RunFrames(runner.get(), /*num_frames=*/4);
+
+  ASSERT_EQ(results.size(), 4);
+  for (int f = 0; f < 4; ++f) {
+    EXPECT_EQ(results[f], 3.f * f);
+  }
+}
+
+TEST_F(PipelinedFrameRunnerTest, DrainIsIdempotent) {
+  std::unique_ptr<PipelinedFrameRunner> runner = CreateRunner(/*depth=*/2);
+  ASSERT_NE(runner, nullptr);
+
+  std::vector<float> results = RunFrames(runner.get(), /*num_frames=*/3);
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_EQ(runner->Drain(), kTfLiteOk);
+}
+
+TEST_F(PipelinedFrameRunnerTest, DestructorDropsPendingConsumeCallbacks) {
+  std::unique_ptr<PipelinedFrameRunner> runner = CreateRunner(/*depth=*/2);
+  ASSERT_NE(runner, nullptr);
+
+  bool consumed = false;
+  EXPECT_EQ(runner->Schedule(
+                [](Interpreter* interpreter) {
+                  float* input = interpreter->typed_input_tensor<float>(0);
+                  for (int i = 0; i < kNumElements; ++i) {
+                    input[i] = 1.f;
+                  }
+                },
+                [&consumed](Interpreter*) { consumed = true; }),
+            kTfLiteOk);
+  runner.reset();
+  EXPECT_FALSE(consumed);
+}
+
+}  // namespace
+}  // namespace pipelining
+}  // namespace tflite
@@ -103,12 +103,46 @@ class InterpreterOptions {
     return experimental_cache_constant_cast_op_;
   }
 
+  /// Shares one non-persistent memory arena among control flow subgraphs that
+  /// can never be in flight at the same time (e.g. the bodies of unrelated
+  /// WHILE ops). This reduces the peak activation memory of models with many
+  /// control flow ops, at the cost of re-resolving tensor allocations when
+  /// the shared arena has been resized by another subgraph.
+  /// WARNING: This is an experimental API and subject to change.
+  void SetShareArenaAcrossSubgraphs(bool value = true) {
+    experimental_share_arena_across_subgraphs_ = value;
+  }
+
+  /// Returns if the `experimental_share_arena_across_subgraphs_` feature is
+  /// enabled.
+  /// WARNING: This is an experimental API and subject to change.
+  bool GetShareArenaAcrossSubgraphs() const {
+    return experimental_share_arena_across_subgraphs_;
+  }
+
+  /// Sets the number of consecutive frames of a streaming model that
+  /// `tflite::pipelining::PipelinedFrameRunner` may process in parallel. The
+  /// default of 1 processes frames serially.
+  /// WARNING: This is an experimental API and subject to change.
+  void SetPipelineDepth(int value) {
+    if (value > 0) {
+      experimental_pipeline_depth_ = value;
+    }
+  }
+
+  /// Returns the pipeline depth used by
+  /// `tflite::pipelining::PipelinedFrameRunner`.
+  /// WARNING: This is an experimental API and subject to change.
+  int GetPipelineDepth() const { return experimental_pipeline_depth_; }
+
  private:
   bool experimental_preserve_all_tensors_ = false;
   bool experimental_ensure_dynamic_tensors_are_released_ = false;
   int experimental_optimize_memory_for_large_tensors_ = 0;
   bool experimental_disable_delegate_clustering_ = false;
   bool experimental_cache_constant_cast_op_ = false;
+  bool experimental_share_arena_across_subgraphs_ = false;
+  int experimental_pipeline_depth_ = 1;
 };
 
 }  // namespace tflite
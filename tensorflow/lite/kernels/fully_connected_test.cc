@@ -2339,6 +2339,54 @@ TEST_P(SparseQuantizedFullyConnectedOpTest, Simple1x16TestScaledInputOutput) {
   EXPECT_THAT(m.GetOutput(), ElementsAre(-52, -50, -52));
 }
 
+TEST_P(SparseQuantizedFullyConnectedOpTest, Simple1x16TestMultiThreaded) {
+  // 16 units; odd rows are entirely zero, even row u is filled with
+  // 1 + (u / 2) % 2 so that neighboring non-zero rows carry different
+  // weights. A single batch exercises the row-sliced multi-threaded kernel,
+  // three batches exercise the batch-sliced one.
+  std::vector<float> weight_data(16 * 16, 0);
+  for (int u = 0; u < 16; u += 2) {
+    std::fill(weight_data.begin() + u * 16, weight_data.begin() + (u + 1) * 16,
+              static_cast<float>(1 + (u / 2) % 2));
+  }
+  TensorData weight = {TensorType_INT8, {16, 16}, 0, 0, 1};
+  weight.traversal_order = {0, 1, 2};
+  weight.format = {kTfLiteDimDense, kTfLiteDimSparseCSR};
+  weight.block_map = {1};
+  weight.block_size = {16};
+  for (int num_threads = 1; num_threads <= 4; ++num_threads) {
+    for (int batches : {1, 3}) {
+      SparseQuantizedFullyConnectedOpModel m(
+          GetRegistration(),
+          /*units=*/16, /*batches=*/batches,
+          /*input=*/{TensorType_INT8, {batches, 16}, 0, 0, 1}, weight,
+          weight_data,
+          /*output=*/{TensorType_INT8, {}, 0, 0, 1},
+          /*bias_tensor_optional=*/false, /*num_threads=*/num_threads);
+      std::vector<float> bias(16);
+      for (int u = 0; u < 16; ++u) bias[u] = u;
+      std::vector<float> input;
+      for (int b = 0; b < batches; ++b) {
+        input.insert(input.end(), 16, static_cast<float>(b + 1));
+      }
+      m.SetBias(bias);
+      m.SetInput(input);
+
+      ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+      std::vector<int8_t> expected;
+      for (int b = 0; b < batches; ++b) {
+        for (int u = 0; u < 16; ++u) {
+          const int weight_value = u % 2 == 0 ? 1 + (u / 2) % 2 : 0;
+          expected.push_back(16 * weight_value * (b + 1) + u);
+        }
+      }
+      EXPECT_THAT(m.GetOutputShape(), ElementsAre(batches, 16));
+      EXPECT_THAT(m.GetOutput(), ElementsAreArray(expected));
+    }
+  }
+}
+
 TEST_P(SparseQuantizedFullyConnectedOpTest,
        Simple1x16PerChannelQuantizationTest) {
   std::vector<float> weight_data = {
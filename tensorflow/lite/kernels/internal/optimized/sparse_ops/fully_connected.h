@@ -77,21 +77,26 @@ inline void FullyConnectedSparseWeight(
   }
 }
 
+// Computes output rows [row_start, row_end) for batches
+// [batch_start, batch_end). Slicing along the output rows is only valid for a
+// single batch, since the underlying kernel lays out its results contiguously
+// per batch.
 inline void FullyConnectedSparseWeight1x16Impl(
     const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
     const RuntimeShape& input_shape, const int8_t* input_data,
     const RuntimeShape& weights_shape, const int8_t* weights_data,
     const int32_t* per_channel_scale, const int32_t* per_channel_shift,
     const RuntimeShape& bias_shape, const int32_t* bias_data,
-    const RuntimeShape& output_shape, int8_t* output_data, int thread_start,
-    int thread_end, const CpuBackendContext& cpu_backend_context) {
+    const RuntimeShape& output_shape, int8_t* output_data, int batch_start,
+    int batch_end, int row_start, int row_end,
+    const CpuBackendContext& cpu_backend_context) {
   ruy::profiler::ScopeLabel label("FullyConnected");
   ruy::profiler::ScopeLabel inner_label("1x16 Block Sparse");
 
   const int input_dims_count = input_shape.DimensionsCount();
   const int output_dims_count = output_shape.DimensionsCount();
   const int weights_dims_count = weights_shape.DimensionsCount();
-  const int batches = thread_end - thread_start;
+  const int batches = batch_end - batch_start;
   const int input_depth = MatchingDim(weights_shape, weights_dims_count - 1,
                                       input_shape, input_dims_count - 1);
   const int output_depth = MatchingDim(weights_shape, weights_dims_count - 2,
@@ -106,12 +111,20 @@ inline void FullyConnectedSparseWeight1x16Impl(
   const int* w1_segments = sparsity.dim_metadata[1].array_segments->data;
   const int* w1_indices = sparsity.dim_metadata[1].array_indices->data;
 
+  // The weights of row `row_start` start at its first non-zero block. The
+  // segment values stay absolute offsets into `w1_indices`, so only the
+  // weights pointer needs adjusting.
+  constexpr int kBlockSize = 16;
   tensor_utils::SparseMatrixBatchVectorMultiplyAccumulate1x16(
-      weights_data, w1_segments, w1_indices, weights_shape.Dims(0),
-      weights_shape.Dims(1), input_data + thread_start * input_depth, bias_data,
-      batches, input_offset, output_multiplier, output_shift, per_channel_scale,
-      per_channel_shift, output_offset, output_activation_min,
-      output_activation_max, output_data + thread_start * output_depth);
+      weights_data + w1_segments[row_start] * kBlockSize,
+      w1_segments + row_start, w1_indices, row_end - row_start,
+      weights_shape.Dims(1), input_data + batch_start * input_depth,
+      bias_data != nullptr ? bias_data + row_start : nullptr, batches,
+      input_offset, output_multiplier, output_shift,
+      per_channel_scale != nullptr ? per_channel_scale + row_start : nullptr,
+      per_channel_shift != nullptr ? per_channel_shift + row_start : nullptr,
+      output_offset, output_activation_min, output_activation_max,
+      output_data + batch_start * output_depth + row_start);
 }
 
 inline void FullyConnectedSparseWeight1x4Impl(
@@ -198,6 +211,67 @@ struct FullyConnectedSparseWeight1x4Task : cpu_backend_threadpool::Task {
   const CpuBackendContext& cpu_backend_context;
 };
 
+struct FullyConnectedSparseWeight1x16Task : cpu_backend_threadpool::Task {
+  FullyConnectedSparseWeight1x16Task(
+      const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
+      const RuntimeShape& input_shape, const int8_t* input_data,
+      const RuntimeShape& weights_shape, const int8_t* weights_data,
+      const int32_t* per_channel_scale, const int32_t* per_channel_shift,
+      const RuntimeShape& bias_shape, const int32_t* bias_data,
+      const RuntimeShape& output_shape, int8_t* output_data, int batch_start,
+      int batch_end, int row_start, int row_end,
+      const CpuBackendContext& cpu_backend_context_x)
+      : sparsity(sparsity),
+        params(params),
+        input_shape(input_shape),
+        input_data(input_data),
+        weights_shape(weights_shape),
+        weights_data(weights_data),
+        per_channel_scale(per_channel_scale),
+        per_channel_shift(per_channel_shift),
+        bias_shape(bias_shape),
+        bias_data(bias_data),
+        output_shape(output_shape),
+        output_data(output_data),
+        batch_start(batch_start),
+        batch_end(batch_end),
+        row_start(row_start),
+        row_end(row_end),
+        cpu_backend_context(cpu_backend_context_x) {}
+
+  void Run() override {
+    FullyConnectedSparseWeight1x16Impl(
+        sparsity, params, input_shape, input_data, weights_shape, weights_data,
+        per_channel_scale, per_channel_shift, bias_shape, bias_data,
+        output_shape, output_data, batch_start, batch_end, row_start, row_end,
+        cpu_backend_context);
+  }
+
+ private:
+  const TfLiteSparsity& sparsity;
+  const FullyConnectedParams& params;
+  const RuntimeShape& input_shape;
+  const int8_t* input_data;
+  const RuntimeShape& weights_shape;
+  const int8_t* weights_data;
+  const int32_t* per_channel_scale;
+  const int32_t* per_channel_shift;
+  const RuntimeShape& bias_shape;
+  const int32_t* bias_data;
+  const RuntimeShape& output_shape;
+  int8_t* output_data;
+  int batch_start;
+  int batch_end;
+  int row_start;
+  int row_end;
+  const CpuBackendContext& cpu_backend_context;
+};
+
+// The multi-threaded kernel slices batched workloads along the batch
+// dimension, like the 1x4 float kernel above. Single-batch (streaming)
+// workloads are sliced along the output rows instead: every output row only
+// reads its own weight blocks, so rows are independent, and slicing along
+// rows is what lets a batch-of-one inference use more than one core.
 inline void FullyConnectedSparseWeight1x16(
     const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
     const RuntimeShape& input_shape, const int8_t* input_data,
@@ -211,12 +285,50 @@ inline void FullyConnectedSparseWeight1x16(
 
   const int batches =
       FlatSizeSkipDim(output_shape, output_shape.DimensionsCount() - 1);
+  const int output_depth =
+      MatchingDim(weights_shape, weights_shape.DimensionsCount() - 2,
+                  output_shape, output_shape.DimensionsCount() - 1);
+  const int max_threads = cpu_backend_context->max_num_threads();
+
+  // Keep enough rows per thread for the per-task fixed costs to amortize.
+  constexpr int kMinRowsPerThread = 8;
+  const int thread_count =
+      batches == 1
+          ? std::max(1, std::min(max_threads, output_depth / kMinRowsPerThread))
+          : std::max(1, std::min(max_threads, batches));
+  if (thread_count == 1) {
+    return FullyConnectedSparseWeight1x16Impl(
+        sparsity, params, input_shape, input_data, weights_shape, weights_data,
+        per_channel_scale, per_channel_shift, bias_shape, bias_data,
+        output_shape, output_data, 0, batches, 0, output_depth,
+        *cpu_backend_context);
+  }
+
+  std::vector<FullyConnectedSparseWeight1x16Task> tasks;
+  tasks.reserve(thread_count);
+  const int split_size = batches == 1 ? output_depth : batches;
+  int split_start = 0;
+  for (int i = 0; i < thread_count; ++i) {
+    // This makes sure the workload is relatively balanced when the split
+    // dimension is not a multiple of thread_count. The first
+    // mod(split_size, thread_count) tasks need to process one more slice than
+    // the rest.
+    int split_end = split_start + split_size / thread_count;
+    if (i < split_size % thread_count) split_end++;
 
-  // TODO(b/220851507): Add multi-thread support for quantized sparse kernel.
-  return FullyConnectedSparseWeight1x16Impl(
-      sparsity, params, input_shape, input_data, weights_shape, weights_data,
-      per_channel_scale, per_channel_shift, bias_shape, bias_data, output_shape,
-      output_data, 0, batches, *cpu_backend_context);
+    const int batch_start = batches == 1 ? 0 : split_start;
+    const int batch_end = batches == 1 ? 1 : split_end;
+    const int row_start = batches == 1 ? split_start : 0;
+    const int row_end = batches == 1 ? split_end : output_depth;
+    tasks.emplace_back(sparsity, params, input_shape, input_data, weights_shape,
+                       weights_data, per_channel_scale, per_channel_shift,
+                       bias_shape, bias_data, output_shape, output_data,
+                       batch_start, batch_end, row_start, row_end,
+                       *cpu_backend_context);
+    split_start = split_end;
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
 }
 
 // The multi-threaded kernel slices the workload along the batch dimension. If
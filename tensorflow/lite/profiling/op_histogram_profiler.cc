@@ -0,0 +1,214 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/profiling/op_histogram_profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "tensorflow/lite/core/api/profiler.h"
+#include "tensorflow/lite/profiling/memory_info.h"
+#include "tensorflow/lite/profiling/time.h"
+
+namespace tflite::profiling {
+namespace {
+
+// Key layout: bit 62 marks delegate-profiled events, bits 32-61 hold the
+// subgraph index and bits 0-31 the node index. Bit 63 stays clear so valid
+// keys never collide with Slot::kEmptyKey.
+constexpr int kDelegateKeyBit = 62;
+
+int DurationBucket(uint64_t duration_us) {
+  int bucket = 0;
+  for (uint64_t d = duration_us >> 1;
+       d != 0 && bucket < OpHistogramProfiler::kNumDurationBuckets - 1;
+       d >>= 1) {
+    ++bucket;
+  }
+  return bucket;
+}
+
+}  // namespace
+
+OpHistogramProfiler::OpHistogramProfiler(int sampling_interval,
+                                         size_t max_num_ops)
+    : sampling_interval_(std::max(sampling_interval, 1)),
+      slots_(std::max<size_t>(max_num_ops, 1)) {}
+
+int64_t OpHistogramProfiler::MakeKey(int64_t subgraph_index,
+                                     int64_t node_index, bool is_delegate_op) {
+  int64_t key = (subgraph_index & 0x3FFFFFFF) << 32 |
+                (node_index & 0xFFFFFFFF);
+  if (is_delegate_op) {
+    key |= int64_t{1} << kDelegateKeyBit;
+  }
+  return key;
+}
+
+bool OpHistogramProfiler::ShouldSample() {
+  return event_counter_.fetch_add(1, std::memory_order_relaxed) %
+             sampling_interval_ ==
+         0;
+}
+
+uint32_t OpHistogramProfiler::BeginEvent(const char* tag, EventType event_type,
+                                         int64_t event_metadata1,
+                                         int64_t event_metadata2) {
+  if (event_type != EventType::OPERATOR_INVOKE_EVENT || !ShouldSample()) {
+    return 0;
+  }
+  for (int i = 0; i < kMaxPendingEvents; ++i) {
+    PendingEvent& event = pending_events_[i];
+    bool expected = false;
+    if (event.in_use.compare_exchange_strong(expected, true,
+                                             std::memory_order_acquire)) {
+      event.key = MakeKey(/*subgraph_index=*/event_metadata2,
+                          /*node_index=*/event_metadata1,
+                          /*is_delegate_op=*/false);
+      event.begin_in_use_bytes =
+          memory::GetMemoryUsage().in_use_allocated_bytes;
+      event.begin_time_us = time::NowMicros();
+      return i + 1;
+    }
+  }
+  dropped_events_.fetch_add(1, std::memory_order_relaxed);
+  return 0;
+}
+
+void OpHistogramProfiler::EndEvent(uint32_t event_handle) {
+  if (event_handle == 0 || event_handle > kMaxPendingEvents) {
+    return;
+  }
+  PendingEvent& event = pending_events_[event_handle - 1];
+  const uint64_t duration_us = time::NowMicros() - event.begin_time_us;
+  const size_t end_in_use_bytes =
+      memory::GetMemoryUsage().in_use_allocated_bytes;
+  int64_t in_use_bytes_delta = 0;
+  if (event.begin_in_use_bytes != memory::MemoryUsage::kValueNotSet &&
+      end_in_use_bytes != memory::MemoryUsage::kValueNotSet) {
+    in_use_bytes_delta = static_cast<int64_t>(end_in_use_bytes) -
+                         static_cast<int64_t>(event.begin_in_use_bytes);
+  }
+  RecordEvent(event.key, duration_us, in_use_bytes_delta);
+  event.in_use.store(false, std::memory_order_release);
+}
+
+void OpHistogramProfiler::AddEvent(const char* tag, EventType event_type,
+                                   uint64_t metric, int64_t event_metadata1,
+                                   int64_t event_metadata2) {
+  if (event_type != EventType::DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT ||
+      !ShouldSample()) {
+    return;
+  }
+  RecordEvent(MakeKey(/*subgraph_index=*/event_metadata2,
+                      /*node_index=*/event_metadata1,
+                      /*is_delegate_op=*/true),
+              /*duration_us=*/metric, /*in_use_bytes_delta=*/0);
+}
+
+OpHistogramProfiler::Slot* OpHistogramProfiler::FindOrClaimSlot(int64_t key) {
+  // Fibonacci hashing spreads the (subgraph, node) keys over the table; the
+  // linear probe visits every slot before giving up.
+  const size_t start =
+      (static_cast<uint64_t>(key) * UINT64_C(0x9E3779B97F4A7C15)) %
+      slots_.size();
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    Slot& slot = slots_[(start + i) % slots_.size()];
+    int64_t slot_key = slot.key.load(std::memory_order_acquire);
+    if (slot_key == key) {
+      return &slot;
+    }
+    if (slot_key == Slot::kEmptyKey &&
+        slot.key.compare_exchange_strong(slot_key, key,
+                                         std::memory_order_acq_rel)) {
+      return &slot;
+    }
+    // Another thread claimed this slot concurrently; it may have claimed it
+    // for the same key.
+    if (slot.key.load(std::memory_order_acquire) == key) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+void OpHistogramProfiler::RecordEvent(int64_t key, uint64_t duration_us,
+                                      int64_t in_use_bytes_delta) {
+  Slot* slot = FindOrClaimSlot(key);
+  if (slot == nullptr) {
+    dropped_events_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  slot->num_events.fetch_add(1, std::memory_order_relaxed);
+  slot->total_duration_us.fetch_add(duration_us, std::memory_order_relaxed);
+  slot->total_in_use_bytes_delta.fetch_add(in_use_bytes_delta,
+                                           std::memory_order_relaxed);
+  slot->duration_buckets[DurationBucket(duration_us)].fetch_add(
+      1, std::memory_order_relaxed);
+  uint64_t max = slot->max_duration_us.load(std::memory_order_relaxed);
+  while (duration_us > max &&
+         !slot->max_duration_us.compare_exchange_weak(
+             max, duration_us, std::memory_order_relaxed)) {
+  }
+}
+
+std::vector<OpHistogramProfiler::OpStats> OpHistogramProfiler::SnapshotStats()
+    const {
+  std::vector<OpStats> stats;
+  for (const Slot& slot : slots_) {
+    const int64_t key = slot.key.load(std::memory_order_acquire);
+    if (key == Slot::kEmptyKey) {
+      continue;
+    }
+    OpStats op_stats;
+    op_stats.subgraph_index = static_cast<int>((key >> 32) & 0x3FFFFFFF);
+    op_stats.node_index = static_cast<int>(key & 0xFFFFFFFF);
+    op_stats.is_delegate_op = (key >> kDelegateKeyBit) & 1;
+    op_stats.num_events = slot.num_events.load(std::memory_order_relaxed);
+    if (op_stats.num_events == 0) {
+      // The slot was claimed but its first event is not recorded yet.
+      continue;
+    }
+    op_stats.total_duration_us =
+        slot.total_duration_us.load(std::memory_order_relaxed);
+    op_stats.max_duration_us =
+        slot.max_duration_us.load(std::memory_order_relaxed);
+    op_stats.total_in_use_bytes_delta =
+        slot.total_in_use_bytes_delta.load(std::memory_order_relaxed);
+    for (int i = 0; i < kNumDurationBuckets; ++i) {
+      op_stats.duration_buckets[i] =
+          slot.duration_buckets[i].load(std::memory_order_relaxed);
+    }
+    stats.push_back(op_stats);
+  }
+  std::sort(stats.begin(), stats.end(),
+            [](const OpStats& a, const OpStats& b) {
+              if (a.subgraph_index != b.subgraph_index) {
+                return a.subgraph_index < b.subgraph_index;
+              }
+              if (a.node_index != b.node_index) {
+                return a.node_index < b.node_index;
+              }
+              return a.is_delegate_op < b.is_delegate_op;
+            });
+  return stats;
+}
+
+uint64_t OpHistogramProfiler::num_dropped_events() const {
+  return dropped_events_.load(std::memory_order_relaxed);
+}
+
+}  // namespace tflite::profiling
@@ -0,0 +1,151 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_PROFILING_OP_HISTOGRAM_PROFILER_H_
+#define TENSORFLOW_LITE_PROFILING_OP_HISTOGRAM_PROFILER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "tensorflow/lite/core/api/profiler.h"
+
+namespace tflite::profiling {
+
+// Always-on, sampled per-operator latency and memory statistics.
+//
+// Unlike the BufferedProfiler, which buffers individual events for post-hoc
+// summarization by benchmark tools, this profiler aggregates operator invoke
+// events into fixed-size per-operator histograms that a serving process can
+// export continuously. Recording only touches atomic counters (no locks, no
+// allocation after construction), and SnapshotStats() reads those counters
+// without pausing inference, so the profiler can stay attached to production
+// interpreters via Interpreter::SetProfiler(). The per-inference overhead is
+// further bounded by only recording every `sampling_interval`-th event.
+class OpHistogramProfiler : public tflite::Profiler {
+ public:
+  // Durations are bucketed with power-of-two boundaries: bucket `i` counts
+  // events that took [2^i, 2^(i+1)) microseconds, with bucket 0 also
+  // absorbing sub-microsecond events and the last bucket absorbing
+  // everything at or above 2^(kNumDurationBuckets-1) microseconds.
+  static constexpr int kNumDurationBuckets = 20;
+
+  struct OpStats {
+    // Subgraph and node the statistics belong to. For delegate-profiled
+    // events the node index is internal to the delegate.
+    int subgraph_index = 0;
+    int node_index = 0;
+    bool is_delegate_op = false;
+    // Number of sampled events aggregated into the fields below.
+    uint64_t num_events = 0;
+    uint64_t total_duration_us = 0;
+    uint64_t max_duration_us = 0;
+    // Summed change in in-use allocated bytes across the sampled events.
+    // Only meaningful on platforms where memory usage is supported (see
+    // memory::MemoryUsage::IsSupported()); 0 otherwise.
+    int64_t total_in_use_bytes_delta = 0;
+    uint64_t duration_buckets[kNumDurationBuckets] = {};
+  };
+
+  // Every `sampling_interval`-th operator event is recorded; 1 records all
+  // of them. `max_num_ops` bounds the per-operator table; events for
+  // additional operators are dropped once it fills up (see
+  // num_dropped_events()).
+  explicit OpHistogramProfiler(int sampling_interval = 1,
+                               size_t max_num_ops = 1024);
+
+  uint32_t BeginEvent(const char* tag, EventType event_type,
+                      int64_t event_metadata1,
+                      int64_t event_metadata2) override;
+
+  void EndEvent(uint32_t event_handle) override;
+
+  // Aggregates delegate-profiled operator events (e.g. the per-operator
+  // timings reported by the XNNPACK delegate); `metric` is the elapsed time
+  // in microseconds.
+  void AddEvent(const char* tag, EventType event_type, uint64_t metric,
+                int64_t event_metadata1, int64_t event_metadata2) override;
+
+  // Returns a copy of the per-operator statistics collected so far, ordered
+  // by subgraph index then node index. Safe to call from any thread while
+  // inference is running; events still in flight show up in a later
+  // snapshot.
+  std::vector<OpStats> SnapshotStats() const;
+
+  // Number of events lost because the per-operator table or the in-flight
+  // event table was full. Events skipped by sampling are not counted.
+  uint64_t num_dropped_events() const;
+
+ private:
+  // Upper bound on concurrently outstanding BeginEvent/EndEvent pairs.
+  static constexpr int kMaxPendingEvents = 32;
+
+  // One operator's aggregated statistics. The slot is claimed by storing the
+  // operator key with compare-and-swap; all counters are updated with
+  // relaxed atomics, which keeps recording wait-free at the cost of snapshot
+  // fields (e.g. the bucket counts and num_events) being only eventually
+  // consistent with each other.
+  struct Slot {
+    static constexpr int64_t kEmptyKey = -1;
+
+    Slot() {
+      for (std::atomic<uint64_t>& bucket : duration_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    std::atomic<int64_t> key{kEmptyKey};
+    std::atomic<uint64_t> num_events{0};
+    std::atomic<uint64_t> total_duration_us{0};
+    std::atomic<uint64_t> max_duration_us{0};
+    std::atomic<int64_t> total_in_use_bytes_delta{0};
+    std::atomic<uint64_t> duration_buckets[kNumDurationBuckets];
+  };
+
+  // An in-flight event between BeginEvent and EndEvent. The non-atomic
+  // fields are published by the acquire/release operations on `in_use`.
+  struct PendingEvent {
+    std::atomic<bool> in_use{false};
+    int64_t key = 0;
+    uint64_t begin_time_us = 0;
+    size_t begin_in_use_bytes = 0;
+  };
+
+  // Folds the subgraph index, node index and the delegate marker into the
+  // slot key.
+  static int64_t MakeKey(int64_t subgraph_index, int64_t node_index,
+                         bool is_delegate_op);
+
+  // Returns the slot aggregating statistics for `key`, claiming an empty one
+  // if needed, or nullptr when the table is full.
+  Slot* FindOrClaimSlot(int64_t key);
+
+  // Folds one sampled event into the slot for `key`.
+  void RecordEvent(int64_t key, uint64_t duration_us,
+                   int64_t in_use_bytes_delta);
+
+  // Returns true if the current event should be recorded.
+  bool ShouldSample();
+
+  const int sampling_interval_;
+  std::vector<Slot> slots_;
+  PendingEvent pending_events_[kMaxPendingEvents];
+  std::atomic<uint64_t> event_counter_{0};
+  std::atomic<uint64_t> dropped_events_{0};
+};
+
+}  // namespace tflite::profiling
+
+#endif  // TENSORFLOW_LITE_PROFILING_OP_HISTOGRAM_PROFILER_H_
@@ -0,0 +1,141 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/profiling/op_histogram_profiler.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tensorflow/lite/core/api/profiler.h"
+
+namespace tflite::profiling {
+namespace {
+
+uint64_t SumOfBuckets(const OpHistogramProfiler::OpStats& stats) {
+  uint64_t sum = 0;
+  for (uint64_t bucket : stats.duration_buckets) {
+    sum += bucket;
+  }
+  return sum;
+}
+
+TEST(OpHistogramProfilerTest, RecordsOperatorInvokeEvents) {
+  OpHistogramProfiler profiler;
+  for (int i = 0; i < 4; ++i) {
+    const uint32_t handle = profiler.BeginEvent(
+        "MyOp", Profiler::EventType::OPERATOR_INVOKE_EVENT,
+        /*event_metadata1=*/3, /*event_metadata2=*/1);
+    profiler.EndEvent(handle);
+  }
+
+  const std::vector<OpHistogramProfiler::OpStats> stats =
+      profiler.SnapshotStats();
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats[0].subgraph_index, 1);
+  EXPECT_EQ(stats[0].node_index, 3);
+  EXPECT_FALSE(stats[0].is_delegate_op);
+  EXPECT_EQ(stats[0].num_events, 4);
+  EXPECT_EQ(SumOfBuckets(stats[0]), 4);
+  EXPECT_GE(stats[0].total_duration_us, stats[0].max_duration_us);
+  EXPECT_EQ(profiler.num_dropped_events(), 0);
+}
+
+TEST(OpHistogramProfilerTest, IgnoresNonOperatorEvents) {
+  OpHistogramProfiler profiler;
+  const uint32_t handle =
+      profiler.BeginEvent("Invoke", Profiler::EventType::DEFAULT,
+                          /*event_metadata1=*/0, /*event_metadata2=*/0);
+  EXPECT_EQ(handle, 0);
+  profiler.EndEvent(handle);
+  EXPECT_TRUE(profiler.SnapshotStats().empty());
+}
+
+TEST(OpHistogramProfilerTest, SamplingIntervalSkipsEvents) {
+  OpHistogramProfiler profiler(/*sampling_interval=*/2);
+  for (int i = 0; i < 4; ++i) {
+    const uint32_t handle = profiler.BeginEvent(
+        "MyOp", Profiler::EventType::OPERATOR_INVOKE_EVENT,
+        /*event_metadata1=*/0, /*event_metadata2=*/0);
+    profiler.EndEvent(handle);
+  }
+
+  const std::vector<OpHistogramProfiler::OpStats> stats =
+      profiler.SnapshotStats();
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats[0].num_events, 2);
+}
+
+TEST(OpHistogramProfilerTest, AggregatesDelegateProfiledEvents) {
+  constexpr Profiler::EventType kDelegateEvent =
+      Profiler::EventType::DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT;
+  OpHistogramProfiler profiler;
+  profiler.AddEvent("Conv", kDelegateEvent, /*metric=*/5,
+                    /*event_metadata1=*/7, /*event_metadata2=*/0);
+  profiler.AddEvent("Conv", kDelegateEvent, /*metric=*/5,
+                    /*event_metadata1=*/7, /*event_metadata2=*/0);
+  profiler.AddEvent("Conv", kDelegateEvent, /*metric=*/1000,
+                    /*event_metadata1=*/7, /*event_metadata2=*/0);
+
+  const std::vector<OpHistogramProfiler::OpStats> stats =
+      profiler.SnapshotStats();
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_TRUE(stats[0].is_delegate_op);
+  EXPECT_EQ(stats[0].node_index, 7);
+  EXPECT_EQ(stats[0].num_events, 3);
+  EXPECT_EQ(stats[0].total_duration_us, 1010);
+  EXPECT_EQ(stats[0].max_duration_us, 1000);
+  // 5us falls in the [4, 8) bucket, 1000us in the [512, 1024) bucket.
+  EXPECT_EQ(stats[0].duration_buckets[2], 2);
+  EXPECT_EQ(stats[0].duration_buckets[9], 1);
+}
+
+TEST(OpHistogramProfilerTest, SnapshotOrdersBySubgraphThenNode) {
+  OpHistogramProfiler profiler;
+  for (const auto& subgraph_and_node :
+       std::vector<std::pair<int, int>>{{0, 2}, {1, 0}, {0, 1}}) {
+    const uint32_t handle = profiler.BeginEvent(
+        "MyOp", Profiler::EventType::OPERATOR_INVOKE_EVENT,
+        /*event_metadata1=*/subgraph_and_node.second,
+        /*event_metadata2=*/subgraph_and_node.first);
+    profiler.EndEvent(handle);
+  }
+
+  const std::vector<OpHistogramProfiler::OpStats> stats =
+      profiler.SnapshotStats();
+  ASSERT_EQ(stats.size(), 3);
+  EXPECT_EQ(stats[0].subgraph_index, 0);
+  EXPECT_EQ(stats[0].node_index, 1);
+  EXPECT_EQ(stats[1].subgraph_index, 0);
+  EXPECT_EQ(stats[1].node_index, 2);
+  EXPECT_EQ(stats[2].subgraph_index, 1);
+  EXPECT_EQ(stats[2].node_index, 0);
+}
+
+TEST(OpHistogramProfilerTest, DropsEventsBeyondOpTableCapacity) {
+  OpHistogramProfiler profiler(/*sampling_interval=*/1, /*max_num_ops=*/1);
+  for (int node_index = 0; node_index < 2; ++node_index) {
+    const uint32_t handle = profiler.BeginEvent(
+        "MyOp", Profiler::EventType::OPERATOR_INVOKE_EVENT,
+        /*event_metadata1=*/node_index, /*event_metadata2=*/0);
+    profiler.EndEvent(handle);
+  }
+
+  EXPECT_EQ(profiler.SnapshotStats().size(), 1);
+  EXPECT_EQ(profiler.num_dropped_events(), 1);
+}
+
+}  // namespace
+}  // namespace tflite::profiling
@@ -234,7 +234,7 @@ TfLiteStatus SimpleMemoryArena::Allocate(
     TfLiteContext* context, size_t alignment, size_t size, int32_t tensor,
     int32_t first_node, int32_t last_node,
     ArenaAllocWithUsageInterval* new_alloc) {
-  TF_LITE_ENSURE(context, alignment <= underlying_buffer_.GetAlignment());
+  TF_LITE_ENSURE(context, alignment <= underlying_buffer_->GetAlignment());
   new_alloc->tensor = tensor;
   new_alloc->first_node = first_node;
   new_alloc->last_node = last_node;
@@ -288,7 +288,13 @@ TfLiteStatus SimpleMemoryArena::Commit(bool* arena_reallocated) {
   // Resize the arena to the high water mark (calculated by Allocate), retaining
   // old contents and alignment in the process. Since Alloc pointers are offset
   // based, they will remain valid in the new memory block.
-  *arena_reallocated = underlying_buffer_.Resize(high_water_mark_);
+  char* last_committed_ptr = committed_ ? last_committed_ptr_ : nullptr;
+  underlying_buffer_->Resize(high_water_mark_);
+  last_committed_ptr_ = underlying_buffer_->GetPtr();
+  // When the underlying buffer is shared, another arena may have moved it
+  // since this arena's last commit, so compare against the pointer the arena
+  // last resolved from rather than relying on Resize() alone.
+  *arena_reallocated = last_committed_ptr_ != last_committed_ptr;
   committed_ = true;
   return kTfLiteOk;
 }
@@ -299,11 +305,11 @@ TfLiteStatus SimpleMemoryArena::ResolveAlloc(
   TF_LITE_ENSURE(context, committed_);
   TF_LITE_ENSURE(context, output_ptr != nullptr);
   TF_LITE_ENSURE(context,
-                 underlying_buffer_.GetSize() >= (alloc.offset + alloc.size));
+                 underlying_buffer_->GetSize() >= (alloc.offset + alloc.size));
   if (alloc.size == 0) {
     *output_ptr = nullptr;
   } else {
-    *output_ptr = underlying_buffer_.GetPtr() + alloc.offset;
+    *output_ptr = underlying_buffer_->GetPtr() + alloc.offset;
   }
   return kTfLiteOk;
 }
@@ -317,7 +323,7 @@ TfLiteStatus SimpleMemoryArena::ClearPlan() {
 
 TfLiteStatus SimpleMemoryArena::ReleaseBuffer() {
   committed_ = false;
-  underlying_buffer_.Release();
+  underlying_buffer_->Release();
   return kTfLiteOk;
 }
 
@@ -329,7 +335,7 @@ TFLITE_ATTRIBUTE_WEAK void DumpArenaInfo(
 
 void SimpleMemoryArena::DumpDebugInfo(
     const std::string& name, const std::vector<int>& execution_plan) const {
-  tflite::DumpArenaInfo(name, execution_plan, underlying_buffer_.GetSize(),
+  tflite::DumpArenaInfo(name, execution_plan, underlying_buffer_->GetSize(),
                         active_allocs_);
 }
 
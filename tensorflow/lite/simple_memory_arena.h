@@ -17,13 +17,17 @@ limitations under the License.
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/lite/core/c/common.h"
 
 namespace tflite {
 
+constexpr const int kDefaultArenaAlignment = 64;
+
 // This little structure holds the offset and the size for a dynamic memory
 // allocation in the memory arena as well as first_node and last_node that use
 // corresponding tensor. It means that continuous part of memory with this size
@@ -110,9 +114,20 @@ class SimpleMemoryArena {
   explicit SimpleMemoryArena(size_t arena_alignment, int subgraph_index = 0)
       : committed_(false),
         high_water_mark_(0),
-        underlying_buffer_(arena_alignment, subgraph_index),
+        underlying_buffer_(std::make_shared<ResizableAlignedBuffer>(
+            arena_alignment, subgraph_index)),
+        last_committed_ptr_(nullptr),
         active_allocs_() {}
 
+  // Replaces the arena's private buffer with `buffer`, which may be shared
+  // with other arenas. Since the regions planned by different arenas overlap,
+  // sharing is only safe between subgraphs that are never in flight at the
+  // same time (e.g. the bodies of unrelated control flow ops). Must be called
+  // before the first Commit().
+  void SetUnderlyingBuffer(std::shared_ptr<ResizableAlignedBuffer> buffer) {
+    underlying_buffer_ = std::move(buffer);
+  }
+
   // Delete all allocs. This should be called when allocating the first node of
   // a subgraph.
   void ResetAllocs();
@@ -158,10 +173,18 @@ class SimpleMemoryArena {
   // again until Commit() is called & tensor allocations are resolved.
   TfLiteStatus ReleaseBuffer();
 
-  size_t GetBufferSize() const { return underlying_buffer_.GetSize(); }
+  size_t GetBufferSize() const { return underlying_buffer_->GetSize(); }
 
   std::intptr_t BasePointer() const {
-    return reinterpret_cast<std::intptr_t>(underlying_buffer_.GetPtr());
+    return reinterpret_cast<std::intptr_t>(underlying_buffer_->GetPtr());
+  }
+
+  // Returns true if the pointers resolved against this arena are still valid.
+  // A shared underlying buffer may have been reallocated or released by
+  // another arena since this arena last committed, in which case the arena
+  // must be committed and its allocations resolved again before use.
+  bool IsBufferCurrent() const {
+    return !committed_ || underlying_buffer_->GetPtr() == last_committed_ptr_;
   }
 
   // Dumps the memory allocation information of this memory arena (which could
@@ -184,7 +207,12 @@ class SimpleMemoryArena {
  private:
   bool committed_;
   size_t high_water_mark_;
-  ResizableAlignedBuffer underlying_buffer_;
+  // Shared so several arenas belonging to subgraphs that are never in flight
+  // at the same time can be backed by one buffer; see SetUnderlyingBuffer().
+  std::shared_ptr<ResizableAlignedBuffer> underlying_buffer_;
+  // The buffer's data pointer at the time of this arena's last Commit(), used
+  // to detect that a shared buffer has been moved by another arena.
+  char* last_committed_ptr_;
   std::vector<ArenaAllocWithUsageInterval> active_allocs_;
 };
 
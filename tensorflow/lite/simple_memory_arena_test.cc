@@ -14,6 +14,8 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/simple_memory_arena.h"
 
+#include <memory>
+
 #include <gtest/gtest.h>
 #include "tensorflow/lite/core/c/common.h"
 
@@ -321,6 +323,48 @@ TEST(SimpleMemoryArenaTest, TestClearBuffer) {
   EXPECT_NE(resolved_ptr, nullptr);
 }
 
+TEST(SimpleMemoryArenaTest, TestSharedBuffer) {
+  TfLiteContext context;
+  context.ReportError = ReportError;
+  SimpleMemoryArena arena1(64);
+  SimpleMemoryArena arena2(64);
+  auto shared_buffer = std::make_shared<ResizableAlignedBuffer>(
+      /*alignment=*/64, /*subgraph_index=*/0);
+  arena1.SetUnderlyingBuffer(shared_buffer);
+  arena2.SetUnderlyingBuffer(shared_buffer);
+  ArenaAllocWithUsageInterval alloc1;
+  ArenaAllocWithUsageInterval alloc2;
+
+  arena1.Allocate(&context, 32, 2047, 0, 0, 2, &alloc1);
+  arena2.Allocate(&context, 32, 4095, 0, 0, 2, &alloc2);
+
+  // Both arenas resolve allocations against the same buffer.
+  bool reallocated = false;
+  ASSERT_EQ(arena1.Commit(&reallocated), kTfLiteOk);
+  ASSERT_TRUE(reallocated);
+  ASSERT_EQ(arena2.Commit(&reallocated), kTfLiteOk);
+  EXPECT_EQ(arena1.BasePointer(), arena2.BasePointer());
+  EXPECT_TRUE(arena2.IsBufferCurrent());
+
+  // Re-committing the first arena adopts the buffer as resized by the second
+  // one, and resolving remains valid.
+  ASSERT_EQ(arena1.Commit(&reallocated), kTfLiteOk);
+  ASSERT_TRUE(arena1.IsBufferCurrent());
+  char* resolved_ptr = nullptr;
+  ASSERT_EQ(arena1.ResolveAlloc(&context, alloc1, &resolved_ptr), kTfLiteOk);
+  EXPECT_NE(resolved_ptr, nullptr);
+
+  // Releasing the buffer through one arena invalidates the pointers resolved
+  // against the other one, which recovers by committing again.
+  ASSERT_EQ(arena2.ReleaseBuffer(), kTfLiteOk);
+  EXPECT_FALSE(arena1.IsBufferCurrent());
+  ASSERT_EQ(arena1.Commit(&reallocated), kTfLiteOk);
+  EXPECT_TRUE(arena1.IsBufferCurrent());
+  resolved_ptr = nullptr;
+  ASSERT_EQ(arena1.ResolveAlloc(&context, alloc1, &resolved_ptr), kTfLiteOk);
+  EXPECT_NE(resolved_ptr, nullptr);
+}
+
 // Test parameterized by whether ClearBuffer() is called before ClearPlan(), or
 // vice versa.
 class BufferAndPlanClearingTest : public ::testing::Test,
@@ -20,13 +20,27 @@ limitations under the License.
 #include <vector>
 
 #include "absl/status/status.h"
-#include "riegeli/bytes/fd_reader.h"  // from @riegeli
-#include "riegeli/records/record_reader.h"  // from @riegeli
+#include "absl/status/statusor.h"
 #include "tensorflow/tools/proto_splitter/chunk.pb.h"
 #include "tsl/platform/protobuf.h"
 
 namespace tensorflow::tools::proto_splitter {
 
+// Supplies chunk payloads to `Merger` by chunk index. The default
+// implementation reads each chunk on demand from the underlying riegeli file.
+// When TF_PROTO_SPLITTER_STREAM_READ is enabled, `Merger::Read` and
+// `Merger::ReadPartial` install a prefetching implementation that fetches
+// chunks sequentially on a background thread, so chunk fetches from (possibly
+// remote) storage overlap with message merging instead of being serialized
+// with it.
+class ChunkSource {
+ public:
+  virtual ~ChunkSource() = default;
+
+  // Returns the payload of the chunk at `chunk_index`.
+  virtual absl::StatusOr<std::string> GetChunk(int chunk_index) = 0;
+};
+
 class Merger {
  private:
   enum MergerOp { MERGE, READ };
@@ -65,14 +79,10 @@ class Merger {
                              tsl::protobuf::Message* merged_message);
 
   // Uses metadata contained in `chunked_message` to fill `merged_message` with
-  // data accessed by the `reader` using `chunks_info`.
+  // data supplied by `chunk_source`.
   static absl::Status ReadFields(
       const ::tensorflow::proto_splitter::ChunkedMessage& chunked_message,
-      riegeli::RecordReader<riegeli::FdReader<>>& reader,
-      const std::vector<::tensorflow::proto_splitter::ChunkInfo>&
-          chunks_info,  // TODO(adamcogdell): this can just be a
-                        // RepeatedPtrField
-      tsl::protobuf::Message* merged_message);
+      ChunkSource& chunk_source, tsl::protobuf::Message* merged_message);
 
   // Processes a single `chunked_field` within a `chunked_message`. If the field
   // itself is a `chunked_message` that contains additional `chunked_fields`,
@@ -82,9 +92,8 @@ class Merger {
   static absl::Status ProcessField(
       const ::tensorflow::proto_splitter::ChunkedField& chunked_field,
       tsl::protobuf::Message* merged_message,
-      const std::vector<::tensorflow::proto_splitter::ChunkInfo>& chunks_info,
       const std::vector<std::unique_ptr<tsl::protobuf::Message>>& chunks,
-      riegeli::RecordReader<riegeli::FdReader<>>& reader, MergerOp op);
+      ChunkSource& chunk_source, MergerOp op);
 };
 
 }  // namespace tensorflow::tools::proto_splitter
@@ -15,6 +15,7 @@ limitations under the License.
 #include "tensorflow/tools/proto_splitter/merge.h"
 
 #include <array>
+#include <cstdlib>
 #include <memory>
 #include <string>
 #include <utility>
@@ -241,6 +242,21 @@ TEST(MergeTest, TestReadChunkedModel) {
   ASSERT_THAT(merged_saved_model, EqualsProto(test_saved_model));
 }
 
+TEST(MergeTest, TestStreamingReadMatchesDirectRead) {
+  const std::string path =
+      io::JoinPath(testing::TensorFlowSrcRoot(), "cc/saved_model/testdata",
+                   "chunked_saved_model/chunked_model/saved_model");
+  SavedModel direct_saved_model;
+  TF_ASSERT_OK(Merger::Read(path, &direct_saved_model));
+
+  setenv("TF_PROTO_SPLITTER_STREAM_READ", "1", 1);
+  SavedModel streamed_saved_model;
+  TF_ASSERT_OK(Merger::Read(path, &streamed_saved_model));
+  unsetenv("TF_PROTO_SPLITTER_STREAM_READ");
+
+  ASSERT_THAT(streamed_saved_model, EqualsProto(direct_saved_model));
+}
+
 TEST(MergeTest, TestReadPartial) {
   const std::string path =
       io::JoinPath(testing::TensorFlowSrcRoot(),
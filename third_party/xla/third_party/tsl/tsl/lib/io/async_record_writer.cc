@@ -0,0 +1,118 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tsl/lib/io/async_record_writer.h"
+
+#include <deque>
+#include <string>
+#include <utility>
+
+#include "tsl/platform/errors.h"
+#include "tsl/platform/logging.h"
+
+namespace tsl {
+namespace io {
+
+AsyncRecordWriter::AsyncRecordWriter(WritableFile* dest,
+                                     const RecordWriterOptions& options,
+                                     size_t max_buffered_bytes)
+    : writer_(dest, options), max_buffered_bytes_(max_buffered_bytes) {
+  thread_.reset(Env::Default()->StartThread(
+      ThreadOptions(), "async_record_writer", [this]() { WriteLoop(); }));
+}
+
+AsyncRecordWriter::~AsyncRecordWriter() {
+  absl::Status s = Close();
+  if (!s.ok()) {
+    LOG(ERROR) << "Could not finish writing file: " << s;
+  }
+}
+
+absl::Status AsyncRecordWriter::WriteRecord(StringPiece data) {
+  mutex_lock l(mu_);
+  while (queued_bytes_ + data.size() > max_buffered_bytes_ &&
+         !queue_.empty() && !closing_ && status_.ok()) {
+    space_cv_.wait(l);
+  }
+  if (closing_) {
+    return errors::FailedPrecondition("Writer is closed");
+  }
+  if (!status_.ok()) return status_;
+  queue_.emplace_back(data.data(), data.size());
+  queued_bytes_ += data.size();
+  work_cv_.notify_one();
+  return absl::OkStatus();
+}
+
+absl::Status AsyncRecordWriter::Flush() {
+  mutex_lock l(mu_);
+  if (closing_) {
+    return errors::FailedPrecondition("Writer is closed");
+  }
+  while (!queue_.empty() || writing_) {
+    idle_cv_.wait(l);
+  }
+  if (!status_.ok()) return status_;
+  // The background thread only touches writer_ while writing_ is set, so it
+  // is safe to flush from here while holding mu_.
+  return writer_.Flush();
+}
+
+absl::Status AsyncRecordWriter::Close() {
+  {
+    mutex_lock l(mu_);
+    if (closed_) return status_;
+    closing_ = true;
+    work_cv_.notify_one();
+    space_cv_.notify_all();
+  }
+  thread_.reset();  // Joins; the remaining queue has been written.
+  mutex_lock l(mu_);
+  closed_ = true;
+  status_.Update(writer_.Close());
+  return status_;
+}
+
+void AsyncRecordWriter::WriteLoop() {
+  while (true) {
+    std::deque<std::string> batch;
+    {
+      mutex_lock l(mu_);
+      while (queue_.empty() && !closing_) {
+        work_cv_.wait(l);
+      }
+      if (queue_.empty()) return;  // closing_ with nothing left to write.
+      batch.swap(queue_);
+      queued_bytes_ = 0;
+      writing_ = true;
+      space_cv_.notify_all();
+    }
+    absl::Status s;
+    for (const std::string& record : batch) {
+      s.Update(writer_.WriteRecord(record));
+    }
+    {
+      mutex_lock l(mu_);
+      status_.Update(s);
+      writing_ = false;
+      idle_cv_.notify_all();
+      // Unblock producers that were waiting on a now-failed writer.
+      if (!status_.ok()) space_cv_.notify_all();
+    }
+  }
+}
+
+}  // namespace io
+}  // namespace tsl
@@ -0,0 +1,110 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_TSL_LIB_IO_ASYNC_RECORD_WRITER_H_
+#define TENSORFLOW_TSL_LIB_IO_ASYNC_RECORD_WRITER_H_
+
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "tsl/lib/io/record_writer.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/macros.h"
+#include "tsl/platform/mutex.h"
+#include "tsl/platform/status.h"
+#include "tsl/platform/stringpiece.h"
+#include "tsl/platform/types.h"
+
+namespace tsl {
+namespace io {
+
+// A group-commit wrapper around RecordWriter.
+//
+// RecordWriter checksums, compresses and appends each record on the calling
+// thread, so producers that log records (e.g. event writers) stall on the
+// compression stream and the file system.  AsyncRecordWriter instead buffers
+// records in memory and hands them to a single background thread, which
+// drains whatever has accumulated and writes the whole batch through the
+// wrapped RecordWriter.  Record order is preserved.
+//
+// WriteRecord() normally returns after copying the record into the buffer.
+// If the buffer holds more than max_buffered_bytes the caller blocks until
+// the background thread catches up, which bounds memory usage.
+//
+// Flush() blocks until every record accepted so far has been written and the
+// underlying file flushed, so callers that rely on flush-on-demand (such as
+// the summary file writer) keep their durability guarantees.
+//
+// Errors from the background writes are sticky: once a write fails, the
+// failure is returned from every subsequent WriteRecord()/Flush()/Close().
+//
+// This class is thread-safe.
+class AsyncRecordWriter {
+ public:
+  // Create an AsyncRecordWriter that writes to "*dest".  "*dest" must remain
+  // live while this writer is in use.
+  explicit AsyncRecordWriter(
+      WritableFile* dest,
+      const RecordWriterOptions& options = RecordWriterOptions(),
+      size_t max_buffered_bytes = 8 << 20);
+
+  // Calls Close() and logs if it returns an error.
+  ~AsyncRecordWriter();
+
+  // Enqueues "data" to be written as a record.  Blocks only when the buffer
+  // is over its byte budget.
+  absl::Status WriteRecord(StringPiece data);
+
+  // Blocks until all previously accepted records have been written and the
+  // underlying file has been flushed.
+  absl::Status Flush();
+
+  // Writes any buffered records, closes the underlying RecordWriter and
+  // stops the background thread.  The writer may not be used afterwards.
+  absl::Status Close();
+
+ private:
+  // Body of the background thread: repeatedly drains the queue and writes
+  // the drained batch through writer_.
+  void WriteLoop();
+
+  RecordWriter writer_;
+  const size_t max_buffered_bytes_;
+
+  mutex mu_;
+  condition_variable work_cv_;   // Signaled when records are queued.
+  condition_variable space_cv_;  // Signaled when the queue is drained.
+  condition_variable idle_cv_;   // Signaled when a batch has been written.
+  std::deque<std::string> queue_ TF_GUARDED_BY(mu_);
+  size_t queued_bytes_ TF_GUARDED_BY(mu_) = 0;
+  // True while the background thread is writing a drained batch.
+  bool writing_ TF_GUARDED_BY(mu_) = false;
+  bool closing_ TF_GUARDED_BY(mu_) = false;
+  bool closed_ TF_GUARDED_BY(mu_) = false;
+  // First error reported by a background write, if any.
+  absl::Status status_ TF_GUARDED_BY(mu_);
+
+  // Joined by resetting; must be destroyed before the members it uses.
+  std::unique_ptr<Thread> thread_;
+
+  AsyncRecordWriter(const AsyncRecordWriter&) = delete;
+  void operator=(const AsyncRecordWriter&) = delete;
+};
+
+}  // namespace io
+}  // namespace tsl
+
+#endif  // TENSORFLOW_TSL_LIB_IO_ASYNC_RECORD_WRITER_H_
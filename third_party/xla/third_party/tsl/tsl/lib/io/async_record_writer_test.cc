@@ -0,0 +1,117 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tsl/lib/io/async_record_writer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tsl/lib/core/status_test_util.h"
+#include "tsl/lib/io/record_reader.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/errors.h"
+#include "tsl/platform/status.h"
+#include "tsl/platform/strcat.h"
+#include "tsl/platform/test.h"
+
+namespace tsl {
+namespace {
+
+std::vector<string> ReadAllRecords(const string& fname) {
+  Env* env = Env::Default();
+  std::unique_ptr<RandomAccessFile> file;
+  TF_CHECK_OK(env->NewRandomAccessFile(fname, &file));
+  io::RecordReader reader(file.get());
+  std::vector<string> records;
+  uint64 offset = 0;
+  tstring record;
+  while (reader.ReadRecord(&offset, &record).ok()) {
+    records.push_back(record);
+  }
+  return records;
+}
+
+TEST(AsyncRecordWriterTest, WriteFlushRead) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/async_record_writer_test";
+
+  std::unique_ptr<WritableFile> file;
+  TF_ASSERT_OK(env->NewWritableFile(fname, &file));
+  io::AsyncRecordWriter writer(file.get());
+  for (int i = 0; i < 1000; i++) {
+    TF_ASSERT_OK(writer.WriteRecord(strings::StrCat("record-", i)));
+  }
+
+  // Flush must make everything accepted so far readable.
+  TF_ASSERT_OK(writer.Flush());
+  std::vector<string> records = ReadAllRecords(fname);
+  ASSERT_EQ(1000, records.size());
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(strings::StrCat("record-", i), records[i]);
+  }
+  TF_ASSERT_OK(writer.Close());
+}
+
+TEST(AsyncRecordWriterTest, ConcurrentProducers) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/async_record_writer_concurrent";
+
+  std::unique_ptr<WritableFile> file;
+  TF_ASSERT_OK(env->NewWritableFile(fname, &file));
+  constexpr int kThreads = 8;
+  constexpr int kRecordsPerThread = 500;
+  {
+    // Use a tiny buffer so producers exercise the backpressure path.
+    io::AsyncRecordWriter writer(file.get(), io::RecordWriterOptions(),
+                                 /*max_buffered_bytes=*/64);
+    std::vector<std::unique_ptr<Thread>> threads;
+    for (int t = 0; t < kThreads; t++) {
+      threads.emplace_back(
+          env->StartThread(ThreadOptions(), "producer", [&writer, t]() {
+            for (int i = 0; i < kRecordsPerThread; i++) {
+              TF_CHECK_OK(writer.WriteRecord(strings::StrCat(t, ":", i)));
+            }
+          }));
+    }
+    threads.clear();  // Join.
+    TF_ASSERT_OK(writer.Close());
+  }
+
+  std::vector<string> records = ReadAllRecords(fname);
+  EXPECT_EQ(kThreads * kRecordsPerThread, records.size());
+}
+
+TEST(AsyncRecordWriterTest, CloseWritesBufferedRecords) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/async_record_writer_close";
+
+  std::unique_ptr<WritableFile> file;
+  TF_ASSERT_OK(env->NewWritableFile(fname, &file));
+  {
+    io::AsyncRecordWriter writer(file.get());
+    TF_ASSERT_OK(writer.WriteRecord("buffered"));
+    TF_ASSERT_OK(writer.Close());
+    // Further writes must fail.
+    EXPECT_TRUE(errors::IsFailedPrecondition(writer.WriteRecord("late")));
+  }
+
+  std::vector<string> records = ReadAllRecords(fname);
+  ASSERT_EQ(1, records.size());
+  EXPECT_EQ("buffered", records[0]);
+}
+
+}  // namespace
+}  // namespace tsl
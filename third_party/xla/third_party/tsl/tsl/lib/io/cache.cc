@@ -20,6 +20,8 @@ limitations under the License.
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include "tsl/platform/mutex.h"
 #include "tsl/platform/raw_coding.h"
 
@@ -159,6 +161,56 @@ class HandleTable {
   }
 };
 
+// Compact frequency sketch used for TinyLFU-style cache admission.
+// Approximates how often each key hash has been accessed recently with
+// 4-bit saturating counters at two probe positions; all counters are
+// halved periodically so estimates decay and track the current access
+// pattern instead of the all-time one.
+class FrequencySketch {
+ public:
+  FrequencySketch() { memset(counters_, 0, sizeof(counters_)); }
+
+  void Increment(uint32_t hash) {
+    const uint32_t i1 = Index(hash);
+    const uint32_t i2 = Index(Remix(hash));
+    // Conservative update: only bump the smaller counter, which reduces
+    // overestimation from hash collisions.
+    const uint8_t low = std::min(counters_[i1], counters_[i2]);
+    if (low < kMaxCount) {
+      if (counters_[i1] == low) counters_[i1]++;
+      if (counters_[i2] == low && i2 != i1) counters_[i2]++;
+    }
+    if (++ops_ >= kAgingInterval) {
+      Age();
+    }
+  }
+
+  int Estimate(uint32_t hash) const {
+    return std::min(counters_[Index(hash)], counters_[Index(Remix(hash))]);
+  }
+
+ private:
+  static const int kNumCounters = 2048;  // Power of two.
+  static const uint8_t kMaxCount = 15;
+  static const uint32_t kAgingInterval = 8 * kNumCounters;
+
+  static uint32_t Remix(uint32_t h) {
+    h *= 0x9e3779b1;
+    return h ^ (h >> 16);
+  }
+  static uint32_t Index(uint32_t h) { return h & (kNumCounters - 1); }
+
+  void Age() {
+    ops_ = 0;
+    for (int i = 0; i < kNumCounters; i++) {
+      counters_[i] >>= 1;
+    }
+  }
+
+  uint8_t counters_[kNumCounters];
+  uint32_t ops_ = 0;
+};
+
 // A single shard of sharded cache.
 class LRUCache {
  public:
@@ -180,6 +232,12 @@ class LRUCache {
     mutex_lock l(mutex_);
     return usage_;
   }
+  void AddStats(Cache::Stats* stats) const {
+    mutex_lock l(mutex_);
+    stats->lookups += stats_.lookups;
+    stats->hits += stats_.hits;
+    stats->admission_rejections += stats_.admission_rejections;
+  }
 
  private:
   void LRU_Remove(LRUHandle* e);
@@ -205,6 +263,11 @@ class LRUCache {
   LRUHandle in_use_ TF_GUARDED_BY(mutex_);
 
   HandleTable table_ TF_GUARDED_BY(mutex_);
+
+  // Recent access frequencies, used for scan-resistant admission.
+  FrequencySketch sketch_ TF_GUARDED_BY(mutex_);
+
+  Cache::Stats stats_ TF_GUARDED_BY(mutex_);
 };
 
 LRUCache::LRUCache() : capacity_(0), usage_(0) {
@@ -264,8 +327,11 @@ void LRUCache::LRU_Append(LRUHandle* list, LRUHandle* e) {
 
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash) {
   mutex_lock l(mutex_);
+  stats_.lookups++;
+  sketch_.Increment(hash);
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
+    stats_.hits++;
     Ref(e);
   }
   return reinterpret_cast<Cache::Handle*>(e);
@@ -280,8 +346,16 @@ Cache::Handle* LRUCache::Insert(const Slice& key, uint32_t hash, void* value,
                                 size_t charge,
                                 void (*deleter)(const Slice& key,
                                                 void* value)) {
+  // A victim this frequently used is protected from colder entries; below
+  // this, admission behaves like plain LRU. This keeps one large scan from
+  // flushing entries with demonstrated reuse while still letting new
+  // entries displace barely-used ones.
+  static const int kProtectedVictimFrequency = 3;
+
   mutex_lock l(mutex_);
 
+  sketch_.Increment(hash);
+
   LRUHandle* e =
       reinterpret_cast<LRUHandle*>(malloc(sizeof(LRUHandle) - 1 + key.size()));
   e->value = value;
@@ -293,6 +367,22 @@ Cache::Handle* LRUCache::Insert(const Slice& key, uint32_t hash, void* value,
   e->refs = 1;  // for the returned handle.
   memcpy(e->key_data, key.data(), key.size());
 
+  // TinyLFU-style admission: when the insert would evict, compare the
+  // candidate's recent access frequency against the eviction victim's.
+  // Duplicate-key inserts always replace the existing entry.
+  if (capacity_ > 0 && usage_ + charge > capacity_ && lru_.next != &lru_ &&
+      table_.Lookup(key, hash) == nullptr) {
+    const int victim_frequency = sketch_.Estimate(lru_.next->hash);
+    if (victim_frequency >= kProtectedVictimFrequency &&
+        victim_frequency > sketch_.Estimate(hash)) {
+      // Don't cache; hand the entry to the caller only (see capacity_==0
+      // below).
+      stats_.admission_rejections++;
+      e->next = nullptr;
+      return reinterpret_cast<Cache::Handle*>(e);
+    }
+  }
+
   if (capacity_ > 0) {
     e->refs++;  // for the cache's reference.
     e->in_cache = true;
@@ -404,6 +494,12 @@ class ShardedLRUCache : public Cache {
     }
     return total;
   }
+  void GetStats(Stats* stats) const override {
+    *stats = Stats();
+    for (int s = 0; s < kNumShards; s++) {
+      shard_[s].AddStats(stats);
+    }
+  }
 
  private:
   // TODO(byronyi): Figure out why Hash32 fails EvictionPolicy test.
@@ -59,6 +59,16 @@ class Cache {
   // Opaque handle to an entry stored in the cache.
   struct Handle {};
 
+  // Usage counters for monitoring cache effectiveness.
+  struct Stats {
+    uint64_t lookups = 0;
+    uint64_t hits = 0;
+    // Inserts that the admission policy declined to cache (e.g. entries
+    // from a large scan that would have displaced more frequently used
+    // ones). Such entries are still returned to the caller via a handle.
+    uint64_t admission_rejections = 0;
+  };
+
   // Insert a mapping from key->value into the cache and assign it
   // the specified charge against the total cache capacity.
   //
@@ -111,6 +121,10 @@ class Cache {
   // cache.
   virtual size_t TotalCharge() const = 0;
 
+  // Fills "*stats" with this cache's usage counters. The default
+  // implementation reports nothing.
+  virtual void GetStats(Stats* stats) const {}
+
  private:
   void LRU_Remove(Handle* e);
   void LRU_Append(Handle* e);
@@ -208,6 +208,43 @@ TEST_F(CacheTest, HeavyEntries) {
   ASSERT_LE(cached_weight, kCacheSize + kCacheSize / 10);
 }
 
+TEST_F(CacheTest, ScanResistance) {
+  // Establish a small working set with demonstrated reuse.
+  for (int i = 0; i < 10; i++) {
+    Insert(i, 100 + i);
+  }
+  for (int round = 0; round < 10; round++) {
+    for (int i = 0; i < 10; i++) {
+      ASSERT_EQ(100 + i, Lookup(i));
+    }
+  }
+
+  // Sweep many cold entries through the cache without touching the hot
+  // ones, as a full-file table scan would.
+  for (int i = 0; i < 10 * kCacheSize; i++) {
+    Insert(10000 + i, i);
+  }
+
+  // The hot entries must have survived the scan.
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(100 + i, Lookup(i));
+  }
+}
+
+TEST_F(CacheTest, Stats) {
+  Cache::Stats stats;
+  cache_->GetStats(&stats);
+  ASSERT_EQ(0, stats.lookups);
+  ASSERT_EQ(0, stats.hits);
+
+  Insert(100, 101);
+  Lookup(100);
+  Lookup(200);
+  cache_->GetStats(&stats);
+  ASSERT_EQ(2, stats.lookups);
+  ASSERT_EQ(1, stats.hits);
+}
+
 TEST_F(CacheTest, NewId) {
   uint64_t a = cache_->NewId();
   uint64_t b = cache_->NewId();
@@ -0,0 +1,280 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_TSL_LIB_MONITORING_SHARDED_COUNTER_H_
+#define TENSORFLOW_TSL_LIB_MONITORING_SHARDED_COUNTER_H_
+
+// clang-format off
+// Required for IS_MOBILE_PLATFORM
+#include "tsl/platform/platform.h"
+// clang-format on
+
+// We replace this implementation with a null implementation for mobile
+// platforms.
+#ifdef IS_MOBILE_PLATFORM
+
+#include "tsl/platform/macros.h"
+#include "tsl/platform/status.h"
+#include "tsl/platform/types.h"
+
+namespace tsl {
+namespace monitoring {
+
+// ShardedCounterCell which has a null implementation.
+class ShardedCounterCell {
+ public:
+  ShardedCounterCell() {}
+  ~ShardedCounterCell() {}
+
+  void IncrementBy(int64 step) {}
+  int64 value() const { return 0; }
+
+ private:
+  ShardedCounterCell(const ShardedCounterCell&) = delete;
+  void operator=(const ShardedCounterCell&) = delete;
+};
+
+// ShardedCounter which has a null implementation.
+template <int NumLabels>
+class ShardedCounter {
+ public:
+  ~ShardedCounter() {}
+
+  template <typename... MetricDefArgs>
+  static ShardedCounter* New(MetricDefArgs&&... metric_def_args) {
+    return new ShardedCounter<NumLabels>();
+  }
+
+  template <typename... Labels>
+  ShardedCounterCell* GetCell(const Labels&... labels) {
+    return &default_counter_cell_;
+  }
+
+  Status GetStatus() { return OkStatus(); }
+
+ private:
+  ShardedCounter() {}
+
+  ShardedCounterCell default_counter_cell_;
+
+  ShardedCounter(const ShardedCounter&) = delete;
+  void operator=(const ShardedCounter&) = delete;
+};
+
+}  // namespace monitoring
+}  // namespace tsl
+
+#else  // IS_MOBILE_PLATFORM
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include "tsl/lib/monitoring/collection_registry.h"
+#include "tsl/lib/monitoring/metric_def.h"
+#include "tsl/platform/logging.h"
+#include "tsl/platform/macros.h"
+#include "tsl/platform/mutex.h"
+#include "tsl/platform/status.h"
+#include "tsl/platform/thread_annotations.h"
+
+namespace tsl {
+namespace monitoring {
+
+// ShardedCounterCell stores each value of a ShardedCounter.
+//
+// Unlike CounterCell, which keeps a single atomic that all incrementing
+// threads contend on, a ShardedCounterCell spreads increments over several
+// cache-line-padded shards. Threads pick a shard once (round-robin) and
+// increment it with relaxed atomics, so cells that are bumped per element
+// from many threads (e.g. tf.data, batching) do not bounce a cache line
+// between cores. value() aggregates the shards on read.
+//
+// The trade-off is memory: each cell occupies kNumShards cache lines, so
+// reserve ShardedCounter for hot metrics. Increments are visible to value()
+// promptly but without a total order; like CounterCell, the value read while
+// writers are active is a point-in-time approximation.
+//
+// This class is thread-safe.
+class ShardedCounterCell {
+ public:
+  explicit ShardedCounterCell(int64_t value) {
+    shards_[0].value.store(value, std::memory_order_relaxed);
+  }
+  ~ShardedCounterCell() {}
+
+  // Increments this thread's shard of the value by step.
+  // REQUIRES: Step be non-negative.
+  void IncrementBy(int64_t step);
+
+  // Retrieves the current value, aggregated over all shards.
+  int64_t value() const;
+
+ private:
+  // Enough shards that concurrent writers rarely collide, while keeping the
+  // per-cell footprint (kNumShards cache lines) moderate.
+  static constexpr int kNumShards = 16;
+
+  struct alignas(64) Shard {
+    std::atomic<int64_t> value{0};
+  };
+
+  // Returns the shard the calling thread increments.
+  Shard& shard();
+
+  std::array<Shard, kNumShards> shards_;
+
+  ShardedCounterCell(const ShardedCounterCell&) = delete;
+  void operator=(const ShardedCounterCell&) = delete;
+};
+
+// A stateful class for updating a cumulative integer metric under heavy
+// multi-threaded increment load.
+//
+// Same contract and registry integration as Counter (cells are identified by
+// a tuple of labels, collected through CollectionRegistry), but hands out
+// ShardedCounterCells. Use it for metrics that are incremented per element
+// on hot paths; use Counter everywhere else to keep memory usage down.
+//
+// This class is thread-safe.
+template <int NumLabels>
+class ShardedCounter {
+ public:
+  ~ShardedCounter() {
+    // Deleted here, before the metric_def is destroyed.
+    registration_handle_.reset();
+  }
+
+  // Creates the metric based on the metric-definition arguments.
+  //
+  // Example;
+  // auto* counter_with_label = ShardedCounter<1>::New("/tensorflow/counter",
+  //   "Tensorflow counter", "MyLabelName");
+  template <typename... MetricDefArgs>
+  static ShardedCounter* New(MetricDefArgs&&... metric_def_args);
+
+  // Retrieves the cell for the specified labels, creating it on demand if
+  // not already present.
+  template <typename... Labels>
+  ShardedCounterCell* GetCell(const Labels&... labels) TF_LOCKS_EXCLUDED(mu_);
+
+  absl::Status GetStatus() { return status_; }
+
+ private:
+  explicit ShardedCounter(
+      const MetricDef<MetricKind::kCumulative, int64_t, NumLabels>& metric_def)
+      : metric_def_(metric_def),
+        registration_handle_(CollectionRegistry::Default()->Register(
+            &metric_def_, [&](MetricCollectorGetter getter) {
+              auto metric_collector = getter.Get(&metric_def_);
+
+              mutex_lock l(mu_);
+              for (const auto& cell : cells_) {
+                metric_collector.CollectValue(cell.first, cell.second.value());
+              }
+            })) {
+    if (registration_handle_) {
+      status_ = absl::OkStatus();
+    } else {
+      status_ =
+          absl::Status(absl::StatusCode::kAlreadyExists,
+                       "Another metric with the same name already exists.");
+    }
+  }
+
+  mutable mutex mu_;
+
+  absl::Status status_;
+
+  using LabelArray = std::array<string, NumLabels>;
+  std::map<LabelArray, ShardedCounterCell> cells_ TF_GUARDED_BY(mu_);
+
+  // The metric definition. This will be used to identify the metric when we
+  // register it for collection.
+  const MetricDef<MetricKind::kCumulative, int64_t, NumLabels> metric_def_;
+
+  std::unique_ptr<CollectionRegistry::RegistrationHandle> registration_handle_;
+
+  ShardedCounter(const ShardedCounter&) = delete;
+  void operator=(const ShardedCounter&) = delete;
+};
+
+////
+//  Implementation details follow. API readers may skip.
+////
+
+inline ShardedCounterCell::Shard& ShardedCounterCell::shard() {
+  // Spread threads over shards round-robin. The assignment is per thread,
+  // not per cell, which keeps shard selection to one thread-local read on
+  // the increment path.
+  static std::atomic<int> next_shard{0};
+  static thread_local const int shard_index =
+      next_shard.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+  return shards_[shard_index];
+}
+
+inline void ShardedCounterCell::IncrementBy(const int64_t step) {
+  DCHECK_LE(0, step) << "Must not decrement cumulative metrics.";
+  shard().value.fetch_add(step, std::memory_order_relaxed);
+}
+
+inline int64_t ShardedCounterCell::value() const {
+  int64_t sum = 0;
+  for (const Shard& shard : shards_) {
+    sum += shard.value.load(std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+template <int NumLabels>
+template <typename... MetricDefArgs>
+ShardedCounter<NumLabels>* ShardedCounter<NumLabels>::New(
+    MetricDefArgs&&... metric_def_args) {
+  return new ShardedCounter<NumLabels>(
+      MetricDef<MetricKind::kCumulative, int64_t, NumLabels>(
+          std::forward<MetricDefArgs>(metric_def_args)...));
+}
+
+template <int NumLabels>
+template <typename... Labels>
+ShardedCounterCell* ShardedCounter<NumLabels>::GetCell(const Labels&... labels)
+    TF_LOCKS_EXCLUDED(mu_) {
+  // Provides a more informative error message than the one during array
+  // construction below.
+  static_assert(
+      sizeof...(Labels) == NumLabels,
+      "Mismatch between ShardedCounter<NumLabels> and number of labels "
+      "provided in GetCell(...).");
+
+  const LabelArray& label_array = {{labels...}};
+  mutex_lock l(mu_);
+  const auto found_it = cells_.find(label_array);
+  if (found_it != cells_.end()) {
+    return &(found_it->second);
+  }
+  return &(cells_
+               .emplace(std::piecewise_construct,
+                        std::forward_as_tuple(label_array),
+                        std::forward_as_tuple(0))
+               .first->second);
+}
+
+}  // namespace monitoring
+}  // namespace tsl
+
+#endif  // IS_MOBILE_PLATFORM
+#endif  // TENSORFLOW_TSL_LIB_MONITORING_SHARDED_COUNTER_H_
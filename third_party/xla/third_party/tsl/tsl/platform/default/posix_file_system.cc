@@ -29,11 +29,15 @@ limitations under the License.
 #include <time.h>
 #include <unistd.h>
 
+#include <atomic>
+#include <cstdlib>
+
 #include "tsl/platform/default/posix_file_system.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/file_system_helper.h"
 #include "tsl/platform/logging.h"
+#include "tsl/platform/numbers.h"
 #include "tsl/platform/status.h"
 #include "tsl/platform/strcat.h"
 #include "tsl/protobuf/error_codes.pb.h"
@@ -45,11 +49,63 @@ using ::tsl::errors::IOError;
 // 128KB of copy buffer
 constexpr size_t kPosixCopyFileBufferSize = 128 * 1024;
 
+// Number of bytes of asynchronous kernel readahead to request past the end
+// of each sequential read, configured via TF_POSIX_FILE_READAHEAD (0, the
+// default, disables it). When enabled, a sequential reader's next window is
+// advised with POSIX_FADV_WILLNEED while the current one is consumed, so
+// buffered-stream fills are served from reads the kernel has already
+// completed into the page cache instead of stalling on a synchronous
+// pread() per fill. This keeps NVMe queues busy when many shards are read
+// concurrently (e.g. tf.data interleave).
+size_t PosixReadaheadBytes() {
+  static const size_t result = [] {
+    const char* value = getenv("TF_POSIX_FILE_READAHEAD");
+    if (value == nullptr) {
+      return size_t{0};
+    }
+    int64_t bytes;
+    if (!strings::safe_strto64(value, &bytes) || bytes < 0) {
+      LOG(ERROR) << "Invalid TF_POSIX_FILE_READAHEAD value: " << value;
+      return size_t{0};
+    }
+    return static_cast<size_t>(bytes);
+  }();
+  return result;
+}
+
 // pread() based random-access
 class PosixRandomAccessFile : public RandomAccessFile {
  private:
   string filename_;
   int fd_;
+  // End offset of the most recent sequential read, used to detect
+  // sequential access and to avoid re-advising byte ranges the kernel has
+  // already been asked to prefetch. Only maintained when
+  // TF_POSIX_FILE_READAHEAD is set.
+  mutable std::atomic<uint64> sequential_end_{0};
+
+  // If the read that just completed at `read_end` continues a sequential
+  // scan, asks the kernel to asynchronously prefetch the next readahead
+  // window so the caller's subsequent read is served from the page cache.
+  void MaybeAdviseReadahead(uint64 read_start, uint64 read_end) const {
+#if defined(__linux__)
+    const size_t readahead = PosixReadaheadBytes();
+    if (readahead == 0 || read_end <= read_start) {
+      return;
+    }
+    uint64 expected = sequential_end_.load(std::memory_order_relaxed);
+    if (read_start != 0 && read_start != expected) {
+      return;
+    }
+    sequential_end_.store(read_end, std::memory_order_relaxed);
+    // Best effort: a failed advice only costs the prefetch.
+    posix_fadvise(fd_, static_cast<off_t>(read_end),
+                  static_cast<off_t>(readahead), POSIX_FADV_WILLNEED);
+#else
+    (void)read_start;
+    (void)read_end;
+#endif
+  }
 
  public:
   PosixRandomAccessFile(const string& fname, int fd)
@@ -68,6 +124,7 @@ class PosixRandomAccessFile : public RandomAccessFile {
   absl::Status Read(uint64 offset, size_t n, StringPiece* result,
                     char* scratch) const override {
     absl::Status s;
+    const uint64 start_offset = offset;
     char* dst = scratch;
     while (n > 0 && s.ok()) {
       // Some platforms, notably macs, throw EINVAL if pread is asked to read
@@ -94,6 +151,9 @@ class PosixRandomAccessFile : public RandomAccessFile {
       }
     }
     *result = StringPiece(scratch, dst - scratch);
+    if (s.ok()) {
+      MaybeAdviseReadahead(start_offset, offset);
+    }
     return s;
   }
 
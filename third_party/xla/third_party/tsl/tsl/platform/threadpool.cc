@@ -17,6 +17,11 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
 #include "absl/types/optional.h"
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tsl/platform/blocking_counter.h"
@@ -146,6 +151,35 @@ void ThreadPool::Schedule(std::function<void()> fn) {
   underlying_threadpool_->Schedule(std::move(fn));
 }
 
+void ThreadPool::ScheduleWorkItems(int64_t num_items, int max_parallelism,
+                                   std::function<void(int64_t)> fn) {
+  CHECK_GE(num_items, 0);
+  CHECK_GE(max_parallelism, 1);
+  CHECK(fn != nullptr);
+  if (num_items == 0) return;
+  // Shared between the enqueued closures; each closure claims item indices
+  // until all items are taken, so a single enqueue serves many items.
+  struct BulkState {
+    std::atomic<int64_t> next{0};
+    int64_t num_items;
+    std::function<void(int64_t)> fn;
+  };
+  auto state = std::make_shared<BulkState>();
+  state->num_items = num_items;
+  state->fn = std::move(fn);
+  const int64_t num_closures = std::min(
+      num_items, static_cast<int64_t>(std::min(max_parallelism, NumThreads())));
+  for (int64_t i = 0; i < num_closures; ++i) {
+    Schedule([state]() {
+      int64_t index;
+      while ((index = state->next.fetch_add(1, std::memory_order_relaxed)) <
+             state->num_items) {
+        state->fn(index);
+      }
+    });
+  }
+}
+
 int ThreadPool::NumShardsUsedByFixedBlockSizeScheduling(
     const int64_t total, const int64_t block_size) {
   if (block_size <= 0 || total <= 1 || total <= block_size ||
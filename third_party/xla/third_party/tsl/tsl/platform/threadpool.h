@@ -138,6 +138,22 @@ class ThreadPool {
   // Schedules fn() for execution in the pool of threads.
   void Schedule(std::function<void()> fn);
 
+  // Schedules "num_items" logically-separate work items, invoking
+  // fn(item_index) once for each index in [0, num_items). Unlike calling
+  // Schedule() once per item, only min(num_items, max_parallelism,
+  // NumThreads()) closures are enqueued; each claims item indices from a
+  // shared atomic counter until all items are taken. This amortizes the
+  // per-enqueue cost (~1us) over many small items.
+  //
+  // Does not wait for the items to complete; callers needing completion
+  // should arrange for it in fn (e.g. with a BlockingCounter). Items are
+  // executed only on pool threads, never on the calling thread.
+  //
+  // REQUIRES: num_items >= 0
+  // REQUIRES: max_parallelism >= 1
+  void ScheduleWorkItems(int64_t num_items, int max_parallelism,
+                         std::function<void(int64_t)> fn);
+
   void SetStealPartitions(
       const std::vector<std::pair<unsigned, unsigned>>& partitions);
 
@@ -0,0 +1,128 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "tsl/platform/test.h"
+#include "tsl/platform/types.h"
+#include "tsl/profiler/backends/cpu/traceme_recorder.h"
+#include "tsl/profiler/utils/math_utils.h"
+#include "tsl/profiler/utils/time_utils.h"
+
+namespace tsl {
+namespace profiler {
+namespace {
+
+using ::testing::Contains;
+using ::testing::Not;
+
+MATCHER_P(Named, name, "") { return arg.name == name; }
+
+// Returns all dumped events flattened across threads.
+std::vector<TraceMeRecorder::Event> Flatten(TraceMeRecorder::Events events) {
+  std::vector<TraceMeRecorder::Event> result;
+  for (auto& thread_events : events) {
+    for (auto& event : thread_events.events) {
+      result.push_back(std::move(event));
+    }
+  }
+  return result;
+}
+
+TEST(FlightRecorderTest, RecordsWithoutProfilerSession) {
+  int64_t start_time = GetCurrentTimeNanos();
+  int64_t end_time = start_time + UniToNano(1);
+
+  ASSERT_TRUE(TraceMeFlightRecorder::Start(/*level=*/1));
+  EXPECT_TRUE(TraceMeFlightRecorder::Active());
+  TraceMeRecorder::Record({"flight_only", start_time, end_time});
+
+  // A profiler session sees only the events recorded while it was active;
+  // the flight recorder captures both.
+  TraceMeRecorder::Start(/*level=*/1);
+  TraceMeRecorder::Record({"both", start_time, end_time});
+  auto session_events = Flatten(TraceMeRecorder::Stop());
+  EXPECT_THAT(session_events, Contains(Named("both")));
+  EXPECT_THAT(session_events, Not(Contains(Named("flight_only"))));
+
+  auto dumped = Flatten(TraceMeFlightRecorder::Dump());
+  EXPECT_THAT(dumped, Contains(Named("flight_only")));
+  EXPECT_THAT(dumped, Contains(Named("both")));
+
+  TraceMeFlightRecorder::Stop();
+  EXPECT_FALSE(TraceMeFlightRecorder::Active());
+}
+
+TEST(FlightRecorderTest, RingBufferKeepsMostRecentEvents) {
+  int64_t start_time = GetCurrentTimeNanos();
+  int64_t end_time = start_time + UniToNano(1);
+
+  ASSERT_TRUE(TraceMeFlightRecorder::Start(/*level=*/1));
+  constexpr size_t kExtra = 100;
+  const size_t num_events =
+      TraceMeFlightRecorder::kMaxEventsPerThread + kExtra;
+  for (size_t i = 0; i < num_events; ++i) {
+    TraceMeRecorder::Record({absl::StrCat("e", i), start_time, end_time});
+  }
+
+  auto dumped = Flatten(TraceMeFlightRecorder::Dump());
+  ASSERT_EQ(dumped.size(), TraceMeFlightRecorder::kMaxEventsPerThread);
+  // The oldest events were overwritten; the ring holds the most recent ones
+  // in recording order.
+  EXPECT_EQ(dumped.front().name, absl::StrCat("e", kExtra));
+  EXPECT_EQ(dumped.back().name, absl::StrCat("e", num_events - 1));
+
+  TraceMeFlightRecorder::Stop();
+}
+
+TEST(FlightRecorderTest, DumpFiltersByWindow) {
+  int64_t now = GetCurrentTimeNanos();
+
+  ASSERT_TRUE(TraceMeFlightRecorder::Start(/*level=*/1));
+  TraceMeRecorder::Record({"old", now - UniToNano(10), now - UniToNano(9)});
+  TraceMeRecorder::Record({"fresh", now - UniToNano(1), now});
+
+  auto dumped = Flatten(TraceMeFlightRecorder::Dump(
+      /*window_ns=*/UniToNano(5)));
+  EXPECT_THAT(dumped, Contains(Named("fresh")));
+  EXPECT_THAT(dumped, Not(Contains(Named("old"))));
+
+  TraceMeFlightRecorder::Stop();
+}
+
+TEST(FlightRecorderTest, DumpMergesSplitEvents) {
+  int64_t start_time = GetCurrentTimeNanos();
+  int64_t end_time = start_time + UniToNano(1);
+  const int64_t activity_id = TraceMeRecorder::NewActivityId();
+
+  ASSERT_TRUE(TraceMeFlightRecorder::Start(/*level=*/1));
+  TraceMeRecorder::Record({"split", start_time, -activity_id});
+  TraceMeRecorder::Record({std::string(), -activity_id, end_time});
+
+  auto dumped = Flatten(TraceMeFlightRecorder::Dump());
+  ASSERT_EQ(dumped.size(), 1);
+  EXPECT_EQ(dumped[0].name, "split");
+  EXPECT_TRUE(dumped[0].IsComplete());
+  EXPECT_EQ(dumped[0].start_time, start_time);
+  EXPECT_EQ(dumped[0].end_time, end_time);
+
+  TraceMeFlightRecorder::Stop();
+}
+
+}  // namespace
+}  // namespace profiler
+}  // namespace tsl
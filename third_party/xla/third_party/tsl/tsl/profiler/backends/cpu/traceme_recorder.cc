@@ -19,7 +19,9 @@ limitations under the License.
 
 #include <algorithm>
 #include <atomic>
+#include <cstdlib>
 #include <deque>
+#include <limits>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -28,6 +30,8 @@ limitations under the License.
 #include "tsl/platform/env.h"
 #include "tsl/platform/logging.h"
 #include "tsl/platform/macros.h"
+#include "tsl/platform/mutex.h"
+#include "tsl/platform/thread_annotations.h"
 #include "tsl/platform/types.h"
 #include "tsl/profiler/utils/lock_free_queue.h"
 #include "tsl/profiler/utils/per_thread.h"
@@ -55,6 +59,20 @@ static_assert(ATOMIC_INT_LOCK_FREE == 2, "Assumed atomic<int> was lock free");
 
 namespace {
 
+// Level requested by the active profiler session, or kTracingDisabled.
+std::atomic<int> g_profiler_level(TraceMeRecorder::kTracingDisabled);
+
+// Level requested by the flight recorder, or kTracingDisabled.
+std::atomic<int> g_flight_recorder_level(TraceMeRecorder::kTracingDisabled);
+
+// Recomputes the effective trace level observed by TraceMeRecorder::Active.
+void UpdateEffectiveTraceLevel() {
+  internal::g_trace_level.store(
+      std::max(g_profiler_level.load(std::memory_order_acquire),
+               g_flight_recorder_level.load(std::memory_order_acquire)),
+      std::memory_order_release);
+}
+
 // Track events created by ActivityStart and merge their data into events
 // created by ActivityEnd. TraceMe records events in its destructor, so this
 // results in complete events sorted by their end_time in the thread they ended.
@@ -146,6 +164,72 @@ class ThreadLocalRecorder {
   LockFreeQueue<TraceMeRecorder::Event> queue_;
 };
 
+// Fixed-size ring of the most recent TraceMe events of one thread, used by
+// TraceMeFlightRecorder. The producer appends under a lock that is
+// uncontended except while another thread snapshots the buffer for a dump.
+class ThreadLocalRing {
+ public:
+  ThreadLocalRing() {
+    auto* env = Env::Default();
+    info_.tid = env->GetCurrentThreadId();
+    env->GetCurrentThreadName(&info_.name);
+  }
+
+  const TraceMeRecorder::ThreadInfo& Info() const { return info_; }
+
+  // Record is only called from the producer thread.
+  void Record(TraceMeRecorder::Event&& event) {
+    mutex_lock lock(mu_);
+    if (events_.size() < TraceMeFlightRecorder::kMaxEventsPerThread) {
+      events_.push_back(std::move(event));
+    } else {
+      events_[next_ % events_.size()] = std::move(event);
+    }
+    ++next_;
+  }
+
+  // Clear is called from the control thread when the flight recorder starts
+  // to drop events buffered by a previous activation.
+  void Clear() {
+    mutex_lock lock(mu_);
+    events_.clear();
+    next_ = 0;
+  }
+
+  // Copies the buffered events in recording order, routing start events into
+  // `split_event_tracker` like ThreadLocalRecorder::Consume. Events whose
+  // timestamp is older than `cutoff_ns` are skipped.
+  TF_MUST_USE_RESULT std::deque<TraceMeRecorder::Event> Snapshot(
+      int64_t cutoff_ns, SplitEventTracker* split_event_tracker) const {
+    std::deque<TraceMeRecorder::Event> events;
+    mutex_lock lock(mu_);
+    const size_t size = events_.size();
+    const size_t oldest =
+        (size < TraceMeFlightRecorder::kMaxEventsPerThread) ? 0 : next_ % size;
+    for (size_t i = 0; i < size; ++i) {
+      const TraceMeRecorder::Event& event = events_[(oldest + i) % size];
+      const int64_t visible_time_ns =
+          event.IsStart() ? event.start_time : event.end_time;
+      if (visible_time_ns < cutoff_ns) continue;
+      if (event.IsStart()) {
+        split_event_tracker->AddStart(TraceMeRecorder::Event(event));
+        continue;
+      }
+      events.push_back(event);
+      if (events.back().IsEnd()) {
+        split_event_tracker->AddEnd(&events.back());
+      }
+    }
+    return events;
+  }
+
+ private:
+  TraceMeRecorder::ThreadInfo info_;
+  mutable mutex mu_;
+  std::vector<TraceMeRecorder::Event> events_ TF_GUARDED_BY(mu_);
+  size_t next_ TF_GUARDED_BY(mu_) = 0;
+};
+
 }  // namespace
 
 // This method is performance critical and should be kept fast. It is called
@@ -176,23 +260,35 @@ class ThreadLocalRecorder {
 /* static */ bool TraceMeRecorder::Start(int level) {
   level = std::max(0, level);
   int expected = kTracingDisabled;
-  bool started = internal::g_trace_level.compare_exchange_strong(
+  bool started = g_profiler_level.compare_exchange_strong(
       expected, level, std::memory_order_acq_rel);
   if (started) {
     // We may have old events in buffers because Record() raced with Stop().
     Clear();
+    UpdateEffectiveTraceLevel();
   }
   return started;
 }
 
 /* static */ void TraceMeRecorder::Record(Event&& event) {
+  if (TF_PREDICT_FALSE(TraceMeFlightRecorder::Active())) {
+    if (g_profiler_level.load(std::memory_order_acquire) == kTracingDisabled) {
+      // Flight recorder only: keep the profiler queues empty so they cannot
+      // grow without a session to consume them.
+      TraceMeFlightRecorder::Record(std::move(event));
+      return;
+    }
+    TraceMeFlightRecorder::Record(Event(event));
+  }
   PerThread<ThreadLocalRecorder>::Get().Record(std::move(event));
 }
 
 /* static */ TraceMeRecorder::Events TraceMeRecorder::Stop() {
   TraceMeRecorder::Events events;
-  if (internal::g_trace_level.exchange(
-          kTracingDisabled, std::memory_order_acq_rel) != kTracingDisabled) {
+  if (g_profiler_level.exchange(kTracingDisabled,
+                                std::memory_order_acq_rel) !=
+      kTracingDisabled) {
+    UpdateEffectiveTraceLevel();
     events = Consume();
   }
   return events;
@@ -210,5 +306,79 @@ class ThreadLocalRecorder {
   return static_cast<int64_t>(thread_id) << 32 | per_thread_activity_id++;
 }
 
+/* static */ bool TraceMeFlightRecorder::Start(int level) {
+  level = std::max(0, level);
+  int expected = TraceMeRecorder::kTracingDisabled;
+  bool started = g_flight_recorder_level.compare_exchange_strong(
+      expected, level, std::memory_order_acq_rel);
+  if (started) {
+    // Drop events buffered by a previous activation, and keep the rings of
+    // exiting threads alive until Stop() so their events remain dumpable.
+    auto rings = PerThread<ThreadLocalRing>::StartRecording();
+    for (auto& ring : rings) {
+      ring->Clear();
+    }
+    UpdateEffectiveTraceLevel();
+  }
+  return started;
+}
+
+/* static */ void TraceMeFlightRecorder::Stop() {
+  if (g_flight_recorder_level.exchange(TraceMeRecorder::kTracingDisabled,
+                                       std::memory_order_acq_rel) !=
+      TraceMeRecorder::kTracingDisabled) {
+    UpdateEffectiveTraceLevel();
+    PerThread<ThreadLocalRing>::StopRecording();
+  }
+}
+
+/* static */ bool TraceMeFlightRecorder::Active() {
+  return g_flight_recorder_level.load(std::memory_order_acquire) !=
+         TraceMeRecorder::kTracingDisabled;
+}
+
+/* static */ void TraceMeFlightRecorder::Record(
+    TraceMeRecorder::Event&& event) {
+  PerThread<ThreadLocalRing>::Get().Record(std::move(event));
+}
+
+/* static */ TraceMeRecorder::Events TraceMeFlightRecorder::Dump(
+    int64_t window_ns) {
+  TraceMeRecorder::Events result;
+  if (!Active()) return result;
+  const int64_t cutoff_ns =
+      (window_ns > 0)
+          ? static_cast<int64_t>(Env::Default()->NowNanos()) - window_ns
+          : std::numeric_limits<int64_t>::min();
+  // Re-registering releases the rings of threads that exited since the last
+  // dump once their events have been consumed below.
+  auto rings = PerThread<ThreadLocalRing>::StopRecording();
+  PerThread<ThreadLocalRing>::StartRecording();
+  SplitEventTracker split_event_tracker;
+  for (auto& ring : rings) {
+    auto events = ring->Snapshot(cutoff_ns, &split_event_tracker);
+    if (!events.empty()) {
+      result.push_back({ring->Info(), std::move(events)});
+    }
+  }
+  split_event_tracker.HandleCrossThreadEvents();
+  return result;
+}
+
+namespace {
+
+// Supports always-on deployments without a code change: the flight recorder
+// starts at process startup if TF_TRACEME_FLIGHT_RECORDER_LEVEL is set to a
+// positive level.
+TF_ATTRIBUTE_UNUSED const bool flight_recorder_autostarted = []() {
+  const char* level_str = std::getenv("TF_TRACEME_FLIGHT_RECORDER_LEVEL");
+  if (level_str == nullptr) return false;
+  const int level = std::atoi(level_str);
+  if (level <= 0) return false;
+  return TraceMeFlightRecorder::Start(level);
+}();
+
+}  // namespace
+
 }  // namespace profiler
 }  // namespace tsl
@@ -16,6 +16,7 @@ limitations under the License.
 #define TENSORFLOW_TSL_PROFILER_BACKENDS_CPU_TRACEME_RECORDER_H_
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <string>
@@ -28,9 +29,10 @@ namespace tsl {
 namespace profiler {
 namespace internal {
 
-// Current trace level.
+// Current effective trace level: the maximum of the profiler session level
+// and the flight recorder level.
 // Static atomic so TraceMeRecorder::Active can be fast and non-blocking.
-// Modified by TraceMeRecorder singleton when tracing starts/stops.
+// Modified when a profiler session or the flight recorder starts/stops.
 TF_EXPORT extern std::atomic<int> g_trace_level;
 
 }  // namespace internal
@@ -112,6 +114,54 @@ class TraceMeRecorder {
   static TF_MUST_USE_RESULT Events Consume();
 };
 
+// TraceMeFlightRecorder is an always-on "flight recorder" for TraceMe
+// events. When started, each thread keeps its most recent events in a
+// fixed-size ring buffer, independently of profiler sessions. Dump()
+// snapshots the buffered events on demand, e.g. when a request exceeds its
+// SLO, so tail-latency spikes can be examined postmortem without a profiler
+// session having been running.
+//
+// The recording cost per TraceMe at or below the chosen level is an
+// uncontended per-thread lock and a slot overwrite in a pre-sized buffer;
+// memory is bounded by kMaxEventsPerThread per thread. Use a low level
+// (e.g. 1, user instrumentation only) in production to keep the overhead
+// well under 1%.
+//
+// Can be enabled at process startup by setting the environment variable
+// TF_TRACEME_FLIGHT_RECORDER_LEVEL to the desired level.
+class TraceMeFlightRecorder {
+ public:
+  // Maximum number of events retained per thread.
+  static constexpr size_t kMaxEventsPerThread = 1 << 12;
+
+  // Starts recording TraceMes with level <= `level` into per-thread ring
+  // buffers. Returns false if the flight recorder is already started.
+  static bool Start(int level);
+
+  // Stops the flight recorder and discards buffered events.
+  static void Stop();
+
+  // Returns whether the flight recorder is started. Racy, but cheap!
+  static bool Active();
+
+  // Returns a snapshot of the buffered events of all threads, oldest first
+  // within each thread. If `window_ns` > 0, only events newer than
+  // `window_ns` ago are returned. Start/end event pairs are merged as in
+  // TraceMeRecorder::Stop(). Recording continues and the buffers are not
+  // cleared.
+  static TF_MUST_USE_RESULT TraceMeRecorder::Events Dump(
+      int64_t window_ns = 0);
+
+  // Records an event into the calling thread's ring buffer. Called by
+  // TraceMeRecorder::Record(); most callers should create TraceMe objects
+  // instead.
+  static void Record(TraceMeRecorder::Event&& event);
+
+ private:
+  TraceMeFlightRecorder() = delete;
+  ~TraceMeFlightRecorder() = delete;
+};
+
 }  // namespace profiler
 }  // namespace tsl
 
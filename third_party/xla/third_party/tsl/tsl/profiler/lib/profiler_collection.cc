@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tsl/profiler/lib/profiler_collection.h"
 
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -55,5 +56,20 @@ absl::Status ProfilerCollection::CollectData(
   return status;
 }
 
+absl::Status ProfilerCollection::CollectDataStreaming(
+    const std::function<absl::Status(tensorflow::profiler::XPlane&&)>&
+        consume) {
+  absl::Status status;
+  for (auto& profiler : profilers_) {
+    tensorflow::profiler::XSpace space;
+    status.Update(profiler->CollectData(&space));
+    for (tensorflow::profiler::XPlane& plane : *space.mutable_planes()) {
+      status.Update(consume(std::move(plane)));
+    }
+  }
+  profilers_.clear();  // data has been collected
+  return status;
+}
+
 }  // namespace profiler
 }  // namespace tsl
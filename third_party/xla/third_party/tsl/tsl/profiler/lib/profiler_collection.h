@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_TSL_PROFILER_LIB_PROFILER_COLLECTION_H_
 #define TENSORFLOW_TSL_PROFILER_LIB_PROFILER_COLLECTION_H_
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -39,6 +40,14 @@ class ProfilerCollection : public ProfilerInterface {
 
   absl::Status CollectData(tensorflow::profiler::XSpace* space) override;
 
+  // Like CollectData, but collects one profiler at a time and hands each
+  // completed plane to `consume`, so the caller can flush it and release its
+  // memory before the next profiler's data is materialized. At most one
+  // profiler's XSpace is held in memory at any time.
+  absl::Status CollectDataStreaming(
+      const std::function<absl::Status(tensorflow::profiler::XPlane&&)>&
+          consume);
+
  private:
   std::vector<std::unique_ptr<ProfilerInterface>> profilers_;
 };
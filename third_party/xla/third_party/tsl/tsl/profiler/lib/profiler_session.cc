@@ -34,6 +34,7 @@ limitations under the License.
 #include "tsl/profiler/lib/profiler_interface.h"
 #include "tsl/profiler/lib/profiler_lock.h"
 #include "tsl/profiler/utils/time_utils.h"
+#include "tsl/profiler/utils/xspace_stream.h"
 #endif
 
 namespace tsl {
@@ -87,6 +88,30 @@ absl::Status ProfilerSession::CollectData(XSpace* space) {
   return absl::OkStatus();
 }
 
+absl::Status ProfilerSession::CollectDataToStream(
+    profiler::XSpaceStreamWriter* writer) {
+#if !defined(IS_MOBILE_PLATFORM)
+  XSpace metadata;
+  metadata.add_hostnames(port::Hostname());
+  TF_RETURN_IF_ERROR(writer->WriteMetadata(metadata));
+  mutex_lock l(mutex_);
+  TF_RETURN_IF_ERROR(status_);
+  LOG(INFO) << "Profiler session streaming collected data.";
+  if (profilers_ != nullptr) {
+    profilers_->Stop().IgnoreError();
+    stop_time_ns_ = profiler::GetCurrentTimeNanos();
+    TF_RETURN_IF_ERROR(profilers_->CollectDataStreaming(
+        [writer](tensorflow::profiler::XPlane&& plane) {
+          return writer->WritePlane(plane);
+        }));
+    profilers_.reset();  // data has been collected.
+  }
+  // Allow another session to start.
+  profiler_lock_.ReleaseIfActive();
+#endif
+  return absl::OkStatus();
+}
+
 ProfilerSession::ProfilerSession(const ProfileOptions& options)
 #if defined(IS_MOBILE_PLATFORM)
     : status_(errors::Unimplemented(
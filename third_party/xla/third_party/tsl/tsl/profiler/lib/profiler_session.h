@@ -29,12 +29,17 @@ limitations under the License.
 #include "tsl/profiler/protobuf/xplane.pb.h"
 
 #if !defined(IS_MOBILE_PLATFORM)
+#include "tsl/profiler/lib/profiler_collection.h"
 #include "tsl/profiler/lib/profiler_interface.h"
 #include "tsl/profiler/lib/profiler_lock.h"
 #endif
 
 namespace tsl {
 
+namespace profiler {
+class XSpaceStreamWriter;
+}  // namespace profiler
+
 // A profiler which will start profiling when creating the object and will stop
 // when either the object is destroyed or CollectData is called.
 // Multiple instances can be created, but at most one of them will profile.
@@ -67,6 +72,14 @@ class ProfilerSession {
   absl::Status CollectData(tensorflow::profiler::XSpace* space)
       TF_LOCKS_EXCLUDED(mutex_);
 
+  // Collects profile data, streaming each completed plane to `writer` instead
+  // of buffering the whole XSpace in memory, so long high-frequency traces
+  // have bounded collector memory. Unlike CollectData, the streamed planes
+  // are not post-processed; reassemble the space with ReadXSpaceStream and
+  // apply PostProcessSingleHostXSpace if a processed trace is needed.
+  absl::Status CollectDataToStream(profiler::XSpaceStreamWriter* writer)
+      TF_LOCKS_EXCLUDED(mutex_);
+
  private:
   // Constructs an instance of the class and starts profiling
   explicit ProfilerSession(const tensorflow::ProfileOptions& options);
@@ -81,7 +94,8 @@ class ProfilerSession {
 
   profiler::ProfilerLock profiler_lock_ TF_GUARDED_BY(mutex_);
 
-  std::unique_ptr<profiler::ProfilerInterface> profilers_ TF_GUARDED_BY(mutex_);
+  std::unique_ptr<profiler::ProfilerCollection> profilers_
+      TF_GUARDED_BY(mutex_);
 
   uint64 start_time_ns_;
   uint64 stop_time_ns_;
@@ -0,0 +1,109 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tsl/profiler/utils/xspace_stream.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "tsl/lib/io/record_reader.h"
+#include "tsl/lib/io/record_writer.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/errors.h"
+#include "tsl/platform/logging.h"
+#include "tsl/platform/statusor.h"
+#include "tsl/platform/tstring.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace tsl {
+namespace profiler {
+
+using tensorflow::profiler::XPlane;
+using tensorflow::profiler::XSpace;
+
+/*static*/ absl::StatusOr<std::unique_ptr<XSpaceStreamWriter>>
+XSpaceStreamWriter::Create(Env* env, const std::string& path) {
+  std::unique_ptr<WritableFile> file;
+  TF_RETURN_IF_ERROR(env->NewWritableFile(path, &file));
+  auto writer = std::make_unique<io::RecordWriter>(file.get());
+  return absl::WrapUnique(
+      new XSpaceStreamWriter(std::move(file), std::move(writer)));
+}
+
+XSpaceStreamWriter::XSpaceStreamWriter(std::unique_ptr<WritableFile> file,
+                                       std::unique_ptr<io::RecordWriter> writer)
+    : file_(std::move(file)), writer_(std::move(writer)) {}
+
+XSpaceStreamWriter::~XSpaceStreamWriter() {
+  if (writer_ != nullptr) {
+    absl::Status status = Close();
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to close XSpace stream: " << status;
+    }
+  }
+}
+
+absl::Status XSpaceStreamWriter::WriteMetadata(const XSpace& space) {
+  if (metadata_written_) {
+    return errors::FailedPrecondition(
+        "XSpace stream metadata must be written before any plane.");
+  }
+  XSpace metadata = space;
+  metadata.clear_planes();
+  metadata_written_ = true;
+  return writer_->WriteRecord(metadata.SerializeAsString());
+}
+
+absl::Status XSpaceStreamWriter::WritePlane(const XPlane& plane) {
+  if (!metadata_written_) {
+    TF_RETURN_IF_ERROR(WriteMetadata(XSpace()));
+  }
+  return writer_->WriteRecord(plane.SerializeAsString());
+}
+
+absl::Status XSpaceStreamWriter::Close() {
+  TF_RETURN_IF_ERROR(writer_->Close());
+  writer_.reset();
+  absl::Status status = file_->Close();
+  file_.reset();
+  return status;
+}
+
+absl::Status ReadXSpaceStream(Env* env, const std::string& path,
+                              XSpace* space) {
+  std::unique_ptr<RandomAccessFile> file;
+  TF_RETURN_IF_ERROR(env->NewRandomAccessFile(path, &file));
+  io::SequentialRecordReader reader(file.get());
+  tstring record;
+  TF_RETURN_IF_ERROR(reader.ReadRecord(&record));
+  if (!space->MergeFromString(record)) {
+    return errors::DataLoss("Failed to parse XSpace stream metadata in ",
+                            path);
+  }
+  while (true) {
+    absl::Status status = reader.ReadRecord(&record);
+    if (errors::IsOutOfRange(status)) break;  // End of stream.
+    TF_RETURN_IF_ERROR(status);
+    if (!space->add_planes()->ParseFromString(record)) {
+      return errors::DataLoss("Failed to parse XPlane record in ", path);
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace profiler
+}  // namespace tsl
@@ -0,0 +1,76 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_TSL_PROFILER_UTILS_XSPACE_STREAM_H_
+#define TENSORFLOW_TSL_PROFILER_UTILS_XSPACE_STREAM_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/status/status.h"
+#include "tsl/lib/io/record_writer.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/statusor.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace tsl {
+namespace profiler {
+
+// Writes an XSpace to a file incrementally, one record per plane, so a large
+// trace never has to be buffered or serialized in memory all at once.
+//
+// Stream layout (tsl record format): the first record holds the plane-less
+// parts of the XSpace (hostnames, errors, warnings), followed by one record
+// per XPlane. Use ReadXSpaceStream() to reassemble the XSpace.
+//
+// Thread-safety: XSpaceStreamWriter is not thread-safe; callers must
+// serialize access.
+class XSpaceStreamWriter {
+ public:
+  // Creates a writer that streams to `path`, overwriting any existing file.
+  static absl::StatusOr<std::unique_ptr<XSpaceStreamWriter>> Create(
+      Env* env, const std::string& path);
+
+  // Closes the stream, logging on error. Prefer calling Close() explicitly.
+  ~XSpaceStreamWriter();
+
+  // Writes the plane-less parts of `space` as the stream's first record.
+  // Planes in `space` are ignored; pass them to WritePlane() instead.
+  // Returns an error if a plane has already been written.
+  absl::Status WriteMetadata(const tensorflow::profiler::XSpace& space);
+
+  // Appends one plane to the stream. If WriteMetadata() has not been called,
+  // an empty metadata record is written first so the stream stays readable.
+  absl::Status WritePlane(const tensorflow::profiler::XPlane& plane);
+
+  // Flushes buffered records and closes the file.
+  absl::Status Close();
+
+ private:
+  XSpaceStreamWriter(std::unique_ptr<WritableFile> file,
+                     std::unique_ptr<io::RecordWriter> writer);
+
+  std::unique_ptr<WritableFile> file_;
+  std::unique_ptr<io::RecordWriter> writer_;
+  bool metadata_written_ = false;
+};
+
+// Reassembles into `space` an XSpace written by XSpaceStreamWriter.
+absl::Status ReadXSpaceStream(Env* env, const std::string& path,
+                              tensorflow::profiler::XSpace* space);
+
+}  // namespace profiler
+}  // namespace tsl
+
+#endif  // TENSORFLOW_TSL_PROFILER_UTILS_XSPACE_STREAM_H_
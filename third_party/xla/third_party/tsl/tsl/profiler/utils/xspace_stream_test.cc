@@ -0,0 +1,87 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tsl/profiler/utils/xspace_stream.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "tsl/lib/core/status_test_util.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/path.h"
+#include "tsl/platform/test.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace tsl {
+namespace profiler {
+namespace {
+
+using tensorflow::profiler::XPlane;
+using tensorflow::profiler::XSpace;
+
+XPlane MakePlane(const std::string& name, int64_t id) {
+  XPlane plane;
+  plane.set_name(name);
+  plane.set_id(id);
+  return plane;
+}
+
+TEST(XSpaceStreamTest, RoundTrip) {
+  std::string path = io::JoinPath(testing::TmpDir(), "round_trip.xstream");
+  auto writer = XSpaceStreamWriter::Create(Env::Default(), path);
+  TF_ASSERT_OK(writer.status());
+
+  XSpace metadata;
+  metadata.add_hostnames("localhost");
+  TF_ASSERT_OK((*writer)->WriteMetadata(metadata));
+  TF_ASSERT_OK((*writer)->WritePlane(MakePlane("/host:CPU", 1)));
+  TF_ASSERT_OK((*writer)->WritePlane(MakePlane("/device:GPU:0", 2)));
+  TF_ASSERT_OK((*writer)->Close());
+
+  XSpace space;
+  TF_ASSERT_OK(ReadXSpaceStream(Env::Default(), path, &space));
+  ASSERT_EQ(space.hostnames_size(), 1);
+  EXPECT_EQ(space.hostnames(0), "localhost");
+  ASSERT_EQ(space.planes_size(), 2);
+  EXPECT_EQ(space.planes(0).name(), "/host:CPU");
+  EXPECT_EQ(space.planes(1).name(), "/device:GPU:0");
+  EXPECT_EQ(space.planes(1).id(), 2);
+}
+
+TEST(XSpaceStreamTest, PlaneWithoutMetadataIsReadable) {
+  std::string path = io::JoinPath(testing::TmpDir(), "no_metadata.xstream");
+  auto writer = XSpaceStreamWriter::Create(Env::Default(), path);
+  TF_ASSERT_OK(writer.status());
+  TF_ASSERT_OK((*writer)->WritePlane(MakePlane("/host:CPU", 1)));
+  TF_ASSERT_OK((*writer)->Close());
+
+  XSpace space;
+  TF_ASSERT_OK(ReadXSpaceStream(Env::Default(), path, &space));
+  EXPECT_EQ(space.hostnames_size(), 0);
+  ASSERT_EQ(space.planes_size(), 1);
+  EXPECT_EQ(space.planes(0).name(), "/host:CPU");
+}
+
+TEST(XSpaceStreamTest, MetadataAfterPlaneFails) {
+  std::string path = io::JoinPath(testing::TmpDir(), "late_metadata.xstream");
+  auto writer = XSpaceStreamWriter::Create(Env::Default(), path);
+  TF_ASSERT_OK(writer.status());
+  TF_ASSERT_OK((*writer)->WritePlane(MakePlane("/host:CPU", 1)));
+  EXPECT_FALSE((*writer)->WriteMetadata(XSpace()).ok());
+}
+
+}  // namespace
+}  // namespace profiler
+}  // namespace tsl
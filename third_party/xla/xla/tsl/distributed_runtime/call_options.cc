@@ -53,4 +53,14 @@ void CallOptions::SetTimeout(int64_t ms) {
   timeout_in_ms_ = ms;
 }
 
+int64_t CallOptions::GetDeadline() {
+  mutex_lock l(mu_);
+  return deadline_in_micros_;
+}
+
+void CallOptions::SetDeadline(int64_t deadline_in_micros) {
+  mutex_lock l(mu_);
+  deadline_in_micros_ = deadline_in_micros;
+}
+
 }  // end namespace tsl
@@ -66,6 +66,16 @@ class CallOptions {
   int64_t GetTimeout();
   void SetTimeout(int64_t ms);
 
+  // Get and set an absolute operation deadline, in microseconds since the
+  // Unix epoch. Unlike a timeout, which restarts from zero on every attempt,
+  // a deadline is a fixed budget shared by every attempt of every call
+  // issued with these options: retries and successive call phases all draw
+  // from the same budget instead of each waiting a full timeout.
+  //
+  // Default: 0, indicating there is no deadline for this call.
+  int64_t GetDeadline();
+  void SetDeadline(int64_t deadline_in_micros);
+
  private:
   mutex mu_;
   CancelFunction cancel_func_ TF_GUARDED_BY(mu_);
@@ -73,6 +83,9 @@ class CallOptions {
   // RPC operation timeout in milliseconds.
   int64_t timeout_in_ms_ TF_GUARDED_BY(mu_) = 0;
 
+  // Absolute RPC operation deadline in microseconds since the Unix epoch.
+  int64_t deadline_in_micros_ TF_GUARDED_BY(mu_) = 0;
+
   CallOptions(const CallOptions&) = delete;
   void operator=(const CallOptions&) = delete;
 };
@@ -146,7 +146,7 @@ class CoordinationServiceStandaloneImpl : public CoordinationServiceInterface {
   uint64_t GetServiceIncarnation() override;
   void StartCheckStaleness();  // Checks both heartbeat and barrier timeouts.
   void Stop(bool shut_staleness_thread = true);
-  bool ServiceHasStopped() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(state_mu_);
+  bool ServiceHasStopped() const ABSL_SHARED_LOCKS_REQUIRED(state_mu_);
   // Report service error to a specified task.
   void ReportServiceErrorToTaskAsync(const CoordinatedTask& destination_task,
                                      absl::Status error);
@@ -177,6 +177,23 @@ class CoordinationServiceStandaloneImpl : public CoordinationServiceInterface {
   void PassBarrier(std::string_view barrier_id, absl::Status result,
                    BarrierState* barrier)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(state_mu_);
+  // Runs the barrier callbacks deferred by PassBarrier(). Each callback
+  // typically completes a pending client RPC, so they are invoked outside of
+  // `state_mu_` to avoid serializing the O(cluster size) barrier fan-out
+  // behind every other coordination RPC.
+  void InvokeDeferredCallbacks() ABSL_LOCKS_EXCLUDED(state_mu_);
+  // Invokes the deferred barrier callbacks on destruction. Declare an
+  // instance before acquiring `state_mu_` so that the callbacks run after
+  // the lock has been released on every return path.
+  class DeferredCallbackScope {
+   public:
+    explicit DeferredCallbackScope(CoordinationServiceStandaloneImpl* service)
+        : service_(service) {}
+    ~DeferredCallbackScope() { service_->InvokeDeferredCallbacks(); }
+
+   private:
+    CoordinationServiceStandaloneImpl* const service_;
+  };
   // Check if participating tasks are specified correctly across barrier calls.
   bool ValidateTaskArgs(
       const std::vector<CoordinatedTask>& tasks_args,
@@ -274,6 +291,10 @@ class CoordinationServiceStandaloneImpl : public CoordinationServiceInterface {
   // For now, we assume there won't be many simultaneous barriers so we simply
   // use a set.
   absl::flat_hash_set<std::string> ongoing_barriers_ ABSL_GUARDED_BY(state_mu_);
+  // Callbacks of passed barriers with their results, waiting to be invoked
+  // once `state_mu_` is released. See InvokeDeferredCallbacks().
+  std::vector<std::pair<std::vector<StatusCallback>, absl::Status>>
+      deferred_barrier_callbacks_ ABSL_GUARDED_BY(state_mu_);
 
   absl::flat_hash_set<std::string> recoverable_jobs_;
 
@@ -423,6 +444,8 @@ void CoordinationServiceStandaloneImpl::StartCheckStaleness() {
               }
             }
           }
+          // Setting a task to error fails its ongoing barriers.
+          InvokeDeferredCallbacks();
           // Propagate heartbeat timeout errors to other connected tasks.
           if (!stale_task_names.empty()) {
             if (!has_service_to_client_connection) {
@@ -477,6 +500,7 @@ void CoordinationServiceStandaloneImpl::StartCheckStaleness() {
               PassBarrier(barrier_id, error, barrier);
             }
           }
+          InvokeDeferredCallbacks();
           if (!has_service_to_client_connection &&
               expired_barriers.contains(shutdown_barrier_id_)) {
             // Error cannot be propagated since there is no service-to-client
@@ -529,6 +553,7 @@ void CoordinationServiceStandaloneImpl::Stop(bool shut_staleness_thread) {
     // the state is used in `PassBarrier`.
     cluster_state_.clear();
   }
+  InvokeDeferredCallbacks();
   // Destroy thread outside of the mutex.
   if (shut_staleness_thread) {
     check_staleness_thread_.reset();
@@ -565,6 +590,7 @@ absl::Status CoordinationServiceStandaloneImpl::RegisterTask(
 
   absl::Status error;
   std::string error_message;
+  DeferredCallbackScope callback_scope(this);
   {
     absl::MutexLock l(&state_mu_);
     if (ServiceHasStopped()) {
@@ -672,6 +698,7 @@ void CoordinationServiceStandaloneImpl::ShutdownTaskAsync(
                  done);
   } else {
     absl::Status status;
+    DeferredCallbackScope callback_scope(this);
     {
       absl::MutexLock l(&state_mu_);
       if (ServiceHasStopped()) {
@@ -688,6 +715,7 @@ void CoordinationServiceStandaloneImpl::ShutdownTaskAsync(
 
 absl::Status CoordinationServiceStandaloneImpl::ResetTask(
     const CoordinatedTask& task) {
+  DeferredCallbackScope callback_scope(this);
   absl::MutexLock l(&state_mu_);
   return DisconnectTask(task);
 }
@@ -736,6 +764,7 @@ uint64_t CoordinationServiceStandaloneImpl::GetServiceIncarnation() {
 absl::Status CoordinationServiceStandaloneImpl::ReportTaskError(
     const CoordinatedTask& task, absl::Status error) {
   const std::string task_name = GetTaskName(task);
+  DeferredCallbackScope callback_scope(this);
   {
     absl::MutexLock l(&state_mu_);
     if (ServiceHasStopped()) {
@@ -785,7 +814,11 @@ absl::Status CoordinationServiceStandaloneImpl::RecordHeartbeat(
   const std::string task_name = GetTaskName(task);
   absl::Status s = absl::OkStatus();
   {
-    absl::MutexLock l(&state_mu_);
+    // Heartbeats arrive from every task concurrently and only read the
+    // cluster state (the heartbeat timestamp itself is guarded by a
+    // per-task mutex), so a shared lock suffices and keeps the heartbeat
+    // fan-in from serializing behind barrier and key-value RPCs.
+    absl::ReaderMutexLock l(&state_mu_);
     if (ServiceHasStopped()) {
       return MakeCoordinationError(absl::InternalError(absl::StrCat(
           "Coordination service has stopped. RecordHeartbeat() from task: ",
@@ -794,31 +827,33 @@ absl::Status CoordinationServiceStandaloneImpl::RecordHeartbeat(
           "coordination service to shut down before the workers disconnect "
           "gracefully. Check the task leader's logs for an earlier error to "
           "debug the root cause.")));
-    } else if (!cluster_state_.contains(task_name)) {
+    }
+    const auto task_state = cluster_state_.find(task_name);
+    if (task_state == cluster_state_.end()) {
       return MakeCoordinationError(absl::InvalidArgumentError(
           absl::StrCat("Unexpected heartbeat request from task: ", task_name,
                        ". This usually implies a configuration error.")));
     }
-    if (!cluster_state_[task_name]->GetStatus().ok()) {
-      return cluster_state_[task_name]->GetStatus();
-    } else if (cluster_state_[task_name]->GetState() ==
+    if (!task_state->second->GetStatus().ok()) {
+      return task_state->second->GetStatus();
+    } else if (task_state->second->GetState() ==
                    CoordinatedTaskState::TASKSTATE_DISCONNECTED &&
                // We accept heartbeats for a short grace period to account for
                // the lag time between the service recording the state change
                // and the agent stopping heartbeats.
                Env::Default()->NowMicros() >
-                   cluster_state_[task_name]
-                       ->GetDisconnectedGracePeriodMicros()) {
+                   task_state->second->GetDisconnectedGracePeriodMicros()) {
       return MakeCoordinationError(absl::InvalidArgumentError(absl::StrCat(
           "Task with task_name=", task_name,
           " must be registered before sending heartbeat messages")));
     }
-    s = cluster_state_[task_name]->RecordHeartbeat(incarnation);
+    s = task_state->second->RecordHeartbeat(incarnation);
   }
 
   // Set and propagate any heartbeat errors.
   if (!s.ok()) {
     {
+      DeferredCallbackScope callback_scope(this);
       absl::MutexLock l(&state_mu_);
       SetTaskError(task_name, s);
     }
@@ -1082,6 +1117,9 @@ void CoordinationServiceStandaloneImpl::BarrierAsync(
     StatusCallback done) {
   VLOG(3) << "Task " << GetTaskName(task) << " invoked BarrierAsync("
           << barrier_id << ").";
+  // If the barrier passes (or fails) below, notify the waiting tasks after
+  // `state_mu_` has been released.
+  DeferredCallbackScope callback_scope(this);
 
   // Check if caller task is participating in the barrier. If not, update
   // `barriers_` to cause subsequent calls from the same task and other tasks
@@ -1237,6 +1275,7 @@ void CoordinationServiceStandaloneImpl::BarrierAsync(
 
 absl::Status CoordinationServiceStandaloneImpl::CancelBarrier(
     std::string_view barrier_id, const CoordinatedTask& task) {
+  DeferredCallbackScope callback_scope(this);
   absl::MutexLock l(&state_mu_);
   if (ServiceHasStopped()) {
     return MakeCoordinationError(absl::InternalError(
@@ -1316,15 +1355,34 @@ void CoordinationServiceStandaloneImpl::PassBarrier(std::string_view barrier_id,
   }
   barrier->tasks_at_barrier.clear();
   ongoing_barriers_.erase(barrier_id);
-  // Note: barrier_id shouldn't be referenced after this line as its lifetime
-  // may be tied to one of the callbacks.
-  // Propagate results to participating tasks.
-  for (const auto& callback : barrier->done_callbacks) {
-    callback(result);
+  // Defer propagating results to participating tasks until `state_mu_` is
+  // released (see InvokeDeferredCallbacks()). Each callback typically
+  // completes a pending RPC, so invoking all of them under the lock would
+  // serialize the barrier fan-out behind every other coordination RPC at
+  // large cluster sizes.
+  if (!barrier->done_callbacks.empty()) {
+    deferred_barrier_callbacks_.emplace_back(
+        std::move(barrier->done_callbacks), result);
   }
   barrier->done_callbacks.clear();
 }
 
+void CoordinationServiceStandaloneImpl::InvokeDeferredCallbacks() {
+  std::vector<std::pair<std::vector<StatusCallback>, absl::Status>> deferred;
+  {
+    absl::MutexLock l(&state_mu_);
+    if (deferred_barrier_callbacks_.empty()) {
+      return;
+    }
+    deferred.swap(deferred_barrier_callbacks_);
+  }
+  for (const auto& [callbacks, result] : deferred) {
+    for (const auto& callback : callbacks) {
+      callback(result);
+    }
+  }
+}
+
 bool CoordinationServiceStandaloneImpl::ValidateTaskArgs(
 
     const std::vector<CoordinatedTask>& tasks_args,
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_TSL_DISTRIBUTED_RUNTIME_RPC_GRPC_STATE_H_
 #define XLA_TSL_DISTRIBUTED_RUNTIME_RPC_GRPC_STATE_H_
 
+#include <algorithm>
 #include <queue>
 #include <string>
 #include <utility>
@@ -112,6 +113,20 @@ class RPCState : public GrpcClientCQTag {
         target_(target),
         parse_proto_fn_(std::move(parse_proto_fn)) {
     response_ = response;
+    // Convert the caller's budget into an absolute deadline shared by all
+    // attempts, so a retry chain can never exceed it. A deadline set on the
+    // CallOptions takes precedence if it is tighter; it may have been set by
+    // an earlier call in the same chain and already partially consumed.
+    if (timeout_in_ms_ > 0) {
+      deadline_micros_ = Env::Default()->NowMicros() + timeout_in_ms_ * 1000;
+    }
+    if (call_opts_ != nullptr) {
+      const int64_t opts_deadline = call_opts_->GetDeadline();
+      if (opts_deadline > 0 &&
+          (deadline_micros_ == 0 || opts_deadline < deadline_micros_)) {
+        deadline_micros_ = opts_deadline;
+      }
+    }
     ::grpc::Status s = GrpcMaybeUnparseProto(request, &request_buf_);
     if (!s.ok()) {
       LOG(ERROR) << "GrpcMaybeUnparseProto returned with non-ok status: "
@@ -127,9 +142,12 @@ class RPCState : public GrpcClientCQTag {
   void StartCall() {
     context_.reset(new ::grpc::ClientContext());
     context_->set_wait_for_ready(!fail_fast_);
-    if (timeout_in_ms_ > 0) {
-      context_->set_deadline(
-          gpr_time_from_millis(timeout_in_ms_, GPR_TIMESPAN));
+    if (deadline_micros_ > 0) {
+      // Each attempt only gets what is left of the overall budget, not a
+      // fresh timeout.
+      const int64_t remaining_ms = std::max<int64_t>(
+          1, (deadline_micros_ - Env::Default()->NowMicros()) / 1000);
+      context_->set_deadline(gpr_time_from_millis(remaining_ms, GPR_TIMESPAN));
     }
     if (call_opts_) {
       call_opts_->SetCancelCallback([this]() { context_->TryCancel(); });
@@ -175,34 +193,43 @@ class RPCState : public GrpcClientCQTag {
     // Retry if we have any attempts left
     if (++num_retries_ <= max_retries_ &&
         (absl::IsUnavailable(s) || absl::IsUnknown(s))) {
-      response_buf_.Clear();
-      VLOG(1) << "Retrying call for " << method_ << "Retry: " << num_retries_
-              << " of " << max_retries_;
-
       ComputeRetryBackoffMs(/*min_backoff_ms=*/1, /*max_backoff_ms=*/10000);
       int64_t backoff_us = retry_backoff_ms_ * 1000;
-      Env::Default()->SchedClosureAfter(/*micros=*/backoff_us,
-                                        [this]() { StartCall(); });
-    } else {
-      // Attach additional GRPC error information if any to the final status
-      string error_msg = std::string(s.message());
-      strings::StrAppend(&error_msg, "\nAdditional GRPC error information");
-      if (target_) {
-        strings::StrAppend(&error_msg, " from remote target ", *target_);
-      }
-      strings::StrAppend(&error_msg, " while calling ", method_);
-      strings::StrAppend(&error_msg, ":\n:", context_->debug_error_string());
-      s = errors::CreateWithUpdatedMessage(s, error_msg);
-      // Always treat gRPC cancellation as a derived error. This ensures that
-      // other error types are preferred during status aggregation. (gRPC
-      // cancellation messages do not contain the original status message).
-      if (s.code() == absl::StatusCode::kCancelled) {
-        s = StatusGroup::MakeDerived(s);
-      }
+      // Only retry if the remaining budget can cover the backoff; otherwise
+      // fail now instead of sleeping through an attempt that is bound to
+      // miss the deadline.
+      if (deadline_micros_ == 0 ||
+          Env::Default()->NowMicros() + backoff_us < deadline_micros_) {
+        response_buf_.Clear();
+        VLOG(1) << "Retrying call for " << method_ << "Retry: " << num_retries_
+                << " of " << max_retries_;
 
-      done_(s);
-      delete this;
+        Env::Default()->SchedClosureAfter(/*micros=*/backoff_us,
+                                          [this]() { StartCall(); });
+        return;
+      }
+      VLOG(1) << "Not retrying " << method_
+              << ": deadline budget exhausted after " << num_retries_ - 1
+              << " retries";
+    }
+    // Attach additional GRPC error information if any to the final status
+    string error_msg = std::string(s.message());
+    strings::StrAppend(&error_msg, "\nAdditional GRPC error information");
+    if (target_) {
+      strings::StrAppend(&error_msg, " from remote target ", *target_);
     }
+    strings::StrAppend(&error_msg, " while calling ", method_);
+    strings::StrAppend(&error_msg, ":\n:", context_->debug_error_string());
+    s = errors::CreateWithUpdatedMessage(s, error_msg);
+    // Always treat gRPC cancellation as a derived error. This ensures that
+    // other error types are preferred during status aggregation. (gRPC
+    // cancellation messages do not contain the original status message).
+    if (s.code() == absl::StatusCode::kCancelled) {
+      s = StatusGroup::MakeDerived(s);
+    }
+
+    done_(s);
+    delete this;
   }
 
   void ParseAndCallDone() {
@@ -237,6 +264,9 @@ class RPCState : public GrpcClientCQTag {
   ::grpc::Status status_;
   StatusCallback done_;
   int64_t timeout_in_ms_;
+  // Absolute deadline (microseconds since the Unix epoch) shared by all
+  // attempts of this call. 0 means no deadline.
+  int64_t deadline_micros_ = 0;
 
   size_t num_retries_ = 0;
   size_t max_retries_;
@@ -21,6 +21,7 @@ limitations under the License.
 #include <functional>
 #include <limits>
 #include <optional>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
@@ -93,6 +94,12 @@ struct AllocatorStats {
   std::optional<int64_t> pool_bytes;
   std::optional<int64_t> peak_pool_bytes;
 
+  // Per-size-class histogram of free memory, for allocators that bin their
+  // free chunks (e.g. BFCAllocator). Entry i holds the total bytes of free
+  // chunks whose size falls in bin i; a large total spread over small bins
+  // indicates fragmentation.
+  std::optional<std::vector<int64_t>> bin_free_bytes;
+
   AllocatorStats()
       : num_allocs(0),
         bytes_in_use(0),
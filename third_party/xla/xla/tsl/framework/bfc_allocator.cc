@@ -1208,7 +1208,58 @@ MemoryDump BFCAllocator::RecordMemoryMapInternal() {
 
 absl::optional<AllocatorStats> BFCAllocator::GetStats() {
   mutex_lock l(lock_);
-  return stats_;
+  AllocatorStats stats = stats_;
+  // Export the per-bin free-byte histogram so callers can distinguish "20%
+  // free in one block" from "20% free shattered across small bins".
+  const std::array<BinDebugInfo, kNumBins> bin_infos = get_bin_debug_info();
+  std::vector<int64_t> bin_free_bytes(kNumBins);
+  for (BinNum b = 0; b < kNumBins; b++) {
+    bin_free_bytes[b] = static_cast<int64_t>(bin_infos[b].total_bytes_in_bin -
+                                             bin_infos[b].total_bytes_in_use);
+  }
+  stats.bin_free_bytes = std::move(bin_free_bytes);
+  stats.largest_free_block_bytes = LargestFreeChunk();
+  return stats;
+}
+
+bool BFCAllocator::CompactMemoryOnIdle() {
+  mutex_lock l(lock_);
+  // First merge any timestamp-deferred chunks that have become safe, so that
+  // regions fragmented only by deferred frees can be recognized as fully
+  // free.
+  if (timing_counter_ != nullptr) {
+    MergeTimestampedChunks(0);
+  }
+
+  // Collect every region with no chunk in use.
+  absl::flat_hash_set<void*> free_region_ptrs;
+  size_t total_free_bytes = 0;
+  for (const AllocationRegion& region : region_manager_.regions()) {
+    ChunkHandle h = region_manager_.get_handle(region.ptr());
+    bool any_use = false;
+    while (h != kInvalidChunkHandle) {
+      const Chunk* c = ChunkFromHandle(h);
+      if (c->in_use()) {
+        any_use = true;
+        break;
+      }
+      h = c->next;
+    }
+    if (!any_use) {
+      free_region_ptrs.insert(region.ptr());
+      total_free_bytes += region.memory_size();
+    }
+  }
+  if (free_region_ptrs.empty()) {
+    return false;
+  }
+
+  VLOG(1) << "CompactMemoryOnIdle: releasing " << free_region_ptrs.size()
+          << " free region(s) totalling "
+          << strings::HumanReadableNumBytes(total_free_bytes) << " from "
+          << Name();
+  DeallocateRegions(free_region_ptrs);
+  return true;
 }
 
 bool BFCAllocator::ClearStats() {
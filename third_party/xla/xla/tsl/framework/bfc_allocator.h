@@ -94,10 +94,21 @@ class BFCAllocator : public Allocator {
 
   int64_t AllocationId(const void* ptr) const override;
 
+  // In addition to the base stats, fills AllocatorStats::bin_free_bytes with
+  // a per-bin histogram of free memory and refreshes
+  // largest_free_block_bytes, so callers can quantify fragmentation.
   absl::optional<AllocatorStats> GetStats() override;
 
   bool ClearStats() override;
 
+  // Best-effort defragmentation pass intended to be called while the device
+  // is idle (no allocations in flight from the caller's perspective). Merges
+  // timestamp-deferred free chunks that have become safe and returns every
+  // fully free AllocationRegion to the sub-allocator, independent of the
+  // garbage_collection option that gates the OOM-time path. Returns true if
+  // any region was released.
+  bool CompactMemoryOnIdle();
+
   void SetTimingCounter(SharedCounter* sc) { timing_counter_ = sc; }
 
   void SetSafeFrontier(uint64 count) override;
@@ -27,13 +27,26 @@ namespace tsl {
 const CancellationToken CancellationManager::kInvalidToken = -1;
 
 CancellationManager::CancellationManager()
-    : is_cancelling_(false),
-      is_cancelled_(false),
-      next_cancellation_token_(0) {}
+    : cancel_state_(kIdle), next_cancellation_token_(0) {}
 
 CancellationManager::CancellationManager(CancellationManager* parent)
-    : is_cancelling_(false), next_cancellation_token_(0), parent_(parent) {
-  is_cancelled_ = parent->RegisterChild(this);
+    : cancel_state_(kIdle), next_cancellation_token_(0), parent_(parent) {
+  if (parent->RegisterChild(this)) {
+    cancel_state_.store(kCancelled, std::memory_order_release);
+  }
+}
+
+CancellationManager::State* CancellationManager::EnsureState() {
+  State* state = state_ptr_.load(std::memory_order_acquire);
+  if (state != nullptr) {
+    return state;
+  }
+  mutex_lock l(mu_);
+  if (!state_) {
+    state_ = absl::make_unique<State>();
+    state_ptr_.store(state_.get(), std::memory_order_release);
+  }
+  return state_.get();
 }
 
 void CancellationManager::StartCancel() {
@@ -43,52 +56,65 @@ void CancellationManager::StartCancel() {
 }
 
 void CancellationManager::StartCancelWithStatus(const absl::Status& status) {
-  gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks_to_run;
   std::forward_list<CancellationManager*> children_to_cancel;
   Notification* cancelled_notification = nullptr;
+  State* state = nullptr;
   {
     mutex_lock l(mu_);
-    if (is_cancelled_.load(std::memory_order_relaxed) || is_cancelling_) {
+    int expected = kIdle;
+    if (!cancel_state_.compare_exchange_strong(expected, kCancelling,
+                                               std::memory_order_acq_rel)) {
       return;
     }
-    is_cancelling_ = true;
-    if (state_) {
-      std::swap(state_->callbacks, callbacks_to_run);
-
+    state = state_.get();
+    if (state) {
       // Remove all children from the list of children.
-      CancellationManager* child = state_->first_child;
+      CancellationManager* child = state->first_child;
       while (child != nullptr) {
         children_to_cancel.push_front(child);
         child->is_removed_from_parent_ = true;
         child = child->next_sibling_;
       }
-      state_->first_child = nullptr;
+      state->first_child = nullptr;
 
-      cancelled_notification = &state_->cancelled_notification;
+      cancelled_notification = &state->cancelled_notification;
     }
   }
-  // We call these callbacks without holding mu_, so that concurrent
+  // Drain the shards after the transition to kCancelling: a concurrent
+  // RegisterCallback either inserted into a shard before it is drained
+  // below (and its callback runs), or observes kCancelling under the
+  // shard mutex and is rejected.
+  //
+  // We call these callbacks without holding any mutex, so that concurrent
   // calls to DeregisterCallback, which can happen asynchronously, do
   // not block. The callbacks remain valid because any concurrent call
   // to DeregisterCallback will block until the
   // cancelled_notification_ is notified.
-  for (auto key_and_value : callbacks_to_run) {
-    CallbackConfiguration& config = key_and_value.second;
-    if (!status.ok() && config.log_error) {
-      LOG(WARNING) << "Cancellation callback \"" << config.name
-                   << "\" is triggered due to a "
-                   << (StatusGroup::IsDerived(status) ? "derived" : "root")
-                   << " error: " << status.ToString();
+  if (state) {
+    for (CallbackShard& shard : state->callback_shards) {
+      gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks_to_run;
+      {
+        mutex_lock l(shard.mu);
+        std::swap(shard.callbacks, callbacks_to_run);
+      }
+      for (auto& key_and_value : callbacks_to_run) {
+        CallbackConfiguration& config = key_and_value.second;
+        if (!status.ok() && config.log_error) {
+          LOG(WARNING) << "Cancellation callback \"" << config.name
+                       << "\" is triggered due to a "
+                       << (StatusGroup::IsDerived(status) ? "derived" : "root")
+                       << " error: " << status.ToString();
+        }
+        config.callback();
+      }
     }
-    config.callback();
   }
   for (CancellationManager* child : children_to_cancel) {
     child->StartCancelWithStatus(status);
   }
   {
     mutex_lock l(mu_);
-    is_cancelling_ = false;
-    is_cancelled_.store(true, std::memory_order_release);
+    cancel_state_.store(kCancelled, std::memory_order_release);
   }
   if (cancelled_notification) {
     cancelled_notification->Notify();
@@ -111,52 +137,58 @@ bool CancellationManager::RegisterCallbackWithErrorLogging(
 bool CancellationManager::RegisterCallbackConfig(CancellationToken token,
                                                  CallbackConfiguration config) {
   DCHECK_LT(token, next_cancellation_token_) << "Invalid cancellation token";
-  mutex_lock l(mu_);
-  bool should_register = !is_cancelled_ && !is_cancelling_;
+  if (cancel_state_.load(std::memory_order_acquire) != kIdle) {
+    return false;
+  }
+  State* state = EnsureState();
+  CallbackShard& shard = state->callback_shards[token % kNumCallbackShards];
+  mutex_lock l(shard.mu);
+  // Re-check under the shard mutex: StartCancel drains each shard under
+  // its mutex after transitioning to kCancelling, so if the manager is
+  // no longer idle here the drain of this shard has already begun or
+  // completed, and we must not add the callback.
+  bool should_register = cancel_state_.load(std::memory_order_acquire) == kIdle;
   if (should_register) {
-    if (!state_) {
-      state_ = absl::make_unique<State>();
-    }
-    std::swap(state_->callbacks[token], config);
+    std::swap(shard.callbacks[token], config);
   }
   return should_register;
 }
 
 bool CancellationManager::DeregisterCallback(CancellationToken token) {
-  mu_.lock();
-  if (is_cancelled_) {
-    mu_.unlock();
-    return false;
-  } else if (is_cancelling_) {
-    Notification* cancelled_notification =
-        state_ ? &state_->cancelled_notification : nullptr;
-    mu_.unlock();
-    // Wait for all of the cancellation callbacks to be called. This
-    // wait ensures that the caller of DeregisterCallback does not
-    // return immediately and free objects that may be used in the
-    // execution of any currently pending callbacks in StartCancel.
-    if (cancelled_notification) {
-      cancelled_notification->WaitForNotification();
-    }
-    return false;
-  } else {
-    if (state_) {
-      state_->callbacks.erase(token);
+  State* state = state_ptr_.load(std::memory_order_acquire);
+  if (state == nullptr) {
+    // No callback or child was ever registered, so there is nothing to
+    // deregister and no pending cancellation callbacks to wait for.
+    return cancel_state_.load(std::memory_order_acquire) == kIdle;
+  }
+  {
+    CallbackShard& shard = state->callback_shards[token % kNumCallbackShards];
+    mutex_lock l(shard.mu);
+    if (cancel_state_.load(std::memory_order_acquire) == kIdle) {
+      shard.callbacks.erase(token);
+      return true;
     }
-    mu_.unlock();
-    return true;
   }
+  // Wait for all of the cancellation callbacks to be called. This
+  // wait ensures that the caller of DeregisterCallback does not
+  // return immediately and free objects that may be used in the
+  // execution of any currently pending callbacks in StartCancel.
+  if (cancel_state_.load(std::memory_order_acquire) == kCancelling) {
+    state->cancelled_notification.WaitForNotification();
+  }
+  return false;
 }
 
 bool CancellationManager::RegisterChild(CancellationManager* child) {
   mutex_lock l(mu_);
-  if (is_cancelled_.load(std::memory_order_relaxed) || is_cancelling_) {
+  if (cancel_state_.load(std::memory_order_relaxed) != kIdle) {
     child->is_removed_from_parent_ = true;
     return true;
   }
 
   if (!state_) {
     state_ = absl::make_unique<State>();
+    state_ptr_.store(state_.get(), std::memory_order_release);
   }
 
   // Push `child` onto the front of the list of children.
@@ -194,7 +226,7 @@ void CancellationManager::DeregisterChild(CancellationManager* child) {
 
       child->is_removed_from_parent_ = true;
     }
-    if (is_cancelling_) {
+    if (cancel_state_.load(std::memory_order_relaxed) == kCancelling) {
       cancelled_notification = &state_->cancelled_notification;
     }
   }
@@ -208,15 +240,17 @@ void CancellationManager::DeregisterChild(CancellationManager* child) {
 }
 
 bool CancellationManager::TryDeregisterCallback(CancellationToken token) {
-  mutex_lock lock(mu_);
-  if (is_cancelled_ || is_cancelling_) {
+  State* state = state_ptr_.load(std::memory_order_acquire);
+  if (state == nullptr) {
+    return cancel_state_.load(std::memory_order_acquire) == kIdle;
+  }
+  CallbackShard& shard = state->callback_shards[token % kNumCallbackShards];
+  mutex_lock lock(shard.mu);
+  if (cancel_state_.load(std::memory_order_acquire) != kIdle) {
     return false;
-  } else {
-    if (state_) {
-      state_->callbacks.erase(token);
-    }
-    return true;
   }
+  shard.callbacks.erase(token);
+  return true;
 }
 
 CancellationManager::~CancellationManager() {
@@ -229,8 +263,7 @@ CancellationManager::~CancellationManager() {
 }
 
 bool CancellationManager::IsCancelling() {
-  mutex_lock lock(mu_);
-  return is_cancelling_;
+  return cancel_state_.load(std::memory_order_acquire) == kCancelling;
 }
 
 absl::Status RegisterCancellationCallback(
@@ -70,7 +70,9 @@ class CancellationManager {
   void StartCancelWithStatus(const absl::Status& status);
 
   // Returns true iff StartCancel() has been called.
-  bool IsCancelled() { return is_cancelled_.load(std::memory_order_acquire); }
+  bool IsCancelled() {
+    return cancel_state_.load(std::memory_order_acquire) == kCancelled;
+  }
 
   // Returns a token that must be used in calls to RegisterCallback
   // and DeregisterCallback.
@@ -167,23 +169,46 @@ class CancellationManager {
     bool log_error = false;
   };
 
+  // Callback registrations are sharded by token so that concurrent
+  // Register/Deregister calls (typically short cancellable ops on
+  // different executor threads) do not serialize on a single mutex.
+  // Tokens are handed out round-robin by get_cancellation_token, which
+  // spreads concurrent registrations across shards.
+  static constexpr int kNumCallbackShards = 16;
+  struct CallbackShard {
+    mutex mu;
+    gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks
+        TF_GUARDED_BY(mu);
+  };
+
   struct State {
     Notification cancelled_notification;
-    gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks;
+    CallbackShard callback_shards[kNumCallbackShards];
 
     // If this CancellationManager has any children, this member points to the
-    // head of a doubly-linked list of its children.
+    // head of a doubly-linked list of its children. Guarded by the manager's
+    // mu_.
     CancellationManager* first_child = nullptr;  // Not owned.
   };
 
+  // Lifecycle of the manager; transitions kIdle -> kCancelling ->
+  // kCancelled exactly once. Register/Deregister re-check this under the
+  // relevant shard mutex: StartCancel transitions to kCancelling before
+  // draining the shards, so a registration either lands in a shard before
+  // it is drained (and the callback runs) or observes the transition and
+  // is rejected.
+  enum CancelState : int { kIdle = 0, kCancelling = 1, kCancelled = 2 };
+
   bool RegisterCallbackConfig(CancellationToken token,
                               CallbackConfiguration config);
 
   bool RegisterChild(CancellationManager* child);
   void DeregisterChild(CancellationManager* child);
 
-  bool is_cancelling_;
-  std::atomic_bool is_cancelled_;
+  // Returns the lazily created state, creating it if needed.
+  State* EnsureState();
+
+  std::atomic<int> cancel_state_;
   std::atomic<CancellationToken> next_cancellation_token_;
 
   CancellationManager* const parent_ = nullptr;  // Not owned.
@@ -203,6 +228,9 @@ class CancellationManager {
 
   mutex mu_;
   std::unique_ptr<State> state_ TF_GUARDED_BY(mu_);
+  // Set once (under mu_) to state_.get(), so the callback fast paths can
+  // reach the shards without taking mu_. Cleared only by the destructor.
+  std::atomic<State*> state_ptr_{nullptr};
 };
 
 // Registers the given cancellation callback, returning a function that can be
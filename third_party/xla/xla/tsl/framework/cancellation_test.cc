@@ -16,6 +16,7 @@ limitations under the License.
 #include "xla/tsl/framework/cancellation.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <numeric>
 #include <random>
@@ -221,6 +222,45 @@ TEST(Cancellation, TryDeregisterDuringCancel) {
   cancel_complete.WaitForNotification();
 }
 
+TEST(Cancellation, ConcurrentRegisterDuringCancel) {
+  // Race many registrations and deregistrations against StartCancel, and
+  // check that every callback either runs exactly once during the cancel
+  // or is rejected/deregistered, never both and never neither.
+  static constexpr int kNumThreads = 8;
+  static constexpr int kTokensPerThread = 100;
+  auto manager = std::make_unique<CancellationManager>();
+  std::atomic<int> num_callbacks_run(0);
+  std::atomic<int> num_settled(0);
+  Notification start_cancel;
+  {
+    thread::ThreadPool w(Env::Default(), "test", kNumThreads + 1);
+    for (int i = 0; i < kNumThreads; ++i) {
+      w.Schedule([&]() {
+        for (int j = 0; j < kTokensPerThread; ++j) {
+          auto token = manager->get_cancellation_token();
+          bool registered = manager->RegisterCallback(
+              token, [&num_callbacks_run]() { ++num_callbacks_run; });
+          if (!registered) {
+            // Rejected: the callback will never run.
+            ++num_settled;
+          } else if (manager->DeregisterCallback(token)) {
+            // Deregistered before the cancel: the callback did not run.
+            ++num_settled;
+          }
+          // Otherwise the callback ran (or is running) in StartCancel.
+        }
+      });
+    }
+    w.Schedule([&]() {
+      start_cancel.WaitForNotification();
+      manager->StartCancel();
+    });
+    start_cancel.Notify();
+  }
+  EXPECT_TRUE(manager->IsCancelled());
+  EXPECT_EQ(num_callbacks_run + num_settled, kNumThreads * kTokensPerThread);
+}
+
 TEST(Cancellation, Parent_CancelManyChildren) {
   CancellationManager parent;
   std::vector<std::unique_ptr<CancellationManager>> children;